@@ -76,6 +76,16 @@ void DcgmFvBuffer::Clear(void)
     m_numEntries = 0;
 }
 
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBuffer::Reserve(size_t additionalBytes)
+{
+    if (!additionalBytes)
+        return DCGM_ST_OK;
+
+    /* Keep capacities a multiple of 512 like AddFvReally() */
+    return Resize((m_bufferUsed + additionalBytes + 511U) & (~511U));
+}
+
 /******************************************************************************/
 dcgmBufferedFv_t *DcgmFvBuffer::AddFvReally(size_t bytesNeeded)
 {
@@ -309,6 +319,27 @@ dcgmBufferedFv_t *DcgmFvBuffer::AddFV1Value(dcgm_field_entity_group_t entityGrou
     return nullptr;
 }
 
+/******************************************************************************/
+dcgmBufferedFv_t *DcgmFvBuffer::AddBufferedFv(dcgmBufferedFv_t const &fv)
+{
+    if (fv.version != dcgmBufferedFv_version || fv.length < sizeof(fv) - sizeof(fv.value) || fv.length > sizeof(fv))
+    {
+        log_error("Not copying corrupt fv. version {}, length {}", (int)fv.version, (int)fv.length);
+        return nullptr;
+    }
+
+    /* Values are truncated to their length, so only copy that much */
+    size_t const length      = fv.length;
+    dcgmBufferedFv_t *retPtr = AddFvReally(length);
+    if (!retPtr)
+    {
+        return nullptr;
+    }
+
+    memcpy(retPtr, &fv, length);
+    return retPtr;
+}
+
 /******************************************************************************/
 dcgmBufferedFv_t *DcgmFvBuffer::GetNextFv(dcgmBufferedFvCursor_t *cursor)
 {
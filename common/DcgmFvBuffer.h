@@ -222,6 +222,14 @@ public:
                                   dcgm_field_eid_t entityId,
                                   dcgmFieldValue_v1 *fv1);
 
+    /**************************************************************************
+     * Append a copy of a field value from another fvBuffer
+     *
+     * Returns A pointer to the allocated field-value structure
+     *         nullptr on error (will be logged)
+     */
+    dcgmBufferedFv_t *AddBufferedFv(dcgmBufferedFv_t const &fv);
+
     /**************************************************************************
      * Tell this object whether to grow exponentially or not from now on
      *
@@ -232,6 +240,17 @@ public:
      */
     void SetGrowExponentially(bool growExponentially);
 
+    /**************************************************************************
+     * Make room for at least additionalBytes more bytes so that appending them
+     * doesn't resize this buffer again. Use this before appending a known number
+     * of values, e.g. numValues * DCGM_BUFFERED_FV1_MIN_ENTRY_SIZE for int64 or
+     * double values.
+     *
+     * Returns: DCGM_ST_OK on success
+     *          DCGM_ST_MEMORY if we're out of memory
+     */
+    dcgmReturn_t Reserve(size_t additionalBytes);
+
 private:
     /**************************************************************************
      * Resize this structure to hold a new capacity of bytes
@@ -50,6 +50,7 @@ int DcgmPolicyRequest::ProcessMessage(std::unique_ptr<DcgmMessage> msg)
         case DCGM_MSG_PROTO_REQUEST:
         case DCGM_MSG_PROTO_RESPONSE:
         case DCGM_MSG_MODULE_COMMAND:
+        case DCGM_MSG_MODULE_COMMAND_COMPACT:
             /* Request/response messages complete the initial request */
             if (!mIsAckRecvd)
             {
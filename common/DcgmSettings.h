@@ -30,6 +30,13 @@
 /* Environmental variable to bypass the allow list */
 #define DCGM_ENV_WL_BYPASS "__DCGM_WL_BYPASS"
 
+/* Environmental variables that make the hostengine aggregate other hostengines. See DcgmFederation.
+   Nodes are a comma-separated list of host[:port] addresses. Prefix unix socket paths with unix://.
+   Fields are a comma-separated list of field IDs. The interval is how often to sync with every node in ms */
+#define DCGM_ENV_FEDERATION_NODES    "__DCGM_FEDERATION_NODES"
+#define DCGM_ENV_FEDERATION_FIELDS   "__DCGM_FEDERATION_FIELDS"
+#define DCGM_ENV_FEDERATION_INTERVAL "__DCGM_FEDERATION_INTERVAL_MS"
+
 #define DCGM_MODE_EMBEDDED_HE   0 /* Mode when Host Engine is Embedded. ISV Agent Use Case */
 #define DCGM_MODE_STANDALONE_HE 1 /* Mode when Host Engine is Standalone. NV Agent Use Case */
 
@@ -15,6 +15,102 @@
  */
 #include "TimeLib.hpp"
 
+#include <timelib.h>
+
+#include <atomic>
+#include <cstdlib>
+
 
 namespace DcgmNs::Timelib
-{} // namespace DcgmNs::Timelib
\ No newline at end of file
+{
+namespace
+{
+std::atomic<std::int64_t> g_virtualNowUsec { 0 };
+std::atomic<bool> g_virtualInstalled { false };
+std::atomic<bool> g_virtualFreeRunning { false };
+
+timelib64_t VirtualClockCB()
+{
+    return g_virtualNowUsec.load(std::memory_order_acquire);
+}
+} // namespace
+
+void VirtualClock::Install(std::int64_t startUsec, bool freeRunning)
+{
+    g_virtualNowUsec.store(startUsec, std::memory_order_release);
+    g_virtualFreeRunning.store(freeRunning, std::memory_order_release);
+    g_virtualInstalled.store(true, std::memory_order_release);
+    timelib_setClockOverride(VirtualClockCB);
+}
+
+void VirtualClock::Uninstall()
+{
+    timelib_setClockOverride(nullptr);
+    g_virtualInstalled.store(false, std::memory_order_release);
+    g_virtualFreeRunning.store(false, std::memory_order_release);
+}
+
+bool VirtualClock::InstallFromEnv()
+{
+    char const *value = getenv(DCGM_VIRTUAL_CLOCK_ENV_VAR);
+    if (value == nullptr)
+    {
+        return false;
+    }
+
+    long long startUsec = atoll(value);
+    if (startUsec <= 0)
+    {
+        return false;
+    }
+    if (startUsec == 1)
+    {
+        startUsec = ToLegacyTimestamp(std::chrono::system_clock::now());
+    }
+
+    Install(startUsec, true);
+    return true;
+}
+
+bool VirtualClock::IsInstalled() noexcept
+{
+    return g_virtualInstalled.load(std::memory_order_acquire);
+}
+
+bool VirtualClock::IsFreeRunning() noexcept
+{
+    return g_virtualInstalled.load(std::memory_order_acquire) && g_virtualFreeRunning.load(std::memory_order_acquire);
+}
+
+std::int64_t VirtualClock::NowUsec() noexcept
+{
+    return g_virtualNowUsec.load(std::memory_order_acquire);
+}
+
+void VirtualClock::Advance(std::chrono::microseconds duration) noexcept
+{
+    if (duration.count() > 0)
+    {
+        g_virtualNowUsec.fetch_add(duration.count(), std::memory_order_acq_rel);
+    }
+}
+
+void VirtualClock::AdvanceTo(std::int64_t usec) noexcept
+{
+    std::int64_t now = g_virtualNowUsec.load(std::memory_order_acquire);
+    while (now < usec && !g_virtualNowUsec.compare_exchange_weak(now, usec, std::memory_order_acq_rel))
+    {
+    }
+}
+
+TimePoint Now() noexcept
+{
+    if (timelib_getClockOverride() != nullptr)
+    {
+        return TimePoint(
+            std::chrono::duration_cast<TimePoint::duration>(std::chrono::microseconds(timelib_usecSince1970())));
+    }
+    return std::chrono::system_clock::now();
+}
+
+} // namespace DcgmNs::Timelib
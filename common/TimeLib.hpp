@@ -17,15 +17,70 @@
 #include <chrono>
 #include <cstdint>
 
+/* Environment variable that runs the hostengine on a free-running VirtualClock. This is only
+   honored with injection NVML. Set it to 1 to start at the current time or to a timestamp in usec */
+#define DCGM_VIRTUAL_CLOCK_ENV_VAR "__DCGM_VIRTUAL_CLOCK"
+
 
 namespace DcgmNs::Timelib
 {
 using TimePoint = std::chrono::system_clock::time_point;
 
-inline TimePoint Now() noexcept
+/**
+ * @brief Process-wide virtual clock that replaces the system clock for timelib_usecSince1970() and Now().
+ *
+ * Nothing moves the clock but Advance() and AdvanceTo(), so simulated hours of retention, quotas and health
+ * windows can be run in as much wall time as the work takes. When the clock is free-running, the cache
+ * manager's update loop jumps it to its next update instead of sleeping.
+ *
+ * Install it before starting the threads that read the clock. Modules link their own timelib and pick the clock up
+ * through the clockfunc of their dcgmCoreCallbacks_t.
+ */
+class VirtualClock
 {
-    return std::chrono::system_clock::now();
-}
+public:
+    /**
+     * @brief Replaces the system clock with the virtual clock.
+     * @param[in] startUsec     Time to start the clock at in usec since 1970.
+     * @param[in] freeRunning   Should the update loop advance the clock on its own?
+     */
+    static void Install(std::int64_t startUsec, bool freeRunning);
+
+    /**
+     * @brief Goes back to the system clock.
+     */
+    static void Uninstall();
+
+    /**
+     * @brief Installs a free-running clock if DCGM_VIRTUAL_CLOCK_ENV_VAR is set.
+     * @return True if the clock was installed.
+     */
+    static bool InstallFromEnv();
+
+    [[nodiscard]] static bool IsInstalled() noexcept;
+    [[nodiscard]] static bool IsFreeRunning() noexcept;
+
+    /**
+     * @brief Current time of the virtual clock in usec since 1970.
+     */
+    [[nodiscard]] static std::int64_t NowUsec() noexcept;
+
+    /**
+     * @brief Moves the clock forward by \a duration.
+     */
+    static void Advance(std::chrono::microseconds duration) noexcept;
+
+    /**
+     * @brief Moves the clock to \a usec. The clock never goes backwards, so earlier times are ignored.
+     */
+    static void AdvanceTo(std::int64_t usec) noexcept;
+};
+
+/**
+ * @brief Current time. Follows timelib_usecSince1970() when its clock is overridden, which is the case when
+ *        the VirtualClock is installed or when a module reads the hostengine's clock.
+ */
+[[nodiscard]] TimePoint Now() noexcept;
 
 /**
  * @brief Converts std::chrono durations into legacy microseconds representation.
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <DcgmIpcScheduler.h>
+
+#include <catch2/catch.hpp>
+
+
+namespace
+{
+/* Tag each message with its priority in the request ID so the classifier can read it back */
+std::unique_ptr<DcgmMessage> MakeMessage(DcgmIpcPriority_t priority)
+{
+    auto message = std::make_unique<DcgmMessage>();
+    message->SetRequestId(priority);
+    return message;
+}
+
+DcgmIpcSchedulerParams_t MakeParams(unsigned int maxInFlightPerConnection, unsigned int maxSharedInFlight)
+{
+    DcgmIpcSchedulerParams_t params {};
+    params.classify = [](DcgmMessage &message) {
+        return (DcgmIpcPriority_t)message.GetRequestId();
+    };
+    params.maxInFlightPerConnection          = maxInFlightPerConnection;
+    params.maxSharedInFlight                 = maxSharedInFlight;
+    params.weights[DCGM_IPC_PRIORITY_HIGH]   = 4;
+    params.weights[DCGM_IPC_PRIORITY_NORMAL] = 2;
+    params.weights[DCGM_IPC_PRIORITY_BULK]   = 1;
+    return params;
+}
+
+void PushClassified(DcgmIpcScheduler &scheduler, dcgm_connection_id_t connectionId, DcgmIpcPriority_t priority)
+{
+    auto message = MakeMessage(priority);
+    REQUIRE(scheduler.Classify(*message) == priority);
+    scheduler.Push(connectionId, priority, std::move(message));
+}
+} // namespace
+
+TEST_CASE("DcgmIpcScheduler : Default is round robin across connections")
+{
+    DcgmIpcScheduler scheduler;
+
+    for (int i = 0; i < 4; i++)
+    {
+        auto message  = MakeMessage(DCGM_IPC_PRIORITY_HIGH);
+        auto priority = scheduler.Classify(*message);
+        scheduler.Push(i == 1 ? 2 : 1, priority, std::move(message));
+    }
+
+    /* Without a classifier, everything is normal priority */
+    REQUIRE(scheduler.GetStats().classes[DCGM_IPC_PRIORITY_NORMAL].numQueued == 4);
+
+    std::vector<dcgm_connection_id_t> order;
+    while (auto scheduled = scheduler.Pop())
+    {
+        order.push_back(scheduled->connectionId);
+        scheduler.Complete(scheduled->connectionId, scheduled->priority);
+    }
+
+    REQUIRE(order == std::vector<dcgm_connection_id_t> { 1, 2, 1, 1 });
+}
+
+TEST_CASE("DcgmIpcScheduler : Classes are served by weight")
+{
+    DcgmIpcScheduler scheduler;
+    scheduler.SetParams(MakeParams(0, 0));
+
+    for (int i = 0; i < 10; i++)
+    {
+        PushClassified(scheduler, 1, DCGM_IPC_PRIORITY_BULK);
+        PushClassified(scheduler, 2, DCGM_IPC_PRIORITY_NORMAL);
+        PushClassified(scheduler, 3, DCGM_IPC_PRIORITY_HIGH);
+    }
+
+    /* One round is 4 high, 2 normal, then 1 bulk */
+    std::vector<DcgmIpcPriority_t> order;
+    for (int i = 0; i < 7; i++)
+    {
+        auto scheduled = scheduler.Pop();
+        REQUIRE(scheduled.has_value());
+        order.push_back(scheduled->priority);
+        scheduler.Complete(scheduled->connectionId, scheduled->priority);
+    }
+
+    std::vector<DcgmIpcPriority_t> expected = { DCGM_IPC_PRIORITY_HIGH,   DCGM_IPC_PRIORITY_HIGH,
+                                                DCGM_IPC_PRIORITY_HIGH,   DCGM_IPC_PRIORITY_HIGH,
+                                                DCGM_IPC_PRIORITY_NORMAL, DCGM_IPC_PRIORITY_NORMAL,
+                                                DCGM_IPC_PRIORITY_BULK };
+    REQUIRE(order == expected);
+
+    auto stats = scheduler.GetStats();
+    CHECK(stats.classes[DCGM_IPC_PRIORITY_HIGH].numDispatched == 4);
+    CHECK(stats.classes[DCGM_IPC_PRIORITY_HIGH].numQueued == 6);
+    CHECK(stats.classes[DCGM_IPC_PRIORITY_BULK].numDispatched == 1);
+    CHECK(stats.classes[DCGM_IPC_PRIORITY_BULK].maxWaitUsec <= stats.classes[DCGM_IPC_PRIORITY_BULK].totalWaitUsec);
+}
+
+TEST_CASE("DcgmIpcScheduler : In-flight limits")
+{
+    DcgmIpcScheduler scheduler;
+    scheduler.SetParams(MakeParams(1, 2));
+
+    PushClassified(scheduler, 1, DCGM_IPC_PRIORITY_BULK);
+    PushClassified(scheduler, 1, DCGM_IPC_PRIORITY_BULK);
+    PushClassified(scheduler, 2, DCGM_IPC_PRIORITY_NORMAL);
+    PushClassified(scheduler, 3, DCGM_IPC_PRIORITY_NORMAL);
+
+    auto first = scheduler.Pop();
+    REQUIRE(first.has_value());
+    auto second = scheduler.Pop();
+    REQUIRE(second.has_value());
+
+    /* Two non-high messages are in flight, so the shared limit holds back the rest */
+    REQUIRE(!scheduler.Pop().has_value());
+
+    /* High priority messages are never held back */
+    PushClassified(scheduler, 1, DCGM_IPC_PRIORITY_HIGH);
+    auto high = scheduler.Pop();
+    REQUIRE(high.has_value());
+    REQUIRE(high->connectionId == 1);
+    scheduler.Complete(high->connectionId, high->priority);
+
+    scheduler.Complete(first->connectionId, first->priority);
+    scheduler.Complete(second->connectionId, second->priority);
+
+    /* Only connection 1's messages are left, and it can only have one in flight at a time */
+    auto third = scheduler.Pop();
+    REQUIRE(third.has_value());
+    REQUIRE(third->connectionId == 1);
+    REQUIRE(!scheduler.Pop().has_value());
+
+    scheduler.Complete(third->connectionId, third->priority);
+    REQUIRE(scheduler.Pop().has_value());
+}
+
+TEST_CASE("DcgmIpcScheduler : Disconnects wait for queued messages")
+{
+    DcgmIpcScheduler scheduler;
+
+    /* A connection we never heard from can be disconnected right away */
+    REQUIRE(scheduler.MarkDisconnected(5));
+
+    scheduler.Push(1, DCGM_IPC_PRIORITY_NORMAL, MakeMessage(DCGM_IPC_PRIORITY_NORMAL));
+    scheduler.Push(1, DCGM_IPC_PRIORITY_NORMAL, MakeMessage(DCGM_IPC_PRIORITY_NORMAL));
+
+    auto first = scheduler.Pop();
+    REQUIRE(first.has_value());
+
+    REQUIRE(!scheduler.MarkDisconnected(1));
+    REQUIRE(!scheduler.Complete(first->connectionId, first->priority));
+
+    auto second = scheduler.Pop();
+    REQUIRE(second.has_value());
+    REQUIRE(scheduler.Complete(second->connectionId, second->priority));
+    REQUIRE(!scheduler.Pop().has_value());
+}
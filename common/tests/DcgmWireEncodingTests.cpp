@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <DcgmWireEncoding.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+
+
+namespace
+{
+/* Shaped like a module command: a header followed by a mostly empty fixed-size payload */
+struct TestStruct
+{
+    unsigned int length;
+    unsigned int subCommand;
+    unsigned int numValues;
+    char name[256];
+    long long values[512];
+};
+
+TestStruct MakeTestStruct()
+{
+    TestStruct ts = {};
+    ts.length     = sizeof(ts);
+    ts.subCommand = 42;
+    ts.numValues  = 3;
+    strcpy(ts.name, "GPU 0");
+    ts.values[0] = 1;
+    ts.values[1] = 0x123456789ALL;
+    ts.values[2] = -1;
+    return ts;
+}
+
+std::vector<char> Encode(void const *src, size_t srcLength, size_t prefixLength)
+{
+    std::vector<char> encoded;
+    REQUIRE(DcgmWireEncodeCompact(src, srcLength, prefixLength, encoded) == DCGM_ST_OK);
+    return encoded;
+}
+} // namespace
+
+TEST_CASE("DcgmWireEncoding: Round trip of a mostly empty struct")
+{
+    TestStruct const ts = MakeTestStruct();
+    size_t const prefix = 2 * sizeof(unsigned int);
+
+    std::vector<char> encoded = Encode(&ts, sizeof(ts), prefix);
+    CHECK(encoded.size() < 64);
+
+    /* The prefix can be read without decoding */
+    CHECK(memcmp(encoded.data(), &ts, prefix) == 0);
+
+    size_t decodedLength = 0;
+    REQUIRE(DcgmWireGetDecodedLength(encoded.data(), encoded.size(), prefix, decodedLength) == DCGM_ST_OK);
+    CHECK(decodedLength == sizeof(ts));
+
+    /* Decoding has to clear whatever was in the destination before */
+    TestStruct decoded;
+    memset(&decoded, 0xAB, sizeof(decoded));
+    REQUIRE(DcgmWireDecodeCompact(encoded.data(), encoded.size(), prefix, &decoded, sizeof(decoded), decodedLength)
+            == DCGM_ST_OK);
+    CHECK(decodedLength == sizeof(ts));
+    CHECK(memcmp(&decoded, &ts, sizeof(ts)) == 0);
+}
+
+TEST_CASE("DcgmWireEncoding: Round trip of dense and short buffers")
+{
+    std::vector<char> src(1000);
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        /* Zero runs of every length up to a bit past DCGM_WIRE_ENCODING_MIN_ZERO_RUN */
+        src[i] = (i % 23) < (i % 11) ? 0 : (char)(i + 1);
+    }
+
+    for (size_t length : { (size_t)0, (size_t)1, (size_t)7, (size_t)8, (size_t)9, src.size() })
+    {
+        for (size_t prefix : { (size_t)0, std::min(length, (size_t)4) })
+        {
+            std::vector<char> encoded = Encode(src.data(), length, prefix);
+
+            std::vector<char> decoded(length + 1, 'x');
+            size_t decodedLength = 0;
+            REQUIRE(DcgmWireDecodeCompact(
+                        encoded.data(), encoded.size(), prefix, decoded.data(), decoded.size(), decodedLength)
+                    == DCGM_ST_OK);
+            REQUIRE(decodedLength == length);
+            CHECK(memcmp(decoded.data(), src.data(), length) == 0);
+            CHECK(decoded[length] == 'x');
+        }
+    }
+}
+
+TEST_CASE("DcgmWireEncoding: Bad input")
+{
+    TestStruct const ts = MakeTestStruct();
+    size_t const prefix = 2 * sizeof(unsigned int);
+    TestStruct decoded;
+    size_t decodedLength = 0;
+    std::vector<char> unused;
+
+    CHECK(DcgmWireEncodeCompact(&ts, prefix - 1, prefix, unused) == DCGM_ST_BADPARAM);
+
+    std::vector<char> const encoded = Encode(&ts, sizeof(ts), prefix);
+
+    SECTION("Destination too small")
+    {
+        CHECK(DcgmWireDecodeCompact(
+                  encoded.data(), encoded.size(), prefix, &decoded, sizeof(decoded) - 1, decodedLength)
+              == DCGM_ST_INSUFFICIENT_SIZE);
+    }
+
+    SECTION("Truncated")
+    {
+        for (size_t length = 0; length < encoded.size(); length++)
+        {
+            CHECK(DcgmWireDecodeCompact(encoded.data(), length, prefix, &decoded, sizeof(decoded), decodedLength)
+                  == DCGM_ST_BADPARAM);
+        }
+    }
+
+    SECTION("Trailing bytes")
+    {
+        std::vector<char> longer = encoded;
+        longer.push_back(0);
+        CHECK(DcgmWireDecodeCompact(longer.data(), longer.size(), prefix, &decoded, sizeof(decoded), decodedLength)
+              == DCGM_ST_BADPARAM);
+    }
+
+    SECTION("Unknown version")
+    {
+        std::vector<char> other = encoded;
+        other[prefix]           = DCGM_WIRE_ENCODING_COMPACT_VERSION + 1;
+        CHECK(DcgmWireDecodeCompact(other.data(), other.size(), prefix, &decoded, sizeof(decoded), decodedLength)
+              == DCGM_ST_BADPARAM);
+        CHECK(DcgmWireGetDecodedLength(other.data(), other.size(), prefix, decodedLength) == DCGM_ST_BADPARAM);
+    }
+}
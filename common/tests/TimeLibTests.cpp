@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <Defer.hpp>
 #include <TimeLib.hpp>
+#include <timelib.h>
 
 #include <catch2/catch.hpp>
 
@@ -35,4 +37,28 @@ TEST_CASE("TimeLib: FromLegacyTimestamp. Negative")
     auto newTs = FromLegacyTimestamp<std::chrono::milliseconds>(-50000);
     REQUIRE(newTs == (-std::chrono::milliseconds(50)));
     REQUIRE(newTs == std::chrono::milliseconds(-50));
-}
\ No newline at end of file
+}
+TEST_CASE("TimeLib: VirtualClock")
+{
+    std::int64_t const startUsec = 1000000000000LL;
+    VirtualClock::Install(startUsec, false);
+    DcgmNs::Defer defer([] { VirtualClock::Uninstall(); });
+
+    REQUIRE(VirtualClock::IsInstalled());
+    CHECK(!VirtualClock::IsFreeRunning());
+    CHECK(timelib_usecSince1970() == startUsec);
+    CHECK(ToLegacyTimestamp(Now()) == startUsec);
+
+    /* Simulated time only moves when it is told to */
+    VirtualClock::Advance(std::chrono::hours(24));
+    CHECK(timelib_usecSince1970() == startUsec + ToLegacyTimestamp(std::chrono::hours(24)));
+
+    VirtualClock::AdvanceTo(startUsec);
+    CHECK(timelib_usecSince1970() == startUsec + ToLegacyTimestamp(std::chrono::hours(24)));
+    VirtualClock::AdvanceTo(startUsec + ToLegacyTimestamp(std::chrono::hours(48)));
+    CHECK(timelib_secSince1970() == (startUsec + ToLegacyTimestamp(std::chrono::hours(48))) / 1000000);
+
+    VirtualClock::Uninstall();
+    CHECK(!VirtualClock::IsInstalled());
+    CHECK(timelib_usecSince1970() > startUsec + ToLegacyTimestamp(std::chrono::hours(48)));
+}
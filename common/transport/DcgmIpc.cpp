@@ -17,6 +17,7 @@
 
 #include "DcgmIpc.h"
 #include <DcgmLogging.h>
+#include <algorithm>
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <optional>
@@ -24,12 +25,13 @@
 #include <sys/un.h>
 
 /*****************************************************************************/
-/* The previous IPC library had serious threading issues. Adding this macro
+/* The previous IPC library had serious threading issues. Adding these macros
    to validate that we're indeed in the correct thread */
-#define ASSERT_IS_IPC_THREAD assert(pthread_equal(pthread_self(), m_ipcThreadId))
+#define ASSERT_IS_IPC_THREAD     assert(pthread_equal(pthread_self(), m_ipcThreadId))
+#define ASSERT_IS_REACTOR_THREAD assert(pthread_equal(pthread_self(), m_threadId))
 
 /*****************************************************************************/
-DcgmIpc::DcgmIpc(int numWorkerThreads)
+DcgmIpc::DcgmIpc(int numWorkerThreads, unsigned int numReactors)
     : DcgmThread(false, "dcgm_ipc")
     , m_workersPool(numWorkerThreads)
 {
@@ -38,12 +40,18 @@ DcgmIpc::DcgmIpc(int numWorkerThreads)
     m_tcpListenSocketFd     = -1;
     m_domainListenSocketFd  = -1;
     m_ipcThreadId           = 0; /* Any valid value is nonzero */
-    m_eventBase             = nullptr;
     m_dnsBase               = nullptr;
     m_processDisconnectData = nullptr;
     m_tcpListenEvent        = nullptr;
     m_domainListenEvent     = nullptr;
     m_processMessageData    = nullptr;
+
+    numReactors = std::clamp(numReactors, 1U, DCGM_IPC_MAX_REACTORS);
+    m_reactors.reserve(numReactors);
+    for (unsigned int i = 0; i < numReactors; i++)
+    {
+        m_reactors.emplace_back(std::make_unique<DcgmIpcReactor>(this, i));
+    }
 }
 
 /*****************************************************************************/
@@ -84,11 +92,13 @@ dcgmReturn_t DcgmIpc::Init(std::optional<DcgmIpcTcpServerParams_t> tcpParameters
         event_enable_debug_logging(EVENT_DBG_ALL);
     }
 
-    m_eventBase = event_base_new();
-    if (m_eventBase == nullptr)
+    for (auto &reactor : m_reactors)
     {
-        DCGM_LOG_ERROR << "Failed to open event base";
-        return DCGM_ST_GENERIC_ERROR;
+        dcgmReturn_t dcgmReturn = reactor->Init();
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
     }
 
 #if 1
@@ -96,7 +106,7 @@ dcgmReturn_t DcgmIpc::Init(std::optional<DcgmIpcTcpServerParams_t> tcpParameters
                             resolution was sync'd, and the caller
                             is blocked on our future anyway. */
 #else
-    m_dnsBase = evdns_base_new(m_eventBase, 0);
+    m_dnsBase = evdns_base_new(m_reactors[0]->GetEventBase(), 0);
     if (m_dnsBase == nullptr)
     {
         DCGM_LOG_ERROR << "Failed to open DNS event base";
@@ -117,6 +127,19 @@ dcgmReturn_t DcgmIpc::Init(std::optional<DcgmIpcTcpServerParams_t> tcpParameters
 
     auto initFuture = m_initPromise.get_future();
 
+    /* Reactor 0 runs on our own thread. Start the rest on their own threads */
+    for (size_t i = 1; i < m_reactors.size(); i++)
+    {
+        if (m_reactors[i]->Start() != 0)
+        {
+            DCGM_LOG_ERROR << "Unable to start IPC reactor " << i;
+            StopReactorThreads();
+            return DCGM_ST_GENERIC_ERROR;
+        }
+    }
+
+    DCGM_LOG_DEBUG << "Started " << m_reactors.size() << " IPC reactor(s)";
+
     int st = Start();
     if (st != 0)
     {
@@ -145,6 +168,9 @@ DcgmIpc::~DcgmIpc()
             DCGM_LOG_ERROR << "Killing DcgmIpc thread that is still running.";
             Kill();
         }
+
+        /* In case our own thread never ran to stop them */
+        StopReactorThreads();
     }
     catch (std::exception const &ex)
     {
@@ -165,17 +191,28 @@ DcgmIpc::~DcgmIpc()
         event_free(m_domainListenEvent);
     }
 
+    /* event_free() doesn't close the fds. Close them so a new instance can bind the same address */
+    if (m_tcpListenSocketFd >= 0)
+    {
+        close(m_tcpListenSocketFd);
+        m_tcpListenSocketFd = -1;
+    }
+
+    if (m_domainListenSocketFd >= 0)
+    {
+        close(m_domainListenSocketFd);
+        m_domainListenSocketFd = -1;
+    }
+
     /* Free mpBase after any libevent workers are gone */
     if (m_dnsBase)
     {
         evdns_base_free(m_dnsBase, 1);
         m_dnsBase = nullptr;
     }
-    if (m_eventBase)
-    {
-        event_base_free(m_eventBase);
-        m_eventBase = nullptr;
-    }
+
+    /* This frees the event bases. Every reactor thread is stopped by now */
+    m_reactors.clear();
 
     libevent_global_shutdown();
 }
@@ -193,6 +230,7 @@ void DcgmIpc::run()
     if (dcgmReturn != DCGM_ST_OK)
     {
         DCGM_LOG_ERROR << "InitTCPListenerSocket() returned " << errorString(dcgmReturn);
+        StopReactorThreads();
         m_state = DCGM_IPC_STATE_FAILED;
         m_initPromise.set_value(dcgmReturn);
         return;
@@ -202,6 +240,7 @@ void DcgmIpc::run()
     if (dcgmReturn != DCGM_ST_OK)
     {
         DCGM_LOG_ERROR << "InitUnixListenerSocket() returned " << errorString(dcgmReturn);
+        StopReactorThreads();
         m_state = DCGM_IPC_STATE_FAILED;
         m_initPromise.set_value(dcgmReturn);
         return;
@@ -210,16 +249,12 @@ void DcgmIpc::run()
     m_state = DCGM_IPC_STATE_RUNNING;
     m_initPromise.set_value(DCGM_ST_OK);
 
-    DCGM_LOG_DEBUG << "starting event_base_loop()";
-
-    /* Run until we're told to stop */
-    event_base_loop(m_eventBase, EVLOOP_NO_EXIT_ON_EMPTY);
-
-    DCGM_LOG_DEBUG << "event_base_loop() ended. Closing connections.";
+    /* Run reactor 0 on this thread until we're told to stop */
+    m_reactors[0]->RunEventLoop();
 
-    /* Clear out our structures from this thread since this thread owns them */
-    m_bevToConnectionId.clear();
-    m_connections.clear();
+    /* The other reactors were asked to exit their loops by OnStop(). Join them
+       so none of them is still touching the worker pool or its connections */
+    StopReactorThreads();
 
     m_state = DCGM_IPC_STATE_STOPPED;
 
@@ -242,13 +277,37 @@ void DcgmIpc::OnStop()
        callbacks, but the worker pool queue won't leak */
     m_workersPool.StopAndWait();
 
-    if (m_eventBase)
+    for (size_t i = 1; i < m_reactors.size(); i++)
+    {
+        m_reactors[i]->Stop();
+    }
+
+    if (m_reactors[0]->GetEventBase())
     {
         DCGM_LOG_DEBUG << "Requesting loop exit";
-        event_base_loopexit(m_eventBase, nullptr);
+        event_base_loopexit(m_reactors[0]->GetEventBase(), nullptr);
+    }
+}
+
+/*****************************************************************************/
+void DcgmIpc::StopReactorThreads()
+{
+    for (size_t i = 1; i < m_reactors.size(); i++)
+    {
+        if (m_reactors[i]->StopAndWait(60000))
+        {
+            DCGM_LOG_ERROR << "Killing IPC reactor " << i << " that is still running.";
+            m_reactors[i]->Kill();
+        }
     }
 }
 
+/*****************************************************************************/
+DcgmIpcReactor *DcgmIpc::ReactorForConnectionId(dcgm_connection_id_t connectionId)
+{
+    return m_reactors[connectionId % m_reactors.size()].get();
+}
+
 /*****************************************************************************/
 static int SetNonBlocking(int fd)
 {
@@ -346,7 +405,8 @@ dcgmReturn_t DcgmIpc::InitTCPListenerSocket()
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    m_tcpListenEvent = event_new(m_eventBase, m_tcpListenSocketFd, EV_READ | EV_PERSIST, DcgmIpc::StaticOnAccept, this);
+    m_tcpListenEvent = event_new(
+        m_reactors[0]->GetEventBase(), m_tcpListenSocketFd, EV_READ | EV_PERSIST, DcgmIpc::StaticOnAccept, this);
     if (m_tcpListenEvent == nullptr)
     {
         DCGM_LOG_ERROR << "event_new() failed for TCP listener";
@@ -427,8 +487,11 @@ dcgmReturn_t DcgmIpc::InitUnixListenerSocket()
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    m_domainListenEvent
-        = event_new(m_eventBase, m_domainListenSocketFd, EV_READ | EV_PERSIST, DcgmIpc::StaticOnAccept, this);
+    m_domainListenEvent = event_new(m_reactors[0]->GetEventBase(),
+                                    m_domainListenSocketFd,
+                                    EV_READ | EV_PERSIST,
+                                    DcgmIpc::StaticOnAccept,
+                                    this);
     if (m_domainListenEvent == nullptr)
     {
         DCGM_LOG_ERROR << "event_new() failed for domain listener";
@@ -449,12 +512,81 @@ dcgmReturn_t DcgmIpc::InitUnixListenerSocket()
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmIpc::AddConnection(struct bufferevent *bev,
+DcgmIpcReactor::DcgmIpcReactor(DcgmIpc *ipc, unsigned int reactorIndex)
+    : DcgmThread(false, "dcgm_ipc_r" + std::to_string(reactorIndex))
+    , m_ipc(ipc)
+    , m_reactorIndex(reactorIndex)
+    , m_eventBase(nullptr)
+    , m_threadId(0) /* Any valid value is nonzero */
+{}
+
+/*****************************************************************************/
+DcgmIpcReactor::~DcgmIpcReactor()
+{
+    /* Our owner is responsible for stopping our thread (or the DcgmIpc thread for
+       reactor 0) before destroying us */
+    if (m_eventBase)
+    {
+        event_base_free(m_eventBase);
+        m_eventBase = nullptr;
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpcReactor::Init()
+{
+    m_eventBase = event_base_new();
+    if (m_eventBase == nullptr)
+    {
+        DCGM_LOG_ERROR << "Failed to open event base for reactor " << m_reactorIndex;
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmIpcReactor::run()
+{
+    RunEventLoop();
+}
+
+/*****************************************************************************/
+void DcgmIpcReactor::OnStop()
+{
+    if (m_eventBase)
+    {
+        DCGM_LOG_DEBUG << "Requesting loop exit for reactor " << m_reactorIndex;
+        event_base_loopexit(m_eventBase, nullptr);
+    }
+}
+
+/*****************************************************************************/
+void DcgmIpcReactor::RunEventLoop()
+{
+    m_threadId = pthread_self();
+
+    ASSERT_IS_REACTOR_THREAD; /* Make sure the macro works */
+
+    DCGM_LOG_DEBUG << "starting event_base_loop() for reactor " << m_reactorIndex;
+
+    /* Run until we're told to stop */
+    event_base_loop(m_eventBase, EVLOOP_NO_EXIT_ON_EMPTY);
+
+    DCGM_LOG_DEBUG << "event_base_loop() ended for reactor " << m_reactorIndex << ". Closing connections.";
+
+    /* Clear out our structures from this thread since this thread owns them */
+    m_bevToConnectionId.clear();
+    m_connections.clear();
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpcReactor::AddConnection(struct bufferevent *bev,
                                     dcgm_connection_id_t connectionId,
                                     DcgmIpcConnectionState_t initialConnState,
                                     std::promise<dcgmReturn_t> connectPromise)
 {
-    ASSERT_IS_IPC_THREAD;
+    ASSERT_IS_REACTOR_THREAD;
 
     if (bev == nullptr || connectionId == DCGM_CONNECTION_ID_NONE)
     {
@@ -462,17 +594,19 @@ dcgmReturn_t DcgmIpc::AddConnection(struct bufferevent *bev,
         return DCGM_ST_BADPARAM;
     }
 
-    m_bevToConnectionId[bev]    = connectionId;
-    m_connections[connectionId] = std::make_unique<DcgmIpcConnection>(bev, initialConnState, std::move(connectPromise));
+    m_bevToConnectionId[bev] = connectionId;
+    m_connections[connectionId]
+        = std::make_unique<DcgmIpcConnection>(bev, this, initialConnState, std::move(connectPromise));
 
-    DCGM_LOG_DEBUG << "Added connectionId " << connectionId << " bev " << bev << " ics " << initialConnState;
+    DCGM_LOG_DEBUG << "Reactor " << m_reactorIndex << " added connectionId " << connectionId << " bev " << bev
+                   << " ics " << initialConnState;
     return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmIpc::RemoveConnectionById(dcgm_connection_id_t connectionId)
+dcgmReturn_t DcgmIpcReactor::RemoveConnectionById(dcgm_connection_id_t connectionId)
 {
-    ASSERT_IS_IPC_THREAD;
+    ASSERT_IS_REACTOR_THREAD;
 
     auto connectionIt = m_connections.find(connectionId);
     if (connectionIt == m_connections.end())
@@ -481,18 +615,8 @@ dcgmReturn_t DcgmIpc::RemoveConnectionById(dcgm_connection_id_t connectionId)
         return DCGM_ST_NO_DATA;
     }
 
-    /* Now look up the bev (linear search) */
-    struct bufferevent *bev = nullptr;
-    for (auto &bevIt : m_bevToConnectionId)
-    {
-        if (bevIt.second == connectionId)
-        {
-            bev = bevIt.first;
-            break;
-        }
-    }
-
-    if (bev == nullptr)
+    struct bufferevent *bev = connectionIt->second->GetBev();
+    if (bev == nullptr || m_bevToConnectionId.count(bev) == 0)
     {
         DCGM_LOG_ERROR << "bev -> connectionId did not exist but connectionId -> object did for connectionId "
                        << connectionId;
@@ -505,9 +629,9 @@ dcgmReturn_t DcgmIpc::RemoveConnectionById(dcgm_connection_id_t connectionId)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmIpc::RemoveConnectionByBev(struct bufferevent *bev)
+dcgmReturn_t DcgmIpcReactor::RemoveConnectionByBev(struct bufferevent *bev)
 {
-    ASSERT_IS_IPC_THREAD;
+    ASSERT_IS_REACTOR_THREAD;
 
     if (bev == nullptr)
     {
@@ -539,19 +663,14 @@ dcgmReturn_t DcgmIpc::RemoveConnectionByBev(struct bufferevent *bev)
     m_connections.erase(connectionIt);
 
     /* Notify our parent that we got a disconnect */
-    DcgmIpcProcessDisconnect_t pd {};
-    pd.connectionId      = connectionId;
-    pd.processDisconnect = m_processDisconnectFunc;
-    pd.userData          = m_processDisconnectData;
-
-    m_workersPool.Enqueue([pd]() mutable { DcgmIpc::ProcessDisconnectInPool(pd); });
+    m_ipc->EnqueueDisconnect(connectionId);
     return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-void DcgmIpc::ConnectTcpAsyncImpl(DcgmIpcConnectTcp &tcpConnect)
+void DcgmIpcReactor::ConnectTcpAsyncImpl(DcgmIpcConnectTcp &tcpConnect)
 {
-    ASSERT_IS_IPC_THREAD;
+    ASSERT_IS_REACTOR_THREAD;
 
     /* TCP/IP */
     DCGM_LOG_DEBUG << "Client trying to connect to " << tcpConnect.m_hostname << ":" << tcpConnect.m_port;
@@ -576,11 +695,11 @@ void DcgmIpc::ConnectTcpAsyncImpl(DcgmIpcConnectTcp &tcpConnect)
     }
 
     /* Track our event before callbacks could be invoked */
-    bufferevent_setcb(bev, DcgmIpc::StaticReadCB, NULL, DcgmIpc::StaticEventCB, this);
+    bufferevent_setcb(bev, DcgmIpcReactor::StaticReadCB, NULL, DcgmIpcReactor::StaticEventCB, this);
     bufferevent_enable(bev, EV_READ | EV_WRITE);
 
     int ret = bufferevent_socket_connect_hostname(
-        bev, m_dnsBase, AF_INET, tcpConnect.m_hostname.c_str(), tcpConnect.m_port);
+        bev, m_ipc->m_dnsBase, AF_INET, tcpConnect.m_hostname.c_str(), tcpConnect.m_port);
     if (0 != ret)
     {
         RemoveConnectionByBev(bev);
@@ -595,11 +714,11 @@ void DcgmIpc::ConnectTcpAsyncImpl(DcgmIpcConnectTcp &tcpConnect)
 }
 
 /*****************************************************************************/
-void DcgmIpc::ConnectTcpAsyncImplCB(evutil_socket_t, short, void *data)
+void DcgmIpcReactor::ConnectTcpAsyncImplCB(evutil_socket_t, short, void *data)
 {
     std::unique_ptr<DcgmIpcConnectTcp> tcpConnect((DcgmIpcConnectTcp *)data);
 
-    tcpConnect->m_ipc->ConnectTcpAsyncImpl(*tcpConnect);
+    tcpConnect->m_reactor->ConnectTcpAsyncImpl(*tcpConnect);
 }
 
 /*****************************************************************************/
@@ -608,15 +727,17 @@ dcgmReturn_t DcgmIpc::ConnectTcp(std::string hostname,
                                  dcgm_connection_id_t &connectionId,
                                  unsigned int timeoutMs)
 {
-    connectionId = GetNextConnectionId();
+    connectionId            = GetNextConnectionId();
+    DcgmIpcReactor *reactor = ReactorForConnectionId(connectionId);
 
     /* Using new here because we're transferring it through a C callback. The callback will
        assign this to a unique_ptr and then free it automatically */
-    DcgmIpcConnectTcp *connectTcp = new DcgmIpcConnectTcp(this, hostname, port, connectionId);
+    auto *connectTcp = new DcgmIpcReactor::DcgmIpcConnectTcp(reactor, hostname, port, connectionId);
 
     std::future<dcgmReturn_t> connectReturn = connectTcp->m_promise.get_future();
 
-    int st = event_base_once(m_eventBase, -1, EV_TIMEOUT, DcgmIpc::ConnectTcpAsyncImplCB, connectTcp, 0);
+    int st = event_base_once(
+        reactor->GetEventBase(), -1, EV_TIMEOUT, DcgmIpcReactor::ConnectTcpAsyncImplCB, connectTcp, 0);
     if (st)
     {
         DCGM_LOG_ERROR << "Got error " << st << " from event_base_once";
@@ -654,9 +775,9 @@ dcgmReturn_t DcgmIpc::WaitForConnectHelper(dcgm_connection_id_t connectionId,
 }
 
 /*****************************************************************************/
-void DcgmIpc::ConnectDomainAsyncImpl(DcgmIpcConnectDomain &domainConnect)
+void DcgmIpcReactor::ConnectDomainAsyncImpl(DcgmIpcConnectDomain &domainConnect)
 {
-    ASSERT_IS_IPC_THREAD;
+    ASSERT_IS_REACTOR_THREAD;
 
     /* Domain socket */
     DCGM_LOG_DEBUG << "Client trying to connect to " << domainConnect.m_path;
@@ -681,7 +802,7 @@ void DcgmIpc::ConnectDomainAsyncImpl(DcgmIpcConnectDomain &domainConnect)
     }
 
     /* Track our event before callbacks could be invoked */
-    bufferevent_setcb(bev, DcgmIpc::StaticReadCB, NULL, DcgmIpc::StaticEventCB, this);
+    bufferevent_setcb(bev, DcgmIpcReactor::StaticReadCB, NULL, DcgmIpcReactor::StaticEventCB, this);
     bufferevent_enable(bev, EV_READ | EV_WRITE);
 
     struct sockaddr_un unixDomainAddr; /* Unix domain socket address used for specifying connection details */
@@ -703,25 +824,27 @@ void DcgmIpc::ConnectDomainAsyncImpl(DcgmIpcConnectDomain &domainConnect)
 }
 
 /*****************************************************************************/
-void DcgmIpc::ConnectDomainAsyncImplCB(evutil_socket_t, short, void *data)
+void DcgmIpcReactor::ConnectDomainAsyncImplCB(evutil_socket_t, short, void *data)
 {
     std::unique_ptr<DcgmIpcConnectDomain> domainConnect((DcgmIpcConnectDomain *)data);
 
-    domainConnect->m_ipc->ConnectDomainAsyncImpl(*domainConnect);
+    domainConnect->m_reactor->ConnectDomainAsyncImpl(*domainConnect);
 }
 
 /*****************************************************************************/
 dcgmReturn_t DcgmIpc::ConnectDomain(std::string path, dcgm_connection_id_t &connectionId, unsigned int timeoutMs)
 {
-    connectionId = GetNextConnectionId();
+    connectionId            = GetNextConnectionId();
+    DcgmIpcReactor *reactor = ReactorForConnectionId(connectionId);
 
     /* Using new here because we're transferring it through a C callback. The callback will
        assign this to a unique_ptr and then free it automatically */
-    DcgmIpcConnectDomain *connectDomain = new DcgmIpcConnectDomain(this, path, connectionId);
+    auto *connectDomain = new DcgmIpcReactor::DcgmIpcConnectDomain(reactor, path, connectionId);
 
     std::future<dcgmReturn_t> connectReturn = connectDomain->m_promise.get_future();
 
-    int st = event_base_once(m_eventBase, -1, EV_TIMEOUT, DcgmIpc::ConnectDomainAsyncImplCB, connectDomain, 0);
+    int st = event_base_once(
+        reactor->GetEventBase(), -1, EV_TIMEOUT, DcgmIpcReactor::ConnectDomainAsyncImplCB, connectDomain, 0);
     if (st)
     {
         DCGM_LOG_ERROR << "Got error " << st << " from event_base_once";
@@ -732,9 +855,9 @@ dcgmReturn_t DcgmIpc::ConnectDomain(std::string path, dcgm_connection_id_t &conn
 }
 
 /*****************************************************************************/
-void DcgmIpc::MonitorSocketFdAsyncImpl(DcgmIpcMonitorSocketFd &monitorSocketFd)
+void DcgmIpcReactor::MonitorSocketFdAsyncImpl(DcgmIpcMonitorSocketFd &monitorSocketFd)
 {
-    ASSERT_IS_IPC_THREAD;
+    ASSERT_IS_REACTOR_THREAD;
 
     /* Domain socket */
     DCGM_LOG_DEBUG << "Client trying to monitor socket fd " << monitorSocketFd.m_fd;
@@ -748,7 +871,7 @@ void DcgmIpc::MonitorSocketFdAsyncImpl(DcgmIpcMonitorSocketFd &monitorSocketFd)
     }
 
     /* Track our event before callbacks could be invoked */
-    bufferevent_setcb(bev, DcgmIpc::StaticReadCB, NULL, DcgmIpc::StaticEventCB, this);
+    bufferevent_setcb(bev, DcgmIpcReactor::StaticReadCB, NULL, DcgmIpcReactor::StaticEventCB, this);
     bufferevent_enable(bev, EV_READ | EV_WRITE);
 
     /* Add a tracked connection and remove our pending status */
@@ -771,11 +894,11 @@ void DcgmIpc::MonitorSocketFdAsyncImpl(DcgmIpcMonitorSocketFd &monitorSocketFd)
 }
 
 /*****************************************************************************/
-void DcgmIpc::MonitorSocketFdAsyncImplCB(evutil_socket_t, short, void *data)
+void DcgmIpcReactor::MonitorSocketFdAsyncImplCB(evutil_socket_t, short, void *data)
 {
     std::unique_ptr<DcgmIpcMonitorSocketFd> monitorSocketFd((DcgmIpcMonitorSocketFd *)data);
 
-    monitorSocketFd->m_ipc->MonitorSocketFdAsyncImpl(*monitorSocketFd);
+    monitorSocketFd->m_reactor->MonitorSocketFdAsyncImpl(*monitorSocketFd);
 }
 
 /*****************************************************************************/
@@ -793,16 +916,21 @@ dcgmReturn_t DcgmIpc::MonitorSocketFd(int fd, dcgm_connection_id_t &connectionId
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    connectionId = GetNextConnectionId();
+    connectionId            = GetNextConnectionId();
+    DcgmIpcReactor *reactor = ReactorForConnectionId(connectionId);
 
     /* Using new here because we're transferring it through a C callback. The callback will
        assign this to a unique_ptr and then free it automatically */
-    auto monitorSocketFd = std::make_unique<DcgmIpcMonitorSocketFd>(this, fd, connectionId);
+    auto monitorSocketFd = std::make_unique<DcgmIpcReactor::DcgmIpcMonitorSocketFd>(reactor, fd, connectionId);
 
     std::future<dcgmReturn_t> connectReturn = monitorSocketFd->m_promise.get_future();
 
-    int st
-        = event_base_once(m_eventBase, -1, EV_TIMEOUT, DcgmIpc::MonitorSocketFdAsyncImplCB, monitorSocketFd.get(), 0);
+    int st = event_base_once(reactor->GetEventBase(),
+                             -1,
+                             EV_TIMEOUT,
+                             DcgmIpcReactor::MonitorSocketFdAsyncImplCB,
+                             monitorSocketFd.get(),
+                             0);
     if (st)
     {
         DCGM_LOG_ERROR << "Got error " << st << " from event_base_once. Closing fd " << fd;
@@ -837,7 +965,7 @@ dcgm_connection_id_t DcgmIpc::GetNextConnectionId()
 }
 
 /*****************************************************************************/
-void DcgmIpc::EventCB(struct bufferevent *bev, short events)
+void DcgmIpcReactor::EventCB(struct bufferevent *bev, short events)
 {
     dcgm_connection_id_t connectionId = BevToConnectionId(bev);
     if (connectionId == DCGM_CONNECTION_ID_NONE)
@@ -863,23 +991,23 @@ void DcgmIpc::EventCB(struct bufferevent *bev, short events)
 }
 
 /*****************************************************************************/
-void DcgmIpc::StaticEventCB(struct bufferevent *bev, short events, void *ptr)
+void DcgmIpcReactor::StaticEventCB(struct bufferevent *bev, short events, void *ptr)
 {
-    DcgmIpc *dcgmIpc = (DcgmIpc *)ptr;
-    dcgmIpc->EventCB(bev, events);
+    DcgmIpcReactor *reactor = (DcgmIpcReactor *)ptr;
+    reactor->EventCB(bev, events);
 }
 
 /*****************************************************************************/
-void DcgmIpc::StaticReadCB(struct bufferevent *bev, void *ptr)
+void DcgmIpcReactor::StaticReadCB(struct bufferevent *bev, void *ptr)
 {
-    DcgmIpc *dcgmIpc = (DcgmIpc *)ptr;
-    dcgmIpc->ReadCB(bev);
+    DcgmIpcReactor *reactor = (DcgmIpcReactor *)ptr;
+    reactor->ReadCB(bev);
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmIpc::SetConnectionState(dcgm_connection_id_t connectionId, DcgmIpcConnectionState_t state)
+dcgmReturn_t DcgmIpcReactor::SetConnectionState(dcgm_connection_id_t connectionId, DcgmIpcConnectionState_t state)
 {
-    ASSERT_IS_IPC_THREAD;
+    ASSERT_IS_REACTOR_THREAD;
 
     DcgmIpcConnection *connection = ConnectionIdToPtr(connectionId);
     if (connection == nullptr)
@@ -893,11 +1021,50 @@ dcgmReturn_t DcgmIpc::SetConnectionState(dcgm_connection_id_t connectionId, Dcgm
 }
 
 /*****************************************************************************/
-void DcgmIpc::ProcessMessageInPool(DcgmIpcProcessMessage_t &processMe)
+void DcgmIpc::SetSchedulerParams(DcgmIpcSchedulerParams_t const &params)
+{
+    m_scheduler.SetParams(params);
+}
+
+/*****************************************************************************/
+DcgmIpcSchedulerStats_t DcgmIpc::GetSchedulerStats() const
+{
+    return m_scheduler.GetStats();
+}
+
+/*****************************************************************************/
+void DcgmIpc::ProcessQueuedMessages()
 {
-    std::unique_ptr<DcgmMessage> dcgmMessage(processMe.dcgmMessage);
+    for (auto scheduled = m_scheduler.Pop(); scheduled.has_value(); scheduled = m_scheduler.Pop())
+    {
+        m_processMessageFunc(scheduled->connectionId, std::move(scheduled->message), m_processMessageData);
 
-    processMe.processMessage(processMe.connectionId, std::move(dcgmMessage), processMe.userData);
+        /* If the connection went away while this message was being processed, we
+           were holding back its disconnect until now */
+        if (m_scheduler.Complete(scheduled->connectionId, scheduled->priority))
+        {
+            m_processDisconnectFunc(scheduled->connectionId, m_processDisconnectData);
+        }
+    }
+}
+
+/*****************************************************************************/
+void DcgmIpc::EnqueueMessages(dcgm_connection_id_t connectionId, std::vector<std::unique_ptr<DcgmMessage>> &messages)
+{
+    for (auto &&dcgmMessage : messages)
+    {
+        DcgmIpcPriority_t priority = m_scheduler.Classify(*dcgmMessage);
+        m_scheduler.Push(connectionId, priority, std::move(dcgmMessage));
+
+        /* Each queued message gets a worker task, but the task processes whatever the
+           scheduler picks rather than this particular message */
+        auto const task = m_workersPool.Enqueue([this]() { ProcessQueuedMessages(); });
+        if (!task.has_value())
+        {
+            /* The message stays queued for the next task that runs */
+            DCGM_LOG_ERROR << "Unable to enqueue message";
+        }
+    }
 }
 
 /*****************************************************************************/
@@ -907,7 +1074,25 @@ void DcgmIpc::ProcessDisconnectInPool(DcgmIpcProcessDisconnect_t &processMe)
 }
 
 /*****************************************************************************/
-DcgmIpcConnection *DcgmIpc::ConnectionIdToPtr(dcgm_connection_id_t connectionId)
+void DcgmIpc::EnqueueDisconnect(dcgm_connection_id_t connectionId)
+{
+    /* Messages that this connection already sent must be processed before its disconnect */
+    if (!m_scheduler.MarkDisconnected(connectionId))
+    {
+        DCGM_LOG_DEBUG << "Deferring disconnect of connectionId " << connectionId << " until its messages finish";
+        return;
+    }
+
+    DcgmIpcProcessDisconnect_t pd {};
+    pd.connectionId      = connectionId;
+    pd.processDisconnect = m_processDisconnectFunc;
+    pd.userData          = m_processDisconnectData;
+
+    m_workersPool.Enqueue([pd]() mutable { DcgmIpc::ProcessDisconnectInPool(pd); });
+}
+
+/*****************************************************************************/
+DcgmIpcConnection *DcgmIpcReactor::ConnectionIdToPtr(dcgm_connection_id_t connectionId)
 {
     auto connectionIt = m_connections.find(connectionId);
     if (connectionIt == m_connections.end())
@@ -922,7 +1107,7 @@ DcgmIpcConnection *DcgmIpc::ConnectionIdToPtr(dcgm_connection_id_t connectionId)
 }
 
 /*****************************************************************************/
-void DcgmIpc::ReadCB(bufferevent *bev)
+void DcgmIpcReactor::ReadCB(bufferevent *bev)
 {
     dcgm_connection_id_t connectionId = BevToConnectionId(bev);
     if (connectionId == DCGM_CONNECTION_ID_NONE)
@@ -955,28 +1140,11 @@ void DcgmIpc::ReadCB(bufferevent *bev)
         return;
     }
 
-    DcgmIpcProcessMessage_t processMessage {};
-
-    processMessage.connectionId   = connectionId;
-    processMessage.processMessage = m_processMessageFunc;
-    processMessage.userData       = m_processMessageData;
-
-    for (auto &&dcgmMessage : messages)
-    {
-        processMessage.dcgmMessage = dcgmMessage.release();
-
-        auto const task
-            = m_workersPool.Enqueue([processMessage]() mutable { DcgmIpc::ProcessMessageInPool(processMessage); });
-        if (!task.has_value())
-        {
-            delete processMessage.dcgmMessage; // we are responsible for this memory if the enqueue fails
-            DCGM_LOG_ERROR << "Unable to enqueue message";
-        }
-    }
+    m_ipc->EnqueueMessages(connectionId, messages);
 }
 
 /*****************************************************************************/
-dcgm_connection_id_t DcgmIpc::BevToConnectionId(struct bufferevent *bev)
+dcgm_connection_id_t DcgmIpcReactor::BevToConnectionId(struct bufferevent *bev)
 {
     auto it = m_bevToConnectionId.find(bev);
     if (it == m_bevToConnectionId.end())
@@ -991,9 +1159,11 @@ dcgm_connection_id_t DcgmIpc::BevToConnectionId(struct bufferevent *bev)
 
 /*****************************************************************************/
 DcgmIpcConnection::DcgmIpcConnection(struct bufferevent *bev,
+                                     DcgmIpcReactor *reactor,
                                      DcgmIpcConnectionState_t connectionState,
                                      std::promise<dcgmReturn_t> &&connectPromise)
     : m_bev(bev)
+    , m_reactor(reactor)
     , m_connectionState(connectionState)
     , m_shouldReadHeader(true)
     , m_readHeader({})
@@ -1040,7 +1210,7 @@ void DcgmIpcConnection::SetConnectionState(DcgmIpcConnectionState_t state)
 }
 
 /*****************************************************************************/
-std::unique_ptr<DcgmMessage> DcgmIpcConnection::GetDcgmMessage(void)
+std::unique_ptr<DcgmMessage> DcgmIpcReactor::GetDcgmMessage(void)
 {
     if (m_reuseMessages.size() > 0)
     {
@@ -1055,7 +1225,7 @@ std::unique_ptr<DcgmMessage> DcgmIpcConnection::GetDcgmMessage(void)
 }
 
 /*****************************************************************************/
-void DcgmIpcConnection::CacheOrFreeDcgmMessage(std::unique_ptr<DcgmMessage> msg)
+void DcgmIpcReactor::CacheOrFreeDcgmMessage(std::unique_ptr<DcgmMessage> msg)
 {
     if (m_reuseMessages.size() < MAX_REUSE_MESSAGES_COUNT)
     {
@@ -1128,7 +1298,7 @@ dcgmReturn_t DcgmIpcConnection::ReadMessages(struct bufferevent *bev,
         }
 
         /* Allocate a new DCGM Message */
-        std::unique_ptr<DcgmMessage> dcgmMessage = GetDcgmMessage();
+        std::unique_ptr<DcgmMessage> dcgmMessage = m_reactor->GetDcgmMessage();
         *(dcgmMessage->GetMessageHdr())          = m_readHeader;
 
         auto msgBytes = dcgmMessage->GetMsgBytesPtr();
@@ -1181,30 +1351,31 @@ void DcgmIpc::OnAccept(int listenerFd)
         return;
     }
 
-    /* TCP/IP */
-    struct bufferevent *bev = bufferevent_socket_new(m_eventBase, clientFd, BEV_OPT_CLOSE_ON_FREE);
-    if (bev == nullptr)
-    {
-        DCGM_LOG_ERROR << "Failed to create socket for fd " << clientFd;
-        close(clientFd);
-        return;
-    }
-
+    /* Hand the socket to the reactor that will own it. Connection IDs are handed out
+       sequentially, so this spreads connections round-robin across our reactors. Nobody
+       waits on the promise of an accepted connection. */
     dcgm_connection_id_t connectionId = GetNextConnectionId();
-    /* Add a tracked connection and remove our pending status */
-    dcgmReturn_t dcgmReturn = AddConnection(bev, connectionId, DCGM_IPC_CS_ACTIVE, std::promise<dcgmReturn_t>());
-    if (dcgmReturn != DCGM_ST_OK)
+    DcgmIpcReactor *reactor           = ReactorForConnectionId(connectionId);
+
+    auto monitorSocketFd = std::make_unique<DcgmIpcReactor::DcgmIpcMonitorSocketFd>(reactor, clientFd, connectionId);
+
+    int st = event_base_once(reactor->GetEventBase(),
+                             -1,
+                             EV_TIMEOUT,
+                             DcgmIpcReactor::MonitorSocketFdAsyncImplCB,
+                             monitorSocketFd.get(),
+                             0);
+    if (st)
     {
-        DCGM_LOG_ERROR << "Failed to AddConnection connectionId" << connectionId;
-        bufferevent_free(bev); /* This auto closes clientFd */
+        DCGM_LOG_ERROR << "Got error " << st << " from event_base_once. Closing fd " << clientFd;
+        close(clientFd);
         return;
     }
 
-    /* Track our event before callbacks could be invoked */
-    bufferevent_setcb(bev, DcgmIpc::StaticReadCB, NULL, DcgmIpc::StaticEventCB, this);
-    bufferevent_enable(bev, EV_READ | EV_WRITE);
+    /* coverity[leaked_storage] No longer owned by us on success */
+    monitorSocketFd.release();
 
-    DCGM_LOG_DEBUG << "Server connection accepted with connectionId " << connectionId << " bev " << bev;
+    DCGM_LOG_DEBUG << "Server connection accepted with connectionId " << connectionId << " fd " << clientFd;
 }
 
 /*****************************************************************************/
@@ -1216,9 +1387,9 @@ void DcgmIpc::StaticOnAccept(int listenFd, short /*ev*/, void *userData)
 }
 
 /*****************************************************************************/
-void DcgmIpc::SendMessageImpl(DcgmIpcSendMessage &sendMessage)
+void DcgmIpcReactor::SendMessageImpl(DcgmIpcSendMessage &sendMessage)
 {
-    ASSERT_IS_IPC_THREAD;
+    ASSERT_IS_REACTOR_THREAD;
 
     /* TCP/IP */
     DCGM_LOG_DEBUG << "Sending message to " << sendMessage.m_connectionId;
@@ -1236,11 +1407,11 @@ void DcgmIpc::SendMessageImpl(DcgmIpcSendMessage &sendMessage)
 }
 
 /*****************************************************************************/
-void DcgmIpc::SendMessageImplCB(evutil_socket_t, short, void *data)
+void DcgmIpcReactor::SendMessageImplCB(evutil_socket_t, short, void *data)
 {
     std::unique_ptr<DcgmIpcSendMessage> sendMessage((DcgmIpcSendMessage *)data);
 
-    sendMessage->m_ipc->SendMessageImpl(*sendMessage);
+    sendMessage->m_reactor->SendMessageImpl(*sendMessage);
 }
 
 /*****************************************************************************/
@@ -1248,12 +1419,15 @@ dcgmReturn_t DcgmIpc::SendMessage(dcgm_connection_id_t connectionId,
                                   std::unique_ptr<DcgmMessage> message,
                                   bool waitForSend)
 {
+    DcgmIpcReactor *reactor = ReactorForConnectionId(connectionId);
+
     /* Using new here because we're transferring it through a C callback */
-    DcgmIpcSendMessage *sendMessage = new DcgmIpcSendMessage(this, connectionId, std::move(message));
+    auto *sendMessage = new DcgmIpcReactor::DcgmIpcSendMessage(reactor, connectionId, std::move(message));
 
     auto sendMessageFuture = sendMessage->m_promise.get_future();
 
-    int st = event_base_once(m_eventBase, -1, EV_TIMEOUT, DcgmIpc::SendMessageImplCB, sendMessage, 0);
+    int st
+        = event_base_once(reactor->GetEventBase(), -1, EV_TIMEOUT, DcgmIpcReactor::SendMessageImplCB, sendMessage, 0);
     if (st)
     {
         DCGM_LOG_ERROR << "Got error " << st << " from event_base_once";
@@ -1287,7 +1461,7 @@ dcgmReturn_t DcgmIpcConnection::SendMessage(std::unique_ptr<DcgmMessage> dcgmMes
 
 
     /* Note that we're only able to do these calls in succession because
-       we only write to connections from a single thread. Otherwise, we'd have
+       we only write to a connection from the thread of the reactor that owns it. Otherwise, we'd have
        to stage the entire message in an evbuffer and call bufferevent_write_buffer */
     int st  = bufferevent_write(m_bev, msgHdr, sizeof(*msgHdr));
     int st2 = bufferevent_write(m_bev, msgBytes->data(), msgBytes->size());
@@ -1297,16 +1471,16 @@ dcgmReturn_t DcgmIpcConnection::SendMessage(std::unique_ptr<DcgmMessage> dcgmMes
         return DCGM_ST_CONNECTION_NOT_VALID;
     }
 
-    /* Possibly save the message object for reuse */
-    CacheOrFreeDcgmMessage(std::move(dcgmMessage));
+    /* Possibly save the message object for reuse by any connection of this reactor */
+    m_reactor->CacheOrFreeDcgmMessage(std::move(dcgmMessage));
 
     return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-void DcgmIpc::CloseConnectionImpl(DcgmIpcCloseConnection &closeConnection)
+void DcgmIpcReactor::CloseConnectionImpl(DcgmIpcCloseConnection &closeConnection)
 {
-    ASSERT_IS_IPC_THREAD;
+    ASSERT_IS_REACTOR_THREAD;
 
     dcgmReturn_t dcgmReturn = RemoveConnectionById(closeConnection.m_connectionId);
     if (dcgmReturn != DCGM_ST_OK)
@@ -1321,21 +1495,24 @@ void DcgmIpc::CloseConnectionImpl(DcgmIpcCloseConnection &closeConnection)
 }
 
 /*****************************************************************************/
-void DcgmIpc::CloseConnectionImplCB(evutil_socket_t, short, void *data)
+void DcgmIpcReactor::CloseConnectionImplCB(evutil_socket_t, short, void *data)
 {
     std::unique_ptr<DcgmIpcCloseConnection> closeConnection((DcgmIpcCloseConnection *)data);
 
-    closeConnection->m_ipc->CloseConnectionImpl(*closeConnection);
+    closeConnection->m_reactor->CloseConnectionImpl(*closeConnection);
 }
 
 /*****************************************************************************/
 dcgmReturn_t DcgmIpc::CloseConnection(dcgm_connection_id_t connectionId)
 {
+    DcgmIpcReactor *reactor = ReactorForConnectionId(connectionId);
+
     /* Using new here because we're transferring it through a C callback. The callback will
        assign this to a unique_ptr and then free it automatically */
-    DcgmIpcCloseConnection *closeConnection = new DcgmIpcCloseConnection(this, connectionId);
+    auto *closeConnection = new DcgmIpcReactor::DcgmIpcCloseConnection(reactor, connectionId);
 
-    int st = event_base_once(m_eventBase, -1, EV_TIMEOUT, DcgmIpc::CloseConnectionImplCB, closeConnection, 0);
+    int st = event_base_once(
+        reactor->GetEventBase(), -1, EV_TIMEOUT, DcgmIpcReactor::CloseConnectionImplCB, closeConnection, 0);
     if (st)
     {
         DCGM_LOG_ERROR << "Got error " << st << " from event_base_once";
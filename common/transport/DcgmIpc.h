@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "DcgmIpcScheduler.h"
 #include "DcgmProtocol.h"
 #include <DcgmThread.h>
 #include <ThreadPool.hpp>
@@ -28,10 +29,12 @@
 #include <event2/thread.h>
 #include <functional>
 #include <future>
+#include <memory>
 #include <optional>
 #include <stack>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 typedef struct
 {
@@ -71,23 +74,17 @@ typedef std::function<void(dcgm_connection_id_t, std::unique_ptr<DcgmMessage>, v
    This will be invoked on a separate worker pool */
 typedef std::function<void(dcgm_connection_id_t, void *userData)> DcgmIpcProcessDisconnectFunc_f;
 
+class DcgmIpcReactor;
+
 class DcgmIpcConnection
 {
 private:
     struct bufferevent *m_bev;
+    DcgmIpcReactor *m_reactor; /* Reactor this connection is serviced by. Not owned here */
     DcgmIpcConnectionState_t m_connectionState;
     bool m_shouldReadHeader;            /* Should we read the message header next (true) or the message body (false) */
     dcgm_message_header_t m_readHeader; /* Header of the message we are currently reading. This gets updated
                                            by ReadMessages */
-    std::stack<std::unique_ptr<DcgmMessage>> m_reuseMessages; /* Reuse messages rather than allocating and freeing them.
-                                                                 Capacity is controlled with MAX_REUSE_MESSAGES_COUNT */
-
-    static const size_t MAX_REUSE_MESSAGES_COUNT
-        = 10; /* Maximum number of DcgmMessages we're willing to keep cached for reuse */
-
-    /* Helpers to get/free a DcgmMessage object, possibly using the m_reuseMessages cache */
-    std::unique_ptr<DcgmMessage> GetDcgmMessage(void);
-    void CacheOrFreeDcgmMessage(std::unique_ptr<DcgmMessage> msg);
 
 public:
     /* Promise used for async connect. Making this public for ease of use as a private class */
@@ -95,6 +92,7 @@ public:
 
     /* Constructor and destructor */
     DcgmIpcConnection(struct bufferevent *bev,
+                      DcgmIpcReactor *reactor,
                       DcgmIpcConnectionState_t connectionState,
                       std::promise<dcgmReturn_t> &&connectPromise);
     ~DcgmIpcConnection();
@@ -102,22 +100,227 @@ public:
     dcgmReturn_t SendMessage(std::unique_ptr<DcgmMessage> dcgmMessage);
     void SetConnectionState(DcgmIpcConnectionState_t state);
     dcgmReturn_t ReadMessages(struct bufferevent *bev, std::vector<std::unique_ptr<DcgmMessage>> &messages);
+    struct bufferevent *GetBev() const
+    {
+        return m_bev;
+    }
+};
+
+class DcgmIpc;
+
+/*****************************************************************************/
+/* A reactor is a libevent event base plus the connections whose sockets are
+   serviced by it. All reads, message framing and writes for a connection happen
+   on the thread of the reactor that owns it.
+
+   Reactor 0 runs its event loop on the DcgmIpc thread itself and also owns the
+   listening sockets. Any additional reactors run on their own threads. */
+class DcgmIpcReactor : public DcgmThread
+{
+private:
+    DcgmIpc *m_ipc;              /* Instance of DcgmIpc this is associated with. Not owned here */
+    unsigned int m_reactorIndex; /* Index of this reactor in DcgmIpc::m_reactors */
+    event_base *m_eventBase;     /* libevent base class instance */
+    pthread_t m_threadId;        /* ID of the thread running our event loop */
+
+    /* Tracking of connections - These should only be changed from this reactor's thread.
+       Use the ASSERT_IS_REACTOR_THREAD macro to verify you are in the reactor thread before
+       reading or writing any of the following. */
+    std::unordered_map<struct bufferevent *, dcgm_connection_id_t> m_bevToConnectionId;
+    std::unordered_map<dcgm_connection_id_t, std::unique_ptr<DcgmIpcConnection>> m_connections;
+
+    std::stack<std::unique_ptr<DcgmMessage>> m_reuseMessages; /* Reuse messages rather than allocating and freeing them.
+                                                                 These are shared by every connection of this reactor.
+                                                                 Capacity is controlled with MAX_REUSE_MESSAGES_COUNT */
+
+    static const size_t MAX_REUSE_MESSAGES_COUNT
+        = 64; /* Maximum number of DcgmMessages we're willing to keep cached for reuse per reactor */
+
+public:
+    /*************************************************************************/
+    DcgmIpcReactor(DcgmIpc *ipc, unsigned int reactorIndex);
+    ~DcgmIpcReactor();
+
+    /*************************************************************************/
+    /* Soft constructor. Allocates our event base. Returns DCGM_ST_OK on success */
+    dcgmReturn_t Init();
+
+    /*************************************************************************/
+    /* Inherited from DcgmThread(). Only used for reactors other than reactor 0 */
+    void OnStop() override;
+    void run() override;
+
+    /*************************************************************************/
+    /* Run our event loop on the calling thread until event_base_loopexit() is called.
+       All connections of this reactor are closed before this returns */
+    void RunEventLoop();
+
+    /*************************************************************************/
+    event_base *GetEventBase()
+    {
+        return m_eventBase;
+    }
+
+    /*************************************************************************/
+    /* Helpers to get/free a DcgmMessage object, possibly using the m_reuseMessages cache.
+       These are only safe to call from this reactor's thread */
+    std::unique_ptr<DcgmMessage> GetDcgmMessage(void);
+    void CacheOrFreeDcgmMessage(std::unique_ptr<DcgmMessage> msg);
+
+    /*****************************************************************************/
+    class DcgmIpcConnectTcp
+    {
+    public:
+        DcgmIpcReactor *m_reactor;            /* Reactor that will own this connection. Not owned here */
+        std::string m_hostname;               /* Hostname to connect to */
+        int m_port;                           /* Port to connect to */
+        dcgm_connection_id_t m_connectionId;  /* Connection ID that was assigned to this
+                                             pending connect */
+        std::promise<dcgmReturn_t> m_promise; /* Promise used to return if we connected or not */
+
+        DcgmIpcConnectTcp(DcgmIpcReactor *reactor, std::string hostname, int port, dcgm_connection_id_t connectionId)
+            : m_reactor(reactor)
+            , m_hostname(hostname)
+            , m_port(port)
+            , m_connectionId(connectionId)
+        {}
+    };
+
+    static void ConnectTcpAsyncImplCB(evutil_socket_t, short, void *data);
+
+    /*****************************************************************************/
+    class DcgmIpcConnectDomain
+    {
+    public:
+        DcgmIpcReactor *m_reactor;            /* Reactor that will own this connection. Not owned here */
+        std::string m_path;                   /* Path to the unix socket to open */
+        dcgm_connection_id_t m_connectionId;  /* Connection ID that was assigned to this
+                                             pending connect */
+        std::promise<dcgmReturn_t> m_promise; /* Promise used to return if we connected or not */
+
+        DcgmIpcConnectDomain(DcgmIpcReactor *reactor, std::string path, dcgm_connection_id_t connectionId)
+            : m_reactor(reactor)
+            , m_path(path)
+            , m_connectionId(connectionId)
+        {}
+    };
+
+    static void ConnectDomainAsyncImplCB(evutil_socket_t, short, void *data);
+
+    /*****************************************************************************/
+    struct DcgmIpcMonitorSocketFd
+    {
+    public:
+        DcgmIpcReactor *m_reactor;            /* Reactor that will own this connection. Not owned here */
+        int m_fd;                             /* File descriptor to monitor */
+        dcgm_connection_id_t m_connectionId;  /* Connection ID that was assigned to this
+                                             pending connect */
+        std::promise<dcgmReturn_t> m_promise; /* Promise used to return if we connected or not */
+
+        DcgmIpcMonitorSocketFd(DcgmIpcReactor *reactor, int fd, dcgm_connection_id_t connectionId)
+            : m_reactor(reactor)
+            , m_fd(fd)
+            , m_connectionId(connectionId)
+        {}
+    };
+
+    static void MonitorSocketFdAsyncImplCB(evutil_socket_t, short, void *data);
+
+    /*****************************************************************************/
+    class DcgmIpcSendMessage
+    {
+    public:
+        DcgmIpcReactor *m_reactor;              /* Reactor that owns m_connectionId. Not owned here */
+        dcgm_connection_id_t m_connectionId;    /* Connection to send the message to */
+        std::unique_ptr<DcgmMessage> m_message; /* Message to send */
+        std::promise<dcgmReturn_t> m_promise;   /* Promise used to return if we connected or not */
+
+        DcgmIpcSendMessage(DcgmIpcReactor *reactor,
+                           dcgm_connection_id_t connectionId,
+                           std::unique_ptr<DcgmMessage> message)
+            : m_reactor(reactor)
+            , m_connectionId(connectionId)
+            , m_message(std::move(message))
+        {}
+    };
+
+    static void SendMessageImplCB(evutil_socket_t, short, void *data);
+
+    /*****************************************************************************/
+    class DcgmIpcCloseConnection
+    {
+    public:
+        DcgmIpcReactor *m_reactor;           /* Reactor that owns m_connectionId. Not owned here */
+        dcgm_connection_id_t m_connectionId; /* Connection to close */
+
+        DcgmIpcCloseConnection(DcgmIpcReactor *reactor, dcgm_connection_id_t connectionId)
+            : m_reactor(reactor)
+            , m_connectionId(connectionId)
+        {}
+    };
+
+    static void CloseConnectionImplCB(evutil_socket_t, short, void *data);
+
+private:
+    /*************************************************************************/
+    /* Track and untrack connections */
+    dcgmReturn_t AddConnection(struct bufferevent *bev,
+                               dcgm_connection_id_t connectionId,
+                               DcgmIpcConnectionState_t initialConnState,
+                               std::promise<dcgmReturn_t> connectPromise);
+    dcgmReturn_t RemoveConnectionByBev(struct bufferevent *bev);
+    dcgmReturn_t RemoveConnectionById(dcgm_connection_id_t connectionId);
+    dcgmReturn_t SetConnectionState(dcgm_connection_id_t connectionId, DcgmIpcConnectionState_t state);
+
+    /*************************************************************************/
+    /* Implementations of the async requests above. These run on this reactor's thread */
+    void ConnectTcpAsyncImpl(DcgmIpcConnectTcp &tcpConnect);
+    void ConnectDomainAsyncImpl(DcgmIpcConnectDomain &domainConnect);
+    void MonitorSocketFdAsyncImpl(DcgmIpcMonitorSocketFd &monitorFd);
+    void SendMessageImpl(DcgmIpcSendMessage &sendMessage);
+    void CloseConnectionImpl(DcgmIpcCloseConnection &closeConnection);
+
+    /*************************************************************************/
+    /* Libevent eventCB. Called on connect/disconnect */
+    static void StaticEventCB(struct bufferevent *bev, short events, void *ptr);
+    void EventCB(struct bufferevent *bev, short events);
+
+    /*************************************************************************/
+    /* Libevent readCB. Called when data is read from a socket */
+    static void StaticReadCB(struct bufferevent *bev, void *ptr);
+    void ReadCB(bufferevent *bev);
+
+    /*************************************************************************/
+    /* Helper methods for converting a bev or connectionId to a pointer to a DcgmIpcConnection object
+       These are only safe to call from this reactor's thread */
+    dcgm_connection_id_t BevToConnectionId(struct bufferevent *bev);
+    DcgmIpcConnection *ConnectionIdToPtr(dcgm_connection_id_t connectionId);
 };
 
 class DcgmIpc : public DcgmThread
 {
 private:
-    /* libevent base class instance */
-    event_base *m_eventBase;
+    friend class DcgmIpcReactor;
+
     evdns_base *m_dnsBase;
     struct event *m_tcpListenEvent;
     struct event *m_domainListenEvent;
 
+    /* Reactors that service our connections. This is sized at construction and never
+       resized, so it's safe to read from any thread. m_reactors[0] runs on our own
+       thread and owns the listening sockets. A connection is owned by
+       m_reactors[connectionId % m_reactors.size()] for its entire lifetime. */
+    std::vector<std::unique_ptr<DcgmIpcReactor>> m_reactors;
+
     /* Optional parameters for TCP/IP and domain socket listener sockets.
        If these are not set, then don't start a listening server */
     std::optional<DcgmIpcTcpServerParams_t> m_tcpParameters;
     std::optional<DcgmIpcDomainServerParams_t> m_domainParameters;
 
+    /* Queue that decides which received message a worker processes next. This is
+       declared before m_workersPool since queued worker tasks refer to it */
+    DcgmIpcScheduler m_scheduler;
+
     /* Worker threads where cllbacks like
        ProcessMessage() and OnClientDisconnect() are called from */
     DcgmNs::ThreadPool m_workersPool;
@@ -143,12 +346,6 @@ private:
        GetNextConnectionId() to access this */
     std::atomic<dcgm_connection_id_t> m_connectionId = DCGM_CONNECTION_ID_NONE;
 
-    /* Tracking of connections - These should only be changed from the IPC thread.
-       Use the ASSERT_IS_IPC_THREAD macro to verify you are in the IPC thread before
-       reading or writing any of the following. */
-    std::unordered_map<struct bufferevent *, dcgm_connection_id_t> m_bevToConnectionId;
-    std::unordered_map<dcgm_connection_id_t, std::unique_ptr<DcgmIpcConnection>> m_connections;
-
     /* Start-up promise. gets set by worker thread after init finishes or fails */
     std::promise<dcgmReturn_t> m_initPromise;
 
@@ -157,8 +354,19 @@ public:
        since the beginning of DCGM */
     static const int DCGM_IPC_CONNECTION_BACKLOG = 6;
 
+    /* Maximum number of reactors (event bases / IO threads) a DcgmIpc instance can have */
+    static const unsigned int DCGM_IPC_MAX_REACTORS = 32;
+
     /*************************************************************************/
-    explicit DcgmIpc(int numWorkerThreads);
+    /*
+     * Constructor
+     *
+     * numWorkerThreads IN: How many threads to process messages and disconnects on
+     * numReactors      IN: How many event bases (each with its own IO thread) to
+     *                      spread connections across. Clamped to
+     *                      [1, DCGM_IPC_MAX_REACTORS]
+     */
+    explicit DcgmIpc(int numWorkerThreads, unsigned int numReactors = 1);
     ~DcgmIpc();
 
     /*************************************************************************/
@@ -175,6 +383,25 @@ public:
                       DcgmIpcProcessDisconnectFunc_f processDisconnectFunc,
                       void *processDisconnectData);
 
+    /*************************************************************************/
+    /* Set how received messages are prioritized and limited before they are handed
+     * to the worker pool. This must be called before Init(). If it's never called,
+     * messages are served round robin across connections with no in-flight limits.
+     */
+    void SetSchedulerParams(DcgmIpcSchedulerParams_t const &params);
+
+    /*************************************************************************/
+    /* Get how many messages of each priority class have been processed and how long
+       they waited in the queue before a worker picked them up */
+    DcgmIpcSchedulerStats_t GetSchedulerStats() const;
+
+    /*************************************************************************/
+    /* Get the number of reactors this instance is spreading connections across */
+    unsigned int GetNumReactors() const
+    {
+        return m_reactors.size();
+    }
+
     /*************************************************************************/
     /* Connect to a TCP/IP Host
      *
@@ -253,121 +480,12 @@ private:
     dcgm_connection_id_t GetNextConnectionId();
 
     /*************************************************************************/
-    /* Track and untrack connections */
-    dcgmReturn_t AddConnection(struct bufferevent *bev,
-                               dcgm_connection_id_t connectionId,
-                               DcgmIpcConnectionState_t initialConnState,
-                               std::promise<dcgmReturn_t> connectPromise);
-    dcgmReturn_t RemoveConnectionByBev(struct bufferevent *bev);
-    dcgmReturn_t RemoveConnectionById(dcgm_connection_id_t connectionId);
-    dcgmReturn_t SetConnectionState(dcgm_connection_id_t connectionId, DcgmIpcConnectionState_t state);
-
-    /*****************************************************************************/
-    class DcgmIpcConnectTcp
-    {
-    public:
-        DcgmIpc *m_ipc;                       /* Instance of DcgmIpc this is associated with. Not owned here */
-        std::string m_hostname;               /* Hostname to connect to */
-        int m_port;                           /* Port to connect to */
-        dcgm_connection_id_t m_connectionId;  /* Connection ID that was assigned to this
-                                             pending connect */
-        std::promise<dcgmReturn_t> m_promise; /* Promise used to return if we connected or not */
-
-        DcgmIpcConnectTcp(DcgmIpc *ipc, std::string hostname, int port, dcgm_connection_id_t connectionId)
-            : m_ipc(ipc)
-            , m_hostname(hostname)
-            , m_port(port)
-            , m_connectionId(connectionId)
-        {}
-    };
-
-    static void ConnectTcpAsyncImplCB(evutil_socket_t, short, void *data);
-    void ConnectTcpAsyncImpl(DcgmIpcConnectTcp &tcpConnect);
-
-    /*****************************************************************************/
-    class DcgmIpcConnectDomain
-    {
-    public:
-        DcgmIpc *m_ipc;                       /* Instance of DcgmIpc this is associated with. Not owned here */
-        std::string m_path;                   /* Path to the unix socket to open */
-        dcgm_connection_id_t m_connectionId;  /* Connection ID that was assigned to this
-                                             pending connect */
-        std::promise<dcgmReturn_t> m_promise; /* Promise used to return if we connected or not */
-
-        DcgmIpcConnectDomain(DcgmIpc *ipc, std::string path, dcgm_connection_id_t connectionId)
-            : m_ipc(ipc)
-            , m_path(path)
-            , m_connectionId(connectionId)
-        {}
-    };
-
-    static void ConnectDomainAsyncImplCB(evutil_socket_t, short, void *data);
-    void ConnectDomainAsyncImpl(DcgmIpcConnectDomain &domainConnect);
-
-    /*****************************************************************************/
-    struct DcgmIpcMonitorSocketFd
-    {
-    public:
-        DcgmIpc *m_ipc;                       /* Instance of DcgmIpc this is associated with. Not owned here */
-        int m_fd;                             /* File descriptor to monitor */
-        dcgm_connection_id_t m_connectionId;  /* Connection ID that was assigned to this
-                                             pending connect */
-        std::promise<dcgmReturn_t> m_promise; /* Promise used to return if we connected or not */
-
-        DcgmIpcMonitorSocketFd(DcgmIpc *ipc, int fd, dcgm_connection_id_t connectionId)
-            : m_ipc(ipc)
-            , m_fd(fd)
-            , m_connectionId(connectionId)
-        {}
-    };
-
-    static void MonitorSocketFdAsyncImplCB(evutil_socket_t, short, void *data);
-    void MonitorSocketFdAsyncImpl(DcgmIpcMonitorSocketFd &monitorFd);
-
-    /*****************************************************************************/
-    class DcgmIpcSendMessage
-    {
-    public:
-        DcgmIpc *m_ipc;                         /* Instance of DcgmIpc this is associated with. Not owned here */
-        dcgm_connection_id_t m_connectionId;    /* Connection to send the message to */
-        std::unique_ptr<DcgmMessage> m_message; /* Message to send */
-        std::promise<dcgmReturn_t> m_promise;   /* Promise used to return if we connected or not */
-
-        DcgmIpcSendMessage(DcgmIpc *ipc, dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message)
-            : m_ipc(ipc)
-            , m_connectionId(connectionId)
-            , m_message(std::move(message))
-        {}
-    };
-
-    static void SendMessageImplCB(evutil_socket_t, short, void *data);
-    void SendMessageImpl(DcgmIpcSendMessage &sendMessage);
-
-    /*****************************************************************************/
-    class DcgmIpcCloseConnection
-    {
-    public:
-        DcgmIpc *m_ipc;                      /* Instance of DcgmIpc this is associated with. Not owned here */
-        dcgm_connection_id_t m_connectionId; /* Connection to close */
-
-        DcgmIpcCloseConnection(DcgmIpc *ipc, dcgm_connection_id_t connectionId)
-            : m_ipc(ipc)
-            , m_connectionId(connectionId)
-        {}
-    };
-
-    static void CloseConnectionImplCB(evutil_socket_t, short, void *data);
-    void CloseConnectionImpl(DcgmIpcCloseConnection &closeConnection);
-
-    /*************************************************************************/
-    /* Libevent eventCB. Called on connect/disconnect */
-    static void StaticEventCB(struct bufferevent *bev, short events, void *ptr);
-    void EventCB(struct bufferevent *bev, short events);
+    /* Get the reactor that owns a given connectionId. Safe to call from any thread */
+    DcgmIpcReactor *ReactorForConnectionId(dcgm_connection_id_t connectionId);
 
     /*************************************************************************/
-    /* Libevent readCB. Called when data is read from a socket */
-    static void StaticReadCB(struct bufferevent *bev, void *ptr);
-    void ReadCB(bufferevent *bev);
+    /* Stop and join every reactor that runs on its own thread */
+    void StopReactorThreads();
 
     /*************************************************************************/
     /* Libevent acceptCB. Called when a new connection is ready to accept */
@@ -375,23 +493,14 @@ private:
     void OnAccept(int fd);
 
     /*************************************************************************/
-    /* Helper methods for converting a bev or connectionId to a pointer to a DcgmIpcConnection object
-       These are only safe to call from the IPC main thread */
-    dcgm_connection_id_t BevToConnectionId(struct bufferevent *bev);
-    DcgmIpcConnection *ConnectionIdToPtr(dcgm_connection_id_t connectionId);
+    /* Worker pool task. Processes queued messages in the order m_scheduler picks them
+       until nothing is left that can be dispatched. We process messages outside of
+       the IPC thread to avoid deadlocks and keep sockets responsive */
+    void ProcessQueuedMessages();
 
     /*************************************************************************/
-    /* Function to call to process a message in our worker pool. We queue this outside
-       of the IPC thread to avoid deadlocks and keep sockets responsive */
-    typedef struct
-    {
-        dcgm_connection_id_t connectionId;          /* Connection this message came from */
-        DcgmMessage *dcgmMessage;                   /* Message to process */
-        DcgmIpcProcessMessageFunc_f processMessage; /* Function to call with the message */
-        void *userData;                             /* User context pointer that was passed to Init() */
-    } DcgmIpcProcessMessage_t;
-
-    static void ProcessMessageInPool(DcgmIpcProcessMessage_t &processMe);
+    /* Queue messages that a reactor read from connectionId for our worker pool */
+    void EnqueueMessages(dcgm_connection_id_t connectionId, std::vector<std::unique_ptr<DcgmMessage>> &messages);
 
     /*************************************************************************/
     /* Function to call to process a client disconnect in our worker pool. We queue this outside
@@ -405,6 +514,10 @@ private:
 
     static void ProcessDisconnectInPool(DcgmIpcProcessDisconnect_t &processMe);
 
+    /*************************************************************************/
+    /* Tell our parent that connectionId went away. Called by reactors */
+    void EnqueueDisconnect(dcgm_connection_id_t connectionId);
+
     /*************************************************************************/
     /* Helper method to wait for a connection future for a given timeout */
     dcgmReturn_t WaitForConnectHelper(dcgm_connection_id_t connectionId,
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmIpcScheduler.h"
+#include <DcgmLogging.h>
+
+#include <algorithm>
+
+/*****************************************************************************/
+DcgmIpcScheduler::DcgmIpcScheduler()
+{
+    for (unsigned int i = 0; i < DCGM_IPC_PRIORITY_COUNT; i++)
+    {
+        m_params.weights[i] = 1;
+    }
+}
+
+/*****************************************************************************/
+void DcgmIpcScheduler::SetParams(DcgmIpcSchedulerParams_t const &params)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_params = params;
+    for (unsigned int i = 0; i < DCGM_IPC_PRIORITY_COUNT; i++)
+    {
+        m_params.weights[i] = std::max(m_params.weights[i], 1U);
+        m_credits[i]        = m_params.weights[i];
+    }
+}
+
+/*****************************************************************************/
+DcgmIpcPriority_t DcgmIpcScheduler::Classify(DcgmMessage &message) const
+{
+    /* m_params is only written before messages flow, so this doesn't need m_mutex */
+    if (!m_params.classify)
+    {
+        return DCGM_IPC_PRIORITY_NORMAL;
+    }
+
+    DcgmIpcPriority_t priority = m_params.classify(message);
+    if (priority < DCGM_IPC_PRIORITY_HIGH || priority >= DCGM_IPC_PRIORITY_COUNT)
+    {
+        DCGM_LOG_ERROR << "Classifier returned invalid priority " << priority;
+        return DCGM_IPC_PRIORITY_NORMAL;
+    }
+
+    return priority;
+}
+
+/*****************************************************************************/
+void DcgmIpcScheduler::Push(dcgm_connection_id_t connectionId,
+                            DcgmIpcPriority_t priority,
+                            std::unique_ptr<DcgmMessage> message)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ConnectionState &connection = m_connections[connectionId];
+    if (connection.queues[priority].empty())
+    {
+        m_activeConnections[priority].push_back(connectionId);
+    }
+
+    connection.queues[priority].push_back({ std::move(message), std::chrono::steady_clock::now() });
+    connection.numQueued++;
+    m_stats.classes[priority].numQueued++;
+}
+
+/*****************************************************************************/
+bool DcgmIpcScheduler::CanDispatch(ConnectionState const &connection, DcgmIpcPriority_t priority) const
+{
+    /* High priority messages are never held back. That's what keeps a liveness probe
+       responsive while its connection has a long running request in flight */
+    if (priority == DCGM_IPC_PRIORITY_HIGH)
+    {
+        return true;
+    }
+
+    if (m_params.maxInFlightPerConnection != 0 && connection.numInFlight >= m_params.maxInFlightPerConnection)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+std::optional<DcgmIpcScheduledMessage_t> DcgmIpcScheduler::PopFromClass(DcgmIpcPriority_t priority)
+{
+    if (priority != DCGM_IPC_PRIORITY_HIGH && m_params.maxSharedInFlight != 0
+        && m_sharedInFlight >= m_params.maxSharedInFlight)
+    {
+        return std::nullopt;
+    }
+
+    auto &activeConnections = m_activeConnections[priority];
+
+    /* Visit each active connection at most once, rotating the ones we skip to the back */
+    for (size_t i = 0, numActive = activeConnections.size(); i < numActive; i++)
+    {
+        dcgm_connection_id_t connectionId = activeConnections.front();
+        activeConnections.pop_front();
+
+        auto connectionIt = m_connections.find(connectionId);
+        if (connectionIt == m_connections.end())
+        {
+            DCGM_LOG_ERROR << "Active connectionId " << connectionId << " has no state";
+            continue;
+        }
+
+        ConnectionState &connection = connectionIt->second;
+        if (!CanDispatch(connection, priority))
+        {
+            activeConnections.push_back(connectionId);
+            continue;
+        }
+
+        QueuedMessage queued = std::move(connection.queues[priority].front());
+        connection.queues[priority].pop_front();
+        connection.numQueued--;
+        if (!connection.queues[priority].empty())
+        {
+            activeConnections.push_back(connectionId);
+        }
+
+        if (priority == DCGM_IPC_PRIORITY_HIGH)
+        {
+            connection.numInFlightHigh++;
+        }
+        else
+        {
+            connection.numInFlight++;
+            m_sharedInFlight++;
+        }
+
+        auto waitTime = std::chrono::steady_clock::now() - queued.enqueueTime;
+        auto waitUsec = (unsigned long long)std::chrono::duration_cast<std::chrono::microseconds>(waitTime).count();
+
+        DcgmIpcClassStats_t &stats = m_stats.classes[priority];
+        stats.numQueued--;
+        stats.numDispatched++;
+        stats.totalWaitUsec += waitUsec;
+        stats.maxWaitUsec    = std::max(stats.maxWaitUsec, waitUsec);
+
+        return DcgmIpcScheduledMessage_t { connectionId, priority, std::move(queued.message) };
+    }
+
+    return std::nullopt;
+}
+
+/*****************************************************************************/
+std::optional<DcgmIpcScheduledMessage_t> DcgmIpcScheduler::Pop()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    /* Weighted round robin. Each class can be served as many times per round as its weight,
+       higher priority classes first. Once no class with credits left has anything we can
+       dispatch, start a new round and try once more */
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        for (unsigned int i = 0; i < DCGM_IPC_PRIORITY_COUNT; i++)
+        {
+            if (m_credits[i] == 0)
+            {
+                continue;
+            }
+
+            auto scheduled = PopFromClass((DcgmIpcPriority_t)i);
+            if (scheduled.has_value())
+            {
+                m_credits[i]--;
+                return scheduled;
+            }
+        }
+
+        for (unsigned int i = 0; i < DCGM_IPC_PRIORITY_COUNT; i++)
+        {
+            m_credits[i] = m_params.weights[i];
+        }
+    }
+
+    return std::nullopt;
+}
+
+/*****************************************************************************/
+bool DcgmIpcScheduler::RemoveIfFinished(dcgm_connection_id_t connectionId, ConnectionState const &connection)
+{
+    if (!connection.disconnected || connection.numQueued != 0 || connection.numInFlight != 0
+        || connection.numInFlightHigh != 0)
+    {
+        return false;
+    }
+
+    m_connections.erase(connectionId);
+    return true;
+}
+
+/*****************************************************************************/
+bool DcgmIpcScheduler::Complete(dcgm_connection_id_t connectionId, DcgmIpcPriority_t priority)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto connectionIt = m_connections.find(connectionId);
+    if (connectionIt == m_connections.end())
+    {
+        DCGM_LOG_ERROR << "Completed message for unknown connectionId " << connectionId;
+        return false;
+    }
+
+    ConnectionState &connection = connectionIt->second;
+    if (priority == DCGM_IPC_PRIORITY_HIGH)
+    {
+        connection.numInFlightHigh--;
+    }
+    else
+    {
+        connection.numInFlight--;
+        m_sharedInFlight--;
+    }
+
+    return RemoveIfFinished(connectionId, connection);
+}
+
+/*****************************************************************************/
+bool DcgmIpcScheduler::MarkDisconnected(dcgm_connection_id_t connectionId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto connectionIt = m_connections.find(connectionId);
+    if (connectionIt == m_connections.end())
+    {
+        return true; /* We never saw a message from this connection */
+    }
+
+    connectionIt->second.disconnected = true;
+    return RemoveIfFinished(connectionId, connectionIt->second);
+}
+
+/*****************************************************************************/
+DcgmIpcSchedulerStats_t DcgmIpcScheduler::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmProtocol.h"
+#include <chrono>
+#include <dcgm_structs.h>
+#include <dcgm_structs_internal.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+/* Priority classes that incoming messages are scheduled in */
+typedef enum
+{
+    DCGM_IPC_PRIORITY_HIGH   = 0, /* Latency sensitive requests like liveness probes and health checks */
+    DCGM_IPC_PRIORITY_NORMAL = 1, /* Everything that isn't classified otherwise */
+    DCGM_IPC_PRIORITY_BULK   = 2, /* Long running or large requests like diag runs and sample reads */
+    DCGM_IPC_PRIORITY_COUNT  = 3  /* Sentinel value */
+} DcgmIpcPriority_t;
+
+/* Callback that assigns a priority class to a message before it is queued. This is called
+   from a reactor thread, so it must be cheap and must not block */
+typedef std::function<DcgmIpcPriority_t(DcgmMessage &message)> DcgmIpcClassifyFunc_f;
+
+typedef struct
+{
+    DcgmIpcClassifyFunc_f classify; /* Classifier. If not set, every message is DCGM_IPC_PRIORITY_NORMAL */
+
+    /* How many non-high priority messages a single connection can have being processed at once.
+       0 = unlimited */
+    unsigned int maxInFlightPerConnection;
+
+    /* How many non-high priority messages can be processed at once across all connections. Keep this
+       below the worker count to reserve workers for high priority messages. 0 = unlimited */
+    unsigned int maxSharedInFlight;
+
+    /* Relative share of dispatches each class gets when more than one class has work. 0 is treated as 1 */
+    unsigned int weights[DCGM_IPC_PRIORITY_COUNT];
+} DcgmIpcSchedulerParams_t;
+
+typedef struct
+{
+    unsigned long long numDispatched; /* How many messages of this class have been handed to a worker */
+    unsigned long long totalWaitUsec; /* Sum of how long those messages sat in the queue */
+    unsigned long long maxWaitUsec;   /* Longest any of those messages sat in the queue */
+    unsigned int numQueued;           /* How many messages of this class are queued right now */
+} DcgmIpcClassStats_t;
+
+typedef struct
+{
+    DcgmIpcClassStats_t classes[DCGM_IPC_PRIORITY_COUNT];
+} DcgmIpcSchedulerStats_t;
+
+/* A message that the scheduler picked to be processed next */
+typedef struct
+{
+    dcgm_connection_id_t connectionId;
+    DcgmIpcPriority_t priority;
+    std::unique_ptr<DcgmMessage> message;
+} DcgmIpcScheduledMessage_t;
+
+/*
+ * Weighted fair queue that sits between the reactors and the IPC worker pool.
+ *
+ * Messages are queued per connection within their priority class. Classes are
+ * served by weighted round robin, and the connections within a class are served
+ * round robin so one busy client can't starve the others. A connection that has
+ * hit the in-flight limit is skipped until one of its messages completes.
+ *
+ * This class is thread safe.
+ */
+class DcgmIpcScheduler
+{
+public:
+    /*************************************************************************/
+    DcgmIpcScheduler();
+
+    /*************************************************************************/
+    /* Replace the scheduling parameters. This is meant to be called before
+       any messages are queued */
+    void SetParams(DcgmIpcSchedulerParams_t const &params);
+
+    /*************************************************************************/
+    /* Get the priority class of a message from the configured classifier */
+    DcgmIpcPriority_t Classify(DcgmMessage &message) const;
+
+    /*************************************************************************/
+    /* Queue a message from connectionId in the given priority class */
+    void Push(dcgm_connection_id_t connectionId, DcgmIpcPriority_t priority, std::unique_ptr<DcgmMessage> message);
+
+    /*************************************************************************/
+    /* Pick the next message to process and mark it as in flight.
+     *
+     * Returns: The message. Complete() must be called after it has been processed.
+     *          std::nullopt if nothing is queued or everything queued is held back
+     *          by an in-flight limit. In the latter case, the worker that completes
+     *          the blocking message is responsible for calling Pop() again.
+     */
+    std::optional<DcgmIpcScheduledMessage_t> Pop();
+
+    /*************************************************************************/
+    /* Mark a message returned by Pop() as processed.
+     *
+     * Returns: true if the connection has disconnected and this was its last
+     *          outstanding message. The caller is then responsible for
+     *          processing the disconnect.
+     */
+    bool Complete(dcgm_connection_id_t connectionId, DcgmIpcPriority_t priority);
+
+    /*************************************************************************/
+    /* Note that a connection went away. Messages that were already queued for it
+     * are still processed so disconnects are seen after the requests before them.
+     *
+     * Returns: true if the connection has nothing queued or in flight, meaning
+     *          the caller can process the disconnect right away. false if the
+     *          disconnect will be handed back by a later call to Complete().
+     */
+    bool MarkDisconnected(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    /* Get a snapshot of the per-class queue statistics */
+    DcgmIpcSchedulerStats_t GetStats() const;
+
+private:
+    struct QueuedMessage
+    {
+        std::unique_ptr<DcgmMessage> message;
+        std::chrono::steady_clock::time_point enqueueTime;
+    };
+
+    struct ConnectionState
+    {
+        std::deque<QueuedMessage> queues[DCGM_IPC_PRIORITY_COUNT]; /* Queued messages by class */
+        unsigned int numQueued       = 0;     /* Total messages across queues */
+        unsigned int numInFlight     = 0;     /* Non-high priority messages being processed */
+        unsigned int numInFlightHigh = 0;     /* High priority messages being processed */
+        bool disconnected            = false; /* Has this connection gone away? */
+    };
+
+    mutable std::mutex m_mutex;
+    DcgmIpcSchedulerParams_t m_params {};
+
+    std::unordered_map<dcgm_connection_id_t, ConnectionState> m_connections;
+
+    /* Connections that have something queued in each class, in the order they will be served */
+    std::deque<dcgm_connection_id_t> m_activeConnections[DCGM_IPC_PRIORITY_COUNT];
+
+    /* Dispatches each class has left in the current weighted round robin round */
+    unsigned int m_credits[DCGM_IPC_PRIORITY_COUNT] = {};
+
+    unsigned int m_sharedInFlight = 0; /* Non-high priority messages being processed */
+
+    DcgmIpcSchedulerStats_t m_stats {};
+
+    /*************************************************************************/
+    /* Can connection take another message of the given class right now? Caller must hold m_mutex */
+    bool CanDispatch(ConnectionState const &connection, DcgmIpcPriority_t priority) const;
+
+    /*************************************************************************/
+    /* Pop the next dispatchable message of a class. Caller must hold m_mutex */
+    std::optional<DcgmIpcScheduledMessage_t> PopFromClass(DcgmIpcPriority_t priority);
+
+    /*************************************************************************/
+    /* Remove a connection's state once it has gone away and has nothing left.
+       Returns true if it was removed. Caller must hold m_mutex */
+    bool RemoveIfFinished(dcgm_connection_id_t connectionId, ConnectionState const &connection);
+};
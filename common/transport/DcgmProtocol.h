@@ -66,6 +66,12 @@ typedef struct
 #define DCGM_MSG_MODULE_COMMAND 0x0300 /* A module command message */
 #define DCGM_MSG_POLICY_NOTIFY  0x0400 /* Async notification of a policy violation */
 #define DCGM_MSG_REQUEST_NOTIFY 0x0500 /* Notify an async request that it will receive no further updates */
+#define DCGM_MSG_CLIENT_CACHE_INVALIDATE \
+    0x0600 /* Async notification that data cached by a client's read-through cache may have changed */
+#define DCGM_MSG_MODULE_COMMAND_COMPACT \
+    0x0700 /* A module command message in the compact wire encoding. See DcgmWireEncoding.h. Only sent to
+              hostengines that accepted it in DCGM_CORE_SR_NEGOTIATE_WIRE_ENCODING. Responses are sent back
+              with the same type */
 
 /* DCGM_MSG_POLICY_NOTIFY - Signal a client that a policy has been violated */
 typedef struct
@@ -84,6 +90,15 @@ typedef struct
                                message contents */
 } dcgm_msg_request_notify_t;
 
+/* DCGM_MSG_CLIENT_CACHE_INVALIDATE - Tell a client the hostengine's cache generations have moved. Cached
+ *                                    responses fetched under older generations must not be served anymore
+ **/
+typedef struct
+{
+    long long configGeneration; /* Bumped whenever groups, field groups or the MIG hierarchy change */
+    long long valuesGeneration; /* Bumped whenever field values may have changed. This includes config changes */
+} dcgm_msg_client_cache_invalidate_t;
+
 class DcgmMessage
 {
 public:
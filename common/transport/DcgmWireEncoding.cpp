@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmWireEncoding.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+void AppendVarint(std::vector<char> &out, size_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((char)((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back((char)value);
+}
+
+/* Returns false if the varint runs past end or doesn't fit in a size_t */
+bool ReadVarint(unsigned char const *&in, unsigned char const *end, size_t &value)
+{
+    value              = 0;
+    unsigned int shift = 0;
+
+    while (in < end)
+    {
+        unsigned char const byte = *in++;
+        if (shift >= sizeof(size_t) * 8 || (shift > 0 && (size_t)(byte & 0x7F) > (SIZE_MAX >> shift)))
+        {
+            return false;
+        }
+
+        value |= (size_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+        shift += 7;
+    }
+
+    return false;
+}
+
+/* Read the version and decoded length that follow the prefix */
+dcgmReturn_t ReadHeader(unsigned char const *&in,
+                        unsigned char const *end,
+                        size_t prefixLength,
+                        size_t &decodedLength)
+{
+    if ((size_t)(end - in) < prefixLength + 1)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    in += prefixLength;
+    if (*in++ != DCGM_WIRE_ENCODING_COMPACT_VERSION)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (!ReadVarint(in, end, decodedLength) || decodedLength < prefixLength)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    return DCGM_ST_OK;
+}
+} // namespace
+
+/*****************************************************************************/
+dcgmReturn_t DcgmWireEncodeCompact(void const *src, size_t srcLength, size_t prefixLength, std::vector<char> &encoded)
+{
+    if (prefixLength > srcLength)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    auto const *bytes = (unsigned char const *)src;
+
+    encoded.clear();
+    encoded.reserve(prefixLength + 16);
+    encoded.insert(encoded.end(), bytes, bytes + prefixLength);
+    encoded.push_back((char)DCGM_WIRE_ENCODING_COMPACT_VERSION);
+    AppendVarint(encoded, srcLength);
+
+    size_t literalStart = prefixLength;
+    size_t pos          = prefixLength;
+
+    while (pos < srcLength)
+    {
+        if (bytes[pos] != 0)
+        {
+            pos++;
+            continue;
+        }
+
+        size_t runEnd = pos;
+        while (runEnd < srcLength && bytes[runEnd] == 0)
+        {
+            runEnd++;
+        }
+
+        /* Trailing zeros are always worth dropping */
+        if (runEnd - pos >= DCGM_WIRE_ENCODING_MIN_ZERO_RUN || runEnd == srcLength)
+        {
+            AppendVarint(encoded, pos - literalStart);
+            encoded.insert(encoded.end(), bytes + literalStart, bytes + pos);
+            AppendVarint(encoded, runEnd - pos);
+            literalStart = runEnd;
+        }
+
+        pos = runEnd;
+    }
+
+    if (literalStart < srcLength)
+    {
+        AppendVarint(encoded, srcLength - literalStart);
+        encoded.insert(encoded.end(), bytes + literalStart, bytes + srcLength);
+        AppendVarint(encoded, 0);
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmWireGetDecodedLength(void const *encoded,
+                                      size_t encodedLength,
+                                      size_t prefixLength,
+                                      size_t &decodedLength)
+{
+    auto const *in  = (unsigned char const *)encoded;
+    auto const *end = in + encodedLength;
+
+    return ReadHeader(in, end, prefixLength, decodedLength);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmWireDecodeCompact(void const *encoded,
+                                   size_t encodedLength,
+                                   size_t prefixLength,
+                                   void *dst,
+                                   size_t dstCapacity,
+                                   size_t &decodedLength)
+{
+    auto const *in  = (unsigned char const *)encoded;
+    auto const *end = in + encodedLength;
+    auto *out       = (char *)dst;
+
+    decodedLength   = 0;
+    size_t expected = 0;
+
+    dcgmReturn_t ret = ReadHeader(in, end, prefixLength, expected);
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    if (expected > dstCapacity)
+    {
+        return DCGM_ST_INSUFFICIENT_SIZE;
+    }
+
+    memcpy(out, encoded, prefixLength);
+    size_t written = prefixLength;
+
+    while (written < expected)
+    {
+        size_t literalLength = 0;
+        size_t zeroLength    = 0;
+
+        if (!ReadVarint(in, end, literalLength) || literalLength > expected - written
+            || literalLength > (size_t)(end - in))
+        {
+            return DCGM_ST_BADPARAM;
+        }
+        memcpy(out + written, in, literalLength);
+        in += literalLength;
+        written += literalLength;
+
+        if (!ReadVarint(in, end, zeroLength) || zeroLength > expected - written
+            || (literalLength == 0 && zeroLength == 0))
+        {
+            return DCGM_ST_BADPARAM;
+        }
+        memset(out + written, 0, zeroLength);
+        written += zeroLength;
+    }
+
+    if (in != end)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    decodedLength = written;
+    return DCGM_ST_OK;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <dcgm_structs.h>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Compact wire encoding of fixed-size structs.
+ *
+ * Most module command structs are sized for their worst case: string buffers, value arrays and entity
+ * lists that are mostly left zeroed. The compact encoding replaces every long run of zero bytes with its
+ * length, so the bytes on the wire follow what the struct actually holds rather than its capacity.
+ *
+ * Layout of an encoded buffer:
+ *   - prefixLength bytes copied verbatim. Lets the receiver look at a header without decoding
+ *   - 1 byte encoding version (DCGM_WIRE_ENCODING_COMPACT_VERSION)
+ *   - varint decoded length, including the prefix
+ *   - Runs of: varint literal length, the literal bytes, varint zero run length
+ *
+ * Varints are LEB128: 7 bits per byte, least significant group first.
+ */
+
+#define DCGM_WIRE_ENCODING_COMPACT_VERSION 1
+
+/* Bitmask of wire encodings negotiated with DCGM_CORE_SR_NEGOTIATE_WIRE_ENCODING */
+#define DCGM_WIRE_ENCODING_MASK_COMPACT 0x1
+#define DCGM_WIRE_ENCODING_MASK_ALL     DCGM_WIRE_ENCODING_MASK_COMPACT
+
+/* Module commands smaller than this are always sent verbatim. There's little to gain on them */
+#define DCGM_WIRE_ENCODING_MIN_LENGTH 256
+
+/* Zero runs shorter than this are kept in the surrounding literal. Breaking a literal costs up to two
+   varint bytes, so shorter runs don't pay for themselves */
+#define DCGM_WIRE_ENCODING_MIN_ZERO_RUN 8
+
+/*****************************************************************************/
+/*
+ * Encode a struct with the compact encoding
+ *
+ * src          IN: Struct to encode
+ * srcLength    IN: Size of src in bytes
+ * prefixLength IN: How many bytes at the front of src to copy verbatim. Must be <= srcLength
+ * encoded     OUT: Encoded bytes. Any previous contents are replaced
+ *
+ * Returns DCGM_ST_OK on success
+ *         DCGM_ST_BADPARAM if prefixLength > srcLength
+ */
+dcgmReturn_t DcgmWireEncodeCompact(void const *src,
+                                   size_t srcLength,
+                                   size_t prefixLength,
+                                   std::vector<char> &encoded);
+
+/*****************************************************************************/
+/*
+ * Get the decoded length of a buffer encoded with DcgmWireEncodeCompact without decoding it
+ *
+ * Returns DCGM_ST_OK on success
+ *         DCGM_ST_BADPARAM if the buffer is truncated or not a supported version
+ */
+dcgmReturn_t DcgmWireGetDecodedLength(void const *encoded,
+                                      size_t encodedLength,
+                                      size_t prefixLength,
+                                      size_t &decodedLength);
+
+/*****************************************************************************/
+/*
+ * Decode a buffer encoded with DcgmWireEncodeCompact straight into the struct it was encoded from
+ *
+ * encoded        IN: Encoded bytes
+ * encodedLength  IN: Size of encoded in bytes
+ * prefixLength   IN: prefixLength that was passed to DcgmWireEncodeCompact
+ * dst           OUT: Decoded struct
+ * dstCapacity    IN: Size of dst in bytes
+ * decodedLength OUT: How many bytes of dst were written
+ *
+ * Returns DCGM_ST_OK on success
+ *         DCGM_ST_BADPARAM if the buffer is truncated, corrupt or not a supported version
+ *         DCGM_ST_INSUFFICIENT_SIZE if the decoded struct doesn't fit in dstCapacity
+ */
+dcgmReturn_t DcgmWireDecodeCompact(void const *encoded,
+                                   size_t encodedLength,
+                                   size_t prefixLength,
+                                   void *dst,
+                                   size_t dstCapacity,
+                                   size_t &decodedLength);
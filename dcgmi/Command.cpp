@@ -18,6 +18,7 @@
  */
 
 #include "Command.h"
+#include "DcgmiBatch.h"
 #include "dcgm_agent.h"
 #include "dcgm_structs.h"
 #include "dcgmi_common.h"
@@ -32,7 +33,8 @@ Command::Command() = default;
 /*****************************************************************************/
 Command::~Command()
 {
-    if (m_dcgmHandle)
+    /* A borrowed handle belongs to the batch, which disconnects it when the batch is done */
+    if (m_dcgmHandle && !m_borrowedHandle)
     {
         // Disconnect
         dcgmReturn_t result = dcgmDisconnect(m_dcgmHandle);
@@ -46,9 +48,27 @@ Command::~Command()
 
 /*****************************************************************************/
 dcgmReturn_t Command::Connect(void)
+{
+    if (DcgmiBatch::IsActive())
+    {
+        dcgmReturn_t result
+            = DcgmiBatch::GetConnection(m_hostName, m_persistAfterDisconnect, m_timeout, m_silent, m_dcgmHandle);
+        m_borrowedHandle = (result == DCGM_ST_OK);
+        return result;
+    }
+
+    return ConnectToHost(m_hostName, m_persistAfterDisconnect, m_timeout, m_silent, m_dcgmHandle);
+}
+
+/*****************************************************************************/
+dcgmReturn_t Command::ConnectToHost(std::string const &hostName,
+                                    unsigned int persistAfterDisconnect,
+                                    unsigned int timeoutMs,
+                                    bool silent,
+                                    dcgmHandle_t &dcgmHandle)
 {
     dcgmConnectV2Params_t connectParams;
-    const char *hostNameStr  = m_hostName.c_str();
+    const char *hostNameStr  = hostName.c_str();
     bool isUnixSocketAddress = false;
 
     /* For now, do a global init of DCGM on the start of a command. We can change this later to
@@ -58,12 +78,12 @@ dcgmReturn_t Command::Connect(void)
     dcgmReturn_t result = dcgmInit();
     if (DCGM_ST_OK != result)
     {
-        if (m_silent == false)
+        if (silent == false)
             std::cout << "Error: unable to initialize DCGM" << std::endl;
         return result;
     }
 
-    hostNameStr = dcgmi_parse_hostname_string(hostNameStr, &isUnixSocketAddress, !m_silent);
+    hostNameStr = dcgmi_parse_hostname_string(hostNameStr, &isUnixSocketAddress, !silent);
     if (!hostNameStr)
     {
         return DCGM_ST_BADPARAM; /* Don't need to print here. The function above already did */
@@ -71,16 +91,16 @@ dcgmReturn_t Command::Connect(void)
 
     memset(&connectParams, 0, sizeof(connectParams));
     connectParams.version                = dcgmConnectV2Params_version;
-    connectParams.persistAfterDisconnect = m_persistAfterDisconnect;
+    connectParams.persistAfterDisconnect = persistAfterDisconnect;
     connectParams.addressIsUnixSocket    = isUnixSocketAddress ? 1 : 0;
-    connectParams.timeoutMs              = m_timeout;
+    connectParams.timeoutMs              = timeoutMs;
 
-    result = dcgmConnect_v2(hostNameStr, &connectParams, &m_dcgmHandle);
+    result = dcgmConnect_v2(hostNameStr, &connectParams, &dcgmHandle);
     if (DCGM_ST_OK != result)
     {
-        if (m_silent == false)
+        if (silent == false)
         {
-            std::cout << "Error: unable to establish a connection to the specified host: " << m_hostName << std::endl;
+            std::cout << "Error: unable to establish a connection to the specified host: " << hostName << std::endl;
         }
         return result;
     }
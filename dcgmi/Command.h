@@ -37,6 +37,16 @@ public:
      *****************************************************************************/
     dcgmReturn_t Connect();
 
+    /*****************************************************************************
+     * Open a new connection to hostName. Connect() uses this unless a batch is
+     * running, in which case the batch hands out a shared connection instead
+     *****************************************************************************/
+    static dcgmReturn_t ConnectToHost(std::string const &hostName,
+                                      unsigned int persistAfterDisconnect,
+                                      unsigned int timeoutMs,
+                                      bool silent,
+                                      dcgmHandle_t &dcgmHandle);
+
     /*****************************************************************************
      * persistAfterDisconnect: Should the host engine persist the watches created
      *                         by this connection after the connection goes away?
@@ -67,6 +77,7 @@ protected:
                                                    1=yes. 0=no (default). */
     bool m_json {};
     bool m_silent {};
+    bool m_borrowedHandle {}; /*!< Is m_dcgmHandle shared by a batch rather than owned by this command? */
 };
 
 
@@ -18,6 +18,7 @@
 
 #include "CommandLineParser.h"
 #include "Config.h"
+#include "DcgmiBatch.h"
 #include "DcgmiProfile.h"
 #include "DcgmiSettings.h"
 #include "DcgmiTest.h"
@@ -52,6 +53,7 @@
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 
 #define CHECK_TCLAP_ARG_NEGATIVE_VALUE(arg, name) \
     if (arg.getValue() < 0)                       \
@@ -97,6 +99,12 @@ CommandLineParser::StaticConstructor::StaticConstructor()
 dcgmReturn_t CommandLineParser::ProcessCommandLine(int argc, char const *const *argv)
 {
     dcgmReturn_t result = DCGM_ST_OK;
+
+    if (argc >= 2 && std::string_view(argv[1]) == "--batch")
+    {
+        return DcgmiBatch::RunOnStdio();
+    }
+
     try
     {
         // declare the main class that will handle processing
@@ -106,6 +114,7 @@ dcgmReturn_t CommandLineParser::ProcessCommandLine(int argc, char const *const *
         // override the output so that usage can display the cudatools address
         DCGMEntryOutput nvout;
         cmd.setOutput(&nvout);
+        cmd.setExceptionHandling(!DcgmiBatch::IsActive());
 
         // parameters
         TCLAP::SwitchArg versionArg("v", "vv", "Get DCGMI version information");
@@ -158,6 +167,12 @@ dcgmReturn_t CommandLineParser::ProcessCommandLine(int argc, char const *const *
         TCLAP::ValueArg<std::string> profileArg(
             "", "profile", "Control and list DCGM profiling metrics", false, "", "", cmd);
         TCLAP::ValueArg<std::string> settingsArg("", "set", "Configure hostengine settings", false, "", "", cmd);
+        TCLAP::SwitchArg batchArg("",
+                                  "batch",
+                                  "Read dcgmi commands from stdin, one per line, and run them over a single "
+                                  "connection. A JSON status record per command is written to stdout. The "
+                                  "commands' own output goes to stderr",
+                                  cmd);
 
         nvout.addToGroup("1", &subsystemArg);
         nvout.addToGroup("2", &versionArg);
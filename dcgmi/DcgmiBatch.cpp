@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmiBatch.h"
+#include "Command.h"
+#include "CommandLineParser.h"
+#include "dcgm_agent.h"
+
+#include <DcgmLogging.h>
+#include <json/json.h>
+#include <tclap/CmdLine.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ext/stdio_filebuf.h>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+
+
+/*****************************************************************************/
+bool DcgmiBatch::IsActive()
+{
+    return m_active;
+}
+
+/*****************************************************************************/
+std::optional<std::vector<std::string>> DcgmiBatch::SplitCommandLine(std::string const &line)
+{
+    std::vector<std::string> args;
+    std::string current;
+    bool inArg    = false;
+    char quote    = '\0';
+    bool escaping = false;
+
+    for (char c : line)
+    {
+        if (escaping)
+        {
+            current.push_back(c);
+            escaping = false;
+        }
+        else if (quote != '\0')
+        {
+            if (c == quote)
+            {
+                quote = '\0';
+            }
+            else if (c == '\\' && quote == '"')
+            {
+                escaping = true;
+            }
+            else
+            {
+                current.push_back(c);
+            }
+        }
+        else if (c == '\'' || c == '"')
+        {
+            quote = c;
+            inArg = true;
+        }
+        else if (c == '\\')
+        {
+            escaping = true;
+            inArg    = true;
+        }
+        else if (std::isspace(static_cast<unsigned char>(c)))
+        {
+            if (inArg)
+            {
+                args.push_back(std::move(current));
+                current.clear();
+                inArg = false;
+            }
+        }
+        else
+        {
+            current.push_back(c);
+            inArg = true;
+        }
+    }
+
+    if (quote != '\0' || escaping)
+    {
+        return std::nullopt;
+    }
+
+    if (inArg)
+    {
+        args.push_back(std::move(current));
+    }
+
+    return args;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmiBatch::GetConnection(std::string const &hostName,
+                                       unsigned int persistAfterDisconnect,
+                                       unsigned int timeoutMs,
+                                       bool silent,
+                                       dcgmHandle_t &dcgmHandle)
+{
+    ConnectionKey key { hostName, persistAfterDisconnect, timeoutMs };
+
+    auto it = m_connections.find(key);
+    if (it != m_connections.end())
+    {
+        dcgmHandle = it->second;
+        return DCGM_ST_OK;
+    }
+
+    dcgmReturn_t result = Command::ConnectToHost(hostName, persistAfterDisconnect, timeoutMs, silent, dcgmHandle);
+    if (result == DCGM_ST_OK)
+    {
+        m_connections[key] = dcgmHandle;
+    }
+
+    return result;
+}
+
+/*****************************************************************************/
+void DcgmiBatch::DisconnectAll()
+{
+    for (auto const &[key, dcgmHandle] : m_connections)
+    {
+        dcgmReturn_t result = dcgmDisconnect(dcgmHandle);
+        if (result != DCGM_ST_OK)
+        {
+            log_debug("dcgmDisconnect of {} returned {}", std::get<0>(key), (int)result);
+        }
+    }
+
+    /* Groups are owned by their connection, so they went away with it */
+    m_connections.clear();
+    m_entityGroups.clear();
+    m_fieldGroups.clear();
+}
+
+/*****************************************************************************/
+DcgmiBatch::EntityGroupKey DcgmiBatch::MakeEntityGroupKey(dcgmHandle_t dcgmHandle,
+                                                          dcgmGroupType_t groupType,
+                                                          std::vector<dcgmGroupEntityPair_t> const &entityList)
+{
+    std::vector<std::pair<dcgm_field_entity_group_t, dcgm_field_eid_t>> entities;
+    entities.reserve(entityList.size());
+    for (auto const &entity : entityList)
+    {
+        entities.emplace_back(entity.entityGroupId, entity.entityId);
+    }
+
+    return EntityGroupKey { dcgmHandle, groupType, std::move(entities) };
+}
+
+/*****************************************************************************/
+std::optional<dcgmGpuGrp_t> DcgmiBatch::FindEntityGroup(dcgmHandle_t dcgmHandle,
+                                                        dcgmGroupType_t groupType,
+                                                        std::vector<dcgmGroupEntityPair_t> const &entityList)
+{
+    if (!m_active)
+    {
+        return std::nullopt;
+    }
+
+    auto it = m_entityGroups.find(MakeEntityGroupKey(dcgmHandle, groupType, entityList));
+    if (it == m_entityGroups.end())
+    {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+/*****************************************************************************/
+void DcgmiBatch::AddEntityGroup(dcgmHandle_t dcgmHandle,
+                                dcgmGroupType_t groupType,
+                                std::vector<dcgmGroupEntityPair_t> const &entityList,
+                                dcgmGpuGrp_t groupId)
+{
+    if (m_active)
+    {
+        m_entityGroups[MakeEntityGroupKey(dcgmHandle, groupType, entityList)] = groupId;
+    }
+}
+
+/*****************************************************************************/
+std::optional<dcgmFieldGrp_t> DcgmiBatch::FindFieldGroup(dcgmHandle_t dcgmHandle,
+                                                         std::vector<unsigned short> const &fieldIds)
+{
+    if (!m_active)
+    {
+        return std::nullopt;
+    }
+
+    auto it = m_fieldGroups.find(FieldGroupKey { dcgmHandle, fieldIds });
+    if (it == m_fieldGroups.end())
+    {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+/*****************************************************************************/
+void DcgmiBatch::AddFieldGroup(dcgmHandle_t dcgmHandle,
+                               std::vector<unsigned short> const &fieldIds,
+                               dcgmFieldGrp_t fieldGroupId)
+{
+    if (m_active)
+    {
+        m_fieldGroups[FieldGroupKey { dcgmHandle, fieldIds }] = fieldGroupId;
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmiBatch::RunCommand(std::vector<std::string> const &args)
+{
+    /* The subsystem parsers expect argv[0] to be the program name */
+    std::vector<char const *> argv;
+    argv.reserve(args.size() + 2);
+    argv.push_back("dcgmi");
+    for (auto const &arg : args)
+    {
+        argv.push_back(arg.c_str());
+    }
+    argv.push_back(nullptr);
+
+    try
+    {
+        return CommandLineParser::ProcessCommandLine(static_cast<int>(args.size() + 1), argv.data());
+    }
+    catch (TCLAP::ExitException &e)
+    {
+        /* --help and friends. Outside of a batch, TCLAP would have exited the process here */
+        return e.getExitStatus() == 0 ? DCGM_ST_OK : DCGM_ST_BADPARAM;
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return static_cast<dcgmReturn_t>(-2);
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmiBatch::Run(std::istream &input, std::ostream &output)
+{
+    dcgmReturn_t batchResult = DCGM_ST_OK;
+    std::string line;
+    unsigned int lineNumber = 0;
+
+    Json::StreamWriterBuilder writerBuilder;
+    writerBuilder["indentation"] = "";
+
+    m_active = true;
+
+    while (std::getline(input, line))
+    {
+        lineNumber++;
+
+        auto args = SplitCommandLine(line);
+        if (args.has_value() && (args->empty() || args->front().starts_with('#')))
+        {
+            continue;
+        }
+
+        /* Accept lines copied from a shell script that still start with the program name */
+        if (args.has_value() && args->front() == "dcgmi")
+        {
+            args->erase(args->begin());
+        }
+
+        dcgmReturn_t result;
+        if (!args.has_value())
+        {
+            std::cerr << "Error: Unterminated quote on line " << lineNumber << "." << std::endl;
+            result = DCGM_ST_BADPARAM;
+        }
+        else if (!args->empty() && args->front() == "--batch")
+        {
+            std::cerr << "Error: --batch can't be used inside of a batch." << std::endl;
+            result = DCGM_ST_BADPARAM;
+        }
+        else
+        {
+            result = RunCommand(*args);
+        }
+
+        if (result == DCGM_ST_CONNECTION_NOT_VALID)
+        {
+            /* The host engine may have restarted. Reconnect on the next command */
+            DisconnectAll();
+        }
+
+        if (result != DCGM_ST_OK)
+        {
+            batchResult = result;
+        }
+
+        char const *statusString = errorString(result);
+
+        Json::Value record;
+        record["line"]         = lineNumber;
+        record["command"]      = line;
+        record["status"]       = static_cast<int>(result);
+        record["statusString"] = statusString != nullptr ? statusString : "Unknown error";
+
+        /* Let what the command printed come out before its record when both streams go to a terminal */
+        std::cout.flush();
+        fflush(stdout);
+        output << Json::writeString(writerBuilder, record) << std::endl;
+    }
+
+    DisconnectAll();
+    m_active = false;
+
+    return batchResult;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmiBatch::RunOnStdio()
+{
+    std::cout.flush();
+    fflush(stdout);
+
+    int statusFd = dup(STDOUT_FILENO);
+    if (statusFd < 0 || dup2(STDERR_FILENO, STDOUT_FILENO) < 0)
+    {
+        std::cerr << "Error: Unable to redirect stdout for the batch: " << strerror(errno) << std::endl;
+        if (statusFd >= 0)
+        {
+            close(statusFd);
+        }
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    dcgmReturn_t result;
+    {
+        /* Owns statusFd from here on and closes it on the way out */
+        __gnu_cxx::stdio_filebuf<char> statusBuf(statusFd, std::ios::out);
+        std::ostream status(&statusBuf);
+
+        result = Run(std::cin, status);
+
+        std::cout.flush();
+        fflush(stdout);
+        status.flush();
+        if (dup2(statusFd, STDOUT_FILENO) < 0)
+        {
+            log_error("Unable to restore stdout after the batch: {}", strerror(errno));
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_structs.h"
+
+#include <iosfwd>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+/*
+ * Runs many dcgmi commands from one process (dcgmi --batch).
+ *
+ * Commands are read one per line, exactly as they would be typed after "dcgmi".
+ * While a batch is running, commands share one host engine connection per
+ * host/options combination, and the temporary entity and field groups that
+ * dcgmi creates on behalf of a command are reused by later commands that ask
+ * for the same members. After each command, a single-line JSON record with the
+ * command's status is written to the output.
+ *
+ * Commands print human-readable text, and only some of them have a --json
+ * option, so the status records get a stream of their own. RunOnStdio() writes
+ * them to stdout and moves everything the commands print to stderr.
+ */
+class DcgmiBatch
+{
+public:
+    /*****************************************************************************
+     * Run every command in input until EOF. Blank lines and lines starting with
+     * '#' are skipped.
+     *
+     * Returns DCGM_ST_OK if every command succeeded
+     *         The status of the last command that failed otherwise
+     *****************************************************************************/
+    static dcgmReturn_t Run(std::istream &input, std::ostream &output);
+
+    /*****************************************************************************
+     * Run() the commands on stdin for dcgmi --batch. Status records are the only
+     * thing written to stdout. For the whole batch, stdout of the commands is
+     * redirected to stderr, where their error messages already go.
+     *
+     * Returns the same as Run()
+     *         DCGM_ST_GENERIC_ERROR if stdout couldn't be redirected
+     *****************************************************************************/
+    static dcgmReturn_t RunOnStdio();
+
+    /*****************************************************************************
+     * Is a batch currently running?
+     *****************************************************************************/
+    static bool IsActive();
+
+    /*****************************************************************************
+     * Get the shared connection for the given connection options, connecting if
+     * this is the first command that asked for it
+     *****************************************************************************/
+    static dcgmReturn_t GetConnection(std::string const &hostName,
+                                      unsigned int persistAfterDisconnect,
+                                      unsigned int timeoutMs,
+                                      bool silent,
+                                      dcgmHandle_t &dcgmHandle);
+
+    /*****************************************************************************
+     * Look up or remember the temporary groups created with dcgmi_create_entity_group()
+     * and dcgmi_create_field_group(). These are no-ops when no batch is running
+     *****************************************************************************/
+    static std::optional<dcgmGpuGrp_t> FindEntityGroup(dcgmHandle_t dcgmHandle,
+                                                       dcgmGroupType_t groupType,
+                                                       std::vector<dcgmGroupEntityPair_t> const &entityList);
+    static void AddEntityGroup(dcgmHandle_t dcgmHandle,
+                               dcgmGroupType_t groupType,
+                               std::vector<dcgmGroupEntityPair_t> const &entityList,
+                               dcgmGpuGrp_t groupId);
+    static std::optional<dcgmFieldGrp_t> FindFieldGroup(dcgmHandle_t dcgmHandle,
+                                                        std::vector<unsigned short> const &fieldIds);
+    static void AddFieldGroup(dcgmHandle_t dcgmHandle,
+                              std::vector<unsigned short> const &fieldIds,
+                              dcgmFieldGrp_t fieldGroupId);
+
+    /*****************************************************************************
+     * Split a command line into arguments the way a shell would for simple cases:
+     * whitespace separates arguments, single and double quotes group them, and a
+     * backslash escapes the next character outside of single quotes.
+     *
+     * Returns the arguments, or std::nullopt if a quote was never closed
+     *****************************************************************************/
+    static std::optional<std::vector<std::string>> SplitCommandLine(std::string const &line);
+
+private:
+    /* hostName, persistAfterDisconnect, timeoutMs */
+    using ConnectionKey = std::tuple<std::string, unsigned int, unsigned int>;
+
+    /* dcgmHandle, groupType, (entityGroupId, entityId) of each member */
+    using EntityGroupKey
+        = std::tuple<dcgmHandle_t, dcgmGroupType_t, std::vector<std::pair<dcgm_field_entity_group_t, dcgm_field_eid_t>>>;
+
+    /* dcgmHandle, field IDs */
+    using FieldGroupKey = std::tuple<dcgmHandle_t, std::vector<unsigned short>>;
+
+    static inline bool m_active = false;
+    static inline std::map<ConnectionKey, dcgmHandle_t> m_connections;
+    static inline std::map<EntityGroupKey, dcgmGpuGrp_t> m_entityGroups;
+    static inline std::map<FieldGroupKey, dcgmFieldGrp_t> m_fieldGroups;
+
+    /*****************************************************************************
+     * Run a single command line. Returns the command's status
+     *****************************************************************************/
+    static dcgmReturn_t RunCommand(std::vector<std::string> const &args);
+
+    /*****************************************************************************
+     * Disconnect every shared connection and forget the groups created over them
+     *****************************************************************************/
+    static void DisconnectAll();
+
+    static EntityGroupKey MakeEntityGroupKey(dcgmHandle_t dcgmHandle,
+                                             dcgmGroupType_t groupType,
+                                             std::vector<dcgmGroupEntityPair_t> const &entityList);
+};
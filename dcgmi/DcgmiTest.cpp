@@ -44,7 +44,7 @@ dcgmReturn_t DcgmiTest::IntrospectCache(dcgmHandle_t mDcgmHandle,
                                         bool isGroup)
 {
     dcgmReturn_t result = DCGM_ST_OK;
-    dcgmCacheManagerFieldInfo_v4_t fieldInfo;
+    dcgmCacheManagerFieldInfo_v5_t fieldInfo;
     dcgmGroupInfo_t stNvcmGroupInfo;
     unsigned int gpuIds[DCGM_MAX_NUM_DEVICES];
     unsigned int numGpus = 0;
@@ -79,8 +79,8 @@ dcgmReturn_t DcgmiTest::IntrospectCache(dcgmHandle_t mDcgmHandle,
 
     // get field info
     DcgmFieldsInit();
-    memset(&fieldInfo, 0, sizeof(dcgmCacheManagerFieldInfo_v4_t));
-    fieldInfo.version = dcgmCacheManagerFieldInfo_version4;
+    memset(&fieldInfo, 0, sizeof(dcgmCacheManagerFieldInfo_v5_t));
+    fieldInfo.version = dcgmCacheManagerFieldInfo_version5;
     result            = HelperParseForFieldId(fieldId, fieldInfo.fieldId, mDcgmHandle);
 
     if (result != DCGM_ST_OK)
@@ -155,7 +155,7 @@ dcgmReturn_t DcgmiTest::InjectCache(dcgmHandle_t mDcgmHandle,
     return DCGM_ST_OK;
 }
 
-void DcgmiTest::HelperDisplayField(dcgmCacheManagerFieldInfo_v4_t &fieldInfo)
+void DcgmiTest::HelperDisplayField(dcgmCacheManagerFieldInfo_v5_t &fieldInfo)
 {
     CommandOutputController cmdView = CommandOutputController();
 
@@ -221,6 +221,38 @@ void DcgmiTest::HelperDisplayField(dcgmCacheManagerFieldInfo_v4_t &fieldInfo)
     cmdView.addDisplayParameter(DATA_INFO_TAG, fieldInfo.numWatchers);
     cmdView.display();
 
+    cmdView.addDisplayParameter(DATA_NAME_TAG, "Sample Bytes");
+    cmdView.addDisplayParameter(DATA_INFO_TAG, fieldInfo.sampleBytes);
+    cmdView.display();
+
+    cmdView.addDisplayParameter(DATA_NAME_TAG, "Budget Evicted Samples");
+    cmdView.addDisplayParameter(DATA_INFO_TAG, fieldInfo.budgetEvictedSamples);
+    cmdView.display();
+
+    if (fieldInfo.hugePages != DCGM_CM_HUGEPAGES_NONE)
+    {
+        cmdView.addDisplayParameter(DATA_NAME_TAG, "Pool NUMA Node");
+        cmdView.addDisplayParameter(DATA_INFO_TAG, fieldInfo.numaNode);
+        cmdView.display();
+
+        cmdView.addDisplayParameter(DATA_NAME_TAG, "Pool Hugepages");
+        cmdView.addDisplayParameter(DATA_INFO_TAG,
+                                    fieldInfo.hugePages == DCGM_CM_HUGEPAGES_EXPLICIT ? "Explicit" : "Transparent");
+        cmdView.display();
+
+        cmdView.addDisplayParameter(DATA_NAME_TAG, "Pool Bytes Reserved");
+        cmdView.addDisplayParameter(DATA_INFO_TAG, fieldInfo.poolBytesReserved);
+        cmdView.display();
+
+        cmdView.addDisplayParameter(DATA_NAME_TAG, "Pool Bytes In Use");
+        cmdView.addDisplayParameter(DATA_INFO_TAG, fieldInfo.poolBytesInUse);
+        cmdView.display();
+
+        cmdView.addDisplayParameter(DATA_NAME_TAG, "Pool Heap Fallbacks");
+        cmdView.addDisplayParameter(DATA_INFO_TAG, fieldInfo.poolHeapFallbacks);
+        cmdView.display();
+    }
+
     std::cout << std::endl;
 }
 
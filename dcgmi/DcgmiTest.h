@@ -45,7 +45,7 @@ protected:
 
 private:
     /* Helper function to display field info to stdout */
-    void HelperDisplayField(dcgmCacheManagerFieldInfo_v4_t &fieldInfo);
+    void HelperDisplayField(dcgmCacheManagerFieldInfo_v5_t &fieldInfo);
 
     /* Helper function to initialize and populate the needed data in the field value */
     dcgmReturn_t HelperInitFieldValue(dcgmInjectFieldValue_t &injectFieldValue, std::string &injectValue);
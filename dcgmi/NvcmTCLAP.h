@@ -16,6 +16,8 @@
 #ifndef _NVCMI_TCLAP_DEFS_H
 #define _NVCMI_TCLAP_DEFS_H
 
+#include "DcgmiBatch.h"
+
 #include <tclap/Arg.h>
 #include <tclap/CmdLine.h>
 #include <tclap/CmdLineInterface.h>
@@ -51,6 +53,8 @@ public:
         : CmdLine(message, delimiter, version, helpAndVersion)
     {
         myName = name;
+        /* A batch runs many commands in one process, so parse errors and --help can't exit() */
+        setExceptionHandling(!DcgmiBatch::IsActive());
         if (!helpAndVersion)
         {
             TCLAP::Visitor *v = new TCLAP::HelpVisitor(this, &_output);
@@ -23,6 +23,7 @@
 #include <unistd.h>
 
 #include "DcgmStringHelpers.h"
+#include "DcgmiBatch.h"
 #include "MigIdParser.hpp"
 #include "dcgm_agent.h"
 #include "dcgm_fields.h"
@@ -183,6 +184,12 @@ dcgmReturn_t dcgmi_create_entity_group(dcgmHandle_t dcgmHandle,
     char groupName[32]          = { 0 };
     unsigned int i;
 
+    if (auto cachedGroupId = DcgmiBatch::FindEntityGroup(dcgmHandle, groupType, entityList))
+    {
+        *groupId = *cachedGroupId;
+        return DCGM_ST_OK;
+    }
+
     snprintf(groupName, sizeof(groupName) - 1, "dcgmi_%u_%d", myPid, ++numGroupsCreated);
 
     dcgmReturn = dcgmGroupCreate(dcgmHandle, groupType, groupName, groupId);
@@ -204,6 +211,8 @@ dcgmReturn_t dcgmi_create_entity_group(dcgmHandle_t dcgmHandle,
         }
     }
 
+    DcgmiBatch::AddEntityGroup(dcgmHandle, groupType, entityList, *groupId);
+
     return DCGM_ST_OK;
 }
 
@@ -278,6 +287,12 @@ dcgmReturn_t dcgmi_create_field_group(dcgmHandle_t dcgmHandle,
     unsigned int myPid          = (unsigned int)getpid();
     char groupName[32]          = { 0 };
 
+    if (auto cachedGroupId = DcgmiBatch::FindFieldGroup(dcgmHandle, fieldIds))
+    {
+        *groupId = *cachedGroupId;
+        return DCGM_ST_OK;
+    }
+
     snprintf(groupName, sizeof(groupName) - 1, "dcgmi_%u_%d", myPid, ++numGroupsCreated);
 
     dcgmReturn = dcgmFieldGroupCreate(dcgmHandle, fieldIds.size(), &fieldIds[0], groupName, groupId);
@@ -285,6 +300,10 @@ dcgmReturn_t dcgmi_create_field_group(dcgmHandle_t dcgmHandle,
     {
         SHOW_AND_LOG_ERROR << "Got error while creating a Field Group: " << errorString(dcgmReturn);
     }
+    else
+    {
+        DcgmiBatch::AddFieldGroup(dcgmHandle, fieldIds, *groupId);
+    }
 
     return dcgmReturn;
 }
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch.hpp>
+
+#include <DcgmiBatch.h>
+#include <dcgm_structs.h>
+
+#include <json/json.h>
+
+#include <sstream>
+
+TEST_CASE("DcgmiBatch: SplitCommandLine")
+{
+    using Args = std::vector<std::string>;
+
+    CHECK(DcgmiBatch::SplitCommandLine("") == Args {});
+    CHECK(DcgmiBatch::SplitCommandLine("   \t ") == Args {});
+    CHECK(DcgmiBatch::SplitCommandLine("discovery -l") == Args { "discovery", "-l" });
+    CHECK(DcgmiBatch::SplitCommandLine("  dmon   -e 150,155\t-c 1 ") == Args { "dmon", "-e", "150,155", "-c", "1" });
+    CHECK(DcgmiBatch::SplitCommandLine("group -c \"my group\"") == Args { "group", "-c", "my group" });
+    CHECK(DcgmiBatch::SplitCommandLine("group -c 'my \"group\"'") == Args { "group", "-c", "my \"group\"" });
+    CHECK(DcgmiBatch::SplitCommandLine("group -c my\\ group") == Args { "group", "-c", "my group" });
+    CHECK(DcgmiBatch::SplitCommandLine("group -c \"a \\\"b\\\"\"") == Args { "group", "-c", "a \"b\"" });
+    CHECK(DcgmiBatch::SplitCommandLine("group -c ''") == Args { "group", "-c", "" });
+
+    CHECK(!DcgmiBatch::SplitCommandLine("group -c \"my group").has_value());
+    CHECK(!DcgmiBatch::SplitCommandLine("group -c 'my group").has_value());
+    CHECK(!DcgmiBatch::SplitCommandLine("group -c \\").has_value());
+}
+
+TEST_CASE("DcgmiBatch: Group caches are inactive outside of a batch")
+{
+    std::vector<dcgmGroupEntityPair_t> entityList = { { DCGM_FE_GPU, 0 } };
+    std::vector<unsigned short> fieldIds          = { 150, 155 };
+
+    REQUIRE(!DcgmiBatch::IsActive());
+
+    DcgmiBatch::AddEntityGroup(1, DCGM_GROUP_EMPTY, entityList, 5);
+    DcgmiBatch::AddFieldGroup(1, fieldIds, 6);
+
+    CHECK(!DcgmiBatch::FindEntityGroup(1, DCGM_GROUP_EMPTY, entityList).has_value());
+    CHECK(!DcgmiBatch::FindFieldGroup(1, fieldIds).has_value());
+}
+
+TEST_CASE("DcgmiBatch: Status records")
+{
+    std::istringstream input("# A comment\n"
+                             "\n"
+                             "group -c \"unterminated\n"
+                             "dcgmi --batch\n");
+    std::ostringstream output;
+
+    dcgmReturn_t result = DcgmiBatch::Run(input, output);
+    CHECK(result == DCGM_ST_BADPARAM);
+    CHECK(!DcgmiBatch::IsActive());
+
+    /* Comments and blank lines don't get records */
+    std::istringstream records(output.str());
+    std::string line;
+    std::vector<Json::Value> parsed;
+    while (std::getline(records, line))
+    {
+        Json::Value record;
+        Json::CharReaderBuilder readerBuilder;
+        std::string errors;
+        std::istringstream recordStream(line);
+        REQUIRE(Json::parseFromStream(readerBuilder, recordStream, &record, &errors));
+        parsed.push_back(record);
+    }
+
+    REQUIRE(parsed.size() == 2);
+    CHECK(parsed[0]["line"].asUInt() == 3);
+    CHECK(parsed[0]["status"].asInt() == DCGM_ST_BADPARAM);
+    CHECK(parsed[1]["line"].asUInt() == 4);
+    CHECK(parsed[1]["command"].asString() == "dcgmi --batch");
+    CHECK(parsed[1]["status"].asInt() == DCGM_ST_BADPARAM);
+}
@@ -557,13 +557,37 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmGroupRemoveEntity(dcgmHandle_t pDcgmHandle,
  *  - \ref DCGM_ST_OK                   if the group info is successfully received.
  *  - \ref DCGM_ST_BADPARAM             if any of \a groupId or \a pDcgmGroupInfo is invalid.
  *  - \ref DCGM_ST_INIT_ERROR           if the library has not been successfully initialized.
- *  - \ref DCGM_ST_MAX_LIMIT            if the group does not contain the GPU
+ *  - \ref DCGM_ST_MAX_LIMIT            if the group has more than \ref DCGM_GROUP_MAX_ENTITIES entities.
+ *                                      Use \ref dcgmGroupGetEntities for those
  *  - \ref DCGM_ST_NOT_CONFIGURED       if entry corresponding to the group (\a groupId) does not exists
  */
 dcgmReturn_t DCGM_PUBLIC_API dcgmGroupGetInfo(dcgmHandle_t pDcgmHandle,
                                               dcgmGpuGrp_t groupId,
                                               dcgmGroupInfo_t *pDcgmGroupInfo);
 
+/**
+ * Used to page through the entities of the group represented by \a groupId. Groups aren't limited to
+ * \ref DCGM_GROUP_MAX_ENTITIES entities. Use this instead of \ref dcgmGroupGetInfo for groups that may
+ * be larger than that.
+ *
+ * @param pDcgmHandle        IN: DCGM Handle
+ * @param groupId            IN: Group ID for which entities are to be fetched
+ * @param entities       IN/OUT: entities->version and entities->startIndex are inputs. Up to
+ *                               \ref DCGM_GROUP_ENTITIES_PAGE_SIZE entities from startIndex on are returned
+ *                               along with the total number of entities in the group
+ *
+ * @return
+ *  - \ref DCGM_ST_OK                   if the entities were successfully received.
+ *  - \ref DCGM_ST_BADPARAM             if \a entities is NULL or \a entities->startIndex is past the end of
+ *                                      the group
+ *  - \ref DCGM_ST_VER_MISMATCH         if \a entities->version is invalid
+ *  - \ref DCGM_ST_INIT_ERROR           if the library has not been successfully initialized.
+ *  - \ref DCGM_ST_NOT_CONFIGURED       if entry corresponding to the group (\a groupId) does not exists
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmGroupGetEntities(dcgmHandle_t pDcgmHandle,
+                                                  dcgmGpuGrp_t groupId,
+                                                  dcgmGroupEntities_t *entities);
+
 /**
  * Used to get the Ids of all groups of entities. The information returned is a list of group ids
  * in \a groupIdList as well as a count of how many ids there are in \a count. Please allocate enough
@@ -1029,6 +1053,47 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmGetValuesSince_v2(dcgmHandle_t pDcgmHandle,
                                                    dcgmFieldValueEntityEnumeration_f enumCB,
                                                    void *userData);
 
+/**
+ * Request all field values that have updated since a given timestamp as columns
+ *
+ * This returns the same values as \ref dcgmGetValuesSince_v2, but copies them straight into caller-owned
+ * arrays instead of invoking a callback for every entity. This is meant for language bindings and
+ * analytics consumers that want to hand the results to a vectorized library without a per-value copy.
+ *
+ * If the arrays or string pool in \a values are too small, as many complete values as fit are stored,
+ * values->totalCount and values->stringPoolNeeded say how much room is needed, nextSinceTimestamp is
+ * left at sinceTimestamp, and DCGM_ST_INSUFFICIENT_SIZE is returned. The caller can then grow its
+ * buffers and retry.
+ *
+ * @param pDcgmHandle         IN: DCGM Handle
+ * @param groupId             IN: Group ID representing collection of one or more entities. Look at \ref dcgmGroupCreate
+ *                                for details on creating the group. Alternatively, pass in the group id as
+ *                                \a DCGM_GROUP_ALL_GPUS to perform operation on all the GPUs or
+ *                                \a DCGM_GROUP_ALL_NVSWITCHES to perform the operation on all NvSwitches.
+ * @param fieldGroupId        IN: Fields to return data for
+ * @param sinceTimestamp      IN: Timestamp to request values since in usec since 1970. This will be returned in
+ *                                nextSinceTimestamp for subsequent calls 0 = request all data
+ * @param untilTimestamp      IN: Timestamp to request values until in usec since 1970. 0 = up to now
+ * @param nextSinceTimestamp OUT: Timestamp to use for sinceTimestamp on next call to this function
+ * @param values          IN/OUT: Columns to store the values in. values->version, values->capacity, the per-value
+ *                                arrays and the string pool must be set by the caller. A NULL string pool gets
+ *                                the offsets and lengths of string and binary values without their contents
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid
+ *        - \ref DCGM_ST_VER_MISMATCH         if values->version is not a supported version
+ *        - \ref DCGM_ST_INSUFFICIENT_SIZE    if not all values fit in \a values
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmGetValuesSinceColumnar(dcgmHandle_t pDcgmHandle,
+                                                        dcgmGpuGrp_t groupId,
+                                                        dcgmFieldGrp_t fieldGroupId,
+                                                        long long sinceTimestamp,
+                                                        long long untilTimestamp,
+                                                        long long *nextSinceTimestamp,
+                                                        dcgmColumnarValues_t *values);
+
 /**
  * Request latest cached field value for a field value collection
  *
@@ -1083,6 +1148,47 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmGetLatestValues_v2(dcgmHandle_t pDcgmHandle,
                                                     dcgmFieldValueEntityEnumeration_f enumCB,
                                                     void *userData);
 
+/**
+ * Request the latest cached field values for a field value collection that changed since the last call
+ *
+ * The host engine remembers, for each connection, group and field group, the values it returned last time.
+ * Only the values whose status or value changed since then are returned, so exporters that poll static or slowly
+ * changing fields every interval don't pay to transfer and enumerate them again. A newer sample of the same value
+ * is not a change.
+ *
+ * The first call for a group and field group returns every value, as does every \a resyncInterval -th call after
+ * that, so a caller can rebuild its view from scratch periodically. What the host engine remembers is dropped when
+ * the connection closes or the group or field group is destroyed.
+ *
+ * @param pDcgmHandle        IN: DCGM Handle
+ * @param groupId            IN: Group ID representing collection of one or more entities. Look at \ref dcgmGroupCreate
+ *                               for details on creating the group. Alternatively, pass in the group id as
+ *                               \a DCGM_GROUP_ALL_GPUS to perform operation on all the GPUs or
+ *                               \a DCGM_GROUP_ALL_NVSWITCHES to perform the operation on all NvSwitches.
+ * @param fieldGroupId       IN: Fields to return data for.
+ * @param resyncInterval     IN: Return every value on every resyncInterval-th call. Pass 1 to always get every value
+ *                               or 0 for \ref DCGM_FV_CHANGES_DEFAULT_RESYNC_INTERVAL.
+ * @param isResync          OUT: Optional. Set to 1 if every value was returned or 0 if only the values that changed
+ *                               were.
+ * @param enumCB             IN: Callback to invoke for every field value that changed. It isn't called at all if
+ *                               nothing changed.
+ * @param userData           IN: User data pointer to pass to the userData field of enumCB.
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid
+ *        - \ref DCGM_ST_INSUFFICIENT_SIZE    if the changed values don't fit in one response. Nothing is recorded as
+ *                                            returned, so use a smaller group or field group
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmGetLatestValueChanges(dcgmHandle_t pDcgmHandle,
+                                                       dcgmGpuGrp_t groupId,
+                                                       dcgmFieldGrp_t fieldGroupId,
+                                                       unsigned int resyncInterval,
+                                                       int *isResync,
+                                                       dcgmFieldValueEntityEnumeration_f enumCB,
+                                                       void *userData);
+
 /**
  * Request latest cached field value for a GPU
  *
@@ -1142,6 +1248,48 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmEntitiesGetLatestValues(dcgmHandle_t pDcgmHandl
                                                          unsigned int flags,
                                                          dcgmFieldValue_v2 values[]);
 
+/**
+ * Request the cached field values for a list of fields for a group of entities as of one completed
+ * update cycle of the host engine.
+ *
+ * Unlike \ref dcgmEntitiesGetLatestValues, none of the returned values come from an update cycle that is
+ * still in progress, so the values of all of the entities are a consistent snapshot. Fields that were
+ * not due to be updated in that cycle return the value from the last cycle that updated them.
+ *
+ * To see every cycle once without forcing extra polls with \ref dcgmUpdateAllFields, pass 0 in *cycleId
+ * on the first call and the *cycleId returned by the previous call on every call after that.
+ *
+ * Note: The returned entities are not guaranteed to be in any order. Reordering can occur internally
+ *       in order to optimize calls to the NVIDIA driver.
+ *
+ * @param pDcgmHandle   IN: DCGM Handle
+ * @param entities      IN: List of entities to get values for
+ * @param entityCount   IN: Number of entries in entities[]
+ * @param fields        IN: Field IDs to return data for. See the definitions in dcgm_fields.h that start with DCGM_FI_.
+ * @param fieldCount    IN: Number of field IDs in fields[] array.
+ * @param cycleId   IN/OUT: IN: 0 to use the last completed update cycle. Otherwise, the last cycle ID that was
+ *                          returned to the caller. This waits for a later cycle to complete.
+ *                          OUT: ID of the update cycle the values are from. Cycle IDs increase with every cycle.
+ * @param timeoutMs     IN: How long to wait for an update cycle to complete, in milliseconds. This can be at most
+ *                          \ref DCGM_MAX_CYCLE_WAIT_MS. Cycles only happen when \ref dcgmUpdateAllFields is called
+ *                          if the host engine was started in DCGM_OPERATION_MODE_MANUAL.
+ * @param values       OUT: Field values for the fields requested. This must be able to hold entityCount *
+ *                          fieldCount field value records.
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                if the call was successful
+ *        - \ref DCGM_ST_TIMEOUT           if no update cycle after *cycleId completed within timeoutMs
+ *        - \ref DCGM_ST_BADPARAM          if a parameter is invalid
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmEntitiesGetCycleValues(dcgmHandle_t pDcgmHandle,
+                                                        dcgmGroupEntityPair_t entities[],
+                                                        unsigned int entityCount,
+                                                        unsigned short fields[],
+                                                        unsigned int fieldCount,
+                                                        long long *cycleId,
+                                                        unsigned int timeoutMs,
+                                                        dcgmFieldValue_v2 values[]);
+
 /*************************************************************************/
 /**
  * Get a summary of the values for a field id over a period of time.
@@ -1788,6 +1936,114 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmIntrospectGetHostengineCpuUtilization(dcgmHandl
                                                                        dcgmIntrospectCpuUtil_t *cpuUtil,
                                                                        int waitIfNoData);
 
+/*************************************************************************/
+/**
+ * Retrieve how long client requests to the DCGM hostengine waited to be processed, by priority class.
+ * Requests are queued by class (see DCGM_INTROSPECT_QUEUE_CLASS_*) and served by weighted fair
+ * queuing across client connections.
+ *
+ * @param pDcgmHandle        IN: DCGM Handle
+ * @param queueWait      IN/OUT: see \ref dcgmIntrospectQueueWait_t. queueWait->version must be set to
+ *                               dcgmIntrospectQueueWait_version prior to this call.
+ *
+ * @return
+ *       - \ref DCGM_ST_OK                   if the call was successful
+ *       - \ref DCGM_ST_VER_MISMATCH         if queueWait->version is 0 or invalid.
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmIntrospectGetHostengineQueueWait(dcgmHandle_t pDcgmHandle,
+                                                                  dcgmIntrospectQueueWait_t *queueWait);
+
+/*************************************************************************/
+/**
+ * Retrieve how many of the forced update cycles requested with \ref dcgmUpdateAllFields were executed
+ * and how many were coalesced with another cycle.
+ *
+ * @param pDcgmHandle        IN: DCGM Handle
+ * @param forcedUpdates  IN/OUT: see \ref dcgmIntrospectForcedUpdates_t. forcedUpdates->version must be set to
+ *                               dcgmIntrospectForcedUpdates_version prior to this call.
+ *
+ * @return
+ *       - \ref DCGM_ST_OK                   if the call was successful
+ *       - \ref DCGM_ST_VER_MISMATCH         if forcedUpdates->version is 0 or invalid.
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmIntrospectGetForcedUpdates(dcgmHandle_t pDcgmHandle,
+                                                            dcgmIntrospectForcedUpdates_t *forcedUpdates);
+
+/*************************************************************************/
+/**
+ * Retrieve how much memory the hostengine's cache of field samples is using, its budget and how many samples
+ * were evicted to stay within that budget.
+ *
+ * @param pDcgmHandle      IN: DCGM Handle
+ * @param cacheMemory  IN/OUT: see \ref dcgmIntrospectCacheMemory_t. cacheMemory->version must be set to
+ *                             dcgmIntrospectCacheMemory_version prior to this call.
+ *
+ * @return
+ *       - \ref DCGM_ST_OK                   if the call was successful
+ *       - \ref DCGM_ST_BADPARAM             if cacheMemory is NULL
+ *       - \ref DCGM_ST_VER_MISMATCH         if cacheMemory->version is 0 or invalid.
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmIntrospectGetCacheMemory(dcgmHandle_t pDcgmHandle,
+                                                          dcgmIntrospectCacheMemory_t *cacheMemory);
+
+/*************************************************************************/
+/**
+ * Set a budget for the memory used by the hostengine's cache of field samples. Whenever the cache grows past
+ * the budget, samples are evicted until it is back under it. See \ref dcgmIntrospectCacheMemory_t for which
+ * samples are evicted first.
+ *
+ * The budget can also be set with the --max-cache-memory option of nv-hostengine.
+ *
+ * @param pDcgmHandle  IN: DCGM Handle
+ * @param budgetBytes  IN: Budget in bytes. 0 = unlimited
+ *
+ * @return
+ *       - \ref DCGM_ST_OK                   if the call was successful
+ *       - \ref DCGM_ST_BADPARAM             if budgetBytes is negative
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmIntrospectSetCacheMemoryBudget(dcgmHandle_t pDcgmHandle, long long budgetBytes);
+
+/*************************************************************************/
+/**
+ * Get the state of every downstream hostengine of an aggregating hostengine. A hostengine aggregates other
+ * hostengines when it was started with the --federate option of nv-hostengine. It keeps a connection to every
+ * one of them, watches the federated fields there and mirrors their latest values.
+ *
+ * @param pDcgmHandle  IN: DCGM Handle
+ * @param nodes       OUT: State of every downstream hostengine. nodes->version must be set to
+ *                         \ref dcgmFederationNodes_version
+ *
+ * @return
+ *       - \ref DCGM_ST_OK                   if the call was successful
+ *       - \ref DCGM_ST_BADPARAM             if nodes is NULL
+ *       - \ref DCGM_ST_VER_MISMATCH         if nodes->version is invalid
+ *       - \ref DCGM_ST_NOT_CONFIGURED       if the hostengine doesn't aggregate any hostengines
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmFederationGetNodes(dcgmHandle_t pDcgmHandle, dcgmFederationNodes_t *nodes);
+
+/*************************************************************************/
+/**
+ * Get a page of the latest field values that an aggregating hostengine mirrored from its downstream
+ * hostengines. Values are qualified by the node they came from. See \ref dcgmFederationGetNodes.
+ *
+ * @param pDcgmHandle  IN: DCGM Handle
+ * @param values   IN/OUT: values->version, values->nodeId and values->startIndex are inputs. The rest is
+ *                         populated on success
+ *
+ * @return
+ *       - \ref DCGM_ST_OK                   if the call was successful
+ *       - \ref DCGM_ST_BADPARAM             if values is NULL or values->nodeId isn't a valid node
+ *       - \ref DCGM_ST_VER_MISMATCH         if values->version is invalid
+ *       - \ref DCGM_ST_NOT_CONFIGURED       if the hostengine doesn't aggregate any hostengines
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmFederationGetLatestValues(dcgmHandle_t pDcgmHandle, dcgmFederationValues_t *values);
+
 /** @} */ // Closing for DCGMAPI_METADATA
 
 /***************************************************************************************************/
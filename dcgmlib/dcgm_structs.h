@@ -607,6 +607,42 @@ typedef dcgmGroupInfo_v2 dcgmGroupInfo_t;
  */
 #define dcgmGroupInfo_version dcgmGroupInfo_version2
 
+/**
+ * Maximum number of entities returned by one call to \ref dcgmGroupGetEntities
+ */
+#define DCGM_GROUP_ENTITIES_PAGE_SIZE 1024
+
+/**
+ * Structure to page through the entities of a DCGM group. Unlike \ref dcgmGroupInfo_t, this works on
+ * groups with more than \ref DCGM_GROUP_MAX_ENTITIES entities
+ *
+ * Added in DCGM 3.2.0
+ */
+typedef struct
+{
+    unsigned int version;    //!< IN: Version Number (use dcgmGroupEntities_version1)
+    unsigned int startIndex; //!< IN: Index of the first entity to return. 0 = the start of the group
+    unsigned int count;      //!< OUT: Number of entities returned in \a entityList
+    unsigned int totalCount; //!< OUT: Number of entities in the group. Keep calling with startIndex += count
+                             //!<      until startIndex reaches this
+    dcgmGroupEntityPair_t entityList[DCGM_GROUP_ENTITIES_PAGE_SIZE]; //!< OUT: Entities in the order they were added
+} dcgmGroupEntities_v1;
+
+/**
+ * Typedef for \ref dcgmGroupEntities_v1
+ */
+typedef dcgmGroupEntities_v1 dcgmGroupEntities_t;
+
+/**
+ * Version 1 for \ref dcgmGroupEntities_v1
+ */
+#define dcgmGroupEntities_version1 MAKE_DCGM_VERSION(dcgmGroupEntities_v1, 1)
+
+/**
+ * Latest version for \ref dcgmGroupEntities_t
+ */
+#define dcgmGroupEntities_version dcgmGroupEntities_version1
+
 /**
  * Enum for the different kinds of MIG profiles
  */
@@ -1965,6 +2001,17 @@ typedef struct
  */
 #define DCGM_FV_FLAG_LIVE_DATA 0x00000001
 
+/**
+ * Maximum timeoutMs that can be passed to dcgmEntitiesGetCycleValues()
+ */
+#define DCGM_MAX_CYCLE_WAIT_MS 60000
+
+/**
+ * How many calls of dcgmGetLatestValueChanges() are answered with only the values that changed before
+ * every value is sent again, when 0 is passed as its resyncInterval
+ */
+#define DCGM_FV_CHANGES_DEFAULT_RESYNC_INTERVAL 60
+
 /**
  * User callback function for processing one or more field updates. This callback will
  * be invoked one or more times per field until all of the expected field values have been
@@ -2009,6 +2056,67 @@ typedef int (*dcgmFieldValueEntityEnumeration_f)(dcgm_field_entity_group_t entit
                                                  int numValues,
                                                  void *userData);
 
+/**
+ * Value of dcgmColumnarValues_v1::poolOffsets[] for values that have nothing in the string pool
+ */
+#define DCGM_COLUMNAR_NO_POOL_ENTRY 0xFFFFFFFF
+
+/**
+ * Struct-of-arrays output of \ref dcgmGetValuesSinceColumnar. Value i is made up of entry i of
+ * each of the per-value arrays. All arrays are owned by the caller.
+ *
+ * Each per-value array must have room for \a capacity entries. Any per-value array can be NULL
+ * if the caller doesn't need that column. The unused one of int64Values[i] and doubleValues[i]
+ * is set to DCGM_INT64_BLANK or DCGM_FP64_BLANK.
+ *
+ * String and binary values are copied into \a stringPool. Strings are NULL terminated, and
+ * poolLengths[i] includes the terminator. If \a stringPool is NULL, string and binary values
+ * are not copied anywhere, but poolOffsets[i], poolLengths[i] and \a stringPoolNeeded are still
+ * set as if the pool were big enough. This can be used to size the pool or to skip string and
+ * binary payloads.
+ */
+typedef struct
+{
+    unsigned int version; //!< Version number. Use dcgmColumnarValues_version
+
+    unsigned int capacity;   //!< IN: How many entries each of the per-value arrays can hold
+    unsigned int count;      //!< OUT: How many values were stored in the per-value arrays
+    unsigned int totalCount; //!< OUT: How many values there were. If this is greater than count,
+                             //!<      the call returned DCGM_ST_INSUFFICIENT_SIZE
+
+    long long *timestamps;                     //!< OUT: Timestamp of each value in usec since 1970
+    dcgm_field_entity_group_t *entityGroupIds; //!< OUT: Entity group of each value
+    dcgm_field_eid_t *entityIds;               //!< OUT: Entity of each value
+    unsigned short *fieldIds;                  //!< OUT: Field ID of each value. One of DCGM_FI_?
+    unsigned short *fieldTypes;                //!< OUT: Field type of each value. One of DCGM_FT_?
+    int *statuses;                             //!< OUT: Status of each value. DCGM_ST_OK or one of DCGM_ST_?
+    long long *int64Values;                    //!< OUT: Value of DCGM_FT_INT64 and DCGM_FT_TIMESTAMP fields
+    double *doubleValues;                      //!< OUT: Value of DCGM_FT_DOUBLE fields
+    unsigned int *poolOffsets;                 //!< OUT: Offset of string and binary values in stringPool
+    unsigned int *poolLengths;                 //!< OUT: Size of string and binary values in stringPool
+
+    char *stringPool;                //!< OUT: Buffer that string and binary values are copied into. NULL = don't copy
+    unsigned int stringPoolCapacity; //!< IN: Size of stringPool in bytes
+    unsigned int stringPoolUsed;     //!< OUT: How many bytes of stringPool were used. If a value didn't fit,
+                                     //!<      the call returned DCGM_ST_INSUFFICIENT_SIZE
+    unsigned int stringPoolNeeded;   //!< OUT: How many bytes of stringPool all values would need
+} dcgmColumnarValues_v1;
+
+/**
+ * Typedef for \ref dcgmColumnarValues_v1
+ */
+typedef dcgmColumnarValues_v1 dcgmColumnarValues_t;
+
+/**
+ * Version 1 for \ref dcgmColumnarValues_v1
+ */
+#define dcgmColumnarValues_version1 MAKE_DCGM_VERSION(dcgmColumnarValues_v1, 1)
+
+/**
+ * Latest version for \ref dcgmColumnarValues_t
+ */
+#define dcgmColumnarValues_version dcgmColumnarValues_version1
+
 
 /**
  * Summary of time series data in int64 format.
@@ -2765,6 +2873,226 @@ typedef dcgmIntrospectCpuUtil_v1 dcgmIntrospectCpuUtil_t;
  */
 #define dcgmIntrospectCpuUtil_version dcgmIntrospectCpuUtil_version1
 
+/**
+ * Priority classes that the hostengine schedules client requests in
+ */
+#define DCGM_INTROSPECT_QUEUE_CLASS_HIGH   0 //!< Liveness probes, health checks and policy registration
+#define DCGM_INTROSPECT_QUEUE_CLASS_NORMAL 1 //!< Requests that aren't classified as high or bulk
+#define DCGM_INTROSPECT_QUEUE_CLASS_BULK   2 //!< Large sample reads and diagnostic runs
+#define DCGM_INTROSPECT_QUEUE_CLASS_COUNT  3 //!< Number of priority classes
+
+/**
+ * How long requests of one priority class waited to be processed by the hostengine
+ */
+typedef struct
+{
+    unsigned long long numRequests;   //!< Number of requests of this class that have been processed
+    unsigned long long totalWaitUsec; //!< Total time those requests spent queued, in usec
+    unsigned long long maxWaitUsec;   //!< Longest time any of those requests spent queued, in usec
+    unsigned int numQueued;           //!< Number of requests of this class that are queued right now
+} dcgmIntrospectQueueClassWait_t;
+
+/**
+ * Queue wait times of the hostengine's client requests by priority class
+ */
+typedef struct
+{
+    unsigned int version;                                                      //!< version number
+    dcgmIntrospectQueueClassWait_t classes[DCGM_INTROSPECT_QUEUE_CLASS_COUNT]; //!< See DCGM_INTROSPECT_QUEUE_CLASS_*
+} dcgmIntrospectQueueWait_v1;
+
+/**
+ * Typedef for \ref dcgmIntrospectQueueWait_t
+ */
+typedef dcgmIntrospectQueueWait_v1 dcgmIntrospectQueueWait_t;
+
+/**
+ * Version 1 for \ref dcgmIntrospectQueueWait_t
+ */
+#define dcgmIntrospectQueueWait_version1 MAKE_DCGM_VERSION(dcgmIntrospectQueueWait_v1, 1)
+
+/**
+ * Latest version for \ref dcgmIntrospectQueueWait_t
+ */
+#define dcgmIntrospectQueueWait_version dcgmIntrospectQueueWait_version1
+
+/**
+ * Counts of the forced update cycles that clients requested with dcgmUpdateAllFields()
+ *
+ * Forced updates are coalesced. A request that arrives while a forced cycle is queued is attached to that
+ * cycle instead of queueing another one. If a minimum spacing is set with the
+ * __DCGM_FORCED_UPDATE_MIN_SPACING_MS environment variable of the hostengine, a request is also satisfied
+ * by a cycle that started less than that long before it.
+ */
+typedef struct
+{
+    unsigned int version;     //!< version number
+    long long numRequests;    //!< Number of forced update requests
+    long long numExecuted;    //!< Number of forced update cycles that were executed
+    long long numCoalesced;   //!< Number of forced update requests that attached to another cycle
+    long long numSkipped;     //!< Number of queued forced update cycles that were skipped since a timed cycle
+                              //!< satisfied their requests first
+    long long minSpacingUsec; //!< Minimum spacing between forced update cycles, in usec
+} dcgmIntrospectForcedUpdates_v1;
+
+/**
+ * Typedef for \ref dcgmIntrospectForcedUpdates_t
+ */
+typedef dcgmIntrospectForcedUpdates_v1 dcgmIntrospectForcedUpdates_t;
+
+/**
+ * Version 1 for \ref dcgmIntrospectForcedUpdates_t
+ */
+#define dcgmIntrospectForcedUpdates_version1 MAKE_DCGM_VERSION(dcgmIntrospectForcedUpdates_v1, 1)
+
+/**
+ * Latest version for \ref dcgmIntrospectForcedUpdates_t
+ */
+#define dcgmIntrospectForcedUpdates_version dcgmIntrospectForcedUpdates_version1
+
+/**
+ * Memory used by the hostengine's cache of field samples, and what has been evicted to keep it within the
+ * budget set with \ref dcgmIntrospectSetCacheMemoryBudget
+ *
+ * When the budget is exceeded, the oldest samples are evicted first from fields that nobody watches anymore,
+ * then from fields that only clients watch and last from fields that hostengine modules watch. The newest
+ * sample of every field is always kept.
+ */
+typedef struct
+{
+    unsigned int version;     //!< version number
+    long long budgetBytes;    //!< Cache memory budget in bytes. 0 = unlimited
+    long long usedBytes;      //!< Bytes used by cached samples right now
+    long long numEvictions;   //!< Number of times samples were evicted because the budget was exceeded
+    long long evictedSamples; //!< Number of samples that were evicted
+    long long evictedBytes;   //!< Bytes that were freed by evicting samples
+} dcgmIntrospectCacheMemory_v1;
+
+/**
+ * Typedef for \ref dcgmIntrospectCacheMemory_t
+ */
+typedef dcgmIntrospectCacheMemory_v1 dcgmIntrospectCacheMemory_t;
+
+/**
+ * Version 1 for \ref dcgmIntrospectCacheMemory_t
+ */
+#define dcgmIntrospectCacheMemory_version1 MAKE_DCGM_VERSION(dcgmIntrospectCacheMemory_v1, 1)
+
+/**
+ * Latest version for \ref dcgmIntrospectCacheMemory_t
+ */
+#define dcgmIntrospectCacheMemory_version dcgmIntrospectCacheMemory_version1
+
+/**
+ * Maximum number of downstream hostengines that an aggregating hostengine can federate
+ */
+#define DCGM_FEDERATION_MAX_NODES 64
+
+/**
+ * Maximum number of field values returned by one call to \ref dcgmFederationGetLatestValues
+ */
+#define DCGM_FEDERATION_MAX_VALUES 128
+
+/**
+ * Pass as dcgmFederationValues_v1::nodeId to get the values of every node
+ */
+#define DCGM_FEDERATION_ALL_NODES 0xFFFFFFFF
+
+/**
+ * State of one downstream hostengine of an aggregating hostengine
+ */
+typedef struct
+{
+    unsigned int nodeId;               //!< ID that qualifies the entities of this node in federated field values
+    unsigned int connected;            //!< 1 if the aggregator is connected to the node right now. 0 if not
+    char address[DCGM_MAX_STR_LENGTH]; //!< Address the node was configured with
+    long long lagUsec;         //!< How old the newest mirrored sample was when the last sync finished. This includes
+                               //!< any clock skew between the hosts. 0 = nothing was mirrored yet
+    long long syncLatencyUsec; //!< How long the last successful sync with the node took
+    long long lastSyncTs;      //!< When the last successful sync finished in usec since 1970. 0 = never
+    long long numSyncs;        //!< Number of successful syncs with the node
+    long long numErrors;       //!< Number of failed connection attempts and syncs
+    long long numValues;       //!< Number of field values mirrored from the node right now
+} dcgmFederationNode_v1;
+
+/**
+ * State of every downstream hostengine of an aggregating hostengine
+ */
+typedef struct
+{
+    unsigned int version;                                //!< version number (dcgmFederationNodes_version)
+    unsigned int numNodes;                               //!< Number of entries in nodes[] that are populated
+    dcgmFederationNode_v1 nodes[DCGM_FEDERATION_MAX_NODES]; //!< One entry per downstream hostengine
+} dcgmFederationNodes_v1;
+
+/**
+ * Typedef for \ref dcgmFederationNodes_v1
+ */
+typedef dcgmFederationNodes_v1 dcgmFederationNodes_t;
+
+/**
+ * Version 1 for \ref dcgmFederationNodes_v1
+ */
+#define dcgmFederationNodes_version1 MAKE_DCGM_VERSION(dcgmFederationNodes_v1, 1)
+
+/**
+ * Latest version for \ref dcgmFederationNodes_t
+ */
+#define dcgmFederationNodes_version dcgmFederationNodes_version1
+
+/**
+ * Latest value of one field of one entity of a downstream hostengine. Entities are qualified by the node
+ * they belong to since entity IDs are only unique within a node.
+ */
+typedef struct
+{
+    unsigned int nodeId;                     //!< Node this value was mirrored from. See dcgmFederationNode_v1::nodeId
+    dcgm_field_entity_group_t entityGroupId; //!< Entity group of the entity on the node
+    dcgm_field_eid_t entityId;               //!< Entity ID on the node
+    unsigned short fieldId;                  //!< One of DCGM_FI_?
+    unsigned short fieldType;                //!< One of DCGM_FT_?. Binary fields are not mirrored
+    int status;                              //!< Status of the value on the node. DCGM_ST_OK or one of DCGM_ST_?
+    int64_t ts;                              //!< Timestamp of the value on the node in usec since 1970
+    union
+    {
+        int64_t i64;                   //!< Int64 value
+        double dbl;                    //!< Double value
+        char str[DCGM_MAX_STR_LENGTH]; //!< NULL terminated string
+    } value;                           //!< Value
+} dcgmFederationFieldValue_v1;
+
+/**
+ * A page of the latest field values that an aggregating hostengine mirrored from its downstream hostengines
+ */
+typedef struct
+{
+    unsigned int version;    //!< IN: version number (dcgmFederationValues_version)
+    unsigned int nodeId;     //!< IN: Node to get the values of or DCGM_FEDERATION_ALL_NODES
+    unsigned int startIndex; //!< IN: Index of the first value to return. Pass numValues of each page summed up to
+                             //!<     page through more than DCGM_FEDERATION_MAX_VALUES values
+    unsigned int numValues;  //!< OUT: Number of entries in values[] that are populated
+    unsigned int totalValues; //!< OUT: Number of values there are for nodeId in total
+    unsigned int generation;  //!< OUT: Changes whenever values are added, which moves the indexes of the values after
+                              //!<      them. Start over from startIndex 0 if it differs between the pages of a listing
+    dcgmFederationFieldValue_v1 values[DCGM_FEDERATION_MAX_VALUES]; //!< OUT: Values ordered by node, entity group,
+                                                                    //!<      entity and field
+} dcgmFederationValues_v1;
+
+/**
+ * Typedef for \ref dcgmFederationValues_v1
+ */
+typedef dcgmFederationValues_v1 dcgmFederationValues_t;
+
+/**
+ * Version 1 for \ref dcgmFederationValues_v1
+ */
+#define dcgmFederationValues_version1 MAKE_DCGM_VERSION(dcgmFederationValues_v1, 1)
+
+/**
+ * Latest version for \ref dcgmFederationValues_t
+ */
+#define dcgmFederationValues_version dcgmFederationValues_version1
+
 #define DCGM_MAX_CONFIG_FILE_LEN 10000
 #define DCGM_MAX_TEST_NAMES      20
 #define DCGM_MAX_TEST_NAMES_LEN  50
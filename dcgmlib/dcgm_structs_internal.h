@@ -199,6 +199,12 @@ typedef unsigned int dcgm_connection_id_t;
 /* Cache Manager Info flags */
 #define DCGM_CMI_F_WATCHED 0x00000001 /* Is this field being watched? */
 
+/* How the cache manager stores samples. See __DCGM_CACHE_HUGEPAGES */
+#define DCGM_CM_HUGEPAGES_NONE        0 /* Samples are on the default heap */
+#define DCGM_CM_HUGEPAGES_TRANSPARENT 1 /* Samples are in per-NUMA node pools backed by transparent hugepages */
+#define DCGM_CM_HUGEPAGES_EXPLICIT    2 /* Like DCGM_CM_HUGEPAGES_TRANSPARENT, but reserved hugetlbfs pages are
+                                           used while there are any */
+
 /* This structure mirrors the DcgmWatcher object */
 typedef struct dcgm_cm_field_info_watcher_t
 {
@@ -214,7 +220,7 @@ typedef struct dcgm_cm_field_info_watcher_t
  */
 #define DCGM_CM_FIELD_INFO_NUM_WATCHERS 10
 
-typedef struct dcgmCacheManagerFieldInfo_v4_t
+typedef struct dcgmCacheManagerFieldInfo_v5_t
 {
     unsigned int version;          /* Version. Check against dcgmCacheManagerInfo_version */
     unsigned int flags;            /* Bitmask of DCGM_CMI_F_? #defines that apply to this field */
@@ -236,9 +242,18 @@ typedef struct dcgmCacheManagerFieldInfo_v4_t
     int numWatchers;               /* Number of watchers that are valid in watchers[] */
     dcgm_cm_field_info_watcher_t watchers[DCGM_CM_FIELD_INFO_NUM_WATCHERS]; /* Who are the first 10
                                                                            watchers of this field? */
-} dcgmCacheManagerFieldInfo_v4_t, *dcgmCacheManagerFieldInfo_v4_p;
+    int numaNode;                  /* NUMA node of the pool that holds this field's samples.
+                                      -1=the samples are on the default heap */
+    int hugePages;                 /* DCGM_CM_HUGEPAGES_? mode of that pool */
+    long long sampleBytes;         /* Bytes of sample storage that this field holds */
+    long long poolBytesReserved;   /* Bytes that the pool has mapped. This is shared by every field in the pool */
+    long long poolBytesInUse;      /* Bytes of the pool that are holding samples of any field */
+    long long poolHeapFallbacks;   /* Allocations that the pool had to serve from the default heap */
+    long long budgetEvictedSamples; /* Samples of this field that were evicted to stay within the cache
+                                       memory budget */
+} dcgmCacheManagerFieldInfo_v5_t, *dcgmCacheManagerFieldInfo_v5_p;
 
-#define dcgmCacheManagerFieldInfo_version4 MAKE_DCGM_VERSION(dcgmCacheManagerFieldInfo_v4_t, 4)
+#define dcgmCacheManagerFieldInfo_version5 MAKE_DCGM_VERSION(dcgmCacheManagerFieldInfo_v5_t, 5)
 
 /**
  * The maximum number of topology elements possible given DCGM_MAX_NUM_DEVICES
@@ -553,6 +568,36 @@ typedef struct
     char buffer[SAMPLES_BUFFER_SIZE_V2]; //!< OUT: this field is last, and can be truncated for speed */
 } dcgmEntitiesGetLatestValues_v2;
 
+/**
+ * Version 1 of dcgmGetLatestValueChanges_t
+ */
+typedef struct
+{
+    unsigned int groupId;        //!< IN: Group to get values for
+    unsigned int fieldGroupId;   //!< IN: Field group to get values for
+    unsigned int resyncInterval; //!< IN: Send every value on every resyncInterval-th call. 0 = default
+    unsigned int isResync;       //!< OUT: 1 if buffer has every value. 0 if only the ones that changed
+    unsigned int cmdRet;         //!< OUT: Error code generated
+    unsigned int bufferSize;     //!< OUT: Length of populated buffer. 0 if nothing changed
+    char buffer[SAMPLES_BUFFER_SIZE_V2]; //!< OUT: this field is last, and can be truncated for speed */
+} dcgmGetLatestValueChanges_v1;
+
+/**
+ * Version 1 of dcgmEntitiesGetCycleValues_t
+ */
+typedef struct
+{
+    dcgmGroupEntityPair_t entities[DCGM_GROUP_MAX_ENTITIES];        //!< IN: List of entities to get values for
+    unsigned int entitiesCount;                                     //!< IN: Number of entries in entities[]
+    unsigned short fieldIdList[DCGM_MAX_FIELD_IDS_PER_FIELD_GROUP]; //!< IN: Field IDs to return data for
+    unsigned int fieldIdCount;                                      //!< IN: Number of field IDs in fieldIdList[] array.
+    long long cycleId;       //!< IN/OUT: Last update cycle the caller has seen, or 0. OUT: Cycle the values are from
+    unsigned int timeoutMs;  //!< IN: How long to wait for a cycle after cycleId to complete
+    unsigned int cmdRet;     //!< OUT: Error code generated
+    unsigned int bufferSize; //!< OUT: Length of populated buffer
+    char buffer[SAMPLES_BUFFER_SIZE_V2]; //!< OUT: this field is last, and can be truncated for speed */
+} dcgmEntitiesGetCycleValues_v1;
+
 /**
  * Version 1 of dcgmGetMultipleValuesForField
  */
@@ -680,15 +725,15 @@ typedef struct
 typedef dcgmInjectFieldValueMsg_v1 dcgmInjectFieldValueMsg_t;
 
 /**
- * Version 2 of dcgmGetCacheManagerFieldInfo_t
+ * Version 3 of dcgmGetCacheManagerFieldInfo_t
  */
 typedef struct
 {
-    dcgmCacheManagerFieldInfo_v4_t
+    dcgmCacheManagerFieldInfo_v5_t
         fieldInfo;       //!< IN/OUT: Structure to populate. fieldInfo->gpuId and fieldInfo->fieldId must
                          //           be populated on calling for this call to work
     unsigned int cmdRet; //!< OUT: Error code generated
-} dcgmGetCacheManagerFieldInfo_v2;
+} dcgmGetCacheManagerFieldInfo_v3;
 
 typedef struct
 {
@@ -343,7 +343,7 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmInjectFieldValue(dcgmHandle_t pDcgmHandle,
  *
  */
 dcgmReturn_t DCGM_PUBLIC_API dcgmGetCacheManagerFieldInfo(dcgmHandle_t pDcgmHandle,
-                                                          dcgmCacheManagerFieldInfo_v4_t *fieldInfo);
+                                                          dcgmCacheManagerFieldInfo_v5_t *fieldInfo);
 
 /**
  * This method returns the status of the gpu
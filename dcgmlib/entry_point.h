@@ -26,7 +26,7 @@ DCGM_ENTRY_POINT(dcgmInjectFieldValue,
 
 DCGM_ENTRY_POINT(dcgmGetCacheManagerFieldInfo,
                  tsapiEngineGetCacheManagerFieldInfo,
-                 (dcgmHandle_t pDcgmHandle, dcgmCacheManagerFieldInfo_v4_t *fieldInfo),
+                 (dcgmHandle_t pDcgmHandle, dcgmCacheManagerFieldInfo_v5_t *fieldInfo),
                  "({} {})",
                  pDcgmHandle,
                  fieldInfo)
@@ -231,6 +231,14 @@ DCGM_ENTRY_POINT(dcgmGroupGetInfo,
                  groupId,
                  pDcgmGroupInfo)
 
+DCGM_ENTRY_POINT(dcgmGroupGetEntities,
+                 tsapiEngineGroupGetEntities,
+                 (dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId, dcgmGroupEntities_t *entities),
+                 "({} {} {})",
+                 pDcgmHandle,
+                 groupId,
+                 entities)
+
 DCGM_ENTRY_POINT(dcgmGroupGetAllIds,
                  tsapiGroupGetAllIds,
                  (dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupIdList[], unsigned int *count),
@@ -506,6 +514,24 @@ DCGM_ENTRY_POINT(dcgmGetValuesSince_v2,
                  enumCB,
                  userData)
 
+DCGM_ENTRY_POINT(dcgmGetValuesSinceColumnar,
+                 tsapiEngineGetValuesSinceColumnar,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmGpuGrp_t groupId,
+                  dcgmFieldGrp_t fieldGroupId,
+                  long long sinceTimestamp,
+                  long long untilTimestamp,
+                  long long *nextSinceTimestamp,
+                  dcgmColumnarValues_t *values),
+                 "({} {} {} {} {} {} {})",
+                 pDcgmHandle,
+                 groupId,
+                 fieldGroupId,
+                 sinceTimestamp,
+                 untilTimestamp,
+                 nextSinceTimestamp,
+                 values)
+
 DCGM_ENTRY_POINT(dcgmGetLatestValues,
                  tsapiEngineGetLatestValues,
                  (dcgmHandle_t pDcgmHandle,
@@ -534,6 +560,24 @@ DCGM_ENTRY_POINT(dcgmGetLatestValues_v2,
                  enumCB,
                  userData)
 
+DCGM_ENTRY_POINT(dcgmGetLatestValueChanges,
+                 tsapiEngineGetLatestValueChanges,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmGpuGrp_t groupId,
+                  dcgmFieldGrp_t fieldGroupId,
+                  unsigned int resyncInterval,
+                  int *isResync,
+                  dcgmFieldValueEntityEnumeration_f enumCB,
+                  void *userData),
+                 "({} {} {} {} {} {} {})",
+                 pDcgmHandle,
+                 groupId,
+                 fieldGroupId,
+                 resyncInterval,
+                 isResync,
+                 enumCB,
+                 userData)
+
 DCGM_ENTRY_POINT(dcgmEntitiesGetLatestValues,
                  tsapiEntitiesGetLatestValues,
                  (dcgmHandle_t pDcgmHandle,
@@ -552,6 +596,26 @@ DCGM_ENTRY_POINT(dcgmEntitiesGetLatestValues,
                  flags,
                  values)
 
+DCGM_ENTRY_POINT(dcgmEntitiesGetCycleValues,
+                 tsapiEntitiesGetCycleValues,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmGroupEntityPair_t entities[],
+                  unsigned int entityCount,
+                  unsigned short fields[],
+                  unsigned int fieldCount,
+                  long long *cycleId,
+                  unsigned int timeoutMs,
+                  dcgmFieldValue_v2 values[]),
+                 "({} {} {} {} {} {} {} {})",
+                 pDcgmHandle,
+                 entities,
+                 entityCount,
+                 fields,
+                 fieldCount,
+                 cycleId,
+                 timeoutMs,
+                 values)
+
 DCGM_ENTRY_POINT(dcgmWatchFields,
                  tsapiWatchFields,
                  (dcgmHandle_t pDcgmHandle,
@@ -804,6 +868,48 @@ DCGM_ENTRY_POINT(dcgmIntrospectGetHostengineCpuUtilization,
                  cpuUtil,
                  waitIfNoData)
 
+DCGM_ENTRY_POINT(dcgmIntrospectGetHostengineQueueWait,
+                 tsapiIntrospectGetHostengineQueueWait,
+                 (dcgmHandle_t pDcgmHandle, dcgmIntrospectQueueWait_t *queueWait),
+                 "({} {})",
+                 pDcgmHandle,
+                 queueWait)
+
+DCGM_ENTRY_POINT(dcgmIntrospectGetForcedUpdates,
+                 tsapiIntrospectGetForcedUpdates,
+                 (dcgmHandle_t pDcgmHandle, dcgmIntrospectForcedUpdates_t *forcedUpdates),
+                 "({} {})",
+                 pDcgmHandle,
+                 forcedUpdates)
+
+DCGM_ENTRY_POINT(dcgmIntrospectGetCacheMemory,
+                 tsapiIntrospectGetCacheMemory,
+                 (dcgmHandle_t pDcgmHandle, dcgmIntrospectCacheMemory_t *cacheMemory),
+                 "({} {})",
+                 pDcgmHandle,
+                 cacheMemory)
+
+DCGM_ENTRY_POINT(dcgmIntrospectSetCacheMemoryBudget,
+                 tsapiIntrospectSetCacheMemoryBudget,
+                 (dcgmHandle_t pDcgmHandle, long long budgetBytes),
+                 "({} {})",
+                 pDcgmHandle,
+                 budgetBytes)
+
+DCGM_ENTRY_POINT(dcgmFederationGetNodes,
+                 tsapiFederationGetNodes,
+                 (dcgmHandle_t pDcgmHandle, dcgmFederationNodes_t *nodes),
+                 "({} {})",
+                 pDcgmHandle,
+                 nodes)
+
+DCGM_ENTRY_POINT(dcgmFederationGetLatestValues,
+                 tsapiFederationGetLatestValues,
+                 (dcgmHandle_t pDcgmHandle, dcgmFederationValues_t *values),
+                 "({} {})",
+                 pDcgmHandle,
+                 values)
+
 DCGM_ENTRY_POINT(dcgmIntrospectGetFieldsMemoryUsage,
                  tsapiIntrospectGetFieldsMemoryUsage,
                  (dcgmHandle_t pDcgmHandle,
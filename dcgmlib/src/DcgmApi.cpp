@@ -85,8 +85,10 @@ extern "C" {
 }
 #pragma GCC diagnostic pop
 
+#include "DcgmClientCache.h"
 #include "DcgmClientHandler.h"
 #include "DcgmHostEngineHandler.h"
+#include <functional>
 #include <mutex>
 
 /* Define these outside of C linkage since they use C++ features */
@@ -115,6 +117,8 @@ static std::mutex g_dcgmGlobalsMutex;     /* Lock to control access to g_dcgmGlo
                                          can be memset to 0 in dcgmShutdown() */
 static dcgm_globals_t g_dcgmGlobals = {}; /* Declared static so we don't export it */
 
+static DcgmClientCache g_dcgmClientCache; /* Opt-in read-through cache of read-only requests. This has its own lock */
+
 /*****************************************************************************
  * Functions used for locking/unlocking the globals of DCGM within a process
  ******************************************************************************/
@@ -215,6 +219,18 @@ static void dcgmapiReleaseClientHandler()
     dcgmGlobalsUnlock();
 }
 
+/*****************************************************************************/
+/* Stop the embedded hostengine from mirroring downstream hostengines. This must be called
+   without the globals lock since the federation threads acquire it through the client API */
+static void dcgmapiStopFederation()
+{
+    DcgmHostEngineHandler *heHandler = DcgmHostEngineHandler::Instance();
+    if (heHandler != nullptr)
+    {
+        heHandler->StopFederation();
+    }
+}
+
 /*****************************************************************************/
 /* free the client handler that was allocated with dcgmapiAcquireClientHandler */
 static void dcgmapiFreeClientHandler()
@@ -346,6 +362,112 @@ dcgmReturn_t processModuleCommandAtHostEngine(dcgmHandle_t pDcgmHandle,
     }
 }
 
+/*****************************************************************************
+ * Get the current client cache generations of a handle, subscribing a remote
+ * handle to invalidations the first time.
+ *
+ * Returns the generations if responses for this handle can be cached
+ *         nullopt if the cache is off or the hostengine doesn't support it
+ *****************************************************************************/
+static std::optional<DcgmClientCache::Generations> helperClientCacheGetGenerations(dcgmHandle_t dcgmHandle)
+{
+    if (!DcgmClientCache::IsEnabled())
+    {
+        return std::nullopt;
+    }
+
+    if (dcgmHandle == (dcgmHandle_t)DCGM_EMBEDDED_HANDLE)
+    {
+        DcgmHostEngineHandler *pHEHandlerInstance = DcgmHostEngineHandler::Instance();
+        if (pHEHandlerInstance == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        DcgmClientCache::Generations generations;
+        pHEHandlerInstance->GetClientCacheGenerations(generations.config, generations.values);
+        return generations;
+    }
+
+    std::optional<DcgmClientCache::Generations> generations = g_dcgmClientCache.GetGenerations(dcgmHandle);
+    if (generations.has_value() || !g_dcgmClientCache.BeginSubscribe(dcgmHandle))
+    {
+        return generations;
+    }
+
+    dcgm_core_msg_client_cache_subscribe_t msg {};
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_CLIENT_CACHE_SUBSCRIBE;
+    msg.header.version    = dcgm_core_msg_client_cache_subscribe_version;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn = dcgmModuleSendBlockingFixedRequest(
+        dcgmHandle, &msg.header, sizeof(msg), std::make_unique<DcgmClientCacheRequest>(g_dcgmClientCache, dcgmHandle));
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        /* Older hostengines return DCGM_ST_FUNCTION_NOT_FOUND. Don't try again on this handle */
+        log_debug("Not caching requests for handle {}. Subscribing returned {}", (void *)dcgmHandle, (int)dcgmReturn);
+    }
+
+    g_dcgmClientCache.EndSubscribe(
+        dcgmHandle, dcgmReturn == DCGM_ST_OK, { msg.configGeneration, msg.valuesGeneration });
+    return g_dcgmClientCache.GetGenerations(dcgmHandle);
+}
+
+/*****************************************************************************
+ * Send a read-only request through the client read-through cache when it's
+ * turned on. Otherwise, this is dcgmModuleSendBlockingFixedRequest().
+ *
+ * cacheKey     IN: Parameters of the request that the response depends on. The
+ *                  module and subcommand are added to it here
+ * scope        IN: Which hostengine changes make the response stale
+ * serialize    IN: Returns the part of the response to cache, or nullopt if the
+ *                  response shouldn't be cached, like when the request failed
+ * deserialize  IN: Puts a cached response back into moduleCommand
+ *
+ *****************************************************************************/
+static dcgmReturn_t helperSendCachedRequest(dcgmHandle_t dcgmHandle,
+                                           dcgm_module_command_header_t *moduleCommand,
+                                           size_t maxResponseSize,
+                                           std::string cacheKey,
+                                           DcgmClientCache::Scope scope,
+                                           std::function<std::optional<std::string>()> const &serialize,
+                                           std::function<void(std::string const &)> const &deserialize)
+{
+    std::optional<DcgmClientCache::Generations> generations = helperClientCacheGetGenerations(dcgmHandle);
+    if (!generations.has_value())
+    {
+        // coverity[overrun-buffer-arg]
+        return dcgmModuleSendBlockingFixedRequest(dcgmHandle, moduleCommand, maxResponseSize);
+    }
+
+    DcgmClientCache::AppendToKey(cacheKey, &moduleCommand->moduleId);
+    DcgmClientCache::AppendToKey(cacheKey, &moduleCommand->subCommand);
+
+    std::string response;
+    if (g_dcgmClientCache.Lookup(dcgmHandle, cacheKey, scope, *generations, response))
+    {
+        deserialize(response);
+        return DCGM_ST_OK;
+    }
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, moduleCommand, maxResponseSize);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
+
+    std::optional<std::string> toCache = serialize();
+    if (toCache.has_value())
+    {
+        g_dcgmClientCache.Store(dcgmHandle, cacheKey, scope, *generations, std::move(*toCache));
+    }
+
+    return DCGM_ST_OK;
+}
+
 /*****************************************************************************/
 static dcgmReturn_t tsapiEngineGroupCreate(dcgmHandle_t pDcgmHandle,
                                            dcgmGroupType_t type,
@@ -576,8 +698,26 @@ dcgmReturn_t helperGroupGetInfo(dcgmHandle_t pDcgmHandle,
 
     msg.gi.groupId = groupId;
 
-    // coverity[overrun-buffer-arg]
-    ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg.header, sizeof(msg));
+    /* Callers that ask for the timestamp use it as the end of a since-query, so it has to be fresh */
+    std::string cacheKey;
+    DcgmClientCache::AppendToKey(cacheKey, &groupId);
+    DcgmClientCache::Scope scope
+        = hostEngineTimestamp != nullptr ? DcgmClientCache::Scope::Values : DcgmClientCache::Scope::Config;
+
+    ret = helperSendCachedRequest(
+        pDcgmHandle,
+        &msg.header,
+        sizeof(msg),
+        std::move(cacheKey),
+        scope,
+        [&msg]() -> std::optional<std::string> {
+            if (msg.gi.cmdRet != DCGM_ST_OK)
+            {
+                return std::nullopt;
+            }
+            return std::string(reinterpret_cast<char const *>(&msg.gi), sizeof(msg.gi));
+        },
+        [&msg](std::string const &response) { memcpy(&msg.gi, response.data(), sizeof(msg.gi)); });
 
     if (DCGM_ST_OK != ret)
     {
@@ -614,6 +754,106 @@ dcgmReturn_t helperGroupGetInfo(dcgmHandle_t pDcgmHandle,
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+static dcgmReturn_t helperGroupGetEntitiesPage(dcgmHandle_t pDcgmHandle,
+                                               dcgmGpuGrp_t groupId,
+                                               dcgmGroupEntities_t *entities,
+                                               long long *hostEngineTimestamp)
+{
+    if (!entities)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (entities->version != dcgmGroupEntities_version1)
+    {
+        DCGM_LOG_ERROR << "Struct version mismatch";
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    std::unique_ptr<dcgm_core_msg_group_get_entities_t> msg = std::make_unique<dcgm_core_msg_group_get_entities_t>();
+    memset(msg.get(), 0, sizeof(*msg));
+
+    msg->header.length     = sizeof(*msg);
+    msg->header.moduleId   = DcgmModuleIdCore;
+    msg->header.subCommand = DCGM_CORE_SR_GROUP_GET_ENTITIES;
+    msg->header.version    = dcgm_core_msg_group_get_entities_version;
+
+    msg->groupId             = groupId;
+    msg->entities.version    = dcgmGroupEntities_version1;
+    msg->entities.startIndex = entities->startIndex;
+
+    /* Callers that ask for the timestamp use it as the end of a since-query, so it has to be fresh */
+    std::string cacheKey;
+    DcgmClientCache::AppendToKey(cacheKey, &groupId);
+    DcgmClientCache::AppendToKey(cacheKey, &entities->startIndex);
+    DcgmClientCache::Scope scope
+        = hostEngineTimestamp != nullptr ? DcgmClientCache::Scope::Values : DcgmClientCache::Scope::Config;
+
+    dcgmReturn_t ret = helperSendCachedRequest(
+        pDcgmHandle,
+        &msg->header,
+        sizeof(*msg),
+        std::move(cacheKey),
+        scope,
+        [&msg]() -> std::optional<std::string> {
+            return std::string(reinterpret_cast<char const *>(msg.get()), sizeof(*msg));
+        },
+        [&msg](std::string const &response) { memcpy(msg.get(), response.data(), sizeof(*msg)); });
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    if (msg->entities.count > DCGM_GROUP_ENTITIES_PAGE_SIZE)
+    {
+        DCGM_LOG_ERROR << "Invalid number of entities returned from the hostengine";
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    if (hostEngineTimestamp)
+    {
+        *hostEngineTimestamp = msg->timestamp;
+    }
+
+    entities->count      = msg->entities.count;
+    entities->totalCount = msg->entities.totalCount;
+    memcpy(entities->entityList, msg->entities.entityList, entities->count * sizeof(entities->entityList[0]));
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************
+ * Get every entity of a group, however many pages that takes
+ *
+ * hostEngineTimestamp OUT: Optional. Hostengine time when the first page was read
+ *****************************************************************************/
+static dcgmReturn_t helperGroupGetEntities(dcgmHandle_t pDcgmHandle,
+                                           dcgmGpuGrp_t groupId,
+                                           std::vector<dcgmGroupEntityPair_t> &entities,
+                                           long long *hostEngineTimestamp)
+{
+    std::unique_ptr<dcgmGroupEntities_t> page = std::make_unique<dcgmGroupEntities_t>();
+    page->version                             = dcgmGroupEntities_version1;
+    page->startIndex                          = 0;
+
+    entities.clear();
+
+    do
+    {
+        dcgmReturn_t ret = helperGroupGetEntitiesPage(
+            pDcgmHandle, groupId, page.get(), page->startIndex == 0 ? hostEngineTimestamp : nullptr);
+        if (ret != DCGM_ST_OK)
+        {
+            return ret;
+        }
+
+        entities.insert(entities.end(), &page->entityList[0], &page->entityList[page->count]);
+        page->startIndex += page->count;
+    } while (page->count > 0 && page->startIndex < page->totalCount);
+
+    return DCGM_ST_OK;
+}
+
 /*****************************************************************************
  * This method is a common helper to get value for multiple fields
  *
@@ -687,11 +927,43 @@ dcgmReturn_t helperGetLatestValuesForFields(dcgmHandle_t dcgmHandle,
         msg->ev.fieldGroupId = fieldGroupId;
     }
 
-    // coverity[overrun-buffer-arg]
-    ret = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg->header, sizeof(*msg));
+    if (!DcgmClientCache::CanCacheLatestValues(flags))
+    {
+        ret = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg->header, sizeof(*msg));
+    }
+    else
+    {
+        std::string cacheKey;
+        DcgmClientCache::AppendToKey(cacheKey, &flags);
+        DcgmClientCache::AppendToKey(cacheKey, &msg->ev.groupId);
+        DcgmClientCache::AppendToKey(cacheKey, &msg->ev.entitiesCount);
+        DcgmClientCache::AppendToKey(cacheKey, msg->ev.entities, msg->ev.entitiesCount);
+        DcgmClientCache::AppendToKey(cacheKey, &msg->ev.fieldGroupId);
+        DcgmClientCache::AppendToKey(cacheKey, &msg->ev.fieldIdCount);
+        DcgmClientCache::AppendToKey(cacheKey, msg->ev.fieldIdList, msg->ev.fieldIdCount);
+
+        ret = helperSendCachedRequest(
+            dcgmHandle,
+            &msg->header,
+            sizeof(*msg),
+            std::move(cacheKey),
+            DcgmClientCache::Scope::Values,
+            [&msg]() -> std::optional<std::string> {
+                if (msg->ev.cmdRet != DCGM_ST_OK || msg->ev.bufferSize > sizeof(msg->ev.buffer))
+                {
+                    return std::nullopt;
+                }
+                return std::string(msg->ev.buffer, msg->ev.bufferSize);
+            },
+            [&msg](std::string const &response) {
+                memcpy(msg->ev.buffer, response.data(), response.size());
+                msg->ev.bufferSize = response.size();
+                msg->ev.cmdRet     = DCGM_ST_OK;
+            });
+    }
     if (DCGM_ST_OK != ret)
     {
-        DCGM_LOG_ERROR << "dcgmModuleSendBlockingFixedRequest returned " << ret;
+        DCGM_LOG_ERROR << "Request returned " << ret;
         return ret;
     }
 
@@ -756,6 +1028,86 @@ dcgmReturn_t tsapiEntitiesGetLatestValues(dcgmHandle_t dcgmHandle,
     return DCGM_ST_OK;
 }
 
+/****************************************************************************/
+dcgmReturn_t tsapiEntitiesGetCycleValues(dcgmHandle_t dcgmHandle,
+                                         dcgmGroupEntityPair_t entities[],
+                                         unsigned int entityCount,
+                                         unsigned short fields[],
+                                         unsigned int fieldCount,
+                                         long long *cycleId,
+                                         unsigned int timeoutMs,
+                                         dcgmFieldValue_v2 values[])
+{
+    if (!entities || entityCount < 1 || entityCount > DCGM_GROUP_MAX_ENTITIES || !fields || fieldCount < 1
+        || fieldCount > DCGM_MAX_FIELD_IDS_PER_FIELD_GROUP || !cycleId || *cycleId < 0
+        || timeoutMs > DCGM_MAX_CYCLE_WAIT_MS || !values)
+    {
+        DCGM_LOG_ERROR << "Bad parameter";
+        return DCGM_ST_BADPARAM;
+    }
+
+    // Don't put a 4 MB object on the stack
+    std::unique_ptr<dcgm_core_msg_entities_get_cycle_values_t> msg
+        = std::make_unique<dcgm_core_msg_entities_get_cycle_values_t>();
+
+    msg->header.length
+        = sizeof(*msg) - SAMPLES_BUFFER_SIZE_V2; /* avoid transferring the large buffer when making request */
+    msg->header.moduleId   = DcgmModuleIdCore;
+    msg->header.subCommand = DCGM_CORE_SR_ENTITIES_GET_CYCLE_VALUES;
+    msg->header.version    = dcgm_core_msg_entities_get_cycle_values_version;
+
+    memmove(&msg->cv.entities[0], entities, entityCount * sizeof(entities[0]));
+    msg->cv.entitiesCount = entityCount;
+    memmove(&msg->cv.fieldIdList[0], fields, fieldCount * sizeof(fields[0]));
+    msg->cv.fieldIdCount = fieldCount;
+    msg->cv.cycleId      = *cycleId;
+    msg->cv.timeoutMs    = timeoutMs;
+
+    /* The host engine may hold the request for up to timeoutMs before it answers */
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn
+        = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg->header, sizeof(*msg), nullptr, 60000 + timeoutMs);
+    if (DCGM_ST_OK != dcgmReturn)
+    {
+        DCGM_LOG_ERROR << "dcgmModuleSendBlockingFixedRequest returned " << dcgmReturn;
+        return dcgmReturn;
+    }
+
+    if (DCGM_ST_OK != msg->cv.cmdRet)
+    {
+        DCGM_LOG_DEBUG << "Got message status " << msg->cv.cmdRet;
+        return (dcgmReturn_t)msg->cv.cmdRet;
+    }
+
+    DcgmFvBuffer fvBuffer(0);
+    fvBuffer.SetFromBuffer(msg->cv.buffer, msg->cv.bufferSize);
+
+    size_t bufferSize = 0, elementCount = 0;
+    dcgmReturn = fvBuffer.GetSize(&bufferSize, &elementCount);
+    if (dcgmReturn != DCGM_ST_OK)
+        return dcgmReturn;
+
+    /* Check that we got as many fields back as we requested */
+    if (elementCount != fieldCount * entityCount)
+    {
+        DCGM_LOG_ERROR << "Returned FV mismatch. Requested " << entityCount * fieldCount << " != returned "
+                       << elementCount;
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    /* Convert the buffered FVs to our output array */
+    dcgmBufferedFvCursor_t cursor = 0;
+    unsigned int valuesIndex      = 0;
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        fvBuffer.ConvertBufferedFvToFv2(fv, &values[valuesIndex]);
+        valuesIndex++;
+    }
+
+    *cycleId = msg->cv.cycleId;
+    return DCGM_ST_OK;
+}
+
 /*****************************************************************************
  * Common helper method for standalone and embedded case to fetch DCGM GPU Ids from
  * the system
@@ -1921,7 +2273,7 @@ dcgmReturn_t helperInjectFieldValue(dcgmHandle_t pDcgmHandle,
 }
 
 /*****************************************************************************/
-dcgmReturn_t tsapiEngineGetCacheManagerFieldInfo(dcgmHandle_t pDcgmHandle, dcgmCacheManagerFieldInfo_v4_t *fieldInfo)
+dcgmReturn_t tsapiEngineGetCacheManagerFieldInfo(dcgmHandle_t pDcgmHandle, dcgmCacheManagerFieldInfo_v5_t *fieldInfo)
 {
     if (!fieldInfo)
     {
@@ -1933,10 +2285,10 @@ dcgmReturn_t tsapiEngineGetCacheManagerFieldInfo(dcgmHandle_t pDcgmHandle, dcgmC
     msg.header.length     = sizeof(msg);
     msg.header.moduleId   = DcgmModuleIdCore;
     msg.header.subCommand = DCGM_CORE_SR_GET_CACHE_MANAGER_FIELD_INFO;
-    msg.header.version    = dcgm_core_msg_get_cache_manager_field_info_version2;
+    msg.header.version    = dcgm_core_msg_get_cache_manager_field_info_version3;
 
     memcpy(&msg.fi.fieldInfo, fieldInfo, sizeof(msg.fi.fieldInfo));
-    msg.fi.fieldInfo.version = dcgmCacheManagerFieldInfo_version4;
+    msg.fi.fieldInfo.version = dcgmCacheManagerFieldInfo_version5;
     // coverity[overrun-buffer-arg]
     dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg.header, sizeof(msg));
 
@@ -1951,7 +2303,7 @@ dcgmReturn_t tsapiEngineGetCacheManagerFieldInfo(dcgmHandle_t pDcgmHandle, dcgmC
         return (dcgmReturn_t)msg.fi.cmdRet;
     }
 
-    memcpy(fieldInfo, &msg.fi.fieldInfo, sizeof(dcgmCacheManagerFieldInfo_v4_t));
+    memcpy(fieldInfo, &msg.fi.fieldInfo, sizeof(dcgmCacheManagerFieldInfo_v5_t));
 
     return (dcgmReturn_t)msg.fi.cmdRet;
 }
@@ -2289,7 +2641,7 @@ static dcgmReturn_t helperGetFieldValuesSince(dcgmHandle_t pDcgmHandle,
                                               void *userData)
 {
     dcgmReturn_t dcgmSt, retDcgmSt;
-    dcgmGroupInfo_t groupInfo = {};
+    std::vector<dcgmGroupEntityPair_t> groupEntities;
     unsigned int i;
     int j;
     unsigned int gpuId, fieldId;
@@ -2316,29 +2668,26 @@ static dcgmReturn_t helperGetFieldValuesSince(dcgmHandle_t pDcgmHandle,
 
     *nextSinceTimestamp = sinceTimestamp;
 
-    groupInfo.version = dcgmGroupInfo_version;
-
     /* Convert groupId to list of GPUs. Note that this is an extra round trip to the server
      * in the remote case, but it keeps the code much simpler */
-    dcgmSt = helperGroupGetInfo(pDcgmHandle, groupId, &groupInfo, &endQueryTimestamp);
+    dcgmSt = helperGroupGetEntities(pDcgmHandle, groupId, groupEntities, &endQueryTimestamp);
     if (dcgmSt != DCGM_ST_OK)
     {
-        log_error("helperGroupGetInfo groupId {} returned {}", (void *)groupId, (int)dcgmSt);
+        log_error("helperGroupGetEntities groupId {} returned {}", (void *)groupId, (int)dcgmSt);
         return dcgmSt;
     }
 
-    log_debug("Got group {} with {} entities", groupInfo.groupName, groupInfo.count);
+    log_debug("Got groupId {} with {} entities", (void *)groupId, groupEntities.size());
 
     /* Pre-check the group for non-GPU/non-global entities */
-    for (i = 0; i < groupInfo.count; i++)
+    for (i = 0; i < groupEntities.size(); i++)
     {
-        if (groupInfo.entityList[i].entityGroupId != DCGM_FE_GPU
-            && groupInfo.entityList[i].entityGroupId != DCGM_FE_NONE)
+        if (groupEntities[i].entityGroupId != DCGM_FE_GPU && groupEntities[i].entityGroupId != DCGM_FE_NONE)
         {
             log_error("helperGetFieldValuesSince called on groupId {} with non-GPU eg {}, eid {}.",
                       (void *)groupId,
-                      groupInfo.entityList[i].entityGroupId,
-                      groupInfo.entityList[i].entityId);
+                      groupEntities[i].entityGroupId,
+                      groupEntities[i].entityId);
             return DCGM_ST_NOT_SUPPORTED;
         }
     }
@@ -2350,9 +2699,9 @@ static dcgmReturn_t helperGetFieldValuesSince(dcgmHandle_t pDcgmHandle,
 
     dcgmFieldValue_v1 fv1;
 
-    for (i = 0; i < groupInfo.count; i++)
+    for (i = 0; i < groupEntities.size(); i++)
     {
-        gpuId = groupInfo.entityList[i].entityId;
+        gpuId = groupEntities[i].entityId;
 
         for (j = 0; j < numFieldIds; j++)
         {
@@ -2362,14 +2711,14 @@ static dcgmReturn_t helperGetFieldValuesSince(dcgmHandle_t pDcgmHandle,
 
             retNumFieldValues = valuesAtATime;
             dcgmSt            = helperGetMultipleValuesForFieldFvBuffer(pDcgmHandle,
-                                                             DCGM_FE_GPU,
-                                                             gpuId,
-                                                             fieldId,
-                                                             &retNumFieldValues,
-                                                             sinceTimestamp,
-                                                             endQueryTimestamp,
-                                                             DCGM_ORDER_ASCENDING,
-                                                             &fvBuffer);
+                                                                        DCGM_FE_GPU,
+                                                                        gpuId,
+                                                                        fieldId,
+                                                                        &retNumFieldValues,
+                                                                        sinceTimestamp,
+                                                                        endQueryTimestamp,
+                                                                        DCGM_ORDER_ASCENDING,
+                                                                        &fvBuffer);
             if (dcgmSt == DCGM_ST_NO_DATA)
             {
                 log_debug("DCGM_ST_NO_DATA for gpuId {}, fieldId {}, sinceTs {}", gpuId, fieldId, sinceTimestamp);
@@ -2417,7 +2766,7 @@ static dcgmReturn_t helperGetValuesSince(dcgmHandle_t pDcgmHandle,
                                          void *userData)
 {
     dcgmReturn_t dcgmSt, retDcgmSt;
-    dcgmGroupInfo_t groupInfo           = {};
+    std::vector<dcgmGroupEntityPair_t> groupEntities;
     dcgmFieldGroupInfo_t fieldGroupInfo = {};
     unsigned int i;
     int j;
@@ -2456,29 +2805,27 @@ static dcgmReturn_t helperGetValuesSince(dcgmHandle_t pDcgmHandle,
 
     /* Convert groupId to list of GPUs. Note that this is an extra round trip to the server
      * in the remote case, but it keeps the code much simpler */
-    groupInfo.version = dcgmGroupInfo_version;
-    dcgmSt            = helperGroupGetInfo(pDcgmHandle, groupId, &groupInfo, &endQueryTimestamp);
+    dcgmSt = helperGroupGetEntities(pDcgmHandle, groupId, groupEntities, &endQueryTimestamp);
     if (dcgmSt != DCGM_ST_OK)
     {
-        log_error("helperGroupGetInfo groupId {} returned {}", (void *)groupId, (int)dcgmSt);
+        log_error("helperGroupGetEntities groupId {} returned {}", (void *)groupId, (int)dcgmSt);
         return dcgmSt;
     }
 
     log_debug(
-        "Got group {} with {} GPUs, endQueryTimestamp {}", groupInfo.groupName, groupInfo.count, endQueryTimestamp);
+        "Got groupId {} with {} GPUs, endQueryTimestamp {}", (void *)groupId, groupEntities.size(), endQueryTimestamp);
 
     /* Pre-check the group for non-GPU/non-global entities */
     if (!enumCBv2)
     {
-        for (i = 0; i < groupInfo.count; i++)
+        for (i = 0; i < groupEntities.size(); i++)
         {
-            if (groupInfo.entityList[i].entityGroupId != DCGM_FE_GPU
-                && groupInfo.entityList[i].entityGroupId != DCGM_FE_NONE)
+            if (groupEntities[i].entityGroupId != DCGM_FE_GPU && groupEntities[i].entityGroupId != DCGM_FE_NONE)
             {
                 log_error("helperGetValuesSince called on groupId {} with non-GPU eg {}, eid {}.",
                           (void *)groupId,
-                          groupInfo.entityList[i].entityGroupId,
-                          groupInfo.entityList[i].entityId);
+                          groupEntities[i].entityGroupId,
+                          groupEntities[i].entityId);
                 return DCGM_ST_NOT_SUPPORTED;
             }
         }
@@ -2491,7 +2838,7 @@ static dcgmReturn_t helperGetValuesSince(dcgmHandle_t pDcgmHandle,
 
     dcgmFieldValue_v1 fv1;
 
-    for (i = 0; i < groupInfo.count; i++)
+    for (i = 0; i < groupEntities.size(); i++)
     {
         for (j = 0; j < (int)fieldGroupInfo.numFieldIds; j++)
         {
@@ -2503,19 +2850,19 @@ static dcgmReturn_t helperGetValuesSince(dcgmHandle_t pDcgmHandle,
                nextSinceTimestamp we're returning to the client */
             retNumFieldValues = valuesAtATime;
             dcgmSt            = helperGetMultipleValuesForFieldFvBuffer(pDcgmHandle,
-                                                             groupInfo.entityList[i].entityGroupId,
-                                                             groupInfo.entityList[i].entityId,
-                                                             fieldId,
-                                                             &retNumFieldValues,
-                                                             sinceTimestamp,
-                                                             endQueryTimestamp,
-                                                             DCGM_ORDER_ASCENDING,
-                                                             &fvBuffer);
+                                                                        groupEntities[i].entityGroupId,
+                                                                        groupEntities[i].entityId,
+                                                                        fieldId,
+                                                                        &retNumFieldValues,
+                                                                        sinceTimestamp,
+                                                                        endQueryTimestamp,
+                                                                        DCGM_ORDER_ASCENDING,
+                                                                        &fvBuffer);
             if (dcgmSt == DCGM_ST_NO_DATA)
             {
                 log_debug("DCGM_ST_NO_DATA for eg {}, eid {}, fieldId {}, sinceTs {}",
-                          groupInfo.entityList[i].entityGroupId,
-                          groupInfo.entityList[i].entityId,
+                          groupEntities[i].entityGroupId,
+                          groupEntities[i].entityId,
                           fieldId,
                           sinceTimestamp);
                 continue;
@@ -2524,16 +2871,16 @@ static dcgmReturn_t helperGetValuesSince(dcgmHandle_t pDcgmHandle,
             {
                 log_error("Got st {} from helperGetMultipleValuesForField eg {}, eid {}, fieldId {}",
                           (int)dcgmSt,
-                          groupInfo.entityList[i].entityGroupId,
-                          groupInfo.entityList[i].entityId,
+                          groupEntities[i].entityGroupId,
+                          groupEntities[i].entityId,
                           fieldId);
                 return dcgmSt;
             }
 
             log_debug("Got {} values for eg {}, eid {}, fieldId {}",
                       retNumFieldValues,
-                      groupInfo.entityList[i].entityGroupId,
-                      groupInfo.entityList[i].entityId,
+                      groupEntities[i].entityGroupId,
+                      groupEntities[i].entityId,
                       fieldId);
 
             dcgmBufferedFvCursor_t cursor = 0;
@@ -2544,7 +2891,7 @@ static dcgmReturn_t helperGetValuesSince(dcgmHandle_t pDcgmHandle,
                 fvBuffer.ConvertBufferedFvToFv1(fv, &fv1);
                 if (enumCB)
                 {
-                    callbackSt = enumCB(groupInfo.entityList[i].entityId, &fv1, 1, userData);
+                    callbackSt = enumCB(groupEntities[i].entityId, &fv1, 1, userData);
                     if (callbackSt != 0)
                     {
                         log_debug("User requested callback exit");
@@ -2554,8 +2901,7 @@ static dcgmReturn_t helperGetValuesSince(dcgmHandle_t pDcgmHandle,
                 }
                 if (enumCBv2)
                 {
-                    callbackSt = enumCBv2(
-                        groupInfo.entityList[i].entityGroupId, groupInfo.entityList[i].entityId, &fv1, 1, userData);
+                    callbackSt = enumCBv2(groupEntities[i].entityGroupId, groupEntities[i].entityId, &fv1, 1, userData);
                     if (callbackSt != 0)
                     {
                         log_debug("User requested callback exit");
@@ -2574,6 +2920,204 @@ static dcgmReturn_t helperGetValuesSince(dcgmHandle_t pDcgmHandle,
     return retDcgmSt;
 }
 
+/*****************************************************************************/
+/* Append one buffered field value to the caller's columns. With a NULL string pool, string
+ * and binary values get their pool offset and length, but nothing is copied.
+ *
+ * Returns true if the value was stored
+ *         false if the columns or the string pool are full. Nothing is stored after
+ *         that so the stored values are always a complete prefix of the results */
+static bool helperAppendColumnarValue(dcgmBufferedFv_t *fv, dcgmColumnarValues_t *columns)
+{
+    unsigned int poolBytes = 0;
+    if (fv->fieldType == DCGM_FT_STRING || fv->fieldType == DCGM_FT_BINARY)
+    {
+        /* Compute the string/binary size by subtracting off the rest of the fv */
+        poolBytes = fv->length - (sizeof(*fv) - sizeof(fv->value));
+        if (fv->fieldType == DCGM_FT_STRING)
+        {
+            poolBytes = strnlen(fv->value.str, poolBytes) + 1;
+        }
+    }
+
+    /* Once a value has been dropped, drop everything after it too */
+    bool const droppedEarlier = columns->count != columns->totalCount;
+    bool const copyToPool     = columns->stringPool != nullptr;
+    bool const poolFits       = !copyToPool || columns->stringPoolUsed + poolBytes <= columns->stringPoolCapacity;
+
+    /* Where the value is, or would be in a pool big enough for every value */
+    unsigned int const poolOffset = columns->stringPoolNeeded;
+
+    columns->totalCount++;
+    columns->stringPoolNeeded += poolBytes;
+
+    if (droppedEarlier || columns->count >= columns->capacity || (poolBytes > 0 && !poolFits))
+    {
+        return false;
+    }
+
+    unsigned int i = columns->count;
+
+    if (columns->timestamps)
+        columns->timestamps[i] = fv->timestamp;
+    if (columns->entityGroupIds)
+        columns->entityGroupIds[i] = (dcgm_field_entity_group_t)fv->entityGroupId;
+    if (columns->entityIds)
+        columns->entityIds[i] = fv->entityId;
+    if (columns->fieldIds)
+        columns->fieldIds[i] = fv->fieldId;
+    if (columns->fieldTypes)
+        columns->fieldTypes[i] = fv->fieldType;
+    if (columns->statuses)
+        columns->statuses[i] = fv->status;
+    if (columns->int64Values)
+        columns->int64Values[i] = fv->fieldType == DCGM_FT_INT64 || fv->fieldType == DCGM_FT_TIMESTAMP
+                                      ? fv->value.i64
+                                      : DCGM_INT64_BLANK;
+    if (columns->doubleValues)
+        columns->doubleValues[i] = fv->fieldType == DCGM_FT_DOUBLE ? fv->value.dbl : DCGM_FP64_BLANK;
+    if (columns->poolOffsets)
+        columns->poolOffsets[i] = poolBytes > 0 ? poolOffset : DCGM_COLUMNAR_NO_POOL_ENTRY;
+    if (columns->poolLengths)
+        columns->poolLengths[i] = poolBytes;
+
+    if (poolBytes > 0 && copyToPool)
+    {
+        memcpy(&columns->stringPool[columns->stringPoolUsed], &fv->value, poolBytes);
+        if (fv->fieldType == DCGM_FT_STRING)
+        {
+            columns->stringPool[columns->stringPoolUsed + poolBytes - 1] = '\0';
+        }
+        columns->stringPoolUsed += poolBytes;
+    }
+
+    columns->count++;
+    return true;
+}
+
+/*****************************************************************************/
+static dcgmReturn_t helperGetValuesSinceColumnar(dcgmHandle_t pDcgmHandle,
+                                                 dcgmGpuGrp_t groupId,
+                                                 dcgmFieldGrp_t fieldGroupId,
+                                                 long long sinceTimestamp,
+                                                 long long untilTimestamp,
+                                                 long long *nextSinceTimestamp,
+                                                 dcgmColumnarValues_t *columns)
+{
+    dcgmReturn_t dcgmSt;
+    std::vector<dcgmGroupEntityPair_t> groupEntities;
+    dcgmFieldGroupInfo_t fieldGroupInfo = {};
+    int valuesAtATime
+        = SAMPLES_BUFFER_SIZE_V2 / DCGM_BUFFERED_FV1_MIN_ENTRY_SIZE; /* How many values should we fetch at a time */
+    int retNumFieldValues;
+    long long endQueryTimestamp = 0;
+    DcgmFvBuffer fvBuffer(0);
+
+    if (!nextSinceTimestamp || !columns)
+    {
+        log_error("Bad param to helperGetValuesSinceColumnar");
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (columns->version != dcgmColumnarValues_version1)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", columns->version, dcgmColumnarValues_version1);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    *nextSinceTimestamp       = sinceTimestamp;
+    columns->count            = 0;
+    columns->totalCount       = 0;
+    columns->stringPoolUsed   = 0;
+    columns->stringPoolNeeded = 0;
+
+    fieldGroupInfo.version      = dcgmFieldGroupInfo_version;
+    fieldGroupInfo.fieldGroupId = fieldGroupId;
+    dcgmSt                      = dcgmFieldGroupGetInfo(pDcgmHandle, &fieldGroupInfo);
+    if (dcgmSt != DCGM_ST_OK)
+    {
+        log_error(
+            "Got dcgmSt {} from dcgmFieldGroupGetInfo() fieldGroupId {}", (dcgmReturn_t)dcgmSt, (void *)fieldGroupId);
+        return dcgmSt;
+    }
+
+    /* Convert groupId to list of entities. Note that this is an extra round trip to the server
+     * in the remote case, but it keeps the code much simpler */
+    dcgmSt = helperGroupGetEntities(pDcgmHandle, groupId, groupEntities, &endQueryTimestamp);
+    if (dcgmSt != DCGM_ST_OK)
+    {
+        log_error("helperGroupGetEntities groupId {} returned {}", (void *)groupId, (int)dcgmSt);
+        return dcgmSt;
+    }
+
+    /* Clip the window to the caller's end time, but never past what the server has seen yet */
+    if (untilTimestamp > 0 && untilTimestamp < endQueryTimestamp)
+    {
+        endQueryTimestamp = untilTimestamp;
+    }
+
+    log_debug("Got groupId {} with {} entities, {} fields, endQueryTimestamp {}",
+              (void *)groupId,
+              groupEntities.size(),
+              fieldGroupInfo.numFieldIds,
+              endQueryTimestamp);
+
+    for (unsigned int i = 0; i < groupEntities.size(); i++)
+    {
+        for (unsigned int j = 0; j < fieldGroupInfo.numFieldIds; j++)
+        {
+            unsigned short fieldId = fieldGroupInfo.fieldIds[j];
+
+            fvBuffer.Clear();
+
+            retNumFieldValues = valuesAtATime;
+            dcgmSt            = helperGetMultipleValuesForFieldFvBuffer(pDcgmHandle,
+                                                                        groupEntities[i].entityGroupId,
+                                                                        groupEntities[i].entityId,
+                                                                        fieldId,
+                                                                        &retNumFieldValues,
+                                                                        sinceTimestamp,
+                                                                        endQueryTimestamp,
+                                                                        DCGM_ORDER_ASCENDING,
+                                                                        &fvBuffer);
+            if (dcgmSt == DCGM_ST_NO_DATA)
+            {
+                continue;
+            }
+            else if (dcgmSt != DCGM_ST_OK)
+            {
+                log_error("Got st {} from helperGetMultipleValuesForField eg {}, eid {}, fieldId {}",
+                          (int)dcgmSt,
+                          groupEntities[i].entityGroupId,
+                          groupEntities[i].entityId,
+                          fieldId);
+                return dcgmSt;
+            }
+
+            dcgmBufferedFvCursor_t cursor = 0;
+
+            for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+            {
+                /* Keep going when we run out of room so the caller learns how much room it needs */
+                helperAppendColumnarValue(fv, columns);
+            }
+        }
+    }
+
+    if (columns->count < columns->totalCount)
+    {
+        log_debug("Stored {} of {} values. String pool needs {} bytes",
+                  columns->count,
+                  columns->totalCount,
+                  columns->stringPoolNeeded);
+        /* Not advancing nextSinceTimestamp so the caller can retry with larger buffers */
+        return DCGM_ST_INSUFFICIENT_SIZE;
+    }
+
+    *nextSinceTimestamp = endQueryTimestamp + 1;
+    return DCGM_ST_OK;
+}
+
 /*****************************************************************************/
 static dcgmReturn_t helperGetLatestValues(dcgmHandle_t pDcgmHandle,
                                           dcgmGpuGrp_t groupId,
@@ -2795,8 +3339,24 @@ dcgmReturn_t tsapiFieldGroupGetInfo(dcgmHandle_t pDcgmHandle, dcgmFieldGroupInfo
 
     memcpy(&msg.info.fg, fieldGroupInfo, sizeof(msg.info.fg));
 
-    // coverity[overrun-buffer-arg]
-    dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg.header, sizeof(msg));
+    std::string cacheKey;
+    DcgmClientCache::AppendToKey(cacheKey, &fieldGroupInfo->version);
+    DcgmClientCache::AppendToKey(cacheKey, &fieldGroupInfo->fieldGroupId);
+
+    dcgmReturn_t ret = helperSendCachedRequest(
+        pDcgmHandle,
+        &msg.header,
+        sizeof(msg),
+        std::move(cacheKey),
+        DcgmClientCache::Scope::Config,
+        [&msg]() -> std::optional<std::string> {
+            if (msg.info.cmdRet != DCGM_ST_OK)
+            {
+                return std::nullopt;
+            }
+            return std::string(reinterpret_cast<char const *>(&msg.info), sizeof(msg.info));
+        },
+        [&msg](std::string const &response) { memcpy(&msg.info, response.data(), sizeof(msg.info)); });
 
     DCGM_LOG_DEBUG << "tsapiFieldGroupGetInfo got ret " << ret;
 
@@ -3263,6 +3823,13 @@ static dcgmReturn_t tsapiEngineGroupGetInfo(dcgmHandle_t pDcgmHandle,
     return helperGroupGetInfo(pDcgmHandle, groupId, pDcgmGroupInfo, nullptr);
 }
 
+static dcgmReturn_t tsapiEngineGroupGetEntities(dcgmHandle_t pDcgmHandle,
+                                                dcgmGpuGrp_t groupId,
+                                                dcgmGroupEntities_t *entities)
+{
+    return helperGroupGetEntitiesPage(pDcgmHandle, groupId, entities, nullptr);
+}
+
 static dcgmReturn_t tsapiStatusCreate(dcgmStatus_t *pDcgmStatusList)
 {
     if ((dcgmStatus_t) nullptr == pDcgmStatusList)
@@ -3339,16 +3906,13 @@ static dcgmReturn_t tsapiEngineGetAllSupportedDevices(dcgmHandle_t pDcgmHandle,
     return cmHelperGetAllDevices(pDcgmHandle, gpuIdList, count, 1);
 }
 
-dcgmReturn_t tsapiGetEntityGroupEntities(dcgmHandle_t dcgmHandle,
-                                         dcgm_field_entity_group_t entityGroup,
-                                         dcgm_field_eid_t *entities,
-                                         int *numEntities,
-                                         unsigned int flags)
+/* Get the entities of an entity group from hostengines that predate DCGM_CORE_SR_GET_ENTITY_GROUP_ENTITIES_V2 */
+static dcgmReturn_t helperGetEntityGroupEntitiesV1(dcgmHandle_t dcgmHandle,
+                                                   dcgm_field_entity_group_t entityGroup,
+                                                   dcgm_field_eid_t *entities,
+                                                   int *numEntities,
+                                                   unsigned int flags)
 {
-    if (!entities || !numEntities)
-    {
-        return DCGM_ST_BADPARAM;
-    }
 
     int entitiesCapacity = *numEntities;
 
@@ -3393,6 +3957,62 @@ dcgmReturn_t tsapiGetEntityGroupEntities(dcgmHandle_t dcgmHandle,
     return DCGM_ST_OK;
 }
 
+dcgmReturn_t tsapiGetEntityGroupEntities(dcgmHandle_t dcgmHandle,
+                                         dcgm_field_entity_group_t entityGroup,
+                                         dcgm_field_eid_t *entities,
+                                         int *numEntities,
+                                         unsigned int flags)
+{
+    if (!entities || !numEntities)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    int entitiesCapacity = *numEntities;
+    int numCopied        = 0;
+
+    dcgm_core_msg_get_entity_group_entities_v2 msg = {};
+
+    do
+    {
+        msg.header.length     = sizeof(msg);
+        msg.header.moduleId   = DcgmModuleIdCore;
+        msg.header.subCommand = DCGM_CORE_SR_GET_ENTITY_GROUP_ENTITIES_V2;
+        msg.header.version    = dcgm_core_msg_get_entity_group_entities_version2;
+
+        msg.entityGroup = entityGroup;
+        msg.flags       = flags;
+        msg.startIndex  = numCopied;
+
+        // coverity[overrun-buffer-arg]
+        dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+        if (ret == DCGM_ST_FUNCTION_NOT_FOUND && numCopied == 0)
+        {
+            /* Older hostengines can only list up to DCGM_GROUP_MAX_ENTITIES entities in one go */
+            return helperGetEntityGroupEntitiesV1(dcgmHandle, entityGroup, entities, numEntities, flags);
+        }
+        else if (ret != DCGM_ST_OK)
+        {
+            return ret;
+        }
+
+        *numEntities = msg.totalEntities;
+        if ((int)msg.totalEntities > entitiesCapacity)
+        {
+            return DCGM_ST_INSUFFICIENT_SIZE;
+        }
+
+        for (unsigned int i = 0; i < msg.numEntities && numCopied < entitiesCapacity; i++)
+        {
+            entities[numCopied++] = msg.entities[i];
+        }
+    } while (msg.numEntities > 0 && numCopied < (int)msg.totalEntities);
+
+    /* The entity group can shrink between pages */
+    *numEntities = numCopied;
+    return DCGM_ST_OK;
+}
+
 dcgmReturn_t tsapiGetGpuInstanceHierarchy(dcgmHandle_t dcgmHandle, dcgmMigHierarchy_v2 *hierarchy)
 {
     dcgmReturn_t ret = DCGM_ST_NOT_SUPPORTED;
@@ -3891,6 +4511,18 @@ static dcgmReturn_t tsapiEngineGetValuesSince_v2(dcgmHandle_t pDcgmHandle,
         pDcgmHandle, groupId, fieldGroupId, sinceTimestamp, nextSinceTimestamp, 0, enumCB, userData);
 }
 
+static dcgmReturn_t tsapiEngineGetValuesSinceColumnar(dcgmHandle_t pDcgmHandle,
+                                                      dcgmGpuGrp_t groupId,
+                                                      dcgmFieldGrp_t fieldGroupId,
+                                                      long long sinceTimestamp,
+                                                      long long untilTimestamp,
+                                                      long long *nextSinceTimestamp,
+                                                      dcgmColumnarValues_t *values)
+{
+    return helperGetValuesSinceColumnar(
+        pDcgmHandle, groupId, fieldGroupId, sinceTimestamp, untilTimestamp, nextSinceTimestamp, values);
+}
+
 static dcgmReturn_t tsapiEngineGetLatestValues(dcgmHandle_t pDcgmHandle,
                                                dcgmGpuGrp_t groupId,
                                                dcgmFieldGrp_t fieldGroupId,
@@ -3909,6 +4541,85 @@ static dcgmReturn_t tsapiEngineGetLatestValues_v2(dcgmHandle_t pDcgmHandle,
     return helperGetLatestValues(pDcgmHandle, groupId, fieldGroupId, 0, enumCB, userData);
 }
 
+static dcgmReturn_t tsapiEngineGetLatestValueChanges(dcgmHandle_t pDcgmHandle,
+                                                     dcgmGpuGrp_t groupId,
+                                                     dcgmFieldGrp_t fieldGroupId,
+                                                     unsigned int resyncInterval,
+                                                     int *isResync,
+                                                     dcgmFieldValueEntityEnumeration_f enumCB,
+                                                     void *userData)
+{
+    if (!groupId || !fieldGroupId || !enumCB)
+    {
+        DCGM_LOG_ERROR << "Bad param";
+        return DCGM_ST_BADPARAM;
+    }
+
+    // Don't put a 4 MB object on the stack
+    std::unique_ptr<dcgm_core_msg_get_latest_value_changes_t> msg
+        = std::make_unique<dcgm_core_msg_get_latest_value_changes_t>();
+
+    msg->header.length
+        = sizeof(*msg) - SAMPLES_BUFFER_SIZE_V2; /* avoid transferring the large buffer when making request */
+    msg->header.moduleId   = DcgmModuleIdCore;
+    msg->header.subCommand = DCGM_CORE_SR_GET_LATEST_VALUE_CHANGES;
+    msg->header.version    = dcgm_core_msg_get_latest_value_changes_version;
+
+    msg->vc.groupId        = groupId;
+    msg->vc.fieldGroupId   = fieldGroupId;
+    msg->vc.resyncInterval = resyncInterval;
+
+    /* Not going through the client read-through cache. The host engine's answer depends on what it sent before */
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg->header, sizeof(*msg));
+    if (DCGM_ST_OK != dcgmReturn)
+    {
+        DCGM_LOG_ERROR << "dcgmModuleSendBlockingFixedRequest returned " << dcgmReturn;
+        return dcgmReturn;
+    }
+
+    if (DCGM_ST_OK != msg->vc.cmdRet)
+    {
+        DCGM_LOG_ERROR << "Got message status " << msg->vc.cmdRet;
+        return (dcgmReturn_t)msg->vc.cmdRet;
+    }
+
+    if (isResync != nullptr)
+    {
+        *isResync = msg->vc.isResync ? 1 : 0;
+    }
+
+    if (msg->vc.bufferSize == 0)
+    {
+        /* Nothing changed */
+        return DCGM_ST_OK;
+    }
+
+    DcgmFvBuffer fvBuffer(0);
+    dcgmReturn = fvBuffer.SetFromBuffer(msg->vc.buffer, msg->vc.bufferSize);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
+
+    dcgmFieldValue_v1 fieldValueV1; /* Converted from fv */
+    dcgmBufferedFvCursor_t cursor = 0;
+
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        fvBuffer.ConvertBufferedFvToFv1(fv, &fieldValueV1);
+
+        if (enumCB((dcgm_field_entity_group_t)fv->entityGroupId, fv->entityId, &fieldValueV1, 1, userData) != 0)
+        {
+            DCGM_LOG_DEBUG << "User requested callback exit";
+            /* Leaving status as OK. User requested the exit */
+            break;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
 static dcgmReturn_t tsapiEngineHealthSet(dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId, dcgmHealthSystems_t systems)
 {
     dcgmHealthSetParams_v2 params {};
@@ -4519,6 +5230,173 @@ static dcgmReturn_t tsapiIntrospectGetHostengineCpuUtilization(dcgmHandle_t dcgm
     return dcgmReturn;
 }
 
+static dcgmReturn_t tsapiIntrospectGetHostengineQueueWait(dcgmHandle_t dcgmHandle,
+                                                          dcgmIntrospectQueueWait_t *queueWait)
+{
+    dcgm_introspect_msg_he_queue_wait_v1 msg;
+    dcgmReturn_t dcgmReturn;
+
+    if (!queueWait)
+        return DCGM_ST_BADPARAM;
+    if (queueWait->version != dcgmIntrospectQueueWait_version1)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", queueWait->version, dcgmIntrospectQueueWait_version1);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdIntrospect;
+    msg.header.subCommand = DCGM_INTROSPECT_SR_HOSTENGINE_QUEUE_WAIT;
+    msg.header.version    = dcgm_introspect_msg_he_queue_wait_version1;
+
+    memcpy(&msg.queueWait, queueWait, sizeof(*queueWait));
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+
+    /* Copy the response back over the request */
+    memcpy(queueWait, &msg.queueWait, sizeof(*queueWait));
+    return dcgmReturn;
+}
+
+static dcgmReturn_t tsapiIntrospectGetForcedUpdates(dcgmHandle_t dcgmHandle,
+                                                    dcgmIntrospectForcedUpdates_t *forcedUpdates)
+{
+    dcgm_core_msg_get_forced_updates_t msg;
+    dcgmReturn_t dcgmReturn;
+
+    if (!forcedUpdates)
+        return DCGM_ST_BADPARAM;
+    if (forcedUpdates->version != dcgmIntrospectForcedUpdates_version1)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", forcedUpdates->version, dcgmIntrospectForcedUpdates_version1);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_GET_FORCED_UPDATES;
+    msg.header.version    = dcgm_core_msg_get_forced_updates_version;
+
+    memcpy(&msg.forcedUpdates, forcedUpdates, sizeof(*forcedUpdates));
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+
+    /* Copy the response back over the request */
+    memcpy(forcedUpdates, &msg.forcedUpdates, sizeof(*forcedUpdates));
+    return dcgmReturn;
+}
+
+static dcgmReturn_t tsapiIntrospectGetCacheMemory(dcgmHandle_t dcgmHandle, dcgmIntrospectCacheMemory_t *cacheMemory)
+{
+    dcgm_core_msg_get_cache_memory_t msg;
+    dcgmReturn_t dcgmReturn;
+
+    if (!cacheMemory)
+        return DCGM_ST_BADPARAM;
+    if (cacheMemory->version != dcgmIntrospectCacheMemory_version1)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", cacheMemory->version, dcgmIntrospectCacheMemory_version1);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_GET_CACHE_MEMORY;
+    msg.header.version    = dcgm_core_msg_get_cache_memory_version;
+
+    memcpy(&msg.cacheMemory, cacheMemory, sizeof(*cacheMemory));
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+
+    /* Copy the response back over the request */
+    memcpy(cacheMemory, &msg.cacheMemory, sizeof(*cacheMemory));
+    return dcgmReturn;
+}
+
+static dcgmReturn_t tsapiIntrospectSetCacheMemoryBudget(dcgmHandle_t dcgmHandle, long long budgetBytes)
+{
+    dcgm_core_msg_set_cache_memory_budget_t msg;
+
+    if (budgetBytes < 0)
+        return DCGM_ST_BADPARAM;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_SET_CACHE_MEMORY_BUDGET;
+    msg.header.version    = dcgm_core_msg_set_cache_memory_budget_version;
+    msg.budgetBytes       = budgetBytes;
+
+    // coverity[overrun-buffer-arg]
+    return dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+}
+
+static dcgmReturn_t tsapiFederationGetNodes(dcgmHandle_t dcgmHandle, dcgmFederationNodes_t *nodes)
+{
+    dcgm_core_msg_get_federation_nodes_t msg;
+    dcgmReturn_t dcgmReturn;
+
+    if (!nodes)
+        return DCGM_ST_BADPARAM;
+    if (nodes->version != dcgmFederationNodes_version1)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", nodes->version, dcgmFederationNodes_version1);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_GET_FEDERATION_NODES;
+    msg.header.version    = dcgm_core_msg_get_federation_nodes_version;
+
+    msg.nodes.version = nodes->version;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+
+    /* Copy the response back over the request */
+    memcpy(nodes, &msg.nodes, sizeof(*nodes));
+    return dcgmReturn;
+}
+
+static dcgmReturn_t tsapiFederationGetLatestValues(dcgmHandle_t dcgmHandle, dcgmFederationValues_t *values)
+{
+    dcgm_core_msg_get_federation_values_t msg;
+    dcgmReturn_t dcgmReturn;
+
+    if (!values)
+        return DCGM_ST_BADPARAM;
+    if (values->version != dcgmFederationValues_version1)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", values->version, dcgmFederationValues_version1);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_GET_FEDERATION_VALUES;
+    msg.header.version    = dcgm_core_msg_get_federation_values_version;
+
+    msg.values.version    = values->version;
+    msg.values.nodeId     = values->nodeId;
+    msg.values.startIndex = values->startIndex;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+
+    /* Copy the response back over the request */
+    memcpy(values, &msg.values, sizeof(*values));
+    return dcgmReturn;
+}
+
 static dcgmReturn_t tsapiSelectGpusByTopology(dcgmHandle_t pDcgmHandle,
                                               uint64_t inputGpuIds,
                                               uint32_t numGpus,
@@ -5193,6 +6071,8 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmStopEmbedded(dcgmHandle_t pDcgmHandle)
         return DCGM_ST_BADPARAM;
     }
 
+    dcgmapiStopFederation();
+
     dcgmGlobalsLock();
 
     /* Check again after lock */
@@ -5222,6 +6102,8 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmStopEmbedded(dcgmHandle_t pDcgmHandle)
 
     dcgmGlobalsUnlock();
 
+    g_dcgmClientCache.RemoveHandle(pDcgmHandle);
+
     return DCGM_ST_OK;
 }
 
@@ -5366,6 +6248,8 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmDisconnect(dcgmHandle_t pDcgmHandle)
 
     dcgmapiReleaseClientHandler();
 
+    g_dcgmClientCache.RemoveHandle(pDcgmHandle);
+
     log_debug("dcgmDisconnect closed connection with handle {}", (void *)pDcgmHandle);
     return DCGM_ST_OK;
 }
@@ -5421,6 +6305,9 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmShutdown()
         return DCGM_ST_OK;
     }
 
+    /* The federation uses remote connections, so it has to stop before they go away */
+    dcgmapiStopFederation();
+
     /* Clean up remote connections - must NOT have dcgmGlobalsLock() here or we will
        deadlock */
     log_debug("Before dcgmapiFreeClientHandler");
@@ -32,14 +32,17 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
+#include <limits>
 #include <list>
 #include <map>
 #include <numeric>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -93,6 +96,15 @@ static unsigned int entityKeyHashCB(const void *key)
     return retVal;
 }
 
+/* Key of a watch in m_latestValueIndex. Same bits as the key in m_entityWatchHashTable */
+static std::uint64_t WatchKeyToLatestValueKey(dcgm_entity_key_t const &watchKey)
+{
+    static_assert(sizeof(std::uint64_t) == sizeof(dcgm_entity_key_t));
+    std::uint64_t key = 0;
+    memcpy(&key, &watchKey, sizeof(key));
+    return key;
+}
+
 /* Comparison callbacks for m_entityWatchHashTable */
 static int entityKeyCmpCB(const void *key1, const void *key2)
 {
@@ -118,17 +130,32 @@ static void entityValueFreeCB(void *WatchInfo)
         watchInfo->timeSeries = 0;
     }
 
+    for (auto &view : watchInfo->views)
+    {
+        if (view.timeSeries)
+        {
+            timeseries_destroy(view.timeSeries);
+            view.timeSeries = 0;
+        }
+    }
+
     delete (watchInfo);
 }
 
 static dcgmReturn_t helperNvSwitchAddFieldWatch(dcgm_field_entity_group_t entityGroupId,
                                                 unsigned int entityId,
-                                                unsigned short dcgmFieldId,
+                                                unsigned short const *dcgmFieldIds,
+                                                unsigned int numFieldIds,
                                                 long long monitorIntervalUsec,
                                                 DcgmWatcher watcher)
 {
     dcgm_nvswitch_msg_watch_field_t msg = {};
 
+    if (numFieldIds > NVSWITCH_MSG_MAX_WATCH_FIELD_IDS)
+    {
+        return DCGM_ST_INSUFFICIENT_SIZE;
+    }
+
     msg.header.length     = sizeof(msg);
     msg.header.version    = dcgm_nvswitch_msg_watch_field_version;
     msg.header.moduleId   = DcgmModuleIdNvSwitch;
@@ -136,8 +163,8 @@ static dcgmReturn_t helperNvSwitchAddFieldWatch(dcgm_field_entity_group_t entity
 
     msg.entityGroupId      = entityGroupId;
     msg.entityId           = entityId;
-    msg.numFieldIds        = 1;
-    msg.fieldIds[0]        = dcgmFieldId;
+    msg.numFieldIds        = numFieldIds;
+    memcpy(msg.fieldIds, dcgmFieldIds, numFieldIds * sizeof(msg.fieldIds[0]));
     msg.updateIntervalUsec = monitorIntervalUsec;
     msg.watcherType        = watcher.watcherType;
     msg.connectionId       = watcher.connectionId;
@@ -938,6 +965,49 @@ DcgmCacheManager::DcgmCacheManager()
         m_forceProfMetricsThroughGpm = true;
     }
     DCGM_LOG_DEBUG << "Set m_forceProfMetricsThroughGpm to " << m_forceProfMetricsThroughGpm;
+
+    const char *minSpacingEnvStr = getenv("__DCGM_FORCED_UPDATE_MIN_SPACING_MS");
+    if (minSpacingEnvStr != nullptr)
+    {
+        int minSpacingMs = atoi(minSpacingEnvStr);
+        if (minSpacingMs >= 0)
+        {
+            m_forcedUpdateStats.minSpacingUsec = (timelib64_t)minSpacingMs * 1000;
+        }
+        else
+        {
+            DCGM_LOG_ERROR << "Ignoring invalid __DCGM_FORCED_UPDATE_MIN_SPACING_MS value \"" << minSpacingEnvStr
+                           << "\"";
+        }
+    }
+
+    const char *decimationEnvStr = getenv("__DCGM_WATCH_DECIMATION");
+    if (decimationEnvStr != nullptr)
+    {
+        std::string_view const decimation(decimationEnvStr);
+        if (decimation == "last")
+        {
+            m_defaultDecimation = DcgmcmDecimateLast;
+        }
+        else if (decimation == "first")
+        {
+            m_defaultDecimation = DcgmcmDecimateFirst;
+        }
+        else if (decimation == "mean")
+        {
+            m_defaultDecimation = DcgmcmDecimateMean;
+        }
+        else if (decimation == "max")
+        {
+            m_defaultDecimation = DcgmcmDecimateMax;
+        }
+        else
+        {
+            DCGM_LOG_ERROR << "Ignoring invalid __DCGM_WATCH_DECIMATION value \"" << decimationEnvStr << "\"";
+        }
+    }
+
+    m_cacheHugePages = DcgmCacheMemoryPool::GetHugePagesFromEnv();
 }
 
 /*****************************************************************************/
@@ -953,6 +1023,7 @@ DcgmCacheManager::~DcgmCacheManager()
 
     if (m_entityWatchHashTable)
     {
+        m_latestValueIndex.Clear();
         hashtable_destroy(m_entityWatchHashTable);
         m_entityWatchHashTable = 0;
     }
@@ -1714,19 +1785,7 @@ bool DcgmCacheManager::GetIsValidEntityId(dcgm_field_entity_group_t entityGroupI
             break;
     }
 
-    /* This is O(n^2) but only used by injecting FVs from the test framework */
-    for (size_t i = 0; i < m_numGpus; i++)
-    {
-        for (dcgmcm_vgpu_info_p vgpu = m_gpus[i].vgpuList; vgpu != nullptr; vgpu = vgpu->next)
-        {
-            if (vgpu->vgpuId == entityId)
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return m_vgpuParentGpuIds.contains(entityId);
 }
 
 /*****************************************************************************/
@@ -1867,6 +1926,8 @@ dcgmReturn_t DcgmCacheManager::Init(int pollInLockStep, double /*maxSampleAge*/)
         return ret;
     }
 
+    InitMemoryPools();
+
     /* Start the event watch before we start the event reading thread */
     ManageDeviceEvents(DCGM_GPU_ID_BAD, 0);
 
@@ -1949,7 +2010,7 @@ dcgmReturn_t DcgmCacheManager::Shutdown()
         Kill();
     }
 
-    /* Sending an empty vgpuList to free vgpuList of all GPUs*/
+    /* Sending an empty vGPU list to free the vGPU instances of all GPUs */
     vgpuInstanceCount = 0;
     for (unsigned int i = 0; i < m_numGpus; i++)
     {
@@ -1958,6 +2019,7 @@ dcgmReturn_t DcgmCacheManager::Shutdown()
 
     if (m_entityWatchHashTable)
     {
+        m_latestValueIndex.Clear();
         hashtable_destroy(m_entityWatchHashTable);
         m_entityWatchHashTable = 0;
     }
@@ -2108,6 +2170,8 @@ dcgmcm_watch_info_p DcgmCacheManager::AllocWatchInfo(dcgm_entity_key_t entityKey
     retInfo->fetchCount            = 0;
     retInfo->timeSeries            = 0;
     retInfo->pushedByModule        = false;
+    retInfo->cacheBytes            = 0;
+    retInfo->budgetEvictedSamples  = 0;
 
     // Explicitly initialize these fields to make valgrind happy
     retInfo->practicalEntityGroupId = static_cast<dcgm_field_entity_group_t>(retInfo->watchKey.entityGroupId);
@@ -2176,6 +2240,10 @@ dcgmcm_watch_info_p DcgmCacheManager::GetEntityWatchInfo(dcgm_field_entity_group
             FreeWatchInfo(retInfo);
             retInfo = 0;
         }
+        else
+        {
+            m_latestValueIndex.Insert(WatchKeyToLatestValueKey(addKey), &retInfo->latestValue);
+        }
     }
 
     if (mutexReturn == DCGM_MUTEX_ST_OK)
@@ -2394,23 +2462,82 @@ dcgmReturn_t DcgmCacheManager::Resume()
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::UpdateAllFields(int waitForUpdate)
+dcgmReturn_t DcgmCacheManager::UpdateAllFields(int waitForUpdate, bool useMinSpacing)
 {
     using namespace DcgmNs;
-    auto task = Enqueue(make_task("DoOneUpdateAllFields", [this] { return DoOneUpdateAllFields(); }));
+    long long targetCycleId = 0;
+    bool needCycle          = true;
 
-    if (!task.has_value())
     {
-        DCGM_LOG_ERROR << "Unable to enqueueDoOneUpdateAllFields";
-        return DCGM_ST_GENERIC_ERROR;
+        std::lock_guard<std::mutex> lock(m_cycleMutex);
+
+        timelib64_t now        = timelib_usecSince1970();
+        timelib64_t minSpacing = useMinSpacing ? m_forcedUpdateStats.minSpacingUsec : 0;
+
+        m_forcedUpdateStats.numRequests++;
+
+        if (minSpacing && m_cycleInProgress && now - m_currentCycleStartUsec < minSpacing)
+        {
+            /* Attach to the cycle in progress */
+            targetCycleId = m_lastCycleId + 1;
+            needCycle     = false;
+        }
+        else if (minSpacing && !m_cycleInProgress && m_lastCycleId > 0 && now - m_lastCycleStartUsec < minSpacing)
+        {
+            /* The last cycle is recent enough */
+            targetCycleId = m_lastCycleId;
+            needCycle     = false;
+        }
+        else
+        {
+            /* We need a cycle that starts after now. If one is in progress, that's the one after it */
+            targetCycleId = m_lastCycleId + (m_cycleInProgress ? 2 : 1);
+            if (m_forcedCyclePending)
+            {
+                /* The queued forced cycle hasn't started yet, so it will do */
+                needCycle = false;
+            }
+        }
+
+        if (!needCycle)
+        {
+            m_forcedUpdateStats.numCoalesced++;
+        }
+        else
+        {
+            m_forcedCyclePending = true;
+        }
+    }
+
+    if (needCycle)
+    {
+        auto task = Enqueue(make_task("DoOneUpdateAllFields",
+                                      [this, targetCycleId] { return RunForcedUpdate(targetCycleId); }));
+        if (!task.has_value())
+        {
+            DCGM_LOG_ERROR << "Unable to enqueueDoOneUpdateAllFields";
+            std::lock_guard<std::mutex> lock(m_cycleMutex);
+            m_forcedCyclePending = false;
+            return DCGM_ST_GENERIC_ERROR;
+        }
     }
-    else if (waitForUpdate)
+
+    if (waitForUpdate)
     {
         if (HasRun())
         {
-            /* Wait for the return value */
-            timelib64_t nextWakeup = (*task).get();
-            DCGM_LOG_DEBUG << "DoOneUpdateAllFields returned " << (long long)nextWakeup;
+            /* Wait for our cycle or any later one. Check for shutdown every so often since
+               a stopped update thread won't complete any more cycles */
+            std::unique_lock<std::mutex> lock(m_cycleMutex);
+            while (!m_cycleCondition.wait_for(
+                lock, std::chrono::seconds(1), [this, targetCycleId] { return m_lastCycleId >= targetCycleId; }))
+            {
+                if (ShouldStop())
+                {
+                    DCGM_LOG_DEBUG << "Stopped waiting for cycle " << targetCycleId << " on shutdown.";
+                    break;
+                }
+            }
         }
         else
         {
@@ -2421,6 +2548,234 @@ dcgmReturn_t DcgmCacheManager::UpdateAllFields(int waitForUpdate)
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+timelib64_t DcgmCacheManager::RunForcedUpdate(long long targetCycleId)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_cycleMutex);
+        if (m_lastCycleId >= targetCycleId)
+        {
+            /* A timed cycle started after we were queued and already satisfied our callers */
+            m_forcedUpdateStats.numSkipped++;
+            return 0;
+        }
+
+        m_forcedUpdateStats.numExecuted++;
+    }
+
+    return DoOneUpdateAllFields();
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::SetForcedUpdateMinSpacing(timelib64_t minSpacingUsec)
+{
+    std::lock_guard<std::mutex> lock(m_cycleMutex);
+    m_forcedUpdateStats.minSpacingUsec = std::max(minSpacingUsec, (timelib64_t)0);
+}
+
+/*****************************************************************************/
+dcgmcm_forced_update_stats_t DcgmCacheManager::GetForcedUpdateStats()
+{
+    std::lock_guard<std::mutex> lock(m_cycleMutex);
+    return m_forcedUpdateStats;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::SetCacheMemoryBudget(long long budgetBytes)
+{
+    if (budgetBytes < 0)
+    {
+        log_error("Invalid cache memory budget {}", budgetBytes);
+        return DCGM_ST_BADPARAM;
+    }
+
+    DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+
+    m_cacheMemoryStats.budgetBytes = budgetBytes;
+    log_info("Cache memory budget set to {} bytes. {} bytes are in use", budgetBytes, m_cacheMemoryStats.usedBytes);
+
+    /* Don't wait for the next update cycle to get under a smaller budget */
+    EnforceCacheMemoryBudget();
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmcm_cache_memory_stats_t DcgmCacheManager::GetCacheMemoryStats()
+{
+    DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+    return m_cacheMemoryStats;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::UpdateWatchInfoCacheBytes(dcgmcm_watch_info_p watchInfo)
+{
+    long long cacheBytes = 0;
+    if (watchInfo->timeSeries != nullptr)
+    {
+        keyedvector_p kv = watchInfo->timeSeries->keyedVector;
+        cacheBytes       = (long long)kv->Nblocks * kv->subBlockSize + watchInfo->timeSeries->ptrBytes;
+    }
+    for (auto const &view : watchInfo->views)
+    {
+        if (view.timeSeries != nullptr)
+        {
+            keyedvector_p kv = view.timeSeries->keyedVector;
+            cacheBytes += (long long)kv->Nblocks * kv->subBlockSize + view.timeSeries->ptrBytes;
+        }
+    }
+
+    m_cacheMemoryStats.usedBytes += cacheBytes - watchInfo->cacheBytes;
+    watchInfo->cacheBytes = cacheBytes;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::EnforceCacheMemoryBudget()
+{
+    long long const budgetBytes = m_cacheMemoryStats.budgetBytes;
+    if (budgetBytes <= 0 || m_cacheMemoryStats.usedBytes <= budgetBytes)
+    {
+        m_cacheOverBudgetWarned = false;
+        return;
+    }
+
+    /* Evict down to a low watermark so that we don't have to evict again on every cycle */
+    long long const targetBytes = budgetBytes - budgetBytes / 10;
+
+    struct EvictionCandidate
+    {
+        int priority; /* Lower priorities are evicted first */
+        timelib64_t oldestTimestamp;
+        dcgmcm_watch_info_p watchInfo;
+        timeseries_p timeSeries; /* watchInfo->timeSeries or the timeseries of one of its views */
+    };
+    std::vector<EvictionCandidate> candidates;
+
+    auto addCandidate = [&candidates](int priority, dcgmcm_watch_info_p watchInfo, timeseries_p timeSeries) {
+        if (timeSeries == nullptr || timeseries_size(timeSeries) < 2)
+        {
+            return; /* The newest sample is always kept */
+        }
+
+        kv_cursor_t cursor;
+        auto oldest = (timeseries_entry_p)keyedvector_first(timeSeries->keyedVector, &cursor);
+        candidates.push_back({ priority, oldest->usecSince1970, watchInfo, timeSeries });
+    };
+
+    for (void *hashIter = hashtable_iter(m_entityWatchHashTable); hashIter;
+         hashIter       = hashtable_iter_next(m_entityWatchHashTable, hashIter))
+    {
+        dcgmcm_watch_info_p watchInfo = (dcgmcm_watch_info_p)hashtable_iter_value(hashIter);
+        if (watchInfo == nullptr)
+        {
+            continue;
+        }
+
+        /* Samples nobody watches anymore go first, then samples only clients asked for, then samples
+           that our own modules depend on */
+        int priority = 0;
+        for (auto const &watcher : watchInfo->watchers)
+        {
+            priority = std::max(priority, watcher.watcher.watcherType == DcgmWatcherTypeClient ? 1 : 2);
+        }
+        addCandidate(priority, watchInfo, watchInfo->timeSeries);
+
+        /* Views only serve client watchers. Their bytes count toward the budget too */
+        for (auto const &view : watchInfo->views)
+        {
+            addCandidate(1, watchInfo, view.timeSeries);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](EvictionCandidate const &a, EvictionCandidate const &b) {
+        if (a.priority != b.priority)
+        {
+            return a.priority < b.priority;
+        }
+        return a.oldestTimestamp < b.oldestTimestamp;
+    });
+
+    long long const usedBytesBefore = m_cacheMemoryStats.usedBytes;
+    long long evictedSamples        = 0;
+
+    auto classBegin = candidates.begin();
+    while (classBegin != candidates.end() && m_cacheMemoryStats.usedBytes > targetBytes)
+    {
+        auto classEnd = std::find_if(classBegin, candidates.end(), [priority = classBegin->priority](auto const &c) {
+            return c.priority != priority;
+        });
+
+        /* Halve every watch of this priority, the ones with the oldest samples first, until we're under
+           the target or each watch is down to its newest sample. This trims the longest histories the
+           most without wiping out any single watch */
+        bool evictedAny = true;
+        while (evictedAny && m_cacheMemoryStats.usedBytes > targetBytes)
+        {
+            evictedAny = false;
+            for (auto it = classBegin; it != classEnd && m_cacheMemoryStats.usedBytes > targetBytes; ++it)
+            {
+                dcgmcm_watch_info_p watchInfo = it->watchInfo;
+                int const numSamples          = timeseries_size(it->timeSeries);
+                if (numSamples < 2)
+                {
+                    continue;
+                }
+
+                int const keepSamples = numSamples - numSamples / 2;
+                int st                = timeseries_enforce_quota(it->timeSeries, 0, keepSamples);
+                UpdateWatchInfoCacheBytes(watchInfo);
+                if (st)
+                {
+                    log_error("timeseries_enforce_quota returned {}", st);
+                    continue;
+                }
+
+                if (it->timeSeries == watchInfo->timeSeries)
+                {
+                    watchInfo->budgetEvictedSamples += numSamples - keepSamples;
+                }
+                evictedSamples += numSamples - keepSamples;
+                evictedAny = true;
+            }
+        }
+
+        classBegin = classEnd;
+    }
+
+    if (evictedSamples > 0)
+    {
+        m_cacheMemoryStats.numEvictions++;
+        m_cacheMemoryStats.evictedSamples += evictedSamples;
+        m_cacheMemoryStats.evictedBytes += usedBytesBefore - m_cacheMemoryStats.usedBytes;
+    }
+
+    if (m_cacheMemoryStats.usedBytes > budgetBytes)
+    {
+        /* This stays true on every cycle until watches go away or the budget grows. Only warn once */
+        if (!m_cacheOverBudgetWarned)
+        {
+            log_warning("Cache memory is still {} bytes after evicting {} samples. Budget {} bytes",
+                        m_cacheMemoryStats.usedBytes,
+                        evictedSamples,
+                        budgetBytes);
+            m_cacheOverBudgetWarned = true;
+        }
+        else
+        {
+            log_debug("Cache memory is still {} bytes after evicting {} samples. Budget {} bytes",
+                      m_cacheMemoryStats.usedBytes,
+                      evictedSamples,
+                      budgetBytes);
+        }
+    }
+    else
+    {
+        log_debug("Evicted {} samples to bring cache memory from {} to {} bytes",
+                  evictedSamples,
+                  usedBytesBefore,
+                  m_cacheMemoryStats.usedBytes);
+    }
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::ManageDeviceEvents(unsigned int addWatchOnGpuId, unsigned short addWatchOnFieldId)
 {
@@ -2594,7 +2949,7 @@ void DcgmCacheManager::ReadAndCacheDriverVersions(void)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::NvmlPreWatch(unsigned int gpuId, unsigned short dcgmFieldId)
+dcgmReturn_t DcgmCacheManager::NvmlPreWatch(unsigned int gpuId, unsigned short dcgmFieldId, bool *deferEvents)
 {
     nvmlReturn_t nvmlReturn;
     nvmlDevice_t nvmlDevice     = 0;
@@ -2670,6 +3025,11 @@ dcgmReturn_t DcgmCacheManager::NvmlPreWatch(unsigned int gpuId, unsigned short d
 
         case DCGM_FI_DEV_XID_ERRORS:
         case DCGM_FI_DEV_GPU_NVLINK_ERRORS:
+            if (deferEvents != nullptr)
+            {
+                *deferEvents = true;
+                break;
+            }
             ManageDeviceEvents(gpuId, dcgmFieldId);
             break;
 
@@ -2754,54 +3114,273 @@ dcgmReturn_t DcgmCacheManager::AddFieldWatch(dcgm_field_entity_group_t entityGro
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::UpdateFieldWatch(dcgmcm_watch_info_p watchInfo,
-                                                timelib64_t monitorIntervalUsec,
-                                                double maxAgeSec,
-                                                int maxKeepSamples,
-                                                DcgmWatcher watcher)
+dcgmReturn_t DcgmCacheManager::AddFieldWatches(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                               std::vector<unsigned short> const &fieldIds,
+                                               timelib64_t monitorIntervalUsec,
+                                               double maxSampleAge,
+                                               int maxKeepSamples,
+                                               DcgmWatcher watcher,
+                                               bool subscribeForUpdates,
+                                               bool updateOnFirstWatch,
+                                               bool &wereFirstWatcher)
 {
-    using DcgmNs::Timelib::FromLegacyTimestamp;
-    using DcgmNs::Timelib::ToLegacyTimestamp;
-    using DcgmNs::Utils::GetMaxAge;
-    using namespace std::chrono;
-
-    if (!watchInfo)
-        return DCGM_ST_BADPARAM;
+    std::vector<dcgm_field_meta_p> fieldMetas;
+    std::vector<dcgm_entity_key_t> watchKeys;
+    std::unordered_set<std::uint64_t> seenKeys;
+    std::map<std::pair<unsigned short, dcgm_field_eid_t>, std::vector<unsigned short>> nvSwitchFieldIds;
+    bool deferredEvents = false;
+    dcgmReturn_t dcgmReturn;
 
-    dcgm_mutex_lock(m_mutex);
+    wereFirstWatcher = false;
 
-    if (!watchInfo->isWatched)
+    /* Validate every field before anything is watched */
+    fieldMetas.reserve(fieldIds.size());
+    for (unsigned short fieldId : fieldIds)
     {
-        dcgm_mutex_unlock(m_mutex);
-        return DCGM_ST_NOT_WATCHED;
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+        if (fieldMeta == nullptr)
+        {
+            log_error("AddFieldWatches got unknown fieldId {}", fieldId);
+            return DCGM_ST_UNKNOWN_FIELD;
+        }
+        if (fieldId >= DCGM_FI_MAX_FIELDS)
+        {
+            return DCGM_ST_BADPARAM;
+        }
+        fieldMetas.push_back(fieldMeta);
     }
 
-    watchInfo->monitorIntervalUsec = monitorIntervalUsec;
+    /* Global fields are watched once no matter how many entities asked for them */
+    watchKeys.reserve(entities.size() * fieldIds.size());
+    for (auto const &entity : entities)
+    {
+        for (dcgm_field_meta_p fieldMeta : fieldMetas)
+        {
+            dcgm_entity_key_t watchKey;
+            watchKey.entityGroupId = fieldMeta->scope == DCGM_FS_GLOBAL ? DCGM_FE_NONE : entity.entityGroupId;
+            watchKey.entityId      = watchKey.entityGroupId == DCGM_FE_NONE ? 0 : entity.entityId;
+            watchKey.fieldId       = fieldMeta->fieldId;
 
-    watchInfo->maxAgeUsec = ToLegacyTimestamp(GetMaxAge(
-        FromLegacyTimestamp<milliseconds>(monitorIntervalUsec), seconds(std::uint64_t(maxAgeSec)), maxKeepSamples));
+            if (!seenKeys.insert(WatchKeyToLatestValueKey(watchKey)).second)
+            {
+                continue;
+            }
+            watchKeys.push_back(watchKey);
 
-    dcgm_mutex_unlock(m_mutex);
-    return DCGM_ST_OK;
-}
+            if (watchKey.entityGroupId == DCGM_FE_SWITCH || watchKey.entityGroupId == DCGM_FE_LINK)
+            {
+                nvSwitchFieldIds[{ watchKey.entityGroupId, watchKey.entityId }].push_back(watchKey.fieldId);
+            }
+        }
+    }
 
-/*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::RemoveFieldWatch(dcgm_field_entity_group_t entityGroupId,
-                                                unsigned int entityId,
-                                                unsigned short dcgmFieldId,
-                                                int clearCache,
-                                                DcgmWatcher watcher)
-{
-    dcgm_field_meta_p fieldMeta = 0;
+    /* Trigger the update loop to buffer updates from now on */
+    if (subscribeForUpdates)
+        m_haveAnyLiveSubscribers = true;
 
-    fieldMeta = DcgmFieldGetById(dcgmFieldId);
-    if (!fieldMeta)
-        return DCGM_ST_UNKNOWN_FIELD;
+    { /* Scoped lock */
+        DcgmLockGuard dlg(m_mutex);
 
-    if (entityGroupId != DCGM_FE_NONE)
-    {
-        return RemoveEntityFieldWatch(entityGroupId, entityId, dcgmFieldId, clearCache, watcher);
-    }
+        std::vector<dcgmcm_watch_info_p> watchInfos;
+        std::vector<dcgm_entity_key_t> preWatchedKeys;
+        watchInfos.reserve(watchKeys.size());
+
+        /* Undo the pre-watches done so far. Device events are re-registered from the watches that are left */
+        auto undoPreWatches = [this, &preWatchedKeys]() {
+            for (auto const &preWatchedKey : preWatchedKeys)
+            {
+                if (preWatchedKey.entityGroupId == DCGM_FE_NONE)
+                {
+                    NvmlPostWatch(-1, preWatchedKey.fieldId);
+                }
+                else
+                {
+                    NvmlPostWatch(GpuIdToNvmlIndex(preWatchedKey.entityId), preWatchedKey.fieldId);
+                }
+            }
+        };
+
+        /* Do the pre-watches of the watches that aren't watched yet before any watch info is created, so a
+           failure leaves nothing behind but pre-watches to undo. Device events are only re-registered once at
+           the end */
+        for (auto const &watchKey : watchKeys)
+        {
+            dcgmcm_watch_info_p watchInfo = GetEntityWatchInfo(
+                (dcgm_field_entity_group_t)watchKey.entityGroupId, watchKey.entityId, watchKey.fieldId, 0);
+            if (watchInfo != nullptr && watchInfo->isWatched)
+            {
+                continue;
+            }
+
+            if (watchKey.entityGroupId == DCGM_FE_NONE)
+            {
+                NvmlPreWatch(-1, watchKey.fieldId, &deferredEvents);
+            }
+            else if (watchKey.entityGroupId == DCGM_FE_GPU)
+            {
+                dcgmReturn = NvmlPreWatch(GpuIdToNvmlIndex(watchKey.entityId), watchKey.fieldId, &deferredEvents);
+                if (dcgmReturn != DCGM_ST_OK)
+                {
+                    log_error("NvmlPreWatch eg {}, eid {}, fieldId {} failed with {}. No watches were added.",
+                              watchKey.entityGroupId,
+                              watchKey.entityId,
+                              watchKey.fieldId,
+                              (int)dcgmReturn);
+                    undoPreWatches();
+                    return dcgmReturn;
+                }
+            }
+            else
+            {
+                continue;
+            }
+
+            preWatchedKeys.push_back(watchKey);
+        }
+
+        /* Create the watch infos that don't exist yet. This only fails if the hashtable is out of memory.
+           Watch infos created before that stay unwatched, like those of watches whose watchers are gone,
+           because their latest-value slots can't leave m_latestValueIndex */
+        for (auto const &watchKey : watchKeys)
+        {
+            dcgmcm_watch_info_p watchInfo = GetEntityWatchInfo(
+                (dcgm_field_entity_group_t)watchKey.entityGroupId, watchKey.entityId, watchKey.fieldId, 1);
+            if (watchInfo == nullptr)
+            {
+                DCGM_LOG_ERROR << "Got watchInfo == null for eg " << watchKey.entityGroupId << ", eid "
+                               << watchKey.entityId << ", fieldId " << watchKey.fieldId << ". No watches were added.";
+                undoPreWatches();
+                return DCGM_ST_GENERIC_ERROR;
+            }
+
+            if (!watchInfo->isWatched && watchKey.entityGroupId == DCGM_FE_GPU)
+            {
+                watchInfo->lastQueriedUsec = 0;
+            }
+
+            watchInfos.push_back(watchInfo);
+        }
+
+        /* Nothing can fail from here on */
+        for (dcgmcm_watch_info_p watchInfo : watchInfos)
+        {
+            dcgm_entity_key_t const &watchKey = watchInfo->watchKey;
+
+            timelib64_t watchIntervalUsec = monitorIntervalUsec;
+            if (watchKey.fieldId == DCGM_FI_DEV_INFOROM_CONFIG_CHECK
+                || watchKey.fieldId == DCGM_FI_DEV_INFOROM_CONFIG_VALID)
+            {
+                /* For inforom checks, enforce a 30-second minumum to avoid excessive CPU cycles */
+                watchIntervalUsec = std::max(watchIntervalUsec, (timelib64_t)30000000);
+            }
+
+            dcgm_watch_watcher_info_t newWatcher
+                = MakeWatcherInfo(watcher, watchIntervalUsec, maxSampleAge, maxKeepSamples, subscribeForUpdates);
+
+            bool firstWatcher;
+            if (watchKey.entityGroupId == DCGM_FE_NONE)
+            {
+                bool wasAdded = false;
+                AddOrUpdateWatcher(watchInfo, &wasAdded, &newWatcher);
+                watchInfo->isWatched = 1;
+                firstWatcher         = watchInfo->lastQueriedUsec == 0;
+            }
+            else
+            {
+                firstWatcher = AttachEntityWatcher(watchInfo, newWatcher);
+            }
+
+            wereFirstWatcher = wereFirstWatcher || firstWatcher;
+        }
+
+        if (deferredEvents)
+        {
+            ManageDeviceEvents(DCGM_GPU_ID_BAD, 0);
+        }
+    } /* End scoped lock */
+
+    /* The NvSwitch module gets one message per entity instead of one per field */
+    for (auto const &[entity, switchFieldIds] : nvSwitchFieldIds)
+    {
+        for (size_t i = 0; i < switchFieldIds.size(); i += NVSWITCH_MSG_MAX_WATCH_FIELD_IDS)
+        {
+            unsigned int numFieldIds = std::min(switchFieldIds.size() - i, (size_t)NVSWITCH_MSG_MAX_WATCH_FIELD_IDS);
+
+            dcgmReturn = helperNvSwitchAddFieldWatch((dcgm_field_entity_group_t)entity.first,
+                                                     entity.second,
+                                                     &switchFieldIds[i],
+                                                     numFieldIds,
+                                                     monitorIntervalUsec,
+                                                     watcher);
+            if (dcgmReturn != DCGM_ST_OK)
+            {
+                DCGM_LOG_ERROR << "Got status " << errorString(dcgmReturn) << "(" << dcgmReturn << ")"
+                               << " when trying to set watches";
+            }
+        }
+    }
+
+    if (wereFirstWatcher && updateOnFirstWatch)
+    {
+        UpdateAllFields(1);
+    }
+
+    DCGM_LOG_DEBUG << "AddFieldWatches added " << watchKeys.size() << " watches for " << entities.size()
+                   << " entities and " << fieldIds.size() << " fields, mfu " << (long long int)monitorIntervalUsec
+                   << ", msa " << maxSampleAge << ", mka " << maxKeepSamples << ", sfu " << subscribeForUpdates;
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::UpdateFieldWatch(dcgmcm_watch_info_p watchInfo,
+                                                timelib64_t monitorIntervalUsec,
+                                                double maxAgeSec,
+                                                int maxKeepSamples,
+                                                DcgmWatcher watcher)
+{
+    using DcgmNs::Timelib::FromLegacyTimestamp;
+    using DcgmNs::Timelib::ToLegacyTimestamp;
+    using DcgmNs::Utils::GetMaxAge;
+    using namespace std::chrono;
+
+    if (!watchInfo)
+        return DCGM_ST_BADPARAM;
+
+    dcgm_mutex_lock(m_mutex);
+
+    if (!watchInfo->isWatched)
+    {
+        dcgm_mutex_unlock(m_mutex);
+        return DCGM_ST_NOT_WATCHED;
+    }
+
+    watchInfo->monitorIntervalUsec = monitorIntervalUsec;
+
+    watchInfo->maxAgeUsec = ToLegacyTimestamp(GetMaxAge(
+        FromLegacyTimestamp<milliseconds>(monitorIntervalUsec), seconds(std::uint64_t(maxAgeSec)), maxKeepSamples));
+
+    dcgm_mutex_unlock(m_mutex);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::RemoveFieldWatch(dcgm_field_entity_group_t entityGroupId,
+                                                unsigned int entityId,
+                                                unsigned short dcgmFieldId,
+                                                int clearCache,
+                                                DcgmWatcher watcher)
+{
+    dcgm_field_meta_p fieldMeta = 0;
+
+    fieldMeta = DcgmFieldGetById(dcgmFieldId);
+    if (!fieldMeta)
+        return DCGM_ST_UNKNOWN_FIELD;
+
+    if (entityGroupId != DCGM_FE_NONE)
+    {
+        return RemoveEntityFieldWatch(entityGroupId, entityId, dcgmFieldId, clearCache, watcher);
+    }
     else
     {
         return RemoveGlobalFieldWatch(dcgmFieldId, clearCache, watcher);
@@ -2907,6 +3486,7 @@ dcgmReturn_t DcgmCacheManager::UpdateWatchFromWatchers(dcgmcm_watch_info_p watch
     if (watchInfo->watchers.empty())
     {
         watchInfo->hasSubscribedWatchers = 0;
+        UpdateWatcherViews(watchInfo, {});
         return DCGM_ST_NOT_WATCHED;
     }
 
@@ -2914,28 +3494,282 @@ dcgmReturn_t DcgmCacheManager::UpdateWatchFromWatchers(dcgmcm_watch_info_p watch
 
     /* Don't update watchInfo's value here because we don't want non-locking readers to them in a temporary state */
     timelib64_t minMonitorFreqUsec = it->monitorIntervalUsec;
-    timelib64_t minMaxAgeUsec      = it->maxAgeUsec;
     bool hasSubscribedWatchers     = it->isSubscribed;
 
     for (++it; it != watchInfo->watchers.end(); ++it)
     {
         minMonitorFreqUsec = std::min(minMonitorFreqUsec, it->monitorIntervalUsec);
-        minMaxAgeUsec      = std::min(minMaxAgeUsec, it->maxAgeUsec);
         if (it->isSubscribed)
             hasSubscribedWatchers = 1;
     }
 
+    /* Client watchers that are much slower than the watch read from their own decimated view. Only
+       the other watchers' ages decide how long the shared samples are kept */
+    dcgm_field_meta_p fieldMeta = DcgmFieldGetById(watchInfo->watchKey.fieldId);
+    bool const canDecimate      = minMonitorFreqUsec > 0 && fieldMeta != nullptr
+                             && (fieldMeta->fieldType == DCGM_FT_INT64 || fieldMeta->fieldType == DCGM_FT_DOUBLE);
+
+    std::vector<dcgm_watch_watcher_info_t const *> viewWatchers;
+    timelib64_t maxMaxAgeUsec = 0;
+
+    for (auto const &watcher : watchInfo->watchers)
+    {
+        if (canDecimate && watcher.watcher.watcherType == DcgmWatcherTypeClient
+            && watcher.monitorIntervalUsec >= DCGM_CM_VIEW_MIN_DECIMATION * minMonitorFreqUsec)
+        {
+            viewWatchers.push_back(&watcher);
+        }
+        else
+        {
+            maxMaxAgeUsec = std::max(maxMaxAgeUsec, watcher.maxAgeUsec);
+        }
+    }
+
+    UpdateWatcherViews(watchInfo, viewWatchers);
+
     watchInfo->monitorIntervalUsec   = minMonitorFreqUsec;
-    watchInfo->maxAgeUsec            = minMaxAgeUsec;
+    watchInfo->maxAgeUsec            = maxMaxAgeUsec;
     watchInfo->hasSubscribedWatchers = hasSubscribedWatchers;
 
-    log_debug("UpdateWatchFromWatchers minMonitorFreqUsec {}, minMaxAgeUsec {}, hsw {}",
+    log_debug("UpdateWatchFromWatchers minMonitorFreqUsec {}, maxMaxAgeUsec {}, views {}, hsw {}",
               (long long)minMonitorFreqUsec,
-              (long long)minMaxAgeUsec,
+              (long long)maxMaxAgeUsec,
+              watchInfo->views.size(),
               watchInfo->hasSubscribedWatchers);
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+/*
+ * Insert a finished bucket into a view, allocating the view's timeseries on its
+ * first bucket, and drop the buckets that are older than the view's max age
+ */
+static void InsertWatcherViewSample(dcgmcm_watcher_view_t &view,
+                                    int tsType,
+                                    kv_allocator_t const *allocator,
+                                    timelib64_t timestamp,
+                                    long long valueInt64,
+                                    double valueDouble,
+                                    bool isInt64)
+{
+    if (view.timeSeries == nullptr)
+    {
+        int errorSt     = 0;
+        view.timeSeries = timeseries_alloc_with_allocator(tsType, allocator, &errorSt);
+        if (view.timeSeries == nullptr)
+        {
+            log_error("timeseries_alloc(tsType={}) failed with {}", tsType, errorSt);
+            return;
+        }
+    }
+
+    if (isInt64)
+    {
+        timeseries_insert_int64_coerce(view.timeSeries, timestamp, valueInt64, 0);
+    }
+    else
+    {
+        timeseries_insert_double_coerce(view.timeSeries, timestamp, valueDouble, 0);
+    }
+
+    if (view.maxAgeUsec > 0)
+    {
+        timeseries_enforce_quota(view.timeSeries, timestamp - view.maxAgeUsec, 0);
+    }
+}
+
+/*****************************************************************************/
+/*
+ * Add one sample of the shared series to a view. tsType is the type of the
+ * view's timeseries. isInt64 says which of valueInt64 and valueDouble is the
+ * sample's value
+ */
+static void AppendToWatcherView(dcgmcm_watcher_view_t &view,
+                                int tsType,
+                                kv_allocator_t const *allocator,
+                                timelib64_t timestamp,
+                                long long valueInt64,
+                                double valueDouble,
+                                bool isInt64)
+{
+    /* Older than the open bucket. The view has already moved past it */
+    if (view.bucketEndUsec != 0 && timestamp < view.bucketEndUsec - view.intervalUsec)
+    {
+        return;
+    }
+
+    if (view.bucketEndUsec != 0 && timestamp >= view.bucketEndUsec)
+    {
+        /* This sample starts a new bucket. Close the open one. First was emitted when the bucket opened */
+        if (view.decimation != DcgmcmDecimateFirst)
+        {
+            if (view.decimation == DcgmcmDecimateLast || view.bucketCount == 0)
+            {
+                /* Last, or nothing but blanks. Pass the newest one on */
+                InsertWatcherViewSample(
+                    view, tsType, allocator, view.bucketLastUsec, view.bucketLastInt64, view.bucketLastDouble, isInt64);
+            }
+            else if (view.decimation == DcgmcmDecimateMean)
+            {
+                double const mean = view.bucketSum / view.bucketCount;
+                InsertWatcherViewSample(
+                    view, tsType, allocator, view.bucketLastUsec, std::llround(mean), mean, isInt64);
+            }
+            else
+            {
+                InsertWatcherViewSample(
+                    view, tsType, allocator, view.bucketLastUsec, view.bucketMaxInt64, view.bucketMaxDouble, isInt64);
+            }
+        }
+        view.bucketEndUsec = 0;
+    }
+
+    if (view.bucketEndUsec == 0)
+    {
+        /* Buckets are aligned to the interval so that every view of a watch at the same interval lines up */
+        view.bucketEndUsec   = (timestamp / view.intervalUsec + 1) * view.intervalUsec;
+        view.bucketCount     = 0;
+        view.bucketSum       = 0.0;
+        view.bucketMaxDouble = std::numeric_limits<double>::lowest();
+        view.bucketMaxInt64  = std::numeric_limits<long long>::min();
+
+        if (view.decimation == DcgmcmDecimateFirst)
+        {
+            InsertWatcherViewSample(view, tsType, allocator, timestamp, valueInt64, valueDouble, isInt64);
+        }
+    }
+
+    view.bucketLastUsec   = timestamp;
+    view.bucketLastInt64  = valueInt64;
+    view.bucketLastDouble = valueDouble;
+
+    bool const isBlank = isInt64 ? DCGM_INT64_IS_BLANK(valueInt64) : DCGM_FP64_IS_BLANK(valueDouble);
+    if (!isBlank)
+    {
+        view.bucketCount++;
+        view.bucketSum += isInt64 ? (double)valueInt64 : valueDouble;
+        view.bucketMaxInt64  = std::max(view.bucketMaxInt64, valueInt64);
+        view.bucketMaxDouble = std::max(view.bucketMaxDouble, valueDouble);
+    }
+}
+
+/*****************************************************************************/
+dcgmcm_watcher_view_t *DcgmCacheManager::GetWatcherView(dcgmcm_watch_info_p watchInfo, DcgmWatcher const &watcher)
+{
+    for (auto &view : watchInfo->views)
+    {
+        if (view.watcher == watcher)
+        {
+            return &view;
+        }
+    }
+    return nullptr;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::UpdateWatcherViews(dcgmcm_watch_info_p watchInfo,
+                                          std::vector<dcgm_watch_watcher_info_t const *> const &viewWatchers)
+{
+    std::vector<dcgmcm_watcher_view_t> &views = watchInfo->views;
+    if (views.empty() && viewWatchers.empty())
+    {
+        return;
+    }
+
+    /* Drop the views of watchers that are gone or whose buckets changed. A new max age is just
+       enforced from here on */
+    for (auto viewIt = views.begin(); viewIt != views.end();)
+    {
+        auto found = std::find_if(viewWatchers.begin(), viewWatchers.end(), [&](auto const *viewWatcher) {
+            return viewWatcher->watcher == viewIt->watcher;
+        });
+
+        if (found == viewWatchers.end() || (*found)->monitorIntervalUsec != viewIt->intervalUsec
+            || (*found)->decimation != viewIt->decimation)
+        {
+            if (viewIt->timeSeries)
+            {
+                timeseries_destroy(viewIt->timeSeries);
+            }
+            viewIt = views.erase(viewIt);
+        }
+        else
+        {
+            viewIt->maxAgeUsec = (*found)->maxAgeUsec;
+            ++viewIt;
+        }
+    }
+
+    DcgmCacheMemoryPool *pool       = GetSampleMemoryPool(watchInfo);
+    kv_allocator_t const *allocator = pool == nullptr ? nullptr : pool->GetKvAllocator();
+
+    for (auto const *viewWatcher : viewWatchers)
+    {
+        if (GetWatcherView(watchInfo, viewWatcher->watcher) != nullptr)
+        {
+            continue;
+        }
+
+        dcgmcm_watcher_view_t view {};
+        view.watcher      = viewWatcher->watcher;
+        view.intervalUsec = viewWatcher->monitorIntervalUsec;
+        view.maxAgeUsec   = viewWatcher->maxAgeUsec;
+        view.decimation   = viewWatcher->decimation;
+        views.push_back(view);
+
+        /* Start the view with the history that's already cached so that a new watcher of a
+           busy field doesn't start out empty */
+        timeseries_p timeSeries = watchInfo->timeSeries;
+        if (timeSeries == nullptr || (timeSeries->tsType != TS_TYPE_INT64 && timeSeries->tsType != TS_TYPE_DOUBLE))
+        {
+            continue;
+        }
+
+        bool const isInt64 = timeSeries->tsType == TS_TYPE_INT64;
+        kv_cursor_t cursor;
+        for (auto *entry = (timeseries_entry_p)keyedvector_first(timeSeries->keyedVector, &cursor); entry;
+             entry       = (timeseries_entry_p)keyedvector_next(timeSeries->keyedVector, &cursor))
+        {
+            AppendToWatcherView(views.back(),
+                                timeSeries->tsType,
+                                allocator,
+                                entry->usecSince1970,
+                                isInt64 ? entry->val.i64 : 0,
+                                isInt64 ? 0.0 : entry->val.dbl,
+                                isInt64);
+        }
+    }
+
+    UpdateWatchInfoCacheBytes(watchInfo);
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::AppendToWatcherViews(dcgmcm_watch_info_p watchInfo,
+                                            int tsType,
+                                            timelib64_t timestamp,
+                                            long long valueInt64,
+                                            double valueDouble)
+{
+    if (watchInfo->views.empty() || watchInfo->timeSeries == nullptr)
+    {
+        return;
+    }
+
+    DcgmCacheMemoryPool *pool       = GetSampleMemoryPool(watchInfo);
+    kv_allocator_t const *allocator = pool == nullptr ? nullptr : pool->GetKvAllocator();
+
+    for (auto &view : watchInfo->views)
+    {
+        AppendToWatcherView(view,
+                            watchInfo->timeSeries->tsType,
+                            allocator,
+                            timestamp,
+                            valueInt64,
+                            valueDouble,
+                            tsType == TS_TYPE_INT64);
+    }
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::AddEntityFieldWatch(dcgm_field_entity_group_t entityGroupId,
                                                    unsigned int entityId,
@@ -2950,7 +3784,6 @@ dcgmReturn_t DcgmCacheManager::AddEntityFieldWatch(dcgm_field_entity_group_t ent
 {
     dcgmcm_watch_info_p watchInfo;
     dcgmReturn_t dcgmReturn = DCGM_ST_OK;
-    bool wasAdded           = false;
     dcgm_watch_watcher_info_t newWatcher;
 
     if (dcgmFieldId >= DCGM_FI_MAX_FIELDS)
@@ -2972,22 +3805,12 @@ dcgmReturn_t DcgmCacheManager::AddEntityFieldWatch(dcgm_field_entity_group_t ent
 
     /* Populate the cache manager version of watcher so we can insert/update it in this watchInfo's
        watcher table */
-    newWatcher.watcher             = watcher;
-    newWatcher.monitorIntervalUsec = monitorIntervalUsec;
-
-    using DcgmNs::Timelib::FromLegacyTimestamp;
-    using DcgmNs::Timelib::ToLegacyTimestamp;
-    using DcgmNs::Utils::GetMaxAge;
-    using namespace std::chrono;
-
-    newWatcher.maxAgeUsec   = ToLegacyTimestamp(GetMaxAge(
-        FromLegacyTimestamp<milliseconds>(monitorIntervalUsec), seconds(std::uint64_t(maxSampleAge)), maxKeepSamples));
-    newWatcher.isSubscribed = subscribeForUpdates ? 1 : 0;
+    newWatcher = MakeWatcherInfo(watcher, monitorIntervalUsec, maxSampleAge, maxKeepSamples, subscribeForUpdates);
 
     if ((entityGroupId == DCGM_FE_SWITCH) || (entityGroupId == DCGM_FE_LINK))
     {
         dcgmReturn_t retSt
-            = helperNvSwitchAddFieldWatch(entityGroupId, entityId, dcgmFieldId, monitorIntervalUsec, watcher);
+            = helperNvSwitchAddFieldWatch(entityGroupId, entityId, &dcgmFieldId, 1, monitorIntervalUsec, watcher);
 
         if (retSt != DCGM_ST_OK)
         {
@@ -3021,37 +3844,7 @@ dcgmReturn_t DcgmCacheManager::AddEntityFieldWatch(dcgm_field_entity_group_t ent
             }
         }
 
-        /* Add or update the watcher in our table */
-        AddOrUpdateWatcher(watchInfo, &wasAdded, &newWatcher);
-
-        watchInfo->isWatched      = 1;
-        watchInfo->pushedByModule = false;
-
-        dcgm_entity_key_t entityKey;
-        entityKey.entityGroupId = entityGroupId;
-        entityKey.entityId      = entityId;
-        entityKey.fieldId       = dcgmFieldId;
-        if (EntitySupportsGpm(entityKey))
-        {
-            dcgmReturn = m_gpmManager.AddWatcher(entityKey, watcher, monitorIntervalUsec, newWatcher.maxAgeUsec);
-            if (dcgmReturn != DCGM_ST_OK)
-            {
-                DCGM_LOG_ERROR << "Unexpected return " << dcgmReturn << " from m_gpmManager->AddWatcher()";
-            }
-        }
-        else if (IsModulePushedFieldId(watchInfo->watchKey.fieldId))
-        {
-            /* If this isn't a supported GPM field and the field is a module-pushed field, mark it so */
-            DCGM_LOG_DEBUG << "Setting eg " << watchEntityGroupId << ", eid " << watchEntityId << ", fieldId "
-                           << dcgmFieldId << " as module-pushed";
-            watchInfo->pushedByModule = true;
-        }
-
-        wereFirstWatcher = false;
-        if (watchInfo->lastQueriedUsec == 0)
-        {
-            wereFirstWatcher = true;
-        }
+        wereFirstWatcher = AttachEntityWatcher(watchInfo, newWatcher);
 
     } /* End scoped lock */
 
@@ -3069,6 +3862,62 @@ dcgmReturn_t DcgmCacheManager::AddEntityFieldWatch(dcgm_field_entity_group_t ent
     return dcgmReturn;
 }
 
+/*****************************************************************************/
+dcgm_watch_watcher_info_t DcgmCacheManager::MakeWatcherInfo(DcgmWatcher const &watcher,
+                                                            timelib64_t monitorIntervalUsec,
+                                                            double maxSampleAge,
+                                                            int maxKeepSamples,
+                                                            bool subscribeForUpdates)
+{
+    using DcgmNs::Timelib::FromLegacyTimestamp;
+    using DcgmNs::Timelib::ToLegacyTimestamp;
+    using DcgmNs::Utils::GetMaxAge;
+    using namespace std::chrono;
+
+    dcgm_watch_watcher_info_t newWatcher;
+
+    newWatcher.watcher             = watcher;
+    newWatcher.monitorIntervalUsec = monitorIntervalUsec;
+    newWatcher.maxAgeUsec          = ToLegacyTimestamp(GetMaxAge(
+        FromLegacyTimestamp<milliseconds>(monitorIntervalUsec), seconds(std::uint64_t(maxSampleAge)), maxKeepSamples));
+    newWatcher.isSubscribed = subscribeForUpdates ? 1 : 0;
+    newWatcher.decimation   = m_defaultDecimation;
+
+    return newWatcher;
+}
+
+/*****************************************************************************/
+bool DcgmCacheManager::AttachEntityWatcher(dcgmcm_watch_info_p watchInfo, dcgm_watch_watcher_info_t &newWatcher)
+{
+    bool wasAdded = false;
+
+    /* Add or update the watcher in our table */
+    AddOrUpdateWatcher(watchInfo, &wasAdded, &newWatcher);
+
+    watchInfo->isWatched      = 1;
+    watchInfo->pushedByModule = false;
+
+    dcgm_entity_key_t const &entityKey = watchInfo->watchKey;
+    if (EntitySupportsGpm(entityKey))
+    {
+        dcgmReturn_t dcgmReturn = m_gpmManager.AddWatcher(
+            entityKey, newWatcher.watcher, newWatcher.monitorIntervalUsec, newWatcher.maxAgeUsec);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            DCGM_LOG_ERROR << "Unexpected return " << dcgmReturn << " from m_gpmManager->AddWatcher()";
+        }
+    }
+    else if (IsModulePushedFieldId(entityKey.fieldId))
+    {
+        /* If this isn't a supported GPM field and the field is a module-pushed field, mark it so */
+        DCGM_LOG_DEBUG << "Setting eg " << entityKey.entityGroupId << ", eid " << entityKey.entityId << ", fieldId "
+                       << entityKey.fieldId << " as module-pushed";
+        watchInfo->pushedByModule = true;
+    }
+
+    return watchInfo->lastQueriedUsec == 0;
+}
+
 /*****************************************************************************/
 bool DcgmCacheManager::EntitySupportsGpm(const dcgm_entity_key_t &entityKey)
 {
@@ -3210,6 +4059,7 @@ dcgmReturn_t DcgmCacheManager::AddGlobalFieldWatch(unsigned short dcgmFieldId,
                                                             seconds(std::uint64_t(maxSampleAge)),
                                                             maxKeepSamples));
         newWatcher.isSubscribed = subscribeForUpdates;
+        newWatcher.decimation   = m_defaultDecimation;
 
         /* New watch? */
         if (!watchInfo->isWatched)
@@ -3375,6 +4225,117 @@ static dcgmReturn_t DcgmcmWriteTimeSeriesEntryToFvBuffer(dcgm_field_entity_group
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+/* Destination of the runs of samples that DcgmCacheManager::GetSamples() copies */
+typedef struct
+{
+    dcgm_field_entity_group_t entityGroupId;
+    dcgm_field_eid_t entityId;
+    unsigned short fieldId;
+    timeseries_p timeseries;
+    bool descending;         /* Runs are visited newest first. Copy each one from its end */
+    dcgmcm_sample_p samples; /* Samples to fill in. Can be null */
+    DcgmFvBuffer *fvBuffer;  /* FV buffer to append to. Can be null */
+    int Nsamples;            /* How many samples have been copied */
+    dcgmReturn_t status;     /* Why the copy was stopped */
+} dcgmcm_sample_copy_t;
+
+/*****************************************************************************/
+/*
+ * timeseries_run_f that copies a run of entries to the samples and FV buffer of
+ * a dcgmcm_sample_copy_t
+ */
+static int DcgmcmCopySampleRun(timeseries_entry_p entries, int Nentries, void *user)
+{
+    dcgmcm_sample_copy_t *copy = (dcgmcm_sample_copy_t *)user;
+    int const tsType           = copy->timeseries->tsType;
+    int const first            = copy->descending ? Nentries - 1 : 0;
+    int const step             = copy->descending ? -1 : 1;
+
+    if (tsType == TS_TYPE_INT64 || tsType == TS_TYPE_DOUBLE)
+    {
+        /* Fixed-size values. GetSamples() already reserved room for them in fvBuffer */
+        dcgmcm_sample_p samples = copy->samples ? &copy->samples[copy->Nsamples] : nullptr;
+
+        for (int i = 0, entryIndex = first; i < Nentries; i++, entryIndex += step)
+        {
+            timeseries_entry_p entry = &entries[entryIndex];
+
+            if (samples)
+            {
+                samples[i].timestamp = entry->usecSince1970;
+                if (tsType == TS_TYPE_INT64)
+                {
+                    samples[i].val.i64  = entry->val.i64;
+                    samples[i].val2.i64 = entry->val2.i64;
+                }
+                else
+                {
+                    samples[i].val.d  = entry->val.dbl;
+                    samples[i].val2.d = entry->val2.dbl;
+                }
+            }
+
+            if (copy->fvBuffer)
+            {
+                dcgmBufferedFv_t *fv;
+                if (tsType == TS_TYPE_INT64)
+                {
+                    fv = copy->fvBuffer->AddInt64Value(copy->entityGroupId,
+                                                       copy->entityId,
+                                                       copy->fieldId,
+                                                       entry->val.i64,
+                                                       entry->usecSince1970,
+                                                       DCGM_ST_OK);
+                }
+                else
+                {
+                    fv = copy->fvBuffer->AddDoubleValue(copy->entityGroupId,
+                                                        copy->entityId,
+                                                        copy->fieldId,
+                                                        entry->val.dbl,
+                                                        entry->usecSince1970,
+                                                        DCGM_ST_OK);
+                }
+                if (!fv)
+                {
+                    copy->status = DCGM_ST_MEMORY;
+                    return TS_ST_MEMORY;
+                }
+            }
+        }
+
+        copy->Nsamples += Nentries;
+        return TS_ST_OK;
+    }
+
+    for (int i = 0, entryIndex = first; i < Nentries; i++, entryIndex += step)
+    {
+        timeseries_entry_p entry = &entries[entryIndex];
+        dcgmReturn_t st          = DCGM_ST_OK;
+
+        if (copy->samples)
+        {
+            st = DcgmcmTimeSeriesEntryToSample(&copy->samples[copy->Nsamples], entry, copy->timeseries);
+        }
+        if (copy->fvBuffer)
+        {
+            st = DcgmcmWriteTimeSeriesEntryToFvBuffer(
+                copy->entityGroupId, copy->entityId, copy->fieldId, entry, copy->fvBuffer, copy->timeseries);
+        }
+
+        if (st != DCGM_ST_OK)
+        {
+            copy->status = st;
+            return TS_ST_UNKNOWN;
+        }
+
+        copy->Nsamples++;
+    }
+
+    return TS_ST_OK;
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::GetUniquePidLists(dcgm_field_entity_group_t entityGroupId,
                                                  dcgm_field_eid_t entityId,
@@ -4239,7 +5200,8 @@ dcgmReturn_t DcgmCacheManager::GetSamples(dcgm_field_entity_group_t entityGroupI
                                           timelib64_t startTime,
                                           timelib64_t endTime,
                                           dcgmOrder_t order,
-                                          DcgmFvBuffer *fvBuffer)
+                                          DcgmFvBuffer *fvBuffer,
+                                          DcgmWatcher const *watcher)
 {
     dcgm_field_meta_p fieldMeta = 0;
     dcgmReturn_t st, retSt = DCGM_ST_OK;
@@ -4301,102 +5263,55 @@ dcgmReturn_t DcgmCacheManager::GetSamples(dcgm_field_entity_group_t entityGroupI
     /* Data type is assumed to be a time series type */
 
     timeseries = watchInfo->timeSeries;
-    kv_cursor_t cursor;
-    timeseries_entry_p entry = 0;
-
-    if (order == DCGM_ORDER_ASCENDING)
+    if (watcher != nullptr)
     {
-        /* Which entry we start on depends on if a starting timestamp was provided or not */
-        if (!startTime)
+        /* A watcher that's slower than the watch reads its own decimated samples */
+        dcgmcm_watcher_view_t const *view = GetWatcherView(watchInfo, *watcher);
+        if (view != nullptr && view->timeSeries != nullptr)
         {
-            entry = (timeseries_entry_p)keyedvector_first(timeseries->keyedVector, &cursor);
-        }
-        else
-        {
-            timeseries_entry_t key;
-
-            key.usecSince1970 = startTime;
-            entry             = (timeseries_entry_p)keyedvector_find_by_key(
-                timeseries->keyedVector, &key, KV_LGE_GREATEQUAL, &cursor);
-        }
-
-        /* Walk all samples until we fill our buffer, run out of samples, or go past our end timestamp */
-        for (; entry && (*Msamples) < maxSamples;
-             entry = (timeseries_entry_p)keyedvector_next(timeseries->keyedVector, &cursor))
-        {
-            /* Past our time range? */
-            if (endTime && entry->usecSince1970 > endTime)
-                break;
-
-            /* Got an entry. Convert it to a sample */
-            st = DCGM_ST_OK;
-            if (samples)
-            {
-                st = DcgmcmTimeSeriesEntryToSample(&samples[*Msamples], entry, timeseries);
-            }
-            if (fvBuffer)
-            {
-                st = DcgmcmWriteTimeSeriesEntryToFvBuffer(
-                    entityGroupId, entityId, dcgmFieldId, entry, fvBuffer, timeseries);
-            }
-
-            if (st)
-            {
-                DCGM_LOG_ERROR << "st " << st;
-                *Msamples = 0;
-                return st;
-            }
-
-            (*Msamples)++;
+            timeseries = view->timeSeries;
         }
     }
-    else /* DCGM_ORDER_DESCENDING */
+    /* Find both ends of [startTime, endTime] by binary search and copy the runs in between */
+    timeseries_range_t range;
+    int tsSt = timeseries_find_range(timeseries, startTime, endTime, &range);
+    if (tsSt != TS_ST_OK)
     {
-        /* Which entry we start on depends on if a starting timestamp was provided or not */
-        if (!endTime)
-        {
-            entry = (timeseries_entry_p)keyedvector_last(timeseries->keyedVector, &cursor);
-        }
-        else
-        {
-            timeseries_entry_t key;
-
-            key.usecSince1970 = endTime;
-            entry
-                = (timeseries_entry_p)keyedvector_find_by_key(timeseries->keyedVector, &key, KV_LGE_LESSEQUAL, &cursor);
-        }
+        DCGM_LOG_ERROR << "Got error " << tsSt << " from timeseries_find_range";
+        return DCGM_ST_GENERIC_ERROR;
+    }
 
-        /* Walk all samples until we fill our buffer, run out of samples, or go past our end timestamp */
-        for (; entry && (*Msamples) < maxSamples;
-             entry = (timeseries_entry_p)keyedvector_prev(timeseries->keyedVector, &cursor))
+    int const Ncopy = std::min(range.Nentries, maxSamples);
+    if (fvBuffer && Ncopy > 0 && (timeseries->tsType == TS_TYPE_INT64 || timeseries->tsType == TS_TYPE_DOUBLE))
+    {
+        /* Grow the buffer once rather than every few samples */
+        st = fvBuffer->Reserve((size_t)Ncopy * DCGM_BUFFERED_FV1_MIN_ENTRY_SIZE);
+        if (st != DCGM_ST_OK)
         {
-            /* Past our time range? */
-            if (startTime && entry->usecSince1970 < startTime)
-                break;
-
-            /* Got an entry. Convert it to a sample */
-            st = DCGM_ST_OK;
-            if (samples)
-            {
-                st = DcgmcmTimeSeriesEntryToSample(&samples[*Msamples], entry, timeseries);
-            }
-            if (fvBuffer)
-            {
-                st = DcgmcmWriteTimeSeriesEntryToFvBuffer(
-                    entityGroupId, entityId, dcgmFieldId, entry, fvBuffer, timeseries);
-            }
+            return st;
+        }
+    }
 
-            if (st)
-            {
-                DCGM_LOG_ERROR << "st " << st;
-                *Msamples = 0;
-                return st;
-            }
+    dcgmcm_sample_copy_t copy {};
+    copy.entityGroupId = entityGroupId;
+    copy.entityId      = entityId;
+    copy.fieldId       = dcgmFieldId;
+    copy.timeseries    = timeseries;
+    copy.descending    = order == DCGM_ORDER_DESCENDING;
+    copy.samples       = samples;
+    copy.fvBuffer      = fvBuffer;
+    copy.status        = DCGM_ST_OK;
 
-            (*Msamples)++;
-        }
+    tsSt = timeseries_visit_range(timeseries, &range, copy.descending ? 1 : 0, Ncopy, DcgmcmCopySampleRun, &copy);
+    if (tsSt < 0)
+    {
+        st = copy.status != DCGM_ST_OK ? copy.status : DCGM_ST_GENERIC_ERROR;
+        DCGM_LOG_ERROR << "st " << st;
+        return st;
     }
 
+    *Msamples = copy.Nsamples;
+
     /* Handle case where no samples are returned because of nvml errors calling the API */
     if (!(*Msamples))
     {
@@ -4420,7 +5335,8 @@ dcgmReturn_t DcgmCacheManager::GetLatestSample(dcgm_field_entity_group_t entityG
                                                dcgm_field_eid_t entityId,
                                                unsigned short dcgmFieldId,
                                                dcgmcm_sample_p sample,
-                                               DcgmFvBuffer *fvBuffer)
+                                               DcgmFvBuffer *fvBuffer,
+                                               timelib64_t asOfTimestamp)
 {
     dcgm_field_meta_p fieldMeta = 0;
     dcgmReturn_t st, retSt = DCGM_ST_OK;
@@ -4440,14 +5356,21 @@ dcgmReturn_t DcgmCacheManager::GetLatestSample(dcgm_field_entity_group_t entityG
 
     dcgm_field_entity_group_t watchEntityGroupId = entityGroupId;
 
-    DcgmLockGuard dlg(m_mutex);
-
     if (fieldMeta->scope == DCGM_FS_GLOBAL && watchEntityGroupId != DCGM_FE_NONE)
     {
         DCGM_LOG_DEBUG << "Fixing entityGroupId for global field";
         watchEntityGroupId = DCGM_FE_NONE;
     }
 
+    /* Most reads are of the latest int64 or double value. Those don't need m_mutex */
+    if (!asOfTimestamp
+        && GetLatestSampleFromSlot(watchEntityGroupId, entityGroupId, entityId, fieldMeta->fieldId, sample, fvBuffer))
+    {
+        return DCGM_ST_OK;
+    }
+
+    DcgmLockGuard dlg(m_mutex);
+
     /* Don't need to GetIsValidEntityId(entityGroupId, entityId) here because Get*WatchInfo will
        return null if there isn't a valid watch */
 
@@ -4464,15 +5387,29 @@ dcgmReturn_t DcgmCacheManager::GetLatestSample(dcgm_field_entity_group_t entityG
         return st;
     }
 
-    /* Data type is assumed to be a time series type */
+    /* Data type is assumed to be a time series type */
+
+    timeseries = watchInfo->timeSeries;
+    kv_cursor_t cursor;
+    timeseries_entry_p entry = 0;
+    if (!asOfTimestamp)
+    {
+        entry = (timeseries_entry_p)keyedvector_last(timeseries->keyedVector, &cursor);
+    }
+    else
+    {
+        timeseries_entry_t key;
+
+        key.usecSince1970 = asOfTimestamp;
+        entry = (timeseries_entry_p)keyedvector_find_by_key(timeseries->keyedVector, &key, KV_LGE_LESSEQUAL, &cursor);
+    }
 
-    timeseries = watchInfo->timeSeries;
-    kv_cursor_t cursor;
-    timeseries_entry_p entry = (timeseries_entry_p)keyedvector_last(timeseries->keyedVector, &cursor);
     if (!entry)
     {
         /* No entries in time series. If NVML apis failed, return their error code */
-        if (watchInfo->lastStatus != NVML_SUCCESS)
+        if (keyedvector_size(timeseries->keyedVector) > 0)
+            retSt = DCGM_ST_NO_DATA; /* Only have samples newer than asOfTimestamp */
+        else if (watchInfo->lastStatus != NVML_SUCCESS)
             retSt = DcgmNs::Utils::NvmlReturnToDcgmReturn(watchInfo->lastStatus);
         else if (!watchInfo->isWatched)
             retSt = DCGM_ST_NOT_WATCHED;
@@ -4500,6 +5437,63 @@ dcgmReturn_t DcgmCacheManager::GetLatestSample(dcgm_field_entity_group_t entityG
     return retSt;
 }
 
+/*****************************************************************************/
+bool DcgmCacheManager::GetLatestSampleFromSlot(dcgm_field_entity_group_t watchEntityGroupId,
+                                               dcgm_field_entity_group_t entityGroupId,
+                                               dcgm_field_eid_t entityId,
+                                               unsigned short fieldId,
+                                               dcgmcm_sample_p sample,
+                                               DcgmFvBuffer *fvBuffer)
+{
+    dcgm_entity_key_t watchKey;
+    EntityIdToWatchKey(&watchKey, watchEntityGroupId, watchEntityGroupId == DCGM_FE_NONE ? 0 : entityId, fieldId);
+
+    DcgmLatestValueSlot const *slot = m_latestValueIndex.Find(WatchKeyToLatestValueKey(watchKey));
+    DcgmLatestValue value;
+    if (slot == nullptr || !slot->Read(value))
+    {
+        /* Not watched, no samples yet, or not a type the slot holds */
+        return false;
+    }
+
+    if (fvBuffer)
+    {
+        dcgmBufferedFv_t *fv = nullptr;
+        if (value.tsType == TS_TYPE_INT64)
+        {
+            fv = fvBuffer->AddInt64Value(entityGroupId, entityId, fieldId, value.valueInt64, value.timestamp, DCGM_ST_OK);
+        }
+        else
+        {
+            fv = fvBuffer->AddDoubleValue(
+                entityGroupId, entityId, fieldId, value.valueDouble, value.timestamp, DCGM_ST_OK);
+        }
+
+        if (fv == nullptr)
+        {
+            /* Let the locked path report it */
+            return false;
+        }
+    }
+
+    if (sample)
+    {
+        sample->timestamp = value.timestamp;
+        if (value.tsType == TS_TYPE_INT64)
+        {
+            sample->val.i64  = value.valueInt64;
+            sample->val2.i64 = value.value2Int64;
+        }
+        else
+        {
+            sample->val.d  = value.valueDouble;
+            sample->val2.d = value.value2Double;
+        }
+    }
+
+    return true;
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::GetMultipleLatestSamples(std::vector<dcgmGroupEntityPair_t> &entities,
                                                         std::vector<unsigned short> &fieldIds,
@@ -4511,9 +5505,8 @@ dcgmReturn_t DcgmCacheManager::GetMultipleLatestSamples(std::vector<dcgmGroupEnt
     if (!fvBuffer)
         return DCGM_ST_BADPARAM;
 
-    /* Lock the cache manager once for the whole request */
-    dcgm_mutex_lock(m_mutex);
-
+    /* Not locking the cache manager for the whole request. Most samples come from latest-value slots
+       without the lock, and GetLatestSample() locks for the rest */
     for (entityIt = entities.begin(); entityIt != entities.end(); ++entityIt)
     {
         for (fieldIdIt = fieldIds.begin(); fieldIdIt != fieldIds.end(); ++fieldIdIt)
@@ -4530,11 +5523,66 @@ dcgmReturn_t DcgmCacheManager::GetMultipleLatestSamples(std::vector<dcgmGroupEnt
         }
     }
 
-    dcgm_mutex_unlock(m_mutex);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::GetMultipleSamplesForCycle(std::vector<dcgmGroupEntityPair_t> &entities,
+                                                          std::vector<unsigned short> &fieldIds,
+                                                          long long &cycleId,
+                                                          unsigned int timeoutMs,
+                                                          DcgmFvBuffer *fvBuffer)
+{
+    if (!fvBuffer || cycleId < 0)
+        return DCGM_ST_BADPARAM;
+
+    /* Wait for a cycle after the one the caller has already seen. This doesn't trigger an update
+       cycle like UpdateAllFields() does. It just waits for the update thread's next one */
+    {
+        std::unique_lock<std::mutex> lock(m_cycleMutex);
+
+        long long const lastSeenCycleId = cycleId;
+        if (!m_cycleCondition.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, lastSeenCycleId] {
+                return m_lastCycleId > lastSeenCycleId;
+            }))
+        {
+            DCGM_LOG_DEBUG << "Timed out after " << timeoutMs << " ms waiting for a cycle after " << lastSeenCycleId;
+            return DCGM_ST_TIMEOUT;
+        }
+    }
+
+    /* Lock the cache manager once for the whole request. An update cycle may be in progress, but
+       can't complete while we hold the lock, so the last completed cycle can't change under us */
+    DcgmLockGuard dlg(m_mutex);
+
+    cycleId                      = m_lastCycleId;
+    timelib64_t const cycleEndTs = m_lastCycleEndUsec;
+
+    for (auto const &entity : entities)
+    {
+        for (auto const fieldId : fieldIds)
+        {
+            /* Errors are written as statuses for each fv in fvBuffer */
+            dcgmReturn_t ret = GetLatestSample(entity.entityGroupId, entity.entityId, fieldId, 0, fvBuffer, cycleEndTs);
+            if (DCGM_ST_OK != ret)
+            {
+                DCGM_LOG_DEBUG << "GetLatestSample returned " << errorString(ret) << " for entityId "
+                               << entity.entityId << " groupId " << entity.entityGroupId << " fieldId " << fieldId
+                               << " as of cycle " << cycleId;
+            }
+        }
+    }
 
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+long long DcgmCacheManager::GetLastCompletedCycleId()
+{
+    std::lock_guard<std::mutex> lock(m_cycleMutex);
+    return m_lastCycleId;
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::SetValue(int gpuId, unsigned short dcgmFieldId, dcgmcm_sample_p value)
 {
@@ -5167,6 +6215,16 @@ dcgmReturn_t DcgmCacheManager::SubscribeForEvent(const dcgmcmEventSubscription_t
             break;
         }
 
+        case DcgmcmEventTypeUpdateCycle:
+        {
+            if (eventSub.fn.cycleCb == nullptr)
+            {
+                DCGM_LOG_DEBUG << "Cannot subscribe to update cycles using a null callback function";
+                return DCGM_ST_BADPARAM;
+            }
+            break;
+        }
+
         default:
         {
             DCGM_LOG_DEBUG << "Cannot process cache manager event type " << eventSub.type;
@@ -5230,6 +6288,15 @@ dcgmReturn_t DcgmCacheManager::ActuallyUpdateAllFields(dcgmcm_update_thread_t *t
 
     ClearThreadCtx(threadCtx);
 
+    /* Forget last cycle's vGPU sessions, but keep their buffers around to be reused */
+    for (auto &[gpuId, sessions] : m_vgpuSessionsThisCycle)
+    {
+        sessions.encSessionsStatus = NVML_ERROR_UNINITIALIZED;
+        sessions.fbcSessionsStatus = NVML_ERROR_UNINITIALIZED;
+        sessions.encSessions.clear();
+        sessions.fbcSessions.clear();
+    }
+
     *earliestNextUpdate = 0;
     now                 = timelib_usecSince1970();
 
@@ -5773,6 +6840,7 @@ void DcgmCacheManager::ClearWatchInfo(dcgmcm_watch_info_p watchInfo, int clearCa
         return;
 
     watchInfo->watchers.clear();
+    UpdateWatcherViews(watchInfo, {});
     watchInfo->isWatched           = 0;
     watchInfo->pushedByModule      = false;
     watchInfo->monitorIntervalUsec = 0;
@@ -5782,6 +6850,8 @@ void DcgmCacheManager::ClearWatchInfo(dcgmcm_watch_info_p watchInfo, int clearCa
     {
         timeseries_destroy(watchInfo->timeSeries);
         watchInfo->timeSeries = 0;
+        UpdateWatchInfoCacheBytes(watchInfo);
+        PublishLatestValue(watchInfo);
     }
 }
 
@@ -5861,6 +6931,7 @@ timelib64_t DcgmCacheManager::DoOneUpdateAllFields(void)
 {
     timelib64_t earliestNextUpdate    = 0;
     dcgmcm_update_thread_t *threadCtx = m_updateThreadCtx;
+    long long cycleId                 = 0;
 
     assert(threadCtx != nullptr);
 
@@ -5871,6 +6942,14 @@ timelib64_t DcgmCacheManager::DoOneUpdateAllFields(void)
         threadCtx->fvBuffer = new DcgmFvBuffer();
     }
 
+    /* Any forced update queued before now is satisfied by this cycle */
+    {
+        std::lock_guard<std::mutex> cycleLock(m_cycleMutex);
+        m_cycleInProgress       = true;
+        m_forcedCyclePending    = false;
+        m_currentCycleStartUsec = timelib_usecSince1970();
+    }
+
     /* ActuallyUpdateAllFields needs a locked mutex */
     {
         DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
@@ -5878,8 +6957,24 @@ timelib64_t DcgmCacheManager::DoOneUpdateAllFields(void)
         /* Try to update all fields */
         earliestNextUpdate = 0;
         ActuallyUpdateAllFields(threadCtx, &earliestNextUpdate);
+
+        EnforceCacheMemoryBudget();
+
+        /* Publish the cycle while we still hold m_mutex so readers holding it see a stable cycle */
+        std::lock_guard<std::mutex> cycleLock(m_cycleMutex);
+        m_lastCycleId++;
+        m_lastCycleStartUsec = m_currentCycleStartUsec;
+        m_lastCycleEndUsec   = timelib_usecSince1970();
+        m_cycleInProgress    = false;
+        cycleId              = m_lastCycleId;
     }
 
+    /* Notify before waking up forced update waiters so their clients hear about the
+       cycle before the responses to their requests */
+    NotifyUpdateCycleSubscribers(cycleId);
+
+    m_cycleCondition.notify_all();
+
     if (threadCtx->fvBuffer)
         UpdateFvSubscribers(threadCtx);
 
@@ -5933,6 +7028,15 @@ void DcgmCacheManager::RunWrapped(void)
             continue;
         }
 
+        /* On a free-running virtual clock, jump straight to the next update instead of waiting for it */
+        if (earliestNextUpdate && DcgmNs::Timelib::VirtualClock::IsFreeRunning())
+        {
+            DcgmNs::Timelib::VirtualClock::AdvanceTo(std::min(earliestNextUpdate, maxNextWakeTime));
+            m_runStats.numSleepsSkipped++;
+            SetRunInterval(std::chrono::milliseconds(0));
+            continue;
+        }
+
         /* Only bother if we are supposed to sleep for > 100 usec. Sleep takes 60+ usec */
         /* Are we past our maximum time between loops? */
         if (now > maxNextWakeTime - 100)
@@ -5986,7 +7090,7 @@ void DcgmCacheManager::run(void)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::GetCacheManagerFieldInfo(dcgmCacheManagerFieldInfo_v4_t *fieldInfo)
+dcgmReturn_t DcgmCacheManager::GetCacheManagerFieldInfo(dcgmCacheManagerFieldInfo_v5_t *fieldInfo)
 {
     dcgmcm_watch_info_p watchInfo = 0;
     dcgm_field_meta_p fieldMeta   = 0;
@@ -5995,11 +7099,11 @@ dcgmReturn_t DcgmCacheManager::GetCacheManagerFieldInfo(dcgmCacheManagerFieldInf
     if (!fieldInfo)
         return DCGM_ST_BADPARAM;
 
-    if (fieldInfo->version != dcgmCacheManagerFieldInfo_version4)
+    if (fieldInfo->version != dcgmCacheManagerFieldInfo_version5)
     {
         log_error("Got GetCacheManagerFieldInfo ver {} != expected {}",
                   (int)fieldInfo->version,
-                  (int)dcgmCacheManagerFieldInfo_version4);
+                  (int)dcgmCacheManagerFieldInfo_version5);
         return DCGM_ST_VER_MISMATCH;
     }
 
@@ -6034,7 +7138,7 @@ dcgmReturn_t DcgmCacheManager::GetCacheManagerFieldInfo(dcgmCacheManagerFieldInf
     if (watchInfo->isWatched)
         fieldInfo->flags |= DCGM_CMI_F_WATCHED;
 
-    fieldInfo->version             = dcgmCacheManagerFieldInfo_version4;
+    fieldInfo->version             = dcgmCacheManagerFieldInfo_version5;
     fieldInfo->lastStatus          = (short)watchInfo->lastStatus;
     fieldInfo->maxAgeUsec          = watchInfo->maxAgeUsec;
     fieldInfo->monitorIntervalUsec = watchInfo->monitorIntervalUsec;
@@ -6055,6 +7159,34 @@ dcgmReturn_t DcgmCacheManager::GetCacheManagerFieldInfo(dcgmCacheManagerFieldInf
         fieldInfo->numWatchers++;
     }
 
+    DcgmCacheMemoryPool *pool = GetSampleMemoryPool(watchInfo);
+    if (pool != nullptr)
+    {
+        DcgmCacheMemoryPool::Stats stats = pool->GetStats();
+        fieldInfo->numaNode              = pool->GetNumaNode();
+        fieldInfo->hugePages             = pool->GetHugePages();
+        fieldInfo->poolBytesReserved     = stats.bytesReserved;
+        fieldInfo->poolBytesInUse        = stats.bytesInUse;
+        fieldInfo->poolHeapFallbacks     = stats.heapFallbacks;
+    }
+    else
+    {
+        fieldInfo->numaNode          = -1;
+        fieldInfo->hugePages         = DCGM_CM_HUGEPAGES_NONE;
+        fieldInfo->poolBytesReserved = 0;
+        fieldInfo->poolBytesInUse    = 0;
+        fieldInfo->poolHeapFallbacks = 0;
+    }
+
+    fieldInfo->sampleBytes = 0;
+    if (watchInfo->timeSeries && watchInfo->timeSeries->keyedVector)
+    {
+        keyedvector_p kv       = watchInfo->timeSeries->keyedVector;
+        fieldInfo->sampleBytes = (long long)kv->Nblocks * kv->subBlockSize;
+    }
+
+    fieldInfo->budgetEvictedSamples = watchInfo->budgetEvictedSamples;
+
     if (!watchInfo->timeSeries)
     {
         /* No values yet */
@@ -6154,6 +7286,7 @@ dcgmReturn_t DcgmCacheManager::AppendEntityDouble(dcgmcm_update_thread_t *thread
         }
 
         timeseries_insert_double_coerce(watchInfo->timeSeries, timestamp, value1, value2);
+        AppendToWatcherViews(watchInfo, TS_TYPE_DOUBLE, timestamp, 0, value1);
         EnforceWatchInfoQuota(watchInfo, timestamp, oldestKeepTimestamp);
 
         if (mutexSt == DCGM_MUTEX_ST_OK)
@@ -6184,8 +7317,11 @@ dcgmReturn_t DcgmCacheManager::AllocWatchInfoTimeSeries(dcgmcm_watch_info_p watc
     if (watchInfo->timeSeries)
         return DCGM_ST_OK; /* Already alloc'd */
 
-    int errorSt           = 0;
-    watchInfo->timeSeries = timeseries_alloc(tsType, &errorSt);
+    DcgmCacheMemoryPool *pool = GetSampleMemoryPool(watchInfo);
+
+    int errorSt = 0;
+    watchInfo->timeSeries
+        = timeseries_alloc_with_allocator(tsType, pool == nullptr ? nullptr : pool->GetKvAllocator(), &errorSt);
     if (!watchInfo->timeSeries)
     {
         log_error("timeseries_alloc(tsType={}) failed with {}", tsType, errorSt);
@@ -6195,6 +7331,86 @@ dcgmReturn_t DcgmCacheManager::AllocWatchInfoTimeSeries(dcgmcm_watch_info_p watc
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+void DcgmCacheManager::InitMemoryPools()
+{
+    if (m_cacheHugePages == DCGM_CM_HUGEPAGES_NONE || !m_memoryPools.empty())
+    {
+        return;
+    }
+
+    dcgmAffinity_t affinity = {};
+    dcgmReturn_t ret        = PopulateCpuAffinity(affinity);
+    if (ret != DCGM_ST_OK)
+    {
+        log_warning("Unable to get the CPU affinity of the GPUs: {}. Samples will be on the default heap.",
+                    errorString(ret));
+        return;
+    }
+
+    unsigned int const bitsPerMask = sizeof(affinity.affinityMasks[0].bitmask[0]) * 8;
+
+    for (unsigned int i = 0; i < affinity.numGpus && i < DCGM_MAX_NUM_DEVICES; i++)
+    {
+        unsigned int const gpuId = affinity.affinityMasks[i].dcgmGpuId;
+        if (gpuId >= DCGM_MAX_NUM_DEVICES)
+        {
+            continue;
+        }
+
+        /* A GPU's CPUs are all on its NUMA node, so the first one tells us where it is */
+        int numaNode = -1;
+        for (unsigned int word = 0; word < DCGM_AFFINITY_BITMASK_ARRAY_SIZE && numaNode < 0; word++)
+        {
+            unsigned long const mask = affinity.affinityMasks[i].bitmask[word];
+            if (mask != 0)
+            {
+                numaNode = DcgmCacheMemoryPool::GetNumaNodeOfCpu(word * bitsPerMask + __builtin_ctzl(mask));
+                break;
+            }
+        }
+
+        auto &pool = m_memoryPools[numaNode];
+        if (!pool)
+        {
+            pool = std::make_unique<DcgmCacheMemoryPool>(numaNode, m_cacheHugePages, KV_DEFAULT_SUBBLOCK_SIZE);
+        }
+        m_gpuMemoryPools[gpuId] = pool.get();
+
+        log_debug("Samples of GPU {} will be in the pool of NUMA node {}", gpuId, numaNode);
+    }
+}
+
+/*****************************************************************************/
+DcgmCacheMemoryPool *DcgmCacheManager::GetSampleMemoryPool(dcgmcm_watch_info_p watchInfo)
+{
+    if (m_memoryPools.empty())
+    {
+        return nullptr;
+    }
+
+    switch (watchInfo->practicalEntityGroupId)
+    {
+        case DCGM_FE_GPU:
+        case DCGM_FE_GPU_I:
+        case DCGM_FE_GPU_CI:
+            break;
+
+        default:
+            return nullptr;
+    }
+
+    /* MIG instances are on the NUMA node of the GPU they are carved out of */
+    unsigned int gpuId = DCGM_GPU_ID_BAD;
+    if (GetGpuId(watchInfo->practicalEntityGroupId, watchInfo->practicalEntityId, gpuId) != DCGM_ST_OK
+        || gpuId >= DCGM_MAX_NUM_DEVICES)
+    {
+        return nullptr;
+    }
+
+    return m_gpuMemoryPools[gpuId];
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::EnforceWatchInfoQuota(dcgmcm_watch_info_p watchInfo,
                                                      timelib64_t timestamp,
@@ -6205,6 +7421,11 @@ dcgmReturn_t DcgmCacheManager::EnforceWatchInfoQuota(dcgmcm_watch_info_p watchIn
 
     /* Passing count quota as 0 since we enforce quota by time alone */
     int st = timeseries_enforce_quota(watchInfo->timeSeries, oldestKeepTimestamp, 0);
+
+    /* Every append ends up here, so this keeps the accounting and the latest value current */
+    UpdateWatchInfoCacheBytes(watchInfo);
+    PublishLatestValue(watchInfo);
+
     if (st)
     {
         log_error("timeseries_enforce_quota returned {}", st);
@@ -6214,6 +7435,41 @@ dcgmReturn_t DcgmCacheManager::EnforceWatchInfoQuota(dcgmcm_watch_info_p watchIn
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+void DcgmCacheManager::PublishLatestValue(dcgmcm_watch_info_p watchInfo)
+{
+    timeseries_p timeSeries = watchInfo->timeSeries;
+    if (timeSeries == nullptr || (timeSeries->tsType != TS_TYPE_INT64 && timeSeries->tsType != TS_TYPE_DOUBLE))
+    {
+        watchInfo->latestValue.Clear();
+        return;
+    }
+
+    /* The newest sample isn't always the one just appended. Injected samples can be older */
+    kv_cursor_t cursor;
+    timeseries_entry_p entry = (timeseries_entry_p)keyedvector_last(timeSeries->keyedVector, &cursor);
+    if (entry == nullptr)
+    {
+        watchInfo->latestValue.Clear();
+        return;
+    }
+
+    DcgmLatestValue value {};
+    value.tsType    = timeSeries->tsType;
+    value.timestamp = entry->usecSince1970;
+    if (timeSeries->tsType == TS_TYPE_INT64)
+    {
+        value.valueInt64  = entry->val.i64;
+        value.value2Int64 = entry->val2.i64;
+    }
+    else
+    {
+        value.valueDouble  = entry->val.dbl;
+        value.value2Double = entry->val2.dbl;
+    }
+    watchInfo->latestValue.Publish(value);
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::AppendEntityInt64(dcgmcm_update_thread_t *threadCtx,
                                                  long long value1,
@@ -6251,6 +7507,7 @@ dcgmReturn_t DcgmCacheManager::AppendEntityInt64(dcgmcm_update_thread_t *threadC
         }
 
         timeseries_insert_int64_coerce(watchInfo->timeSeries, timestamp, value1, value2);
+        AppendToWatcherViews(watchInfo, TS_TYPE_INT64, timestamp, value1, 0.0);
         EnforceWatchInfoQuota(watchInfo, timestamp, oldestKeepTimestamp);
 
         if (mutexSt == DCGM_MUTEX_ST_OK)
@@ -6413,17 +7670,14 @@ std::optional<unsigned int> DcgmCacheManager::GetGpuIdForEntity(dcgm_field_entit
             }
             break;
         case DCGM_FE_VGPU:
-            for (unsigned int i = 0; i < m_numGpus; i++)
+        {
+            auto it = m_vgpuParentGpuIds.find(entityId);
+            if (it != m_vgpuParentGpuIds.end())
             {
-                for (dcgmcm_vgpu_info_p vgpu = m_gpus[i].vgpuList; vgpu != nullptr; vgpu = vgpu->next)
-                {
-                    if (vgpu->vgpuId == entityId)
-                    {
-                        return m_gpus[i].gpuId;
-                    }
-                }
+                return it->second;
             }
             break;
+        }
         default:
             return std::nullopt;
     }
@@ -6546,6 +7800,23 @@ void DcgmCacheManager::NotifyMigUpdateSubscribers(unsigned int gpuId)
     }
 }
 
+/*****************************************************************************/
+void DcgmCacheManager::NotifyUpdateCycleSubscribers(long long cycleId)
+{
+    dcgmMutexReturn_t mutexSt = dcgm_mutex_lock_me(m_mutex);
+
+    std::vector<dcgmcmEventSubscription_t> localCopy(begin(m_subscriptions[DcgmcmEventTypeUpdateCycle]),
+                                                     end(m_subscriptions[DcgmcmEventTypeUpdateCycle]));
+
+    if (mutexSt != DCGM_MUTEX_ST_LOCKEDBYME)
+        dcgm_mutex_unlock(m_mutex);
+
+    for (auto &&entry : localCopy)
+    {
+        entry.fn.cycleCb(cycleId, entry.userData);
+    }
+}
+
 /*****************************************************************************/
 void DcgmCacheManager::RecordXidForGpu(unsigned int gpuId,
                                        dcgmcm_update_thread_t &threadCtx,
@@ -10994,105 +12265,54 @@ void DcgmCacheManager::ReadAndCacheNvLinkData(dcgmcm_update_thread_t *threadCtx,
 dcgmReturn_t DcgmCacheManager::ManageVgpuList(unsigned int gpuId, nvmlVgpuInstance_t *vgpuInstanceIds)
 {
     DcgmLockGuard dlg(m_mutex);
-    dcgmcm_vgpu_info_p curr = NULL, temp = NULL, initialVgpuListState = NULL, finalVgpuListState = NULL;
 
     /* First element of the vgpuInstanceIds array must hold the count of vGPU instances running */
     unsigned int vgpuCount = vgpuInstanceIds[0];
 
-    /* Stores the initial state of vgpuList for the current GPU */
-    initialVgpuListState = m_gpus[gpuId].vgpuList;
+    std::unordered_set<nvmlVgpuInstance_t> &vgpuIds = m_gpus[gpuId].vgpuIds;
+    std::unordered_set<nvmlVgpuInstance_t> activeVgpuIds(vgpuInstanceIds + 1, vgpuInstanceIds + 1 + vgpuCount);
 
-    /* Checking if new vGPU instances have spawned up in this iteration.
-       A vGPU instance is new if its instance ID is present in the refreshed
-       list returned by NVML, but is absent from the current GPU's vgpuList. */
-    for (unsigned int i = 0; i < vgpuCount; i++)
-    {
-        bool new_entry = 1;
-        temp = curr = m_gpus[gpuId].vgpuList;
+    /* Stores the initial state of the vGPU instances for the current GPU */
+    bool const hadVgpus = !vgpuIds.empty();
 
-        while (curr)
+    /* Remove inactive vGPU instances. A vGPU instance is inactive if it's absent from the
+       refreshed list returned by NVML */
+    for (auto it = vgpuIds.begin(); it != vgpuIds.end();)
+    {
+        nvmlVgpuInstance_t vgpuId = *it;
+        if (activeVgpuIds.contains(vgpuId))
         {
-            if (vgpuInstanceIds[i + 1] == curr->vgpuId)
-            {
-                new_entry = 0;
-                /* Marking the current vgpuList entry as "found", since it is present in
-                   the refreshed vGPU ID list returned by NVML */
-                curr->found = 1;
-                break;
-            }
-            temp = curr;
-            curr = curr->next;
+            ++it;
+            continue;
         }
 
-        /* Add the new vGPU Instance info to the vgpuList of the current GPU */
-        if (new_entry)
-        {
-            dcgmcm_vgpu_info_p vgpuInfo = (dcgmcm_vgpu_info_p)malloc(sizeof(dcgmcm_vgpu_info_t));
-            if (!vgpuInfo)
-            {
-                log_error("malloc of {} bytes failed for metadata of vGPU instance {}",
-                          (int)(sizeof(dcgmcm_vgpu_info_t)),
-                          vgpuInstanceIds[i + 1]);
-                continue;
-            }
-
-            vgpuInfo->vgpuId = vgpuInstanceIds[i + 1];
-            vgpuInfo->found  = 1;
-            vgpuInfo->next   = NULL;
-
-
-            if (!m_gpus[gpuId].vgpuList)
-                m_gpus[gpuId].vgpuList = vgpuInfo;
-            else
-            {
-                vgpuInfo->next = temp->next;
-                temp->next     = vgpuInfo;
-            }
-
-            WatchVgpuFields(vgpuInfo->vgpuId);
-        }
+        it = vgpuIds.erase(it);
+        m_vgpuParentGpuIds.erase(vgpuId);
+        UnwatchVgpuFields(vgpuId);
+        log_debug("Removing vgpuId {} for gpuId {}", vgpuId, gpuId);
     }
 
-    temp = nullptr;
-    curr = m_gpus[gpuId].vgpuList;
-
-    /* Remove entries of inactive vGPU instances from the current GPU's list. */
-    while (curr)
+    /* Add new vGPU instances. Iterating over the NVML list rather than activeVgpuIds keeps the
+       watches being added in the order NVML reported the instances */
+    for (unsigned int i = 0; i < vgpuCount; i++)
     {
-        dcgmcm_vgpu_info_p toBeDeleted = NULL;
-        /*Any vGPU metadata node in m_vgpus that is not marked as "found" in the previous loop is stale/inactive. */
-        if (!curr->found)
-        {
-            toBeDeleted = curr;
-            if (curr == m_gpus[gpuId].vgpuList)
-            {
-                m_gpus[gpuId].vgpuList = curr->next;
-            }
-            else if (temp != nullptr)
-            {
-                temp->next = curr->next;
-            }
-            curr = curr->next;
-
-            UnwatchVgpuFields(toBeDeleted->vgpuId);
-            log_debug("Removing vgpuId {} for gpuId {}", toBeDeleted->vgpuId, gpuId);
-            free(toBeDeleted);
-        }
-        else
+        nvmlVgpuInstance_t vgpuId = vgpuInstanceIds[i + 1];
+        if (!vgpuIds.insert(vgpuId).second)
         {
-            curr->found = 0;
-            temp        = curr;
-            curr        = curr->next;
+            continue;
         }
+
+        m_vgpuParentGpuIds[vgpuId] = gpuId;
+        WatchVgpuFields(vgpuId);
     }
 
-    /* Stores the final state of vgpuList after any addition/removal of vGPU entries on the current GPU */
-    finalVgpuListState = m_gpus[gpuId].vgpuList;
+    /* Stores the final state of the vGPU instances after any addition/removal on the current GPU */
+    bool const hasVgpus = !vgpuIds.empty();
 
     DcgmWatcher watcher(DcgmWatcherTypeCacheManager);
 
     /* Watching frequently cached fields only when there are vGPU instances running on the GPU. */
-    if ((!initialVgpuListState) && (finalVgpuListState))
+    if (!hadVgpus && hasVgpus)
     {
         bool wereFirstWatcher = false;
         AddFieldWatch(DCGM_FE_GPU,
@@ -11130,7 +12350,7 @@ dcgmReturn_t DcgmCacheManager::ManageVgpuList(unsigned int gpuId, nvmlVgpuInstan
                       false,
                       wereFirstWatcher);
     }
-    else if ((initialVgpuListState) && (!finalVgpuListState))
+    else if (hadVgpus && !hasVgpus)
     {
         RemoveFieldWatch(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_VGPU_UTILIZATIONS, 1, watcher);
         RemoveFieldWatch(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_VGPU_PER_PROCESS_UTILIZATION, 1, watcher);
@@ -11139,19 +12359,11 @@ dcgmReturn_t DcgmCacheManager::ManageVgpuList(unsigned int gpuId, nvmlVgpuInstan
         RemoveFieldWatch(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_FBC_SESSIONS_INFO, 1, watcher);
     }
 
-    /* Verifying vpuList to match the input vGPU instance ids array, in case of mismatch return
+    /* Verifying the vGPU instances match the input vGPU instance ids array, in case of mismatch return
      * DCGM_ST_GENERIC_ERROR */
-    temp = m_gpus[gpuId].vgpuList;
-    while (temp)
+    if (vgpuIds != activeVgpuIds)
     {
-        unsigned int i = 0;
-        while (i < vgpuCount && temp->vgpuId != vgpuInstanceIds[i + 1])
-        {
-            i++;
-        }
-        if (i >= vgpuCount)
-            return DCGM_ST_GENERIC_ERROR;
-        temp = temp->next;
+        return DCGM_ST_GENERIC_ERROR;
     }
 
     return DCGM_ST_OK;
@@ -11803,6 +13015,36 @@ void DcgmCacheManager::WatchVgpuFields(nvmlVgpuInstance_t vgpuId)
                         wereFirstWatcher);
 }
 
+/*****************************************************************************/
+dcgmcm_vgpu_sessions_t const *DcgmCacheManager::GetVgpuSessionsForCycle(nvmlVgpuInstance_t vgpuId)
+{
+    unsigned int gpuId;
+    nvmlDevice_t nvmlDevice;
+
+    {
+        DcgmLockGuard dlg(m_mutex);
+
+        auto it = m_vgpuParentGpuIds.find(vgpuId);
+        if (it == m_vgpuParentGpuIds.end())
+        {
+            log_debug("vgpuId {} isn't running on any GPU", vgpuId);
+            return nullptr;
+        }
+
+        gpuId      = it->second;
+        nvmlDevice = m_gpus[gpuId].nvmlDevice;
+    }
+
+    dcgmcm_vgpu_sessions_t &sessions = m_vgpuSessionsThisCycle[gpuId];
+    if (sessions.encSessionsStatus != NVML_ERROR_UNINITIALIZED)
+    {
+        return &sessions; /* Another vGPU instance on this GPU already fetched them this cycle */
+    }
+
+    FetchVgpuSessions(nvmlDevice, sessions);
+    return &sessions;
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::UnwatchVgpuFields(nvmlVgpuInstance_t vgpuId)
 {
@@ -15,11 +15,13 @@
  */
 #pragma once
 
+#include "DcgmCacheMemoryPool.h"
 #include "DcgmDiscovery.h"
 #include "DcgmFvBuffer.h"
 #include "DcgmGpmManager.hpp"
 #include "DcgmGpuInstance.h"
 #include "DcgmInjectionNvmlManager.h"
+#include "DcgmLatestValueSlot.h"
 #include "DcgmMigManager.h"
 #include "DcgmMutex.h"
 #include "DcgmSettings.h"
@@ -35,13 +37,16 @@
 
 #include <DcgmTaskRunner.h>
 
+#include <array>
 #include <bitset>
 #include <condition_variable>
 #include <dcgm_nvml.h>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 /*****************************************************************************/
 /* Summary information types */
@@ -86,6 +91,21 @@ typedef struct dcgmcm_sample_t /* This is made to look similar to timeseries_val
 
 } dcgmcm_sample_t, *dcgmcm_sample_p;
 
+/*****************************************************************************/
+/* How a watcher's decimated view reduces the samples in each of its intervals */
+typedef enum
+{
+    DcgmcmDecimateLast = 0, /* The last sample of each interval, emitted when the interval closes. This is
+                               the newest value the watcher would have seen sampling on its own */
+    DcgmcmDecimateFirst,    /* The first sample of each interval, emitted as soon as it arrives */
+    DcgmcmDecimateMean,     /* Mean of the non-blank samples in each interval */
+    DcgmcmDecimateMax,      /* Largest non-blank sample in each interval */
+} dcgmcm_decimation_t;
+
+/* A watcher only gets its own decimated view of a watch if its interval is at least this many times
+   the interval the watch is sampled at. Closer than that, reading the shared samples is as cheap */
+#define DCGM_CM_VIEW_MIN_DECIMATION 2
+
 /*****************************************************************************/
 /* Details for a single watcher of a field. Each fieldId has a vector of these */
 typedef struct dcgm_watch_watcher_info_t
@@ -96,8 +116,35 @@ typedef struct dcgm_watch_watcher_info_t
                                           field. If 0, the class default is used */
     int isSubscribed;                /* Does this watcher want live updates
                                           when this field value updates? */
+    dcgmcm_decimation_t decimation;  /* How this watcher's view is decimated, if it has one */
 } dcgm_watch_watcher_info_t, *dcgm_watch_watcher_info_p;
 
+/*****************************************************************************/
+/*
+ * A client watcher's own series of a watch, decimated from the shared samples to
+ * the watcher's interval and kept for the watcher's max age.
+ *
+ * A watch is sampled at the shortest interval of its watchers. Without views,
+ * a slow watcher sharing a field with a fast one would keep the fast rate for its
+ * whole retention and scan all of it on every read.
+ */
+typedef struct dcgmcm_watcher_view_t
+{
+    DcgmWatcher watcher;             /* Whose view this is. Reads from this watcher's connection use it */
+    timelib64_t intervalUsec;        /* Bucket width. The watcher's monitorIntervalUsec */
+    timelib64_t maxAgeUsec;          /* The watcher's maxAgeUsec */
+    dcgmcm_decimation_t decimation;  /* How each bucket is reduced to one sample */
+    timeseries_p timeSeries;         /* One sample per bucket. nullptr until the first bucket is done */
+    timelib64_t bucketEndUsec;       /* End of the open bucket. 0 = no open bucket */
+    timelib64_t bucketLastUsec;      /* Timestamp of the newest sample in the open bucket */
+    int bucketCount;                 /* Non-blank samples in the open bucket */
+    double bucketSum;                /* Sum of the non-blank samples in the open bucket */
+    double bucketMaxDouble;          /* Largest non-blank double in the open bucket */
+    long long bucketMaxInt64;        /* Largest non-blank int64 in the open bucket */
+    double bucketLastDouble;         /* Newest double in the open bucket, blank or not */
+    long long bucketLastInt64;       /* Newest int64 in the open bucket, blank or not */
+} dcgmcm_watcher_view_t;
+
 /*****************************************************************************/
 /*
  * Struct to hold a single watch and its field values
@@ -140,16 +187,28 @@ typedef struct dcgmcm_watch_info_t
     dcgm_field_entity_group_t practicalEntityGroupId; /* the entity group id where data should
                                                         be polled */
     dcgm_field_eid_t practicalEntityId;               /* the entity id where data should be pulled */
+    long long cacheBytes;                             /* Bytes held by timeSeries and the views as of the last
+                                                         time they changed. The sum of these is the cache
+                                                         memory in use */
+    long long budgetEvictedSamples;                   /* Samples evicted from timeSeries to stay within the
+                                                         cache memory budget */
+    std::vector<dcgmcm_watcher_view_t> views;         /* Decimated views of slower client watchers. Those
+                                                         watchers don't count toward timeSeries' retention */
+    DcgmLatestValueSlot latestValue;                  /* Newest sample of timeSeries if it's int64 or double.
+                                                         Read by GetLatestSample() without m_mutex */
 } dcgmcm_watch_info_t, *dcgmcm_watch_info_p;
 
 /*****************************************************************************/
-typedef struct dcgmcm_vgpu_info_t
+/* Results of the per-GPU NVML session queries for one update cycle. Every vGPU instance on
+   the GPU filters its sessions out of these, so each GPU is queried once per cycle rather
+   than once per vGPU instance */
+struct dcgmcm_vgpu_sessions_t
 {
-    nvmlVgpuInstance_t vgpuId;       /* vGPU Instance ID */
-    bool found;                      /* Flag to denote that the vGPU instance is
-                                           still active */
-    struct dcgmcm_vgpu_info_t *next; /* Pointer to the next node in the list */
-} dcgmcm_vgpu_info_t, *dcgmcm_vgpu_info_p;
+    nvmlReturn_t encSessionsStatus = NVML_ERROR_UNINITIALIZED; /* Status of nvmlDeviceGetEncoderSessions */
+    std::vector<nvmlEncoderSessionInfo_t> encSessions;         /* Encoder sessions of every vGPU instance */
+    nvmlReturn_t fbcSessionsStatus = NVML_ERROR_UNINITIALIZED; /* Status of nvmlDeviceGetFBCSessions */
+    std::vector<nvmlFBCSessionInfo_t> fbcSessions;             /* FBC sessions of every vGPU instance */
+};
 
 extern const unsigned int DCGM_BLANK_ENTITY_ID;
 
@@ -167,7 +226,6 @@ typedef struct dcgmcm_gpu_info_t
         memset(&pciInfo, 0, sizeof(pciInfo));
         arch               = DCGM_CHIP_ARCH_UNKNOWN;
         virtualizationMode = DCGM_GPU_VIRTUALIZATION_MODE_NONE;
-        memset(&vgpuList, 0, sizeof(vgpuList));
         memset(nvLinkLinkState, DcgmNvLinkLinkStateNotSupported, sizeof(nvLinkLinkState));
         numNvLinks = 0;
     }
@@ -184,12 +242,12 @@ typedef struct dcgmcm_gpu_info_t
         , ccMode(0)
         , maxGpcs(other.maxGpcs)
         , usedGpcs(other.usedGpcs)
+        , vgpuIds(other.vgpuIds)
         , instances(other.instances)
         , ciCount(other.ciCount)
     {
         memcpy(uuid, other.uuid, sizeof(uuid));
         memcpy(&pciInfo, &other.pciInfo, sizeof(pciInfo));
-        memcpy(&vgpuList, &other.vgpuList, sizeof(vgpuList));
         memcpy(nvLinkLinkState, other.nvLinkLinkState, sizeof(nvLinkLinkState));
     }
 
@@ -211,8 +269,8 @@ typedef struct dcgmcm_gpu_info_t
             numNvLinks         = other.numNvLinks;
             memcpy(uuid, other.uuid, sizeof(uuid));
             memcpy(&pciInfo, &other.pciInfo, sizeof(pciInfo));
-            memcpy(&vgpuList, &other.vgpuList, sizeof(vgpuList));
             memcpy(nvLinkLinkState, other.nvLinkLinkState, sizeof(nvLinkLinkState));
+            vgpuIds   = other.vgpuIds;
             instances = other.instances;
             ciCount   = other.ciCount;
         }
@@ -236,7 +294,7 @@ typedef struct dcgmcm_gpu_info_t
     unsigned int usedGpcs = 0; /*!< Number of actually used GPCs */
 
     /* vGPU Instance metadata */
-    dcgmcm_vgpu_info_p vgpuList; /* Head pointer of the vGPU linked list for this GPU */
+    std::unordered_set<nvmlVgpuInstance_t> vgpuIds; /* Active vGPU instances on this GPU */
 
     /* NvLink per-lane status */
     dcgmNvLinkLinkState_t nvLinkLinkState[DCGM_NVLINK_MAX_LINKS_PER_GPU];
@@ -264,6 +322,30 @@ typedef struct dcgmcm_gpu_info_cached_t
        DcgmCacheManager::GetAllGpuInfo */
 } dcgmcm_gpu_info_cached_t, *dcgmcm_gpu_info_cached_p;
 
+/*****************************************************************************/
+/* Stats of forced update cycles requested with UpdateAllFields() */
+typedef struct
+{
+    long long numRequests;      /* Number of UpdateAllFields() calls */
+    long long numExecuted;      /* Number of forced update cycles that actually ran */
+    long long numCoalesced;     /* Number of UpdateAllFields() calls that were satisfied by a cycle that was
+                                   already queued, in progress or within the minimum spacing */
+    long long numSkipped;       /* Number of queued forced update cycles that didn't run since a timed cycle
+                                   satisfied their callers first */
+    timelib64_t minSpacingUsec; /* Current minimum spacing between forced update cycles */
+} dcgmcm_forced_update_stats_t;
+
+/*****************************************************************************/
+/* Memory used by cached samples and evictions to stay within the budget */
+typedef struct
+{
+    long long budgetBytes;    /* Cache memory budget. 0 = unlimited */
+    long long usedBytes;      /* Bytes held by the time series of every watch */
+    long long numEvictions;   /* Number of budget passes that evicted any samples */
+    long long evictedSamples; /* Number of samples evicted */
+    long long evictedBytes;   /* Bytes freed by evicting samples */
+} dcgmcm_cache_memory_stats_t;
+
 /*****************************************************************************/
 /* Runtime stats for the cache manager */
 struct dcgmcm_runtime_stats_t
@@ -372,12 +454,15 @@ typedef enum
 {
     DcgmcmEventTypeFvUpdate = 0,   // field value update event
     DcgmcmEventTypeMigReconfigure, // Mig reconfigured event
+    DcgmcmEventTypeUpdateCycle,    // An update cycle completed
 
     DcgmcmEventTypeSize // Always last entry
 } DcgmcmEventType_t;
 
 typedef void (*dcgmOnMigReconfigure_f)(unsigned int gpuId, void *userData);
 
+typedef void (*dcgmOnUpdateCycle_f)(long long cycleId, void *userData);
+
 typedef struct
 {
     DcgmcmEventType_t type; // specifies which kind of subscription this is
@@ -385,6 +470,7 @@ typedef struct
     {
         dcgmOnSubscribedFvUpdate_f fvCb; // callback for field value updates
         dcgmOnMigReconfigure_f migCb;    // callback for mig configuration
+        dcgmOnUpdateCycle_f cycleCb;     // callback for completed update cycles
     } fn;
     void *userData; // user data passed to callback function
 } dcgmcmEventSubscription_t;
@@ -638,14 +724,62 @@ public:
      * This notifies the sampling thread that
      * it should do a round of sampling before going to sleep again.
      *
+     * Forced updates are coalesced. If a forced update cycle is already queued,
+     * the caller is attached to it instead of queueing another one.
+     *
      * waitForUpdate IN: Whether (1) or not (0) the caller should wait for the
      *                   triggered update cycle to finish before returning.
+     * useMinSpacing IN: Whether the caller can also be satisfied by a cycle that
+     *                   started up to the forced update minimum spacing before
+     *                   this call (see SetForcedUpdateMinSpacing()). Only client
+     *                   requests pass true. Modules and other internal callers
+     *                   expect values newer than their request and must pass false
      *
      * Returns 0 on success
      *         DCGM_ST_? #define on error.
      *
      */
-    dcgmReturn_t UpdateAllFields(int waitForUpdate);
+    dcgmReturn_t UpdateAllFields(int waitForUpdate, bool useMinSpacing = false);
+
+    /*************************************************************************/
+    /*
+     * Set the minimum spacing between forced update cycles. Callers of
+     * UpdateAllFields() with useMinSpacing set are satisfied by any cycle that
+     * started less than minSpacingUsec before they called instead of forcing a
+     * new one. 0 = every forced update gets a cycle that starts after it.
+     *
+     * This defaults to the __DCGM_FORCED_UPDATE_MIN_SPACING_MS environment
+     * variable, or 0 if it isn't set.
+     */
+    void SetForcedUpdateMinSpacing(timelib64_t minSpacingUsec);
+
+    /*************************************************************************/
+    /*
+     * Get the counts of forced update cycles that were executed vs coalesced
+     */
+    dcgmcm_forced_update_stats_t GetForcedUpdateStats();
+
+    /*************************************************************************/
+    /*
+     * Set a budget for the memory held by cached samples. Once per update
+     * cycle, if the cache is over budget, the oldest samples are evicted
+     * until it is 10% under budget. Watches with no watchers are evicted
+     * first, then watches that only clients watch, then watches that
+     * hostengine modules watch. The newest sample of a watch is never
+     * evicted.
+     *
+     * budgetBytes IN: Budget in bytes. 0 = unlimited
+     *
+     * Returns: DCGM_ST_OK on success
+     *          DCGM_ST_BADPARAM if budgetBytes is negative
+     */
+    dcgmReturn_t SetCacheMemoryBudget(long long budgetBytes);
+
+    /*************************************************************************/
+    /*
+     * Get the memory used by cached samples, the budget and eviction counts
+     */
+    dcgmcm_cache_memory_stats_t GetCacheMemoryStats();
 
 
     /*************************************************************************/
@@ -694,6 +828,32 @@ public:
                                bool updateOnFirstWatch,
                                bool &wereFirstWatcher);
 
+    /*************************************************************************/
+    /*
+     * Add watches of every field in fieldIds on every entity in entities as one
+     * transaction. The parameters mean the same as for AddFieldWatch().
+     *
+     * Duplicate entity/field pairs are watched once. The lock is taken once,
+     * NVML events are re-registered once and each NvSwitch entity gets a single
+     * watch message. Either every watch is added or, on error, none are. A
+     * failed batch undoes its NVML pre-watches and creates no watch infos.
+     *
+     * wereFirstWatcher    OUT: Whether we were the first watcher of any of the watches
+     *
+     * Returns 0 on success
+     *        <0 on error. See DCGM_ST_? #defines
+     *
+     */
+    dcgmReturn_t AddFieldWatches(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                 std::vector<unsigned short> const &fieldIds,
+                                 timelib64_t monitorIntervalUsec,
+                                 double maxSampleAge,
+                                 int maxKeepSamples,
+                                 DcgmWatcher watcher,
+                                 bool subscribeForUpdates,
+                                 bool updateOnFirstWatch,
+                                 bool &wereFirstWatcher);
+
     /*************************************************************************/
     /*
      * Update the caching frquency, maxSampleAge and maxKeepSamples for a given field
@@ -910,6 +1070,9 @@ public:
      *                       endTime
      * fvBuffer    OUT: Optional fvBuffer to write the samples to. Can be nullptr
      *                  if samples[] is provided
+     * watcher      IN: Optional watcher that is reading. If it has a decimated view
+     *                  of this field, the samples come from the view. nullptr = read
+     *                  the samples at the rate the field is sampled at
      *
      * Returns 0 on success
      *        <0 on error. See DCGM_ST_? #defines
@@ -922,7 +1085,8 @@ public:
                             timelib64_t startTime,
                             timelib64_t endTime,
                             dcgmOrder_t order,
-                            DcgmFvBuffer *fvBuffer);
+                            DcgmFvBuffer *fvBuffer,
+                            DcgmWatcher const *watcher = nullptr);
 
 
     /*************************************************************************/
@@ -934,6 +1098,8 @@ public:
      * dcgmFieldId   IN: Which DCGM field to get the value for
      * sample       OUT: Where to place sample (optional)
      * fvBuffer     OUT: Alternative place to place sample (optional)
+     * asOfTimestamp IN: If nonzero, get the most recent sample with a timestamp at or
+     *                   before this instead of the most recent sample
      *
      * Returns 0 on success
      *        <0 on error. See DCGM_ST_? #defines
@@ -942,7 +1108,8 @@ public:
                                  dcgm_field_eid_t entityId,
                                  unsigned short dcgmFieldId,
                                  dcgmcm_sample_p sample,
-                                 DcgmFvBuffer *fvBuffer);
+                                 DcgmFvBuffer *fvBuffer,
+                                 timelib64_t asOfTimestamp = 0);
 
     /*************************************************************************/
     /*
@@ -965,6 +1132,42 @@ public:
                                               std::vector<unsigned short> &fieldIds,
                                               DcgmFvBuffer *fvBuffer);
 
+    /*************************************************************************/
+    /*
+     * Get the samples of multiple entities for multiple fields as of the end of one
+     * completed update cycle into a fvBuffer.
+     *
+     * Unlike GetMultipleLatestSamples(), values cached by an update cycle that is
+     * still in progress are never returned, so all of the values are a consistent
+     * snapshot of the cache. Fields that weren't due to be updated in that cycle
+     * return the sample from the last cycle that updated them.
+     *
+     * entityList    IN: Entities to fetch the values for
+     * fieldIds      IN: Field IDs to fetch for each entity
+     * cycleId   IN/OUT: IN: 0 to use the last completed cycle. Otherwise, the last cycle the
+     *                       caller has seen. This waits for a cycle after it to complete.
+     *                   OUT: The ID of the cycle that the values are from
+     * timeoutMs     IN: How long to wait for a cycle to complete, in milliseconds. This is only
+     *                   used if a cycle after cycleId hasn't completed yet
+     * fvBuffer     OUT: Where to place samples.
+     *
+     * Returns 0 on success
+     *         DCGM_ST_TIMEOUT if no new cycle completed within timeoutMs
+     *        <0 on error. See DCGM_ST_? #defines
+     */
+    dcgmReturn_t GetMultipleSamplesForCycle(std::vector<dcgmGroupEntityPair_t> &entities,
+                                            std::vector<unsigned short> &fieldIds,
+                                            long long &cycleId,
+                                            unsigned int timeoutMs,
+                                            DcgmFvBuffer *fvBuffer);
+
+    /*************************************************************************/
+    /*
+     * Get the ID of the last completed update cycle. Update cycle IDs start at 1 and
+     * increase by one for every cycle. 0 means that no cycle has completed yet
+     */
+    long long GetLastCompletedCycleId();
+
     /*************************************************************************/
     /*
      * Set value for a field
@@ -1068,7 +1271,7 @@ public:
      *
      *
      */
-    dcgmReturn_t GetCacheManagerFieldInfo(dcgmCacheManagerFieldInfo_v4_t *fieldInfo);
+    dcgmReturn_t GetCacheManagerFieldInfo(dcgmCacheManagerFieldInfo_v5_t *fieldInfo);
 
     /*************************************************************************/
     /*
@@ -1247,10 +1450,22 @@ public:
      */
     dcgmReturn_t UnwatchVgpuFields(nvmlVgpuInstance_t vgpuId);
 
+    /*************************************************************************/
+    /*
+     * Get the encoder and FBC sessions of the GPU that vgpuId is running on. The first call for a
+     * GPU in each update cycle queries NVML. Later calls in the same cycle reuse those results.
+     *
+     * This must only be called from the update thread without m_mutex held.
+     *
+     * Returns a pointer to the sessions, which is valid until the next update cycle starts
+     *         nullptr if vgpuId isn't a known vGPU instance
+     */
+    dcgmcm_vgpu_sessions_t const *GetVgpuSessionsForCycle(nvmlVgpuInstance_t vgpuId);
+
     /*************************************************************************/
     /*
      * Manage the dynamic addition/removal of the vGPUs.
-     * Active vGPU instance (linked) list is maintained per GPU within the function depending on addition of
+     * Active vGPU instance set is maintained per GPU within the function depending on addition of
      * new vGPU instance or removal of any running vGPU instance.
      * Also vgpuIndex is mapped to the vGPU instances running within range specified for the nvmlIndex.
      * First element of vgpuInstanceIds array passed as input must hold the count of vGPU instances running.
@@ -1429,6 +1644,12 @@ public:
     /*************************************************************************/
     void NotifyMigUpdateSubscribers(unsigned int gpuId);
 
+    /*************************************************************************/
+    /*
+     * Notify subscribers that the update cycle cycleId completed
+     */
+    void NotifyUpdateCycleSubscribers(long long cycleId);
+
     /**
      * Generates the appropriate value for CUDA_VISIBLE_DEVICES for the specified
      * device
@@ -1594,6 +1815,13 @@ private:
     unsigned int m_numComputeInstances;                         // Number of total compute instances created
     std::array<dcgmcm_gpu_info_t, DCGM_MAX_NUM_DEVICES> m_gpus; /* All of the GPUs we know about, indexed by gpuId */
 
+    /* Which GPU each active vGPU instance is running on. Kept in sync with m_gpus[].vgpuIds */
+    std::unordered_map<nvmlVgpuInstance_t, unsigned int> m_vgpuParentGpuIds;
+
+    /* Per-GPU vGPU sessions fetched during the current update cycle, indexed by gpuId. Only
+       accessed by the update thread, so this isn't protected by m_mutex */
+    std::unordered_map<unsigned int, dcgmcm_vgpu_sessions_t> m_vgpuSessionsThisCycle;
+
     bool m_nvmlInitted; /* Tracks whether or not NVML has been initialized. since NVML keeps a count
                            of initializations, we don't want to double initialize or we won't be able
                            to detach and attach to GPUs correctly. */
@@ -1628,6 +1856,39 @@ private:
     /* Runtime stats of the cache manager */
     dcgmcm_runtime_stats_t m_runStats;
 
+    /* The last completed update cycle. These are only written by the update thread while it holds
+       both m_mutex and m_cycleMutex, so holding either of them is enough to read them */
+    long long m_lastCycleId          = 0; /* ID of the last completed update cycle. 0 = none yet */
+    timelib64_t m_lastCycleStartUsec = 0; /* When the last completed update cycle started */
+    timelib64_t m_lastCycleEndUsec   = 0; /* When the last completed update cycle finished. Every
+                                             sample cached by that cycle is at or before this */
+
+    /* Forced update coalescing state. Protected by m_cycleMutex */
+    bool m_cycleInProgress              = false; /* Is an update cycle running right now? */
+    timelib64_t m_currentCycleStartUsec = 0;     /* When the update cycle in progress started */
+    bool m_forcedCyclePending           = false; /* Is a forced cycle queued that hasn't started yet? */
+    dcgmcm_forced_update_stats_t m_forcedUpdateStats {};
+
+    std::mutex m_cycleMutex;
+    std::condition_variable m_cycleCondition; /* Notified every time an update cycle completes */
+
+    /* Pools that samples are stored in. These are only changed by Init() */
+    int m_cacheHugePages = DCGM_CM_HUGEPAGES_NONE; /* DCGM_CM_HUGEPAGES_? mode. NONE = no pools */
+    std::map<int, std::unique_ptr<DcgmCacheMemoryPool>> m_memoryPools; /* Pool of each NUMA node */
+    std::array<DcgmCacheMemoryPool *, DCGM_MAX_NUM_DEVICES> m_gpuMemoryPools {}; /* Pool of each GPU's NUMA
+                                                                                   node by gpuId. nullptr =
+                                                                                   the default heap */
+
+    /* Cache memory accounting and budget. Protected by m_mutex */
+    dcgmcm_cache_memory_stats_t m_cacheMemoryStats {};
+    bool m_cacheOverBudgetWarned = false; /* Have we warned that eviction can't get under the budget since
+                                             usage was last within it? */
+
+    dcgmcm_decimation_t m_defaultDecimation = DcgmcmDecimateLast; /* Decimation of new watchers' views */
+
+    /* Latest-value slot of every watch by watch key. Inserts are under m_mutex. Reads don't lock */
+    DcgmLatestValueIndex m_latestValueIndex;
+
     DcgmCacheManagerEventThread *m_eventThread; /* Thread for reading NVML events */
 
     bool m_haveAnyLiveSubscribers; /* Has any watch registered to receive live updates? */
@@ -1728,6 +1989,37 @@ private:
      */
     dcgmReturn_t AllocWatchInfoTimeSeries(dcgmcm_watch_info_p watchInfo, int tsType);
 
+    /*************************************************************************/
+    /*
+     * Create a memory pool for the NUMA node of each GPU from the GPUs' CPU affinity.
+     * This does nothing unless DCGM_CACHE_HUGEPAGES_ENV_VAR is set.
+     */
+    void InitMemoryPools();
+
+    /*************************************************************************/
+    /*
+     * Get the pool that a watch's samples should be stored in. Entities below a GPU
+     * use their GPU's pool.
+     *
+     * Returns: The pool
+     *          nullptr if the samples belong on the default heap
+     */
+    DcgmCacheMemoryPool *GetSampleMemoryPool(dcgmcm_watch_info_p watchInfo);
+
+    /*************************************************************************/
+    /*
+     * Update watchInfo->cacheBytes and the cache memory in use after its
+     * timeSeries changed. m_mutex must be held.
+     */
+    void UpdateWatchInfoCacheBytes(dcgmcm_watch_info_p watchInfo);
+
+    /*************************************************************************/
+    /*
+     * Evict samples if the cache is over its memory budget. See
+     * SetCacheMemoryBudget(). m_mutex must be held.
+     */
+    void EnforceCacheMemoryBudget();
+
     /*************************************************************************/
     /*
      * Add a watcher on a field or update the existing watcher if newWatcher is
@@ -1769,14 +2061,66 @@ private:
 
     /*************************************************************************/
     /*
-     * Update the update update frequency and quota based on the minimum values
-     * from all of our watchers
+     * Update the update frequency from the minimum interval of all of our
+     * watchers. Client watchers that are slow enough get a decimated view and
+     * the quota comes from the maximum age of the rest.
      *
      * NOTE: This function assumes the cache manager is already locked so that
      *       watchInfo is safe to modify
      */
     dcgmReturn_t UpdateWatchFromWatchers(dcgmcm_watch_info_p watchInfo);
 
+    /*************************************************************************/
+    /*
+     * Add, reset or remove the decimated views of watchInfo to match
+     * viewWatchers. New views are filled from the samples already cached.
+     * m_mutex must be held.
+     */
+    void UpdateWatcherViews(dcgmcm_watch_info_p watchInfo,
+                            std::vector<dcgm_watch_watcher_info_t const *> const &viewWatchers);
+
+    /*************************************************************************/
+    /*
+     * Add a sample that was just cached in watchInfo->timeSeries to the
+     * decimated views of watchInfo. m_mutex must be held.
+     */
+    void AppendToWatcherViews(dcgmcm_watch_info_p watchInfo,
+                              int tsType,
+                              timelib64_t timestamp,
+                              long long valueInt64,
+                              double valueDouble);
+
+    /*************************************************************************/
+    /*
+     * Publish the newest sample of watchInfo->timeSeries to watchInfo->latestValue,
+     * or empty the slot if there isn't an int64 or double sample to publish.
+     * m_mutex must be held.
+     */
+    void PublishLatestValue(dcgmcm_watch_info_p watchInfo);
+
+    /*************************************************************************/
+    /*
+     * Try to read the latest sample of a watch from its latest-value slot
+     * without m_mutex. Writes the sample to sample and/or fvBuffer like
+     * GetLatestSample().
+     *
+     * Returns true if the sample was read from the slot
+     *         false if the caller needs to read it with m_mutex held
+     */
+    bool GetLatestSampleFromSlot(dcgm_field_entity_group_t watchEntityGroupId,
+                                 dcgm_field_entity_group_t entityGroupId,
+                                 dcgm_field_eid_t entityId,
+                                 unsigned short fieldId,
+                                 dcgmcm_sample_p sample,
+                                 DcgmFvBuffer *fvBuffer);
+
+    /*************************************************************************/
+    /*
+     * Returns the decimated view of watchInfo that belongs to watcher, or
+     * nullptr if it doesn't have one. m_mutex must be held.
+     */
+    static dcgmcm_watcher_view_t *GetWatcherView(dcgmcm_watch_info_p watchInfo, DcgmWatcher const &watcher);
+
     /*************************************************************************/
     /*
      * Tell the cache manager to update its NvLink link state for a given gpuId
@@ -1912,6 +2256,27 @@ private:
                                      bool updateOnFirstWatch,
                                      bool &wereFirstWatcher);
 
+    /*************************************************************************/
+    /*
+     * Helper method to build the watcher table entry of a new watch
+     */
+    dcgm_watch_watcher_info_t MakeWatcherInfo(DcgmWatcher const &watcher,
+                                              timelib64_t monitorIntervalUsec,
+                                              double maxSampleAge,
+                                              int maxKeepSamples,
+                                              bool subscribeForUpdates);
+
+    /*************************************************************************/
+    /*
+     * Helper method to add or update newWatcher in an entity watch and mark the
+     * watch as watched.
+     *
+     * NOTE: This function assumes m_mutex is held
+     *
+     * Returns whether the watch has never been queried (we were the first watcher)
+     */
+    bool AttachEntityWatcher(dcgmcm_watch_info_p watchInfo, dcgm_watch_watcher_info_t &newWatcher);
+
     /*************************************************************************/
     /*
      * Helper method to remove device field watches
@@ -2029,6 +2394,12 @@ private:
      */
     timelib64_t DoOneUpdateAllFields(void);
 
+    /*
+     * Task queued by UpdateAllFields(). Runs an update cycle unless another cycle
+     * already completed cycle targetCycleId
+     */
+    timelib64_t RunForcedUpdate(long long targetCycleId);
+
     /*************************************************************************/
     /*
      * The part of run() that actually does work. This exists so that all
@@ -2044,8 +2415,12 @@ private:
      *
      * NOTE: This function assumes it is inside of a Lock() / Unlock() pair.
      *
+     * deferEvents   OUT: Optional. If provided, fields that need NVML events set this
+     *                    to true instead of calling ManageDeviceEvents(). The caller
+     *                    must then call ManageDeviceEvents() once it's done
+     *
      */
-    dcgmReturn_t NvmlPreWatch(unsigned int gpuId, unsigned short dcgmFieldId);
+    dcgmReturn_t NvmlPreWatch(unsigned int gpuId, unsigned short dcgmFieldId, bool *deferEvents = nullptr);
     dcgmReturn_t NvmlPostWatch(unsigned int gpuId, unsigned short dcgmFieldId);
 
     /*************************************************************************/
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmCacheMemoryPool.h"
+
+#include <DcgmLogging.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <linux/mempolicy.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*****************************************************************************/
+DcgmCacheMemoryPool::DcgmCacheMemoryPool(int numaNode, int hugePages, size_t blockSize)
+    : m_numaNode(numaNode)
+    , m_hugePages(hugePages)
+    , m_blockSize(blockSize)
+    , m_kvAllocator { KvAllocCB, KvFreeCB, this }
+{}
+
+/*****************************************************************************/
+DcgmCacheMemoryPool::~DcgmCacheMemoryPool()
+{
+    for (auto const &[chunk, chunkInfo] : m_chunks)
+    {
+        munmap((void *)chunk, DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE);
+    }
+}
+
+/*****************************************************************************/
+void *DcgmCacheMemoryPool::MapChunk()
+{
+    void *chunk = MAP_FAILED;
+
+    if (m_hugePages == DCGM_CM_HUGEPAGES_EXPLICIT)
+    {
+        /* Hugetlbfs mappings are always aligned to the hugepage size */
+        chunk = mmap(nullptr,
+                     DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                     -1,
+                     0);
+        if (chunk == MAP_FAILED && m_chunks.empty())
+        {
+            log_warning("No explicit hugepages are available for the cache pool of NUMA node {}. errno {}. "
+                        "Using transparent hugepages.",
+                        m_numaNode,
+                        errno);
+        }
+    }
+
+    if (chunk == MAP_FAILED)
+    {
+        /* Over-map so the chunk can be aligned to where a hugepage can back it */
+        size_t const mapSize = 2 * DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE;
+        char *mapped = (char *)mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED)
+        {
+            log_error("mmap of {} bytes for the cache pool of NUMA node {} failed with errno {}",
+                      mapSize,
+                      m_numaNode,
+                      errno);
+            return nullptr;
+        }
+
+        std::uintptr_t const aligned = ((std::uintptr_t)mapped + DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE - 1)
+                                       & ~(std::uintptr_t)(DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE - 1);
+        size_t const head = aligned - (std::uintptr_t)mapped;
+        if (head > 0)
+        {
+            munmap(mapped, head);
+        }
+        munmap((void *)(aligned + DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE), DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE - head);
+
+        chunk = (void *)aligned;
+        if (m_hugePages != DCGM_CM_HUGEPAGES_NONE)
+        {
+            madvise(chunk, DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE, MADV_HUGEPAGE);
+        }
+    }
+
+    /* Nothing has touched the chunk yet, so all of its pages will be faulted in on the node */
+    if (m_numaNode >= 0 && m_numaNode < (int)(sizeof(unsigned long) * 8))
+    {
+        unsigned long nodeMask = 1UL << m_numaNode;
+        long const st = syscall(
+            SYS_mbind, chunk, DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE, MPOL_PREFERRED, &nodeMask, sizeof(nodeMask) * 8, 0);
+        if (st != 0)
+        {
+            log_debug("mbind to NUMA node {} failed with errno {}", m_numaNode, errno);
+        }
+    }
+
+    m_chunks.try_emplace((std::uintptr_t)chunk);
+    m_stats.bytesReserved += DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE;
+    return chunk;
+}
+
+/*****************************************************************************/
+void *DcgmCacheMemoryPool::Allocate(size_t size)
+{
+    if (size == m_blockSize && m_blockSize <= DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        void *block          = nullptr;
+        std::uintptr_t chunk = 0;
+        if (!m_chunksWithFreeBlocks.empty())
+        {
+            /* Fill the lowest chunks first so the higher ones get a chance to drain and be unmapped */
+            chunk            = *m_chunksWithFreeBlocks.begin();
+            Chunk &chunkInfo = m_chunks[chunk];
+            block            = chunkInfo.freeBlocks.back();
+            chunkInfo.freeBlocks.pop_back();
+            if (chunkInfo.freeBlocks.empty())
+            {
+                m_chunksWithFreeBlocks.erase(chunk);
+            }
+        }
+        else
+        {
+            if (m_nextBlock == nullptr || m_nextBlock + m_blockSize > m_chunkEnd)
+            {
+                char *newChunk = (char *)MapChunk();
+                if (newChunk != nullptr)
+                {
+                    m_nextBlock = newChunk;
+                    m_chunkEnd  = newChunk + DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE;
+                }
+            }
+
+            if (m_nextBlock != nullptr && m_nextBlock + m_blockSize <= m_chunkEnd)
+            {
+                block = m_nextBlock;
+                chunk = (std::uintptr_t)(m_chunkEnd - DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE);
+                m_nextBlock += m_blockSize;
+            }
+        }
+
+        if (block != nullptr)
+        {
+            m_chunks[chunk].blocksInUse++;
+            m_stats.bytesInUse += m_blockSize;
+            return block;
+        }
+
+        m_stats.heapFallbacks++;
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.heapFallbacks++;
+    }
+
+    return malloc(size);
+}
+
+/*****************************************************************************/
+void DcgmCacheMemoryPool::Free(void *ptr, size_t size)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    if (size == m_blockSize)
+    {
+        std::uintptr_t const chunk
+            = (std::uintptr_t)ptr & ~(std::uintptr_t)(DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE - 1);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto chunkIt = m_chunks.find(chunk); chunkIt != m_chunks.end())
+        {
+            chunkIt->second.freeBlocks.push_back(ptr);
+            chunkIt->second.blocksInUse--;
+            m_chunksWithFreeBlocks.insert(chunk);
+            m_stats.bytesInUse -= m_blockSize;
+            ReleaseChunkIfUnused(chunkIt);
+            return;
+        }
+    }
+
+    /* This came from the heap when the pool couldn't serve it */
+    free(ptr);
+}
+
+/*****************************************************************************/
+void DcgmCacheMemoryPool::ReleaseChunkIfUnused(std::map<std::uintptr_t, Chunk>::iterator chunkIt)
+{
+    std::uintptr_t const chunk = chunkIt->first;
+    if (chunkIt->second.blocksInUse > 0 || (char *)chunk + DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE == m_chunkEnd)
+    {
+        return;
+    }
+
+    /* Every block of the chunk is on its free list, so nothing points into it anymore */
+    m_chunksWithFreeBlocks.erase(chunk);
+    m_chunks.erase(chunkIt);
+    munmap((void *)chunk, DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE);
+    m_stats.bytesReserved -= DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE;
+    m_stats.chunksUnmapped++;
+}
+
+/*****************************************************************************/
+DcgmCacheMemoryPool::Stats DcgmCacheMemoryPool::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+/*****************************************************************************/
+void *DcgmCacheMemoryPool::KvAllocCB(size_t size, void *user)
+{
+    return ((DcgmCacheMemoryPool *)user)->Allocate(size);
+}
+
+/*****************************************************************************/
+void DcgmCacheMemoryPool::KvFreeCB(void *block, size_t size, void *user)
+{
+    ((DcgmCacheMemoryPool *)user)->Free(block, size);
+}
+
+/*****************************************************************************/
+int DcgmCacheMemoryPool::GetNumaNodeOfCpu(unsigned int cpuId)
+{
+    /* Every CPU directory has a nodeN link to the node it is on */
+    std::error_code ec;
+    std::filesystem::directory_iterator it("/sys/devices/system/cpu/cpu" + std::to_string(cpuId), ec);
+    for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+    {
+        std::string const name = it->path().filename().string();
+        if (name.size() > 4 && name.starts_with("node")
+            && name.find_first_not_of("0123456789", 4) == std::string::npos)
+        {
+            return std::stoi(name.substr(4));
+        }
+    }
+
+    return -1;
+}
+
+/*****************************************************************************/
+int DcgmCacheMemoryPool::GetHugePagesFromEnv()
+{
+    char const *hugePagesEnvStr = getenv(DCGM_CACHE_HUGEPAGES_ENV_VAR);
+    if (hugePagesEnvStr == nullptr)
+    {
+        return DCGM_CM_HUGEPAGES_NONE;
+    }
+
+    int hugePages = atoi(hugePagesEnvStr);
+    if (hugePages < DCGM_CM_HUGEPAGES_NONE || hugePages > DCGM_CM_HUGEPAGES_EXPLICIT)
+    {
+        DCGM_LOG_ERROR << "Ignoring invalid " << DCGM_CACHE_HUGEPAGES_ENV_VAR << " value \"" << hugePagesEnvStr << "\"";
+        return DCGM_CM_HUGEPAGES_NONE;
+    }
+
+    return hugePages;
+}
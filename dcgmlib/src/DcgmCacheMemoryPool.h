@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_structs_internal.h"
+#include "keyedvector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+/* Environment variable that places the cache manager's samples in per-NUMA node pools.
+   Set it to one of the DCGM_CM_HUGEPAGES_? values. Unset or 0 uses the default heap */
+#define DCGM_CACHE_HUGEPAGES_ENV_VAR "__DCGM_CACHE_HUGEPAGES"
+
+/* Size of the chunks that pools map at a time. This is the size of an x86_64 and aarch64 hugepage */
+#define DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE (2 * 1024 * 1024)
+
+/*****************************************************************************
+ * Pool of fixed-size blocks for cached samples, placed on one NUMA node.
+ *
+ * Blocks are carved out of chunks of DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE that are
+ * mapped with transparent or explicit hugepages and bound to the pool's NUMA
+ * node before they are touched. Freed blocks are reused, lowest chunk first, and
+ * a chunk whose blocks have all been freed is unmapped. The newest chunk is kept
+ * so a pool that shrinks to nothing doesn't have to map it again right away.
+ * Requests for any other size than the pool's block size are served from the
+ * default heap.
+ *
+ * This is thread safe.
+ *****************************************************************************/
+class DcgmCacheMemoryPool
+{
+public:
+    struct Stats
+    {
+        long long bytesReserved  = 0; /* Bytes mapped for chunks */
+        long long bytesInUse     = 0; /* Bytes of the chunks that are handed out */
+        long long heapFallbacks  = 0; /* Allocations that were served from the default heap */
+        long long chunksUnmapped = 0; /* Chunks unmapped once all of their blocks were freed */
+    };
+
+    /*************************************************************************/
+    /*
+     * numaNode  IN: NUMA node to place the pool on. -1=don't bind the pool to a node
+     * hugePages IN: DCGM_CM_HUGEPAGES_? mode to map chunks with
+     * blockSize IN: Size of the blocks that are served from the pool
+     */
+    DcgmCacheMemoryPool(int numaNode, int hugePages, size_t blockSize);
+    ~DcgmCacheMemoryPool();
+
+    DcgmCacheMemoryPool(DcgmCacheMemoryPool const &)            = delete;
+    DcgmCacheMemoryPool &operator=(DcgmCacheMemoryPool const &) = delete;
+
+    /*************************************************************************/
+    /* Allocate size bytes. Returns nullptr if out of memory */
+    void *Allocate(size_t size);
+
+    /*************************************************************************/
+    /* Free a block returned by Allocate(). size must match what was passed to Allocate() */
+    void Free(void *ptr, size_t size);
+
+    /*************************************************************************/
+    /* Get an allocator that can be passed to keyedvector_alloc_with_allocator() */
+    kv_allocator_t const *GetKvAllocator() const
+    {
+        return &m_kvAllocator;
+    }
+
+    /*************************************************************************/
+    Stats GetStats();
+
+    int GetNumaNode() const
+    {
+        return m_numaNode;
+    }
+
+    int GetHugePages() const
+    {
+        return m_hugePages;
+    }
+
+    /*************************************************************************/
+    /* Get the NUMA node that a CPU belongs to from sysfs. Returns -1 if it is unknown */
+    static int GetNumaNodeOfCpu(unsigned int cpuId);
+
+    /*************************************************************************/
+    /* Read DCGM_CACHE_HUGEPAGES_ENV_VAR. Returns DCGM_CM_HUGEPAGES_NONE if pools are off */
+    static int GetHugePagesFromEnv();
+
+private:
+    /* Map and bind a new chunk. Returns nullptr if that fails. m_mutex must be held */
+    void *MapChunk();
+
+    static void *KvAllocCB(size_t size, void *user);
+    static void KvFreeCB(void *block, size_t size, void *user);
+
+    int const m_numaNode;
+    int const m_hugePages;
+    size_t const m_blockSize;
+    kv_allocator_t m_kvAllocator;
+
+    struct Chunk
+    {
+        std::vector<void *> freeBlocks; /* Blocks of this chunk that were freed and can be reused */
+        size_t blocksInUse = 0;         /* Blocks of this chunk that are handed out */
+    };
+
+    /* Unmap chunk if none of its blocks are in use and it isn't the newest one. m_mutex must be held */
+    void ReleaseChunkIfUnused(std::map<std::uintptr_t, Chunk>::iterator chunkIt);
+
+    std::mutex m_mutex;
+    std::map<std::uintptr_t, Chunk> m_chunks;        /* Mapped chunks by address, all aligned to the chunk size */
+    std::set<std::uintptr_t> m_chunksWithFreeBlocks; /* Chunks whose freeBlocks aren't empty */
+    char *m_nextBlock = nullptr;                     /* Next never-used block of the newest chunk */
+    char *m_chunkEnd  = nullptr;                     /* End of the newest chunk */
+    Stats m_stats;
+};
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmClientCache.h"
+
+#include <DcgmLogging.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+/*****************************************************************************/
+bool DcgmClientCache::IsEnabled()
+{
+    static bool const enabled = [] {
+        char const *value = getenv(DCGM_CLIENT_CACHE_ENV_VAR);
+        return value != nullptr && atoi(value) == 1;
+    }();
+
+    return enabled;
+}
+
+/*****************************************************************************/
+bool DcgmClientCache::CanCacheLatestValues(unsigned int flags)
+{
+    return (flags & DCGM_FV_FLAG_LIVE_DATA) == 0;
+}
+
+/*****************************************************************************/
+bool DcgmClientCache::BeginSubscribe(dcgmHandle_t handle)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    HandleCache &handleCache = m_handles[handle];
+    if (handleCache.state != SubscribeState::NotSubscribed)
+    {
+        return false;
+    }
+
+    handleCache.state = SubscribeState::Subscribing;
+    return true;
+}
+
+/*****************************************************************************/
+void DcgmClientCache::EndSubscribe(dcgmHandle_t handle, bool subscribed, Generations generations)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_handles.find(handle);
+    if (it == m_handles.end() || it->second.state != SubscribeState::Subscribing)
+    {
+        /* The handle was removed while we were subscribing */
+        return;
+    }
+
+    HandleCache &handleCache = it->second;
+    if (!subscribed)
+    {
+        handleCache.state = SubscribeState::Unsupported;
+        return;
+    }
+
+    handleCache.state = SubscribeState::Subscribed;
+
+    /* Notifications may have beaten the subscription response here */
+    handleCache.generations.config = std::max(handleCache.generations.config, generations.config);
+    handleCache.generations.values = std::max(handleCache.generations.values, generations.values);
+}
+
+/*****************************************************************************/
+std::optional<DcgmClientCache::Generations> DcgmClientCache::GetGenerations(dcgmHandle_t handle)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_handles.find(handle);
+    if (it == m_handles.end() || it->second.state != SubscribeState::Subscribed)
+    {
+        return std::nullopt;
+    }
+
+    return it->second.generations;
+}
+
+/*****************************************************************************/
+void DcgmClientCache::UpdateGenerations(dcgmHandle_t handle, Generations generations)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_handles.find(handle);
+    if (it == m_handles.end())
+    {
+        return;
+    }
+
+    /* Notifications can be sent from more than one hostengine thread, so they may arrive out of order */
+    HandleCache &handleCache       = it->second;
+    handleCache.generations.config = std::max(handleCache.generations.config, generations.config);
+    handleCache.generations.values = std::max(handleCache.generations.values, generations.values);
+}
+
+/*****************************************************************************/
+bool DcgmClientCache::IsValid(Entry const &entry, Scope scope, Generations const &current)
+{
+    if (entry.generations.config != current.config)
+    {
+        return false;
+    }
+
+    return scope == Scope::Config || entry.generations.values == current.values;
+}
+
+/*****************************************************************************/
+bool DcgmClientCache::Lookup(dcgmHandle_t handle,
+                             std::string const &key,
+                             Scope scope,
+                             Generations const &current,
+                             std::string &response)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto handleIt = m_handles.find(handle);
+    if (handleIt == m_handles.end())
+    {
+        return false;
+    }
+
+    auto entryIt = handleIt->second.entries.find(key);
+    if (entryIt == handleIt->second.entries.end() || !IsValid(entryIt->second, scope, current))
+    {
+        return false;
+    }
+
+    response = entryIt->second.response;
+    return true;
+}
+
+/*****************************************************************************/
+void DcgmClientCache::Store(dcgmHandle_t handle,
+                            std::string const &key,
+                            Scope scope,
+                            Generations const &fetchedAt,
+                            std::string response)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    HandleCache &handleCache = m_handles[handle];
+
+    /* The values generation moves with every change, so it orders fetches */
+    if (fetchedAt.values < handleCache.prunedAt.values)
+    {
+        /* Something changed while this request was in flight */
+        return;
+    }
+
+    /* Drop the entries that can't be served anymore once the generations move, so
+       the cache only grows with the number of distinct requests between changes */
+    if (fetchedAt.values > handleCache.prunedAt.values)
+    {
+        std::erase_if(handleCache.entries,
+                      [&fetchedAt](auto const &item) { return !IsValid(item.second, item.second.scope, fetchedAt); });
+        handleCache.prunedAt = fetchedAt;
+    }
+
+    handleCache.entries[key] = Entry { scope, fetchedAt, std::move(response) };
+}
+
+/*****************************************************************************/
+void DcgmClientCache::RemoveHandle(dcgmHandle_t handle)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_handles.erase(handle);
+}
+
+/*****************************************************************************/
+DcgmClientCacheRequest::DcgmClientCacheRequest(DcgmClientCache &cache, dcgmHandle_t handle)
+    : DcgmRequest(0)
+    , m_cache(cache)
+    , m_handle(handle)
+{}
+
+/*****************************************************************************/
+int DcgmClientCacheRequest::ProcessMessage(std::unique_ptr<DcgmMessage> msg)
+{
+    if (!msg)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    dcgm_message_header_t *header = msg->GetMessageHdr();
+    if (header->msgType != DCGM_MSG_CLIENT_CACHE_INVALIDATE)
+    {
+        log_error("Unexpected msgType {} received.", header->msgType);
+        return DCGM_ST_OK; /* Returning an error here doesn't affect anything we want to affect */
+    }
+
+    auto msgBytes = msg->GetMsgBytesPtr();
+    if (msgBytes->size() < sizeof(dcgm_msg_client_cache_invalidate_t))
+    {
+        log_error("Got a client cache invalidation of {} bytes. Expected {}",
+                  msgBytes->size(),
+                  sizeof(dcgm_msg_client_cache_invalidate_t));
+        return DCGM_ST_OK;
+    }
+
+    dcgm_msg_client_cache_invalidate_t invalidate;
+    memcpy(&invalidate, msgBytes->data(), sizeof(invalidate));
+
+    m_cache.UpdateGenerations(m_handle, { invalidate.configGeneration, invalidate.valuesGeneration });
+    return DCGM_ST_OK;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmRequest.h"
+#include "dcgm_structs.h"
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+/* Environment variable that turns on the client read-through cache when set to 1 */
+#define DCGM_CLIENT_CACHE_ENV_VAR "__DCGM_CLIENT_CACHE"
+
+/*****************************************************************************
+ * Opt-in read-through cache for read-only requests that libdcgm sends to a
+ * hostengine. Entries are keyed by (handle, request).
+ *
+ * The hostengine keeps two generation counters. The config generation moves when
+ * groups, field groups or the MIG hierarchy change. The values generation moves
+ * with every config change, every completed update cycle and every other change
+ * to field values like injections or watches. Remote clients hear about new
+ * generations through DCGM_MSG_CLIENT_CACHE_INVALIDATE notifications. Embedded
+ * clients read them straight from the hostengine.
+ *
+ * An entry is served only while the generations it was fetched under are
+ * still current, so repeated reads between two changes are answered locally.
+ *****************************************************************************/
+class DcgmClientCache
+{
+public:
+    /* What has to stay unchanged for an entry to be served */
+    enum class Scope
+    {
+        Config, /* Only the config generation */
+        Values, /* The config and values generations */
+    };
+
+    struct Generations
+    {
+        long long config = 0;
+        long long values = 0;
+    };
+
+    /*************************************************************************/
+    /* Is the cache turned on for this process? See DCGM_CLIENT_CACHE_ENV_VAR */
+    static bool IsEnabled();
+
+    /*************************************************************************/
+    /* Can a latest-values request with these DCGM_FV_FLAG_? flags be answered from the cache?
+       Live data has to be read from the driver, so it never can */
+    static bool CanCacheLatestValues(unsigned int flags);
+
+    /*************************************************************************/
+    /* Append the raw bytes of count values to a cache key */
+    template <typename T>
+    static void AppendToKey(std::string &key, T const *values, size_t count = 1)
+    {
+        key.append(reinterpret_cast<char const *>(values), sizeof(T) * count);
+    }
+
+    /*************************************************************************/
+    /*
+     * Claim the subscription of a remote handle. Returns true if the caller should
+     * subscribe and then call EndSubscribe(). Returns false if the handle is already
+     * subscribed, is being subscribed by another thread or can't be subscribed.
+     */
+    bool BeginSubscribe(dcgmHandle_t handle);
+
+    /*************************************************************************/
+    /* Finish a subscription claimed with BeginSubscribe() */
+    void EndSubscribe(dcgmHandle_t handle, bool subscribed, Generations generations);
+
+    /*************************************************************************/
+    /* Get the latest generations of a subscribed remote handle, or nullopt if it isn't subscribed */
+    std::optional<Generations> GetGenerations(dcgmHandle_t handle);
+
+    /*************************************************************************/
+    /* Record generations pushed by the hostengine. Older generations than we have are ignored */
+    void UpdateGenerations(dcgmHandle_t handle, Generations generations);
+
+    /*************************************************************************/
+    /*
+     * Look up a cached response
+     *
+     * current IN: The handle's current generations
+     *
+     * Returns true and sets response if an entry that is still valid for scope was found
+     */
+    bool Lookup(dcgmHandle_t handle,
+                std::string const &key,
+                Scope scope,
+                Generations const &current,
+                std::string &response);
+
+    /*************************************************************************/
+    /*
+     * Cache a response
+     *
+     * fetchedAt IN: The handle's generations from before the request was sent
+     */
+    void Store(dcgmHandle_t handle,
+               std::string const &key,
+               Scope scope,
+               Generations const &fetchedAt,
+               std::string response);
+
+    /*************************************************************************/
+    /* Forget everything about a handle. Call this when it is disconnected */
+    void RemoveHandle(dcgmHandle_t handle);
+
+private:
+    enum class SubscribeState
+    {
+        NotSubscribed,
+        Subscribing,
+        Subscribed,
+        Unsupported, /* The hostengine doesn't know about client caches */
+    };
+
+    struct Entry
+    {
+        Scope scope;
+        Generations generations;
+        std::string response;
+    };
+
+    struct HandleCache
+    {
+        SubscribeState state = SubscribeState::NotSubscribed;
+        Generations generations;
+        Generations prunedAt;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    static bool IsValid(Entry const &entry, Scope scope, Generations const &current);
+
+    std::mutex m_mutex;
+    std::unordered_map<dcgmHandle_t, HandleCache> m_handles;
+};
+
+/*****************************************************************************
+ * Request that receives DCGM_MSG_CLIENT_CACHE_INVALIDATE notifications for a
+ * remote handle and passes them on to its DcgmClientCache
+ *****************************************************************************/
+class DcgmClientCacheRequest : public DcgmRequest
+{
+public:
+    DcgmClientCacheRequest(DcgmClientCache &cache, dcgmHandle_t handle);
+    int ProcessMessage(std::unique_ptr<DcgmMessage> msg) override;
+
+private:
+    DcgmClientCache &m_cache;
+    dcgmHandle_t m_handle;
+};
@@ -20,6 +20,7 @@
 #include "DcgmProtocol.h"
 #include "DcgmRequest.h"
 #include "DcgmSettings.h"
+#include "DcgmWireEncoding.h"
 #include "dcgm_util.h"
 #include "timelib.h"
 #include <DcgmIpc.h>
@@ -406,10 +407,19 @@ dcgmReturn_t DcgmClientHandler::ExchangeModuleCommandAsync(dcgmHandle_t dcgmHand
     auto requestFut = AddBlockingRequest(connectionId, requestId);
 
     /* Update Encoded Message with a header to be sent over socket */
-    dcgmSendMsg->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND, requestId, DCGM_ST_OK, moduleCommand->length);
     auto msgData = dcgmSendMsg->GetMsgBytesPtr();
-    msgData->resize(moduleCommand->length);
-    memcpy(msgData->data(), moduleCommand, moduleCommand->length);
+    if (moduleCommand->length >= DCGM_WIRE_ENCODING_MIN_LENGTH
+        && (GetWireEncodings(connectionId) & DCGM_WIRE_ENCODING_MASK_COMPACT))
+    {
+        DcgmWireEncodeCompact(moduleCommand, moduleCommand->length, sizeof(*moduleCommand), *msgData);
+        dcgmSendMsg->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND_COMPACT, requestId, DCGM_ST_OK, msgData->size());
+    }
+    else
+    {
+        dcgmSendMsg->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND, requestId, DCGM_ST_OK, moduleCommand->length);
+        msgData->resize(moduleCommand->length);
+        memcpy(msgData->data(), moduleCommand, moduleCommand->length);
+    }
 
     if (request != nullptr)
     {
@@ -449,6 +459,29 @@ dcgmReturn_t DcgmClientHandler::ExchangeModuleCommandAsync(dcgmHandle_t dcgmHand
     DCGM_LOG_DEBUG << "Request Wait completed for connectionId " << connectionId << " request ID: " << requestId;
 
     dcgm_message_header_t *recvHeader = response.response->GetMessageHdr();
+    auto msgBytes                     = response.response->GetMsgBytesPtr();
+
+    if (recvHeader->msgType == DCGM_MSG_MODULE_COMMAND_COMPACT)
+    {
+        /* Rebuild the fixed-size struct straight into the caller's buffer */
+        size_t decodedLength = 0;
+        dcgmReturn_t ret     = DcgmWireDecodeCompact(msgBytes->data(),
+                                                 recvHeader->length,
+                                                 sizeof(*moduleCommand),
+                                                 moduleCommand,
+                                                 maxResponseSize,
+                                                 decodedLength);
+        if (ret != DCGM_ST_OK)
+        {
+            DCGM_LOG_ERROR << "Unable to decode compact module command response of length " << recvHeader->length
+                           << " into " << maxResponseSize << " bytes: " << errorString(ret);
+            return DCGM_ST_GENERIC_ERROR;
+        }
+
+        DCGM_LOG_DEBUG << "Got compact module command response of length " << recvHeader->length << " decoded to "
+                       << decodedLength;
+        return (dcgmReturn_t)recvHeader->status;
+    }
 
     if (recvHeader->msgType != DCGM_MSG_MODULE_COMMAND)
     {
@@ -463,7 +496,6 @@ dcgmReturn_t DcgmClientHandler::ExchangeModuleCommandAsync(dcgmHandle_t dcgmHand
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    auto msgBytes = response.response->GetMsgBytesPtr();
     memcpy(moduleCommand, msgBytes->data(), recvHeader->length);
 
     DCGM_LOG_DEBUG << "Got module command response of length " << recvHeader->length;
@@ -494,18 +526,63 @@ dcgmReturn_t DcgmClientHandler::PopulateConnectionAttributes(dcgmHandle_t dcgmHa
         return dcgmReturn;
     }
 
-    /* Don't lock until here. If we had the lock going into ExchangeModuleCommandAsync(), we could
-       never receive our message from the libevent processing thread */
-    DcgmLockGuard dlg(&m_mutex);
+    {
+        /* Don't lock until here. If we had the lock going into ExchangeModuleCommandAsync(), we could
+           never receive our message from the libevent processing thread */
+        DcgmLockGuard dlg(&m_mutex);
+
+        /* Returns pair of {iterator, wasInsertedBool} */
+        auto [attributesIt, wasInserted] = m_connectionAttributes.emplace(
+            connectionId, DCHConnectionAttributes(false, msg.version.rawBuildInfoString));
+
+        DCGM_LOG_DEBUG << "connectionId " << connectionId << " returned version "
+                       << attributesIt->second.m_buildInfo.GetVersion();
+    }
+
+    NegotiateWireEncoding(connectionId);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmClientHandler::NegotiateWireEncoding(dcgm_connection_id_t connectionId)
+{
+    dcgm_core_msg_negotiate_wire_encoding_t msg = {};
 
-    /* Returns pair of {iterator, wasInsertedBool} */
-    auto [attributesIt, wasInserted]
-        = m_connectionAttributes.emplace(connectionId, DCHConnectionAttributes(false, msg.version.rawBuildInfoString));
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_NEGOTIATE_WIRE_ENCODING;
+    msg.header.version    = dcgm_core_msg_negotiate_wire_encoding_version;
+    msg.encodings         = DCGM_WIRE_ENCODING_MASK_ALL;
 
-    DCGM_LOG_DEBUG << "connectionId " << connectionId << " returned version "
-                   << attributesIt->second.m_buildInfo.GetVersion();
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn = ExchangeModuleCommandAsync(connectionId, &msg.header, nullptr, sizeof(msg));
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        /* Older hostengines return DCGM_ST_FUNCTION_NOT_FOUND. They only take verbatim module commands */
+        DCGM_LOG_DEBUG << "ConnectionId " << connectionId << " didn't negotiate a wire encoding: "
+                       << errorString(dcgmReturn);
+        return dcgmReturn;
+    }
 
+    DcgmLockGuard dlg(&m_mutex);
+
+    auto attributesIt = m_connectionAttributes.find(connectionId);
+    if (attributesIt != m_connectionAttributes.end())
+    {
+        attributesIt->second.m_wireEncodings = msg.encodings & DCGM_WIRE_ENCODING_MASK_ALL;
+    }
+
+    DCGM_LOG_DEBUG << "connectionId " << connectionId << " negotiated wire encodings x" << std::hex << msg.encodings;
     return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
+unsigned int DcgmClientHandler::GetWireEncodings(dcgm_connection_id_t connectionId)
+{
+    DcgmLockGuard dlg(&m_mutex);
+
+    auto attributesIt = m_connectionAttributes.find(connectionId);
+    return attributesIt == m_connectionAttributes.end() ? 0 : attributesIt->second.m_wireEncodings;
+}
+
+/*****************************************************************************/
@@ -38,6 +38,7 @@ public:
     {}
 
     DcgmNs::DcgmBuildInfo m_buildInfo; /* Build info retrieved from the server */
+    unsigned int m_wireEncodings = 0;  /* DCGM_WIRE_ENCODING_MASK_? negotiated with the server */
 };
 
 class DcgmClientHandler
@@ -120,6 +121,19 @@ private:
      */
     dcgmReturn_t PopulateConnectionAttributes(dcgmHandle_t dcgmHandle);
 
+    /*************************************************************************/
+    /* Agree with the server on how module commands are encoded on the wire.
+     * Connections stay on verbatim module commands if this fails.
+     *
+     * Returns DCGM_ST_OK if OK
+     *         DCGM_ST_FUNCTION_NOT_FOUND if the server predates wire encodings
+     *         Other nonzero DCGM_ST_? on error.
+     */
+    dcgmReturn_t NegotiateWireEncoding(dcgm_connection_id_t connectionId);
+
+    /* Get the DCGM_WIRE_ENCODING_MASK_? negotiated for a connection */
+    unsigned int GetWireEncodings(dcgm_connection_id_t connectionId);
+
     /*************************************************************************/
 
     /* Get the next request ID to use for a client request */
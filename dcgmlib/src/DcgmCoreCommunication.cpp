@@ -336,6 +336,54 @@ dcgmReturn_t DcgmCoreCommunication::ProcessGetSamples(dcgm_module_command_header
     return DCGM_ST_OK;
 }
 
+dcgmReturn_t DcgmCoreCommunication::ProcessGetSamplesBatch(dcgm_module_command_header_t *header)
+{
+    dcgmCoreGetSamplesBatch_t gsb;
+
+    if (header == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    dcgmReturn_t ret = DcgmModule::CheckVersion(header, dcgmCoreGetSamplesBatch_version);
+
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    memcpy(&gsb, header, sizeof(gsb));
+
+    if (gsb.request.numRequests > 0 && (gsb.request.requests == nullptr || gsb.response.results == nullptr))
+    {
+        gsb.response.ret = DCGM_ST_BADPARAM;
+        memcpy(header, &gsb, sizeof(gsb));
+        return DCGM_ST_OK;
+    }
+
+    gsb.response.ret = DCGM_ST_OK;
+    for (unsigned int i = 0; i < gsb.request.numRequests; i++)
+    {
+        dcgmCoreGetSamplesParams_t const &request = gsb.request.requests[i];
+        dcgmCoreGetSamplesResult_t &result        = gsb.response.results[i];
+
+        result.numSamples = request.maxSamples;
+        result.ret        = m_cacheManagerPtr->GetSamples(request.entityGroupId,
+                                                   request.entityId,
+                                                   request.fieldId,
+                                                   result.samples,
+                                                   &result.numSamples,
+                                                   request.startTime,
+                                                   request.endTime,
+                                                   request.order,
+                                                   nullptr);
+    }
+
+    memcpy(header, &gsb, sizeof(gsb));
+
+    return DCGM_ST_OK;
+}
+
 dcgmReturn_t DcgmCoreCommunication::ProcessGpuIdToNvmlIndex(dcgm_module_command_header_t *header)
 {
     dcgmCoreBasicQuery_t br;
@@ -666,22 +714,15 @@ dcgmReturn_t DcgmCoreCommunication::ProcessGetGroupEntities(dcgm_module_command_
     std::vector<dcgmGroupEntityPair_t> entities;
     gge.response.ret = m_groupManagerPtr->GetGroupEntities(gge.request.groupId, entities);
 
-    if (entities.size() > DCGM_GROUP_MAX_ENTITIES)
-    {
-        DCGM_LOG_ERROR << fmt::format("Too many entities in the group {}. Provided {}, supported up to {}",
-                                      gge.request.groupId,
-                                      entities.size(),
-                                      DCGM_GROUP_MAX_ENTITIES);
-        return DCGM_ST_MAX_LIMIT;
-    }
-
-    for (size_t i = 0; i < entities.size(); i++)
+    /* Groups can be larger than the response. The proxy pages through them */
+    gge.totalEntityPairs          = entities.size();
+    gge.response.entityPairsCount = 0;
+    for (size_t i = gge.startIndex; i < entities.size() && gge.response.entityPairsCount < DCGM_GROUP_MAX_ENTITIES;
+         i++)
     {
-        gge.response.entityPairs[i] = entities[i];
+        gge.response.entityPairs[gge.response.entityPairsCount++] = entities[i];
     }
 
-    gge.response.entityPairsCount = entities.size();
-
     memcpy(header, &gge, sizeof(gge));
 
     return DCGM_ST_OK;
@@ -1086,6 +1127,29 @@ dcgmReturn_t DcgmCoreCommunication::ProcessGetServiceAccount(dcgm_module_command
     return DCGM_ST_OK;
 }
 
+dcgmReturn_t DcgmCoreCommunication::ProcessGetIpcQueueWait(dcgm_module_command_header_t *header)
+{
+    dcgmCoreGetIpcQueueWait_v1 query = {};
+    if (header == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (auto const ret = DcgmModule::CheckVersion(header, dcgmCoreGetIpcQueueWait_version1); ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    memcpy(&query, header, sizeof(query));
+
+    query.response.queueWait.version = dcgmIntrospectQueueWait_version1;
+    query.response.ret              = DcgmHostEngineHandler::Instance()->GetIpcQueueWait(&query.response.queueWait);
+
+    memcpy(header, &query, sizeof(query));
+
+    return DCGM_ST_OK;
+}
+
 dcgmReturn_t DcgmCoreCommunication::ProcessRequestInCore(dcgm_module_command_header_t *header)
 {
     dcgmReturn_t ret = DCGM_ST_OK;
@@ -1150,6 +1214,12 @@ dcgmReturn_t DcgmCoreCommunication::ProcessRequestInCore(dcgm_module_command_hea
             break;
         }
 
+        case DcgmCoreReqIdCMGetSamplesBatch:
+        {
+            ret = ProcessGetSamplesBatch(header);
+            break;
+        }
+
         case DcgmCoreReqIdCMGpuIdToNvmlIndex:
         {
             ret = ProcessGpuIdToNvmlIndex(header);
@@ -1282,6 +1352,12 @@ dcgmReturn_t DcgmCoreCommunication::ProcessRequestInCore(dcgm_module_command_hea
             break;
         }
 
+        case DcgmCoreReqGetIpcQueueWait:
+        {
+            ret = ProcessGetIpcQueueWait(header);
+            break;
+        }
+
         default:
             DCGM_LOG_DEBUG << "Unhandled sub command " << header->subCommand << " received and ignored.";
             break;
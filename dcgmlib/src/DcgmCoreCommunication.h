@@ -83,6 +83,7 @@ private:
     dcgmReturn_t ProcessGetLatestSample(dcgm_module_command_header_t *header);
     dcgmReturn_t ProcessGetEntityNvLinkLinkStatus(dcgm_module_command_header_t *header);
     dcgmReturn_t ProcessGetSamples(dcgm_module_command_header_t *header);
+    dcgmReturn_t ProcessGetSamplesBatch(dcgm_module_command_header_t *header);
     dcgmReturn_t ProcessGpuIdToNvmlIndex(dcgm_module_command_header_t *header);
 
     /*
@@ -113,6 +114,7 @@ private:
     dcgmReturn_t ProcessGetMigUtilization(dcgm_module_command_header_t *header);
     dcgmReturn_t ProcessGetMigIndicesForEntity(dcgm_module_command_header_t *header);
     dcgmReturn_t ProcessGetServiceAccount(dcgm_module_command_header_t *header);
+    dcgmReturn_t ProcessGetIpcQueueWait(dcgm_module_command_header_t *header);
 };
 
 #endif
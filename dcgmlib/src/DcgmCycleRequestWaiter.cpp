@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmCycleRequestWaiter.h"
+
+#include <DcgmLogging.h>
+
+#include <algorithm>
+#include <utility>
+
+/* Longest the thread sleeps without anything to do before it checks whether it should stop */
+#define DCGM_CYCLE_WAITER_IDLE_MS 1000
+
+/*****************************************************************************/
+DcgmCycleRequestWaiter::DcgmCycleRequestWaiter()
+    : DcgmThread(false, "dcgm_cycle_wait")
+{}
+
+/*****************************************************************************/
+DcgmCycleRequestWaiter::~DcgmCycleRequestWaiter()
+{
+    try
+    {
+        if (StopAndWait(2 * DCGM_CYCLE_WAITER_IDLE_MS) != 0)
+        {
+            DCGM_LOG_ERROR << "Cycle request waiter thread didn't stop. Killing it.";
+            Kill();
+        }
+    }
+    catch (std::exception const &ex)
+    {
+        DCGM_LOG_ERROR << "Exception caught in ~DcgmCycleRequestWaiter(): " << ex.what();
+    }
+}
+
+/*****************************************************************************/
+void DcgmCycleRequestWaiter::Park(long long lastSeenCycleId,
+                                  long long lastCompletedCycleId,
+                                  unsigned int timeoutMs,
+                                  std::function<void()> complete)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    /* A cycle may have completed after the caller checked, but before it told us about it */
+    m_lastCycleId = std::max(m_lastCycleId, lastCompletedCycleId);
+    m_parked.push_back(ParkedRequest { lastSeenCycleId,
+                                       std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs),
+                                       std::move(complete) });
+    m_wakeUp = true;
+    m_condition.notify_one();
+}
+
+/*****************************************************************************/
+void DcgmCycleRequestWaiter::OnUpdateCycle(long long cycleId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_lastCycleId = std::max(m_lastCycleId, cycleId);
+    m_wakeUp      = true;
+    m_condition.notify_one();
+}
+
+/*****************************************************************************/
+size_t DcgmCycleRequestWaiter::GetNumParked()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_parked.size();
+}
+
+/*****************************************************************************/
+void DcgmCycleRequestWaiter::OnStop()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wakeUp = true;
+    m_condition.notify_one();
+}
+
+/*****************************************************************************/
+void DcgmCycleRequestWaiter::run()
+{
+    while (!ShouldStop())
+    {
+        std::vector<std::function<void()>> ready;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            auto wakeTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(DCGM_CYCLE_WAITER_IDLE_MS);
+            for (auto const &parked : m_parked)
+            {
+                wakeTime = std::min(wakeTime, parked.deadline);
+            }
+
+            m_condition.wait_until(lock, wakeTime, [this] { return m_wakeUp; });
+            m_wakeUp = false;
+
+            auto const now = std::chrono::steady_clock::now();
+            auto it        = std::partition(m_parked.begin(), m_parked.end(), [this, now](ParkedRequest const &parked) {
+                return parked.lastSeenCycleId >= m_lastCycleId && parked.deadline > now;
+            });
+
+            for (auto readyIt = it; readyIt != m_parked.end(); ++readyIt)
+            {
+                ready.push_back(std::move(readyIt->complete));
+            }
+            m_parked.erase(it, m_parked.end());
+        }
+
+        /* Complete outside of the lock so new requests can be parked meanwhile */
+        for (auto &complete : ready)
+        {
+            complete();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_parked.empty())
+    {
+        DCGM_LOG_DEBUG << "Dropping " << m_parked.size() << " parked requests on shutdown.";
+        m_parked.clear();
+    }
+}
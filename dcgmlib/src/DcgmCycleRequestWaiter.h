@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <DcgmThread.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/*****************************************************************************
+ * Holds client requests that wait for an update cycle so they don't occupy
+ * an IPC worker while they wait.
+ *
+ * A parked request is completed on this thread once a cycle after the one
+ * it has seen completes, or once its timeout elapses, whichever is first.
+ * The completion reads whatever is there without waiting any further.
+ *****************************************************************************/
+class DcgmCycleRequestWaiter : public DcgmThread
+{
+public:
+    DcgmCycleRequestWaiter();
+    ~DcgmCycleRequestWaiter() override;
+
+    /*************************************************************************/
+    /*
+     * Park a request until a cycle after lastSeenCycleId completes
+     *
+     * lastSeenCycleId      IN: Last cycle the caller has seen
+     * lastCompletedCycleId IN: Last cycle the cache manager completed when the caller checked
+     * timeoutMs            IN: How long to wait for the cycle at most
+     * complete             IN: Called on this thread when the cycle completed or the wait timed out
+     */
+    void Park(long long lastSeenCycleId,
+              long long lastCompletedCycleId,
+              unsigned int timeoutMs,
+              std::function<void()> complete);
+
+    /*************************************************************************/
+    /* Called when the update cycle cycleId completed */
+    void OnUpdateCycle(long long cycleId);
+
+    /*************************************************************************/
+    /* Get how many requests are parked right now */
+    size_t GetNumParked();
+
+    /*************************************************************************/
+    void run() override;
+
+private:
+    struct ParkedRequest
+    {
+        long long lastSeenCycleId;
+        std::chrono::steady_clock::time_point deadline;
+        std::function<void()> complete;
+    };
+
+    void OnStop() override;
+
+    std::mutex m_mutex;                  /* Protects the members below */
+    std::condition_variable m_condition; /* Signaled when m_wakeUp is set */
+    bool m_wakeUp           = false;     /* Whether something changed since the thread last looked */
+    long long m_lastCycleId = 0;         /* Last completed cycle we know of */
+    std::vector<ParkedRequest> m_parked; /* Requests that are still waiting */
+};
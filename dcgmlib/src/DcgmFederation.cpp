@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmFederation.h"
+
+#include "dcgm_agent.h"
+#include "dcgm_fields.h"
+#include "timelib.h"
+
+#include <DcgmLogging.h>
+#include <DcgmStringHelpers.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <fmt/format.h>
+#include <iterator>
+#include <unistd.h>
+
+/* How long to wait for a node to accept a connection */
+#define DCGM_FEDERATION_CONNECT_TIMEOUT_MS 5000
+
+/* Fields that are mirrored when DCGM_ENV_FEDERATION_FIELDS isn't set */
+static unsigned short const c_defaultFieldIds[] = {
+    DCGM_FI_DEV_GPU_TEMP, DCGM_FI_DEV_POWER_USAGE, DCGM_FI_DEV_GPU_UTIL, DCGM_FI_DEV_MEM_COPY_UTIL,
+    DCGM_FI_DEV_FB_USED,  DCGM_FI_DEV_SM_CLOCK,    DCGM_FI_DEV_XID_ERRORS,
+};
+
+/*****************************************************************************/
+DcgmFederationNode::DcgmFederationNode(unsigned int nodeId,
+                                       std::string address,
+                                       std::vector<unsigned short> fieldIds,
+                                       long long intervalUsec)
+    : DcgmThread(false, fmt::format("dcgm_fed_{}", nodeId))
+    , m_nodeId(nodeId)
+    , m_address(std::move(address))
+    , m_fieldIds(std::move(fieldIds))
+    , m_intervalUsec(intervalUsec)
+{}
+
+/*****************************************************************************/
+DcgmFederationNode::~DcgmFederationNode()
+{
+    try
+    {
+        if (StopAndWait(2 * DCGM_FEDERATION_CONNECT_TIMEOUT_MS) != 0)
+        {
+            DCGM_LOG_ERROR << "Federation thread of node " << m_nodeId << " didn't stop. Killing it.";
+            Kill();
+        }
+    }
+    catch (std::exception const &ex)
+    {
+        DCGM_LOG_ERROR << "Exception caught in ~DcgmFederationNode(): " << ex.what();
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFederationNode::Connect()
+{
+    dcgmConnectV2Params_t connectParams {};
+    connectParams.version                = dcgmConnectV2Params_version;
+    connectParams.persistAfterDisconnect = 0; /* The node drops our watches if we go away */
+    connectParams.timeoutMs              = DCGM_FEDERATION_CONNECT_TIMEOUT_MS;
+
+    std::string address = m_address;
+    if (address.starts_with("unix://"))
+    {
+        address                           = address.substr(7);
+        connectParams.addressIsUnixSocket = 1;
+    }
+
+    dcgmReturn_t dcgmReturn = dcgmConnect_v2(address.c_str(), &connectParams, &m_dcgmHandle);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_debug("Unable to connect to federation node {} at {}: {}", m_nodeId, m_address, errorString(dcgmReturn));
+        m_dcgmHandle = 0;
+        return dcgmReturn;
+    }
+
+    /* Field group names are unique per hostengine, and other aggregators may share this node */
+    std::string const fieldGroupName = fmt::format("federation_{}_{}_{}", getpid(), m_nodeId, timelib_usecSince1970());
+    std::vector<unsigned short> fieldIds = m_fieldIds;
+
+    dcgmReturn = dcgmFieldGroupCreate(
+        m_dcgmHandle, (int)fieldIds.size(), fieldIds.data(), fieldGroupName.c_str(), &m_fieldGroupId);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("dcgmFieldGroupCreate on federation node {} returned {}", m_nodeId, errorString(dcgmReturn));
+        Disconnect();
+        return dcgmReturn;
+    }
+
+    /* Only the latest sample is mirrored, but keep one more so a sample that lands during a sync isn't lost */
+    dcgmReturn = dcgmWatchFields(m_dcgmHandle, DCGM_GROUP_ALL_GPUS, m_fieldGroupId, m_intervalUsec, 0.0, 2);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("dcgmWatchFields on federation node {} returned {}", m_nodeId, errorString(dcgmReturn));
+        Disconnect();
+        return dcgmReturn;
+    }
+
+    /* Start over since samples from before a reconnect may be gone */
+    m_sinceTs = 0;
+
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_connected = true;
+    log_info("Connected to federation node {} at {}", m_nodeId, m_address);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmFederationNode::Disconnect()
+{
+    if (m_dcgmHandle != 0)
+    {
+        /* Our watches and field group go away with the connection */
+        dcgmDisconnect(m_dcgmHandle);
+        m_dcgmHandle = 0;
+    }
+
+    m_fieldGroupId = 0;
+
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_connected = false;
+}
+
+/*****************************************************************************/
+int DcgmFederationNode::ValuesCB(dcgm_field_entity_group_t entityGroupId,
+                                 dcgm_field_eid_t entityId,
+                                 dcgmFieldValue_v1 *values,
+                                 int numValues,
+                                 void *userData)
+{
+    DcgmFederationNode *node = (DcgmFederationNode *)userData;
+
+    std::lock_guard<std::mutex> lock(node->m_stateMutex);
+
+    for (int i = 0; i < numValues; i++)
+    {
+        dcgmFieldValue_v1 const &value = values[i];
+        if (value.fieldType == DCGM_FT_BINARY)
+        {
+            continue;
+        }
+
+        node->m_newestTs = std::max(node->m_newestTs, (long long)value.ts);
+
+        auto [it, inserted] = node->m_latestValues.try_emplace({ entityGroupId, entityId, value.fieldId });
+        if (inserted)
+        {
+            node->m_generation++;
+        }
+
+        dcgmFederationFieldValue_v1 &mirrored = it->second;
+        if (mirrored.ts > value.ts)
+        {
+            /* We already have a newer sample */
+            continue;
+        }
+
+        mirrored.nodeId        = node->m_nodeId;
+        mirrored.entityGroupId = entityGroupId;
+        mirrored.entityId      = entityId;
+        mirrored.fieldId       = value.fieldId;
+        mirrored.fieldType     = value.fieldType;
+        mirrored.status        = value.status;
+        mirrored.ts            = value.ts;
+        memcpy(&mirrored.value, &value.value, sizeof(mirrored.value));
+        mirrored.value.str[sizeof(mirrored.value.str) - 1] = '\0';
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFederationNode::Sync()
+{
+    long long const startTs = timelib_usecSince1970();
+    long long nextSinceTs   = 0;
+
+    m_newestTs = 0;
+
+    dcgmReturn_t dcgmReturn = dcgmGetValuesSince_v2(
+        m_dcgmHandle, DCGM_GROUP_ALL_GPUS, m_fieldGroupId, m_sinceTs, &nextSinceTs, ValuesCB, this);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("dcgmGetValuesSince_v2 on federation node {} returned {}", m_nodeId, errorString(dcgmReturn));
+        return dcgmReturn;
+    }
+
+    m_sinceTs = nextSinceTs;
+
+    long long const endTs = timelib_usecSince1970();
+
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_syncLatencyUsec = endTs - startTs;
+    m_lastSyncTs      = endTs;
+    m_numSyncs++;
+    if (m_newestTs > 0)
+    {
+        m_lagUsec = endTs - m_newestTs;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmFederationNode::run()
+{
+    while (!ShouldStop())
+    {
+        long long const startTs = timelib_usecSince1970();
+
+        dcgmReturn_t dcgmReturn = DCGM_ST_OK;
+        if (m_dcgmHandle == 0)
+        {
+            dcgmReturn = Connect();
+        }
+
+        if (dcgmReturn == DCGM_ST_OK)
+        {
+            dcgmReturn = Sync();
+            if (dcgmReturn != DCGM_ST_OK)
+            {
+                /* Reconnect on the next interval in case the node was restarted */
+                Disconnect();
+            }
+        }
+
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            m_numErrors++;
+        }
+
+        long long const elapsedUsec = timelib_usecSince1970() - startTs;
+        Sleep(std::max(0LL, m_intervalUsec - elapsedUsec));
+    }
+
+    Disconnect();
+}
+
+/*****************************************************************************/
+void DcgmFederationNode::GetState(dcgmFederationNode_v1 &state)
+{
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+
+    state.nodeId = m_nodeId;
+    SafeCopyTo(state.address, m_address.c_str());
+    state.connected       = m_connected ? 1 : 0;
+    state.lagUsec         = m_lagUsec;
+    state.syncLatencyUsec = m_syncLatencyUsec;
+    state.lastSyncTs      = m_lastSyncTs;
+    state.numSyncs        = m_numSyncs;
+    state.numErrors       = m_numErrors;
+    state.numValues       = m_latestValues.size();
+}
+
+/*****************************************************************************/
+size_t DcgmFederationNode::GetLatestValues(size_t skip,
+                                           size_t maxValues,
+                                           std::vector<dcgmFederationFieldValue_v1> &values,
+                                           unsigned int &generation)
+{
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+
+    generation = m_generation;
+    if (skip >= m_latestValues.size())
+    {
+        return m_latestValues.size();
+    }
+
+    for (auto it = std::next(m_latestValues.begin(), skip); it != m_latestValues.end() && values.size() < maxValues;
+         ++it)
+    {
+        values.push_back(it->second);
+    }
+
+    return m_latestValues.size();
+}
+
+/*****************************************************************************/
+DcgmFederation::DcgmFederation(std::vector<std::string> const &addresses,
+                               std::vector<unsigned short> const &fieldIds,
+                               long long intervalUsec)
+{
+    m_nodes.reserve(addresses.size());
+    for (unsigned int nodeId = 0; nodeId < addresses.size(); nodeId++)
+    {
+        m_nodes.push_back(std::make_unique<DcgmFederationNode>(nodeId, addresses[nodeId], fieldIds, intervalUsec));
+    }
+
+    /* Start them after they all exist so GetNodes() never sees a partial list */
+    for (auto &node : m_nodes)
+    {
+        node->Start();
+    }
+}
+
+/*****************************************************************************/
+DcgmFederation::~DcgmFederation()
+{
+    Stop();
+}
+
+/*****************************************************************************/
+void DcgmFederation::Stop()
+{
+    /* Ask every node to stop first so slow nodes are waited on in parallel */
+    for (auto &node : m_nodes)
+    {
+        node->Stop();
+    }
+
+    for (auto &node : m_nodes)
+    {
+        /* Leave room for a connection attempt that is in flight */
+        if (node->StopAndWait(2 * DCGM_FEDERATION_CONNECT_TIMEOUT_MS) != 0)
+        {
+            DCGM_LOG_ERROR << "A federation node thread didn't stop. Killing it.";
+            node->Kill();
+        }
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFederation::ParseFieldIds(std::string const &fieldIdsStr, std::vector<unsigned short> &fieldIds)
+{
+    fieldIds.clear();
+
+    for (auto const &token : DcgmNs::Split(fieldIdsStr, ','))
+    {
+        unsigned short fieldId = 0;
+        auto [end, ec]         = std::from_chars(token.data(), token.data() + token.size(), fieldId);
+        if (ec != std::errc() || end != token.data() + token.size())
+        {
+            log_error("Invalid federation field ID \"{}\"", token);
+            return DCGM_ST_BADPARAM;
+        }
+
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+        if (fieldMeta == nullptr)
+        {
+            log_error("Unknown federation field ID {}", fieldId);
+            return DCGM_ST_UNKNOWN_FIELD;
+        }
+        if (fieldMeta->fieldType == DCGM_FT_BINARY)
+        {
+            log_error("Binary field {} can't be federated", fieldId);
+            return DCGM_ST_BADPARAM;
+        }
+
+        fieldIds.push_back(fieldId);
+    }
+
+    if (fieldIds.empty() || fieldIds.size() > DCGM_MAX_FIELD_IDS_PER_FIELD_GROUP)
+    {
+        log_error("Got {} federation field IDs. Expected 1 to {}", fieldIds.size(), DCGM_MAX_FIELD_IDS_PER_FIELD_GROUP);
+        return DCGM_ST_BADPARAM;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+std::unique_ptr<DcgmFederation> DcgmFederation::CreateFromEnv()
+{
+    char const *nodesStr = getenv(DCGM_ENV_FEDERATION_NODES);
+    if (nodesStr == nullptr || nodesStr[0] == '\0')
+    {
+        return nullptr;
+    }
+
+    std::vector<std::string> addresses;
+    for (auto const &address : DcgmNs::Split(nodesStr, ','))
+    {
+        if (!address.empty())
+        {
+            addresses.emplace_back(address);
+        }
+    }
+
+    if (addresses.empty() || addresses.size() > DCGM_FEDERATION_MAX_NODES)
+    {
+        log_error("Got {} federation nodes from {}. Expected 1 to {}",
+                  addresses.size(),
+                  DCGM_ENV_FEDERATION_NODES,
+                  DCGM_FEDERATION_MAX_NODES);
+        return nullptr;
+    }
+
+    std::vector<unsigned short> fieldIds(std::begin(c_defaultFieldIds), std::end(c_defaultFieldIds));
+    char const *fieldsStr = getenv(DCGM_ENV_FEDERATION_FIELDS);
+    if (fieldsStr != nullptr && fieldsStr[0] != '\0' && ParseFieldIds(fieldsStr, fieldIds) != DCGM_ST_OK)
+    {
+        log_error("Not federating due to an invalid {}", DCGM_ENV_FEDERATION_FIELDS);
+        return nullptr;
+    }
+
+    long long intervalMs  = DCGM_FEDERATION_DEFAULT_INTERVAL_MS;
+    char const *intervalStr = getenv(DCGM_ENV_FEDERATION_INTERVAL);
+    if (intervalStr != nullptr)
+    {
+        intervalMs = atoll(intervalStr);
+        if (intervalMs <= 0)
+        {
+            log_error("Ignoring invalid {} value \"{}\"", DCGM_ENV_FEDERATION_INTERVAL, intervalStr);
+            intervalMs = DCGM_FEDERATION_DEFAULT_INTERVAL_MS;
+        }
+    }
+
+    log_info("Federating {} hostengines every {} ms", addresses.size(), intervalMs);
+    return std::make_unique<DcgmFederation>(addresses, fieldIds, intervalMs * 1000);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFederation::GetNodes(dcgmFederationNodes_v1 &nodes)
+{
+    nodes.numNodes = 0;
+    for (auto &node : m_nodes)
+    {
+        node->GetState(nodes.nodes[nodes.numNodes]);
+        nodes.numNodes++;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFederation::GetLatestValues(dcgmFederationValues_v1 &values)
+{
+    std::vector<DcgmFederationNode *> nodes;
+
+    if (values.nodeId == DCGM_FEDERATION_ALL_NODES)
+    {
+        for (auto &node : m_nodes)
+        {
+            nodes.push_back(node.get());
+        }
+    }
+    else if (values.nodeId < m_nodes.size())
+    {
+        nodes.push_back(m_nodes[values.nodeId].get());
+    }
+    else
+    {
+        log_error("Invalid federation node ID {}", values.nodeId);
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* Walk the nodes in order so a page continues where the previous one ended.
+       Every node's generation only grows, so their sum changes whenever any of them does */
+    std::vector<dcgmFederationFieldValue_v1> page;
+    page.reserve(DCGM_FEDERATION_MAX_VALUES);
+    size_t totalValues = 0;
+    values.generation  = 0;
+    for (auto *node : nodes)
+    {
+        unsigned int generation = 0;
+        size_t const skip       = values.startIndex > totalValues ? values.startIndex - totalValues : 0;
+        totalValues += node->GetLatestValues(skip, DCGM_FEDERATION_MAX_VALUES, page, generation);
+        values.generation += generation;
+    }
+
+    values.totalValues = totalValues;
+    values.numValues   = page.size();
+    std::copy(page.begin(), page.end(), values.values);
+
+    return DCGM_ST_OK;
+}
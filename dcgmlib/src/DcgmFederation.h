@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmSettings.h"
+#include "dcgm_structs.h"
+
+#include <DcgmThread.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#define DCGM_FEDERATION_DEFAULT_INTERVAL_MS 1000
+
+/*****************************************************************************
+ * Mirrors the latest values of the federated fields of one downstream
+ * hostengine.
+ *
+ * The thread keeps a connection to the node through the regular client API,
+ * watches the fields on every GPU there and then pulls only what changed
+ * since the last sync with dcgmGetValuesSince_v2. Lost connections are
+ * re-established on the next interval. Every node has its own thread so a
+ * slow or unreachable node never holds up the others.
+ *****************************************************************************/
+class DcgmFederationNode : public DcgmThread
+{
+public:
+    /*************************************************************************/
+    /*
+     * nodeId         IN: ID that qualifies the entities of this node
+     * address        IN: host[:port] or unix:// path of the node
+     * fieldIds       IN: Fields to mirror
+     * intervalUsec   IN: How often to sync with the node
+     */
+    DcgmFederationNode(unsigned int nodeId,
+                       std::string address,
+                       std::vector<unsigned short> fieldIds,
+                       long long intervalUsec);
+    ~DcgmFederationNode() override;
+
+    /*************************************************************************/
+    void run() override;
+
+    /*************************************************************************/
+    /* Get the connection state and lag of this node */
+    void GetState(dcgmFederationNode_v1 &state);
+
+    /*************************************************************************/
+    /*
+     * Append the latest values of the mirrored fields, ordered by entity and field
+     *
+     * skip        IN: How many values to skip before the first one that is appended
+     * maxValues   IN: Stop appending once values holds this many entries
+     * values     OUT: Values to append to
+     * generation OUT: Changes whenever a value is added, which moves the values after it
+     *
+     * Returns how many values this node has in total
+     */
+    size_t GetLatestValues(size_t skip,
+                           size_t maxValues,
+                           std::vector<dcgmFederationFieldValue_v1> &values,
+                           unsigned int &generation);
+
+private:
+    /* Connect to the node and watch the federated fields there */
+    dcgmReturn_t Connect();
+    void Disconnect();
+
+    /* Pull the values that changed since the last sync */
+    dcgmReturn_t Sync();
+
+    static int ValuesCB(dcgm_field_entity_group_t entityGroupId,
+                        dcgm_field_eid_t entityId,
+                        dcgmFieldValue_v1 *values,
+                        int numValues,
+                        void *userData);
+
+    unsigned int const m_nodeId;
+    std::string const m_address;
+    std::vector<unsigned short> const m_fieldIds;
+    long long const m_intervalUsec;
+
+    /* Only used from the thread */
+    dcgmHandle_t m_dcgmHandle     = 0;
+    dcgmFieldGrp_t m_fieldGroupId = 0;
+    long long m_sinceTs           = 0;
+    long long m_newestTs          = 0; /* Newest sample timestamp seen in the current sync */
+
+    /* Everything below is protected by m_stateMutex */
+    std::mutex m_stateMutex;
+    using ValueKey = std::tuple<dcgm_field_entity_group_t, dcgm_field_eid_t, unsigned short>;
+    std::map<ValueKey, dcgmFederationFieldValue_v1> m_latestValues;
+    unsigned int m_generation   = 0; /* Bumped whenever a key is added to m_latestValues */
+    bool m_connected            = false;
+    long long m_lagUsec         = 0;
+    long long m_syncLatencyUsec = 0;
+    long long m_lastSyncTs      = 0;
+    long long m_numSyncs        = 0;
+    long long m_numErrors       = 0;
+};
+
+/*****************************************************************************
+ * Aggregator mode of the hostengine. Mirrors fields from many downstream
+ * hostengines and serves them node-qualified to this hostengine's clients.
+ *
+ * This is thread safe.
+ *****************************************************************************/
+class DcgmFederation
+{
+public:
+    /*************************************************************************/
+    /*
+     * addresses    IN: host[:port] or unix:// path of every node. The index is the node's ID
+     * fieldIds     IN: Fields to mirror from every node
+     * intervalUsec IN: How often to sync with every node
+     */
+    DcgmFederation(std::vector<std::string> const &addresses,
+                   std::vector<unsigned short> const &fieldIds,
+                   long long intervalUsec);
+
+    ~DcgmFederation();
+
+    /*************************************************************************/
+    /* Stop syncing with every node and disconnect from them. The last mirrored
+       values and node states can still be read afterwards */
+    void Stop();
+
+    /*************************************************************************/
+    /* Create a federation from the DCGM_ENV_FEDERATION_? variables.
+       Returns nullptr if no nodes are configured or the configuration is invalid */
+    static std::unique_ptr<DcgmFederation> CreateFromEnv();
+
+    /*************************************************************************/
+    /* Parse a comma-separated list of field IDs */
+    static dcgmReturn_t ParseFieldIds(std::string const &fieldIdsStr, std::vector<unsigned short> &fieldIds);
+
+    /*************************************************************************/
+    dcgmReturn_t GetNodes(dcgmFederationNodes_v1 &nodes);
+
+    /*************************************************************************/
+    /* Fill values->values from values->startIndex on. values->nodeId selects the node.
+       values->generation tells the caller whether the indexes moved since its last page */
+    dcgmReturn_t GetLatestValues(dcgmFederationValues_v1 &values);
+
+private:
+    std::vector<std::unique_ptr<DcgmFederationNode>> m_nodes;
+};
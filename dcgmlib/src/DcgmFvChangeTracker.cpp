@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmFvChangeTracker.h"
+
+#include <DcgmLogging.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*****************************************************************************/
+static std::uint64_t MakeSentValueKey(dcgmBufferedFv_t const &fv)
+{
+    return ((std::uint64_t)fv.entityGroupId << 48) | ((std::uint64_t)fv.entityId << 16) | fv.fieldId;
+}
+
+/*****************************************************************************/
+std::uint64_t DcgmFvChangeTracker::HashValue(dcgmBufferedFv_t const &fv)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    auto hashBytes     = [&hash](void const *bytes, size_t count) {
+        for (size_t i = 0; i < count; i++)
+        {
+            hash = (hash ^ static_cast<unsigned char const *>(bytes)[i]) * 0x100000001b3ULL;
+        }
+    };
+
+    hashBytes(&fv.fieldType, sizeof(fv.fieldType));
+    hashBytes(&fv.status, sizeof(fv.status));
+
+    /* Values are truncated to their length. Strings and blobs only hash the bytes that were sent */
+    size_t const valueOffset = offsetof(dcgmBufferedFv_t, value);
+    if (fv.length > valueOffset)
+    {
+        hashBytes(&fv.value, std::min<size_t>(fv.length - valueOffset, sizeof(fv.value)));
+    }
+
+    return hash;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvChangeTracker::GetChanges(dcgm_connection_id_t connectionId,
+                                             unsigned int groupId,
+                                             unsigned int fieldGroupId,
+                                             unsigned int resyncInterval,
+                                             DcgmFvBuffer &latest,
+                                             size_t maxBytes,
+                                             DcgmFvBuffer &changes,
+                                             bool &isResync)
+{
+    if (resyncInterval == 0)
+    {
+        resyncInterval = DCGM_FV_CHANGES_DEFAULT_RESYNC_INTERVAL;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Reader &reader                = m_readers[ReaderKey(connectionId, groupId, fieldGroupId)];
+    unsigned int const callNumber = reader.callsSinceResync + 1;
+    isResync                      = !reader.synced || callNumber >= resyncInterval;
+
+    /* Only remember what was sent once we know it fits in the response */
+    std::vector<std::pair<std::uint64_t, SentValue>> sentValues;
+    changes.Clear();
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = latest.GetNextFv(&cursor); fv; fv = latest.GetNextFv(&cursor))
+    {
+        std::uint64_t const key = MakeSentValueKey(*fv);
+        auto const previous     = isResync ? reader.sent.end() : reader.sent.find(key);
+        bool const wasSent      = previous != reader.sent.end();
+
+        if (wasSent && previous->second.timestamp == fv->timestamp)
+        {
+            /* Still the sample that was sent last time */
+            continue;
+        }
+
+        SentValue const sentValue { fv->timestamp, HashValue(*fv) };
+        if (wasSent && previous->second.hash == sentValue.hash)
+        {
+            /* A newer sample of the same value. Remember its timestamp so it isn't hashed again */
+            sentValues.emplace_back(key, sentValue);
+            continue;
+        }
+
+        if (changes.AddBufferedFv(*fv) == nullptr)
+        {
+            return DCGM_ST_MEMORY;
+        }
+        sentValues.emplace_back(key, sentValue);
+    }
+
+    size_t bufferSize   = 0;
+    size_t elementCount = 0;
+    changes.GetSize(&bufferSize, &elementCount);
+    if (bufferSize > maxBytes)
+    {
+        log_debug("{} changed values need {} bytes > {}", elementCount, bufferSize, maxBytes);
+        return DCGM_ST_INSUFFICIENT_SIZE;
+    }
+
+    if (isResync)
+    {
+        /* Rebuilt from scratch so entities that left the group are forgotten */
+        reader.sent.clear();
+        reader.synced           = true;
+        reader.callsSinceResync = 0;
+    }
+    else
+    {
+        reader.callsSinceResync = callNumber;
+    }
+
+    for (auto const &[key, sentValue] : sentValues)
+    {
+        reader.sent[key] = sentValue;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmFvChangeTracker::OnConnectionRemove(dcgm_connection_id_t connectionId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::erase_if(m_readers, [connectionId](auto const &reader) { return std::get<0>(reader.first) == connectionId; });
+}
+
+/*****************************************************************************/
+void DcgmFvChangeTracker::OnGroupRemove(unsigned int groupId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::erase_if(m_readers, [groupId](auto const &reader) { return std::get<1>(reader.first) == groupId; });
+}
+
+/*****************************************************************************/
+void DcgmFvChangeTracker::OnFieldGroupRemove(unsigned int fieldGroupId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::erase_if(m_readers, [fieldGroupId](auto const &reader) { return std::get<2>(reader.first) == fieldGroupId; });
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <DcgmFvBuffer.h>
+#include <dcgm_structs.h>
+#include <dcgm_structs_internal.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+/*****************************************************************************/
+/*
+ * Remembers which latest values were delivered to each reader of
+ * dcgmGetLatestValueChanges so the next call only has to carry the ones that changed.
+ *
+ * A reader is identified by its connection and the (group, field group) it reads.
+ * For every (entity, field) of a reader, the timestamp and a hash of the value it was
+ * last sent are kept. A value whose timestamp didn't move is unchanged without looking
+ * at it. Otherwise its status, type and value bytes are hashed and compared. Every
+ * resyncInterval calls, and on the first call, everything is sent again.
+ */
+class DcgmFvChangeTracker
+{
+public:
+    /*************************************************************************/
+    /*
+     * Copy the values of latest that changed since the last call for the same reader into changes
+     *
+     * connectionId   - connection of the reader. DCGM_CONNECTION_ID_NONE for embedded readers
+     * groupId        - resolved group ID the values are for
+     * fieldGroupId   - field group ID the values are for
+     * resyncInterval - send every value on every resyncInterval-th call. 0 = DCGM_FV_CHANGES_DEFAULT_RESYNC_INTERVAL
+     * latest         - latest values of every (entity, field) of the group and field group
+     * maxBytes       - largest changes buffer the reader can take
+     * changes        - OUT: values of latest that changed. Everything on a resync
+     * isResync       - OUT: whether changes has every value of latest
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_INSUFFICIENT_SIZE if changes would be bigger than maxBytes. Nothing is
+     *                                   recorded as sent, so the next call sends them again
+     *         DCGM_ST_? #define on other errors
+     */
+    dcgmReturn_t GetChanges(dcgm_connection_id_t connectionId,
+                            unsigned int groupId,
+                            unsigned int fieldGroupId,
+                            unsigned int resyncInterval,
+                            DcgmFvBuffer &latest,
+                            size_t maxBytes,
+                            DcgmFvBuffer &changes,
+                            bool &isResync);
+
+    /*************************************************************************/
+    /* Forget every reader of a connection that went away */
+    void OnConnectionRemove(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    /* Forget every reader of a group that was destroyed */
+    void OnGroupRemove(unsigned int groupId);
+
+    /*************************************************************************/
+    /* Forget every reader of a field group that was destroyed */
+    void OnFieldGroupRemove(unsigned int fieldGroupId);
+
+    /*************************************************************************/
+    /* Hash of everything about fv that a reader would see change, except its timestamp */
+    static std::uint64_t HashValue(dcgmBufferedFv_t const &fv);
+
+private:
+    struct SentValue
+    {
+        std::int64_t timestamp;
+        std::uint64_t hash;
+    };
+
+    struct Reader
+    {
+        unsigned int callsSinceResync = 0;
+        bool synced                   = false; /* Whether sent was built by a resync */
+
+        /* What was last sent for each entity group, entity and field ID */
+        std::unordered_map<std::uint64_t, SentValue> sent;
+    };
+
+    using ReaderKey = std::tuple<dcgm_connection_id_t, unsigned int, unsigned int>;
+
+    std::mutex m_mutex;                    /* Protects m_readers */
+    std::map<ReaderKey, Reader> m_readers; /* By connection, group and field group */
+};
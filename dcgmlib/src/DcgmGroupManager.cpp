@@ -23,6 +23,7 @@
 #include "DcgmHostEngineHandler.h"
 #include "DcgmLogging.h"
 #include "DcgmSettings.h"
+#include <algorithm>
 #include <fmt/format.h>
 #include <stdexcept>
 
@@ -633,6 +634,7 @@ DcgmGroupInfo::DcgmGroupInfo(dcgm_connection_id_t connectionId,
 DcgmGroupInfo::~DcgmGroupInfo()
 {
     mEntityList.clear();
+    mEntityIndex.clear();
 }
 
 /*****************************************************************************/
@@ -656,28 +658,18 @@ dcgmReturn_t DcgmGroupInfo::AddEntityToGroup(dcgm_field_entity_group_t entityGro
     insertEntity.entityId      = entityId;
 
     /* Check if entity is already added to the group */
-    for (unsigned int i = 0; i < mEntityList.size(); ++i)
+    unsigned long long const key = EntityKey(entityGroupId, entityId);
+    auto indexIt                 = std::lower_bound(mEntityIndex.begin(), mEntityIndex.end(), key);
+    if (indexIt != mEntityIndex.end() && *indexIt == key)
     {
-        if (mEntityList[i].entityGroupId == insertEntity.entityGroupId
-            && mEntityList[i].entityId == insertEntity.entityId)
-        {
-            log_warning("AddEntityToGroup groupId {} eg {}, eid {} was already in the group",
-                        mGroupId,
-                        entityGroupId,
-                        entityId);
-            return DCGM_ST_BADPARAM;
-        }
-    }
-
-    if (mEntityList.size() >= DCGM_GROUP_MAX_ENTITIES)
-    {
-        /*
-         * This is a safeguard for public API that has hardcoded array of DCGM_GROUP_MAX_ENTITIES elements in a group.
-         */
-        DCGM_LOG_DEBUG << fmt::format("Too many items in the groupId {}", mGroupId);
-        return DCGM_ST_MAX_LIMIT;
+        log_warning(
+            "AddEntityToGroup groupId {} eg {}, eid {} was already in the group", mGroupId, entityGroupId, entityId);
+        return DCGM_ST_BADPARAM;
     }
 
+    /* Groups aren't limited to DCGM_GROUP_MAX_ENTITIES. Only dcgmGroupGetInfo() is, since it returns a fixed
+       array. Larger groups are listed with dcgmGroupGetEntities() */
+    mEntityIndex.insert(indexIt, key);
     mEntityList.push_back(insertEntity);
     return DCGM_ST_OK;
 }
@@ -685,17 +677,22 @@ dcgmReturn_t DcgmGroupInfo::AddEntityToGroup(dcgm_field_entity_group_t entityGro
 /*****************************************************************************/
 dcgmReturn_t DcgmGroupInfo::RemoveEntityFromGroup(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId)
 {
-    for (unsigned int i = 0; i < mEntityList.size(); ++i)
+    unsigned long long const key = EntityKey(entityGroupId, entityId);
+    auto indexIt                 = std::lower_bound(mEntityIndex.begin(), mEntityIndex.end(), key);
+    if (indexIt == mEntityIndex.end() || *indexIt != key)
     {
-        if (mEntityList[i].entityGroupId == entityGroupId && mEntityList[i].entityId == entityId)
-        {
-            mEntityList.erase(mEntityList.begin() + i);
-            return DCGM_ST_OK;
-        }
+        log_error(
+            "Tried to remove eg {}, eid {} from groupId {}. was not found.", entityGroupId, entityId, GetGroupId());
+        return DCGM_ST_BADPARAM;
     }
 
-    log_error("Tried to remove eg {}, eid {} from groupId {}. was not found.", entityGroupId, entityId, GetGroupId());
-    return DCGM_ST_BADPARAM;
+    /* The index only makes the membership check cheap. Removing is still linear in the size of the group since
+       mEntityList has to keep the order entities were added in for paging */
+    mEntityIndex.erase(indexIt);
+    mEntityList.erase(std::find_if(mEntityList.begin(), mEntityList.end(), [&](dcgmGroupEntityPair_t const &entity) {
+        return entity.entityGroupId == entityGroupId && entity.entityId == entityId;
+    }));
+    return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
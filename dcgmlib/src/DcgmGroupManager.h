@@ -326,7 +326,8 @@ public:
     dcgmReturn_t AddEntityToGroup(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId);
 
     /*****************************************************************************
-     * This method is used to remove an entity from this group
+     * This method is used to remove an entity from this group. This is linear in the
+     * number of entities in the group
      *
      * @param entityGroupId IN: Entity group of the entity to remove from this group
      * @param entityId      IN: Entity id of the entity to remove from this group
@@ -382,9 +383,16 @@ public:
     bool AreAllTheSameSku();
 
 private:
+    static unsigned long long EntityKey(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId)
+    {
+        return ((unsigned long long)entityGroupId << 32) | entityId;
+    }
+
     unsigned int mGroupId;                          /* ID representing GPU group */
     std::string mName;                              /* Name for the group group */
-    std::vector<dcgmGroupEntityPair_t> mEntityList; /* List of entities */
+    std::vector<dcgmGroupEntityPair_t> mEntityList; /* List of entities in the order they were added */
+    std::vector<unsigned long long> mEntityIndex;   /* Sorted EntityKey() of every entity in mEntityList. Keeps
+                                                       membership checks cheap on groups of thousands of entities */
     dcgm_connection_id_t mConnectionId;             /* Connection ID that created this group */
     DcgmCacheManager *mpCacheManager;               /* Pointer to the cache manager */
 };
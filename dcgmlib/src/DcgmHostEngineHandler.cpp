@@ -26,9 +26,12 @@
 #include "DcgmModulePolicy.h"
 #include "DcgmSettings.h"
 #include "DcgmStatus.h"
+#include "DcgmWireEncoding.h"
+#include "dcgm_diag_structs.h"
 #include "dcgm_health_structs.h"
 #include "dcgm_helpers.h"
 #include "dcgm_nvswitch_structs.h"
+#include "dcgm_policy_structs.h"
 #include "dcgm_profiling_structs.h"
 #include "dcgm_sysmon_structs.h"
 #include "dcgm_util.h"
@@ -38,9 +41,11 @@
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 #include "DcgmCoreCommunication.h"
 #include "DcgmGroupManager.h"
+#include <TimeLib.hpp>
 #include <dcgm_nvml.h>
 
 #ifdef INJECTION_LIBRARY_AVAILABLE
@@ -1023,7 +1028,7 @@ dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommand(dcgm_module_command_hea
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmHostEngineHandler::GetCacheManagerFieldInfo(dcgmCacheManagerFieldInfo_v4_t *fieldInfo)
+dcgmReturn_t DcgmHostEngineHandler::GetCacheManagerFieldInfo(dcgmCacheManagerFieldInfo_v5_t *fieldInfo)
 {
     return mpCacheManager->GetCacheManagerFieldInfo(fieldInfo);
 }
@@ -1045,6 +1050,14 @@ void DcgmHostEngineHandler::OnConnectionRemove(dcgm_connection_id_t connectionId
         mpCacheManager->OnConnectionRemove(connectionId);
     }
 
+    {
+        std::lock_guard<std::mutex> lock(m_clientCacheMutex);
+        std::erase_if(m_clientCacheSubscribers,
+                      [connectionId](auto const &subscriber) { return subscriber.first == connectionId; });
+    }
+
+    m_fvChangeTracker.OnConnectionRemove(connectionId);
+
     /* Notify each module about the client disconnect */
     dcgm_core_msg_client_disconnect_t msg;
     memset(&msg, 0, sizeof(msg));
@@ -1073,6 +1086,16 @@ dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommandMsg(dcgm_connection_id_t
 
     auto msgBytes  = message->GetMsgBytesPtr();
     auto msgHeader = message->GetMessageHdr();
+    bool compact   = message->GetMsgType() == DCGM_MSG_MODULE_COMMAND_COMPACT;
+
+    if (compact)
+    {
+        retSt = DecodeCompactModuleCommand(*msgBytes);
+        if (retSt != DCGM_ST_OK)
+        {
+            return retSt;
+        }
+    }
 
 /* Resize our buffer to be the maximum size of a DCGM message. This is so
    the module command response can be larger than the request
@@ -1091,9 +1114,9 @@ dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommandMsg(dcgm_connection_id_t
     /* Verify that we didn't get a malicious moduleCommand->length. This also implicitly
        checks that our message isn't larger than DCGM_PROTO_MAX_MESSAGE_SIZE
        since DcgmIpc checks that when it assembles messages from the socket stream. */
-    if (moduleCommand->length != message->GetLength())
+    if (moduleCommand->length != msgBytes->size())
     {
-        DCGM_LOG_ERROR << "Module command has bad length " << moduleCommand->length << " != " << message->GetLength();
+        DCGM_LOG_ERROR << "Module command has bad length " << moduleCommand->length << " != " << msgBytes->size();
         return DCGM_ST_BADPARAM;
     }
 
@@ -1107,6 +1130,16 @@ dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommandMsg(dcgm_connection_id_t
                 moduleCommand         = (dcgm_module_command_header_t *)msgBytes->data();
                 moduleCommand->length = sizeof(dcgm_core_msg_entities_get_latest_values_v2);
                 break;
+            case DCGM_CORE_SR_ENTITIES_GET_CYCLE_VALUES:
+                msgBytes->resize(sizeof(dcgm_core_msg_entities_get_cycle_values_t));
+                moduleCommand         = (dcgm_module_command_header_t *)msgBytes->data();
+                moduleCommand->length = sizeof(dcgm_core_msg_entities_get_cycle_values_t);
+                break;
+            case DCGM_CORE_SR_GET_LATEST_VALUE_CHANGES:
+                msgBytes->resize(sizeof(dcgm_core_msg_get_latest_value_changes_t));
+                moduleCommand         = (dcgm_module_command_header_t *)msgBytes->data();
+                moduleCommand->length = sizeof(dcgm_core_msg_get_latest_value_changes_t);
+                break;
             case DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V1:
                 msgBytes->resize(sizeof(dcgm_core_msg_entities_get_latest_values_v1));
                 moduleCommand         = (dcgm_module_command_header_t *)msgBytes->data();
@@ -1133,15 +1166,92 @@ dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommandMsg(dcgm_connection_id_t
 
     moduleCommand->connectionId = connectionId;
 
+    if (moduleCommand->moduleId == DcgmModuleIdCore
+        && moduleCommand->subCommand == DCGM_CORE_SR_ENTITIES_GET_CYCLE_VALUES
+        && moduleCommand->version == dcgm_core_msg_entities_get_cycle_values_version)
+    {
+        auto *cycleValues               = (dcgm_core_msg_entities_get_cycle_values_t *)moduleCommand;
+        unsigned int const timeoutMs    = cycleValues->cv.timeoutMs;
+        long long const lastSeenCycleId = cycleValues->cv.cycleId;
+        long long const lastCycleId     = mpCacheManager->GetLastCompletedCycleId();
+
+        if (timeoutMs > 0 && timeoutMs <= DCGM_MAX_CYCLE_WAIT_MS && lastSeenCycleId >= lastCycleId)
+        {
+            /* Don't hold up an IPC worker while we wait for the cycle. The waiter reads the values once
+               the cycle completes or the wait times out */
+            cycleValues->cv.timeoutMs = 0;
+
+            /* std::function needs a copyable callable */
+            auto parked = std::make_shared<std::unique_ptr<DcgmMessage>>(std::move(message));
+            m_cycleRequestWaiter.Park(lastSeenCycleId, lastCycleId, timeoutMs, [this, connectionId, parked, compact] {
+                DispatchModuleCommandMsg(connectionId, std::move(*parked), compact);
+            });
+            return DCGM_ST_OK;
+        }
+    }
+
+    DispatchModuleCommandMsg(connectionId, std::move(message), compact);
+    return retSt;
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::DispatchModuleCommandMsg(dcgm_connection_id_t connectionId,
+                                                     std::unique_ptr<DcgmMessage> message,
+                                                     bool compact)
+{
+    auto msgBytes      = message->GetMsgBytesPtr();
+    auto moduleCommand = (dcgm_module_command_header_t *)msgBytes->data();
+
     dcgmReturn_t requestStatus = ProcessModuleCommand(moduleCommand);
 
     /* Resize msgBytes to whatever moduleCommand's updated size is */
     msgBytes->resize(moduleCommand->length);
+    dcgm_request_id_t const requestId = moduleCommand->requestId;
+
+    /* Answer in the encoding we were asked in */
+    if (compact)
+    {
+        std::vector<char> encoded;
+        DcgmWireEncodeCompact(msgBytes->data(), msgBytes->size(), sizeof(dcgm_module_command_header_t), encoded);
+        msgBytes->swap(encoded);
+    }
 
-    message->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND, moduleCommand->requestId, requestStatus, moduleCommand->length);
+    message->UpdateMsgHdr(compact ? DCGM_MSG_MODULE_COMMAND_COMPACT : DCGM_MSG_MODULE_COMMAND,
+                          requestId,
+                          requestStatus,
+                          msgBytes->size());
 
     m_dcgmIpc.SendMessage(connectionId, std::move(message), false);
-    return retSt;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::DecodeCompactModuleCommand(std::vector<char> &msgBytes)
+{
+    size_t decodedLength = 0;
+    dcgmReturn_t ret     = DcgmWireGetDecodedLength(
+        msgBytes.data(), msgBytes.size(), sizeof(dcgm_module_command_header_t), decodedLength);
+    if (ret != DCGM_ST_OK || decodedLength > DCGM_PROTO_MAX_MESSAGE_SIZE)
+    {
+        DCGM_LOG_ERROR << "Got a malformed compact module command of length " << msgBytes.size();
+        return DCGM_ST_BADPARAM;
+    }
+
+    std::vector<char> decoded(decodedLength);
+    ret = DcgmWireDecodeCompact(msgBytes.data(),
+                                msgBytes.size(),
+                                sizeof(dcgm_module_command_header_t),
+                                decoded.data(),
+                                decoded.size(),
+                                decodedLength);
+    if (ret != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "Unable to decode compact module command of length " << msgBytes.size() << ": "
+                       << errorString(ret);
+        return DCGM_ST_BADPARAM;
+    }
+
+    msgBytes.swap(decoded);
+    return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
@@ -1155,6 +1265,7 @@ void DcgmHostEngineHandler::ProcessMessage(dcgm_connection_id_t connectionId, st
             break;
 
         case DCGM_MSG_MODULE_COMMAND:
+        case DCGM_MSG_MODULE_COMMAND_COMPACT:
             ProcessModuleCommandMsg(connectionId, std::move(message));
             break;
 
@@ -1309,6 +1420,8 @@ void DcgmHostEngineHandler::OnGroupRemove(unsigned int groupId)
             SendModuleMessage((dcgmModuleId_t)id, (dcgm_module_command_header_t *)&msg);
         }
     }
+
+    InvalidateClientCaches(true);
 }
 
 /*****************************************************************************/
@@ -1381,6 +1494,72 @@ void DcgmHostEngineHandler::OnMigUpdates(unsigned int gpuId)
 
         SendModuleMessage((dcgmModuleId_t)m_module.id, (dcgm_module_command_header_t *)&msg);
     }
+
+    InvalidateClientCaches(true);
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::OnUpdateCycle(long long cycleId)
+{
+    InvalidateClientCaches(false);
+    m_cycleRequestWaiter.OnUpdateCycle(cycleId);
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::InvalidateClientCaches(bool configChanged)
+{
+    dcgm_msg_client_cache_invalidate_t msg {};
+
+    if (configChanged)
+    {
+        m_clientCacheConfigGeneration++;
+    }
+    m_clientCacheValuesGeneration++;
+
+    std::vector<std::pair<dcgm_connection_id_t, dcgm_request_id_t>> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(m_clientCacheMutex);
+        if (m_clientCacheSubscribers.empty())
+        {
+            return;
+        }
+        subscribers = m_clientCacheSubscribers;
+    }
+
+    msg.configGeneration = m_clientCacheConfigGeneration;
+    msg.valuesGeneration = m_clientCacheValuesGeneration;
+
+    for (auto const &[connectionId, requestId] : subscribers)
+    {
+        SendRawMessageToClient(
+            connectionId, DCGM_MSG_CLIENT_CACHE_INVALIDATE, requestId, &msg, sizeof(msg), DCGM_ST_OK);
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::AddClientCacheSubscriber(dcgm_connection_id_t connectionId,
+                                                             dcgm_request_id_t requestId)
+{
+    if (connectionId == DCGM_CONNECTION_ID_NONE || requestId == DCGM_REQUEST_ID_NONE)
+    {
+        DCGM_LOG_ERROR << "Client cache subscriptions are only for remote requests. connectionId " << connectionId
+                       << ", requestId " << requestId;
+        return DCGM_ST_BADPARAM;
+    }
+
+    std::lock_guard<std::mutex> lock(m_clientCacheMutex);
+    m_clientCacheSubscribers.emplace_back(connectionId, requestId);
+
+    DCGM_LOG_DEBUG << "Added client cache subscriber connectionId " << connectionId << ", requestId " << requestId;
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::GetClientCacheGenerations(long long &configGeneration, long long &valuesGeneration)
+{
+    /* Read values first so a config change between the two reads can only make us look stale */
+    valuesGeneration = m_clientCacheValuesGeneration;
+    configGeneration = m_clientCacheConfigGeneration;
 }
 
 /*****************************************************************************/
@@ -1400,6 +1579,12 @@ static void nvHostEngineMigCallback(unsigned int gpuId, void *userData)
     hostEngineHandler->OnMigUpdates(gpuId);
 }
 
+static void nvHostEngineUpdateCycleCallback(long long cycleId, void *userData)
+{
+    auto *hostEngineHandler = (DcgmHostEngineHandler *)userData;
+    hostEngineHandler->OnUpdateCycle(cycleId);
+}
+
 void DcgmHostEngineHandler::ShutdownNvml()
 {
     if (m_usingInjectionNvml)
@@ -1434,6 +1619,13 @@ void DcgmHostEngineHandler::LoadNvml()
         {
             throw std::runtime_error("Error: Failed to initialize injected NVML");
         }
+
+        /* Injected values don't care what time it is, so simulations can run on a virtual clock */
+        if (DcgmNs::Timelib::VirtualClock::InstallFromEnv())
+        {
+            log_info("Running on a free-running virtual clock starting at {}",
+                     DcgmNs::Timelib::VirtualClock::NowUsec());
+        }
     }
 #endif
 
@@ -1446,12 +1638,117 @@ void DcgmHostEngineHandler::LoadNvml()
     }
 }
 
+/*****************************************************************************/
+unsigned int DcgmHostEngineHandler::GetNumIpcReactors()
+{
+    const char *reactorsEnvStr = getenv("__DCGM_IPC_NUM_REACTORS");
+    if (reactorsEnvStr != nullptr)
+    {
+        int numReactors = atoi(reactorsEnvStr);
+        if (numReactors > 0)
+        {
+            return (unsigned int)numReactors;
+        }
+
+        DCGM_LOG_ERROR << "Ignoring invalid __DCGM_IPC_NUM_REACTORS value \"" << reactorsEnvStr << "\"";
+    }
+
+    return std::clamp(std::thread::hardware_concurrency() / 16, 1U, DCGM_HE_MAX_DEFAULT_IPC_REACTORS);
+}
+
+/*****************************************************************************/
+unsigned int DcgmHostEngineHandler::GetIpcMaxInFlightPerConnection()
+{
+    const char *maxInFlightEnvStr = getenv("__DCGM_IPC_MAX_IN_FLIGHT_PER_CONNECTION");
+    if (maxInFlightEnvStr != nullptr)
+    {
+        int maxInFlight = atoi(maxInFlightEnvStr);
+        if (maxInFlight >= 0)
+        {
+            return (unsigned int)maxInFlight;
+        }
+
+        DCGM_LOG_ERROR << "Ignoring invalid __DCGM_IPC_MAX_IN_FLIGHT_PER_CONNECTION value \"" << maxInFlightEnvStr
+                       << "\"";
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
+DcgmIpcPriority_t DcgmHostEngineHandler::ClassifyMessage(DcgmMessage &message)
+{
+    if ((message.GetMsgType() != DCGM_MSG_MODULE_COMMAND && message.GetMsgType() != DCGM_MSG_MODULE_COMMAND_COMPACT)
+        || message.GetLength() < sizeof(dcgm_module_command_header_t))
+    {
+        return DCGM_IPC_PRIORITY_NORMAL;
+    }
+
+    /* The compact encoding keeps the header verbatim */
+    auto moduleCommand = (dcgm_module_command_header_t const *)message.GetMsgBytesPtr()->data();
+
+    switch (moduleCommand->moduleId)
+    {
+        case DcgmModuleIdCore:
+            switch (moduleCommand->subCommand)
+            {
+                case DCGM_CORE_SR_HOSTENGINE_HEALTH:
+                case DCGM_CORE_SR_HOSTENGINE_VERSION:
+                case DCGM_CORE_SR_NEGOTIATE_WIRE_ENCODING:
+                case DCGM_CORE_SR_CLIENT_LOGIN:
+                    return DCGM_IPC_PRIORITY_HIGH;
+
+                case DCGM_CORE_SR_GET_MULTIPLE_VALUES_FOR_FIELD_V1:
+                case DCGM_CORE_SR_GET_MULTIPLE_VALUES_FOR_FIELD_V2:
+                case DCGM_CORE_SR_JOB_GET_STATS:
+                case DCGM_CORE_SR_GET_FIELD_SUMMARY:
+                case DCGM_CORE_SR_UPDATE_ALL_FIELDS:
+                case DCGM_CORE_SR_ENTITIES_GET_CYCLE_VALUES: /* Can hold a worker while it waits for a cycle */
+                    return DCGM_IPC_PRIORITY_BULK;
+
+                default:
+                    return DCGM_IPC_PRIORITY_NORMAL;
+            }
+
+        case DcgmModuleIdHealth:
+            switch (moduleCommand->subCommand)
+            {
+                case DCGM_HEALTH_SR_GET_SYSTEMS:
+                case DCGM_HEALTH_SR_CHECK_GPUS:
+                case DCGM_HEALTH_SR_CHECK_V4:
+                case DCGM_HEALTH_SR_SET_SYSTEMS_V2:
+                    return DCGM_IPC_PRIORITY_HIGH;
+
+                default:
+                    return DCGM_IPC_PRIORITY_NORMAL;
+            }
+
+        case DcgmModuleIdPolicy:
+            switch (moduleCommand->subCommand)
+            {
+                case DCGM_POLICY_SR_REGISTER:
+                case DCGM_POLICY_SR_UNREGISTER:
+                    return DCGM_IPC_PRIORITY_HIGH;
+
+                default:
+                    return DCGM_IPC_PRIORITY_NORMAL;
+            }
+
+        case DcgmModuleIdDiag:
+            /* Stopping a diag should not wait behind the diag it's stopping */
+            return moduleCommand->subCommand == DCGM_DIAG_SR_RUN ? DCGM_IPC_PRIORITY_BULK : DCGM_IPC_PRIORITY_NORMAL;
+
+        default:
+            return DCGM_IPC_PRIORITY_NORMAL;
+    }
+}
+
 /*****************************************************************************
  Constructor for DCGM Host Engine Handler
  *****************************************************************************/
 DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params)
     : m_communicator()
-    , m_dcgmIpc(DCGM_HE_NUM_WORKERS)
+    , m_dcgmIpc(DCGM_HE_NUM_WORKERS + DCGM_HE_NUM_PRIORITY_WORKERS, GetNumIpcReactors())
     , m_hostengineHealth(0)
     , m_usingInjectionNvml(false)
 {
@@ -1570,11 +1867,12 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
         }
     }
 
-    dcgmcmEventSubscription_t fv  = {};
-    dcgmcmEventSubscription_t mig = {};
-    fv.type                       = DcgmcmEventTypeFvUpdate;
-    fv.fn.fvCb                    = nvHostEngineFvCallback;
-    fv.userData                   = this;
+    dcgmcmEventSubscription_t fv    = {};
+    dcgmcmEventSubscription_t mig   = {};
+    dcgmcmEventSubscription_t cycle = {};
+    fv.type                         = DcgmcmEventTypeFvUpdate;
+    fv.fn.fvCb                      = nvHostEngineFvCallback;
+    fv.userData                     = this;
 
     dcgmRet = mpCacheManager->SubscribeForEvent(fv);
     if (dcgmRet != DCGM_ST_OK)
@@ -1592,6 +1890,16 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
         throw std::runtime_error("DCGM was unable to subscribe for mig reconfiguration updates.");
     }
 
+    cycle.type       = DcgmcmEventTypeUpdateCycle;
+    cycle.fn.cycleCb = nvHostEngineUpdateCycleCallback;
+    cycle.userData   = this;
+
+    dcgmRet = mpCacheManager->SubscribeForEvent(cycle);
+    if (dcgmRet != DCGM_ST_OK)
+    {
+        throw std::runtime_error("DCGM was unable to subscribe for update cycle notifications.");
+    }
+
     /* Initialize the group manager before we add our default watches */
     mpGroupManager = new DcgmGroupManager(mpCacheManager, false);
     mpGroupManager->SubscribeForGroupEvents(HostEngineOnGroupEventCB, this);
@@ -1604,6 +1912,7 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
     m_coreCallbacks.poster     = &m_communicator;
     m_coreCallbacks.version    = dcgmCoreCallbacks_version;
     m_coreCallbacks.loggerfunc = (dcgmLoggerCallback_f)DcgmLoggingGetCallback();
+    m_coreCallbacks.clockfunc  = timelib_usecSince1970;
 
     /* Create default groups after we've set up core callbacks. This is because creating
        default groups causes the NvSwitch module to load, which in turn tries to ask m_coreCallbacks
@@ -1639,6 +1948,14 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
         ss << "CacheManager UpdateAllFields. Error: " << ret;
         throw std::runtime_error(ss.str());
     }
+
+    if (m_cycleRequestWaiter.Start() != 0)
+    {
+        throw std::runtime_error("Unable to start the cycle request waiter thread.");
+    }
+
+    /* Start mirroring downstream hostengines if we were asked to aggregate any */
+    m_federation = DcgmFederation::CreateFromEnv();
 }
 
 /*****************************************************************************
@@ -1662,6 +1979,11 @@ DcgmHostEngineHandler::~DcgmHostEngineHandler()
         DCGM_LOG_ERROR << "Unknown exception caught in DcgmHostEngineHandler::~DcgmHostEngineHandler()";
     }
 
+    StopFederation();
+
+    /* Parked requests refer to the cache manager and IPC. Drop them before those go away */
+    m_cycleRequestWaiter.StopAndWait(60000);
+
     auto lock = Lock();
 
     /* Free sub-modules before we unload core modules */
@@ -3594,8 +3916,6 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroup(unsigned int groupId,
                                                     int maxKeepSamples,
                                                     DcgmWatcher const &watcher)
 {
-    int i;
-    int j;
     dcgmReturn_t dcgmReturn;
     std::vector<dcgmGroupEntityPair_t> entities;
     std::vector<unsigned short> fieldIds;
@@ -3619,41 +3939,28 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroup(unsigned int groupId,
 
     log_debug("Got {} entities and {} fields", (int)entities.size(), (int)fieldIds.size());
 
-    bool wasFirstWatcher    = false;
-    bool updateOnFirstWatch = false; /* Don't have the cache manager update after every watch. Instead,
-                                        we will set shouldUpdateAllFields and UpdateAllFields at the end */
     bool shouldUpdateAllFields = false;
-
-    for (i = 0; i < (int)entities.size(); i++)
+    bool updateOnFirstWatch    = false; /* Don't have the cache manager update after the watches. Instead,
+                                           we will UpdateAllFields at the end if shouldUpdateAllFields is set */
+
+    /* All of the watches are added in one transaction. If any fails, none are left behind */
+    dcgmReturn = mpCacheManager->AddFieldWatches(entities,
+                                                 fieldIds,
+                                                 monitorIntervalUsec,
+                                                 maxSampleAge,
+                                                 maxKeepSamples,
+                                                 watcher,
+                                                 false,
+                                                 updateOnFirstWatch,
+                                                 shouldUpdateAllFields);
+    if (dcgmReturn != DCGM_ST_OK)
     {
-        for (j = 0; j < (int)fieldIds.size(); j++)
-        {
-            dcgmReturn = mpCacheManager->AddFieldWatch(entities[i].entityGroupId,
-                                                       entities[i].entityId,
-                                                       fieldIds[j],
-                                                       monitorIntervalUsec,
-                                                       maxSampleAge,
-                                                       maxKeepSamples,
-                                                       watcher,
-                                                       false,
-                                                       updateOnFirstWatch,
-                                                       wasFirstWatcher);
-            if (dcgmReturn != DCGM_ST_OK)
-            {
-                log_error("AddFieldWatch({}, {}, {}) returned {}",
-                          entities[i].entityGroupId,
-                          entities[i].entityId,
-                          (int)fieldIds[j],
-                          (int)dcgmReturn);
-                retSt = dcgmReturn;
-                goto GETOUT;
-            }
-
-            if (wasFirstWatcher)
-            {
-                shouldUpdateAllFields = true;
-            }
-        }
+        log_error("AddFieldWatches of {} entities and {} fields returned {}",
+                  (int)entities.size(),
+                  (int)fieldIds.size(),
+                  (int)dcgmReturn);
+        retSt = dcgmReturn;
+        goto GETOUT;
     }
 
     if (shouldUpdateAllFields)
@@ -3854,8 +4161,6 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroupAllGpus(dcgmFieldGrp_t fieldG
                                                            int activeOnly,
                                                            DcgmWatcher const &watcher)
 {
-    int i;
-    int j;
     dcgmReturn_t dcgmReturn;
     std::vector<unsigned int> gpuIds;
     std::vector<unsigned short> fieldIds;
@@ -3877,36 +4182,33 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroupAllGpus(dcgmFieldGrp_t fieldG
 
     log_debug("Got {} gpus and {} fields", (int)gpuIds.size(), (int)fieldIds.size());
 
-    bool wasFirstWatcher    = false;
-    bool updateOnFirstWatch = false; /* Don't have the cache manager update after every watch. Instead,
-                                        we will set shouldUpdateAllFields and UpdateAllFields at the end */
-    bool shouldUpdateAllFields = false;
-
-    for (i = 0; i < (int)gpuIds.size(); i++)
+    std::vector<dcgmGroupEntityPair_t> entities;
+    entities.reserve(gpuIds.size());
+    for (unsigned int gpuId : gpuIds)
     {
-        for (j = 0; j < (int)fieldIds.size(); j++)
-        {
-            dcgmReturn = mpCacheManager->AddFieldWatch(DCGM_FE_GPU,
-                                                       gpuIds[i],
-                                                       fieldIds[j],
-                                                       monitorIntervalUsec,
-                                                       maxSampleAge,
-                                                       maxKeepSamples,
-                                                       watcher,
-                                                       false,
-                                                       updateOnFirstWatch,
-                                                       wasFirstWatcher);
-            if (dcgmReturn != DCGM_ST_OK)
-            {
-                log_error("AddFieldWatch({}, {}) returned {}", (int)gpuIds[i], (int)fieldIds[j], (int)dcgmReturn);
-                return DCGM_ST_GENERIC_ERROR;
-            }
+        entities.push_back({ DCGM_FE_GPU, gpuId });
+    }
 
-            if (wasFirstWatcher)
-            {
-                shouldUpdateAllFields = true;
-            }
-        }
+    bool shouldUpdateAllFields = false;
+    bool updateOnFirstWatch    = false; /* Don't have the cache manager update after the watches. Instead,
+                                           we will UpdateAllFields at the end if shouldUpdateAllFields is set */
+
+    dcgmReturn = mpCacheManager->AddFieldWatches(entities,
+                                                 fieldIds,
+                                                 monitorIntervalUsec,
+                                                 maxSampleAge,
+                                                 maxKeepSamples,
+                                                 watcher,
+                                                 false,
+                                                 updateOnFirstWatch,
+                                                 shouldUpdateAllFields);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("AddFieldWatches of {} gpus and {} fields returned {}",
+                  (int)gpuIds.size(),
+                  (int)fieldIds.size(),
+                  (int)dcgmReturn);
+        return DCGM_ST_GENERIC_ERROR;
     }
 
     if (shouldUpdateAllFields)
@@ -4004,6 +4306,17 @@ dcgmReturn_t DcgmHostEngineHandler::RunServer(unsigned short portNumber,
 {
     dcgmReturn_t dcgmReturn;
 
+    /* Latency sensitive requests get more of the dispatches and the priority workers to themselves,
+       so a client flooding us with large reads or a diag run can't starve liveness probes */
+    DcgmIpcSchedulerParams_t schedulerParams {};
+    schedulerParams.classify                          = DcgmHostEngineHandler::ClassifyMessage;
+    schedulerParams.maxInFlightPerConnection          = GetIpcMaxInFlightPerConnection();
+    schedulerParams.maxSharedInFlight                 = DCGM_HE_NUM_WORKERS;
+    schedulerParams.weights[DCGM_IPC_PRIORITY_HIGH]   = 8;
+    schedulerParams.weights[DCGM_IPC_PRIORITY_NORMAL] = 4;
+    schedulerParams.weights[DCGM_IPC_PRIORITY_BULK]   = 1;
+    m_dcgmIpc.SetSchedulerParams(schedulerParams);
+
     if (isConnectionTCP)
     {
         DcgmIpcTcpServerParams_t tcpParams {};
@@ -4037,6 +4350,15 @@ dcgmReturn_t DcgmHostEngineHandler::RunServer(unsigned short portNumber,
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+void DcgmHostEngineHandler::StopFederation()
+{
+    if (m_federation)
+    {
+        m_federation->Stop();
+    }
+}
+
 /*****************************************************************************
  This method deletes the DCGM Host Engine Handler Instance
  *****************************************************************************/
@@ -4127,6 +4449,34 @@ std::string const &DcgmHostEngineHandler::GetServiceAccount() const
     return m_serviceAccount;
 }
 
+dcgmReturn_t DcgmHostEngineHandler::GetIpcQueueWait(dcgmIntrospectQueueWait_t *queueWait)
+{
+    static_assert(DCGM_INTROSPECT_QUEUE_CLASS_COUNT == DCGM_IPC_PRIORITY_COUNT);
+    static_assert(DCGM_INTROSPECT_QUEUE_CLASS_HIGH == DCGM_IPC_PRIORITY_HIGH);
+    static_assert(DCGM_INTROSPECT_QUEUE_CLASS_BULK == DCGM_IPC_PRIORITY_BULK);
+
+    if (queueWait == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (queueWait->version != dcgmIntrospectQueueWait_version1)
+    {
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    DcgmIpcSchedulerStats_t stats = m_dcgmIpc.GetSchedulerStats();
+    for (unsigned int i = 0; i < DCGM_INTROSPECT_QUEUE_CLASS_COUNT; i++)
+    {
+        queueWait->classes[i].numRequests   = stats.classes[i].numDispatched;
+        queueWait->classes[i].totalWaitUsec = stats.classes[i].totalWaitUsec;
+        queueWait->classes[i].maxWaitUsec   = stats.classes[i].maxWaitUsec;
+        queueWait->classes[i].numQueued     = stats.classes[i].numQueued;
+    }
+
+    return DCGM_ST_OK;
+}
+
 bool DcgmHostEngineHandler::UsingInjectionNvml() const
 {
     return m_usingInjectionNvml;
@@ -22,13 +22,17 @@
 
 #include "DcgmCacheManager.h"
 #include "DcgmCoreCommunication.h"
+#include "DcgmCycleRequestWaiter.h"
+#include "DcgmFederation.h"
 #include "DcgmFieldGroup.h"
+#include "DcgmFvChangeTracker.h"
 #include "DcgmGroupManager.h"
 #include "DcgmIpc.h"
 #include "DcgmModule.h"
 #include "DcgmRequest.h"
 #include "DcgmWatcher.h"
 #include "dcgm_agent.h"
+#include <atomic>
 #include <core/DcgmModuleCore.h>
 #include <dcgm_core_communication.h>
 #include <iostream>
@@ -65,6 +69,32 @@ private:
     static const int DCGM_HE_NUM_WORKERS = 2; /* How many worker threads to use for processing
                                                  user data */
 
+    static const unsigned int DCGM_HE_MAX_DEFAULT_IPC_REACTORS = 4; /* Upper bound of the default number of IPC
+                                                                       reactors (socket IO threads) */
+
+    /*****************************************************************************
+     * Get how many IPC reactors to spread client connections across. This defaults
+     * to one per 16 CPUs, capped at DCGM_HE_MAX_DEFAULT_IPC_REACTORS, and can be
+     * overridden with the __DCGM_IPC_NUM_REACTORS environment variable.
+     *****************************************************************************/
+    static unsigned int GetNumIpcReactors();
+
+    static const int DCGM_HE_NUM_PRIORITY_WORKERS = 1; /* Extra workers that only high priority requests like
+                                                          liveness probes and health checks can occupy */
+
+    /*****************************************************************************
+     * Get how many non-high priority requests a single client connection can have
+     * being processed at once. This defaults to unlimited (0) and can be set with
+     * the __DCGM_IPC_MAX_IN_FLIGHT_PER_CONNECTION environment variable.
+     *****************************************************************************/
+    static unsigned int GetIpcMaxInFlightPerConnection();
+
+    /*****************************************************************************
+     * Assign the priority class a client request is scheduled in by the module
+     * and subcommand it targets. Called from the IPC reactor threads
+     *****************************************************************************/
+    static DcgmIpcPriority_t ClassifyMessage(DcgmMessage &message);
+
 public:
     /*****************************************************************************
      * This method is used to initialize DCGM HostEngineHandler
@@ -122,6 +152,18 @@ public:
     dcgmReturn_t ProcessModuleCommandMsg(dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message);
     dcgmReturn_t ProcessModuleCommand(dcgm_module_command_header_t *moduleCommand);
 
+    /*****************************************************************************
+     Run the decoded module command of message and send the response to connectionId
+     *****************************************************************************/
+    void DispatchModuleCommandMsg(dcgm_connection_id_t connectionId,
+                                  std::unique_ptr<DcgmMessage> message,
+                                  bool compact);
+
+    /*****************************************************************************
+     Decode a DCGM_MSG_MODULE_COMMAND_COMPACT message body in place
+     *****************************************************************************/
+    dcgmReturn_t DecodeCompactModuleCommand(std::vector<char> &msgBytes);
+
     /*****************************************************************************
      Get the status for an entity
      *****************************************************************************/
@@ -194,6 +236,54 @@ public:
      *****************************************************************************/
     void OnMigUpdates(unsigned int gpuId);
 
+    /*****************************************************************************
+     Notify this object that the cache manager completed an update cycle.
+     *****************************************************************************/
+    void OnUpdateCycle(long long cycleId);
+
+    /*****************************************************************************
+     * Move the generations that client read-through caches validate against, and
+     * tell every subscribed remote client about it.
+     *
+     * configChanged IN: Whether groups, field groups or the MIG hierarchy changed.
+     *                   Field values are always considered changed.
+     *****************************************************************************/
+    void InvalidateClientCaches(bool configChanged);
+
+    /*****************************************************************************
+     * Subscribe a remote request to DCGM_MSG_CLIENT_CACHE_INVALIDATE notifications.
+     * Embedded clients read the generations with GetClientCacheGenerations() instead.
+     *****************************************************************************/
+    dcgmReturn_t AddClientCacheSubscriber(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId);
+
+    /*****************************************************************************
+     * Get the current generations that client read-through caches validate against
+     *****************************************************************************/
+    void GetClientCacheGenerations(long long &configGeneration, long long &valuesGeneration);
+
+    /*****************************************************************************
+     * Get the federation of downstream hostengines this hostengine aggregates.
+     * Returns nullptr if it isn't aggregating any. See DCGM_ENV_FEDERATION_NODES
+     *****************************************************************************/
+    DcgmFederation *GetFederation()
+    {
+        return m_federation.get();
+    }
+
+    /*****************************************************************************
+     * Get what was last sent to each reader of dcgmGetLatestValueChanges
+     *****************************************************************************/
+    DcgmFvChangeTracker &GetFvChangeTracker()
+    {
+        return m_fvChangeTracker;
+    }
+
+    /*****************************************************************************
+     * Stop mirroring downstream hostengines. This must be called without the
+     * DCGM globals lock held since the federation threads use the client API.
+     *****************************************************************************/
+    void StopFederation();
+
     /*****************************************************************************
      * Add a watcher to a local request. This watcher will be assigned a requestId
      * and will receive a ProcessMessage() call every time a message is sent from
@@ -303,6 +393,12 @@ public:
     void SetServiceAccount(const char *serviceAccout);
     std::string const &GetServiceAccount() const;
 
+    /*****************************************************************************
+     * Get how long client requests waited to be processed, by priority class.
+     * queueWait->version must already be set
+     *****************************************************************************/
+    dcgmReturn_t GetIpcQueueWait(dcgmIntrospectQueueWait_t *queueWait);
+
     bool UsingInjectionNvml() const;
 
     dcgmReturn_t NvmlInjectFieldValue(dcgm_field_eid_t gpuId, const nvmlFieldValue_t &value);
@@ -376,7 +472,7 @@ private:
     /*****************************************************************************
      * This method is get information for a field in the cache manager
      *****************************************************************************/
-    dcgmReturn_t GetCacheManagerFieldInfo(dcgmCacheManagerFieldInfo_v4_t *fieldInfo);
+    dcgmReturn_t GetCacheManagerFieldInfo(dcgmCacheManagerFieldInfo_v5_t *fieldInfo);
 
     /*****************************************************************************
      * This method is used to try to load a module of DCGM
@@ -488,7 +584,7 @@ private:
      Private Constructor and Destructor to achieve Singelton design
      *****************************************************************************/
     DcgmHostEngineHandler()
-        : m_dcgmIpc(DCGM_HE_NUM_WORKERS)
+        : m_dcgmIpc(DCGM_HE_NUM_WORKERS + DCGM_HE_NUM_PRIORITY_WORKERS, GetNumIpcReactors())
     {}
     explicit DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params);
     virtual ~DcgmHostEngineHandler();
@@ -527,6 +623,23 @@ private:
     typedef std::unordered_map<dcgm_request_id_t, std::unique_ptr<DcgmRequest>> watchedRequests_t;
     watchedRequests_t m_watchedRequests;
 
+    /* Client read-through cache generations and the remote requests to notify when they move.
+       m_clientCacheSubscribers is protected by m_clientCacheMutex rather than Lock() since it's
+       used from the cache manager's update thread */
+    std::atomic<long long> m_clientCacheConfigGeneration { 0 };
+    std::atomic<long long> m_clientCacheValuesGeneration { 0 };
+    std::mutex m_clientCacheMutex;
+    std::vector<std::pair<dcgm_connection_id_t, dcgm_request_id_t>> m_clientCacheSubscribers;
+
+    /* Latest values sent to each reader of dcgmGetLatestValueChanges. Has its own lock */
+    DcgmFvChangeTracker m_fvChangeTracker;
+
+    /* Cycle value requests that wait for an update cycle without holding up an IPC worker */
+    DcgmCycleRequestWaiter m_cycleRequestWaiter;
+
+    /* Downstream hostengines this hostengine aggregates. Set once in the constructor. nullptr if none */
+    std::unique_ptr<DcgmFederation> m_federation;
+
     unsigned int m_hostengineHealth {};
     std::string m_serviceAccount;
     bool m_usingInjectionNvml {};
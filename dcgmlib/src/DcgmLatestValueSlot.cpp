@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmLatestValueSlot.h"
+
+/* Initial capacity of a DcgmLatestValueIndex. Must be a power of 2 */
+#define DCGM_LATEST_VALUE_INDEX_MIN_CAPACITY 64
+
+/*****************************************************************************/
+DcgmLatestValueSlot::DcgmLatestValueSlot(DcgmLatestValueSlot const &other)
+{
+    *this = other;
+}
+
+/*****************************************************************************/
+DcgmLatestValueSlot &DcgmLatestValueSlot::operator=(DcgmLatestValueSlot const &other)
+{
+    if (this != &other)
+    {
+        DcgmLatestValue value;
+        if (other.Read(value))
+        {
+            Publish(value);
+        }
+        else
+        {
+            Clear();
+        }
+    }
+    return *this;
+}
+
+/*****************************************************************************/
+void DcgmLatestValueSlot::Publish(DcgmLatestValue const &value)
+{
+    unsigned long long const sequence = m_sequence.load(std::memory_order_relaxed);
+
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_tsType.store(value.tsType, std::memory_order_relaxed);
+    m_timestamp.store(value.timestamp, std::memory_order_relaxed);
+    m_valueInt64.store(value.valueInt64, std::memory_order_relaxed);
+    m_value2Int64.store(value.value2Int64, std::memory_order_relaxed);
+    m_valueDouble.store(value.valueDouble, std::memory_order_relaxed);
+    m_value2Double.store(value.value2Double, std::memory_order_relaxed);
+    m_isSet.store(true, std::memory_order_relaxed);
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/*****************************************************************************/
+void DcgmLatestValueSlot::Clear()
+{
+    unsigned long long const sequence = m_sequence.load(std::memory_order_relaxed);
+
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_isSet.store(false, std::memory_order_relaxed);
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/*****************************************************************************/
+bool DcgmLatestValueSlot::Read(DcgmLatestValue &value) const
+{
+    for (;;)
+    {
+        unsigned long long const before = m_sequence.load(std::memory_order_acquire);
+        if (before & 1)
+        {
+            /* An update is being written. It's only a few stores, so spin rather than yield */
+            continue;
+        }
+
+        bool const isSet   = m_isSet.load(std::memory_order_relaxed);
+        value.tsType       = m_tsType.load(std::memory_order_relaxed);
+        value.timestamp    = m_timestamp.load(std::memory_order_relaxed);
+        value.valueInt64   = m_valueInt64.load(std::memory_order_relaxed);
+        value.value2Int64  = m_value2Int64.load(std::memory_order_relaxed);
+        value.valueDouble  = m_valueDouble.load(std::memory_order_relaxed);
+        value.value2Double = m_value2Double.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) == before)
+        {
+            return isSet;
+        }
+    }
+}
+
+/*****************************************************************************/
+DcgmLatestValueIndex::DcgmLatestValueIndex()
+{
+    Clear();
+}
+
+/*****************************************************************************/
+static size_t HashLatestValueKey(std::uint64_t key)
+{
+    /* Finalizer of splitmix64. The fields of a watch key are small integers, so they need mixing */
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return (size_t)(key ^ (key >> 31));
+}
+
+/*****************************************************************************/
+DcgmLatestValueSlot *DcgmLatestValueIndex::Find(std::uint64_t key) const
+{
+    Table const *table = m_table.load(std::memory_order_acquire);
+    if (table == nullptr)
+    {
+        return nullptr;
+    }
+
+    /* Tables are never more than half full, so there's always an unused entry to stop at */
+    for (size_t i = HashLatestValueKey(key) & table->mask;; i = (i + 1) & table->mask)
+    {
+        Entry const &entry        = table->entries[i];
+        DcgmLatestValueSlot *slot = entry.slot.load(std::memory_order_acquire);
+        if (slot == nullptr)
+        {
+            return nullptr;
+        }
+        if (entry.key.load(std::memory_order_relaxed) == key)
+        {
+            return slot;
+        }
+    }
+}
+
+/*****************************************************************************/
+void DcgmLatestValueIndex::InsertIntoTable(Table &table, std::uint64_t key, DcgmLatestValueSlot *slot)
+{
+    for (size_t i = HashLatestValueKey(key) & table.mask;; i = (i + 1) & table.mask)
+    {
+        Entry &entry = table.entries[i];
+        if (entry.slot.load(std::memory_order_relaxed) == nullptr)
+        {
+            /* The key has to be visible before the slot that makes the entry used */
+            entry.key.store(key, std::memory_order_relaxed);
+            entry.slot.store(slot, std::memory_order_release);
+            table.size++;
+            return;
+        }
+    }
+}
+
+/*****************************************************************************/
+void DcgmLatestValueIndex::Insert(std::uint64_t key, DcgmLatestValueSlot *slot)
+{
+    if (slot == nullptr || Find(key) != nullptr)
+    {
+        return;
+    }
+
+    Table *table = m_table.load(std::memory_order_relaxed);
+
+    if ((table->size + 1) * 2 > table->mask + 1)
+    {
+        /* Readers that already loaded the old table keep probing it, so it stays in m_tables */
+        auto bigger = std::make_unique<Table>((table->mask + 1) * 2);
+        for (size_t i = 0; i <= table->mask; i++)
+        {
+            DcgmLatestValueSlot *existing = table->entries[i].slot.load(std::memory_order_relaxed);
+            if (existing != nullptr)
+            {
+                InsertIntoTable(*bigger, table->entries[i].key.load(std::memory_order_relaxed), existing);
+            }
+        }
+
+        table = bigger.get();
+        m_tables.push_back(std::move(bigger));
+        m_table.store(table, std::memory_order_release);
+    }
+
+    InsertIntoTable(*table, key, slot);
+}
+
+/*****************************************************************************/
+void DcgmLatestValueIndex::Clear()
+{
+    auto table = std::make_unique<Table>(DCGM_LATEST_VALUE_INDEX_MIN_CAPACITY);
+    m_table.store(table.get(), std::memory_order_release);
+
+    m_tables.clear();
+    m_tables.push_back(std::move(table));
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <timelib.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*****************************************************************************/
+/* A value read out of a DcgmLatestValueSlot */
+struct DcgmLatestValue
+{
+    int tsType;            /* TS_TYPE_INT64 or TS_TYPE_DOUBLE */
+    timelib64_t timestamp; /* usec since 1970 */
+    long long valueInt64;  /* Value if tsType is TS_TYPE_INT64 */
+    long long value2Int64; /* Second value if tsType is TS_TYPE_INT64 */
+    double valueDouble;    /* Value if tsType is TS_TYPE_DOUBLE */
+    double value2Double;   /* Second value if tsType is TS_TYPE_DOUBLE */
+};
+
+/*****************************************************************************/
+/*
+ * Latest int64 or double sample of one watch, readable without the cache
+ * manager's lock.
+ *
+ * The slot is a seqlock. There is a single writer at a time, the cache manager
+ * with m_mutex held, which makes the sequence odd while it writes the value.
+ * Readers copy the value and retry if the sequence was odd or changed under them,
+ * so a read never blocks the writer and never sees half of an update.
+ */
+class DcgmLatestValueSlot
+{
+public:
+    DcgmLatestValueSlot() = default;
+
+    /* Copies take a snapshot of the other slot's value. Used when copying a whole watch */
+    DcgmLatestValueSlot(DcgmLatestValueSlot const &other);
+    DcgmLatestValueSlot &operator=(DcgmLatestValueSlot const &other);
+
+    /*************************************************************************/
+    /* Publish a new latest value. Callers must be serialized */
+    void Publish(DcgmLatestValue const &value);
+
+    /*************************************************************************/
+    /* Mark the slot empty. Callers must be serialized with Publish() */
+    void Clear();
+
+    /*************************************************************************/
+    /*
+     * Copy out the latest value
+     *
+     * Returns true if value was set
+     *         false if the slot is empty
+     */
+    bool Read(DcgmLatestValue &value) const;
+
+private:
+    std::atomic<unsigned long long> m_sequence { 0 }; /* Odd while an update is being written */
+    std::atomic<bool> m_isSet { false };
+    std::atomic<int> m_tsType { 0 };
+    std::atomic<long long> m_timestamp { 0 };
+    std::atomic<long long> m_valueInt64 { 0 };
+    std::atomic<long long> m_value2Int64 { 0 };
+    std::atomic<double> m_valueDouble { 0.0 };
+    std::atomic<double> m_value2Double { 0.0 };
+};
+
+/*****************************************************************************/
+/*
+ * Map of watch keys to their DcgmLatestValueSlot that can be read without a lock.
+ *
+ * This is an open-addressed table with linear probing. Slots are only ever
+ * added and must outlive the index. Inserts must be serialized by the caller.
+ * When the table gets half full, it's copied to one twice as big and the new
+ * table is published with a single store. Readers may still be probing the old
+ * table, so it is kept until Clear(). Retired tables add up to less than the
+ * current one.
+ */
+class DcgmLatestValueIndex
+{
+public:
+    DcgmLatestValueIndex();
+
+    /*************************************************************************/
+    /* Returns the slot of key, or nullptr if it was never inserted */
+    DcgmLatestValueSlot *Find(std::uint64_t key) const;
+
+    /*************************************************************************/
+    /* Add the slot of key. Does nothing if key is already in the index */
+    void Insert(std::uint64_t key, DcgmLatestValueSlot *slot);
+
+    /*************************************************************************/
+    /*
+     * Remove every key. Readers must be done with the index, since this frees
+     * the tables they probe
+     */
+    void Clear();
+
+private:
+    struct Entry
+    {
+        std::atomic<std::uint64_t> key { 0 };
+        std::atomic<DcgmLatestValueSlot *> slot { nullptr }; /* nullptr = unused. Set after key */
+    };
+
+    struct Table
+    {
+        explicit Table(size_t capacity)
+            : entries(new Entry[capacity])
+            , mask(capacity - 1)
+        {}
+
+        std::unique_ptr<Entry[]> entries;
+        size_t mask; /* Capacity - 1. Capacity is a power of 2 */
+        size_t size = 0;
+    };
+
+    static void InsertIntoTable(Table &table, std::uint64_t key, DcgmLatestValueSlot *slot);
+
+    std::atomic<Table *> m_table { nullptr };   /* Table readers probe */
+    std::vector<std::unique_ptr<Table>> m_tables; /* Every table ever published. The last one is m_table */
+};
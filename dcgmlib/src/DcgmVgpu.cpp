@@ -22,6 +22,9 @@
 #include "dcgm_structs_internal.h"
 #include <DcgmStringHelpers.h>
 
+#include <algorithm>
+#include <iterator>
+
 /*****************************************************************************/
 static std::string_view ConvertNvmlGridLicenseStateToString(unsigned int licenseState)
 {
@@ -144,66 +147,137 @@ dcgmReturn_t GetDeviceFBCSessionsInfo(DcgmCacheManager &cm,
     return DCGM_ST_OK;
 }
 
-dcgmReturn_t GetVgpuInstanceFBCSessionsInfo(DcgmCacheManager &cm,
-                                            nvmlVgpuInstance_t vgpuId,
-                                            dcgmcm_update_thread_t *threadCtx,
-                                            dcgmcm_watch_info_p watchInfo,
-                                            timelib64_t now,
-                                            timelib64_t expireTime)
+/*****************************************************************************/
+void FetchVgpuSessions(nvmlDevice_t nvmlDevice, dcgmcm_vgpu_sessions_t &sessions)
 {
-    dcgmDeviceFbcSessions_t *vgpuFbcSessions = NULL;
-    nvmlFBCSessionInfo_t *sessionInfo        = NULL;
-    unsigned int i, sessionCount = 0;
-    nvmlReturn_t nvmlReturn;
+    unsigned int sessionCount = 0;
 
-    vgpuFbcSessions = (dcgmDeviceFbcSessions_t *)malloc(sizeof(*vgpuFbcSessions));
-    if (!vgpuFbcSessions)
+    sessions.encSessionsStatus = nvmlDeviceGetEncoderSessions(nvmlDevice, &sessionCount, nullptr);
+    if (sessions.encSessionsStatus == NVML_SUCCESS && sessionCount != 0)
     {
-        log_error("malloc of {} bytes failed", (int)(sizeof(*vgpuFbcSessions)));
-        return DCGM_ST_MEMORY;
+        sessions.encSessions.resize(sessionCount);
+        sessions.encSessionsStatus
+            = nvmlDeviceGetEncoderSessions(nvmlDevice, &sessionCount, sessions.encSessions.data());
     }
+    sessions.encSessions.resize(sessions.encSessionsStatus == NVML_SUCCESS ? sessionCount : 0);
 
-    nvmlReturn = nvmlVgpuInstanceGetFBCSessions(vgpuId, &sessionCount, NULL);
-    if (watchInfo)
-        watchInfo->lastStatus = nvmlReturn;
+    sessionCount               = 0;
+    sessions.fbcSessionsStatus = nvmlDeviceGetFBCSessions(nvmlDevice, &sessionCount, nullptr);
+    if (sessions.fbcSessionsStatus == NVML_SUCCESS && sessionCount != 0)
+    {
+        sessions.fbcSessions.resize(sessionCount);
+        sessions.fbcSessionsStatus = nvmlDeviceGetFBCSessions(nvmlDevice, &sessionCount, sessions.fbcSessions.data());
+    }
+    sessions.fbcSessions.resize(sessions.fbcSessionsStatus == NVML_SUCCESS ? sessionCount : 0);
+}
+
+/*****************************************************************************/
+/* Get the encoder sessions of vgpuId, preferably from this cycle's per-GPU query */
+static nvmlReturn_t GetVgpuInstanceEncoderSessions(DcgmCacheManager &cm,
+                                                   nvmlVgpuInstance_t vgpuId,
+                                                   std::vector<nvmlEncoderSessionInfo_t> &sessionInfo)
+{
+    dcgmcm_vgpu_sessions_t const *gpuSessions = cm.GetVgpuSessionsForCycle(vgpuId);
+    if (gpuSessions != nullptr && gpuSessions->encSessionsStatus == NVML_SUCCESS)
+    {
+        std::copy_if(gpuSessions->encSessions.begin(),
+                     gpuSessions->encSessions.end(),
+                     std::back_inserter(sessionInfo),
+                     [vgpuId](nvmlEncoderSessionInfo_t const &session) { return session.vgpuInstance == vgpuId; });
+        return NVML_SUCCESS;
+    }
 
+    /* Fall back to asking about just this vGPU instance */
+    unsigned int sessionCount = 0;
+    nvmlReturn_t nvmlReturn   = nvmlVgpuInstanceGetEncoderSessions(vgpuId, &sessionCount, nullptr);
     if (nvmlReturn != NVML_SUCCESS || sessionCount == 0)
     {
-        vgpuFbcSessions->version      = dcgmDeviceFbcSessions_version;
-        vgpuFbcSessions->sessionCount = 0;
-        int payloadSize               = sizeof(*vgpuFbcSessions) - sizeof(vgpuFbcSessions->sessionInfo);
-        cm.AppendEntityBlob(threadCtx, vgpuFbcSessions, payloadSize, now, expireTime);
-        free(vgpuFbcSessions);
-        return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+        return nvmlReturn;
     }
 
-    sessionInfo = (nvmlFBCSessionInfo_t *)malloc(sizeof(*sessionInfo) * (sessionCount));
-    if (!sessionInfo)
+    sessionInfo.resize(sessionCount);
+    nvmlReturn = nvmlVgpuInstanceGetEncoderSessions(vgpuId, &sessionCount, sessionInfo.data());
+    if (nvmlReturn != NVML_SUCCESS)
     {
-        log_error("malloc of {} bytes failed", (int)(sizeof(*sessionInfo) * (sessionCount)));
-        free(vgpuFbcSessions);
-        return DCGM_ST_MEMORY;
+        DCGM_LOG_ERROR << fmt::format("nvmlVgpuInstanceGetEncoderSessions failed for vgpuId {} with status ({}){}",
+                                      vgpuId,
+                                      nvmlReturn,
+                                      nvmlErrorString(nvmlReturn));
+        sessionInfo.clear();
+        return nvmlReturn;
     }
 
-    nvmlReturn = nvmlVgpuInstanceGetFBCSessions(vgpuId, &sessionCount, sessionInfo);
-    if (watchInfo)
-        watchInfo->lastStatus = nvmlReturn;
+    sessionInfo.resize(sessionCount);
+    return NVML_SUCCESS;
+}
+
+/*****************************************************************************/
+/* Get the FBC sessions of vgpuId, preferably from this cycle's per-GPU query */
+static nvmlReturn_t GetVgpuInstanceFBCSessions(DcgmCacheManager &cm,
+                                               nvmlVgpuInstance_t vgpuId,
+                                               std::vector<nvmlFBCSessionInfo_t> &sessionInfo)
+{
+    dcgmcm_vgpu_sessions_t const *gpuSessions = cm.GetVgpuSessionsForCycle(vgpuId);
+    if (gpuSessions != nullptr && gpuSessions->fbcSessionsStatus == NVML_SUCCESS)
+    {
+        std::copy_if(gpuSessions->fbcSessions.begin(),
+                     gpuSessions->fbcSessions.end(),
+                     std::back_inserter(sessionInfo),
+                     [vgpuId](nvmlFBCSessionInfo_t const &session) { return session.vgpuInstance == vgpuId; });
+        return NVML_SUCCESS;
+    }
+
+    /* Fall back to asking about just this vGPU instance */
+    unsigned int sessionCount = 0;
+    nvmlReturn_t nvmlReturn   = nvmlVgpuInstanceGetFBCSessions(vgpuId, &sessionCount, nullptr);
+    if (nvmlReturn != NVML_SUCCESS || sessionCount == 0)
+    {
+        return nvmlReturn;
+    }
+
+    sessionInfo.resize(sessionCount);
+    nvmlReturn = nvmlVgpuInstanceGetFBCSessions(vgpuId, &sessionCount, sessionInfo.data());
     if (nvmlReturn != NVML_SUCCESS)
     {
         log_error("nvmlVgpuInstanceGetFBCSessions failed with status {} for vgpuId {}", (int)nvmlReturn, vgpuId);
-        free(sessionInfo);
-        free(vgpuFbcSessions);
-        return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+        sessionInfo.clear();
+        return nvmlReturn;
     }
 
-    vgpuFbcSessions->version      = dcgmDeviceFbcSessions_version;
-    vgpuFbcSessions->sessionCount = sessionCount;
+    sessionInfo.resize(sessionCount);
+    return NVML_SUCCESS;
+}
 
-    for (i = 0; i < sessionCount; i++)
+/*****************************************************************************/
+dcgmReturn_t GetVgpuInstanceFBCSessionsInfo(DcgmCacheManager &cm,
+                                            nvmlVgpuInstance_t vgpuId,
+                                            dcgmcm_update_thread_t *threadCtx,
+                                            dcgmcm_watch_info_p watchInfo,
+                                            timelib64_t now,
+                                            timelib64_t expireTime)
+{
+    std::vector<nvmlFBCSessionInfo_t> sessionInfo;
+
+    auto vgpuFbcSessions     = std::make_unique<dcgmDeviceFbcSessions_t>();
+    vgpuFbcSessions->version = dcgmDeviceFbcSessions_version;
+
+    nvmlReturn_t nvmlReturn = GetVgpuInstanceFBCSessions(cm, vgpuId, sessionInfo);
+    if (watchInfo)
+        watchInfo->lastStatus = nvmlReturn;
+
+    if (nvmlReturn != NVML_SUCCESS || sessionInfo.empty())
     {
-        if (vgpuFbcSessions->sessionCount >= DCGM_MAX_FBC_SESSIONS)
-            break; /* Don't overflow data structure */
+        vgpuFbcSessions->sessionCount = 0;
+        int payloadSize               = sizeof(*vgpuFbcSessions) - sizeof(vgpuFbcSessions->sessionInfo);
+        cm.AppendEntityBlob(threadCtx, vgpuFbcSessions.get(), payloadSize, now, expireTime);
+        return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+    }
 
+    /* Don't overflow data structure */
+    vgpuFbcSessions->sessionCount = std::min<unsigned int>(sessionInfo.size(), DCGM_MAX_FBC_SESSIONS);
+
+    for (unsigned int i = 0; i < vgpuFbcSessions->sessionCount; i++)
+    {
         vgpuFbcSessions->sessionInfo[i].version        = dcgmDeviceFbcSessionInfo_version;
         vgpuFbcSessions->sessionInfo[i].vgpuId         = sessionInfo[i].vgpuInstance;
         vgpuFbcSessions->sessionInfo[i].sessionId      = sessionInfo[i].sessionId;
@@ -223,9 +297,7 @@ dcgmReturn_t GetVgpuInstanceFBCSessionsInfo(DcgmCacheManager &cm,
     int payloadSize = (sizeof(*vgpuFbcSessions) - sizeof(vgpuFbcSessions->sessionInfo))
                       + (vgpuFbcSessions->sessionCount * sizeof(vgpuFbcSessions->sessionInfo[0]));
 
-    cm.AppendEntityBlob(threadCtx, vgpuFbcSessions, payloadSize, now, expireTime);
-    free(sessionInfo);
-    free(vgpuFbcSessions);
+    cm.AppendEntityBlob(threadCtx, vgpuFbcSessions.get(), payloadSize, now, expireTime);
     return DCGM_ST_OK;
 }
 
@@ -593,20 +665,19 @@ dcgmReturn_t BufferOrCacheLatestVgpuValue(DcgmCacheManager &cm,
         case DCGM_FI_DEV_VGPU_ENC_SESSIONS_INFO:
         {
             std::unique_ptr<dcgmDeviceVgpuEncSessions_t[]> vgpuEncSessionsInfo;
-            std::unique_ptr<nvmlEncoderSessionInfo_t[]> sessionInfo;
-            unsigned int sessionCount = 0;
+            std::vector<nvmlEncoderSessionInfo_t> sessionInfo;
 
-            nvmlReturn = nvmlVgpuInstanceGetEncoderSessions(vgpuId, &sessionCount, nullptr);
+            nvmlReturn = GetVgpuInstanceEncoderSessions(cm, vgpuId, sessionInfo);
             if (watchInfo != nullptr)
             {
                 watchInfo->lastStatus = nvmlReturn;
             }
 
-            sessionInfo         = std::make_unique<nvmlEncoderSessionInfo_t[]>(sessionCount);
-            vgpuEncSessionsInfo = std::make_unique<dcgmDeviceVgpuEncSessions_t[]>(sessionCount + 1);
+            unsigned int sessionCount = sessionInfo.size();
+            vgpuEncSessionsInfo       = std::make_unique<dcgmDeviceVgpuEncSessions_t[]>(sessionCount + 1);
 
             /* Initialize the first session object since the code below only updates index 1 and beyond */
-            memset(vgpuEncSessionsInfo.get(), 0, sizeof(nvmlEncoderSessionInfo_t));
+            memset(vgpuEncSessionsInfo.get(), 0, sizeof(dcgmDeviceVgpuEncSessions_t));
             vgpuEncSessionsInfo[0].version = dcgmDeviceVgpuEncSessions_version;
 
             if (nvmlReturn != NVML_SUCCESS)
@@ -617,24 +688,6 @@ dcgmReturn_t BufferOrCacheLatestVgpuValue(DcgmCacheManager &cm,
                 return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
             }
 
-            if (sessionCount != 0)
-            {
-                nvmlReturn = nvmlVgpuInstanceGetEncoderSessions(vgpuId, &sessionCount, sessionInfo.get());
-                if (watchInfo != nullptr)
-                {
-                    watchInfo->lastStatus = nvmlReturn;
-                }
-                if (nvmlReturn != NVML_SUCCESS)
-                {
-                    DCGM_LOG_ERROR << fmt::format(
-                        "nvmlVgpuInstanceGetEncoderSessions failed for vgpuId {} with status ({}){}",
-                        vgpuId,
-                        nvmlReturn,
-                        nvmlErrorString(nvmlReturn));
-                    return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
-                }
-            }
-
             /* First element of the array holds the count */
             vgpuEncSessionsInfo[0].encoderSessionInfo.sessionCount = sessionCount;
 
@@ -36,13 +36,21 @@ dcgmReturn_t GetDeviceFBCSessionsInfo(DcgmCacheManager &cm,
                                       timelib64_t now,
                                       timelib64_t expireTime);
 
-dcgmReturn_t GetVgpuInstanceFBCSessionsInfo(DcgmCacheManager *cm,
+dcgmReturn_t GetVgpuInstanceFBCSessionsInfo(DcgmCacheManager &cm,
                                             nvmlVgpuInstance_t vgpuId,
                                             dcgmcm_update_thread_t *threadCtx,
                                             dcgmcm_watch_info_p watchInfo,
                                             timelib64_t now,
                                             timelib64_t expireTime);
 
+/*************************************************************************/
+/*
+ * Query the encoder and FBC sessions of every vGPU instance on a GPU at once. Failures are
+ * recorded in the status members of sessions rather than returned
+ *
+ */
+void FetchVgpuSessions(nvmlDevice_t nvmlDevice, dcgmcm_vgpu_sessions_t &sessions);
+
 /*************************************************************************/
 /*
  * Cache or buffer the latest value for a watched vGPU field
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch.hpp>
+
+#include <DcgmCacheMemoryPool.h>
+#include <timeseries.h>
+
+#include <cstring>
+#include <vector>
+
+TEST_CASE("CacheMemoryPool: Blocks are reused")
+{
+    DcgmCacheMemoryPool pool(-1, DCGM_CM_HUGEPAGES_TRANSPARENT, KV_DEFAULT_SUBBLOCK_SIZE);
+
+    void *block1 = pool.Allocate(KV_DEFAULT_SUBBLOCK_SIZE);
+    void *block2 = pool.Allocate(KV_DEFAULT_SUBBLOCK_SIZE);
+    REQUIRE(block1 != nullptr);
+    REQUIRE(block2 != nullptr);
+    CHECK(block1 != block2);
+    memset(block1, 0xAB, KV_DEFAULT_SUBBLOCK_SIZE);
+
+    DcgmCacheMemoryPool::Stats stats = pool.GetStats();
+    CHECK(stats.bytesReserved == DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE);
+    CHECK(stats.bytesInUse == 2 * KV_DEFAULT_SUBBLOCK_SIZE);
+    CHECK(stats.heapFallbacks == 0);
+
+    pool.Free(block1, KV_DEFAULT_SUBBLOCK_SIZE);
+    CHECK(pool.Allocate(KV_DEFAULT_SUBBLOCK_SIZE) == block1);
+
+    /* Other sizes come from the heap */
+    void *other = pool.Allocate(16);
+    REQUIRE(other != nullptr);
+    CHECK(pool.GetStats().heapFallbacks == 1);
+    pool.Free(other, 16);
+
+    pool.Free(block1, KV_DEFAULT_SUBBLOCK_SIZE);
+    pool.Free(block2, KV_DEFAULT_SUBBLOCK_SIZE);
+    CHECK(pool.GetStats().bytesInUse == 0);
+}
+
+TEST_CASE("CacheMemoryPool: Timeseries stored in a pool")
+{
+    DcgmCacheMemoryPool pool(-1, DCGM_CM_HUGEPAGES_TRANSPARENT, KV_DEFAULT_SUBBLOCK_SIZE);
+
+    int errorSt     = 0;
+    timeseries_p ts = timeseries_alloc_with_allocator(TS_TYPE_INT64, pool.GetKvAllocator(), &errorSt);
+    REQUIRE(ts != nullptr);
+
+    /* Enough samples to need more than one chunk */
+    int const numSamples = 2 * DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE / sizeof(timeseries_entry_t);
+    for (int i = 0; i < numSamples; i++)
+    {
+        REQUIRE(timeseries_insert_int64(ts, i + 1, i, 0) == TS_ST_OK);
+    }
+
+    CHECK(timeseries_size(ts) == numSamples);
+
+    DcgmCacheMemoryPool::Stats stats = pool.GetStats();
+    CHECK(stats.bytesReserved > DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE);
+    CHECK(stats.bytesInUse == (long long)ts->keyedVector->Nblocks * KV_DEFAULT_SUBBLOCK_SIZE);
+    CHECK(stats.heapFallbacks == 0);
+
+    timeseries_destroy(ts);
+    stats = pool.GetStats();
+    CHECK(stats.bytesInUse == 0);
+
+    /* Only the newest chunk is left mapped */
+    CHECK(stats.bytesReserved == DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE);
+    CHECK(stats.chunksUnmapped > 0);
+}
+
+TEST_CASE("CacheMemoryPool: Chunks are unmapped once they are free")
+{
+    size_t const blockSize      = 64 * 1024;
+    size_t const blocksPerChunk = DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE / blockSize;
+    DcgmCacheMemoryPool pool(-1, DCGM_CM_HUGEPAGES_TRANSPARENT, blockSize);
+
+    /* Three full chunks */
+    std::vector<void *> blocks;
+    for (size_t i = 0; i < 3 * blocksPerChunk; i++)
+    {
+        blocks.push_back(pool.Allocate(blockSize));
+        REQUIRE(blocks.back() != nullptr);
+    }
+    REQUIRE(pool.GetStats().bytesReserved == 3 * DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE);
+
+    /* Emptying the first chunk gives it back. Half of the second one stays in use */
+    for (size_t i = 0; i < blocksPerChunk + blocksPerChunk / 2; i++)
+    {
+        pool.Free(blocks[i], blockSize);
+    }
+
+    DcgmCacheMemoryPool::Stats stats = pool.GetStats();
+    CHECK(stats.chunksUnmapped == 1);
+    CHECK(stats.bytesReserved == 2 * DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE);
+    CHECK(stats.bytesInUse == (long long)(blocksPerChunk + blocksPerChunk / 2) * (long long)blockSize);
+
+    /* The second chunk's free blocks are used before anything new is mapped */
+    std::vector<void *> refill;
+    for (size_t i = 0; i < blocksPerChunk / 2; i++)
+    {
+        refill.push_back(pool.Allocate(blockSize));
+        REQUIRE(refill.back() != nullptr);
+        memset(refill.back(), 0xAB, blockSize);
+    }
+    CHECK(pool.GetStats().bytesReserved == 2 * DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE);
+
+    /* The newest chunk stays mapped even once it is empty */
+    for (size_t i = 2 * blocksPerChunk; i < blocks.size(); i++)
+    {
+        pool.Free(blocks[i], blockSize);
+    }
+    CHECK(pool.GetStats().chunksUnmapped == 1);
+
+    for (size_t i = blocksPerChunk + blocksPerChunk / 2; i < 2 * blocksPerChunk; i++)
+    {
+        pool.Free(blocks[i], blockSize);
+    }
+    for (void *block : refill)
+    {
+        pool.Free(block, blockSize);
+    }
+
+    stats = pool.GetStats();
+    CHECK(stats.bytesInUse == 0);
+    CHECK(stats.chunksUnmapped == 2);
+    CHECK(stats.bytesReserved == DCGM_CACHE_MEMORY_POOL_CHUNK_SIZE);
+}
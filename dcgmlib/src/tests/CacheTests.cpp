@@ -18,7 +18,13 @@
 #include <sstream>
 
 #include <DcgmCacheManager.h>
+#include <DcgmCoreCommunication.h>
+#include <DcgmCoreProxy.h>
+#include <DcgmGroupManager.h>
 #include <Defer.hpp>
+#include <TimeLib.hpp>
+
+using DcgmNs::Timelib::VirtualClock;
 
 #if defined(NV_VMWARE)
 /* No. of iterations corresponding to different sample set of vgpuIds */
@@ -133,6 +139,268 @@ TEST_CASE("CacheManager: Test VgpuManageList")
 }
 #endif
 
+TEST_CASE("CacheManager: vGPU instances are tracked per GPU")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuIds[2];
+    gpuIds[0] = cm.AddFakeGpu();
+    gpuIds[1] = cm.AddFakeGpu();
+
+    /* First element is the count */
+    nvmlVgpuInstance_t firstGpuVgpus[]  = { 3, 11, 41, 52 };
+    nvmlVgpuInstance_t secondGpuVgpus[] = { 2, 8, 32 };
+    REQUIRE(cm.ManageVgpuList(gpuIds[0], firstGpuVgpus) == DCGM_ST_OK);
+    REQUIRE(cm.ManageVgpuList(gpuIds[1], secondGpuVgpus) == DCGM_ST_OK);
+
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 41) == gpuIds[0]);
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 32) == gpuIds[1]);
+    CHECK(cm.GetIsValidEntityId(DCGM_FE_VGPU, 52));
+    CHECK(!cm.GetIsValidEntityId(DCGM_FE_VGPU, 99));
+
+    /* 41 and 52 went away and 61 showed up. Passing the same list again is a no-op */
+    nvmlVgpuInstance_t refreshedVgpus[] = { 2, 61, 11 };
+    REQUIRE(cm.ManageVgpuList(gpuIds[0], refreshedVgpus) == DCGM_ST_OK);
+    REQUIRE(cm.ManageVgpuList(gpuIds[0], refreshedVgpus) == DCGM_ST_OK);
+
+    CHECK(!cm.GetGpuIdForEntity(DCGM_FE_VGPU, 41).has_value());
+    CHECK(!cm.GetIsValidEntityId(DCGM_FE_VGPU, 52));
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 61) == gpuIds[0]);
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 11) == gpuIds[0]);
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 8) == gpuIds[1]);
+
+    /* An empty list removes every vGPU instance on the GPU */
+    nvmlVgpuInstance_t noVgpus[] = { 0 };
+    REQUIRE(cm.ManageVgpuList(gpuIds[1], noVgpus) == DCGM_ST_OK);
+    CHECK(!cm.GetIsValidEntityId(DCGM_FE_VGPU, 8));
+    CHECK(!cm.GetIsValidEntityId(DCGM_FE_VGPU, 32));
+}
+
+TEST_CASE("CacheManager: Samples as of a timestamp")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    /* Recent enough that none of the samples is older than the default max age */
+    timelib64_t const baseTs = timelib_usecSince1970() - 3000;
+
+    dcgmcm_sample_t sample {};
+    for (long long i = 1; i <= 3; i++)
+    {
+        sample.timestamp = baseTs + i * 1000;
+        sample.val.i64   = i;
+        REQUIRE(cm.InjectSamples(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, &sample, 1) == DCGM_ST_OK);
+    }
+
+    dcgmcm_sample_t latest {};
+    REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, &latest, nullptr) == DCGM_ST_OK);
+    CHECK(latest.val.i64 == 3);
+
+    REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, &latest, nullptr, baseTs + 2500)
+            == DCGM_ST_OK);
+    CHECK(latest.val.i64 == 2);
+    CHECK(latest.timestamp == baseTs + 2000);
+
+    REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, &latest, nullptr, baseTs + 1000)
+            == DCGM_ST_OK);
+    CHECK(latest.val.i64 == 1);
+
+    /* Every sample is newer */
+    CHECK(cm.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, &latest, nullptr, baseTs + 999)
+          == DCGM_ST_NO_DATA);
+}
+
+TEST_CASE("CacheManager: Samples expire on a virtual clock")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    timelib64_t const startUsec = 1000000000000LL;
+    VirtualClock::Install(startUsec, false);
+    DcgmNs::Defer clockDefer([] { VirtualClock::Uninstall(); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    /* A day of samples every 10 minutes. Only the ones within the default max age are kept */
+    timelib64_t const interval = DcgmNs::Timelib::ToLegacyTimestamp(std::chrono::minutes(10));
+    dcgmcm_sample_t sample {};
+    for (long long i = 0; i < 24 * 6; i++)
+    {
+        sample.timestamp = timelib_usecSince1970();
+        sample.val.i64   = i;
+        REQUIRE(cm.InjectSamples(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, &sample, 1) == DCGM_ST_OK);
+        VirtualClock::Advance(std::chrono::microseconds(interval));
+    }
+
+    CHECK(timelib_usecSince1970() == startUsec + 24 * 6 * interval);
+
+    dcgmCacheManagerFieldInfo_v5_t fieldInfo {};
+    fieldInfo.version       = dcgmCacheManagerFieldInfo_version5;
+    fieldInfo.entityGroupId = DCGM_FE_GPU;
+    fieldInfo.entityId      = gpuId;
+    fieldInfo.fieldId       = DCGM_FI_DEV_GPU_TEMP;
+    REQUIRE(cm.GetCacheManagerFieldInfo(&fieldInfo) == DCGM_ST_OK);
+    CHECK(fieldInfo.numSamples == 1);
+    CHECK(fieldInfo.newestTimestamp == startUsec + (24 * 6 - 1) * interval);
+}
+
+TEST_CASE("CacheManager: Samples for a cycle time out without an update thread")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuId = cm.AddFakeGpu();
+    CHECK(cm.GetLastCompletedCycleId() == 0);
+
+    std::vector<dcgmGroupEntityPair_t> entities = { { DCGM_FE_GPU, gpuId } };
+    std::vector<unsigned short> fieldIds        = { DCGM_FI_DEV_GPU_TEMP };
+    DcgmFvBuffer fvBuffer;
+    long long cycleId = 0;
+
+    CHECK(cm.GetMultipleSamplesForCycle(entities, fieldIds, cycleId, 10, &fvBuffer) == DCGM_ST_TIMEOUT);
+    CHECK(cycleId == 0);
+
+    cycleId = -1;
+    CHECK(cm.GetMultipleSamplesForCycle(entities, fieldIds, cycleId, 0, &fvBuffer) == DCGM_ST_BADPARAM);
+    cycleId = 0;
+    CHECK(cm.GetMultipleSamplesForCycle(entities, fieldIds, cycleId, 0, nullptr) == DCGM_ST_BADPARAM);
+}
+
+TEST_CASE("CacheManager: Forced updates coalesce onto a queued cycle")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    cm.SetForcedUpdateMinSpacing(0);
+
+    /* Without an update thread, the first request's cycle stays queued, so later requests attach to it */
+    CHECK(cm.UpdateAllFields(0) == DCGM_ST_OK);
+    CHECK(cm.UpdateAllFields(0) == DCGM_ST_OK);
+    CHECK(cm.UpdateAllFields(0, true) == DCGM_ST_OK);
+
+    dcgmcm_forced_update_stats_t stats = cm.GetForcedUpdateStats();
+    CHECK(stats.numRequests == 3);
+    CHECK(stats.numExecuted == 0);
+    CHECK(stats.numCoalesced == 2);
+    CHECK(stats.numSkipped == 0);
+    CHECK(stats.minSpacingUsec == 0);
+
+    cm.SetForcedUpdateMinSpacing(-5);
+    CHECK(cm.GetForcedUpdateStats().minSpacingUsec == 0);
+    cm.SetForcedUpdateMinSpacing(250000);
+    CHECK(cm.GetForcedUpdateStats().minSpacingUsec == 250000);
+}
+
+TEST_CASE("CacheManager: Forced updates from modules always run a fresh cycle")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+    DcgmGroupManager gm(&cm, false);
+    DcgmCoreCommunication coreCommunication;
+    coreCommunication.Init(&cm, &gm);
+    DcgmCoreProxy coreProxy({ dcgmCoreCallbacks_version, PostRequestToCore, &coreCommunication, nullptr });
+
+    REQUIRE(cm.Start() == DCGM_ST_OK);
+
+    /* Long enough that every client request is satisfied by the last cycle */
+    cm.SetForcedUpdateMinSpacing(3600LL * 1000000);
+
+    REQUIRE(cm.UpdateAllFields(1) == DCGM_ST_OK);
+    long long cycleId = cm.GetLastCompletedCycleId();
+    REQUIRE(cycleId > 0);
+
+    REQUIRE(cm.UpdateAllFields(1, true) == DCGM_ST_OK);
+    CHECK(cm.GetLastCompletedCycleId() == cycleId);
+
+    /* Modules ask for values that are newer than their request */
+    for (int i = 0; i < 3; i++)
+    {
+        REQUIRE(coreProxy.UpdateAllFields(1) == DCGM_ST_OK);
+        CHECK(cm.GetLastCompletedCycleId() > cycleId);
+        cycleId = cm.GetLastCompletedCycleId();
+    }
+}
+
+TEST_CASE("CacheManager: Samples are evicted to stay within the memory budget")
+{
+    int const numSamples = 2000;
+
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    CHECK(cm.SetCacheMemoryBudget(-1) == DCGM_ST_BADPARAM);
+
+    /* Recent enough that none of the samples is older than the default max age */
+    timelib64_t const baseTs = timelib_usecSince1970() - numSamples * 1000;
+
+    dcgmcm_sample_t sample {};
+    for (long long i = 1; i <= numSamples; i++)
+    {
+        sample.timestamp = baseTs + i * 1000;
+        sample.val.i64   = i;
+        REQUIRE(cm.InjectSamples(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, &sample, 1) == DCGM_ST_OK);
+        REQUIRE(cm.InjectSamples(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_SM_CLOCK, &sample, 1) == DCGM_ST_OK);
+    }
+
+    dcgmcm_cache_memory_stats_t stats = cm.GetCacheMemoryStats();
+    REQUIRE(stats.usedBytes > 0);
+    CHECK(stats.budgetBytes == 0);
+    CHECK(stats.numEvictions == 0);
+
+    long long const budgetBytes = stats.usedBytes / 4;
+    REQUIRE(cm.SetCacheMemoryBudget(budgetBytes) == DCGM_ST_OK);
+
+    long long const usedBytesBefore = stats.usedBytes;
+    stats                           = cm.GetCacheMemoryStats();
+    CHECK(stats.budgetBytes == budgetBytes);
+    CHECK(stats.usedBytes <= budgetBytes);
+    CHECK(stats.numEvictions == 1);
+    CHECK(stats.evictedSamples > 0);
+    CHECK(stats.evictedBytes == usedBytesBefore - stats.usedBytes);
+
+    /* The newest samples are kept */
+    dcgmcm_sample_t latest {};
+    REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, &latest, nullptr) == DCGM_ST_OK);
+    CHECK(latest.val.i64 == numSamples);
+
+    dcgmCacheManagerFieldInfo_v5_t fieldInfo {};
+    fieldInfo.version       = dcgmCacheManagerFieldInfo_version5;
+    fieldInfo.entityGroupId = DCGM_FE_GPU;
+    fieldInfo.entityId      = gpuId;
+    fieldInfo.fieldId       = DCGM_FI_DEV_GPU_TEMP;
+    REQUIRE(cm.GetCacheManagerFieldInfo(&fieldInfo) == DCGM_ST_OK);
+    CHECK(fieldInfo.budgetEvictedSamples > 0);
+    CHECK(fieldInfo.numSamples == numSamples - fieldInfo.budgetEvictedSamples);
+
+    /* A budget that can't be met leaves the newest sample of each watch */
+    REQUIRE(cm.SetCacheMemoryBudget(1) == DCGM_ST_OK);
+    stats = cm.GetCacheMemoryStats();
+    CHECK(stats.usedBytes > 1);
+    CHECK(stats.numEvictions == 2);
+    REQUIRE(cm.GetCacheManagerFieldInfo(&fieldInfo) == DCGM_ST_OK);
+    CHECK(fieldInfo.numSamples == 1);
+
+    /* Passes that have nothing left to evict aren't counted */
+    REQUIRE(cm.SetCacheMemoryBudget(1) == DCGM_ST_OK);
+    CHECK(cm.GetCacheMemoryStats().numEvictions == 2);
+    CHECK(cm.GetCacheMemoryStats().evictedSamples == stats.evictedSamples);
+
+    /* Nothing more is evicted while we're under budget */
+    REQUIRE(cm.SetCacheMemoryBudget(0) == DCGM_ST_OK);
+    CHECK(cm.GetCacheMemoryStats().numEvictions == 2);
+}
+
 TEST_CASE("CacheManager: Test GetGpuId")
 {
     DcgmFieldsInit();
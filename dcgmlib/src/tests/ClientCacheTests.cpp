@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch.hpp>
+
+#include <DcgmClientCache.h>
+
+using Scope       = DcgmClientCache::Scope;
+using Generations = DcgmClientCache::Generations;
+
+static dcgmHandle_t const handle = 1;
+
+TEST_CASE("ClientCache: Entries are served until their scope changes")
+{
+    DcgmClientCache cache;
+    std::string response;
+
+    Generations fetchedAt { 1, 10 };
+    cache.Store(handle, "config", Scope::Config, fetchedAt, "group");
+    cache.Store(handle, "values", Scope::Values, fetchedAt, "fvs");
+
+    REQUIRE(cache.Lookup(handle, "config", Scope::Config, fetchedAt, response));
+    CHECK(response == "group");
+    REQUIRE(cache.Lookup(handle, "values", Scope::Values, fetchedAt, response));
+    CHECK(response == "fvs");
+
+    /* A new update cycle only makes values stale */
+    Generations nextCycle { 1, 11 };
+    REQUIRE(cache.Lookup(handle, "config", Scope::Config, nextCycle, response));
+    CHECK(!cache.Lookup(handle, "values", Scope::Values, nextCycle, response));
+
+    /* A config change makes everything stale */
+    Generations nextConfig { 2, 12 };
+    CHECK(!cache.Lookup(handle, "config", Scope::Config, nextConfig, response));
+
+    /* Other handles don't see the entries */
+    CHECK(!cache.Lookup(2, "config", Scope::Config, fetchedAt, response));
+}
+
+TEST_CASE("ClientCache: Stale stores are dropped")
+{
+    DcgmClientCache cache;
+    std::string response;
+
+    cache.Store(handle, "a", Scope::Config, { 1, 11 }, "new");
+
+    /* A response fetched before the last change must not be cached */
+    cache.Store(handle, "b", Scope::Config, { 1, 10 }, "old");
+    CHECK(!cache.Lookup(handle, "b", Scope::Config, { 1, 10 }, response));
+    CHECK(!cache.Lookup(handle, "b", Scope::Config, { 1, 11 }, response));
+
+    /* Moving on prunes the entries that can't be served anymore */
+    cache.Store(handle, "c", Scope::Config, { 2, 12 }, "newer");
+    CHECK(!cache.Lookup(handle, "a", Scope::Config, { 1, 11 }, response));
+    REQUIRE(cache.Lookup(handle, "c", Scope::Config, { 2, 12 }, response));
+    CHECK(response == "newer");
+
+    cache.RemoveHandle(handle);
+    CHECK(!cache.Lookup(handle, "c", Scope::Config, { 2, 12 }, response));
+}
+
+TEST_CASE("ClientCache: Subscriptions")
+{
+    DcgmClientCache cache;
+
+    CHECK(!cache.GetGenerations(handle).has_value());
+
+    REQUIRE(cache.BeginSubscribe(handle));
+    /* Only one subscriber at a time */
+    CHECK(!cache.BeginSubscribe(handle));
+    CHECK(!cache.GetGenerations(handle).has_value());
+
+    /* A notification that beats the subscription response wins */
+    cache.UpdateGenerations(handle, { 3, 30 });
+    cache.EndSubscribe(handle, true, { 2, 20 });
+
+    auto generations = cache.GetGenerations(handle);
+    REQUIRE(generations.has_value());
+    CHECK(generations->config == 3);
+    CHECK(generations->values == 30);
+
+    /* Out of order notifications don't move the generations backwards */
+    cache.UpdateGenerations(handle, { 4, 40 });
+    cache.UpdateGenerations(handle, { 3, 35 });
+    generations = cache.GetGenerations(handle);
+    REQUIRE(generations.has_value());
+    CHECK(generations->config == 4);
+    CHECK(generations->values == 40);
+
+    /* Hostengines that can't subscribe are never tried again */
+    dcgmHandle_t const oldHostEngine = 2;
+    REQUIRE(cache.BeginSubscribe(oldHostEngine));
+    cache.EndSubscribe(oldHostEngine, false, {});
+    CHECK(!cache.GetGenerations(oldHostEngine).has_value());
+    CHECK(!cache.BeginSubscribe(oldHostEngine));
+}
+
+TEST_CASE("ClientCache: Live data is never served from the cache")
+{
+    CHECK(DcgmClientCache::CanCacheLatestValues(0));
+    CHECK(!DcgmClientCache::CanCacheLatestValues(DCGM_FV_FLAG_LIVE_DATA));
+    CHECK(!DcgmClientCache::CanCacheLatestValues(DCGM_FV_FLAG_LIVE_DATA | 0x2));
+}
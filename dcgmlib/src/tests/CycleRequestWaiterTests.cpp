@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch.hpp>
+
+#include <DcgmCycleRequestWaiter.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+/* Wait up to a few seconds for what to become true */
+template <typename Predicate>
+bool WaitFor(Predicate what)
+{
+    for (int i = 0; i < 500; i++)
+    {
+        if (what())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return what();
+}
+} // namespace
+
+TEST_CASE("CycleRequestWaiter: Requests complete when a newer cycle completes")
+{
+    DcgmCycleRequestWaiter waiter;
+    REQUIRE(waiter.Start() == 0);
+
+    std::atomic<int> completed { 0 };
+    waiter.Park(5, 5, 60000, [&completed] { completed++; });
+    waiter.Park(6, 5, 60000, [&completed] { completed++; });
+    CHECK(waiter.GetNumParked() == 2);
+
+    /* Only the request that saw cycle 5 is done */
+    waiter.OnUpdateCycle(6);
+    REQUIRE(WaitFor([&completed] { return completed == 1; }));
+    CHECK(waiter.GetNumParked() == 1);
+
+    waiter.OnUpdateCycle(7);
+    REQUIRE(WaitFor([&completed] { return completed == 2; }));
+    CHECK(waiter.GetNumParked() == 0);
+}
+
+TEST_CASE("CycleRequestWaiter: A cycle the caller missed completes the request")
+{
+    DcgmCycleRequestWaiter waiter;
+    REQUIRE(waiter.Start() == 0);
+
+    std::atomic<int> completed { 0 };
+
+    /* Cycle 4 completed after the caller checked the cache manager, but before it parked */
+    waiter.OnUpdateCycle(4);
+    waiter.Park(3, 3, 60000, [&completed] { completed++; });
+    CHECK(WaitFor([&completed] { return completed == 1; }));
+}
+
+TEST_CASE("CycleRequestWaiter: Requests complete when they time out")
+{
+    DcgmCycleRequestWaiter waiter;
+    REQUIRE(waiter.Start() == 0);
+
+    std::atomic<int> completed { 0 };
+    auto const start = std::chrono::steady_clock::now();
+    waiter.Park(1, 1, 50, [&completed] { completed++; });
+    REQUIRE(WaitFor([&completed] { return completed == 1; }));
+    CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50));
+
+    /* Parked requests are dropped on shutdown without being completed */
+    waiter.Park(1, 1, 60000, [&completed] { completed++; });
+    REQUIRE(waiter.StopAndWait(5000) == 0);
+    CHECK(completed == 1);
+    CHECK(waiter.GetNumParked() == 0);
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch.hpp>
+
+#include <DcgmFvChangeTracker.h>
+#include <dcgm_fields.h>
+
+#include <vector>
+
+namespace
+{
+constexpr dcgm_connection_id_t CONNECTION_ID = 5;
+constexpr unsigned int GROUP_ID              = 2;
+constexpr unsigned int FIELD_GROUP_ID        = 3;
+constexpr size_t MAX_BYTES                   = 1024 * 1024;
+
+/* Fields 1 and 2 of GPU 0 and a string field of GPU 1 */
+void FillLatest(DcgmFvBuffer &latest, long long ts, long long value1, double value2, char const *value3)
+{
+    latest.Clear();
+    latest.AddInt64Value(DCGM_FE_GPU, 0, 1, value1, ts, DCGM_ST_OK);
+    latest.AddDoubleValue(DCGM_FE_GPU, 0, 2, value2, ts, DCGM_ST_OK);
+    latest.AddStringValue(DCGM_FE_GPU, 1, 3, value3, ts, DCGM_ST_OK);
+}
+
+/* Returns the field IDs in changes */
+std::vector<unsigned short> GetFieldIds(DcgmFvBuffer &changes)
+{
+    std::vector<unsigned short> fieldIds;
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = changes.GetNextFv(&cursor); fv; fv = changes.GetNextFv(&cursor))
+    {
+        fieldIds.push_back(fv->fieldId);
+    }
+    return fieldIds;
+}
+} // namespace
+
+TEST_CASE("FvChangeTracker: Only changed values are sent")
+{
+    DcgmFvChangeTracker tracker;
+    DcgmFvBuffer latest;
+    DcgmFvBuffer changes;
+    bool isResync = false;
+
+    FillLatest(latest, 100, 1, 2.0, "GPU-0");
+    REQUIRE(tracker.GetChanges(CONNECTION_ID, GROUP_ID, FIELD_GROUP_ID, 100, latest, MAX_BYTES, changes, isResync)
+            == DCGM_ST_OK);
+    CHECK(isResync);
+    CHECK(GetFieldIds(changes) == std::vector<unsigned short> { 1, 2, 3 });
+
+    /* Same samples */
+    REQUIRE(tracker.GetChanges(CONNECTION_ID, GROUP_ID, FIELD_GROUP_ID, 100, latest, MAX_BYTES, changes, isResync)
+            == DCGM_ST_OK);
+    CHECK(!isResync);
+    CHECK(GetFieldIds(changes).empty());
+
+    /* Newer samples, but only the double and the string changed */
+    FillLatest(latest, 200, 1, 2.5, "GPU-1");
+    REQUIRE(tracker.GetChanges(CONNECTION_ID, GROUP_ID, FIELD_GROUP_ID, 100, latest, MAX_BYTES, changes, isResync)
+            == DCGM_ST_OK);
+    CHECK(!isResync);
+    CHECK(GetFieldIds(changes) == std::vector<unsigned short> { 2, 3 });
+
+    /* A status change is a change */
+    latest.Clear();
+    latest.AddInt64Value(DCGM_FE_GPU, 0, 1, 1, 300, DCGM_ST_NOT_SUPPORTED);
+    REQUIRE(tracker.GetChanges(CONNECTION_ID, GROUP_ID, FIELD_GROUP_ID, 100, latest, MAX_BYTES, changes, isResync)
+            == DCGM_ST_OK);
+    CHECK(GetFieldIds(changes) == std::vector<unsigned short> { 1 });
+
+    SECTION("Other readers are tracked separately")
+    {
+        dcgm_connection_id_t const other = CONNECTION_ID + 1;
+        FillLatest(latest, 200, 1, 2.5, "GPU-1");
+        REQUIRE(tracker.GetChanges(other, GROUP_ID, FIELD_GROUP_ID, 100, latest, MAX_BYTES, changes, isResync)
+                == DCGM_ST_OK);
+        CHECK(isResync);
+        CHECK(GetFieldIds(changes).size() == 3);
+    }
+
+    SECTION("Forgotten readers start over")
+    {
+        FillLatest(latest, 200, 1, 2.5, "GPU-1");
+        tracker.OnConnectionRemove(CONNECTION_ID);
+        REQUIRE(tracker.GetChanges(CONNECTION_ID, GROUP_ID, FIELD_GROUP_ID, 100, latest, MAX_BYTES, changes, isResync)
+                == DCGM_ST_OK);
+        CHECK(isResync);
+
+        tracker.OnGroupRemove(GROUP_ID);
+        REQUIRE(tracker.GetChanges(CONNECTION_ID, GROUP_ID, FIELD_GROUP_ID, 100, latest, MAX_BYTES, changes, isResync)
+                == DCGM_ST_OK);
+        CHECK(isResync);
+
+        tracker.OnFieldGroupRemove(FIELD_GROUP_ID);
+        REQUIRE(tracker.GetChanges(CONNECTION_ID, GROUP_ID, FIELD_GROUP_ID, 100, latest, MAX_BYTES, changes, isResync)
+                == DCGM_ST_OK);
+        CHECK(isResync);
+    }
+}
+
+TEST_CASE("FvChangeTracker: Periodic resync")
+{
+    DcgmFvChangeTracker tracker;
+    DcgmFvBuffer latest;
+    DcgmFvBuffer changes;
+    bool isResync = false;
+
+    FillLatest(latest, 100, 1, 2.0, "GPU-0");
+
+    std::vector<bool> resyncs;
+    for (int i = 0; i < 7; i++)
+    {
+        REQUIRE(tracker.GetChanges(CONNECTION_ID, GROUP_ID, FIELD_GROUP_ID, 3, latest, MAX_BYTES, changes, isResync)
+                == DCGM_ST_OK);
+        resyncs.push_back(isResync);
+        CHECK(GetFieldIds(changes).size() == (isResync ? 3 : 0));
+    }
+
+    CHECK(resyncs == std::vector<bool> { true, false, false, true, false, false, true });
+}
+
+TEST_CASE("FvChangeTracker: Changes that don't fit aren't recorded as sent")
+{
+    DcgmFvChangeTracker tracker;
+    DcgmFvBuffer latest;
+    DcgmFvBuffer changes;
+    bool isResync = false;
+
+    FillLatest(latest, 100, 1, 2.0, "GPU-0");
+    CHECK(tracker.GetChanges(CONNECTION_ID, GROUP_ID, FIELD_GROUP_ID, 100, latest, 10, changes, isResync)
+          == DCGM_ST_INSUFFICIENT_SIZE);
+
+    REQUIRE(tracker.GetChanges(CONNECTION_ID, GROUP_ID, FIELD_GROUP_ID, 100, latest, MAX_BYTES, changes, isResync)
+            == DCGM_ST_OK);
+    CHECK(isResync);
+    CHECK(GetFieldIds(changes).size() == 3);
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch.hpp>
+
+#include <DcgmLatestValueSlot.h>
+#include <timeseries.h>
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("LatestValueSlot: Publish and clear")
+{
+    DcgmLatestValueSlot slot;
+    DcgmLatestValue value {};
+
+    CHECK(!slot.Read(value));
+
+    DcgmLatestValue published {};
+    published.tsType      = TS_TYPE_DOUBLE;
+    published.timestamp   = 1234;
+    published.valueDouble = 5.5;
+    slot.Publish(published);
+
+    REQUIRE(slot.Read(value));
+    CHECK(value.tsType == TS_TYPE_DOUBLE);
+    CHECK(value.timestamp == 1234);
+    CHECK(value.valueDouble == 5.5);
+
+    /* Copies are snapshots */
+    DcgmLatestValueSlot copy(slot);
+    slot.Clear();
+    CHECK(!slot.Read(value));
+    REQUIRE(copy.Read(value));
+    CHECK(value.timestamp == 1234);
+}
+
+TEST_CASE("LatestValueSlot: Readers never see a torn value")
+{
+    DcgmLatestValueSlot slot;
+    std::atomic<bool> done { false };
+    std::atomic<long long> tornReads { 0 };
+    std::atomic<long long> reads { 0 };
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++)
+    {
+        readers.emplace_back([&] {
+            DcgmLatestValue value {};
+            while (!done.load(std::memory_order_relaxed))
+            {
+                if (!slot.Read(value))
+                {
+                    continue;
+                }
+                reads++;
+                if (value.valueInt64 != value.timestamp || value.value2Int64 != -value.timestamp)
+                {
+                    tornReads++;
+                }
+            }
+        });
+    }
+
+    for (long long i = 1; i <= 200000; i++)
+    {
+        DcgmLatestValue value {};
+        value.tsType      = TS_TYPE_INT64;
+        value.timestamp   = i;
+        value.valueInt64  = i;
+        value.value2Int64 = -i;
+        slot.Publish(value);
+    }
+    done = true;
+
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    CHECK(tornReads == 0);
+    DcgmLatestValue last {};
+    REQUIRE(slot.Read(last));
+    CHECK(last.timestamp == 200000);
+}
+
+TEST_CASE("LatestValueIndex: Lookups across growth")
+{
+    DcgmLatestValueIndex index;
+    std::vector<DcgmLatestValueSlot> slots(1000);
+
+    CHECK(index.Find(1) == nullptr);
+
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        /* Keys shaped like watch keys: small fields packed together */
+        index.Insert(((std::uint64_t)i << 32) | 1, &slots[i]);
+    }
+
+    /* Inserting a key twice keeps the first slot */
+    index.Insert(1, &slots[1]);
+    CHECK(index.Find(1) == &slots[0]);
+
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        CHECK(index.Find(((std::uint64_t)i << 32) | 1) == &slots[i]);
+    }
+    CHECK(index.Find(2) == nullptr);
+
+    index.Clear();
+    CHECK(index.Find(1) == nullptr);
+}
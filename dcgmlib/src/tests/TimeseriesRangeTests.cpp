@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch.hpp>
+
+#include <timeseries.h>
+
+#include <vector>
+
+namespace
+{
+/* Timestamps are 10, 20, ... so that every range boundary can fall between entries */
+timeseries_p MakeTimeseries(int Nentries)
+{
+    int errorSt     = 0;
+    timeseries_p ts = timeseries_alloc(TS_TYPE_INT64, &errorSt);
+    REQUIRE(ts != nullptr);
+    for (int i = 1; i <= Nentries; i++)
+    {
+        REQUIRE(timeseries_insert_int64(ts, i * 10LL, i, 0) == TS_ST_OK);
+    }
+    return ts;
+}
+
+int AppendRunCB(timeseries_entry_p entries, int Nentries, void *user)
+{
+    auto *runs = (std::vector<std::vector<long long>> *)user;
+    runs->emplace_back();
+    for (int i = 0; i < Nentries; i++)
+    {
+        runs->back().push_back(entries[i].val.i64);
+    }
+    return 0;
+}
+
+/* Flatten the runs in the order a caller would copy them */
+std::vector<long long> Visit(timeseries_p ts, timeseries_range_p range, bool descending, int maxEntries)
+{
+    std::vector<std::vector<long long>> runs;
+    int const Nvisited = timeseries_visit_range(ts, range, descending ? 1 : 0, maxEntries, AppendRunCB, &runs);
+
+    std::vector<long long> values;
+    for (auto const &run : runs)
+    {
+        if (descending)
+        {
+            values.insert(values.end(), run.rbegin(), run.rend());
+        }
+        else
+        {
+            values.insert(values.end(), run.begin(), run.end());
+        }
+    }
+    CHECK(Nvisited == (int)values.size());
+    return values;
+}
+} // namespace
+
+TEST_CASE("timeseries_find_range")
+{
+    int const Nentries = 10000; /* Enough for many blocks */
+    timeseries_p ts    = MakeTimeseries(Nentries);
+    timeseries_range_t range;
+
+    REQUIRE(timeseries_find_range(ts, 0, 0, &range) == TS_ST_OK);
+    CHECK(range.Nentries == Nentries);
+
+    /* Boundaries are inclusive and may fall between entries */
+    REQUIRE(timeseries_find_range(ts, 100, 200, &range) == TS_ST_OK);
+    CHECK(range.Nentries == 11);
+    REQUIRE(timeseries_find_range(ts, 95, 205, &range) == TS_ST_OK);
+    CHECK(range.Nentries == 11);
+    REQUIRE(timeseries_find_range(ts, 15, 0, &range) == TS_ST_OK);
+    CHECK(range.Nentries == Nentries - 1);
+    REQUIRE(timeseries_find_range(ts, 0, 55, &range) == TS_ST_OK);
+    CHECK(range.Nentries == 5);
+
+    /* Empty ranges */
+    REQUIRE(timeseries_find_range(ts, 101, 109, &range) == TS_ST_OK);
+    CHECK(range.Nentries == 0);
+    REQUIRE(timeseries_find_range(ts, 200, 100, &range) == TS_ST_OK);
+    CHECK(range.Nentries == 0);
+    REQUIRE(timeseries_find_range(ts, Nentries * 10 + 1, 0, &range) == TS_ST_OK);
+    CHECK(range.Nentries == 0);
+
+    CHECK(timeseries_find_range(ts, 0, 0, nullptr) == TS_ST_BADPARAM);
+    timeseries_destroy(ts);
+}
+
+TEST_CASE("timeseries_visit_range")
+{
+    int const Nentries = 10000;
+    timeseries_p ts    = MakeTimeseries(Nentries);
+    timeseries_range_t range;
+
+    REQUIRE(timeseries_find_range(ts, 105, 50000, &range) == TS_ST_OK);
+    REQUIRE(range.Nentries == 4990);
+
+    std::vector<long long> expected;
+    for (long long value = 11; value <= 5000; value++)
+    {
+        expected.push_back(value);
+    }
+
+    SECTION("Ascending")
+    {
+        CHECK(Visit(ts, &range, false, Nentries) == expected);
+
+        /* The oldest entries are kept when truncated */
+        std::vector<long long> values = Visit(ts, &range, false, 1000);
+        CHECK(values == std::vector<long long>(expected.begin(), expected.begin() + 1000));
+    }
+
+    SECTION("Descending")
+    {
+        std::vector<long long> reversed(expected.rbegin(), expected.rend());
+        CHECK(Visit(ts, &range, true, Nentries) == reversed);
+
+        /* The newest entries are kept when truncated */
+        std::vector<long long> values = Visit(ts, &range, true, 1000);
+        CHECK(values == std::vector<long long>(reversed.begin(), reversed.begin() + 1000));
+    }
+
+    SECTION("Stopped by the callback")
+    {
+        auto stopCB = [](timeseries_entry_p, int, void *) -> int { return TS_ST_UNKNOWN; };
+        CHECK(timeseries_visit_range(ts, &range, 0, Nentries, stopCB, nullptr) == TS_ST_UNKNOWN);
+    }
+
+    SECTION("Empty range")
+    {
+        REQUIRE(timeseries_find_range(ts, 101, 109, &range) == TS_ST_OK);
+        CHECK(Visit(ts, &range, false, Nentries).empty());
+    }
+
+    timeseries_destroy(ts);
+}
@@ -42,10 +42,13 @@ struct HostEngineCommandLine::Impl
                                                   instance from running */
     std::string m_serviceAccount;            /*!< Service account that will be used for unprivileged processes */
     std::string m_homeDir;                   /*!< Home directory for the DCGM diagnostic. */
+    std::string m_federateNodes;             /*!< Comma-separated addresses of hostengines to aggregate */
+    std::string m_federateFields;            /*!< Comma-separated field IDs to mirror from aggregated hostengines */
 
     std::set<dcgmModuleId_t> m_denylistModules; /*!< Modules to add to the denylist */
 
-    std::uint16_t m_hostEnginePort; /*!< Host engine port number */
+    std::uint16_t m_hostEnginePort;   /*!< Host engine port number */
+    std::uint64_t m_maxCacheMemoryMb; /*!< Memory budget of the field sample cache in MB. 0 = unlimited */
 
     bool m_isHostEngineConnTCP; /*!< Flag to indicate that connection is TCP */
     bool m_isTermHostEngine;    /*!< Terminate Daemon */
@@ -123,6 +126,21 @@ std::string const &HostEngineCommandLine::GetHomeDir() const
     return m_pimpl->m_homeDir;
 }
 
+std::uint64_t HostEngineCommandLine::GetMaxCacheMemoryMb() const
+{
+    return m_pimpl->m_maxCacheMemoryMb;
+}
+
+std::string const &HostEngineCommandLine::GetFederateNodes() const
+{
+    return m_pimpl->m_federateNodes;
+}
+
+std::string const &HostEngineCommandLine::GetFederateFields() const
+{
+    return m_pimpl->m_federateFields;
+}
+
 namespace
 {
 using namespace std::string_literals;
@@ -460,6 +478,41 @@ HostEngineCommandLine ParseCommandLine(int argc, char *argv[])
                                              /*typedesc*/ "Diagnostic home",
                                              cmdLine);
 
+        auto maxCacheMemoryArg
+            = ValueArg<std::uint64_t>("",
+                                      "max-cache-memory",
+                                      "Maximum memory in MB that cached field samples may use. The oldest samples "
+                                      "of the least important watches are evicted when the cache grows past this."
+                                      "\nDefault: 0 (unlimited)",
+                                      /*req*/ false,
+                                      /*default*/ 0,
+                                      /*typedesc*/ "MB",
+                                      cmdLine);
+
+        auto federateArg
+            = ValueArg<std::string>("",
+                                    "federate",
+                                    "Aggregate other hostengines. The host engine keeps a connection to every one of "
+                                    "them, mirrors the latest values of the federated fields and serves them to its "
+                                    "own clients qualified by node."
+                                    "\nPass a comma-separated list of addresses like host1:5555,host2."
+                                    " Prefix unix socket paths with unix://.",
+                                    /*req*/ false,
+                                    /*default*/ "",
+                                    /*typedesc*/ "ADDRESSES",
+                                    cmdLine);
+
+        auto federateFieldsArg = ValueArg<std::string>("",
+                                                       "federate-fields",
+                                                       "Field IDs to mirror from the hostengines passed to --federate."
+                                                       "\nPass a comma-separated list of field IDs like 150,155."
+                                                       "\nDefault: GPU temperature, power, utilization, framebuffer, "
+                                                       "SM clock and XID errors",
+                                                       /*req*/ false,
+                                                       /*default*/ "",
+                                                       /*typedesc*/ "FIELD_IDS",
+                                                       cmdLine);
+
         cmdLine.parse(argc, argv);
 
         impl->m_hostEngineSockPath        = domainSockArg.getValue();
@@ -475,6 +528,9 @@ HostEngineCommandLine ParseCommandLine(int argc, char *argv[])
         impl->m_isLogRotate               = logRotateArg.getValue();
         impl->m_serviceAccount            = serviceAccount.getValue();
         impl->m_homeDir                   = homeDir.getValue();
+        impl->m_maxCacheMemoryMb          = maxCacheMemoryArg.getValue();
+        impl->m_federateNodes             = federateArg.getValue();
+        impl->m_federateFields            = federateFieldsArg.getValue();
     }
     catch (TCLAP::ArgException const &ex)
     {
@@ -57,6 +57,11 @@ public:
 
     [[nodiscard]] std::string const &GetHomeDir() const; //!< Home directory for the host engine
 
+    [[nodiscard]] std::uint64_t GetMaxCacheMemoryMb() const; //!< Cache memory budget in MB. 0 = unlimited
+
+    [[nodiscard]] std::string const &GetFederateNodes() const;  //!< Addresses of hostengines to aggregate. "" = none
+    [[nodiscard]] std::string const &GetFederateFields() const; //!< Field IDs to mirror. "" = default fields
+
 private:
     struct Impl;
     struct ImplDeleter
@@ -487,6 +487,16 @@ int main(int argc, char **argv)
         setenv(DCGM_HOME_DIR_VAR_NAME, diagHomeDir.c_str(), 1);
     }
 
+    /* The embedded hostengine starts aggregating these as soon as it's up */
+    if (!cmdLine.GetFederateNodes().empty())
+    {
+        setenv(DCGM_ENV_FEDERATION_NODES, cmdLine.GetFederateNodes().c_str(), 1);
+    }
+    if (!cmdLine.GetFederateFields().empty())
+    {
+        setenv(DCGM_ENV_FEDERATION_FIELDS, cmdLine.GetFederateFields().c_str(), 1);
+    }
+
     ret = dcgmStartEmbedded_v2((dcgmStartEmbeddedV2Params_v1 *)&params);
 
     dcgmHandle = params.dcgmHandle;
@@ -500,6 +510,19 @@ int main(int argc, char **argv)
 
     syslog(LOG_NOTICE, "DCGM initialized");
 
+    if (cmdLine.GetMaxCacheMemoryMb() > 0)
+    {
+        ret = dcgmIntrospectSetCacheMemoryBudget(dcgmHandle, (long long)cmdLine.GetMaxCacheMemoryMb() * 1024 * 1024);
+        if (DCGM_ST_OK != ret)
+        {
+            printf("Err: Failed to set the cache memory budget to %llu MB: %d\n",
+                   (unsigned long long)cmdLine.GetMaxCacheMemoryMb(),
+                   ret);
+            syslog(LOG_NOTICE, "Err: Failed to set the cache memory budget");
+            return cleanup(dcgmHandle, -1, parentPid);
+        }
+    }
+
     InstallCtrlHandler();
 
     /* Should we start in TCP mode? */
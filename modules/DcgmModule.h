@@ -88,6 +88,13 @@ public:
             LoggingSetHostEngineComponentName(moduleName);
         }
         DCGM_LOG_DEBUG << "Initialized logging for module " << moduleId;
+
+        /* Modules link their own copy of timelib. Read the hostengine's clock instead so a clock installed there
+           is seen here too. Skip it when both are the same copy, or timelib would end up calling itself */
+        if (m_coreCallbacks.clockfunc != nullptr && m_coreCallbacks.clockfunc != timelib_usecSince1970)
+        {
+            timelib_setClockOverride(m_coreCallbacks.clockfunc);
+        }
     }
 
     void OnLoggingSeverityChange(dcgm_core_msg_logging_changed_t *msg) override
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cstring>
 #include <fmt/format.h>
 
@@ -22,8 +23,17 @@
 
 DcgmCoreProxy::DcgmCoreProxy(const dcgmCoreCallbacks_t coreCallbacks)
     : m_coreCallbacks(coreCallbacks)
+    , m_asyncWorkers(std::make_shared<AsyncWorkers>())
 {}
 
+DcgmNs::ThreadPool &DcgmCoreProxy::GetAsyncWorkers() const
+{
+    std::call_once(m_asyncWorkers->started, [this] {
+        m_asyncWorkers->pool = std::make_unique<DcgmNs::ThreadPool>(DCGM_CORE_PROXY_ASYNC_WORKERS);
+    });
+    return *m_asyncWorkers->pool;
+}
+
 void initializeCoreHeader(dcgm_module_command_header_t &header,
                           dcgmCoreReqCmd_t cmd,
                           unsigned int version,
@@ -393,6 +403,72 @@ dcgmReturn_t DcgmCoreProxy::GetSamples(dcgm_field_entity_group_t entityGroupId,
     return ret;
 }
 
+dcgmReturn_t DcgmCoreProxy::GetSamplesBatch(std::vector<dcgmCoreGetSamplesParams_t> const &requests,
+                                            std::vector<DcgmCoreSamples> &results) const
+{
+    std::vector<dcgmCoreGetSamplesResult_t> rawResults(requests.size());
+
+    results.clear();
+    results.resize(requests.size());
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        results[i].samples.resize(std::max(requests[i].maxSamples, 0));
+        rawResults[i].samples = results[i].samples.data();
+    }
+
+    dcgmCoreGetSamplesBatch_t gsb = {};
+    initializeCoreHeader(gsb.header, DcgmCoreReqIdCMGetSamplesBatch, dcgmCoreGetSamplesBatch_version, sizeof(gsb));
+    gsb.request.numRequests = requests.size();
+    gsb.request.requests    = requests.data();
+    gsb.response.results    = rawResults.data();
+
+    // coverity[overrun-buffer-val]
+    dcgmReturn_t ret = m_coreCallbacks.postfunc(&gsb.header, m_coreCallbacks.poster);
+    if (ret == DCGM_ST_OK)
+    {
+        ret = gsb.response.ret;
+    }
+
+    if (ret != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "Error '" << errorString(ret) << "' while attempting to get samples for " << requests.size()
+                       << " entities and fields";
+        results.clear();
+        return ret;
+    }
+
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        results[i].ret = rawResults[i].ret;
+        results[i].samples.resize(rawResults[i].ret == DCGM_ST_OK ? rawResults[i].numSamples : 0);
+    }
+
+    return DCGM_ST_OK;
+}
+
+std::shared_future<DcgmCoreSamplesBatch> DcgmCoreProxy::GetSamplesBatchAsync(
+    std::vector<dcgmCoreGetSamplesParams_t> requests) const
+{
+    /* Keep the requests where the fallback below can still get at them if the pool turns the task down */
+    auto sharedRequests = std::make_shared<std::vector<dcgmCoreGetSamplesParams_t> const>(std::move(requests));
+
+    /* Don't capture this. Copies of this proxy share the workers, so this one may be gone when the task runs */
+    auto runBatch = [coreCallbacks = m_coreCallbacks, sharedRequests]() {
+        DcgmCoreSamplesBatch batch;
+        batch.ret = DcgmCoreProxy(coreCallbacks).GetSamplesBatch(*sharedRequests, batch.results);
+        return batch;
+    };
+
+    if (auto future = GetAsyncWorkers().Enqueue(runBatch); future.has_value())
+    {
+        return std::move(*future);
+    }
+
+    std::promise<DcgmCoreSamplesBatch> promise;
+    promise.set_value(runBatch());
+    return promise.get_future().share();
+}
+
 class Blob
 {
 public:
@@ -457,41 +533,45 @@ dcgmReturn_t DcgmCoreProxy::GetMultipleLatestLiveSamples(std::vector<dcgmGroupEn
                                                          DcgmFvBuffer *fvBuffer) const
 {
     dcgmCoreGetMultipleLatestLiveSamples_t gml = {};
+    dcgmReturn_t ret                           = DCGM_ST_OK;
+    Blob blob;
 
-    if (entities.size() > DCGM_GROUP_MAX_ENTITIES)
+    /* A request holds up to DCGM_GROUP_MAX_ENTITIES entities. Larger lists are fetched in chunks whose
+       buffers are concatenated */
+    size_t chunkStart = 0;
+    do
     {
-        DCGM_LOG_ERROR << fmt::format("Too many entities in the group. Provided {}, supported up to {}",
-                                      entities.size(),
-                                      DCGM_GROUP_MAX_ENTITIES);
-        return DCGM_ST_MAX_LIMIT;
-    }
+        size_t const chunkSize = std::min(entities.size() - chunkStart, (size_t)DCGM_GROUP_MAX_ENTITIES);
 
-    gml.request.entityPairCount = entities.size();
-    for (size_t i = 0; i < entities.size(); i++)
-    {
-        gml.request.entityPairs[i] = entities[i];
-    }
+        gml.request.entityPairCount = chunkSize;
+        for (size_t i = 0; i < chunkSize; i++)
+        {
+            gml.request.entityPairs[i] = entities[chunkStart + i];
+        }
 
-    gml.request.fieldIds    = fieldIds.data();
-    gml.request.numFieldIds = fieldIds.size();
+        gml.request.fieldIds       = fieldIds.data();
+        gml.request.numFieldIds    = fieldIds.size();
+        gml.request.bufferPosition = 0;
 
-    initializeCoreHeader(gml.header,
-                         DcgmCoreReqIdCMGetMultipleLatestLiveSamples,
-                         dcgmCoreGetMultipleLatestLiveSamples_version,
-                         sizeof(gml));
+        initializeCoreHeader(gml.header,
+                             DcgmCoreReqIdCMGetMultipleLatestLiveSamples,
+                             dcgmCoreGetMultipleLatestLiveSamples_version,
+                             sizeof(gml));
 
-    // coverity[overrun-buffer-val]
-    dcgmReturn_t ret = m_coreCallbacks.postfunc(&gml.header, m_coreCallbacks.poster);
+        // coverity[overrun-buffer-val]
+        ret = m_coreCallbacks.postfunc(&gml.header, m_coreCallbacks.poster);
+        if (ret != DCGM_ST_OK)
+        {
+            break;
+        }
 
-    if (ret == DCGM_ST_OK)
-    {
-        Blob blob;
+        size_t const chunkBlobStart = blob.GetUsed();
         blob.AppendToBlob(gml.response.buffer, gml.response.bufferSize);
 
         // If the data didn't fit in one call, repeatedly call the API and copy off each portion until we're done.
         while (gml.response.dataDidNotFit)
         {
-            gml.request.bufferPosition = blob.GetUsed();
+            gml.request.bufferPosition = blob.GetUsed() - chunkBlobStart;
             // coverity[overrun-buffer-val]
             ret = m_coreCallbacks.postfunc(&gml.header, m_coreCallbacks.poster);
 
@@ -505,10 +585,12 @@ dcgmReturn_t DcgmCoreProxy::GetMultipleLatestLiveSamples(std::vector<dcgmGroupEn
             }
         }
 
-        if (ret == DCGM_ST_OK)
-        {
-            fvBuffer->SetFromBuffer(blob.GetBlob(), blob.GetUsed());
-        }
+        chunkStart += chunkSize;
+    } while (ret == DCGM_ST_OK && chunkStart < entities.size());
+
+    if (ret == DCGM_ST_OK)
+    {
+        fvBuffer->SetFromBuffer(blob.GetBlob(), blob.GetUsed());
     }
 
     if (ret != DCGM_ST_OK)
@@ -621,27 +703,36 @@ dcgmReturn_t DcgmCoreProxy::SetValue(int gpuId, unsigned short fieldId, dcgmcm_s
 dcgmReturn_t DcgmCoreProxy::GetGroupEntities(unsigned int groupId, std::vector<dcgmGroupEntityPair_t> &entities) const
 {
     dcgmCoreGetGroupEntities_t gge = {};
-    gge.request.connectionId       = 0;
-    gge.request.groupId            = groupId;
+    dcgmReturn_t ret               = DCGM_ST_OK;
+    size_t const initialSize       = entities.size();
 
-    initializeCoreHeader(gge.header, DcgmCoreReqIdGMGetGroupEntities, dcgmCoreGetGroupEntities_version, sizeof(gge));
+    /* Page through the group. It can be larger than one response */
+    do
+    {
+        gge.request.connectionId = 0;
+        gge.request.groupId      = groupId;
+        gge.startIndex           = entities.size() - initialSize;
 
-    // coverity[overrun-buffer-val]
-    dcgmReturn_t ret = m_coreCallbacks.postfunc(&gge.header, m_coreCallbacks.poster);
+        initializeCoreHeader(
+            gge.header, DcgmCoreReqIdGMGetGroupEntities, dcgmCoreGetGroupEntities_version, sizeof(gge));
 
-    if (ret == DCGM_ST_OK)
-    {
-        for (unsigned int i = 0; i < gge.response.entityPairsCount; i++)
+        // coverity[overrun-buffer-val]
+        ret = m_coreCallbacks.postfunc(&gge.header, m_coreCallbacks.poster);
+        if (ret != DCGM_ST_OK)
         {
-            entities.push_back(gge.response.entityPairs[i]);
+            DCGM_LOG_ERROR << "Error '" << errorString(ret) << "' while attempting to get entities for group "
+                           << groupId;
+            return ret;
         }
 
-        ret = gge.response.ret;
-    }
-    else
-    {
-        DCGM_LOG_ERROR << "Error '" << errorString(ret) << "' while attempting to get entities for group " << groupId;
-    }
+        if (gge.response.ret != DCGM_ST_OK)
+        {
+            return gge.response.ret;
+        }
+
+        entities.insert(
+            entities.end(), &gge.response.entityPairs[0], &gge.response.entityPairs[gge.response.entityPairsCount]);
+    } while (gge.response.entityPairsCount > 0 && entities.size() - initialSize < gge.totalEntityPairs);
 
     return ret;
 }
@@ -1062,3 +1153,20 @@ dcgmReturn_t DcgmCoreProxy::GetServiceAccount(std::string &serviceAccount) const
 
     return DCGM_ST_OK;
 }
+
+dcgmReturn_t DcgmCoreProxy::GetIpcQueueWait(dcgmIntrospectQueueWait_t &queueWait) const
+{
+    dcgmCoreGetIpcQueueWait_t query {};
+    initializeCoreHeader(query.header, DcgmCoreReqGetIpcQueueWait, dcgmCoreGetIpcQueueWait_version1, sizeof(query));
+    // coverity[overrun-buffer-val]
+    dcgmReturn_t ret = m_coreCallbacks.postfunc(&query.header, m_coreCallbacks.poster);
+    if (ret != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "[CoreProxy] Got error: " << errorString(ret) << " while getting IPC queue wait times";
+        return ret;
+    }
+
+    queueWait = query.response.queueWait;
+
+    return query.response.ret;
+}
@@ -19,11 +19,36 @@
 
 #include <DcgmEntityTypes.hpp>
 #include <DcgmWatchTable.h>
+#include <ThreadPool.hpp>
 #include <dcgm_core_communication.h>
 #include <dcgm_module_structs.h>
 
+#include <future>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+/* How many GetSamplesBatchAsync() requests can be in the core at once */
+#define DCGM_CORE_PROXY_ASYNC_WORKERS 2
+
+/**
+ * The samples of one request of DcgmCoreProxy::GetSamplesBatch()
+ */
+struct DcgmCoreSamples
+{
+    dcgmReturn_t ret = DCGM_ST_OK;        // !< The status of GetSamples() for this request
+    std::vector<dcgmcm_sample_t> samples; // !< The samples that were found. The caller frees string and blob values
+};
+
+/**
+ * The result of DcgmCoreProxy::GetSamplesBatchAsync()
+ */
+struct DcgmCoreSamplesBatch
+{
+    dcgmReturn_t ret = DCGM_ST_OK;        // !< The status of the batch as a whole
+    std::vector<DcgmCoreSamples> results; // !< One entry per request, in the same order
+};
+
 
 class DcgmCoreProxy
 {
@@ -198,6 +223,29 @@ public:
                             timelib64_t endTime,
                             dcgmOrder_t order);
 
+    /**
+     * Get the samples of many (entity, field) pairs with a single request to the core
+     *
+     * @param[in]  requests - one GetSamples() call per entry. maxSamples is the most samples that entry returns
+     * @param[out] results - the samples and status of each entry of requests, in the same order
+     * @return the status of the batch as a whole. The status of each request is in its result
+     */
+    dcgmReturn_t GetSamplesBatch(std::vector<dcgmCoreGetSamplesParams_t> const &requests,
+                                 std::vector<DcgmCoreSamples> &results) const;
+
+    /**
+     * Same as GetSamplesBatch(), but runs on the proxy's worker threads so the calling thread, typically a module's
+     * TaskRunner, can keep working while the core processes the batch. If the workers are backed up, the batch runs
+     * on the calling thread and the returned future is already ready.
+     *
+     * The workers are shared by copies of this proxy and stop when the last copy is destroyed.
+     *
+     * @param[in] requests - one GetSamples() call per entry
+     * @return a future of the status and results of the batch
+     */
+    std::shared_future<DcgmCoreSamplesBatch> GetSamplesBatchAsync(
+        std::vector<dcgmCoreGetSamplesParams_t> requests) const;
+
     /**
      * @param[in]  entities - a list of each entity id and group id
      * @param[in]  fieldIds - a list of the field ids to be retrieved
@@ -370,9 +418,24 @@ public:
 
     dcgmReturn_t GetServiceAccount(std::string &serviceAccount) const;
 
+    /**
+     * Get how long the hostengine's client requests waited to be processed, by priority class
+     */
+    dcgmReturn_t GetIpcQueueWait(dcgmIntrospectQueueWait_t &queueWait) const;
+
 private:
     dcgmCoreCallbacks_t m_coreCallbacks;
 
+    /* Workers of GetSamplesBatchAsync(). Started on first use */
+    struct AsyncWorkers
+    {
+        std::once_flag started;
+        std::unique_ptr<DcgmNs::ThreadPool> pool;
+    };
+    std::shared_ptr<AsyncWorkers> m_asyncWorkers;
+
+    DcgmNs::ThreadPool &GetAsyncWorkers() const;
+
     dcgmReturn_t GetMigInstanceEntityIdHelper(unsigned int gpuId,
                                               DcgmNs::Mig::Nvml::GpuInstanceId const &instanceId,
                                               DcgmNs::Mig::Nvml::ComputeInstanceId const &computeInstanceId,
@@ -21,6 +21,7 @@
 #include <DcgmHostEngineHandler.h>
 #include <DcgmStringHelpers.h>
 #include <DcgmVersion.hpp>
+#include <DcgmWireEncoding.h>
 #include <fmt/format.h>
 #include <sstream>
 
@@ -88,12 +89,19 @@ dcgmReturn_t DcgmModuleCore::ProcessMessage(dcgm_module_command_header_t *module
             case DCGM_CORE_SR_GET_ENTITY_GROUP_ENTITIES:
                 dcgmReturn = ProcessGetEntityGroupEntities(*(dcgm_core_msg_get_entity_group_entities_t *)moduleCommand);
                 break;
+            case DCGM_CORE_SR_GET_ENTITY_GROUP_ENTITIES_V2:
+                dcgmReturn
+                    = ProcessGetEntityGroupEntitiesV2(*(dcgm_core_msg_get_entity_group_entities_v2 *)moduleCommand);
+                break;
             case DCGM_CORE_SR_GROUP_GET_ALL_IDS:
                 dcgmReturn = ProcessGroupGetAllIds(*(dcgm_core_msg_group_get_all_ids_t *)moduleCommand);
                 break;
             case DCGM_CORE_SR_GROUP_GET_INFO:
                 dcgmReturn = ProcessGroupGetInfo(*(dcgm_core_msg_group_get_info_t *)moduleCommand);
                 break;
+            case DCGM_CORE_SR_GROUP_GET_ENTITIES:
+                dcgmReturn = ProcessGroupGetEntities(*(dcgm_core_msg_group_get_entities_t *)moduleCommand);
+                break;
             case DCGM_CORE_SR_JOB_START_STATS:
                 dcgmReturn = ProcessJobStartStats(*(dcgm_core_msg_job_cmd_t *)moduleCommand);
                 break;
@@ -117,6 +125,14 @@ dcgmReturn_t DcgmModuleCore::ProcessMessage(dcgm_module_command_header_t *module
                 dcgmReturn
                     = ProcessEntitiesGetLatestValuesV2(*(dcgm_core_msg_entities_get_latest_values_v2 *)moduleCommand);
                 break;
+            case DCGM_CORE_SR_ENTITIES_GET_CYCLE_VALUES:
+                dcgmReturn
+                    = ProcessEntitiesGetCycleValues(*(dcgm_core_msg_entities_get_cycle_values_t *)moduleCommand);
+                break;
+            case DCGM_CORE_SR_GET_LATEST_VALUE_CHANGES:
+                dcgmReturn
+                    = ProcessGetLatestValueChanges(*(dcgm_core_msg_get_latest_value_changes_t *)moduleCommand);
+                break;
             case DCGM_CORE_SR_GET_MULTIPLE_VALUES_FOR_FIELD_V1:
                 dcgmReturn = ProcessGetMultipleValuesForFieldV1(
                     *(dcgm_core_msg_get_multiple_values_for_field_v1 *)moduleCommand);
@@ -220,6 +236,34 @@ dcgmReturn_t DcgmModuleCore::ProcessMessage(dcgm_module_command_header_t *module
                 dcgmReturn = ProcessPauseResume(*(dcgm_core_msg_pause_resume_v1 *)moduleCommand);
                 break;
 
+            case DCGM_CORE_SR_GET_FORCED_UPDATES:
+                dcgmReturn = ProcessGetForcedUpdates(*(dcgm_core_msg_get_forced_updates_t *)moduleCommand);
+                break;
+
+            case DCGM_CORE_SR_CLIENT_CACHE_SUBSCRIBE:
+                dcgmReturn = ProcessClientCacheSubscribe(*(dcgm_core_msg_client_cache_subscribe_t *)moduleCommand);
+                break;
+
+            case DCGM_CORE_SR_GET_CACHE_MEMORY:
+                dcgmReturn = ProcessGetCacheMemory(*(dcgm_core_msg_get_cache_memory_t *)moduleCommand);
+                break;
+
+            case DCGM_CORE_SR_SET_CACHE_MEMORY_BUDGET:
+                dcgmReturn = ProcessSetCacheMemoryBudget(*(dcgm_core_msg_set_cache_memory_budget_t *)moduleCommand);
+                break;
+
+            case DCGM_CORE_SR_GET_FEDERATION_NODES:
+                dcgmReturn = ProcessGetFederationNodes(*(dcgm_core_msg_get_federation_nodes_t *)moduleCommand);
+                break;
+
+            case DCGM_CORE_SR_GET_FEDERATION_VALUES:
+                dcgmReturn = ProcessGetFederationValues(*(dcgm_core_msg_get_federation_values_t *)moduleCommand);
+                break;
+            case DCGM_CORE_SR_NEGOTIATE_WIRE_ENCODING:
+                dcgmReturn
+                    = ProcessNegotiateWireEncoding(*(dcgm_core_msg_negotiate_wire_encoding_t *)moduleCommand);
+                break;
+
 #ifdef INJECTION_LIBRARY_AVAILABLE
             case DCGM_CORE_SR_NVML_INJECT_DEVICE:
                 dcgmReturn = ProcessNvmlInjectDevice(*(dcgm_core_msg_nvml_inject_device_t *)moduleCommand);
@@ -238,9 +282,48 @@ dcgmReturn_t DcgmModuleCore::ProcessMessage(dcgm_module_command_header_t *module
                        << " returned: " << errorString(dcgmReturn);
     }
 
+    /* Invalidate before the response goes out so a client sees its own changes */
+    InvalidateClientCaches(moduleCommand->subCommand);
+
     return dcgmReturn;
 }
 
+void DcgmModuleCore::InvalidateClientCaches(unsigned int subCommand)
+{
+    switch (subCommand)
+    {
+        case DCGM_CORE_SR_MIG_ENTITY_CREATE:
+        case DCGM_CORE_SR_MIG_ENTITY_DELETE:
+        case DCGM_CORE_SR_REMOVE_ENTITY:
+        case DCGM_CORE_SR_GROUP_ADD_ENTITY:
+        case DCGM_CORE_SR_GROUP_DESTROY:
+        case DCGM_CORE_SR_FIELDGROUP_DESTROY:
+        case DCGM_CORE_SR_CREATE_FAKE_ENTITIES:
+        case DCGM_CORE_SR_NVML_CREATE_FAKE_ENTITY:
+            DcgmHostEngineHandler::Instance()->InvalidateClientCaches(true);
+            break;
+
+        case DCGM_CORE_SR_WATCH_FIELD_VALUE_V1:
+        case DCGM_CORE_SR_WATCH_FIELD_VALUE_V2:
+        case DCGM_CORE_SR_UNWATCH_FIELD_VALUE:
+        case DCGM_CORE_SR_INJECT_FIELD_VALUE:
+        case DCGM_CORE_SR_WATCH_FIELDS:
+        case DCGM_CORE_SR_UNWATCH_FIELDS:
+        case DCGM_CORE_SR_SET_ENTITY_LINK_STATE:
+        case DCGM_CORE_SR_WATCH_PREDEFINED_FIELDS:
+        case DCGM_CORE_SR_NVML_INJECT_FIELD_VALUE:
+        case DCGM_CORE_SR_NVML_INJECT_DEVICE:
+        case DCGM_CORE_SR_PAUSE_RESUME:
+        case DCGM_CORE_SR_SET_CACHE_MEMORY_BUDGET:
+            DcgmHostEngineHandler::Instance()->InvalidateClientCaches(false);
+            break;
+
+        default:
+            /* Read-only or doesn't affect anything clients cache */
+            break;
+    }
+}
+
 void DcgmModuleCore::Initialize(DcgmCacheManager *cm)
 {
     m_cacheManager = cm;
@@ -375,6 +458,8 @@ dcgmReturn_t DcgmModuleCore::ProcessGroupDestroy(dcgm_core_msg_group_destroy_t &
         return DCGM_ST_OK;
     }
 
+    DcgmHostEngineHandler::Instance()->GetFvChangeTracker().OnGroupRemove(groupId);
+
     msg.gd.cmdRet = DCGM_ST_OK;
 
     return DCGM_ST_OK;
@@ -420,6 +505,44 @@ dcgmReturn_t DcgmModuleCore::ProcessGetEntityGroupEntities(dcgm_core_msg_get_ent
     return DCGM_ST_OK;
 }
 
+dcgmReturn_t DcgmModuleCore::ProcessGetEntityGroupEntitiesV2(dcgm_core_msg_get_entity_group_entities_v2 &msg)
+{
+    std::vector<dcgmGroupEntityPair_t> entities;
+
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_entity_group_entities_version2);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    int onlySupported = (msg.flags & DCGM_GEGE_FLAG_ONLY_SUPPORTED) ? 1 : 0;
+
+    ret = DcgmHostEngineHandler::Instance()->GetAllEntitiesOfEntityGroup(
+        onlySupported, (dcgm_field_entity_group_t)msg.entityGroup, entities);
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    msg.totalEntities = entities.size();
+    msg.numEntities   = 0;
+
+    if (msg.startIndex > entities.size())
+    {
+        DCGM_LOG_ERROR << "startIndex " << msg.startIndex << " is past the " << entities.size()
+                       << " entities of entity group " << msg.entityGroup;
+        return DCGM_ST_BADPARAM;
+    }
+
+    for (size_t i = msg.startIndex; i < entities.size() && msg.numEntities < DCGM_GROUP_ENTITIES_PAGE_SIZE; i++)
+    {
+        msg.entities[msg.numEntities++] = entities[i].entityId;
+    }
+
+    return DCGM_ST_OK;
+}
+
 dcgmReturn_t DcgmModuleCore::ProcessGroupGetAllIds(dcgm_core_msg_group_get_all_ids_t &msg)
 {
     std::vector<dcgmGroupEntityPair_t> entities;
@@ -501,8 +624,10 @@ dcgmReturn_t DcgmModuleCore::ProcessGroupGetInfo(dcgm_core_msg_group_get_info_t
 
     if (entities.size() > DCGM_GROUP_MAX_ENTITIES)
     {
-        DCGM_LOG_ERROR << fmt::format(
-            "Number of entities in the group {} exceeds DCGM_GROUP_MAX_ENTITIES={}.", groupId, DCGM_GROUP_MAX_ENTITIES);
+        DCGM_LOG_DEBUG << fmt::format(
+            "Number of entities in the group {} exceeds DCGM_GROUP_MAX_ENTITIES={}. Use dcgmGroupGetEntities() instead.",
+            groupId,
+            DCGM_GROUP_MAX_ENTITIES);
         msg.gi.cmdRet = DCGM_ST_MAX_LIMIT;
         return DCGM_ST_OK;
     }
@@ -522,6 +647,61 @@ dcgmReturn_t DcgmModuleCore::ProcessGroupGetInfo(dcgm_core_msg_group_get_info_t
     return DCGM_ST_OK;
 }
 
+dcgmReturn_t DcgmModuleCore::ProcessGroupGetEntities(dcgm_core_msg_group_get_entities_t &msg)
+{
+    std::vector<dcgmGroupEntityPair_t> entities;
+
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_group_get_entities_version);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    if (msg.entities.version != dcgmGroupEntities_version1)
+    {
+        DCGM_LOG_ERROR << "Version mismatch x" << std::hex << msg.entities.version << " != x"
+                       << dcgmGroupEntities_version1;
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    unsigned int groupId = msg.groupId;
+
+    ret = m_groupManager->verifyAndUpdateGroupId(&groupId);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Error: Bad group id parameter";
+        return ret;
+    }
+
+    ret = m_groupManager->GetGroupEntities(groupId, entities);
+    if (ret != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "Got ret " << ret << " from GetGroupEntities. groupId " << groupId;
+        return ret;
+    }
+
+    msg.timestamp           = timelib_usecSince1970();
+    msg.entities.totalCount = entities.size();
+    msg.entities.count      = 0;
+
+    if (msg.entities.startIndex > entities.size())
+    {
+        DCGM_LOG_ERROR << "startIndex " << msg.entities.startIndex << " is past the " << entities.size()
+                       << " entities of groupId " << groupId;
+        return DCGM_ST_BADPARAM;
+    }
+
+    for (size_t i = msg.entities.startIndex;
+         i < entities.size() && msg.entities.count < DCGM_GROUP_ENTITIES_PAGE_SIZE;
+         i++)
+    {
+        msg.entities.entityList[msg.entities.count++] = entities[i];
+    }
+
+    return DCGM_ST_OK;
+}
+
 dcgmReturn_t DcgmModuleCore::ProcessJobStartStats(dcgm_core_msg_job_cmd_t &msg)
 {
     dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_job_cmd_version);
@@ -881,6 +1061,157 @@ dcgmReturn_t DcgmModuleCore::ProcessEntitiesGetLatestValuesV2(dcgm_core_msg_enti
     return DCGM_ST_OK;
 }
 
+dcgmReturn_t DcgmModuleCore::ProcessGetLatestValueChanges(dcgm_core_msg_get_latest_value_changes_t &msg)
+{
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_latest_value_changes_version);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    /* initialize length of response to handle failure cases */
+    msg.header.length = sizeof(dcgm_core_msg_get_latest_value_changes_t) - SAMPLES_BUFFER_SIZE_V2;
+    msg.vc.bufferSize = 0;
+    msg.vc.isResync   = 0;
+
+    std::vector<dcgmGroupEntityPair_t> entities;
+    std::vector<unsigned short> fieldIds;
+
+    /* If this is a special group ID, convert it to a real one so every alias shares what was sent */
+    unsigned int groupId = msg.vc.groupId;
+    ret                  = m_groupManager->verifyAndUpdateGroupId(&groupId);
+    if (ret == DCGM_ST_OK)
+    {
+        ret = m_groupManager->GetGroupEntities(groupId, entities);
+    }
+    if (ret != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "Got ret " << ret << " resolving groupId " << msg.vc.groupId;
+        msg.vc.cmdRet = ret;
+        return DCGM_ST_OK;
+    }
+
+    DcgmFieldGroupManager *mpFieldGroupManager = DcgmHostEngineHandler::Instance()->GetFieldGroupManager();
+
+    ret = mpFieldGroupManager->GetFieldGroupFields(msg.vc.fieldGroupId, fieldIds);
+    if (ret != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "Got ret " << ret << " from GetFieldGroupFields. fieldGroupId " << msg.vc.fieldGroupId;
+        msg.vc.cmdRet = ret;
+        return DCGM_ST_OK;
+    }
+
+    DcgmFvBuffer latest(FVBUFFER_GUESS_INITIAL_CAPACITY(entities.size(), fieldIds.size()));
+    ret = m_cacheManager->GetMultipleLatestSamples(entities, fieldIds, &latest);
+    if (ret != DCGM_ST_OK)
+    {
+        msg.vc.cmdRet = ret;
+        return DCGM_ST_OK;
+    }
+
+    /* Unchanged values are dropped here, before they're copied into the response */
+    DcgmFvChangeTracker &tracker = DcgmHostEngineHandler::Instance()->GetFvChangeTracker();
+    DcgmFvBuffer changes(0);
+    bool isResync = false;
+
+    ret = tracker.GetChanges(msg.header.connectionId,
+                             groupId,
+                             msg.vc.fieldGroupId,
+                             msg.vc.resyncInterval,
+                             latest,
+                             sizeof(msg.vc.buffer),
+                             changes,
+                             isResync);
+    if (ret != DCGM_ST_OK)
+    {
+        msg.vc.cmdRet = ret;
+        return DCGM_ST_OK;
+    }
+
+    size_t elementCount = 0;
+    changes.GetSize((size_t *)&msg.vc.bufferSize, &elementCount);
+    if (msg.vc.bufferSize > 0)
+    {
+        memcpy(&msg.vc.buffer, changes.GetBuffer(), (size_t)msg.vc.bufferSize);
+    }
+
+    DCGM_LOG_DEBUG << "Sending " << elementCount << " changed values to connectionId " << msg.header.connectionId
+                   << ". isResync " << isResync;
+
+    /* calculate actual message size to avoid transferring extra data */
+    msg.header.length
+        = sizeof(dcgm_core_msg_get_latest_value_changes_t) - SAMPLES_BUFFER_SIZE_V2 + msg.vc.bufferSize;
+    msg.vc.isResync = isResync ? 1 : 0;
+    msg.vc.cmdRet   = DCGM_ST_OK;
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessEntitiesGetCycleValues(dcgm_core_msg_entities_get_cycle_values_t &msg)
+{
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_entities_get_cycle_values_version);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    /* initialize length of response to handle failure cases */
+    msg.header.length = sizeof(dcgm_core_msg_entities_get_cycle_values_t) - SAMPLES_BUFFER_SIZE_V2;
+
+    if (msg.cv.entitiesCount == 0 || msg.cv.entitiesCount > DCGM_GROUP_MAX_ENTITIES || msg.cv.fieldIdCount == 0
+        || msg.cv.fieldIdCount > DCGM_MAX_FIELD_IDS_PER_FIELD_GROUP || msg.cv.timeoutMs > DCGM_MAX_CYCLE_WAIT_MS)
+    {
+        DCGM_LOG_ERROR << "Invalid entitiesCount " << msg.cv.entitiesCount << ", fieldIdCount " << msg.cv.fieldIdCount
+                       << " or timeoutMs " << msg.cv.timeoutMs;
+        msg.cv.cmdRet = DCGM_ST_BADPARAM;
+        return DCGM_ST_OK;
+    }
+
+    std::vector<dcgmGroupEntityPair_t> entities(&msg.cv.entities[0], &msg.cv.entities[msg.cv.entitiesCount]);
+    std::vector<unsigned short> fieldIds(&msg.cv.fieldIdList[0], &msg.cv.fieldIdList[msg.cv.fieldIdCount]);
+
+    size_t initialCapacity = FVBUFFER_GUESS_INITIAL_CAPACITY(entities.size(), fieldIds.size());
+    DcgmFvBuffer fvBuffer(initialCapacity);
+
+    ret = m_cacheManager->GetMultipleSamplesForCycle(entities, fieldIds, msg.cv.cycleId, msg.cv.timeoutMs, &fvBuffer);
+    if (ret != DCGM_ST_OK)
+    {
+        msg.cv.cmdRet = ret;
+        return DCGM_ST_OK;
+    }
+
+    const char *fvBufferBytes = fvBuffer.GetBuffer();
+    size_t elementCount       = 0;
+
+    fvBuffer.GetSize((size_t *)&msg.cv.bufferSize, &elementCount);
+
+    if ((fvBufferBytes == nullptr) || (msg.cv.bufferSize == 0))
+    {
+        DCGM_LOG_ERROR << "Unexpected fvBuffer " << (void *)fvBufferBytes << ", fvBufferBytes " << msg.cv.bufferSize;
+        msg.cv.cmdRet = DCGM_ST_GENERIC_ERROR;
+        return DCGM_ST_OK;
+    }
+
+    if (msg.cv.bufferSize > sizeof(msg.cv.buffer))
+    {
+        DCGM_LOG_ERROR << "Buffer size too small, consider smaller request: " << msg.cv.bufferSize << ">"
+                       << sizeof(msg.cv.buffer);
+        msg.cv.bufferSize = sizeof(msg.cv.buffer);
+        msg.cv.cmdRet     = DCGM_ST_INSUFFICIENT_SIZE;
+        return DCGM_ST_OK;
+    }
+
+    memcpy(&msg.cv.buffer, fvBufferBytes, (size_t)msg.cv.bufferSize);
+
+    /* calculate actual message size to avoid transferring extra data */
+    msg.header.length = sizeof(dcgm_core_msg_entities_get_cycle_values_t) - SAMPLES_BUFFER_SIZE_V2 + msg.cv.bufferSize;
+    msg.cv.cmdRet     = DCGM_ST_OK;
+
+    return DCGM_ST_OK;
+}
+
 dcgmReturn_t DcgmModuleCore::ProcessGetMultipleValuesForFieldV1(dcgm_core_msg_get_multiple_values_for_field_v1 &msg)
 {
     dcgmReturn_t ret;
@@ -949,9 +1280,17 @@ dcgmReturn_t DcgmModuleCore::ProcessGetMultipleValuesForFieldV1(dcgm_core_msg_ge
         return DCGM_ST_OK;
     }
 
+    /* Read through this connection's decimated view if its watch of the field has one */
+    dcgm_connection_id_t connectionId = msg.header.connectionId;
+    if (DcgmHostEngineHandler::Instance()->GetPersistAfterDisconnect(msg.header.connectionId))
+    {
+        connectionId = DCGM_CONNECTION_ID_NONE;
+    }
+    DcgmWatcher dcgmWatcher(DcgmWatcherTypeClient, connectionId);
+
     NsampleBuffer = MsampleBuffer;
     ret           = m_cacheManager->GetSamples(
-        entityGroupId, entityId, fieldId, nullptr, &NsampleBuffer, startTs, endTs, order, &fvBuffer);
+        entityGroupId, entityId, fieldId, nullptr, &NsampleBuffer, startTs, endTs, order, &fvBuffer, &dcgmWatcher);
     if (ret != DCGM_ST_OK)
     {
         msg.fv.cmdRet = ret;
@@ -1055,9 +1394,17 @@ dcgmReturn_t DcgmModuleCore::ProcessGetMultipleValuesForFieldV2(dcgm_core_msg_ge
         return DCGM_ST_OK;
     }
 
+    /* Read through this connection's decimated view if its watch of the field has one */
+    dcgm_connection_id_t connectionId = msg.header.connectionId;
+    if (DcgmHostEngineHandler::Instance()->GetPersistAfterDisconnect(msg.header.connectionId))
+    {
+        connectionId = DCGM_CONNECTION_ID_NONE;
+    }
+    DcgmWatcher dcgmWatcher(DcgmWatcherTypeClient, connectionId);
+
     NsampleBuffer = MsampleBuffer;
     ret           = m_cacheManager->GetSamples(
-        entityGroupId, entityId, fieldId, nullptr, &NsampleBuffer, startTs, endTs, order, &fvBuffer);
+        entityGroupId, entityId, fieldId, nullptr, &NsampleBuffer, startTs, endTs, order, &fvBuffer, &dcgmWatcher);
     if (ret != DCGM_ST_OK)
     {
         msg.fv.cmdRet = ret;
@@ -1169,7 +1516,7 @@ dcgmReturn_t DcgmModuleCore::ProcessUpdateAllFields(dcgm_core_msg_update_all_fie
         return ret;
     }
 
-    msg.uf.cmdRet = m_cacheManager->UpdateAllFields(msg.uf.waitForUpdate);
+    msg.uf.cmdRet = m_cacheManager->UpdateAllFields(msg.uf.waitForUpdate, true);
 
     return DCGM_ST_OK;
 }
@@ -1288,7 +1635,7 @@ dcgmReturn_t DcgmModuleCore::ProcessInjectFieldValue(dcgm_core_msg_inject_field_
 
 dcgmReturn_t DcgmModuleCore::ProcessGetCacheManagerFieldInfo(dcgm_core_msg_get_cache_manager_field_info_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_cache_manager_field_info_version2);
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_cache_manager_field_info_version3);
     if (ret != DCGM_ST_OK)
     {
         DCGM_LOG_ERROR << "Version mismatch";
@@ -1624,6 +1971,11 @@ dcgmReturn_t DcgmModuleCore::ProcessFieldgroupOp(dcgm_core_msg_fieldgroup_op_t &
     else if (msg.header.subCommand == DCGM_CORE_SR_FIELDGROUP_DESTROY)
     {
         ret = mpFieldGroupManager->RemoveFieldGroup(msg.info.fg.fieldGroupId, dcgmWatcher);
+        if (ret == DCGM_ST_OK)
+        {
+            DcgmHostEngineHandler::Instance()->GetFvChangeTracker().OnFieldGroupRemove(
+                (unsigned int)(uintptr_t)msg.info.fg.fieldGroupId);
+        }
     }
     else if (msg.header.subCommand == DCGM_CORE_SR_FIELDGROUP_GET_INFO)
     {
@@ -2155,3 +2507,158 @@ dcgmReturn_t DcgmModuleCore::ProcessPauseResume(dcgm_core_msg_pause_resume_v1 &m
     }
     return msg.pause ? m_cacheManager->Pause() : m_cacheManager->Resume();
 }
+
+dcgmReturn_t DcgmModuleCore::ProcessGetForcedUpdates(dcgm_core_msg_get_forced_updates_t &msg)
+{
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_forced_updates_version);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    if (msg.forcedUpdates.version != dcgmIntrospectForcedUpdates_version1)
+    {
+        DCGM_LOG_ERROR << "Version mismatch x" << std::hex << msg.forcedUpdates.version
+                       << " != x" << dcgmIntrospectForcedUpdates_version1;
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    dcgmcm_forced_update_stats_t stats = m_cacheManager->GetForcedUpdateStats();
+
+    msg.forcedUpdates.numRequests    = stats.numRequests;
+    msg.forcedUpdates.numExecuted    = stats.numExecuted;
+    msg.forcedUpdates.numCoalesced   = stats.numCoalesced;
+    msg.forcedUpdates.numSkipped     = stats.numSkipped;
+    msg.forcedUpdates.minSpacingUsec = stats.minSpacingUsec;
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessClientCacheSubscribe(dcgm_core_msg_client_cache_subscribe_t &msg)
+{
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_client_cache_subscribe_version);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    DcgmHostEngineHandler *hostEngineHandler = DcgmHostEngineHandler::Instance();
+
+    /* Subscribe first so no generation change between here and the response is missed */
+    ret = hostEngineHandler->AddClientCacheSubscriber(msg.header.connectionId, msg.header.requestId);
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    hostEngineHandler->GetClientCacheGenerations(msg.configGeneration, msg.valuesGeneration);
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessGetCacheMemory(dcgm_core_msg_get_cache_memory_t &msg)
+{
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_cache_memory_version);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    if (msg.cacheMemory.version != dcgmIntrospectCacheMemory_version1)
+    {
+        DCGM_LOG_ERROR << "Version mismatch x" << std::hex << msg.cacheMemory.version << " != x"
+                       << dcgmIntrospectCacheMemory_version1;
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    dcgmcm_cache_memory_stats_t stats = m_cacheManager->GetCacheMemoryStats();
+
+    msg.cacheMemory.budgetBytes    = stats.budgetBytes;
+    msg.cacheMemory.usedBytes      = stats.usedBytes;
+    msg.cacheMemory.numEvictions   = stats.numEvictions;
+    msg.cacheMemory.evictedSamples = stats.evictedSamples;
+    msg.cacheMemory.evictedBytes   = stats.evictedBytes;
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessSetCacheMemoryBudget(dcgm_core_msg_set_cache_memory_budget_t &msg)
+{
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_set_cache_memory_budget_version);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    return m_cacheManager->SetCacheMemoryBudget(msg.budgetBytes);
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessGetFederationNodes(dcgm_core_msg_get_federation_nodes_t &msg)
+{
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_federation_nodes_version);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    if (msg.nodes.version != dcgmFederationNodes_version1)
+    {
+        DCGM_LOG_ERROR << "Version mismatch x" << std::hex << msg.nodes.version << " != x"
+                       << dcgmFederationNodes_version1;
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    DcgmFederation *federation = DcgmHostEngineHandler::Instance()->GetFederation();
+    if (federation == nullptr)
+    {
+        DCGM_LOG_DEBUG << "This hostengine doesn't aggregate any hostengines";
+        return DCGM_ST_NOT_CONFIGURED;
+    }
+
+    return federation->GetNodes(msg.nodes);
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessGetFederationValues(dcgm_core_msg_get_federation_values_t &msg)
+{
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_federation_values_version);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    if (msg.values.version != dcgmFederationValues_version1)
+    {
+        DCGM_LOG_ERROR << "Version mismatch x" << std::hex << msg.values.version << " != x"
+                       << dcgmFederationValues_version1;
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    DcgmFederation *federation = DcgmHostEngineHandler::Instance()->GetFederation();
+    if (federation == nullptr)
+    {
+        DCGM_LOG_DEBUG << "This hostengine doesn't aggregate any hostengines";
+        return DCGM_ST_NOT_CONFIGURED;
+    }
+
+    return federation->GetLatestValues(msg.values);
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessNegotiateWireEncoding(dcgm_core_msg_negotiate_wire_encoding_t &msg)
+{
+    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_negotiate_wire_encoding_version);
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return ret;
+    }
+
+    msg.encodings &= DCGM_WIRE_ENCODING_MASK_ALL;
+    DCGM_LOG_DEBUG << "connectionId " << msg.header.connectionId << " negotiated wire encodings x" << std::hex
+                   << msg.encodings;
+    return DCGM_ST_OK;
+}
@@ -43,8 +43,10 @@ public:
     dcgmReturn_t ProcessAddRemoveEntity(dcgm_core_msg_add_remove_entity_t &msg);
     dcgmReturn_t ProcessGroupDestroy(dcgm_core_msg_group_destroy_t &msg);
     dcgmReturn_t ProcessGetEntityGroupEntities(dcgm_core_msg_get_entity_group_entities_t &msg);
+    dcgmReturn_t ProcessGetEntityGroupEntitiesV2(dcgm_core_msg_get_entity_group_entities_v2 &msg);
     dcgmReturn_t ProcessGroupGetAllIds(dcgm_core_msg_group_get_all_ids_t &msg);
     dcgmReturn_t ProcessGroupGetInfo(dcgm_core_msg_group_get_info_t &msg);
+    dcgmReturn_t ProcessGroupGetEntities(dcgm_core_msg_group_get_entities_t &msg);
     dcgmReturn_t ProcessJobStartStats(dcgm_core_msg_job_cmd_t &msg);
     dcgmReturn_t ProcessJobStopStats(dcgm_core_msg_job_cmd_t &msg);
     dcgmReturn_t ProcessJobGetStats(dcgm_core_msg_job_get_stats_t &msg);
@@ -52,6 +54,15 @@ public:
     dcgmReturn_t ProcessJobRemoveAll(dcgm_core_msg_job_cmd_t &msg);
     dcgmReturn_t ProcessEntitiesGetLatestValuesV1(dcgm_core_msg_entities_get_latest_values_v1 &msg);
     dcgmReturn_t ProcessEntitiesGetLatestValuesV2(dcgm_core_msg_entities_get_latest_values_v2 &msg);
+    dcgmReturn_t ProcessEntitiesGetCycleValues(dcgm_core_msg_entities_get_cycle_values_t &msg);
+    dcgmReturn_t ProcessGetLatestValueChanges(dcgm_core_msg_get_latest_value_changes_t &msg);
+    dcgmReturn_t ProcessGetForcedUpdates(dcgm_core_msg_get_forced_updates_t &msg);
+    dcgmReturn_t ProcessClientCacheSubscribe(dcgm_core_msg_client_cache_subscribe_t &msg);
+    dcgmReturn_t ProcessGetCacheMemory(dcgm_core_msg_get_cache_memory_t &msg);
+    dcgmReturn_t ProcessSetCacheMemoryBudget(dcgm_core_msg_set_cache_memory_budget_t &msg);
+    dcgmReturn_t ProcessGetFederationNodes(dcgm_core_msg_get_federation_nodes_t &msg);
+    dcgmReturn_t ProcessGetFederationValues(dcgm_core_msg_get_federation_values_t &msg);
+    dcgmReturn_t ProcessNegotiateWireEncoding(dcgm_core_msg_negotiate_wire_encoding_t &msg);
     dcgmReturn_t ProcessGetMultipleValuesForFieldV1(dcgm_core_msg_get_multiple_values_for_field_v1 &msg);
     dcgmReturn_t ProcessGetMultipleValuesForFieldV2(dcgm_core_msg_get_multiple_values_for_field_v2 &msg);
     dcgmReturn_t ProcessWatchFieldValueV1(dcgm_core_msg_watch_field_value_v1 &msg);
@@ -90,6 +101,9 @@ public:
     dcgmModuleProcessMessage_f GetMessageProcessingCallback() const;
 
 private:
+    /* Tell client read-through caches about changes made by a subcommand, if it made any */
+    void InvalidateClientCaches(unsigned int subCommand);
+
     DcgmCacheManager *m_cacheManager;
     DcgmGroupManager *m_groupManager;
     dcgmModuleProcessMessage_f m_processMsgCB;
@@ -58,6 +58,8 @@ typedef enum
     DcgmCoreReqIdGetMigUtilization              = 46, // DcgmCacheManager::GetMigUtilization()
     DcgmCoreReqMigIndicesForEntity              = 47, // DcgmCacheManager::GetMigIndicesForEntity()
     DcgmCoreReqGetServiceAccount                = 48, // DcgmHostEngineHandler::GetServiceAccount()
+    DcgmCoreReqGetIpcQueueWait                  = 49, // DcgmHostEngineHandler::GetIpcQueueWait()
+    DcgmCoreReqIdCMGetSamplesBatch              = 50, // DcgmCacheManager::GetSamples() for many entities and fields
     DcgmCoreReqIdCount                                // Always keep this one last
 } dcgmCoreReqCmd_t;
 
@@ -74,6 +76,8 @@ typedef struct
     dcgmCoreReqPost_f postfunc;      // !< function pointer to post a request to the core library
     void *poster;                    // !< pointer to the object that will forward the request to the core modules
     dcgmLoggerCallback_f loggerfunc; // !< function pointer to send logging messages to the hostengine
+    timelib_clock_f clockfunc;       // !< function pointer to read the hostengine's clock. Modules use it in place
+                                     //    of their own copy of timelib so they see the hostengine's VirtualClock
 } dcgmCoreCallbacks_v1;
 
 #define dcgmCoreCallbacks_version1 MAKE_DCGM_VERSION(dcgmCoreCallbacks_v1, 1)
@@ -626,12 +630,14 @@ typedef struct
 {
     dcgm_module_command_header_t header; // Command header
     dcgmCoreBasicGroupParams_t request;
-    dcgmCoreEntityInfoResponse_t response;
-} dcgmCoreGetGroupEntities_v1;
+    unsigned int startIndex;               // IN: Index of the first entity to return
+    unsigned int totalEntityPairs;         // OUT: Number of entities in the group
+    dcgmCoreEntityInfoResponse_t response; // OUT: Up to DCGM_GROUP_MAX_ENTITIES entities from startIndex on
+} dcgmCoreGetGroupEntities_v2;
 
-#define dcgmCoreGetGroupEntities_version1 MAKE_DCGM_VERSION(dcgmCoreGetGroupEntities_v1, 1)
-#define dcgmCoreGetGroupEntities_version  dcgmCoreGetGroupEntities_version1
-typedef dcgmCoreGetGroupEntities_v1 dcgmCoreGetGroupEntities_t;
+#define dcgmCoreGetGroupEntities_version2 MAKE_DCGM_VERSION(dcgmCoreGetGroupEntities_v2, 2)
+#define dcgmCoreGetGroupEntities_version  dcgmCoreGetGroupEntities_version2
+typedef dcgmCoreGetGroupEntities_v2 dcgmCoreGetGroupEntities_t;
 
 typedef struct
 {
@@ -740,3 +746,52 @@ typedef struct
 #define dcgmCoreGetServiceAccount_version1 MAKE_DCGM_VERSION(dcgmCoreGetServiceAccount_v1, 1)
 #define dcgmCoreGetServiceAccount_version  dcgmCoreGetServiceAccount_version1
 typedef dcgmCoreGetServiceAccount_v1 dcgmCoreGetServiceAccount_t;
+
+typedef struct
+{
+    dcgmReturn_t ret;
+    dcgmIntrospectQueueWait_t queueWait;
+} dcgmCoreGetIpcQueueWaitResponse_t;
+
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmCoreGetIpcQueueWaitResponse_t response;
+} dcgmCoreGetIpcQueueWait_v1;
+
+#define dcgmCoreGetIpcQueueWait_version1 MAKE_DCGM_VERSION(dcgmCoreGetIpcQueueWait_v1, 1)
+#define dcgmCoreGetIpcQueueWait_version  dcgmCoreGetIpcQueueWait_version1
+typedef dcgmCoreGetIpcQueueWait_v1 dcgmCoreGetIpcQueueWait_t;
+
+/**
+ * The result of one request of a dcgmCoreGetSamplesBatch_t
+ */
+typedef struct
+{
+    dcgmReturn_t ret;        // !< The status of GetSamples() for this request
+    dcgmcm_sample_p samples; // !< Where to store up to maxSamples samples. Owned by the caller
+    int numSamples;          // !< The number of samples stored in samples
+} dcgmCoreGetSamplesResult_t;
+
+typedef struct
+{
+    unsigned int numRequests;                   // !< The number of entries of requests and results
+    dcgmCoreGetSamplesParams_t const *requests; // !< One GetSamples() call per entry
+} dcgmCoreGetSamplesBatchParams_t;
+
+typedef struct
+{
+    dcgmReturn_t ret;                    // !< The status of the batch as a whole
+    dcgmCoreGetSamplesResult_t *results; // !< Result of each entry of requests. Owned by the caller
+} dcgmCoreGetSamplesBatchResponse_t;
+
+typedef struct
+{
+    dcgm_module_command_header_t header; // Command header
+    dcgmCoreGetSamplesBatchParams_t request;
+    dcgmCoreGetSamplesBatchResponse_t response;
+} dcgmCoreGetSamplesBatch_v1;
+
+#define dcgmCoreGetSamplesBatch_version1 MAKE_DCGM_VERSION(dcgmCoreGetSamplesBatch_v1, 1)
+#define dcgmCoreGetSamplesBatch_version  dcgmCoreGetSamplesBatch_version1
+typedef dcgmCoreGetSamplesBatch_v1 dcgmCoreGetSamplesBatch_t;
@@ -79,6 +79,17 @@
 #define DCGM_CORE_SR_NVML_INJECT_FIELD_VALUE          56 /* Inject a value into injection NVML */
 #define DCGM_CORE_SR_NVML_INJECT_DEVICE               57 /* Inject a value for an NVML device */
 #define DCGM_CORE_SR_PAUSE_RESUME                     58 /* Pause/Resume all metrics collection */
+#define DCGM_CORE_SR_ENTITIES_GET_CYCLE_VALUES        59 /* Get field values as of one completed update cycle */
+#define DCGM_CORE_SR_GET_FORCED_UPDATES               60 /* Get counts of executed vs coalesced forced updates */
+#define DCGM_CORE_SR_CLIENT_CACHE_SUBSCRIBE           61 /* Subscribe to client cache invalidations */
+#define DCGM_CORE_SR_GET_CACHE_MEMORY                 62 /* Get the memory used by the cache and its budget */
+#define DCGM_CORE_SR_SET_CACHE_MEMORY_BUDGET          63 /* Set the memory budget of the cache */
+#define DCGM_CORE_SR_GET_FEDERATION_NODES             64 /* Get the state of federated downstream hostengines */
+#define DCGM_CORE_SR_GET_FEDERATION_VALUES            65 /* Get field values mirrored from downstream hostengines */
+#define DCGM_CORE_SR_NEGOTIATE_WIRE_ENCODING          66 /* Agree on the wire encodings of module commands */
+#define DCGM_CORE_SR_GROUP_GET_ENTITIES               67 /* Get a page of the entities of a group */
+#define DCGM_CORE_SR_GET_ENTITY_GROUP_ENTITIES_V2     68 /* Get a page of the entities of an entity group */
+#define DCGM_CORE_SR_GET_LATEST_VALUE_CHANGES         69 /* Get the latest field values that changed since last time */
 
 /*****************************************************************************/
 /* Subrequest message definitions */
@@ -312,6 +323,36 @@ typedef struct
 #define dcgm_core_msg_entities_get_latest_values_version2 \
     MAKE_DCGM_VERSION(dcgm_core_msg_entities_get_latest_values_v2, 2)
 
+/**
+ * Subrequest DCGM_CORE_SR_ENTITIES_GET_CYCLE_VALUES
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmEntitiesGetCycleValues_v1 cv;
+} dcgm_core_msg_entities_get_cycle_values_v1;
+
+#define dcgm_core_msg_entities_get_cycle_values_version1 \
+    MAKE_DCGM_VERSION(dcgm_core_msg_entities_get_cycle_values_v1, 1)
+#define dcgm_core_msg_entities_get_cycle_values_version dcgm_core_msg_entities_get_cycle_values_version1
+
+typedef dcgm_core_msg_entities_get_cycle_values_v1 dcgm_core_msg_entities_get_cycle_values_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_GET_LATEST_VALUE_CHANGES
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmGetLatestValueChanges_v1 vc;
+} dcgm_core_msg_get_latest_value_changes_v1;
+
+#define dcgm_core_msg_get_latest_value_changes_version1 \
+    MAKE_DCGM_VERSION(dcgm_core_msg_get_latest_value_changes_v1, 1)
+#define dcgm_core_msg_get_latest_value_changes_version dcgm_core_msg_get_latest_value_changes_version1
+
+typedef dcgm_core_msg_get_latest_value_changes_v1 dcgm_core_msg_get_latest_value_changes_t;
+
 /* Used by DCGM 2.x clients */
 typedef struct
 {
@@ -391,13 +432,13 @@ typedef dcgm_core_msg_inject_field_value_v1 dcgm_core_msg_nvml_inject_field_valu
 typedef struct
 {
     dcgm_module_command_header_t header;
-    dcgmGetCacheManagerFieldInfo_v2 fi;
-} dcgm_core_msg_get_cache_manager_field_info_v2;
+    dcgmGetCacheManagerFieldInfo_v3 fi;
+} dcgm_core_msg_get_cache_manager_field_info_v3;
 
-#define dcgm_core_msg_get_cache_manager_field_info_version2 \
-    MAKE_DCGM_VERSION(dcgm_core_msg_get_cache_manager_field_info_v2, 2)
+#define dcgm_core_msg_get_cache_manager_field_info_version3 \
+    MAKE_DCGM_VERSION(dcgm_core_msg_get_cache_manager_field_info_v3, 3)
 
-typedef dcgm_core_msg_get_cache_manager_field_info_v2 dcgm_core_msg_get_cache_manager_field_info_t;
+typedef dcgm_core_msg_get_cache_manager_field_info_v3 dcgm_core_msg_get_cache_manager_field_info_t;
 
 typedef struct
 {
@@ -637,6 +678,146 @@ typedef struct dcgm_core_msg_pause_resume_v1
 
 typedef dcgm_core_msg_pause_resume_v1 dcgm_core_msg_pause_resume_t;
 
+/**
+ * Subrequest DCGM_CORE_SR_GET_FORCED_UPDATES
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header;         /* Command header */
+    dcgmIntrospectForcedUpdates_t forcedUpdates; /* OUT: Forced update counts */
+} dcgm_core_msg_get_forced_updates_v1;
+
+#define dcgm_core_msg_get_forced_updates_version1 MAKE_DCGM_VERSION(dcgm_core_msg_get_forced_updates_v1, 1)
+#define dcgm_core_msg_get_forced_updates_version  dcgm_core_msg_get_forced_updates_version1
+
+typedef dcgm_core_msg_get_forced_updates_v1 dcgm_core_msg_get_forced_updates_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_CLIENT_CACHE_SUBSCRIBE
+ *
+ * The request this is sent with will receive a DCGM_MSG_CLIENT_CACHE_INVALIDATE every time the
+ * hostengine's cache generations move
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header; /* Command header */
+    long long configGeneration;          /* OUT: Current config generation */
+    long long valuesGeneration;          /* OUT: Current values generation */
+} dcgm_core_msg_client_cache_subscribe_v1;
+
+#define dcgm_core_msg_client_cache_subscribe_version1 MAKE_DCGM_VERSION(dcgm_core_msg_client_cache_subscribe_v1, 1)
+#define dcgm_core_msg_client_cache_subscribe_version  dcgm_core_msg_client_cache_subscribe_version1
+
+typedef dcgm_core_msg_client_cache_subscribe_v1 dcgm_core_msg_client_cache_subscribe_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_GET_CACHE_MEMORY
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header;     /* Command header */
+    dcgmIntrospectCacheMemory_t cacheMemory; /* OUT: Cache memory usage and budget */
+} dcgm_core_msg_get_cache_memory_v1;
+
+#define dcgm_core_msg_get_cache_memory_version1 MAKE_DCGM_VERSION(dcgm_core_msg_get_cache_memory_v1, 1)
+#define dcgm_core_msg_get_cache_memory_version  dcgm_core_msg_get_cache_memory_version1
+
+typedef dcgm_core_msg_get_cache_memory_v1 dcgm_core_msg_get_cache_memory_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_SET_CACHE_MEMORY_BUDGET
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header; /* Command header */
+    long long budgetBytes;               /* IN: Cache memory budget in bytes. 0 = unlimited */
+} dcgm_core_msg_set_cache_memory_budget_v1;
+
+#define dcgm_core_msg_set_cache_memory_budget_version1 MAKE_DCGM_VERSION(dcgm_core_msg_set_cache_memory_budget_v1, 1)
+#define dcgm_core_msg_set_cache_memory_budget_version  dcgm_core_msg_set_cache_memory_budget_version1
+
+typedef dcgm_core_msg_set_cache_memory_budget_v1 dcgm_core_msg_set_cache_memory_budget_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_GET_FEDERATION_NODES
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header; /* Command header */
+    dcgmFederationNodes_t nodes;         /* OUT: State of every downstream hostengine */
+} dcgm_core_msg_get_federation_nodes_v1;
+
+#define dcgm_core_msg_get_federation_nodes_version1 MAKE_DCGM_VERSION(dcgm_core_msg_get_federation_nodes_v1, 1)
+#define dcgm_core_msg_get_federation_nodes_version  dcgm_core_msg_get_federation_nodes_version1
+
+typedef dcgm_core_msg_get_federation_nodes_v1 dcgm_core_msg_get_federation_nodes_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_GET_FEDERATION_VALUES
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header; /* Command header */
+    dcgmFederationValues_t values;       /* IN/OUT: Node and start index in. A page of values out */
+} dcgm_core_msg_get_federation_values_v1;
+
+#define dcgm_core_msg_get_federation_values_version1 MAKE_DCGM_VERSION(dcgm_core_msg_get_federation_values_v1, 1)
+#define dcgm_core_msg_get_federation_values_version  dcgm_core_msg_get_federation_values_version1
+
+typedef dcgm_core_msg_get_federation_values_v1 dcgm_core_msg_get_federation_values_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_NEGOTIATE_WIRE_ENCODING
+ *
+ * Hostengines that don't know this return DCGM_ST_FUNCTION_NOT_FOUND and only take verbatim module commands
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header; /* Command header */
+    unsigned int encodings; /* IN: DCGM_WIRE_ENCODING_MASK_? the client can use.
+                               OUT: The subset the hostengine can use as well */
+} dcgm_core_msg_negotiate_wire_encoding_v1;
+
+#define dcgm_core_msg_negotiate_wire_encoding_version1 MAKE_DCGM_VERSION(dcgm_core_msg_negotiate_wire_encoding_v1, 1)
+#define dcgm_core_msg_negotiate_wire_encoding_version  dcgm_core_msg_negotiate_wire_encoding_version1
+
+typedef dcgm_core_msg_negotiate_wire_encoding_v1 dcgm_core_msg_negotiate_wire_encoding_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_GROUP_GET_ENTITIES
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header; /* Command header */
+    unsigned int groupId;                /* IN: Group to list the entities of */
+    long long timestamp;                 /* OUT: Hostengine time when the group was read */
+    dcgmGroupEntities_t entities;        /* IN/OUT: Start index in. A page of entities out */
+} dcgm_core_msg_group_get_entities_v1;
+
+#define dcgm_core_msg_group_get_entities_version1 MAKE_DCGM_VERSION(dcgm_core_msg_group_get_entities_v1, 1)
+#define dcgm_core_msg_group_get_entities_version  dcgm_core_msg_group_get_entities_version1
+
+typedef dcgm_core_msg_group_get_entities_v1 dcgm_core_msg_group_get_entities_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_GET_ENTITY_GROUP_ENTITIES_V2
+ *
+ * Unlike DCGM_CORE_SR_GET_ENTITY_GROUP_ENTITIES, this pages through entity groups of any size
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header;                      /* Command header */
+    unsigned int entityGroup;                                 /* IN: Entity group to list the entities of */
+    unsigned int flags;                                       /* IN: DCGM_GEGE_FLAG_? */
+    unsigned int startIndex;                                  /* IN: Index of the first entity to return */
+    unsigned int numEntities;                                 /* OUT: Number of entities in entities[] */
+    unsigned int totalEntities;                               /* OUT: Number of entities in the entity group */
+    dcgm_field_eid_t entities[DCGM_GROUP_ENTITIES_PAGE_SIZE]; /* OUT: Entities from startIndex on */
+} dcgm_core_msg_get_entity_group_entities_v2;
+
+#define dcgm_core_msg_get_entity_group_entities_version2 \
+    MAKE_DCGM_VERSION(dcgm_core_msg_get_entity_group_entities_v2, 2)
+
 #ifdef INJECTION_LIBRARY_AVAILABLE
 typedef struct
 {
@@ -668,12 +849,14 @@ DCGM_CASSERT(dcgm_core_msg_group_get_info_version1 == (long)0x1000338, 1);
 DCGM_CASSERT(dcgm_core_msg_job_cmd_version1 == (long)0x1000060, 1);
 DCGM_CASSERT(dcgm_core_msg_job_get_stats_version1 == (long)0x1009908, 1);
 DCGM_CASSERT(dcgm_core_msg_entities_get_latest_values_version1 == (long)0x1004334, 1);
+DCGM_CASSERT(dcgm_core_msg_entities_get_cycle_values_version1 == (long)0x13fe338, 1);
+DCGM_CASSERT(dcgm_core_msg_get_latest_value_changes_version1 == (long)0x13fe030, 1);
 DCGM_CASSERT(dcgm_core_msg_get_multiple_values_for_field_version1 == (long)0x1004048, 1);
 DCGM_CASSERT(dcgm_core_msg_watch_field_value_version1 == (long)0x1000040, 1);
 DCGM_CASSERT(dcgm_core_msg_update_all_fields_version1 == (long)0x1000020, 1);
 DCGM_CASSERT(dcgm_core_msg_unwatch_field_value_version1 == (long)0x100002c, 1);
 DCGM_CASSERT(dcgm_core_msg_inject_field_value_version1 == (long)0x1001040, 1);
-DCGM_CASSERT(dcgm_core_msg_get_cache_manager_field_info_version2 == (long)0x2000160, 1);
+DCGM_CASSERT(dcgm_core_msg_get_cache_manager_field_info_version3 == (long)0x3000190, 1);
 DCGM_CASSERT(dcgm_core_msg_watch_fields_version1 == (long)0x1000038, 1);
 DCGM_CASSERT(dcgm_core_msg_get_topology_version1 == (long)0x10026e8, 1);
 DCGM_CASSERT(dcgm_core_msg_get_topology_affinity_version1 == (long)0x1000930, 1);
@@ -695,3 +878,12 @@ DCGM_CASSERT(dcgm_core_msg_fieldgroup_get_all_version == (long)0x1008428, 1);
 DCGM_CASSERT(dcgm_core_msg_get_gpu_instance_hierarchy_version == (long)0x1011f24, 1);
 DCGM_CASSERT(dcgm_core_msg_get_metric_groups_version1 == (long)0x1000578, 1);
 DCGM_CASSERT(dcgm_core_msg_get_metric_groups_version == (long)0x1000578, 1);
+DCGM_CASSERT(dcgm_core_msg_get_forced_updates_version1 == (long)0x1000048, 1);
+DCGM_CASSERT(dcgm_core_msg_client_cache_subscribe_version1 == (long)0x1000028, 1);
+DCGM_CASSERT(dcgm_core_msg_get_cache_memory_version1 == (long)0x1000048, 1);
+DCGM_CASSERT(dcgm_core_msg_set_cache_memory_budget_version1 == (long)0x1000020, 1);
+DCGM_CASSERT(dcgm_core_msg_get_federation_nodes_version1 == (long)0x1004e20, 1);
+DCGM_CASSERT(dcgm_core_msg_get_federation_values_version1 == (long)0x1009030, 1);
+DCGM_CASSERT(dcgm_core_msg_negotiate_wire_encoding_version1 == (long)0x100001c, 1);
+DCGM_CASSERT(dcgm_core_msg_group_get_entities_version1 == (long)0x1002038, 1);
+DCGM_CASSERT(dcgm_core_msg_get_entity_group_entities_version2 == (long)0x200102c, 1);
@@ -21,6 +21,7 @@
 #include "DcgmUtilities.h"
 #include "Defer.hpp"
 #include "NvvsJsonStrings.h"
+#include "NvvsWorkerProtocol.hpp"
 #include "dcgm_config_structs.h"
 #include "dcgm_structs.h"
 #include "serialize/DcgmJsonSerialize.hpp"
@@ -34,6 +35,7 @@
 #include <fmt/format.h>
 #include <iterator>
 #include <ranges>
+#include <poll.h>
 #include <sstream>
 #include <sys/epoll.h>
 #include <sys/stat.h>
@@ -77,6 +79,26 @@ std::string SanitizedString(std::string const &str)
     });
     return sanitized;
 }
+
+/* How long a new nvvs worker may take to load its plugins */
+int const NVVS_WORKER_START_TIMEOUT_MS = 60000;
+/* How long the nvvs worker may take to fork a run */
+int const NVVS_WORKER_LAUNCH_TIMEOUT_MS = 10000;
+
+bool WaitReadable(int fd, int timeoutMs)
+{
+    pollfd pfd { fd, POLLIN, 0 };
+    int ret;
+    while ((ret = poll(&pfd, 1, timeoutMs)) < 0 && errno == EINTR)
+    {}
+    return ret > 0;
+}
+
+bool NvvsWorkerModeRequested()
+{
+    char const *value = getenv(NVVS_WORKER_MODE);
+    return value != nullptr && value[0] != '\0' && strcmp(value, "0") != 0;
+}
 } // namespace
 
 /*****************************************************************************/
@@ -87,17 +109,29 @@ DcgmDiagManager::DcgmDiagManager(dcgmCoreCallbacks_t &dcc)
     , m_ticket(0)
     , m_coreProxy(dcc)
     , m_amShuttingDown(false)
-{}
+    , m_useNvvsWorker(NvvsWorkerModeRequested())
+    , m_workerPid(-1)
+{
+    if (m_useNvvsWorker)
+    {
+        log_info("Diagnostics will be run through a warm nvvs worker");
+    }
+}
 
 DcgmDiagManager::~DcgmDiagManager()
 {
-    DcgmLockGuard lock(&m_mutex);
-    m_amShuttingDown = true;
-    if (m_nvvsPID >= 0)
     {
-        DCGM_LOG_DEBUG << "Cleaning up leftover nvvs process with pid " << m_nvvsPID;
-        KillActiveNvvs((unsigned int)-1); // don't stop until it's dead
+        DcgmLockGuard lock(&m_mutex);
+        m_amShuttingDown = true;
+        if (m_nvvsPID >= 0)
+        {
+            DCGM_LOG_DEBUG << "Cleaning up leftover nvvs process with pid " << m_nvvsPID;
+            KillActiveNvvs((unsigned int)-1); // don't stop until it's dead
+        }
     }
+
+    std::lock_guard<std::mutex> workerLock(m_workerMutex);
+    StopNvvsWorker();
 }
 
 dcgmReturn_t DcgmDiagManager::KillActiveNvvs(unsigned int maxRetries)
@@ -553,6 +587,8 @@ dcgmReturn_t DcgmDiagManager::PerformExternalCommand(std::vector<std::string> &a
     pid_t pid = -1;
     uint64_t myTicket;
     int errno_cached; /* Cached value of errno for logging */
+    bool useWorker = false;
+    std::string workerServiceAccount;
 
     AppendDummyArgs(args);
 
@@ -636,17 +672,30 @@ dcgmReturn_t DcgmDiagManager::PerformExternalCommand(std::vector<std::string> &a
             }
         }
 
-        // Run command
-        pid = DcgmNs::Utils::ForkAndExecCommand(args,
-                                                nullptr,
-                                                &stdoutFd,
-                                                &stderrFd,
-                                                false,
-                                                serviceAccount.has_value() ? (*serviceAccount).c_str() : nullptr,
-                                                nullptr);
-        // Update the nvvs pid
-        myTicket = GetTicket();
-        UpdateChildPID(pid, myTicket);
+        if (m_useNvvsWorker && filename == m_nvvsPath)
+        {
+            workerServiceAccount = serviceAccount.value_or("");
+            useWorker            = true;
+        }
+        else
+        {
+            // Run command
+            pid = DcgmNs::Utils::ForkAndExecCommand(args,
+                                                    nullptr,
+                                                    &stdoutFd,
+                                                    &stderrFd,
+                                                    false,
+                                                    serviceAccount.has_value() ? (*serviceAccount).c_str() : nullptr,
+                                                    nullptr);
+            // Update the nvvs pid
+            myTicket = GetTicket();
+            UpdateChildPID(pid, myTicket);
+        }
+    }
+
+    if (useWorker)
+    {
+        return PerformWorkerCommand(args, *stdoutStr, *stderrStr, workerServiceAccount);
     }
 
     if (pid < 0)
@@ -711,6 +760,14 @@ dcgmReturn_t DcgmDiagManager::PerformExternalCommand(std::vector<std::string> &a
     // Reset pid so that future runs know that nvvs is no longer running
     UpdateChildPID(-1, myTicket);
 
+    return HandleExternalCommandStatus(args[0], childStatus, *stderrStr);
+}
+
+/****************************************************************************/
+dcgmReturn_t DcgmDiagManager::HandleExternalCommandStatus(std::string const &command,
+                                                          int childStatus,
+                                                          std::string &stderrStr)
+{
     // Check exit status
     if (WIFEXITED(childStatus))
     {
@@ -722,7 +779,7 @@ dcgmReturn_t DcgmDiagManager::PerformExternalCommand(std::vector<std::string> &a
              * json object and printed to stdout. The nvvs command itself was successful from our point of view. Now
              * it's up to the upper caller logic to decide if the stdout is valid */
             DCGM_LOG_DEBUG << fmt::format(
-                "The external command '{}' returned a non-zero exit code: {}", args[0], childStatus);
+                "The external command '{}' returned a non-zero exit code: {}", command, childStatus);
             return DCGM_ST_OK;
         }
     }
@@ -730,22 +787,210 @@ dcgmReturn_t DcgmDiagManager::PerformExternalCommand(std::vector<std::string> &a
     {
         // Child terminated due to signal
         childStatus = WTERMSIG(childStatus);
-        DCGM_LOG_ERROR << "The external command '" << args[0] << "' was terminated due to signal " << childStatus;
-        stderrStr->insert(0,
-                          fmt::format("The DCGM diagnostic subprocess was terminated due to signal {}"
-                                      "\n**************\n",
-                                      childStatus));
+        DCGM_LOG_ERROR << "The external command '" << command << "' was terminated due to signal " << childStatus;
+        stderrStr.insert(0,
+                         fmt::format("The DCGM diagnostic subprocess was terminated due to signal {}"
+                                     "\n**************\n",
+                                     childStatus));
         return DCGM_ST_NVVS_KILLED;
     }
     else
     {
         // We should never hit this in practice, but it is possible if the child process is being traced via ptrace
-        DCGM_LOG_DEBUG << "The external command '" << args[0] << "' is being traced";
+        DCGM_LOG_DEBUG << "The external command '" << command << "' is being traced";
         return DCGM_ST_NVVS_ERROR;
     }
 
     return DCGM_ST_OK;
 }
+
+/****************************************************************************/
+bool DcgmDiagManager::IsNvvsWorkerAlive() const
+{
+    return m_workerPid > 0 && waitpid(m_workerPid, nullptr, WNOHANG) == 0;
+}
+
+/****************************************************************************/
+void DcgmDiagManager::StopNvvsWorker() const
+{
+    if (m_workerPid > 0)
+    {
+        DCGM_LOG_DEBUG << "Stopping nvvs worker with pid " << m_workerPid;
+        /* A run in progress is killed too, by the death signal its parent set */
+        kill(m_workerPid, SIGKILL);
+        // Prevent zombie child
+        while (waitpid(m_workerPid, nullptr, 0) == -1 && errno == EINTR)
+        {}
+    }
+
+    m_workerPid = -1;
+    m_workerServiceAccount.clear();
+    m_workerRequestFd  = DcgmNs::Utils::FileHandle();
+    m_workerResponseFd = DcgmNs::Utils::FileHandle();
+}
+
+/****************************************************************************/
+dcgmReturn_t DcgmDiagManager::StartNvvsWorker(std::string const &serviceAccount) const
+{
+    using namespace DcgmNs::Nvvs::Worker;
+
+    std::vector<std::string> args { m_nvvsPath, NVVS_WORKER_ARG };
+    if (char const *pluginDir = getenv(NVVS_PLUGIN_DIR); pluginDir != nullptr)
+    {
+        args.push_back("-p");
+        args.push_back(pluginDir);
+    }
+
+    pid_t pid = DcgmNs::Utils::ForkAndExecCommand(args,
+                                                  &m_workerRequestFd,
+                                                  &m_workerResponseFd,
+                                                  nullptr,
+                                                  false,
+                                                  serviceAccount.empty() ? nullptr : serviceAccount.c_str(),
+                                                  nullptr);
+    if (pid < 0)
+    {
+        log_error("Unable to start the nvvs worker '{}'", m_nvvsPath);
+        StopNvvsWorker();
+        return DCGM_ST_DIAG_BAD_LAUNCH;
+    }
+
+    m_workerPid            = pid;
+    m_workerServiceAccount = serviceAccount;
+
+    MessageType type {};
+    std::string payload;
+    if (!WaitReadable(m_workerResponseFd.Get(), NVVS_WORKER_START_TIMEOUT_MS)
+        || !ReadMessage(m_workerResponseFd.Get(), type, payload) || type != MessageType::Ready)
+    {
+        log_error("The nvvs worker (PID: {}) did not become ready", pid);
+        StopNvvsWorker();
+        return DCGM_ST_DIAG_BAD_LAUNCH;
+    }
+
+    log_debug("Started nvvs worker with pid {}", pid);
+    return DCGM_ST_OK;
+}
+
+/****************************************************************************/
+pid_t DcgmDiagManager::LaunchOnNvvsWorker(std::vector<std::string> const &args) const
+{
+    using namespace DcgmNs::Nvvs::Worker;
+
+    MessageType type {};
+    std::string payload;
+    pid_t pid = -1;
+
+    if (!WriteMessage(m_workerRequestFd.Get(), MessageType::Run, PackArgs(args))
+        || !WaitReadable(m_workerResponseFd.Get(), NVVS_WORKER_LAUNCH_TIMEOUT_MS)
+        || !ReadMessage(m_workerResponseFd.Get(), type, payload) || type != MessageType::Started
+        || payload.size() != sizeof(pid))
+    {
+        return -1;
+    }
+
+    memcpy(&pid, payload.data(), sizeof(pid));
+    return pid;
+}
+
+/****************************************************************************/
+dcgmReturn_t DcgmDiagManager::PerformWorkerCommand(std::vector<std::string> const &args,
+                                                   std::string &stdoutStr,
+                                                   std::string &stderrStr,
+                                                   std::string const &serviceAccount) const
+{
+    using namespace DcgmNs::Nvvs::Worker;
+
+    /* Only one run at a time, as with separate nvvs processes. Don't queue behind a run in progress */
+    std::unique_lock<std::mutex> workerLock(m_workerMutex, std::try_to_lock);
+    if (!workerLock.owns_lock())
+    {
+        return DCGM_ST_DIAG_ALREADY_RUNNING;
+    }
+
+    if (!IsNvvsWorkerAlive() || m_workerServiceAccount != serviceAccount)
+    {
+        StopNvvsWorker();
+        if (auto const ret = StartNvvsWorker(serviceAccount); ret != DCGM_ST_OK)
+        {
+            return ret;
+        }
+    }
+
+    pid_t pid;
+    uint64_t myTicket;
+    {
+        DcgmLockGuard lock(&m_mutex);
+        if (auto const ret = CanRunNewNvvsInstance(); ret != DCGM_ST_OK)
+        {
+            return ret;
+        }
+
+        pid = LaunchOnNvvsWorker(args);
+        if (pid < 0)
+        {
+            log_error("The nvvs worker (PID: {}) failed to launch '{}'", m_workerPid, args[0]);
+            StopNvvsWorker();
+            return DCGM_ST_DIAG_BAD_LAUNCH;
+        }
+
+        // The run can be stopped through KillActiveNvvs() like any other nvvs process
+        myTicket = GetTicket();
+        UpdateChildPID(pid, myTicket);
+    }
+    DCGM_LOG_DEBUG << fmt::format("Launched '{}' on the nvvs worker (PID: {})", args[0], pid);
+
+    fmt::memory_buffer stdoutStream;
+    fmt::memory_buffer stderrStream;
+    MessageType type {};
+    std::string payload;
+    int childStatus = 0;
+    bool exited     = false;
+
+    while (!exited && ReadMessage(m_workerResponseFd.Get(), type, payload))
+    {
+        if (type == MessageType::Stdout)
+        {
+            stdoutStream.append(payload.data(), payload.data() + payload.size());
+        }
+        else if (type == MessageType::Stderr)
+        {
+            stderrStream.append(payload.data(), payload.data() + payload.size());
+        }
+        else if (type == MessageType::Exited && payload.size() == sizeof(childStatus))
+        {
+            memcpy(&childStatus, payload.data(), sizeof(childStatus));
+            exited = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    UpdateChildPID(-1, myTicket);
+
+    stdoutStr = fmt::to_string(stdoutStream);
+    stderrStr = fmt::to_string(stderrStream);
+    DCGM_LOG_DEBUG << "External command stdout: " << SanitizedString(stdoutStr);
+    DCGM_LOG_DEBUG << "External command stderr: " << SanitizedString(stderrStr);
+
+    if (!exited)
+    {
+        DCGM_LOG_ERROR << "Lost the nvvs worker while running '" << args[0] << "'. Recycling it.";
+        StopNvvsWorker();
+        return DCGM_ST_NVVS_ERROR;
+    }
+
+    if (!WIFEXITED(childStatus))
+    {
+        // Don't reuse a worker whose run had to be killed or crashed. The next run starts a fresh one
+        DCGM_LOG_DEBUG << "Recycling the nvvs worker after an abnormal exit of '" << args[0] << "'";
+        StopNvvsWorker();
+    }
+
+    return HandleExternalCommandStatus(args[0], childStatus, stderrStr);
+}
 void DcgmDiagManager::AppendDummyArgs(std::vector<std::string> &args)
 {
     if (args[0] == "dummy") // for unittests
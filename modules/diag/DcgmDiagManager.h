@@ -28,9 +28,13 @@
 #include <DcgmCoreProxy.h>
 #include <fmt/format.h>
 #include <json/json.h>
+#include <mutex>
+#include <optional>
 #include <unordered_set>
 
 #define NVVS_PLUGIN_DIR "NVVS_PLUGIN_DIR"
+/* Set to a non-zero value to run diagnostics through a warm nvvs worker instead of a new nvvs process per run */
+#define NVVS_WORKER_MODE "NVVS_WORKER_MODE"
 
 class DcgmDiagManager
 {
@@ -160,6 +164,15 @@ private:
     bool m_amShuttingDown; /* Is the diag manager in the process of shutting down?. This
                               is guarded by m_mutex and only set by ~DcgmDiagManager() */
 
+    /* Warm nvvs worker (see NvvsWorkerProtocol.hpp). Its state is guarded by m_workerMutex.
+       Lock order is m_workerMutex, then m_mutex */
+    bool const m_useNvvsWorker;                           // Set from NVVS_WORKER_MODE at construction
+    mutable std::mutex m_workerMutex;                     // Held for the whole of a run on the worker
+    mutable pid_t m_workerPid;                            // -1 if there is no worker
+    mutable std::string m_workerServiceAccount;           // Account the worker runs as. Empty for ours
+    mutable DcgmNs::Utils::FileHandle m_workerRequestFd;  // stdin of the worker
+    mutable DcgmNs::Utils::FileHandle m_workerResponseFd; // stdout of the worker
+
     /* methods */
 
     static unsigned int GetTestIndex(const std::string &testName);
@@ -208,4 +221,39 @@ private:
                                    fmt::memory_buffer &stderrStream,
                                    DcgmNs::Utils::FileHandle stdoutFd,
                                    DcgmNs::Utils::FileHandle stderrFd) const;
+
+    /*
+     * Translate the waitpid() status of an external command into a return code, adding an explanation
+     * to stderrStr if it was killed
+     */
+    static dcgmReturn_t HandleExternalCommandStatus(std::string const &command,
+                                                    int childStatus,
+                                                    std::string &stderrStr);
+
+    /*
+     * Run nvvs with args on the warm worker, starting the worker first if it isn't running as serviceAccount.
+     * Behaves like PerformExternalCommand(). The worker is recycled if the run didn't exit normally
+     */
+    dcgmReturn_t PerformWorkerCommand(std::vector<std::string> const &args,
+                                      std::string &stdoutStr,
+                                      std::string &stderrStr,
+                                      std::string const &serviceAccount) const;
+
+    /*
+     * Start the worker as serviceAccount (ours if empty) and wait until its plugins are loaded.
+     * Caller must hold m_workerMutex
+     */
+    dcgmReturn_t StartNvvsWorker(std::string const &serviceAccount) const;
+
+    /* Kill the worker, if any. Caller must hold m_workerMutex */
+    void StopNvvsWorker() const;
+
+    /* Returns true if the worker is running. Caller must hold m_workerMutex */
+    bool IsNvvsWorkerAlive() const;
+
+    /*
+     * Ask the worker to run args and return the pid of the process running them, or -1 if the worker failed.
+     * Caller must hold m_workerMutex and m_mutex
+     */
+    pid_t LaunchOnNvvsWorker(std::vector<std::string> const &args) const;
 };
@@ -1003,12 +1003,8 @@ dcgmReturn_t DcgmHealthWatch::MonitorPcie(dcgm_field_entity_group_t entityGroupI
                                           long long endTime,
                                           DcgmHealthResponse &response)
 {
-    dcgmReturn_t ret           = DCGM_ST_OK;
-    unsigned short fieldId     = DCGM_FI_DEV_PCIE_REPLAY_COUNTER;
-    dcgmcm_sample_t startValue = {};
-    dcgmcm_sample_t endValue   = {};
-
-    int count                    = 0;
+    dcgmReturn_t ret             = DCGM_ST_OK;
+    unsigned short fieldId       = DCGM_FI_DEV_PCIE_REPLAY_COUNTER;
     unsigned int oneMinuteInUsec = 60000000;
     timelib64_t now              = timelib_usecSince1970();
 
@@ -1019,53 +1015,44 @@ dcgmReturn_t DcgmHealthWatch::MonitorPcie(dcgm_field_entity_group_t entityGroupI
         startTime = now - oneMinuteInUsec;
     }
 
-    /* Get the value of the field at the StartTime*/
-    count = 1;
-    ret   = mpCoreProxy.GetSamples(
-        entityGroupId, entityId, fieldId, &startValue, &count, startTime, endTime, DCGM_ORDER_ASCENDING);
+    /* Get the value of the field at the startTime and at the endTime with one request to the core */
+    std::vector<dcgmCoreGetSamplesParams_t> const requests
+        = { { entityGroupId, entityId, fieldId, startTime, endTime, 1, DCGM_ORDER_ASCENDING },
+            { entityGroupId, entityId, fieldId, startTime, endTime, 1, DCGM_ORDER_DESCENDING } };
+    std::vector<DcgmCoreSamples> results;
 
-    if (DCGM_ST_NO_DATA == ret)
-    {
-        log_debug("No data for PCIe for gpuId {}", entityId);
-        return DCGM_ST_OK;
-    }
-    else if (DCGM_ST_NOT_WATCHED == ret)
-    {
-        log_warning("PCIe not watched for gpuId {}", entityId);
-        return DCGM_ST_OK;
-    }
-    else if (DCGM_ST_OK != ret)
+    ret = mpCoreProxy.GetSamplesBatch(requests, results);
+    if (DCGM_ST_OK != ret)
     {
-        log_error("mpCoreProxy.GetSamples returned {} for gpuId {}", (int)ret, entityId);
+        log_error("mpCoreProxy.GetSamplesBatch returned {} for gpuId {}", (int)ret, entityId);
         return ret;
     }
 
-    if (DCGM_INT64_IS_BLANK(startValue.val.i64))
-        return DCGM_ST_OK;
-
-    /* Get the value of the field at the endTime*/
-    count = 1;
-    ret   = mpCoreProxy.GetSamples(
-        entityGroupId, entityId, fieldId, &endValue, &count, startTime, endTime, DCGM_ORDER_DESCENDING);
-    if (DCGM_ST_NO_DATA == ret)
-    {
-        log_debug("No data for PCIe for gpuId {}", entityId);
-        return DCGM_ST_OK;
-    }
-    else if (DCGM_ST_NOT_WATCHED == ret)
+    for (auto const &result : results)
     {
-        log_warning("PCIe not watched for gpuId {}", entityId);
-        return DCGM_ST_OK;
-    }
-    else if (DCGM_ST_OK != ret)
-    {
-        log_error("mpCoreProxy.GetSamples returned {} for gpuId {}", (int)ret, entityId);
-        return ret;
+        if (DCGM_ST_NO_DATA == result.ret)
+        {
+            log_debug("No data for PCIe for gpuId {}", entityId);
+            return DCGM_ST_OK;
+        }
+        else if (DCGM_ST_NOT_WATCHED == result.ret)
+        {
+            log_warning("PCIe not watched for gpuId {}", entityId);
+            return DCGM_ST_OK;
+        }
+        else if (DCGM_ST_OK != result.ret)
+        {
+            log_error("mpCoreProxy.GetSamples returned {} for gpuId {}", (int)result.ret, entityId);
+            return result.ret;
+        }
+        else if (result.samples.empty() || DCGM_INT64_IS_BLANK(result.samples[0].val.i64))
+        {
+            return DCGM_ST_OK;
+        }
     }
 
-    if (DCGM_INT64_IS_BLANK(endValue.val.i64))
-        return DCGM_ST_OK;
-
+    dcgmcm_sample_t const &startValue = results[0].samples[0];
+    dcgmcm_sample_t const &endValue   = results[1].samples[0];
 
     // NO DATA is handled automatically so here we can assume we have the values from the last minute
     // both values have been checked for BLANK values so can be used here
@@ -1872,10 +1859,8 @@ dcgmReturn_t DcgmHealthWatch::MonitorNvSwitchErrorCounts(bool fatal,
                                                          long long endTime,
                                                          DcgmHealthResponse &response)
 {
-    std::vector<unsigned int>::iterator fieldIdIter;
     dcgmReturn_t dcgmReturn;
     std::vector<unsigned int> *fieldIds;
-    dcgmcm_sample_t sample = {};
     dcgmHealthWatchResults_t healthWatchResult;
     dcgmHealthSystems_t healthWatchSystems;
     std::string errorTypeString;
@@ -1906,28 +1891,41 @@ dcgmReturn_t DcgmHealthWatch::MonitorNvSwitchErrorCounts(bool fatal,
         errorTypeString    = "nonfatal";
     }
 
-    memset(&sample, 0, sizeof(sample));
+    /* Get the latest value of every link's counter with a single request to the core */
+    std::vector<dcgmCoreGetSamplesParams_t> requests;
+    requests.reserve(fieldIds->size());
+    for (unsigned int fieldId : *fieldIds)
+    {
+        requests.push_back(
+            { entityGroupId, entityId, (unsigned short)fieldId, startTime, endTime, 1, DCGM_ORDER_DESCENDING });
+    }
 
-    for (fieldIdIter = fieldIds->begin(); fieldIdIter != fieldIds->end(); ++fieldIdIter)
+    std::vector<DcgmCoreSamples> results;
+    dcgmReturn = mpCoreProxy.GetSamplesBatch(requests, results);
+    if (dcgmReturn != DCGM_ST_OK)
     {
-        int count  = 1;
-        dcgmReturn = mpCoreProxy.GetSamples(
-            entityGroupId, entityId, *fieldIdIter, &sample, &count, startTime, endTime, DCGM_ORDER_DESCENDING);
-        if (dcgmReturn != DCGM_ST_OK)
+        log_error("Got error {} from GetSamplesBatch eg {}, eid {}", (int)dcgmReturn, entityGroupId, entityId);
+    }
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        unsigned short const fieldId = requests[i].fieldId;
+        if (results[i].ret != DCGM_ST_OK || results[i].samples.empty())
         {
             log_debug("return {} for GetSamples eg {}, eid {}, fieldId {}, start {}, end {}",
-                      (int)dcgmReturn,
+                      (int)results[i].ret,
                       entityGroupId,
                       entityId,
-                      *fieldIdIter,
+                      fieldId,
                       startTime,
                       endTime);
             continue;
         }
 
+        dcgmcm_sample_t const &sample = results[i].samples[0];
         if (!DCGM_INT64_IS_BLANK(sample.val.i64) && sample.val.i64 > 0)
         {
-            unsigned int linkId = (*fieldIdIter) - fieldIds->at(0);
+            unsigned int linkId = fieldId - fieldIds->at(0);
             DcgmError d { entityId };
             if (fatal)
             {
@@ -148,6 +148,24 @@ std::optional<dcgmReturn_t> DcgmModuleIntrospect::ProcessMetadataHostEngineMemUs
     return GetMemUsageForHostengine(&msg->memoryInfo, msg->waitIfNoData);
 }
 
+/*****************************************************************************/
+dcgmReturn_t DcgmModuleIntrospect::ProcessHostEngineQueueWait(dcgm_introspect_msg_he_queue_wait_v1 *msg)
+{
+    dcgmReturn_t dcgmReturn = CheckVersion(&msg->header, dcgm_introspect_msg_he_queue_wait_version1);
+    if (DCGM_ST_OK != dcgmReturn)
+    {
+        return dcgmReturn; /* Logging handled by helper method */
+    }
+
+    if (msg->queueWait.version != dcgmIntrospectQueueWait_version1)
+    {
+        log_warning("Version mismatch. expected {}. Got {}", dcgmIntrospectQueueWait_version1, msg->queueWait.version);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    return m_coreProxy.GetIpcQueueWait(msg->queueWait);
+}
+
 /*****************************************************************************/
 template <std::invocable Fn>
 dcgmReturn_t DcgmModuleIntrospect::ProcessInTaskRunner(Fn action)
@@ -263,6 +281,11 @@ dcgmReturn_t DcgmModuleIntrospect::ProcessMessage(dcgm_module_command_header_t *
                 });
                 break;
 
+            /* The stats live in the core, so there's no need to go through our task runner */
+            case DCGM_INTROSPECT_SR_HOSTENGINE_QUEUE_WAIT:
+                retSt = ProcessHostEngineQueueWait((dcgm_introspect_msg_he_queue_wait_v1 *)moduleCommand);
+                break;
+
             default:
                 DCGM_LOG_DEBUG << "Unknown subcommand: " << static_cast<int>(moduleCommand->subCommand);
                 return DCGM_ST_FUNCTION_NOT_FOUND;
@@ -60,6 +60,7 @@ private:
      */
     std::optional<dcgmReturn_t> ProcessMetadataHostEngineCpuUtil(dcgm_introspect_msg_he_cpu_util_v1 *msg);
     std::optional<dcgmReturn_t> ProcessMetadataHostEngineMemUsage(dcgm_introspect_msg_he_mem_usage_v1 *msg);
+    dcgmReturn_t ProcessHostEngineQueueWait(dcgm_introspect_msg_he_queue_wait_v1 *msg);
 
     dcgmReturn_t ProcessCoreMessage(dcgm_module_command_header_t *moduleCommand);
 
@@ -24,7 +24,8 @@
 #define DCGM_INTROSPECT_SR_HOSTENGINE_MEM_USAGE 4
 #define DCGM_INTROSPECT_SR_HOSTENGINE_CPU_UTIL  5
 /* 6-7 are deprecated */
-#define DCGM_INTROSPECT_SR_COUNT 8 /* Keep as last entry and 1 greater */
+#define DCGM_INTROSPECT_SR_HOSTENGINE_QUEUE_WAIT 8
+#define DCGM_INTROSPECT_SR_COUNT                 9 /* Keep as last entry and 1 greater */
 
 /*****************************************************************************/
 /* Subrequest message definitions */
@@ -58,6 +59,18 @@ typedef struct dcgm_introspect_msg_he_cpu_util_v1
 
 #define dcgm_introspect_msg_he_cpu_util_version1 MAKE_DCGM_VERSION(dcgm_introspect_msg_he_cpu_util_v1, 1)
 
+/**
+ * Subrequest DCGM_INTROSPECT_SR_HOSTENGINE_QUEUE_WAIT
+ */
+typedef struct dcgm_introspect_msg_he_queue_wait_v1
+{
+    dcgm_module_command_header_t header; /* Command header */
+
+    dcgmIntrospectQueueWait_t queueWait; /* How long the host engine's client requests waited to be processed */
+} dcgm_introspect_msg_he_queue_wait_v1;
+
+#define dcgm_introspect_msg_he_queue_wait_version1 MAKE_DCGM_VERSION(dcgm_introspect_msg_he_queue_wait_v1, 1)
+
 /*****************************************************************************/
 
 #endif // DCGM_INTROSPECT_STRUCTS_H
@@ -34,16 +34,6 @@ namespace DcgmNs
 {
 using namespace DcgmNs::Cpu;
 
-unsigned long long SysmonUtilizationSampleCore::GetTotal() const
-{
-    return m_user + m_nice + m_system + m_idle + m_irq + m_other;
-}
-
-unsigned long long SysmonUtilizationSampleCore::GetActive() const
-{
-    return GetTotal() - m_idle;
-}
-
 DcgmModuleSysmon::DcgmModuleSysmon(dcgmCoreCallbacks_t &dcc)
     : DcgmModuleWithCoreProxy(dcc)
     , m_procStat("/proc/stat")
@@ -615,19 +605,13 @@ dcgmReturn_t DcgmModuleSysmon::ParseProcStatCpuLine(const std::string &line, Sys
         return DCGM_ST_BADPARAM;
     }
 
-    if (coreIndex >= sample.m_cores.size())
+    if (coreIndex >= sample.GetCoreCount())
     {
-        log_error("Core index {} >= sample core count {}", coreIndex, sample.m_cores.size());
+        log_error("Core index {} >= sample core count {}", coreIndex, sample.GetCoreCount());
         return DCGM_ST_BADPARAM;
     }
 
-    auto &coreObj    = sample.m_cores[coreIndex];
-    coreObj.m_user   = user;
-    coreObj.m_nice   = nice;
-    coreObj.m_idle   = idle;
-    coreObj.m_system = system;
-    coreObj.m_irq    = irq;
-    coreObj.m_other  = other;
+    sample.SetCore(coreIndex, SysmonUtilizationSampleCore { user, nice, system, idle, irq, other });
 
     return DCGM_ST_OK;
 }
@@ -636,19 +620,17 @@ dcgmReturn_t DcgmModuleSysmon::ParseProcStatCpuLine(const std::string &line, Sys
 const SysmonUtilizationSample &DcgmModuleSysmon::ReadUtilizationSample(DcgmNs::Timelib::TimePoint now)
 {
     // Check if we have already read the sample
-    auto currentSampleIt = m_utilizationSamples.find(now);
-    if (currentSampleIt != m_utilizationSamples.end())
+    SysmonUtilizationSample const *currentSample = m_utilizationSamples.Find(now);
+    if (currentSample != nullptr)
     {
-        return currentSampleIt->second;
+        return *currentSample;
     }
 
     std::string statContents = readEntireFile(m_procStat);
     std::istringstream statStream(statContents);
     std::string line;
-    SysmonUtilizationSample sample;
-    sample.m_timestamp = now;
-    // Allocate space in the sample for all the cores
-    sample.m_cores.resize(m_cpus.GetTotalCoreCount());
+    // Reuses the counter arrays of the oldest slot once the ring is big enough for the watches
+    SysmonUtilizationSample &sample = m_utilizationSamples.Push(now, m_cpus.GetTotalCoreCount());
 
     std::getline(statStream, line); // Skip first line which lists aggregate stats for the system
 
@@ -661,8 +643,58 @@ const SysmonUtilizationSample &DcgmModuleSysmon::ReadUtilizationSample(DcgmNs::T
         }
     }
 
-    m_utilizationSamples.emplace(now, sample);
-    return m_utilizationSamples[now];
+    return sample;
+}
+
+/*****************************************************************************/
+SysmonUtilizationResult const *DcgmModuleSysmon::GetUtilizationResult(DcgmNs::Timelib::TimePoint now,
+                                                                      DcgmNs::Timelib::TimePoint baselineTime)
+{
+    SysmonUtilizationSample const &currentSample = ReadUtilizationSample(now);
+
+    SysmonUtilizationSample const *baselineSample = m_utilizationSamples.FindAtOrBefore(baselineTime);
+    if (baselineSample == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (m_numUtilizationResults > 0 && m_utilizationResults[0].m_currentTimestamp != now)
+    {
+        // New tick. The results of the last one are stale
+        m_numUtilizationResults = 0;
+    }
+
+    for (size_t i = 0; i < m_numUtilizationResults; i++)
+    {
+        if (m_utilizationResults[i].m_baselineTimestamp == baselineSample->m_timestamp)
+        {
+            return &m_utilizationResults[i];
+        }
+    }
+
+    if (m_numUtilizationResults == 0)
+    {
+        // Fake CPUs can be added at any time, so refresh the core lists once per tick
+        m_cpuCores.clear();
+        for (auto const &cpu : m_cpus.GetCpus())
+        {
+            if (cpu.cpuId >= m_cpuCores.size())
+            {
+                m_cpuCores.resize(cpu.cpuId + 1);
+            }
+            m_cpuCores[cpu.cpuId] = m_cpus.GetCoreIdList(cpu.cpuId);
+        }
+    }
+
+    if (m_numUtilizationResults == m_utilizationResults.size())
+    {
+        m_utilizationResults.emplace_back();
+    }
+
+    SysmonUtilizationResult &result = m_utilizationResults[m_numUtilizationResults];
+    m_numUtilizationResults++;
+    result.Calculate(*baselineSample, currentSample, m_cpuCores);
+    return &result;
 }
 
 dcgmReturn_t DcgmModuleSysmon::UpdateField(DcgmNs::Timelib::TimePoint now, const dcgm_field_update_info_t &updateInfo)
@@ -680,22 +712,14 @@ dcgmReturn_t DcgmModuleSysmon::UpdateField(DcgmNs::Timelib::TimePoint now, const
         case DCGM_FI_DEV_CPU_UTIL_SYS:
         case DCGM_FI_DEV_CPU_UTIL_IRQ:
         {
-            const SysmonUtilizationSample &currentSample = ReadUtilizationSample(now);
-
-            // upper_bound returns the first element with a key above upper_bound
-            auto baselineSamplePlusOneIt = m_utilizationSamples.upper_bound(baselineTime);
-            if (baselineSamplePlusOneIt == m_utilizationSamples.begin())
+            SysmonUtilizationResult const *result = GetUtilizationResult(now, baselineTime);
+            if (result == nullptr)
             {
                 return DCGM_ST_NO_DATA;
             }
-            auto baselineSampleIt                         = std::prev(baselineSamplePlusOneIt);
-            const SysmonUtilizationSample &baselineSample = baselineSampleIt->second;
 
-            double value = CalculateUtilizationForEntity(updateInfo.entityGroupId,
-                                                         updateInfo.entityId,
-                                                         updateInfo.fieldMeta->fieldId,
-                                                         baselineSample,
-                                                         currentSample);
+            double value = CalculateUtilizationForEntity(
+                updateInfo.entityGroupId, updateInfo.entityId, updateInfo.fieldMeta->fieldId, *result);
 
             if (value == -1)
             {
@@ -743,11 +767,11 @@ void DcgmModuleSysmon::PruneSamples(DcgmNs::Timelib::TimePoint now, std::chrono:
     milliseconds maxAge          = GetMaxAge(maxUpdateInterval, maxAge, maxKeepSamples, slackMultiplier);
 
     TimePoint cutOffMinimumExclusive = now - maxAge;
-    auto upperBound                  = m_utilizationSamples.upper_bound(cutOffMinimumExclusive);
+    m_utilizationSamples.Prune(cutOffMinimumExclusive);
 
-    m_utilizationSamples.erase(m_utilizationSamples.begin(), upperBound);
-
-    log_debug("Pruned old samples. utilizationSamples.size = {}", m_utilizationSamples.size());
+    log_debug("Pruned old samples. utilizationSamples.size = {}, capacity = {}",
+              m_utilizationSamples.GetSize(),
+              m_utilizationSamples.GetCapacity());
 }
 
 /*****************************************************************************/
@@ -802,101 +826,26 @@ void DcgmModuleSysmon::UpdateFields(timelib64_t &nextUpdateTimeUsec)
     PruneSamples(now, FromLegacyTimestamp<milliseconds>(maxUpdateIntervalUsec));
 }
 
-/*****************************************************************************/
-double DcgmModuleSysmon::CalculateCoreUtilization(CoreId core,
-                                                  unsigned int fieldId,
-                                                  const SysmonUtilizationSample &baselineSample,
-                                                  const SysmonUtilizationSample &currentSample)
-{
-    if (currentSample.m_cores.size() <= core.id || baselineSample.m_cores.size() <= core.id)
-    {
-        log_error("Invalid core {}", core.id);
-        return -1;
-    }
-
-    double value = 0;
-
-    auto &baselineCore = baselineSample.m_cores[core.id];
-    auto &currentCore  = currentSample.m_cores[core.id];
-
-    switch (fieldId)
-    {
-        case DCGM_FI_DEV_CPU_UTIL_TOTAL:
-            value = currentCore.GetActive() - baselineCore.GetActive();
-            break;
-        case DCGM_FI_DEV_CPU_UTIL_USER:
-            value = currentCore.m_user - baselineCore.m_user;
-            break;
-        case DCGM_FI_DEV_CPU_UTIL_NICE:
-            value = currentCore.m_nice - baselineCore.m_nice;
-            break;
-        case DCGM_FI_DEV_CPU_UTIL_SYS:
-            value = currentCore.m_system - baselineCore.m_system;
-            break;
-        case DCGM_FI_DEV_CPU_UTIL_IRQ:
-            value = currentCore.m_irq - baselineCore.m_irq;
-            break;
-        default:
-            log_error("Invalid field {}", fieldId);
-            return -1;
-    }
-
-    double totalCyclesCurrent  = currentCore.GetTotal();
-    double totalCyclesBaseline = baselineCore.GetTotal();
-    double denominator         = totalCyclesCurrent - totalCyclesBaseline;
-    if (denominator == 0)
-    {
-        log_warning("Denominator == 0");
-        return -1;
-    }
-
-    value /= denominator;
-
-    return value;
-}
-
-/*****************************************************************************/
-double DcgmModuleSysmon::CalculateCpuUtilization(CpuId cpu,
-                                                 unsigned int fieldId,
-                                                 const SysmonUtilizationSample &baselineSample,
-                                                 const SysmonUtilizationSample &currentSample)
-{
-    double value                      = 0;
-    std::vector<unsigned int> coreIds = m_cpus.GetCoreIdList(cpu.id);
-    for (auto &coreId : coreIds)
-    {
-        value += CalculateCoreUtilization(CoreId { coreId }, fieldId, baselineSample, currentSample);
-    }
-    return value / coreIds.size();
-}
-
 /*****************************************************************************/
 double DcgmModuleSysmon::CalculateUtilizationForEntity(unsigned int entityGroupId,
                                                        unsigned int entityId,
                                                        unsigned int fieldId,
-                                                       const SysmonUtilizationSample &baselineSample,
-                                                       const SysmonUtilizationSample &currentSample)
+                                                       const SysmonUtilizationResult &result)
 {
-    switch (fieldId)
+    sysmonUtilizationField_t field = SysmonUtilizationFieldIndex(fieldId);
+    if (field == SYSMON_UTIL_FIELD_COUNT)
     {
-        case DCGM_FI_DEV_CPU_UTIL_TOTAL:
-        case DCGM_FI_DEV_CPU_UTIL_USER:
-        case DCGM_FI_DEV_CPU_UTIL_NICE:
-        case DCGM_FI_DEV_CPU_UTIL_SYS:
-        case DCGM_FI_DEV_CPU_UTIL_IRQ:
-            break;
-        default:
-            log_error("Invalid field {}", fieldId);
-            return -1;
+        log_error("Invalid field {}", fieldId);
+        return -1;
     }
 
     if (entityGroupId == DCGM_FE_CPU_CORE)
     {
-        return CalculateCoreUtilization(CoreId { entityId }, fieldId, baselineSample, currentSample);
+        return result.GetCore(field, entityId);
     }
     else if (entityGroupId == DCGM_FE_CPU)
     {
-        return CalculateCpuUtilization(CpuId { entityId }, fieldId, baselineSample, currentSample);
+        return result.GetCpu(field, entityId);
     }
 
     log_error("Invalid eg {}", entityGroupId);
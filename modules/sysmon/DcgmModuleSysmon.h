@@ -17,6 +17,7 @@
 
 #include "DcgmCpuManager.h"
 #include "DcgmCpuTopology.h"
+#include "DcgmSysmonUtilization.h"
 #include "DcgmSystemMonitor.h"
 #include "MessageGuard.hpp"
 #include "dcgm_sysmon_structs.h"
@@ -38,29 +39,6 @@ typedef enum
     SYSMON_MONITORING_SWITCH_COUNT,
 } sysmonMonitoringSwitch_t;
 
-class SysmonUtilizationSampleCore
-{
-public:
-    unsigned long long GetTotal() const;
-    unsigned long long GetActive() const;
-
-    unsigned long long m_user;
-    unsigned long long m_nice;
-    unsigned long long m_system;
-    unsigned long long m_idle;
-    unsigned long long m_irq;
-    unsigned long long m_other;
-};
-
-class SysmonUtilizationSample
-{
-public:
-    Timelib::TimePoint m_timestamp;
-    std::vector<SysmonUtilizationSampleCore> m_cores;
-};
-
-typedef std::map<Timelib::TimePoint, SysmonUtilizationSample> sysmonUtilSampleMap_t;
-
 class DcgmModuleSysmon
 
     : public DcgmModuleWithCoreProxy<DcgmModuleIdSysmon>
@@ -124,7 +102,10 @@ private:
     DcgmCpuManager m_cpus;
     DcgmCpuTopology m_cpuTopology;
     std::ifstream m_procStat;
-    sysmonUtilSampleMap_t m_utilizationSamples;
+    SysmonUtilizationRing m_utilizationSamples;
+    std::vector<SysmonUtilizationResult> m_utilizationResults; /*!< Results for the current tick, one per baseline */
+    size_t m_numUtilizationResults = 0;
+    std::vector<std::vector<unsigned int>> m_cpuCores; /*!< Core IDs of each CPU, indexed by CPU ID */
     DcgmWatchTable m_watchTable; /* Table of watchers */
     DcgmSystemMonitor m_sysmon;
     std::string m_coreSpeedBaseDir;
@@ -150,19 +131,17 @@ private:
     const SysmonUtilizationSample &ReadUtilizationSample(DcgmNs::Timelib::TimePoint now);
     dcgmReturn_t UpdateField(DcgmNs::Timelib::TimePoint now, const dcgm_field_update_info_t &updateInfo);
     void UpdateFields(timelib64_t &nextUpdateTimeUsec);
-    double CalculateCoreUtilization(DcgmNs::Cpu::CoreId core,
-                                    unsigned int fieldId,
-                                    const SysmonUtilizationSample &baselineSample,
-                                    const SysmonUtilizationSample &currentSample);
-    double CalculateCpuUtilization(DcgmNs::Cpu::CpuId cpu,
-                                   unsigned int fieldId,
-                                   const SysmonUtilizationSample &baselineSample,
-                                   const SysmonUtilizationSample &currentSample);
+    /*
+     * Returns the utilization between the latest sample at or before baselineTime and the sample at now.
+     * Every watcher with the same baseline shares the result for the current tick.
+     * Returns nullptr if there's no sample old enough yet.
+     */
+    SysmonUtilizationResult const *GetUtilizationResult(DcgmNs::Timelib::TimePoint now,
+                                                        DcgmNs::Timelib::TimePoint baselineTime);
     double CalculateUtilizationForEntity(unsigned int entityGroupId,
                                          unsigned int entityId,
                                          unsigned int fieldId,
-                                         const SysmonUtilizationSample &baselineSample,
-                                         const SysmonUtilizationSample &currentSample);
+                                         const SysmonUtilizationResult &result);
     unsigned int GetSocketFromThermalZoneFileContents(const std::string &path, const std::string &contents);
     unsigned int GetSocketIdFromThermalFile(const std::string &path);
     void PopulateTemperatureFileMap();
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmSysmonUtilization.h"
+
+#include <dcgm_fields.h>
+
+#include <algorithm>
+
+namespace DcgmNs
+{
+
+/*****************************************************************************/
+sysmonUtilizationField_t SysmonUtilizationFieldIndex(unsigned int fieldId)
+{
+    switch (fieldId)
+    {
+        case DCGM_FI_DEV_CPU_UTIL_TOTAL:
+            return SYSMON_UTIL_FIELD_TOTAL;
+        case DCGM_FI_DEV_CPU_UTIL_USER:
+            return SYSMON_UTIL_FIELD_USER;
+        case DCGM_FI_DEV_CPU_UTIL_NICE:
+            return SYSMON_UTIL_FIELD_NICE;
+        case DCGM_FI_DEV_CPU_UTIL_SYS:
+            return SYSMON_UTIL_FIELD_SYS;
+        case DCGM_FI_DEV_CPU_UTIL_IRQ:
+            return SYSMON_UTIL_FIELD_IRQ;
+        default:
+            return SYSMON_UTIL_FIELD_COUNT;
+    }
+}
+
+/*****************************************************************************/
+unsigned long long SysmonUtilizationSampleCore::GetTotal() const
+{
+    return m_user + m_nice + m_system + m_idle + m_irq + m_other;
+}
+
+/*****************************************************************************/
+unsigned long long SysmonUtilizationSampleCore::GetActive() const
+{
+    return GetTotal() - m_idle;
+}
+
+/*****************************************************************************/
+void SysmonUtilizationSample::Reset(size_t coreCount)
+{
+    for (auto *counter : { &m_user, &m_nice, &m_system, &m_idle, &m_irq, &m_other })
+    {
+        counter->assign(coreCount, 0);
+    }
+}
+
+/*****************************************************************************/
+size_t SysmonUtilizationSample::GetCoreCount() const
+{
+    return m_user.size();
+}
+
+/*****************************************************************************/
+SysmonUtilizationSampleCore SysmonUtilizationSample::GetCore(size_t coreIndex) const
+{
+    return SysmonUtilizationSampleCore { m_user[coreIndex],   m_nice[coreIndex], m_system[coreIndex],
+                                         m_idle[coreIndex],   m_irq[coreIndex],  m_other[coreIndex] };
+}
+
+/*****************************************************************************/
+void SysmonUtilizationSample::SetCore(size_t coreIndex, SysmonUtilizationSampleCore const &core)
+{
+    m_user[coreIndex]   = core.m_user;
+    m_nice[coreIndex]   = core.m_nice;
+    m_system[coreIndex] = core.m_system;
+    m_idle[coreIndex]   = core.m_idle;
+    m_irq[coreIndex]    = core.m_irq;
+    m_other[coreIndex]  = core.m_other;
+}
+
+/*****************************************************************************/
+SysmonUtilizationRing::SysmonUtilizationRing(size_t capacity)
+    : m_slots(std::max(capacity, (size_t)1))
+{}
+
+/*****************************************************************************/
+SysmonUtilizationSample &SysmonUtilizationRing::At(size_t index)
+{
+    return m_slots[(m_head + index) % m_slots.size()];
+}
+
+/*****************************************************************************/
+SysmonUtilizationSample const &SysmonUtilizationRing::At(size_t index) const
+{
+    return m_slots[(m_head + index) % m_slots.size()];
+}
+
+/*****************************************************************************/
+SysmonUtilizationSample const *SysmonUtilizationRing::FindAtOrBefore(Timelib::TimePoint timestamp) const
+{
+    /* Binary search for the first sample after timestamp */
+    size_t low  = 0;
+    size_t high = m_size;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (At(mid).m_timestamp <= timestamp)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low == 0 ? nullptr : &At(low - 1);
+}
+
+/*****************************************************************************/
+SysmonUtilizationSample const *SysmonUtilizationRing::Find(Timelib::TimePoint timestamp) const
+{
+    SysmonUtilizationSample const *sample = FindAtOrBefore(timestamp);
+    if (sample == nullptr || sample->m_timestamp != timestamp)
+    {
+        return nullptr;
+    }
+    return sample;
+}
+
+/*****************************************************************************/
+SysmonUtilizationSample &SysmonUtilizationRing::Push(Timelib::TimePoint timestamp, size_t coreCount)
+{
+    if (m_size > 0 && At(m_size - 1).m_timestamp >= timestamp)
+    {
+        Clear();
+    }
+
+    if (m_size == m_slots.size())
+    {
+        /* Unroll into a ring twice as big. Moving the samples keeps their counter arrays */
+        std::vector<SysmonUtilizationSample> slots(m_slots.size() * 2);
+        for (size_t i = 0; i < m_size; i++)
+        {
+            slots[i] = std::move(At(i));
+        }
+        m_slots = std::move(slots);
+        m_head  = 0;
+    }
+
+    SysmonUtilizationSample &sample = At(m_size);
+    m_size++;
+
+    sample.m_timestamp = timestamp;
+    sample.Reset(coreCount);
+    return sample;
+}
+
+/*****************************************************************************/
+void SysmonUtilizationRing::Prune(Timelib::TimePoint cutoff)
+{
+    while (m_size > 0 && At(0).m_timestamp <= cutoff)
+    {
+        m_head = (m_head + 1) % m_slots.size();
+        m_size--;
+    }
+}
+
+/*****************************************************************************/
+void SysmonUtilizationRing::Clear()
+{
+    m_head = 0;
+    m_size = 0;
+}
+
+/*****************************************************************************/
+size_t SysmonUtilizationRing::GetSize() const
+{
+    return m_size;
+}
+
+/*****************************************************************************/
+size_t SysmonUtilizationRing::GetCapacity() const
+{
+    return m_slots.size();
+}
+
+/*****************************************************************************/
+void SysmonUtilizationResult::Calculate(SysmonUtilizationSample const &baseline,
+                                        SysmonUtilizationSample const &current,
+                                        std::vector<std::vector<unsigned int>> const &cpuCores)
+{
+    size_t const coreCount = std::min(baseline.GetCoreCount(), current.GetCoreCount());
+
+    m_baselineTimestamp = baseline.m_timestamp;
+    m_currentTimestamp  = current.m_timestamp;
+
+    for (auto &values : m_coreValues)
+    {
+        values.resize(coreCount);
+    }
+    m_denominators.resize(coreCount);
+
+    /* Each pass reads and writes contiguous arrays with no branches, so the compiler can vectorize it */
+    double *denominators = m_denominators.data();
+    for (size_t i = 0; i < coreCount; i++)
+    {
+        unsigned long long const idle = current.m_idle[i] - baseline.m_idle[i];
+        unsigned long long const active
+            = (current.m_user[i] - baseline.m_user[i]) + (current.m_nice[i] - baseline.m_nice[i])
+              + (current.m_system[i] - baseline.m_system[i]) + (current.m_irq[i] - baseline.m_irq[i])
+              + (current.m_other[i] - baseline.m_other[i]);
+
+        m_coreValues[SYSMON_UTIL_FIELD_TOTAL][i] = (double)active;
+        denominators[i]                          = (double)(active + idle);
+    }
+
+    auto reduce = [&](sysmonUtilizationField_t field, std::vector<unsigned long long> const *base,
+                      std::vector<unsigned long long> const *cur) {
+        double *values = m_coreValues[field].data();
+        if (base != nullptr)
+        {
+            unsigned long long const *baseValues = base->data();
+            unsigned long long const *curValues  = cur->data();
+            for (size_t i = 0; i < coreCount; i++)
+            {
+                values[i] = (double)(curValues[i] - baseValues[i]);
+            }
+        }
+        for (size_t i = 0; i < coreCount; i++)
+        {
+            values[i] = denominators[i] == 0 ? -1 : values[i] / denominators[i];
+        }
+    };
+
+    reduce(SYSMON_UTIL_FIELD_TOTAL, nullptr, nullptr);
+    reduce(SYSMON_UTIL_FIELD_USER, &baseline.m_user, &current.m_user);
+    reduce(SYSMON_UTIL_FIELD_NICE, &baseline.m_nice, &current.m_nice);
+    reduce(SYSMON_UTIL_FIELD_SYS, &baseline.m_system, &current.m_system);
+    reduce(SYSMON_UTIL_FIELD_IRQ, &baseline.m_irq, &current.m_irq);
+
+    /* Each CPU is the mean of its cores. A core that couldn't be calculated makes its CPU invalid too */
+    for (unsigned int field = 0; field < SYSMON_UTIL_FIELD_COUNT; field++)
+    {
+        std::vector<double> const &coreValues = m_coreValues[field];
+        std::vector<double> &cpuValues        = m_cpuValues[field];
+        cpuValues.assign(cpuCores.size(), -1);
+
+        for (size_t cpuId = 0; cpuId < cpuCores.size(); cpuId++)
+        {
+            std::vector<unsigned int> const &cores = cpuCores[cpuId];
+            double sum                             = 0;
+            bool valid                             = !cores.empty();
+
+            for (unsigned int coreId : cores)
+            {
+                if (coreId >= coreCount || coreValues[coreId] < 0)
+                {
+                    valid = false;
+                    break;
+                }
+                sum += coreValues[coreId];
+            }
+
+            if (valid)
+            {
+                cpuValues[cpuId] = sum / cores.size();
+            }
+        }
+    }
+}
+
+/*****************************************************************************/
+double SysmonUtilizationResult::GetCore(sysmonUtilizationField_t field, unsigned int coreId) const
+{
+    if (field >= SYSMON_UTIL_FIELD_COUNT || coreId >= m_coreValues[field].size())
+    {
+        return -1;
+    }
+    return m_coreValues[field][coreId];
+}
+
+/*****************************************************************************/
+double SysmonUtilizationResult::GetCpu(sysmonUtilizationField_t field, unsigned int cpuId) const
+{
+    if (field >= SYSMON_UTIL_FIELD_COUNT || cpuId >= m_cpuValues[field].size())
+    {
+        return -1;
+    }
+    return m_cpuValues[field][cpuId];
+}
+
+} // namespace DcgmNs
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <TimeLib.hpp>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace DcgmNs
+{
+
+/* Index of each utilization field in SysmonUtilizationResult */
+typedef enum
+{
+    SYSMON_UTIL_FIELD_TOTAL = 0,
+    SYSMON_UTIL_FIELD_USER,
+    SYSMON_UTIL_FIELD_NICE,
+    SYSMON_UTIL_FIELD_SYS,
+    SYSMON_UTIL_FIELD_IRQ,
+    SYSMON_UTIL_FIELD_COUNT,
+} sysmonUtilizationField_t;
+
+/*
+ * Returns the sysmonUtilizationField_t for a DCGM_FI_DEV_CPU_UTIL_* field ID, or SYSMON_UTIL_FIELD_COUNT if
+ * fieldId isn't a utilization field
+ */
+sysmonUtilizationField_t SysmonUtilizationFieldIndex(unsigned int fieldId);
+
+/* The /proc/stat counters of one core */
+class SysmonUtilizationSampleCore
+{
+public:
+    unsigned long long GetTotal() const;
+    unsigned long long GetActive() const;
+
+    unsigned long long m_user;
+    unsigned long long m_nice;
+    unsigned long long m_system;
+    unsigned long long m_idle;
+    unsigned long long m_irq;
+    unsigned long long m_other;
+};
+
+/*
+ * The /proc/stat counters of every core at one point in time.
+ *
+ * Counters are stored as one array per counter rather than one struct per core, so the per-tick reductions
+ * in SysmonUtilizationResult run over contiguous arrays.
+ */
+class SysmonUtilizationSample
+{
+public:
+    /*
+     * Sets the number of cores and zeroes every counter. Doesn't allocate when the core count is unchanged
+     */
+    void Reset(size_t coreCount);
+
+    size_t GetCoreCount() const;
+    SysmonUtilizationSampleCore GetCore(size_t coreIndex) const;
+    void SetCore(size_t coreIndex, SysmonUtilizationSampleCore const &core);
+
+    Timelib::TimePoint m_timestamp;
+    std::vector<unsigned long long> m_user;
+    std::vector<unsigned long long> m_nice;
+    std::vector<unsigned long long> m_system;
+    std::vector<unsigned long long> m_idle;
+    std::vector<unsigned long long> m_irq;
+    std::vector<unsigned long long> m_other;
+};
+
+/*
+ * Ring of utilization samples ordered by timestamp.
+ *
+ * Slots are reused as samples are pruned, so once the ring has reached the size needed by the longest watch
+ * interval, reading a sample doesn't allocate. The ring only grows when it's full and none of its samples can
+ * be pruned yet.
+ */
+class SysmonUtilizationRing
+{
+public:
+    explicit SysmonUtilizationRing(size_t capacity = 64);
+
+    /*
+     * Returns the sample taken at timestamp, or nullptr if there isn't one
+     */
+    SysmonUtilizationSample const *Find(Timelib::TimePoint timestamp) const;
+
+    /*
+     * Returns the latest sample taken at or before timestamp, or nullptr if there isn't one
+     */
+    SysmonUtilizationSample const *FindAtOrBefore(Timelib::TimePoint timestamp) const;
+
+    /*
+     * Adds a zeroed sample for coreCount cores after the newest one and returns it.
+     *
+     * Timestamps must increase. If timestamp isn't after the newest sample, the clock went backwards and the
+     * ring is cleared first. Samples returned before this call may have moved.
+     */
+    SysmonUtilizationSample &Push(Timelib::TimePoint timestamp, size_t coreCount);
+
+    /*
+     * Drops every sample taken at or before cutoff
+     */
+    void Prune(Timelib::TimePoint cutoff);
+
+    void Clear();
+    size_t GetSize() const;
+    size_t GetCapacity() const;
+
+private:
+    SysmonUtilizationSample &At(size_t index);
+    SysmonUtilizationSample const &At(size_t index) const;
+
+    std::vector<SysmonUtilizationSample> m_slots;
+    size_t m_head = 0; /*!< Slot of the oldest sample */
+    size_t m_size = 0;
+};
+
+/*
+ * Utilization of every core and CPU between two samples.
+ *
+ * Computed once per (baseline, current) pair and then read by every watcher of a utilization field with that
+ * update interval, instead of redoing the core reductions for each entity and field.
+ */
+class SysmonUtilizationResult
+{
+public:
+    /*
+     * Computes the utilization of every core between baseline and current, then averages it over the cores
+     * of each CPU.
+     *
+     * cpuCores - Core IDs owned by each CPU, indexed by CPU ID
+     */
+    void Calculate(SysmonUtilizationSample const &baseline,
+                   SysmonUtilizationSample const &current,
+                   std::vector<std::vector<unsigned int>> const &cpuCores);
+
+    /*
+     * Returns the utilization of a core or CPU as a fraction, or -1 if it couldn't be calculated
+     */
+    double GetCore(sysmonUtilizationField_t field, unsigned int coreId) const;
+    double GetCpu(sysmonUtilizationField_t field, unsigned int cpuId) const;
+
+    Timelib::TimePoint m_baselineTimestamp;
+    Timelib::TimePoint m_currentTimestamp;
+
+private:
+    std::array<std::vector<double>, SYSMON_UTIL_FIELD_COUNT> m_coreValues;
+    std::array<std::vector<double>, SYSMON_UTIL_FIELD_COUNT> m_cpuValues;
+    std::vector<double> m_denominators;
+};
+
+} // namespace DcgmNs
@@ -21,6 +21,8 @@
 #include <DcgmModuleSysmon.h>
 
 #include <DcgmCoreCommunication.h>
+#include <Defer.hpp>
+#include <TimeLib.hpp>
 
 #include <tests/DcgmSysmonTestUtils.h>
 
@@ -45,6 +47,50 @@ TEST_CASE("Sysmon: initialize module")
     DcgmModuleSysmon sysmon(g_coreCallbacks);
 }
 
+namespace
+{
+timelib64_t g_hostEngineUsec = 0;
+
+timelib64_t HostEngineClock()
+{
+    return g_hostEngineUsec;
+}
+} // namespace
+
+TEST_CASE("Sysmon: module reads the hostengine's clock")
+{
+    using DcgmNs::Timelib::Now;
+    using DcgmNs::Timelib::ToLegacyTimestamp;
+
+    DcgmNs::Defer defer([] { timelib_setClockOverride(nullptr); });
+
+    SECTION("Injected clock")
+    {
+        g_hostEngineUsec = ToLegacyTimestamp(std::chrono::hours(24 * 365 * 10));
+
+        dcgmCoreCallbacks_t coreCallbacks = g_coreCallbacks;
+        coreCallbacks.clockfunc           = HostEngineClock;
+        DcgmModuleSysmon sysmon(coreCallbacks);
+
+        CHECK(timelib_usecSince1970() == g_hostEngineUsec);
+        CHECK(ToLegacyTimestamp(Now().time_since_epoch()) == g_hostEngineUsec);
+
+        g_hostEngineUsec += ToLegacyTimestamp(std::chrono::hours(1));
+        CHECK(timelib_usecSince1970() == g_hostEngineUsec);
+        CHECK(ToLegacyTimestamp(Now().time_since_epoch()) == g_hostEngineUsec);
+    }
+
+    SECTION("Same timelib as the hostengine")
+    {
+        dcgmCoreCallbacks_t coreCallbacks = g_coreCallbacks;
+        coreCallbacks.clockfunc           = timelib_usecSince1970;
+        DcgmModuleSysmon sysmon(coreCallbacks);
+
+        CHECK(timelib_getClockOverride() == nullptr);
+        CHECK(timelib_usecSince1970() > 0);
+    }
+}
+
 TEST_CASE("DcgmModuleSysmon::PopulateOwnedCoresBitmaskFromRangeString")
 {
     dcgm_sysmon_cpu_t cpu0;
@@ -105,18 +151,18 @@ TEST_CASE("DcgmModuleSysmon::ParseProcStatCpuLine")
     // Not enough room
     CHECK(sysmon.ParseProcStatCpuLine("cpu0 75 5 6 25", sample) == DCGM_ST_BADPARAM);
 
-    sample.m_cores.resize(12);
+    sample.Reset(12);
 
     CHECK(sysmon.ParseProcStatCpuLine("cpu0 bad line", sample) == DCGM_ST_BADPARAM);
     CHECK(sysmon.ParseProcStatCpuLine("cpu0 bad line with enough tokens for checking", sample) == DCGM_ST_BADPARAM);
     CHECK(sysmon.ParseProcStatCpuLine("cpu0 75 5 6 bad", sample) == DCGM_ST_BADPARAM);
     CHECK(sysmon.ParseProcStatCpuLine("cpu0 badusertime 5 6 76", sample) == DCGM_ST_BADPARAM);
     CHECK(sysmon.ParseProcStatCpuLine("cpu0 75 5 6 25 0 8", sample) == DCGM_ST_OK);
-    CHECK(sample.m_cores[0].m_user == 75);
-    CHECK(sample.m_cores[0].m_nice == 5);
-    CHECK(sample.m_cores[0].m_system == 6);
-    CHECK(sample.m_cores[0].m_idle == 25);
-    CHECK(sample.m_cores[0].m_irq == 8);
+    CHECK(sample.m_user[0] == 75);
+    CHECK(sample.m_nice[0] == 5);
+    CHECK(sample.m_system[0] == 6);
+    CHECK(sample.m_idle[0] == 25);
+    CHECK(sample.m_irq[0] == 8);
 
     // Some lines from my system should pass
     CHECK(sysmon.ParseProcStatCpuLine("cpu0 9733046 9991 2371910 659811695 177306 0 8925 0 0 0", sample) == DCGM_ST_OK);
@@ -192,51 +238,64 @@ TEST_CASE("DcgmModuleSysmon Watches")
     CHECK(!isSubscribed);
 }
 
-TEST_CASE("DcgmModuleSysmon::CalculateCoreUtilization")
+TEST_CASE("DcgmModuleSysmon::CalculateUtilizationForEntity")
 {
     DcgmModuleSysmon sysmon(g_coreCallbacks);
 
     unsigned int numCores = 2;
-    CoreId core           = CoreId { 0 };
 
     double user = 1, nice = 2, system = 3, idle = 4, irq = 5, other = 6;
 
+    SysmonUtilizationSampleCore baselineCore { 1, 2, 3, 4, 5, 6 };
+    SysmonUtilizationSampleCore currentCore { baselineCore.m_user + 1,   baselineCore.m_nice + 2,
+                                              baselineCore.m_system + 3, baselineCore.m_idle + 4,
+                                              baselineCore.m_irq + 5,    baselineCore.m_other + 6 };
+
     SysmonUtilizationSample baselineSample;
-    baselineSample.m_cores.resize(numCores);
-    baselineSample.m_cores[0].m_user   = user;
-    baselineSample.m_cores[0].m_nice   = nice;
-    baselineSample.m_cores[0].m_system = system;
-    baselineSample.m_cores[0].m_idle   = idle;
-    baselineSample.m_cores[0].m_irq    = irq;
-    baselineSample.m_cores[0].m_other  = other;
+    baselineSample.Reset(numCores);
+    baselineSample.SetCore(0, baselineCore);
+    baselineSample.SetCore(1, baselineCore);
 
     SysmonUtilizationSample currentSample;
-    currentSample.m_cores.resize(numCores);
-    currentSample.m_cores[0].m_user   = baselineSample.m_cores[0].m_user + user;
-    currentSample.m_cores[0].m_nice   = baselineSample.m_cores[0].m_nice + nice;
-    currentSample.m_cores[0].m_system = baselineSample.m_cores[0].m_system + system;
-    currentSample.m_cores[0].m_idle   = baselineSample.m_cores[0].m_idle + idle;
-    currentSample.m_cores[0].m_irq    = baselineSample.m_cores[0].m_irq + irq;
-    currentSample.m_cores[0].m_other  = baselineSample.m_cores[0].m_other + other;
+    currentSample.Reset(numCores);
+    currentSample.SetCore(0, currentCore);
+    currentSample.SetCore(1, currentCore);
 
     double activeCycles = user + nice + system + irq + other;
     double totalCycles  = activeCycles + idle;
-    CHECK(totalCycles == baselineSample.m_cores[0].GetTotal());
-    CHECK(activeCycles == baselineSample.m_cores[0].GetActive());
+    CHECK(totalCycles == baselineCore.GetTotal());
+    CHECK(activeCycles == baselineCore.GetActive());
+
+    // Both cores belong to CPU 0
+    std::vector<std::vector<unsigned int>> cpuCores = { { 0, 1 } };
+
+    SysmonUtilizationResult result;
 
     // No change in denominator -> error
-    CHECK(-1 == sysmon.CalculateCoreUtilization(core, DCGM_FI_DEV_CPU_UTIL_USER, baselineSample, baselineSample));
-
-    CHECK(activeCycles / totalCycles
-          == sysmon.CalculateCoreUtilization(core, DCGM_FI_DEV_CPU_UTIL_TOTAL, baselineSample, currentSample));
-    CHECK(user / totalCycles
-          == sysmon.CalculateCoreUtilization(core, DCGM_FI_DEV_CPU_UTIL_USER, baselineSample, currentSample));
-    CHECK(nice / totalCycles
-          == sysmon.CalculateCoreUtilization(core, DCGM_FI_DEV_CPU_UTIL_NICE, baselineSample, currentSample));
-    CHECK(system / totalCycles
-          == sysmon.CalculateCoreUtilization(core, DCGM_FI_DEV_CPU_UTIL_SYS, baselineSample, currentSample));
-    CHECK(irq / totalCycles
-          == sysmon.CalculateCoreUtilization(core, DCGM_FI_DEV_CPU_UTIL_IRQ, baselineSample, currentSample));
+    result.Calculate(baselineSample, baselineSample, cpuCores);
+    CHECK(-1 == sysmon.CalculateUtilizationForEntity(DCGM_FE_CPU_CORE, 0, DCGM_FI_DEV_CPU_UTIL_USER, result));
+    CHECK(-1 == sysmon.CalculateUtilizationForEntity(DCGM_FE_CPU, 0, DCGM_FI_DEV_CPU_UTIL_USER, result));
+
+    result.Calculate(baselineSample, currentSample, cpuCores);
+    for (auto entityGroupId : { DCGM_FE_CPU_CORE, DCGM_FE_CPU })
+    {
+        CHECK(activeCycles / totalCycles
+              == sysmon.CalculateUtilizationForEntity(entityGroupId, 0, DCGM_FI_DEV_CPU_UTIL_TOTAL, result));
+        CHECK(user / totalCycles
+              == sysmon.CalculateUtilizationForEntity(entityGroupId, 0, DCGM_FI_DEV_CPU_UTIL_USER, result));
+        CHECK(nice / totalCycles
+              == sysmon.CalculateUtilizationForEntity(entityGroupId, 0, DCGM_FI_DEV_CPU_UTIL_NICE, result));
+        CHECK(system / totalCycles
+              == sysmon.CalculateUtilizationForEntity(entityGroupId, 0, DCGM_FI_DEV_CPU_UTIL_SYS, result));
+        CHECK(irq / totalCycles
+              == sysmon.CalculateUtilizationForEntity(entityGroupId, 0, DCGM_FI_DEV_CPU_UTIL_IRQ, result));
+    }
+
+    // Unknown entities and fields
+    CHECK(-1 == sysmon.CalculateUtilizationForEntity(DCGM_FE_CPU_CORE, numCores, DCGM_FI_DEV_CPU_UTIL_USER, result));
+    CHECK(-1 == sysmon.CalculateUtilizationForEntity(DCGM_FE_CPU, 1, DCGM_FI_DEV_CPU_UTIL_USER, result));
+    CHECK(-1 == sysmon.CalculateUtilizationForEntity(DCGM_FE_CPU, 0, DCGM_FI_DEV_CPU_TEMP_CURRENT, result));
+    CHECK(-1 == sysmon.CalculateUtilizationForEntity(DCGM_FE_GPU, 0, DCGM_FI_DEV_CPU_UTIL_USER, result));
 }
 
 static int makeCpuFreqEntry(const std::string &baseDir, const int cpuIndex, const int value)
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch.hpp>
+
+#include <DcgmSysmonUtilization.h>
+#include <dcgm_fields.h>
+
+using namespace DcgmNs;
+using DcgmNs::Timelib::TimePoint;
+
+namespace
+{
+TimePoint At(int seconds)
+{
+    return TimePoint {} + std::chrono::seconds(seconds);
+}
+} // namespace
+
+TEST_CASE("SysmonUtilizationRing: lookups and pruning")
+{
+    SysmonUtilizationRing ring(2);
+
+    CHECK(ring.FindAtOrBefore(At(10)) == nullptr);
+
+    for (int i = 1; i <= 5; i++)
+    {
+        SysmonUtilizationSample &sample = ring.Push(At(i * 10), 4);
+        CHECK(sample.GetCoreCount() == 4);
+        sample.m_user[0] = i;
+    }
+
+    // Grew to fit every sample
+    CHECK(ring.GetSize() == 5);
+    CHECK(ring.GetCapacity() >= 5);
+
+    CHECK(ring.Find(At(30))->m_user[0] == 3);
+    CHECK(ring.Find(At(31)) == nullptr);
+    CHECK(ring.FindAtOrBefore(At(9)) == nullptr);
+    CHECK(ring.FindAtOrBefore(At(10))->m_user[0] == 1);
+    CHECK(ring.FindAtOrBefore(At(39))->m_user[0] == 3);
+    CHECK(ring.FindAtOrBefore(At(100))->m_user[0] == 5);
+
+    ring.Prune(At(20));
+    CHECK(ring.GetSize() == 3);
+    CHECK(ring.FindAtOrBefore(At(25)) == nullptr);
+
+    // Pruned slots are reused. Their counters are zeroed
+    size_t const capacity = ring.GetCapacity();
+    SysmonUtilizationSample &sample = ring.Push(At(60), 4);
+    CHECK(ring.GetCapacity() == capacity);
+    CHECK(sample.m_user[0] == 0);
+    CHECK(ring.FindAtOrBefore(At(65))->m_timestamp == At(60));
+    CHECK(ring.FindAtOrBefore(At(35))->m_user[0] == 3);
+
+    // The clock went backwards. Older samples can't be used anymore
+    ring.Push(At(5), 4);
+    CHECK(ring.GetSize() == 1);
+    CHECK(ring.FindAtOrBefore(At(100))->m_timestamp == At(5));
+}
+
+TEST_CASE("SysmonUtilizationResult: per-core and per-CPU utilization")
+{
+    unsigned int const numCores = 8;
+
+    SysmonUtilizationSample baseline;
+    baseline.Reset(numCores);
+    baseline.m_timestamp = At(0);
+
+    SysmonUtilizationSample current;
+    current.Reset(numCores);
+    current.m_timestamp = At(1);
+
+    // Core i spends i of every 10 cycles in user and the rest idle. Core 7 didn't move
+    for (unsigned int i = 0; i < numCores - 1; i++)
+    {
+        current.SetCore(i, SysmonUtilizationSampleCore { i, 0, 0, 10 - i, 0, 0 });
+    }
+
+    // Two sockets and one with a core that couldn't be calculated
+    std::vector<std::vector<unsigned int>> cpuCores = { { 0, 1, 2, 3 }, { 4, 5, 6 }, { 6, 7 }, {} };
+
+    SysmonUtilizationResult result;
+    result.Calculate(baseline, current, cpuCores);
+
+    CHECK(result.m_baselineTimestamp == At(0));
+    CHECK(result.m_currentTimestamp == At(1));
+
+    for (unsigned int i = 0; i < numCores - 1; i++)
+    {
+        CHECK(result.GetCore(SYSMON_UTIL_FIELD_USER, i) == Approx(i / 10.0));
+        CHECK(result.GetCore(SYSMON_UTIL_FIELD_TOTAL, i) == Approx(i / 10.0));
+        CHECK(result.GetCore(SYSMON_UTIL_FIELD_NICE, i) == 0);
+    }
+    CHECK(result.GetCore(SYSMON_UTIL_FIELD_USER, numCores - 1) == -1);
+    CHECK(result.GetCore(SYSMON_UTIL_FIELD_USER, numCores) == -1);
+
+    CHECK(result.GetCpu(SYSMON_UTIL_FIELD_USER, 0) == Approx(0.15));
+    CHECK(result.GetCpu(SYSMON_UTIL_FIELD_TOTAL, 1) == Approx(0.5));
+    CHECK(result.GetCpu(SYSMON_UTIL_FIELD_USER, 2) == -1);
+    CHECK(result.GetCpu(SYSMON_UTIL_FIELD_USER, 3) == -1);
+    CHECK(result.GetCpu(SYSMON_UTIL_FIELD_USER, 4) == -1);
+}
+
+TEST_CASE("SysmonUtilizationFieldIndex")
+{
+    CHECK(SysmonUtilizationFieldIndex(DCGM_FI_DEV_CPU_UTIL_TOTAL) == SYSMON_UTIL_FIELD_TOTAL);
+    CHECK(SysmonUtilizationFieldIndex(DCGM_FI_DEV_CPU_UTIL_USER) == SYSMON_UTIL_FIELD_USER);
+    CHECK(SysmonUtilizationFieldIndex(DCGM_FI_DEV_CPU_UTIL_NICE) == SYSMON_UTIL_FIELD_NICE);
+    CHECK(SysmonUtilizationFieldIndex(DCGM_FI_DEV_CPU_UTIL_SYS) == SYSMON_UTIL_FIELD_SYS);
+    CHECK(SysmonUtilizationFieldIndex(DCGM_FI_DEV_CPU_UTIL_IRQ) == SYSMON_UTIL_FIELD_IRQ);
+    CHECK(SysmonUtilizationFieldIndex(DCGM_FI_DEV_CPU_TEMP_CURRENT) == SYSMON_UTIL_FIELD_COUNT);
+}
@@ -0,0 +1,263 @@
+# Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+'''
+Compiles diag-skus.yaml into the C++ tables declared in nvvs/include/CompiledDiagSkus.h.
+
+usage: compile_diag_skus.py <diag-skus.yaml> <output.cpp>
+
+Only the block-style subset of YAML that diag-skus.yaml uses is understood (nested mappings,
+a sequence of mappings, plain or quoted scalars and comments), so this doesn't need any
+packages beyond the standard library. Anything else fails the build rather than being
+silently misread.
+'''
+import sys
+
+NO_STRING = 0xFFFFFFFF
+
+class ParseError(Exception):
+    pass
+
+def _strip_comment(text):
+    '''Remove a trailing comment that isn't inside of quotes'''
+    quote = None
+    for i, c in enumerate(text):
+        if quote:
+            if c == quote:
+                quote = None
+        elif c in '"\'':
+            quote = c
+        elif c == '#' and (i == 0 or text[i - 1] in ' \t'):
+            return text[:i].rstrip()
+    return text.rstrip()
+
+def _parse_scalar(text, lineNum):
+    if not text:
+        return ''
+    if text[0] in '"\'':
+        if len(text) < 2 or text[-1] != text[0]:
+            raise ParseError('line %d: unterminated quoted scalar' % lineNum)
+        return text[1:-1]
+    if text[0] in '[{&*|>!%@`':
+        raise ParseError('line %d: unsupported YAML syntax "%s"' % (lineNum, text))
+    return text
+
+def _split_key_value(text, lineNum):
+    '''Split "key: value" or "key:" into (key, value or None)'''
+    if text.endswith(':'):
+        return _parse_scalar(text[:-1], lineNum), None
+    sep = text.find(': ')
+    if sep < 0:
+        raise ParseError('line %d: expected "key: value", got "%s"' % (lineNum, text))
+    return _parse_scalar(text[:sep], lineNum), _parse_scalar(text[sep + 2:].strip(), lineNum)
+
+def _tokenize(lines):
+    '''Yield (lineNum, indent, isSequenceItem, text) for each line with content'''
+    for lineNum, line in enumerate(lines, 1):
+        if '\t' in line[:len(line) - len(line.lstrip())]:
+            raise ParseError('line %d: tabs can not be used for indentation' % lineNum)
+        text = _strip_comment(line.strip())
+        if not text:
+            continue
+        indent = len(line) - len(line.lstrip(' '))
+        isSequenceItem = False
+        if text == '-' or text.startswith('- '):
+            isSequenceItem = True
+            text = text[1:].lstrip()
+            indent += 2
+        yield lineNum, indent, isSequenceItem, text
+
+def _parse_block(tokens, pos, indent):
+    '''Parse the mapping or sequence that starts at tokens[pos]. Returns (value, next pos)'''
+    lineNum, _, isSequenceItem, _ = tokens[pos]
+    if isSequenceItem:
+        result = []
+        while pos < len(tokens) and tokens[pos][1] == indent and tokens[pos][2]:
+            item, pos = _parse_mapping(tokens, pos, indent, True)
+            result.append(item)
+        return result, pos
+    return _parse_mapping(tokens, pos, indent, False)
+
+def _parse_mapping(tokens, pos, indent, isSequenceItem):
+    result = {}
+    first = True
+    while pos < len(tokens):
+        lineNum, lineIndent, lineIsSequenceItem, text = tokens[pos]
+        if lineIndent < indent or (lineIndent == indent and lineIsSequenceItem and not first):
+            break
+        if lineIndent > indent:
+            raise ParseError('line %d: unexpected indentation' % lineNum)
+        if lineIsSequenceItem and not (first and isSequenceItem):
+            raise ParseError('line %d: unexpected sequence item' % lineNum)
+        first = False
+        key, value = _split_key_value(text, lineNum)
+        pos += 1
+        if value is None:
+            if pos < len(tokens) and tokens[pos][1] > indent:
+                value, pos = _parse_block(tokens, pos, tokens[pos][1])
+            else:
+                value = ''
+        if key in result:
+            raise ParseError('line %d: duplicate key "%s"' % (lineNum, key))
+        result[key] = value
+    return result, pos
+
+def parse_yaml(lines):
+    tokens = list(_tokenize(lines))
+    if not tokens:
+        return {}
+    value, pos = _parse_block(tokens, 0, tokens[0][1])
+    if pos != len(tokens):
+        raise ParseError('line %d: unexpected content' % tokens[pos][0])
+    return value
+
+def collect_skus(config):
+    '''
+    Returns (version, spec, skus) where skus maps ID -> [name, {(plugin, subtest, param): value}].
+    SKUs that appear more than once are merged, matching ConfigFileParser_v2::ParseYaml()
+    '''
+    for key in ('version', 'spec', 'skus'):
+        if key not in config:
+            raise ParseError('"%s" is missing' % key)
+    if not isinstance(config['skus'], list):
+        raise ParseError('skus must be a sequence')
+
+    skus = {}
+    for sku in config['skus']:
+        if not isinstance(sku, dict) or not isinstance(sku.get('id'), str):
+            raise ParseError('every SKU must be a map with a scalar id')
+        entry = skus.setdefault(sku['id'], ['', {}])
+        if 'name' in sku:
+            entry[0] = sku['name']
+        params = entry[1]
+        for plugin, tests in sku.items():
+            if plugin in ('name', 'id'):
+                if not isinstance(tests, str):
+                    raise ParseError('%s of SKU %s must be a scalar' % (plugin, sku['id']))
+                continue
+            if not isinstance(tests, dict):
+                raise ParseError('%s of SKU %s must be a map' % (plugin, sku['id']))
+            for param, value in tests.items():
+                if isinstance(value, dict):
+                    for subtestParam, subtestValue in value.items():
+                        if not isinstance(subtestValue, str):
+                            raise ParseError('%s.%s.%s of SKU %s must be a scalar'
+                                             % (plugin, param, subtestParam, sku['id']))
+                        params[(plugin, param, subtestParam)] = subtestValue
+                elif isinstance(value, str):
+                    params[(plugin, None, param)] = value
+                else:
+                    raise ParseError('%s.%s of SKU %s must be a scalar or a map' % (plugin, param, sku['id']))
+
+    return config['version'], config['spec'], skus
+
+class StringPool(object):
+    def __init__(self):
+        self.offsets = {}
+        self.strings = []
+        self.size = 0
+
+    def add(self, s):
+        if s is None:
+            return NO_STRING
+        if s not in self.offsets:
+            self.offsets[s] = self.size
+            self.strings.append(s)
+            self.size += len(s.encode('utf-8')) + 1
+        return self.offsets[s]
+
+def _c_literal(s):
+    out = []
+    for b in s.encode('utf-8') + b'\0':
+        c = chr(b)
+        if c in '"\\?':
+            out.append('\\' + c)
+        elif 32 <= b < 127:
+            out.append(c)
+        else:
+            # Octal escapes are at most 3 digits, so they can't swallow the next character
+            out.append('\\%03o' % b)
+    return '"%s"' % ''.join(out)
+
+def source_hash(data):
+    '''64-bit FNV-1a of the source file. CompiledDiagSkus::IsCompiledFrom() computes the same'''
+    h = 0xcbf29ce484222325
+    for b in data:
+        h = ((h ^ b) * 0x100000001b3) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+def generate(version, spec, skus, source):
+    pool = StringPool()
+    versionOffset = pool.add(version)
+    specOffset = pool.add(spec)
+
+    skuRows = []
+    paramRows = []
+    # Sorted so FindSku() can binary search. std::string_view compares bytewise, like this does
+    for skuId in sorted(skus, key=lambda s: s.encode('utf-8')):
+        name, params = skus[skuId]
+        firstParam = len(paramRows)
+        for (plugin, subtest, param), value in params.items():
+            paramRows.append((pool.add(plugin), pool.add(subtest), pool.add(param), pool.add(value)))
+        skuRows.append((pool.add(skuId), pool.add(name), firstParam, len(paramRows) - firstParam))
+
+    out = []
+    out.append('/* Generated from diag-skus.yaml by nvvs/compile_diag_skus.py. Do not edit */')
+    out.append('#include "CompiledDiagSkus.h"')
+    out.append('')
+    out.append('namespace DcgmNs::Nvvs')
+    out.append('{')
+    out.append('const char c_compiledDiagSkuStrings[] =')
+    for s in pool.strings:
+        out.append('    %s' % _c_literal(s))
+    out.append('    ;')
+    out.append('')
+    out.append('const CompiledDiagSku c_compiledDiagSkus[] = {')
+    for row in skuRows:
+        out.append('    { %du, %du, %du, %du },' % row)
+    out.append('};')
+    out.append('')
+    out.append('const CompiledDiagSkuParam c_compiledDiagSkuParams[] = {')
+    for row in paramRows:
+        out.append('    { %du, %du, %du, %du },' % row)
+    out.append('};')
+    out.append('')
+    for cType, name, value in (('std::uint32_t', 'c_compiledDiagSkuCount', '%du' % len(skuRows)),
+                               ('std::uint32_t', 'c_compiledDiagVersion', '%du' % versionOffset),
+                               ('std::uint32_t', 'c_compiledDiagSpec', '%du' % specOffset),
+                               ('std::uint64_t', 'c_compiledDiagSourceSize', '%dull' % len(source)),
+                               ('std::uint64_t', 'c_compiledDiagSourceHash', '%dull' % source_hash(source))):
+        out.append('const %s %-24s = %s;' % (cType, name, value))
+    out.append('} // namespace DcgmNs::Nvvs')
+    out.append('')
+    return '\n'.join(out)
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('usage: %s <diag-skus.yaml> <output.cpp>\n' % sys.argv[0])
+        return 1
+
+    try:
+        with open(sys.argv[1], 'rb') as f:
+            source = f.read()
+        version, spec, skus = collect_skus(parse_yaml(source.decode('utf-8').splitlines()))
+    except ParseError as e:
+        sys.stderr.write('%s: %s\n' % (sys.argv[1], e))
+        return 1
+
+    with open(sys.argv[2], 'w', encoding='utf-8') as f:
+        f.write(generate(version, spec, skus, source))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
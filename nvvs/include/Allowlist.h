@@ -56,7 +56,8 @@ protected:
 
     /***************************PRIVATE**********************************/
 private:
-    void FillMap();
+    /* Fill in m_featureDb for a SKU ID the first time it's asked about */
+    void LoadSku(const std::string &id);
 
     /* YAML config parser
      */
@@ -68,6 +69,9 @@ private:
 
     /* Set of hardware deviceIds which require global configuration changes. */
     std::set<std::string> m_globalChanges;
+
+    /* SKU IDs that LoadSku() has already looked up, including ones that don't exist */
+    std::set<std::string> m_loadedSkus;
 };
 
 } // namespace DcgmNs::Nvvs
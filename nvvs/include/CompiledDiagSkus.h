@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace DcgmNs::Nvvs
+{
+/*
+ * The diag SKU table from diag-skus.yaml, compiled into nvvs at build time by compile_diag_skus.py.
+ *
+ * Every string is an offset into a single string pool, so the tables are plain read-only data with
+ * no relocations. They are paged in from the executable as they are touched instead of being parsed
+ * on every run.
+ */
+
+/* Offset used for strings that are not set */
+constexpr std::uint32_t c_compiledDiagNoString = 0xFFFFFFFF;
+
+struct CompiledDiagSkuParam
+{
+    std::uint32_t plugin;  /* Plugin name, e.g. "sm_stress" */
+    std::uint32_t subtest; /* Subtest name, or c_compiledDiagNoString for a plugin-level parameter */
+    std::uint32_t name;    /* Parameter name */
+    std::uint32_t value;   /* Parameter value, exactly as it was written in the YAML */
+};
+
+struct CompiledDiagSku
+{
+    std::uint32_t id;         /* PCI device ID, optionally followed by the SSID. The table is sorted on this */
+    std::uint32_t name;       /* Name of the SKU */
+    std::uint32_t firstParam; /* Index of the SKU's first entry in c_compiledDiagSkuParams */
+    std::uint32_t numParams;  /* How many entries of c_compiledDiagSkuParams belong to the SKU */
+};
+
+/* Generated tables */
+extern const char c_compiledDiagSkuStrings[];
+extern const CompiledDiagSku c_compiledDiagSkus[];
+extern const CompiledDiagSkuParam c_compiledDiagSkuParams[];
+extern const std::uint32_t c_compiledDiagSkuCount;
+extern const std::uint32_t c_compiledDiagVersion;
+extern const std::uint32_t c_compiledDiagSpec;
+extern const std::uint64_t c_compiledDiagSourceSize;
+extern const std::uint64_t c_compiledDiagSourceHash;
+
+class CompiledDiagSkus
+{
+public:
+    /*************************************************************************/
+    /* Get the version and spec the table was compiled from */
+    static std::string_view GetVersion();
+    static std::string_view GetSpec();
+
+    /*************************************************************************/
+    /* Check whether yaml is the exact file the table was compiled from */
+    static bool IsCompiledFrom(std::string_view yaml);
+
+    /*************************************************************************/
+    /* Get every SKU in the table, sorted by ID */
+    static std::span<CompiledDiagSku const> GetSkus();
+
+    /*************************************************************************/
+    /* Look up a SKU by its ID. Returns nullptr if the SKU isn't in the table */
+    static CompiledDiagSku const *FindSku(std::string_view id);
+
+    /*************************************************************************/
+    /* Get the parameters of a SKU returned by GetSkus() or FindSku() */
+    static std::span<CompiledDiagSkuParam const> GetParams(CompiledDiagSku const &sku);
+
+    /*************************************************************************/
+    /* Resolve a string offset from one of the tables. c_compiledDiagNoString resolves to "" */
+    static std::string_view GetString(std::uint32_t offset);
+};
+
+} // namespace DcgmNs::Nvvs
@@ -17,7 +17,9 @@
 #include "GpuSet.h"
 #include "TestParameters.h"
 #include <fstream>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -28,6 +30,16 @@ namespace DcgmNs::Nvvs
 // Forward declaration
 class ConfigFileParser_v2;
 
+/* The diag parameters of one plugin for a SKU. Values are kept as the scalars from the config */
+struct DiagSkuPlugin
+{
+    std::map<std::string, std::string> params;                          /* parameter -> value */
+    std::map<std::string, std::map<std::string, std::string>> subtests; /* subtest -> parameter -> value */
+};
+
+/* The diag parameters of a SKU, keyed by plugin name */
+using DiagSku = std::map<std::string, DiagSkuPlugin>;
+
 enum nvvs_fwcfg_enum
 {
     NVVS_FWCFG_GLOBAL_DATAFILE = 0,
@@ -128,16 +140,22 @@ public:
     ConfigFileParser_v2(const std::string &configFile, const FrameworkConfig &fwcfg);
 
     /***************************************************************/
-    /* Open the stringstream for the config file and initialize
-     * YAML to the most upper layer doc
+    /* Load the config files. The packaged diag-skus.yaml is only parsed
+     * if it isn't the file the SKU table was compiled from, e.g. after
+     * the dcgm-config package was updated. It then replaces the compiled
+     * table. The user-supplied config file is parsed if there is one.
+     * When neither needs parsing, no YAML is parsed at all
      */
     bool Init();
 
 
     /***************************************************************/
-    /* Return a map from SKU ID to wrapped YAML nodes
+    /* Return the parameters of a SKU: the entry in the compiled SKU
+     * table, or in the packaged config file if that overrides it, with
+     * anything from the user-supplied config file layered on top.
+     * Returns std::nullopt if neither knows about the SKU
      */
-    const std::unordered_map<std::string, YAML::Node> &GetSkus() const;
+    std::optional<DiagSku> GetSku(const std::string &id) const;
 
 
     /***************************************************************/
@@ -148,6 +166,15 @@ public:
         m_configFile = userConfig;
     }
 
+    /***************************************************************/
+    /* Specify the packaged config file. It defaults to diag-skus.yaml
+     * in the directory of the nvvs executable
+     */
+    void setPackageConfigFile(std::string_view packageConfig)
+    {
+        m_packageConfigFile = packageConfig;
+    }
+
     void legacyGlobalStructHelper();
     std::vector<std::unique_ptr<GpuSet>> &getGpuSetVec()
     {
@@ -155,14 +182,16 @@ public:
     }
 
 private:
-    /* Returns reference to m_skus[id]. Adds the GPU if it does not exist */
-    YAML::Node &GetOrAddSku(const std::string &id);
-    void ParseYaml();
+    /* Merge the SKUs of config into skus */
+    void ParseYaml(YAML::Node const &config, std::unordered_map<std::string, YAML::Node> &skus);
+    void LoadPackageConfig();
     FrameworkConfig m_fwcfg;
     std::string m_configFile;
-    YAML::Node m_fallbackYaml;
+    std::string m_packageConfigFile;
     YAML::Node m_userYaml;
-    std::unordered_map<std::string, YAML::Node> m_skus;
+    std::unordered_map<std::string, YAML::Node> m_skus;        /* SKUs from the user-supplied config file */
+    std::unordered_map<std::string, YAML::Node> m_packageSkus; /* SKUs from the packaged config file */
+    bool m_usePackageSkus = false; /* Does the packaged config file override the compiled SKU table? */
 
     std::vector<std::unique_ptr<GpuSet>> gpuSets;
 };
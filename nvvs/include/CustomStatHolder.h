@@ -44,6 +44,17 @@ typedef struct
     long long timestamp;
 } dcgmTimeseriesInfo_t;
 
+/* A custom stat received from a plugin, in the form CustomStatHolder stores it */
+struct CustomStatRecord
+{
+    unsigned short type = DCGM_CUSTOM_STAT_TYPE_GPU; // One of DCGM_CUSTOM_STAT_TYPE_*
+    unsigned int gpuId  = 0;                         // Only for DCGM_CUSTOM_STAT_TYPE_GPU
+    std::string statName;
+    std::string category;
+    std::vector<dcgmTimeseriesInfo_t> values; // Values of GPU and grouped stats
+    std::string strValue;                     // Value of a single stat
+};
+
 class CustomStatHolder
 {
 public:
@@ -116,6 +127,23 @@ public:
      * Add all of the stats referred to in the customStats vector to this object
      */
     void AddDiagStats(const std::vector<dcgmDiagCustomStats_t> &customStats);
+    void AddDiagStats(const std::vector<CustomStatRecord> &customStats);
+
+    /*
+     * Pass every stat in this object to sink, one chunk per stat. Stops at the first chunk sink doesn't take.
+     * Unlike PopulateCustomStats(), this can be called any number of times.
+     *
+     * @return DCGM_ST_OK if every chunk was taken, or the return of sink otherwise
+     */
+    dcgmReturn_t StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData);
+
+    /*
+     * Append the stat in chunk to records. Used by the diagnostic to receive stats streamed by a plugin
+     *
+     * @return DCGM_ST_OK if the chunk was added
+     *         DCGM_ST_BADPARAM if the chunk is invalid
+     */
+    static dcgmReturn_t AppendChunk(std::vector<CustomStatRecord> &records, const dcgmDiagCustomStatChunk_t &chunk);
 
     /*
      * Translates the gpuId to the index it should be in the Json stats file
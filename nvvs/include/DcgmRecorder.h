@@ -300,10 +300,10 @@ public:
     /*
      * Add the customStats information to the private custom stats storage.
      *
-     * @param customStats - the list of diag custom stats structs containing stats information not tied
+     * @param customStats - the custom stats records containing stats information not tied
      *                      to field ids that should be added to the private storage.
      */
-    void AddDiagStats(const std::vector<dcgmDiagCustomStats_t> &customStats);
+    void AddDiagStats(const std::vector<CustomStatRecord> &customStats);
 
     /**
      * Check the errors that should be checked for each plugin
@@ -15,4 +15,17 @@
  */
 #pragma once
 
-extern const char c_fallbackBakedDiagYaml[];
+/*****************************************************************************/
+/*
+ * Run nvvs as a warm worker for the diag module. See NvvsWorkerProtocol.hpp
+ *
+ * The worker maps the plugin libraries once, then serves Run requests from stdin
+ * until stdin is closed. Each request is run by nvvsMain in a child forked from
+ * the worker, so every diagnostic still gets its own process and a crash or a
+ * kill only takes down that run.
+ *
+ * argv is "nvvs --worker [-p <plugin dir>]"
+ *
+ * Returns the exit code of the worker
+ */
+int RunNvvsWorker(int argc, char *argv[], int (*nvvsMain)(int, char **));
@@ -0,0 +1,175 @@
+// Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+/* First argument that starts nvvs as a warm worker instead of running a diagnostic */
+#define NVVS_WORKER_ARG "--worker"
+
+/*
+ * Protocol between the diag module and a warm nvvs worker.
+ *
+ * The worker reads requests from its stdin and writes responses to its stdout.
+ * Every message is a MessageHeader followed by length bytes of payload.
+ *
+ * Once its plugins are loaded the worker sends Ready. For each Run it forks a child
+ * that runs nvvs with the requested arguments, and replies with Started, any number of
+ * Stdout and Stderr messages carrying the child's output, and finally Exited.
+ */
+namespace DcgmNs::Nvvs::Worker
+{
+
+enum class MessageType : std::uint32_t
+{
+    Ready = 1, /* Worker -> diag. No payload */
+    Run,       /* Diag -> worker. Payload is the arguments packed with PackArgs() */
+    Started,   /* Worker -> diag. Payload is the pid_t of the child running the diagnostic */
+    Stdout,    /* Worker -> diag. Payload is output of the child */
+    Stderr,    /* Worker -> diag. Payload is output of the child */
+    Exited,    /* Worker -> diag. Payload is the int status from waitpid() of the child */
+};
+
+struct MessageHeader
+{
+    MessageType type;
+    std::uint32_t length;
+};
+
+/* Largest payload a message can carry. Longer output is split over several messages */
+inline constexpr std::uint32_t MAX_PAYLOAD = 64 * 1024;
+
+/*****************************************************************************/
+/* Write exactly size bytes to fd. Returns false on error or if fd was closed */
+inline bool WriteAll(int fd, void const *buf, size_t size)
+{
+    auto const *pos = static_cast<char const *>(buf);
+    while (size > 0)
+    {
+        ssize_t written = write(fd, pos, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        pos += written;
+        size -= written;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* Read exactly size bytes from fd. Returns false on error or if fd was closed first */
+inline bool ReadAll(int fd, void *buf, size_t size)
+{
+    auto *pos = static_cast<char *>(buf);
+    while (size > 0)
+    {
+        ssize_t numRead = read(fd, pos, size);
+        if (numRead < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        if (numRead == 0)
+        {
+            return false;
+        }
+        pos += numRead;
+        size -= numRead;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+inline bool WriteMessage(int fd, MessageType type, void const *payload, std::uint32_t length)
+{
+    if (length > MAX_PAYLOAD)
+    {
+        return false;
+    }
+    MessageHeader header { type, length };
+    return WriteAll(fd, &header, sizeof(header)) && (length == 0 || WriteAll(fd, payload, length));
+}
+
+/*****************************************************************************/
+inline bool WriteMessage(int fd, MessageType type, std::string const &payload)
+{
+    return WriteMessage(fd, type, payload.data(), static_cast<std::uint32_t>(payload.size()));
+}
+
+/*****************************************************************************/
+/*
+ * Read one message from fd
+ *
+ * Returns true if a whole message was read
+ *         false if fd was closed, on error or if the header is invalid
+ */
+inline bool ReadMessage(int fd, MessageType &type, std::string &payload)
+{
+    MessageHeader header {};
+    if (!ReadAll(fd, &header, sizeof(header)) || header.length > MAX_PAYLOAD)
+    {
+        return false;
+    }
+    type = header.type;
+    payload.resize(header.length);
+    return header.length == 0 || ReadAll(fd, payload.data(), header.length);
+}
+
+/*****************************************************************************/
+/* Pack arguments into a Run payload. Each argument is followed by a NUL */
+inline std::string PackArgs(std::vector<std::string> const &args)
+{
+    std::string packed;
+    for (auto const &arg : args)
+    {
+        packed.append(arg);
+        packed.push_back('\0');
+    }
+    return packed;
+}
+
+/*****************************************************************************/
+/* Inverse of PackArgs(). A missing final NUL is tolerated */
+inline std::vector<std::string> UnpackArgs(std::string const &packed)
+{
+    std::vector<std::string> args;
+    size_t start = 0;
+    while (start < packed.size())
+    {
+        size_t end = packed.find('\0', start);
+        if (end == std::string::npos)
+        {
+            end = packed.size();
+        }
+        args.emplace_back(packed, start, end - start);
+        start = end + 1;
+    }
+    return args;
+}
+
+} // namespace DcgmNs::Nvvs::Worker
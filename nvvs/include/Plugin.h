@@ -290,6 +290,11 @@ public:
      */
     void PopulateCustomStats(dcgmDiagCustomStats_t &customStats);
 
+    /*
+     * Pass every custom stat to sink, one chunk at a time
+     */
+    dcgmReturn_t StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData);
+
     /* Variables */
     Output *progressOut; // Output object passed in from the test framework for progress updates
 
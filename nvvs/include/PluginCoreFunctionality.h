@@ -56,7 +56,7 @@ public:
     dcgmReturn_t PluginEnded(const std::string &statsfile,
                              TestParameters &tp,
                              nvvsPluginResult_t result,
-                             std::vector<dcgmDiagCustomStats_t> &customStats);
+                             std::vector<CustomStatRecord> &customStats);
 
     /********************************************************************/
     /*
@@ -35,8 +35,9 @@ extern "C" {
 #define DCGM_DIAG_PLUGIN_INTERFACE_VERSION_1 1
 #define DCGM_DIAG_PLUGIN_INTERFACE_VERSION_2 2 /* 2.4.0 -> 3.1.7 */
 #define DCGM_DIAG_PLUGIN_INTERFACE_VERSION_3 3 /* Current version - 3.1.8 -> 3.2.3 */
-#define DCGM_DIAG_PLUGIN_INTERFACE_VERSION_4 4 /* Current version - 3.2.5 and later */
-#define DCGM_DIAG_PLUGIN_INTERFACE_VERSION   DCGM_DIAG_PLUGIN_INTERFACE_VERSION_4
+#define DCGM_DIAG_PLUGIN_INTERFACE_VERSION_4 4 /* 3.2.5 and later. Still loaded */
+#define DCGM_DIAG_PLUGIN_INTERFACE_VERSION_5 5 /* Current version - adds StreamCustomStats */
+#define DCGM_DIAG_PLUGIN_INTERFACE_VERSION   DCGM_DIAG_PLUGIN_INTERFACE_VERSION_5
 
 /* IMPORTANT:
  *
@@ -141,6 +142,43 @@ typedef struct
     dcgmDiagCustomStat_t stats[DCGM_DIAG_MAX_CUSTOM_STATS]; // !< the stats
 } dcgmDiagCustomStats_t;
 
+/*
+ * One value of a streamed custom stat. Which member of value is set depends on the valueType of the chunk
+ */
+typedef struct
+{
+    long long timestamp; //!< The timestamp
+    union
+    {
+        long long i;
+        double dbl;
+    } value; //!< The value for the stat
+} dcgmDiagCustomStatValue_t;
+
+/*
+ * A run of values of one custom stat, passed to a dcgmDiagCustomStatsSink_f.
+ * There is no limit on the number of values in a chunk, and a stat may be split over any number of chunks.
+ * All pointers only need to stay valid until the sink returns.
+ */
+typedef struct
+{
+    unsigned short type;                     //!< the type of stat (one of DCGM_CUSTOM_STAT_TYPE_*)
+    unsigned int gpuId;                      //!< The GPU id if type is DCGM_CUSTOM_STAT_TYPE_GPU
+    const char *statName;                    //!< the name of the stat
+    const char *category;                    //!< the category for the stat, if any. May be NULL
+    dcgmPluginValue_t valueType;             //!< DcgmPluginParamInt, DcgmPluginParamFloat or DcgmPluginParamString
+    unsigned int numValues;                  //!< The number of entries in values
+    const dcgmDiagCustomStatValue_t *values; //!< The timestamps and values if valueType is not a string
+    const char *strValue;                    //!< The value if valueType is DcgmPluginParamString
+} dcgmDiagCustomStatChunk_t;
+
+/*
+ * Callback the diagnostic passes to StreamCustomStats()
+ *
+ * @return DCGM_ST_OK if the chunk was taken. Otherwise the plugin should stop streaming
+ */
+typedef dcgmReturn_t (*dcgmDiagCustomStatsSink_f)(const dcgmDiagCustomStatChunk_t *chunk, void *sinkData);
+
 #define DCGM_EVENT_MSG_LEN 1024
 /* Pcie test can generate at least (NUM_GPUs * 6) entries */
 /* NOTE: dcgmi condenses discreet entries into per-gpu output */
@@ -274,6 +312,19 @@ typedef void (*dcgmDiagRunTest_f)(unsigned int timeout,
 DCGM_PUBLIC_API void RetrieveCustomStats(dcgmDiagCustomStats_t *customStats, void *userData);
 typedef void (*dcgmDiagRetrieveCustomStats_f)(dcgmDiagCustomStats_t *customStats, void *userData);
 
+/**
+ * Pass custom stats (not covered by field ids) to the DCGM diagnostic in chunks of any size.
+ * Since DCGM_DIAG_PLUGIN_INTERFACE_VERSION_5. A plugin must export this or RetrieveCustomStats(); this one is
+ * used when it's there.
+ *
+ * @param sink[in]      - the plugin should call this once for each chunk of stats, and stop if it doesn't return
+ *                        DCGM_ST_OK
+ * @param sinkData[in]  - passed back to sink
+ * @param userData[in]  - the user data set in InitializePlugin()
+ */
+DCGM_PUBLIC_API void StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData, void *userData);
+typedef void (*dcgmDiagStreamCustomStats_f)(dcgmDiagCustomStatsSink_f sink, void *sinkData, void *userData);
+
 /**
  * Pass results from the plugin to the diagnostic.
  * Also, perform any shutdown and cleanup required by the plugin
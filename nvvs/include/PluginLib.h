@@ -67,7 +67,7 @@ public:
     void RunTest(unsigned int timeout, TestParameters *tp);
 
     /*****************************************************************************/
-    const std::vector<dcgmDiagCustomStats_t> &GetCustomStats() const;
+    const std::vector<CustomStatRecord> &GetCustomStats() const;
 
     /*****************************************************************************/
     const std::vector<dcgmDiagErrorDetail_v2> &GetErrors() const;
@@ -100,11 +100,13 @@ private:
     dcgmDiagInitializePlugin_f m_initializeCB;
     dcgmDiagRunTest_f m_runTestCB;
     dcgmDiagRetrieveCustomStats_f m_retrieveStatsCB;
+    dcgmDiagStreamCustomStats_f m_streamStatsCB;
     dcgmDiagRetrieveResults_f m_retrieveResultsCB;
     dcgmDiagShutdownPlugin_f m_shutdownPluginCB;
     void *m_userData;
     std::string m_pluginName;
-    std::vector<dcgmDiagCustomStats_t> m_customStats;
+    unsigned int m_pluginInterfaceVersion;
+    std::vector<CustomStatRecord> m_customStats;
     std::vector<dcgmDiagErrorDetail_v2> m_errors;
     std::vector<dcgmDiagErrorDetail_v2> m_info;
     std::vector<dcgmDiagSimpleResult_t> m_results;
@@ -119,5 +121,16 @@ private:
 
     void *LoadFunction(const char *funcname);
 
+    /*****************************************************************************/
+    /*
+     * Get the custom stats of the plugin into m_customStats, through StreamCustomStats() if the plugin has it
+     * and through RetrieveCustomStats() otherwise
+     */
+    void RetrieveCustomStats();
+
+    /*****************************************************************************/
+    /* dcgmDiagCustomStatsSink_f given to StreamCustomStats(). sinkData is the PluginLib */
+    static dcgmReturn_t ReceiveCustomStatChunk(const dcgmDiagCustomStatChunk_t *chunk, void *sinkData);
+
     std::string GetFullLogFileName() const;
 };
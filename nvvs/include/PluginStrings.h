@@ -39,6 +39,7 @@
 #define SW_PLUGIN_NAME             "software"
 #define SW_STR_CHECK_FILE_CREATION "check_file_creation"
 #define SW_STR_SKIP_DEVICE_TEST    "skip_device_test"
+#define SW_STR_HOST_CHECK_BATCH    "host_check_batch" /* Identifies the software run a host check belongs to */
 
 /******************************************************************************
  * PCIE PLUGIN
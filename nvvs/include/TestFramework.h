@@ -60,6 +60,16 @@ public:
 
     void LoadPlugins();
 
+    /********************************************************************/
+    /*
+     * Maps the plugin libraries for the given Cuda major version into this process without
+     * initializing them, so that a process forked from this one loads them with loadPlugins()
+     * without reading them from disk again. Used by the warm nvvs worker.
+     *
+     * Returns the number of libraries that were mapped
+     */
+    unsigned int PreloadPlugins(unsigned int cudaMajorVersion);
+
     int GetPluginIndex(Test::testClasses_enum classNum, const std::string &pluginName);
 
     /********************************************************************/
@@ -82,6 +92,7 @@ protected:
     std::list<void *> dlList;
     Output *m_output;
     bool skipRest;
+    unsigned int m_numSoftwareRuns; /* How many times the software tests were started */
     mode_t m_nvvsBinaryMode;
     uid_t m_nvvsOwnerUid;
     gid_t m_nvvsOwnerGid;
@@ -100,6 +111,7 @@ protected:
                 std::vector<Gpu *> gpuList,
                 bool checkFileCreation);
     void LoadLibrary(const char *libPath, const char *libName);
+    bool IsSkippedLibrary(const char *libName) const;
     void GetAndOutputHeader(Test::testClasses_enum classNum);
     void StartStatWatches(DcgmRecorder &dcgmRecorder, int pluginIndex, std::vector<Gpu *> gpuList);
     void EndStatWatches(DcgmRecorder &dcgmRecorder,
@@ -127,6 +139,12 @@ protected:
      */
     std::string GetPluginDirExtension() const;
 
+    /********************************************************************/
+    /*
+     * Returns /cuda{version}/ for a supported Cuda major version, or an empty string
+     */
+    static std::string GetPluginDirExtension(unsigned int cudaMajorVersion);
+
     /********************************************************************/
     /*
      * Returns true if the plugin has the same permissions and owner as the NVVS binary
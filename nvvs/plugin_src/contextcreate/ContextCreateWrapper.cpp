@@ -83,12 +83,12 @@ void RunTest(unsigned int timeout,
 }
 
 
-void RetrieveCustomStats(dcgmDiagCustomStats_t *customStats, void *userData)
+void StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData, void *userData)
 {
-    if (customStats != nullptr)
+    if (sink != nullptr)
     {
         auto ctx = (ContextCreatePlugin *)userData;
-        ctx->PopulateCustomStats(*customStats);
+        ctx->StreamCustomStats(sink, sinkData);
     }
 }
 
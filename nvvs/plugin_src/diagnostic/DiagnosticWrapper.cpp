@@ -85,12 +85,12 @@ void RunTest(unsigned int timeout,
 }
 
 
-void RetrieveCustomStats(dcgmDiagCustomStats_t *customStats, void *userData)
+void StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData, void *userData)
 {
-    if (customStats != nullptr)
+    if (sink != nullptr)
     {
         auto gbp = (GpuBurnPlugin *)userData;
-        gbp->PopulateCustomStats(*customStats);
+        gbp->StreamCustomStats(sink, sinkData);
     }
 }
 
@@ -91,12 +91,12 @@ void RunTest(unsigned int timeout,
 }
 
 
-void RetrieveCustomStats(dcgmDiagCustomStats_t *customStats, void *userData)
+void StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData, void *userData)
 {
-    if (customStats != nullptr)
+    if (sink != nullptr)
     {
         auto mem = (Memory *)userData;
-        mem->PopulateCustomStats(*customStats);
+        mem->StreamCustomStats(sink, sinkData);
     }
 }
 
@@ -88,12 +88,12 @@ void RunTest(unsigned int timeout,
 }
 
 
-void RetrieveCustomStats(dcgmDiagCustomStats_t *customStats, void *userData)
+void StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData, void *userData)
 {
-    if (customStats != nullptr)
+    if (sink != nullptr)
     {
         auto memtestp = (MemtestPlugin *)userData;
-        memtestp->PopulateCustomStats(*customStats);
+        memtestp->StreamCustomStats(sink, sinkData);
     }
 }
 
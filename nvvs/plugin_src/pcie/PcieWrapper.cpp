@@ -190,12 +190,12 @@ void RunTest(unsigned int timeout,
 }
 
 
-void RetrieveCustomStats(dcgmDiagCustomStats_t *customStats, void *userData)
+void StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData, void *userData)
 {
-    if (customStats != nullptr)
+    if (sink != nullptr)
     {
         auto bg = (BusGrind *)userData;
-        bg->PopulateCustomStats(*customStats);
+        bg->StreamCustomStats(sink, sinkData);
     }
 }
 
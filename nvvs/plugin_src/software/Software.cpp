@@ -25,14 +25,41 @@
 #include <errno.h>
 #include <fmt/format.h>
 #include <iostream>
+#include <link.h>
+#include <mutex>
 #include <stdexcept>
 #include <string.h>
+#include <thread>
 #include <unistd.h>
 
 #ifdef __x86_64__
 __asm__(".symver memcpy,memcpy@GLIBC_2.2.5");
 #endif
 
+namespace
+{
+/* Checks whose outcome only depends on the node. They're run together and their passes are cached */
+const char *const HOST_CHECKS[]
+    = { "denylist", "libraries_nvml", "libraries_cuda", "libraries_cudatk", "env_variables" };
+
+/* Env variables checkForBadEnvVaribles() warns about */
+const char *const BAD_ENV_VARIABLES[] = { "NSIGHT_CUDA_DEBUGGER",
+                                          "CUDA_INJECTION32_PATH",
+                                          "CUDA_INJECTION64_PATH",
+                                          "CUDA_AUTO_BOOST",
+                                          "CUDA_ENABLE_COREDUMP_ON_EXCEPTION",
+                                          "CUDA_COREDUMP_FILE",
+                                          "CUDA_DEVICE_WAITS_ON_EXCEPTION",
+                                          "CUDA_PROFILE",
+                                          "COMPUTE_PROFILE",
+                                          "OPENCL_PROFILE" };
+
+/* Outcomes of host-level checks that haven't been replayed yet. The plugin is recreated between checks */
+std::mutex g_hostCheckMutex;
+std::map<std::string, SoftwareCheckOutcome> g_hostCheckOutcomes;
+std::string g_hostCheckBatch; /* SW_STR_HOST_CHECK_BATCH of the run g_hostCheckOutcomes belong to */
+} // namespace
+
 Software::Software(dcgmHandle_t handle, dcgmDiagPluginGpuList_t *gpuInfo)
     : m_dcgmRecorder(handle)
     , m_dcgmSystem()
@@ -50,6 +77,7 @@ Software::Software(dcgmHandle_t handle, dcgmDiagPluginGpuList_t *gpuInfo)
     tp->AddString(SW_STR_DO_TEST, "None");
     tp->AddString(SW_STR_REQUIRE_PERSISTENCE, "True");
     tp->AddString(SW_STR_SKIP_DEVICE_TEST, "False");
+    tp->AddString(SW_STR_HOST_CHECK_BATCH, "");
     m_infoStruct.defaultTestParameters = tp;
 
     if (gpuInfo == nullptr)
@@ -80,19 +108,14 @@ void Software::Go(unsigned int numParameters, const dcgmDiagPluginTestParameter_
     TestParameters testParameters(*(m_infoStruct.defaultTestParameters));
     testParameters.SetFromStruct(numParameters, tpStruct);
 
-    if (testParameters.GetString(SW_STR_DO_TEST) == "denylist")
-        checkDenylist();
+    if (IsHostCheck(testParameters.GetString(SW_STR_DO_TEST)))
+        ApplyOutcome(TakeHostCheckOutcome(testParameters.GetString(SW_STR_DO_TEST),
+                                          testParameters.GetString(SW_STR_HOST_CHECK_BATCH)));
     else if (testParameters.GetString(SW_STR_DO_TEST) == "permissions")
     {
         checkPermissions(testParameters.GetBoolFromString(SW_STR_CHECK_FILE_CREATION),
                          testParameters.GetBoolFromString(SW_STR_SKIP_DEVICE_TEST));
     }
-    else if (testParameters.GetString(SW_STR_DO_TEST) == "libraries_nvml")
-        checkLibraries(CHECK_NVML);
-    else if (testParameters.GetString(SW_STR_DO_TEST) == "libraries_cuda")
-        checkLibraries(CHECK_CUDA);
-    else if (testParameters.GetString(SW_STR_DO_TEST) == "libraries_cudatk")
-        checkLibraries(CHECK_CUDATK);
     else if (testParameters.GetString(SW_STR_DO_TEST) == "persistence_mode")
     {
         int shouldCheckPersistence = testParameters.GetBoolFromString(SW_STR_REQUIRE_PERSISTENCE);
@@ -107,8 +130,6 @@ void Software::Go(unsigned int numParameters, const dcgmDiagPluginTestParameter_
             checkPersistenceMode();
         }
     }
-    else if (testParameters.GetString(SW_STR_DO_TEST) == "env_variables")
-        checkForBadEnvVaribles();
     else if (testParameters.GetString(SW_STR_DO_TEST) == "graphics_processes")
         checkForGraphicsProcesses();
     else if (testParameters.GetString(SW_STR_DO_TEST) == "page_retirement")
@@ -120,6 +141,165 @@ void Software::Go(unsigned int numParameters, const dcgmDiagPluginTestParameter_
         checkInforom();
 }
 
+bool Software::IsHostCheck(const std::string &name)
+{
+    for (const char *hostCheck : HOST_CHECKS)
+    {
+        if (name == hostCheck)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+SoftwareCheckOutcome Software::RunHostCheck(const std::string &name)
+{
+    SoftwareCheckOutcome outcome;
+
+    try
+    {
+        if (name == "denylist")
+            checkDenylist(outcome);
+        else if (name == "libraries_nvml")
+            checkLibraries(CHECK_NVML, outcome);
+        else if (name == "libraries_cuda")
+            checkLibraries(CHECK_CUDA, outcome);
+        else if (name == "libraries_cudatk")
+            checkLibraries(CHECK_CUDATK, outcome);
+        else if (name == "env_variables")
+            checkForBadEnvVaribles(outcome);
+    }
+    catch (const std::exception &e)
+    {
+        DcgmError d { DcgmError::GpuIdTag::Unknown };
+        DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_INTERNAL, d, e.what());
+        outcome.errors.push_back(d);
+        outcome.result = NVVS_RESULT_FAIL;
+    }
+
+    return outcome;
+}
+
+std::map<std::string, SoftwareCheckOutcome> Software::RunHostChecks()
+{
+    std::string driverVersion;
+    if (m_gpuInfo.numGpus > 0)
+    {
+        driverVersion = m_gpuInfo.gpus[0].attributes.identifiers.driverVersion;
+    }
+
+    std::vector<std::string> envVars { "LD_LIBRARY_PATH", "LD_PRELOAD" };
+    envVars.insert(envVars.end(), std::begin(BAD_ENV_VARIABLES), std::end(BAD_ENV_VARIABLES));
+
+    const char *cacheDir = getenv(NVVS_SW_CACHE_DIR);
+    SoftwareCheckCache cache(cacheDir == nullptr ? "" : cacheDir, driverVersion, std::move(envVars));
+    SoftwarePassedChecks passedChecks = cache.Load();
+
+    // Create every entry first, so the threads never write to the map while it changes
+    std::map<std::string, SoftwareCheckOutcome> outcomes;
+    for (const char *name : HOST_CHECKS)
+    {
+        outcomes[name];
+    }
+
+    std::vector<std::thread> threads;
+    for (auto &[name, outcome] : outcomes)
+    {
+        auto passed = passedChecks.find(name);
+        if (passed != passedChecks.end())
+        {
+            log_debug("Skipping the {} check, which passed before on an unchanged node", name);
+            outcome.result = NVVS_RESULT_PASS;
+            outcome.files  = passed->second;
+            continue;
+        }
+
+        threads.emplace_back([&name = name, &outcome = outcome] { outcome = RunHostCheck(name); });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    if (!threads.empty())
+    {
+        SoftwarePassedChecks nowPassed;
+        for (auto const &[name, outcome] : outcomes)
+        {
+            if (outcome.errors.empty() && (!outcome.result || *outcome.result == NVVS_RESULT_PASS))
+            {
+                nowPassed[name] = outcome.files;
+            }
+        }
+        cache.Store(nowPassed);
+    }
+
+    return outcomes;
+}
+
+SoftwareCheckOutcome Software::TakeHostCheckOutcome(const std::string &name, const std::string &batch)
+{
+    std::lock_guard<std::mutex> lock(g_hostCheckMutex);
+
+    // A run that failed early leaves the checks it didn't get to behind. Never hand those to another run.
+    // Every check is taken once per batch, so a missing one also means a new run started
+    if (batch != g_hostCheckBatch || g_hostCheckOutcomes.find(name) == g_hostCheckOutcomes.end())
+    {
+        g_hostCheckOutcomes = RunHostChecks();
+        g_hostCheckBatch    = batch;
+    }
+
+    auto node = g_hostCheckOutcomes.extract(name);
+    return node.empty() ? SoftwareCheckOutcome {} : std::move(node.mapped());
+}
+
+void Software::ApplyOutcome(const SoftwareCheckOutcome &outcome)
+{
+    for (auto const &error : outcome.errors)
+    {
+        AddError(error);
+    }
+
+    for (auto const &info : outcome.info)
+    {
+        AddInfo(info);
+    }
+
+    if (outcome.result)
+    {
+        SetResult(*outcome.result);
+    }
+}
+
+std::vector<Software::GpuFieldValues> Software::ReadGpuFieldValues(const std::vector<unsigned short> &fieldIds,
+                                                                   unsigned int flags)
+{
+    // Each thread only writes the values of its own GPU
+    std::vector<GpuFieldValues> values(m_gpuList.size());
+    std::vector<std::thread> readers;
+    readers.reserve(m_gpuList.size());
+
+    for (size_t i = 0; i < m_gpuList.size(); i++)
+    {
+        readers.emplace_back([this, gpuId = m_gpuList[i], flags, &fieldIds, &gpuValues = values[i]] {
+            for (unsigned short fieldId : fieldIds)
+            {
+                GpuFieldValue &value = gpuValues[fieldId];
+                value.ret            = m_dcgmRecorder.GetCurrentFieldValue(gpuId, fieldId, value.value, flags);
+            }
+        });
+    }
+
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    return values;
+}
+
 bool Software::CountDevEntry(const std::string &entryName)
 {
     if (entryName.compare(0, 6, "nvidia") == 0)
@@ -226,7 +406,7 @@ bool Software::checkPermissions(bool checkFileCreation, bool skipDeviceTest)
     return false;
 }
 
-bool Software::checkLibraries(libraryCheck_t checkLib)
+bool Software::checkLibraries(libraryCheck_t checkLib, SoftwareCheckOutcome &outcome)
 {
     // check whether the NVML, CUDA, and CUDA toolkit libraries can be found
     // via default paths
@@ -250,56 +430,61 @@ bool Software::checkLibraries(libraryCheck_t checkLib)
             // should never get here
             DcgmError d { DcgmError::GpuIdTag::Unknown };
             DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_BAD_PARAMETER, d, __func__);
-            AddError(d);
-            SetResult(NVVS_RESULT_FAIL);
+            outcome.errors.push_back(d);
+            outcome.result = NVVS_RESULT_FAIL;
         }
     }
 
     for (std::vector<std::string>::iterator it = libs.begin(); it != libs.end(); it++)
     {
         std::string error;
-        if (!findLib(*it, error))
+        std::string path;
+        if (!findLib(*it, error, path))
         {
             DcgmError d { DcgmError::GpuIdTag::Unknown };
             DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_CANNOT_OPEN_LIB, d, it->c_str(), error.c_str());
-            AddError(d);
+            outcome.errors.push_back(d);
             if (checkLib != CHECK_CUDATK)
             {
-                SetResult(NVVS_RESULT_FAIL);
+                outcome.result = NVVS_RESULT_FAIL;
             }
             else
             {
-                SetResult(NVVS_RESULT_WARN);
+                outcome.result = NVVS_RESULT_WARN;
             }
 
             fail = true;
         }
+        else if (!path.empty())
+        {
+            outcome.files.push_back(path);
+        }
     }
 
     // The statements that follow are all classified as info statements because only messages directly tied
     // to failures are errors.
     if (checkLib == CHECK_CUDATK && fail == true)
     {
-        AddInfo("The CUDA Toolkit libraries could not be found.");
-        AddInfo("Is LD_LIBRARY_PATH set to the 64-bit library path? (usually /usr/local/cuda/lib64)");
-        AddInfo("Some tests will not run.");
+        outcome.info.push_back("The CUDA Toolkit libraries could not be found.");
+        outcome.info.push_back("Is LD_LIBRARY_PATH set to the 64-bit library path? (usually /usr/local/cuda/lib64)");
+        outcome.info.push_back("Some tests will not run.");
     }
     if (checkLib == CHECK_CUDA && fail == true)
     {
-        AddInfo("The CUDA main library could not be found.");
-        AddInfo("Skipping remainder of tests.");
+        outcome.info.push_back("The CUDA main library could not be found.");
+        outcome.info.push_back("Skipping remainder of tests.");
     }
     if (checkLib == CHECK_NVML && fail == true)
     {
-        AddInfo("The NVML main library could not be found in the default search paths.");
-        AddInfo(
+        outcome.info.push_back("The NVML main library could not be found in the default search paths.");
+        outcome.info.push_back(
             "Please check to see if it is installed or that LD_LIBRARY_PATH contains the path to libnvidia-ml.so.1.");
-        AddInfo("Skipping remainder of tests.");
+        outcome.info.push_back("Skipping remainder of tests.");
     }
     return fail;
 }
 
-bool Software::checkDenylist()
+bool Software::checkDenylist(SoftwareCheckOutcome &outcome)
 {
     // check whether the nouveau driver is installed and if so, fail this test
     bool status = false;
@@ -332,10 +517,10 @@ bool Software::checkDenylist()
                 std::string baseDir = searchPaths[i];
                 std::stringstream testPath;
                 testPath << baseDir << "/" << ent->d_name << "/" << driverDirs[j];
-                if (checkDriverPathDenylist(testPath.str(), denyList))
+                if (checkDriverPathDenylist(testPath.str(), denyList, outcome))
                 {
-                    SetResult(NVVS_RESULT_FAIL);
-                    status = true;
+                    outcome.result = NVVS_RESULT_FAIL;
+                    status         = true;
                 }
             }
             ent = readdir(dir);
@@ -343,11 +528,13 @@ bool Software::checkDenylist()
         closedir(dir);
     }
     if (!status)
-        SetResult(NVVS_RESULT_PASS);
+        outcome.result = NVVS_RESULT_PASS;
     return status;
 }
 
-int Software::checkDriverPathDenylist(std::string driverPath, std::vector<std::string> const &denyList)
+int Software::checkDriverPathDenylist(std::string driverPath,
+                                      std::vector<std::string> const &denyList,
+                                      SoftwareCheckOutcome &outcome)
 {
     int ret;
     char symlinkTarget[1024];
@@ -389,7 +576,7 @@ int Software::checkDriverPathDenylist(std::string driverPath, std::vector<std::s
             {
                 DcgmError d { DcgmError::GpuIdTag::Unknown };
                 DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_DENYLISTED_DRIVER, d, item.c_str());
-                AddError(d);
+                outcome.errors.push_back(d);
                 return 1;
             }
         }
@@ -398,7 +585,7 @@ int Software::checkDriverPathDenylist(std::string driverPath, std::vector<std::s
     return 0;
 }
 
-bool Software::findLib(std::string library, std::string &error)
+bool Software::findLib(std::string library, std::string &error, std::string &path)
 {
     void *handle;
     handle = dlopen(library.c_str(), RTLD_NOW);
@@ -407,23 +594,30 @@ bool Software::findLib(std::string library, std::string &error)
         error = dlerror();
         return false;
     }
+
+    // Remember where it was found, so a cached pass is dropped when the library changes
+    struct link_map *linkMap = nullptr;
+    if (dlinfo(handle, RTLD_DI_LINKMAP, &linkMap) == 0 && linkMap != nullptr && linkMap->l_name != nullptr)
+    {
+        path = linkMap->l_name;
+    }
     dlclose(handle);
     return true;
 }
 
 int Software::checkForGraphicsProcesses()
 {
-    std::vector<unsigned int>::const_iterator gpuIt;
     unsigned int gpuId;
     unsigned int flags = DCGM_FV_FLAG_LIVE_DATA;
-    dcgmFieldValue_v2 graphicsPidsVal;
 
-    for (gpuIt = m_gpuList.begin(); gpuIt != m_gpuList.end(); gpuIt++)
+    std::vector<GpuFieldValues> values = ReadGpuFieldValues({ DCGM_FI_DEV_GRAPHICS_PIDS }, flags);
+
+    for (size_t i = 0; i < m_gpuList.size(); i++)
     {
-        gpuId = *gpuIt;
+        gpuId = m_gpuList[i];
 
-        dcgmReturn_t ret
-            = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_GRAPHICS_PIDS, graphicsPidsVal, flags);
+        dcgmReturn_t ret                         = values[i][DCGM_FI_DEV_GRAPHICS_PIDS].ret;
+        const dcgmFieldValue_v2 &graphicsPidsVal = values[i][DCGM_FI_DEV_GRAPHICS_PIDS].value;
 
         if (ret != DCGM_ST_OK)
         {
@@ -490,10 +684,6 @@ int Software::checkPersistenceMode()
 int Software::checkPageRetirement()
 {
     unsigned int gpuId;
-    std::vector<unsigned int>::const_iterator gpuIt;
-    dcgmFieldValue_v2 pendingRetirementsFieldValue;
-    dcgmFieldValue_v2 dbeFieldValue;
-    dcgmFieldValue_v2 sbeFieldValue;
     dcgmReturn_t ret;
     int64_t retiredPagesTotal;
 
@@ -507,12 +697,23 @@ int Software::checkPageRetirement()
         flags = 0;
     }
 
-    for (gpuIt = m_gpuList.begin(); gpuIt != m_gpuList.end(); gpuIt++)
+    // The DBE count is only needed with pending retirements, but reading it along with the rest is cheaper
+    std::vector<GpuFieldValues> values = ReadGpuFieldValues({ DCGM_FI_DEV_RETIRED_PENDING,
+                                                              DCGM_FI_DEV_ECC_DBE_VOL_TOTAL,
+                                                              DCGM_FI_DEV_RETIRED_DBE,
+                                                              DCGM_FI_DEV_RETIRED_SBE },
+                                                            flags);
+
+    for (size_t i = 0; i < m_gpuList.size(); i++)
     {
-        gpuId = *gpuIt;
+        gpuId = m_gpuList[i];
+
+        const dcgmFieldValue_v2 &pendingRetirementsFieldValue = values[i][DCGM_FI_DEV_RETIRED_PENDING].value;
+        const dcgmFieldValue_v2 &dbeFieldValue                = values[i][DCGM_FI_DEV_RETIRED_DBE].value;
+        const dcgmFieldValue_v2 &sbeFieldValue                = values[i][DCGM_FI_DEV_RETIRED_SBE].value;
+
         // Check for pending page retirements
-        ret = m_dcgmRecorder.GetCurrentFieldValue(
-            gpuId, DCGM_FI_DEV_RETIRED_PENDING, pendingRetirementsFieldValue, flags);
+        ret = values[i][DCGM_FI_DEV_RETIRED_PENDING].ret;
         if (ret != DCGM_ST_OK)
         {
             DcgmError d { gpuId };
@@ -531,8 +732,8 @@ int Software::checkPageRetirement()
         }
         else if (pendingRetirementsFieldValue.value.i64 > 0)
         {
-            dcgmFieldValue_v2 volDbeVal = {};
-            ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_ECC_DBE_VOL_TOTAL, volDbeVal, flags);
+            const dcgmFieldValue_v2 &volDbeVal = values[i][DCGM_FI_DEV_ECC_DBE_VOL_TOTAL].value;
+            ret                                = values[i][DCGM_FI_DEV_ECC_DBE_VOL_TOTAL].ret;
             if (ret == DCGM_ST_OK && (volDbeVal.value.i64 > 0 && !DCGM_INT64_IS_BLANK(volDbeVal.value.i64)))
             {
                 DcgmError d { gpuId };
@@ -554,7 +755,7 @@ int Software::checkPageRetirement()
         retiredPagesTotal = 0;
 
         // DBE retired pages
-        ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_RETIRED_DBE, dbeFieldValue, flags);
+        ret = values[i][DCGM_FI_DEV_RETIRED_DBE].ret;
         if (ret != DCGM_ST_OK)
         {
             DcgmError d { gpuId };
@@ -575,7 +776,7 @@ int Software::checkPageRetirement()
         }
 
         // SBE retired pages
-        ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_RETIRED_SBE, sbeFieldValue, flags);
+        ret = values[i][DCGM_FI_DEV_RETIRED_SBE].ret;
         if (ret != DCGM_ST_OK)
         {
             DcgmError d { gpuId };
@@ -611,9 +812,6 @@ int Software::checkPageRetirement()
 int Software::checkRowRemapping()
 {
     unsigned int gpuId;
-    std::vector<unsigned int>::const_iterator gpuIt;
-    dcgmFieldValue_v2 pendingRowRemap;
-    dcgmFieldValue_v2 rowRemapFailure;
     dcgmReturn_t ret;
 
     /* Flags to pass to dcgmRecorder.GetCurrentFieldValue. Get live data since we're not watching the fields ahead of
@@ -626,14 +824,19 @@ int Software::checkRowRemapping()
         flags = 0;
     }
 
-    for (gpuIt = m_gpuList.begin(); gpuIt != m_gpuList.end(); gpuIt++)
+    std::vector<GpuFieldValues> values = ReadGpuFieldValues(
+        { DCGM_FI_DEV_ROW_REMAP_FAILURE, DCGM_FI_DEV_ROW_REMAP_PENDING, DCGM_FI_DEV_UNCORRECTABLE_REMAPPED_ROWS },
+        flags);
+
+    for (size_t i = 0; i < m_gpuList.size(); i++)
     {
-        gpuId = *gpuIt;
+        gpuId = m_gpuList[i];
 
-        memset(&rowRemapFailure, 0, sizeof(rowRemapFailure));
+        const dcgmFieldValue_v2 &rowRemapFailure = values[i][DCGM_FI_DEV_ROW_REMAP_FAILURE].value;
+        const dcgmFieldValue_v2 &pendingRowRemap = values[i][DCGM_FI_DEV_ROW_REMAP_PENDING].value;
 
         // Row remap failure
-        ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_ROW_REMAP_FAILURE, rowRemapFailure, flags);
+        ret = values[i][DCGM_FI_DEV_ROW_REMAP_FAILURE].ret;
         if (ret != DCGM_ST_OK)
         {
             DcgmError d { gpuId };
@@ -658,10 +861,8 @@ int Software::checkRowRemapping()
             continue;
         }
 
-        memset(&pendingRowRemap, 0, sizeof(pendingRowRemap));
-
         // Check for pending row remappings
-        ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_ROW_REMAP_PENDING, pendingRowRemap, flags);
+        ret = values[i][DCGM_FI_DEV_ROW_REMAP_PENDING].ret;
         if (ret != DCGM_ST_OK)
         {
             DcgmError d { gpuId };
@@ -678,8 +879,8 @@ int Software::checkRowRemapping()
         }
         else if (pendingRowRemap.value.i64 > 0)
         {
-            dcgmFieldValue_v2 uncRemap = {};
-            ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_UNCORRECTABLE_REMAPPED_ROWS, uncRemap, flags);
+            const dcgmFieldValue_v2 &uncRemap = values[i][DCGM_FI_DEV_UNCORRECTABLE_REMAPPED_ROWS].value;
+            ret                               = values[i][DCGM_FI_DEV_UNCORRECTABLE_REMAPPED_ROWS].ret;
             if (ret == DCGM_ST_OK && (uncRemap.value.i64 > 0 && !DCGM_INT64_IS_BLANK(uncRemap.value.i64)))
             {
                 DcgmError d { gpuId };
@@ -702,16 +903,16 @@ int Software::checkRowRemapping()
 
 int Software::checkInforom()
 {
-    std::vector<unsigned int>::const_iterator gpuIt;
     unsigned int flags = DCGM_FV_FLAG_LIVE_DATA;
-    dcgmFieldValue_v2 inforomValidVal;
 
-    for (gpuIt = m_gpuList.begin(); gpuIt != m_gpuList.end(); gpuIt++)
+    std::vector<GpuFieldValues> values = ReadGpuFieldValues({ DCGM_FI_DEV_INFOROM_CONFIG_VALID }, flags);
+
+    for (size_t i = 0; i < m_gpuList.size(); i++)
     {
-        unsigned int gpuId = *gpuIt;
+        unsigned int gpuId = m_gpuList[i];
 
-        dcgmReturn_t ret
-            = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_INFOROM_CONFIG_VALID, inforomValidVal, flags);
+        dcgmReturn_t ret                         = values[i][DCGM_FI_DEV_INFOROM_CONFIG_VALID].ret;
+        const dcgmFieldValue_v2 &inforomValidVal = values[i][DCGM_FI_DEV_INFOROM_CONFIG_VALID].value;
 
         if (ret != DCGM_ST_OK)
         {
@@ -758,27 +959,13 @@ int Software::checkInforom()
     return 0;
 }
 
-int Software::checkForBadEnvVaribles()
+int Software::checkForBadEnvVaribles(SoftwareCheckOutcome &outcome)
 {
-    std::vector<std::string> checkKeys;
-    std::vector<std::string>::iterator checkKeysIt;
     std::string checkKey;
 
-    /* Env variables to look for */
-    checkKeys.push_back(std::string("NSIGHT_CUDA_DEBUGGER"));
-    checkKeys.push_back(std::string("CUDA_INJECTION32_PATH"));
-    checkKeys.push_back(std::string("CUDA_INJECTION64_PATH"));
-    checkKeys.push_back(std::string("CUDA_AUTO_BOOST"));
-    checkKeys.push_back(std::string("CUDA_ENABLE_COREDUMP_ON_EXCEPTION"));
-    checkKeys.push_back(std::string("CUDA_COREDUMP_FILE"));
-    checkKeys.push_back(std::string("CUDA_DEVICE_WAITS_ON_EXCEPTION"));
-    checkKeys.push_back(std::string("CUDA_PROFILE"));
-    checkKeys.push_back(std::string("COMPUTE_PROFILE"));
-    checkKeys.push_back(std::string("OPENCL_PROFILE"));
-
-    for (checkKeysIt = checkKeys.begin(); checkKeysIt != checkKeys.end(); checkKeysIt++)
+    for (const char *badEnvVariable : BAD_ENV_VARIABLES)
     {
-        checkKey = *checkKeysIt;
+        checkKey = badEnvVariable;
 
         /* Does the variable exist in the environment? */
         if (getenv(checkKey.c_str()) == nullptr)
@@ -790,8 +977,8 @@ int Software::checkForBadEnvVaribles()
         /* Variable found. Warn */
         DcgmError d { DcgmError::GpuIdTag::Unknown };
         DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_BAD_CUDA_ENV, d, checkKey.c_str());
-        AddError(d);
-        SetResult(NVVS_RESULT_WARN);
+        outcome.errors.push_back(d);
+        outcome.result = NVVS_RESULT_WARN;
     }
 
     return 0;
@@ -19,13 +19,28 @@
 #include "Gpu.h"
 #include "Plugin.h"
 #include "PluginStrings.h"
+#include "SoftwareCheckCache.h"
 #include "TestParameters.h"
 #include <DcgmRecorder.h>
 #include <NvvsStructs.h>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
+/*
+ * What a host-level check reported. All of those checks run at once when the first one is requested,
+ * and each run of the plugin replays the outcome of its check.
+ */
+struct SoftwareCheckOutcome
+{
+    std::optional<nvvsPluginResult_t> result; /* Unset if the check didn't set a result */
+    std::vector<DcgmError> errors;
+    std::vector<std::string> info;
+    std::vector<std::string> files; /* Files the outcome depends on, such as the libraries that were found */
+};
+
 class Software : public Plugin
 {
 public:
@@ -57,6 +72,13 @@ private:
         CHECK_CUDATK, // CUDA toolkit libraries (blas, fft, etc.)
     };
 
+    struct GpuFieldValue
+    {
+        dcgmReturn_t ret;
+        dcgmFieldValue_v2 value;
+    };
+    using GpuFieldValues = std::map<unsigned short, GpuFieldValue>;
+
     // variables
     std::string myArgs;
     TestParameters *tp;
@@ -67,17 +89,49 @@ private:
 
     // methods
     bool checkPermissions(bool checkFileCreation, bool skipDevTest);
-    bool checkLibraries(libraryCheck_t libs);
-    bool checkDenylist();
-    bool findLib(std::string, std::string &error);
-    int checkDriverPathDenylist(std::string, std::vector<std::string> const &);
+    static bool checkLibraries(libraryCheck_t libs, SoftwareCheckOutcome &outcome);
+    static bool checkDenylist(SoftwareCheckOutcome &outcome);
+    static bool findLib(std::string, std::string &error, std::string &path);
+    static int checkDriverPathDenylist(std::string, std::vector<std::string> const &, SoftwareCheckOutcome &outcome);
     int retrieveDeviceCount(unsigned int *count);
     int checkPersistenceMode();
     int checkForGraphicsProcesses();
-    int checkForBadEnvVaribles();
+    static int checkForBadEnvVaribles(SoftwareCheckOutcome &outcome);
     int checkPageRetirement();
     int checkRowRemapping();
     int checkInforom();
+
+    /*
+     * Returns true if name is a host-level check, whose outcome only depends on the node and not on the GPUs
+     */
+    static bool IsHostCheck(const std::string &name);
+
+    /*
+     * Run the host-level check name and return what it reported
+     */
+    static SoftwareCheckOutcome RunHostCheck(const std::string &name);
+
+    /*
+     * Run every host-level check concurrently, except those whose pass is still cached
+     */
+    std::map<std::string, SoftwareCheckOutcome> RunHostChecks();
+
+    /*
+     * Returns the outcome of the host-level check name. The first request of a batch runs all of them
+     *
+     * batch identifies the run the check belongs to. See SW_STR_HOST_CHECK_BATCH
+     */
+    SoftwareCheckOutcome TakeHostCheckOutcome(const std::string &name, const std::string &batch);
+
+    /*
+     * Report the outcome of a host-level check as this run's result
+     */
+    void ApplyOutcome(const SoftwareCheckOutcome &outcome);
+
+    /*
+     * Read the live values of fieldIds for every GPU, one thread per GPU. The result is indexed like m_gpuList
+     */
+    std::vector<GpuFieldValues> ReadGpuFieldValues(const std::vector<unsigned short> &fieldIds, unsigned int flags);
 };
 
 
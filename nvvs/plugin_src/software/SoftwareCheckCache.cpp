@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "SoftwareCheckCache.h"
+
+#include <DcgmLogging.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fmt/format.h>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Bump when the layout of the cache file changes */
+#define SW_CACHE_FORMAT_VERSION 1
+
+/* The cache file is a few KB. Anything much bigger wasn't written by us */
+#define SW_CACHE_MAX_SIZE (1024 * 1024)
+
+/*****************************************************************************/
+SoftwareCheckCache::SoftwareCheckCache(std::string cacheDir,
+                                       std::string driverVersion,
+                                       std::vector<std::string> envVars)
+    : m_cacheDir(std::move(cacheDir))
+    , m_driverVersion(std::move(driverVersion))
+    , m_envVars(std::move(envVars))
+{}
+
+/*****************************************************************************/
+std::string SoftwareCheckCache::GetPath() const
+{
+    if (m_cacheDir.empty())
+    {
+        return "";
+    }
+
+    /* Checks see the node with the permissions of the user running them, so each user gets its own cache */
+    return fmt::format("{}/nvvs-software-checks-{}.json", m_cacheDir, geteuid());
+}
+
+/*****************************************************************************/
+Json::Value SoftwareCheckCache::GetFileStamp(std::string const &path)
+{
+    struct stat st = {};
+    if (stat(path.c_str(), &st) != 0)
+    {
+        return Json::Value();
+    }
+
+    return fmt::format("{}:{}:{}:{}.{:09}",
+                       st.st_dev,
+                       st.st_ino,
+                       st.st_size,
+                       static_cast<long long>(st.st_mtim.tv_sec),
+                       static_cast<long>(st.st_mtim.tv_nsec));
+}
+
+/*****************************************************************************/
+/* FNV-1a hash of lines in sorted order, in hex */
+static std::string HashSortedLines(std::vector<std::string> lines)
+{
+    std::sort(lines.begin(), lines.end());
+
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (auto const &line : lines)
+    {
+        for (char c : line)
+        {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+        }
+        hash = (hash ^ '\n') * 0x100000001b3ULL;
+    }
+
+    return fmt::format("{:016x}", hash);
+}
+
+/*****************************************************************************/
+std::string SoftwareCheckCache::HashKernelModules(std::string const &modulesFile)
+{
+    std::ifstream modules(modulesFile);
+    std::vector<std::string> names;
+    std::string line;
+
+    /* Only the names. The rest of each line, like the use count, changes all the time */
+    while (std::getline(modules, line))
+    {
+        std::string name = line.substr(0, line.find(' '));
+        if (!name.empty())
+        {
+            names.push_back(std::move(name));
+        }
+    }
+
+    return HashSortedLines(std::move(names));
+}
+
+/*****************************************************************************/
+std::string SoftwareCheckCache::HashDeviceDrivers(std::vector<std::string> const &devicesDirs)
+{
+    /* The same links the denylist check reads */
+    char const *const driverLinks[] = { "driver", "subsystem/drivers" };
+    std::vector<std::string> drivers;
+
+    for (auto const &devicesDir : devicesDirs)
+    {
+        DIR *dir = opendir(devicesDir.c_str());
+        if (dir == nullptr)
+        {
+            continue;
+        }
+
+        for (struct dirent *ent = readdir(dir); ent != nullptr; ent = readdir(dir))
+        {
+            if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0)
+            {
+                continue;
+            }
+
+            for (char const *driverLink : driverLinks)
+            {
+                std::string const linkPath = fmt::format("{}/{}/{}", devicesDir, ent->d_name, driverLink);
+                char target[1024];
+                ssize_t const ret = readlink(linkPath.c_str(), target, sizeof(target) - 1);
+                if (ret >= 0)
+                {
+                    drivers.push_back(linkPath + "=" + std::string(target, ret));
+                }
+            }
+        }
+        closedir(dir);
+    }
+
+    return HashSortedLines(std::move(drivers));
+}
+
+/*****************************************************************************/
+Json::Value SoftwareCheckCache::GetFingerprint() const
+{
+    Json::Value fingerprint(Json::objectValue);
+
+    /* Only strings and nulls, since a number may not parse back as the same type and would never match */
+    fingerprint["driverVersion"] = m_driverVersion;
+    fingerprint["euid"]          = std::to_string(geteuid());
+    fingerprint["kernelModules"] = HashKernelModules("/proc/modules");
+    fingerprint["deviceDrivers"] = HashDeviceDrivers({ "/sys/bus/pci/devices", "/sys/bus/pci_express/devices" });
+    fingerprint["ldCache"]       = GetFileStamp("/etc/ld.so.cache");
+
+    Json::Value &environment = fingerprint["environment"];
+    environment              = Json::Value(Json::objectValue);
+    for (auto const &envVar : m_envVars)
+    {
+        char const *value   = getenv(envVar.c_str());
+        environment[envVar] = value == nullptr ? Json::Value() : Json::Value(value);
+    }
+
+    return fingerprint;
+}
+
+/*****************************************************************************/
+SoftwarePassedChecks SoftwareCheckCache::Load() const
+{
+    std::string const path = GetPath();
+    if (path.empty())
+    {
+        return {};
+    }
+
+    int fd = open(path.c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0)
+    {
+        if (errno != ENOENT)
+        {
+            log_debug("Cannot open the software check cache '{}': {}", path, strerror(errno));
+        }
+        return {};
+    }
+
+    /* Only trust a file that nobody else could have written */
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_uid != geteuid() || (st.st_mode & (S_IWGRP | S_IWOTH))
+        || st.st_size > SW_CACHE_MAX_SIZE)
+    {
+        log_warning("Ignoring the software check cache '{}': it isn't a private regular file", path);
+        close(fd);
+        return {};
+    }
+
+    std::string content(st.st_size, '\0');
+    size_t numRead = 0;
+    while (numRead < content.size())
+    {
+        ssize_t ret = read(fd, content.data() + numRead, content.size() - numRead);
+        if (ret < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (ret <= 0)
+        {
+            break;
+        }
+        numRead += ret;
+    }
+    close(fd);
+    content.resize(numRead);
+
+    Json::CharReaderBuilder builder;
+    Json::String errors;
+    Json::Value cache;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    if (!reader->parse(content.data(), content.data() + content.size(), &cache, &errors) || !cache.isObject())
+    {
+        log_warning("Ignoring the software check cache '{}': {}", path, errors);
+        return {};
+    }
+
+    if (cache["version"] != SW_CACHE_FORMAT_VERSION || cache["fingerprint"] != GetFingerprint())
+    {
+        log_debug("The software check cache '{}' doesn't match the state of the node", path);
+        return {};
+    }
+
+    SoftwarePassedChecks passedChecks;
+    Json::Value const &checks = cache["checks"];
+    if (!checks.isObject())
+    {
+        return {};
+    }
+
+    for (auto const &name : checks.getMemberNames())
+    {
+        Json::Value const &stamps = checks[name];
+        if (!stamps.isObject())
+        {
+            continue;
+        }
+
+        std::vector<std::string> files = stamps.getMemberNames();
+        bool const unchanged           = std::all_of(files.begin(), files.end(), [&stamps](std::string const &file) {
+            return stamps[file] == GetFileStamp(file);
+        });
+        if (unchanged)
+        {
+            passedChecks[name] = std::move(files);
+        }
+        else
+        {
+            log_debug("Files checked by '{}' changed since it last passed", name);
+        }
+    }
+
+    return passedChecks;
+}
+
+/*****************************************************************************/
+bool SoftwareCheckCache::Store(SoftwarePassedChecks const &passedChecks) const
+{
+    std::string const path = GetPath();
+    if (path.empty())
+    {
+        return false;
+    }
+
+    Json::Value cache(Json::objectValue);
+    cache["version"]     = SW_CACHE_FORMAT_VERSION;
+    cache["fingerprint"] = GetFingerprint();
+
+    Json::Value &checks = cache["checks"];
+    checks              = Json::Value(Json::objectValue);
+    for (auto const &[name, files] : passedChecks)
+    {
+        Json::Value stamps(Json::objectValue);
+        for (auto const &file : files)
+        {
+            stamps[file] = GetFileStamp(file);
+        }
+        checks[name] = stamps;
+    }
+
+    std::string const content = cache.toStyledString();
+
+    /* Write a private temporary file and rename it, so readers never see a partial cache */
+    std::string tmpPath = m_cacheDir + "/.nvvs-software-checks-XXXXXX";
+    int fd              = mkostemp(tmpPath.data(), O_CLOEXEC);
+    if (fd < 0)
+    {
+        log_debug("Cannot create a software check cache in '{}': {}", m_cacheDir, strerror(errno));
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < content.size())
+    {
+        ssize_t ret = write(fd, content.data() + written, content.size() - written);
+        if (ret < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (ret <= 0)
+        {
+            break;
+        }
+        written += ret;
+    }
+
+    if (close(fd) != 0 || written != content.size() || rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        log_warning("Cannot write the software check cache '{}': {}", path, strerror(errno));
+        unlink(tmpPath.c_str());
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <json/json.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/* Directory the software plugin caches the host-level checks that passed in. Nothing is cached if it isn't set */
+#define NVVS_SW_CACHE_DIR "NVVS_SW_CACHE_DIR"
+
+/* Checks that passed, by name. Each maps to the files whose change invalidates it */
+using SoftwarePassedChecks = std::map<std::string, std::vector<std::string>>;
+
+/*****************************************************************************/
+/*
+ * Remembers on disk which host-level software checks passed.
+ *
+ * Those checks only depend on the state of the node, which rarely changes between diags.
+ * Passes are stored with a fingerprint of that state: the driver version, the effective user,
+ * a hash of the loaded kernel modules, a hash of the drivers bound to PCI devices, the
+ * environment variables the checks look at, and the inode, size and mtime of the dynamic
+ * linker cache. Each check also records the files it
+ * depends on, such as the libraries it found. A pass is only reused while all of these match.
+ *
+ * Failures are never cached, so a node that has a problem is checked again on every run.
+ */
+class SoftwareCheckCache
+{
+public:
+    /*
+     * cacheDir      - directory for the cache file. Empty disables the cache
+     * driverVersion - version of the loaded driver
+     * envVars       - environment variables that change the outcome of the checks
+     */
+    SoftwareCheckCache(std::string cacheDir, std::string driverVersion, std::vector<std::string> envVars);
+
+    /*************************************************************************/
+    /* Returns the checks that passed before and are still valid. Empty if there's no usable cache */
+    SoftwarePassedChecks Load() const;
+
+    /*************************************************************************/
+    /*
+     * Replace the cache with passedChecks
+     *
+     * Returns true if the cache was written
+     *         false if the cache is disabled or on error
+     */
+    bool Store(SoftwarePassedChecks const &passedChecks) const;
+
+    /*************************************************************************/
+    /* Path of the cache file, or an empty string if the cache is disabled */
+    std::string GetPath() const;
+
+    /*************************************************************************/
+    /* Fingerprint of the state of the node that every check depends on */
+    Json::Value GetFingerprint() const;
+
+    /*************************************************************************/
+    /* Identity of a file that changes when it's replaced or modified. Null if it can't be read */
+    static Json::Value GetFileStamp(std::string const &path);
+
+    /*************************************************************************/
+    /* FNV-1a hash of the sorted names of the modules in modulesFile, in hex */
+    static std::string HashKernelModules(std::string const &modulesFile);
+
+    /*************************************************************************/
+    /* FNV-1a hash of the driver links of every device in devicesDirs, in hex */
+    static std::string HashDeviceDrivers(std::vector<std::string> const &devicesDirs);
+
+private:
+    std::string m_cacheDir;
+    std::string m_driverVersion;
+    std::vector<std::string> m_envVars;
+};
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch.hpp>
+
+#include <SoftwareCheckCache.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+void WriteFile(std::string const &path, std::string const &content)
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << content;
+}
+
+void RemoveDir(std::string const &dir, SoftwareCheckCache const &cache)
+{
+    unlink(cache.GetPath().c_str());
+    unlink((dir + "/libfake.so").c_str());
+    unlink((dir + "/modules").c_str());
+    rmdir(dir.c_str());
+}
+} // namespace
+
+TEST_CASE("SoftwareCheckCache: Passes are reused until the node changes")
+{
+    char dirTemplate[] = "/tmp/dcgm-sw-cache-XXXXXX";
+    REQUIRE(mkdtemp(dirTemplate) != nullptr);
+    std::string const dir = dirTemplate;
+    std::string const lib = dir + "/libfake.so";
+    WriteFile(lib, "v1");
+
+    unsetenv("DCGM_SW_CACHE_TEST_VAR");
+    SoftwareCheckCache cache(dir, "535.00", { "DCGM_SW_CACHE_TEST_VAR" });
+    CHECK(cache.Load().empty());
+
+    SoftwarePassedChecks passed;
+    passed["denylist"];
+    passed["libraries_nvml"] = { lib };
+    REQUIRE(cache.Store(passed));
+    CHECK(cache.Load() == passed);
+
+    SECTION("A changed library only drops the check that found it")
+    {
+        unlink(lib.c_str());
+        WriteFile(lib, "v2");
+        SoftwarePassedChecks loaded = cache.Load();
+        CHECK(loaded.size() == 1);
+        CHECK(loaded.count("denylist") == 1);
+    }
+
+    SECTION("Another driver or environment drops everything")
+    {
+        SoftwareCheckCache otherDriver(dir, "545.00", { "DCGM_SW_CACHE_TEST_VAR" });
+        CHECK(otherDriver.Load().empty());
+
+        setenv("DCGM_SW_CACHE_TEST_VAR", "1", 1);
+        CHECK(cache.Load().empty());
+        unsetenv("DCGM_SW_CACHE_TEST_VAR");
+    }
+
+    SECTION("A cache others could write is ignored")
+    {
+        chmod(cache.GetPath().c_str(), 0666);
+        CHECK(cache.Load().empty());
+    }
+
+    RemoveDir(dir, cache);
+}
+
+TEST_CASE("SoftwareCheckCache: Disabled without a directory")
+{
+    SoftwareCheckCache cache("", "535.00", {});
+    SoftwarePassedChecks passed;
+    passed["denylist"];
+
+    CHECK(cache.GetPath().empty());
+    CHECK(!cache.Store(passed));
+    CHECK(cache.Load().empty());
+}
+
+TEST_CASE("SoftwareCheckCache: Kernel module hash")
+{
+    char dirTemplate[] = "/tmp/dcgm-sw-cache-XXXXXX";
+    REQUIRE(mkdtemp(dirTemplate) != nullptr);
+    std::string const dir     = dirTemplate;
+    std::string const modules = dir + "/modules";
+
+    WriteFile(modules, "nvidia_uvm 1 0 - Live 0x0\nnvidia 2 1 nvidia_uvm, Live 0x0\n");
+    std::string const hash = SoftwareCheckCache::HashKernelModules(modules);
+
+    /* Use counts and order don't matter */
+    WriteFile(modules, "nvidia 7 3 nvidia_uvm, Live 0x0\nnvidia_uvm 1 2 - Live 0x0\n");
+    CHECK(SoftwareCheckCache::HashKernelModules(modules) == hash);
+
+    WriteFile(modules, "nouveau 1 0 - Live 0x0\nnvidia 2 1 nvidia_uvm, Live 0x0\nnvidia_uvm 1 0 - Live 0x0\n");
+    CHECK(SoftwareCheckCache::HashKernelModules(modules) != hash);
+
+    RemoveDir(dir, SoftwareCheckCache("", "", {}));
+}
+
+TEST_CASE("SoftwareCheckCache: Device driver hash")
+{
+    char dirTemplate[] = "/tmp/dcgm-sw-cache-XXXXXX";
+    REQUIRE(mkdtemp(dirTemplate) != nullptr);
+    std::string const dir    = dirTemplate;
+    std::string const device = dir + "/0000:01:00.0";
+    std::string const driver = device + "/driver";
+    REQUIRE(mkdir(device.c_str(), 0700) == 0);
+
+    std::string const unbound = SoftwareCheckCache::HashDeviceDrivers({ dir });
+
+    REQUIRE(symlink("../../../bus/pci/drivers/nvidia", driver.c_str()) == 0);
+    std::string const nvidia = SoftwareCheckCache::HashDeviceDrivers({ dir });
+    CHECK(nvidia != unbound);
+    CHECK(SoftwareCheckCache::HashDeviceDrivers({ dir, dir + "/missing" }) == nvidia);
+
+    /* Rebinding the device to the denylisted driver changes the fingerprint */
+    unlink(driver.c_str());
+    REQUIRE(symlink("../../../bus/pci/drivers/nouveau", driver.c_str()) == 0);
+    CHECK(SoftwareCheckCache::HashDeviceDrivers({ dir }) != nvidia);
+
+    unlink(driver.c_str());
+    rmdir(device.c_str());
+    rmdir(dir.c_str());
+}
@@ -105,12 +105,12 @@ void RunTest(unsigned int timeout,
 }
 
 
-void RetrieveCustomStats(dcgmDiagCustomStats_t *customStats, void *userData)
+void StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData, void *userData)
 {
-    if (customStats != nullptr)
+    if (sink != nullptr)
     {
         auto cp = (ConstantPerf *)userData;
-        cp->PopulateCustomStats(*customStats);
+        cp->StreamCustomStats(sink, sinkData);
     }
 }
 
@@ -19,6 +19,7 @@
 #include "ParsingUtility.h"
 #include "PluginStrings.h"
 #include <dcgm_fields.h>
+#include <memory>
 #include <unordered_set>
 
 using namespace DcgmNs::Nvvs;
@@ -27,8 +28,7 @@ using namespace DcgmNs::Nvvs;
 Allowlist::Allowlist(const ConfigFileParser_v2 &configFileParser)
     : m_configFileParser(configFileParser)
 {
-    // initialize map of maps
-    FillMap();
+    // SKUs are loaded into the map of maps the first time they are looked up
 }
 
 /*****************************************************************************/
@@ -61,6 +61,8 @@ Allowlist::~Allowlist()
 /*****************************************************************************/
 bool Allowlist::IsAllowlisted(const std::string deviceId, const std::string ssid)
 {
+    LoadSku(deviceId + ssid);
+
     std::map<std::string, std::map<std::string, TestParameters *>>::const_iterator outerIt
         = m_featureDb.find(deviceId + ssid);
     std::set<std::string>::const_iterator globalChangesIt = m_globalChanges.find(deviceId + ssid);
@@ -81,6 +83,7 @@ bool Allowlist::IsAllowlisted(const std::string deviceId, const std::string ssid
 void Allowlist::getDefaultsByDeviceId(const std::string &testName, const std::string &deviceId, TestParameters *tp)
 {
     int st;
+    LoadSku(deviceId);
     TestParameters *testDeviceTp = m_featureDb[deviceId][testName];
     bool requiresGlobalChanges   = m_globalChanges.find(deviceId) != m_globalChanges.end();
     if (testDeviceTp == nullptr)
@@ -154,6 +157,8 @@ void Allowlist::PostProcessAllowlist(std::vector<Gpu *> &gpus)
 
     double ratio = (double)minMemClockSeen / (double)TESLA_V100_BASE_SKU_MEM_CLOCK;
 
+    LoadSku(TESLA_V100_ID);
+
     double existingValue   = m_featureDb[TESLA_V100_ID][MEMBW_PLUGIN_NAME]->GetDouble(MEMBW_STR_MINIMUM_BANDWIDTH);
     double discountedValue = ratio * existingValue;
     m_featureDb[TESLA_V100_ID][MEMBW_PLUGIN_NAME]->SetDouble(MEMBW_STR_MINIMUM_BANDWIDTH, discountedValue);
@@ -175,87 +180,67 @@ static bool isBoolParam(const std::string &param)
 }
 
 /*****************************************************************************/
-void Allowlist::FillMap()
+void Allowlist::LoadSku(const std::string &id)
 {
-    std::string id;
-    TestParameters *tp;
-
-    auto skuMap = m_configFileParser.GetSkus();
+    if (!m_loadedSkus.insert(id).second)
+    {
+        return; /* Already loaded, or already known to be missing */
+    }
 
-    try
+    auto sku = m_configFileParser.GetSku(id);
+    if (!sku.has_value())
     {
-        for (auto pair : skuMap)
-        {
-            id       = pair.first;
-            auto sku = pair.second;
+        return;
+    }
+
+    DCGM_LOG_VERBOSE << "Filling diag config for SKU ID " << id;
 
-            DCGM_LOG_VERBOSE << "Filling diag config for SKU ID " << id;
+    auto &plugins = m_featureDb[id];
+
+    for (auto const &[pluginName, plugin] : *sku)
+    {
+        auto tp        = std::make_unique<TestParameters>();
+        bool isAllowed = true;
 
-            for (auto pluginIt = sku.begin(); pluginIt != sku.end(); pluginIt++)
+        for (auto const &[testName, param] : plugin.params)
+        {
+            /* Convert through YAML so values are read the same way whether they came from the compiled
+               SKU table or from a user-supplied config file */
+            YAML::Node const paramNode(param);
+            DCGM_LOG_VERBOSE << "SKU " << id << " plugin " << pluginName << " param " << testName
+                             << ". Scalar: " << param;
+            if (testName == "is_allowed")
+            {
+                isAllowed = paramNode.as<bool>();
+            }
+            else if (isBoolParam(testName))
             {
-                tp                           = new TestParameters();
-                const std::string pluginName = pluginIt->first.Scalar();
-                auto plugin                  = pluginIt->second;
-                bool isAllowed               = true;
-
-                for (auto testIt = plugin.begin(); testIt != plugin.end(); testIt++)
-                {
-                    const std::string testName = testIt->first.Scalar();
-                    auto paramOrSubtest        = testIt->second;
-                    DCGM_LOG_VERBOSE << "SKU " << id << " plugin " << pluginName << " param/subtest " << testName;
-                    if (paramOrSubtest.IsMap())
-                    {
-                        for (auto subtestIt = paramOrSubtest.begin(); subtestIt != paramOrSubtest.end(); subtestIt++)
-                        {
-                            const std::string subtestName = subtestIt->first.Scalar();
-                            auto subtestParam             = subtestIt->second;
-                            DCGM_LOG_VERBOSE << "Reading " << testName << "." << subtestName
-                                             << " as a double. Scalar: " << subtestParam.Scalar();
-                            tp->AddSubTestDouble(testName, subtestName, subtestParam.as<double>());
-                        }
-                    }
-                    else
-                    {
-                        if (testName == "is_allowed")
-                        {
-                            DCGM_LOG_VERBOSE << "Reading " << testName
-                                             << " as a bool. Scalar: " << paramOrSubtest.Scalar();
-                            isAllowed = paramOrSubtest.as<bool>();
-                        }
-                        else if (isBoolParam(testName))
-                        {
-                            DCGM_LOG_VERBOSE << "Reading " << testName
-                                             << " as a bool. Scalar: " << paramOrSubtest.Scalar();
-                            bool paramValue = paramOrSubtest.as<bool>();
-                            tp->AddString(testName, paramValue ? "True" : "False");
-                        }
-                        /* We used to have an if to handle the string parameters here in order to ensure correct
-                         * parsing. For now, the string parameters have been removed, but if we add some back then we'll
-                         * need to add this if statement again.
-                         *
-                         * else if (isStringParam(testName)) */
-                        else
-                        {
-                            DCGM_LOG_VERBOSE << "Reading " << testName
-                                             << " as a double. Scalar: " << paramOrSubtest.Scalar();
-                            tp->AddDouble(testName, paramOrSubtest.as<double>());
-                        }
-                    }
-                }
-                tp->AddString("is_allowed", isAllowed ? "True" : "False");
-                m_featureDb[id][pluginName] = tp;
-                tp                          = 0;
+                bool paramValue = paramNode.as<bool>();
+                tp->AddString(testName, paramValue ? "True" : "False");
+            }
+            /* We used to have an if to handle the string parameters here in order to ensure correct
+             * parsing. For now, the string parameters have been removed, but if we add some back then we'll
+             * need to add this if statement again.
+             *
+             * else if (isStringParam(testName)) */
+            else
+            {
+                tp->AddDouble(testName, paramNode.as<double>());
             }
         }
-    }
-    catch (const std::exception &e)
-    {
-        if (tp)
+
+        for (auto const &[testName, subtestParams] : plugin.subtests)
         {
-            delete tp;
-            tp = 0;
+            for (auto const &[subtestName, subtestParam] : subtestParams)
+            {
+                DCGM_LOG_VERBOSE << "Reading " << testName << "." << subtestName
+                                 << " as a double. Scalar: " << subtestParam;
+                tp->AddSubTestDouble(testName, subtestName, YAML::Node(subtestParam).as<double>());
+            }
         }
-        throw;
+
+        tp->AddString("is_allowed", isAllowed ? "True" : "False");
+        plugins[pluginName] = tp.release();
     }
 }
 
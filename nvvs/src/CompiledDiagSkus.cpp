@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CompiledDiagSkus.h"
+
+#include <algorithm>
+
+using namespace DcgmNs::Nvvs;
+
+/*****************************************************************************/
+std::string_view CompiledDiagSkus::GetVersion()
+{
+    return GetString(c_compiledDiagVersion);
+}
+
+/*****************************************************************************/
+std::string_view CompiledDiagSkus::GetSpec()
+{
+    return GetString(c_compiledDiagSpec);
+}
+
+/*****************************************************************************/
+bool CompiledDiagSkus::IsCompiledFrom(std::string_view yaml)
+{
+    if (yaml.size() != c_compiledDiagSourceSize)
+    {
+        return false;
+    }
+
+    /* 64-bit FNV-1a, the same as compile_diag_skus.py */
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : yaml)
+    {
+        hash = (hash ^ c) * 0x100000001b3ull;
+    }
+
+    return hash == c_compiledDiagSourceHash;
+}
+
+/*****************************************************************************/
+std::span<CompiledDiagSku const> CompiledDiagSkus::GetSkus()
+{
+    return { c_compiledDiagSkus, c_compiledDiagSkuCount };
+}
+
+/*****************************************************************************/
+CompiledDiagSku const *CompiledDiagSkus::FindSku(std::string_view id)
+{
+    auto skus = GetSkus();
+    auto it   = std::lower_bound(skus.begin(), skus.end(), id, [](CompiledDiagSku const &sku, std::string_view id) {
+        return GetString(sku.id) < id;
+    });
+
+    if (it == skus.end() || GetString(it->id) != id)
+    {
+        return nullptr;
+    }
+
+    return &*it;
+}
+
+/*****************************************************************************/
+std::span<CompiledDiagSkuParam const> CompiledDiagSkus::GetParams(CompiledDiagSku const &sku)
+{
+    return { c_compiledDiagSkuParams + sku.firstParam, sku.numParams };
+}
+
+/*****************************************************************************/
+std::string_view CompiledDiagSkus::GetString(std::uint32_t offset)
+{
+    if (offset == c_compiledDiagNoString)
+    {
+        return {};
+    }
+
+    return std::string_view(c_compiledDiagSkuStrings + offset);
+}
@@ -26,8 +26,8 @@
 #include <libgen.h>
 #include <unistd.h>
 
+#include "CompiledDiagSkus.h"
 #include "ConfigFileParser_v2.h"
-#include "FallbackDiagConfig.h"
 #include "ParsingUtility.h"
 
 using namespace DcgmNs::Nvvs;
@@ -185,8 +185,8 @@ bool FrameworkConfig::SetFrameworkConfigValue(nvvs_fwcfg_enum field, const std::
 }
 
 /*****************************************************************************/
-/* ctor saves off the input parameters to local copies/references and opens
- * the config file
+/* ctor saves off the input parameters to local copies/references. The SKU
+ * table is compiled into nvvs, so nothing is read from disk here
  */
 ConfigFileParser_v2::ConfigFileParser_v2(const std::string &configFile, const FrameworkConfig &fwcfg)
 {
@@ -196,60 +196,82 @@ ConfigFileParser_v2::ConfigFileParser_v2(const std::string &configFile, const Fr
     m_configFile = configFile; // initial configuration file
     m_fwcfg      = fwcfg;      // initial frameworkconfig object
 
-    // Read config from dcgm-config package
-
-    try
+    // The dcgm-config package installs its diag-skus.yaml next to nvvs
+    char execLocation[PATH_MAX] { 0 };
+    if (readlink("/proc/self/exe", execLocation, sizeof(execLocation) - 1) > 0)
     {
-        char execLocation[PATH_MAX] { 0 };
-        ssize_t ret = readlink("/proc/self/exe", execLocation, sizeof(execLocation) - 1);
-
-        if (ret < 0)
-        {
-            throw std::runtime_error("Could not find nvvs executable's directory");
-        }
-        const auto packageYamlLocation = std::filesystem::path(dirname(execLocation)) / c_configFileName;
-
-        DCGM_LOG_DEBUG << "Loading package YAML from " << packageYamlLocation.string();
-        m_fallbackYaml = YAML::LoadFile(packageYamlLocation);
-        DCGM_LOG_DEBUG << "Loaded package YAML";
-    }
-    catch (const std::exception &e)
-    {
-        DCGM_LOG_ERROR
-            << "Could not read package diag config. Please ensure the datacanter-gpu-manager-config package is installed";
-        DCGM_LOG_ERROR << "Exception: " << e.what();
-        m_fallbackYaml = YAML::Load(c_fallbackBakedDiagYaml);
+        m_packageConfigFile = (std::filesystem::path(dirname(execLocation)) / c_configFileName).string();
     }
 
-    // To aid debugging, the spec and version must be present in the fallback YAML
-    try
-    {
-        auto spec    = m_fallbackYaml["spec"].as<std::string>();
-        auto version = m_fallbackYaml["version"].as<std::string>();
-        DCGM_LOG_INFO << "Loaded packaged YAML with version: " << version << ", spec: " << spec;
-    }
-    catch (const YAML::Exception &e)
-    {
-        // Rethrow with a useful message
-        throw std::runtime_error("Packaged YAML did not contain version and/or spec");
-    }
+    // To aid debugging, log what the compiled SKU table was built from
+    DCGM_LOG_INFO << "Using compiled diag config with version: " << CompiledDiagSkus::GetVersion()
+                  << ", spec: " << CompiledDiagSkus::GetSpec() << ", " << CompiledDiagSkus::GetSkus().size()
+                  << " SKUs";
 }
 
 /*****************************************************************************/
-/* Close the stream if needed and initialize an fstream to the config file
- * setting YAML at the top level document
+/* Load the packaged config file if it isn't the one the SKU table was
+ * compiled from, and the user-supplied config file, if one was given
  */
 bool ConfigFileParser_v2::Init()
 {
+    LoadPackageConfig();
+
     if (!m_configFile.empty())
     {
         m_userYaml = YAML::LoadFile(m_configFile);
+        ParseYaml(m_userYaml, m_skus);
     }
 
-    ParseYaml();
     return true;
 }
 
+/*****************************************************************************/
+void ConfigFileParser_v2::LoadPackageConfig()
+{
+    m_usePackageSkus = false;
+    m_packageSkus.clear();
+
+    if (m_packageConfigFile.empty())
+    {
+        return;
+    }
+
+    std::ifstream packageFile(m_packageConfigFile, std::ios::binary);
+    if (!packageFile)
+    {
+        DCGM_LOG_DEBUG << "No packaged diag config at " << m_packageConfigFile;
+        return;
+    }
+
+    std::string const packageYaml { std::istreambuf_iterator<char>(packageFile), std::istreambuf_iterator<char>() };
+    if (CompiledDiagSkus::IsCompiledFrom(packageYaml))
+    {
+        DCGM_LOG_DEBUG << "Packaged diag config " << m_packageConfigFile << " matches the compiled SKU table";
+        return;
+    }
+
+    /* The package was updated without rebuilding nvvs, or the file was edited. Honor it like nvvs always has */
+    try
+    {
+        YAML::Node const packageConfig = YAML::Load(packageYaml);
+        ParseYaml(packageConfig, m_packageSkus);
+        m_usePackageSkus = true;
+
+        DCGM_LOG_INFO << "Packaged diag config " << m_packageConfigFile
+                      << " differs from the compiled SKU table and overrides it. Version: "
+                      << packageConfig["version"].as<std::string>("unknown")
+                      << ", spec: " << packageConfig["spec"].as<std::string>("unknown") << ", "
+                      << m_packageSkus.size() << " SKUs";
+    }
+    catch (const std::exception &e)
+    {
+        m_packageSkus.clear();
+        DCGM_LOG_ERROR << "Could not parse the packaged diag config " << m_packageConfigFile
+                       << ". Using the compiled SKU table. Exception: " << e.what();
+    }
+}
+
 /*****************************************************************************/
 static void parseSubTests(YAML::Node &dstTest, const YAML::Node srcTest)
 {
@@ -316,56 +338,126 @@ static void parseTests(YAML::Node &dstSku, const YAML::Node srcSku)
 }
 
 /*****************************************************************************/
-void ConfigFileParser_v2::ParseYaml()
+void ConfigFileParser_v2::ParseYaml(YAML::Node const &config, std::unordered_map<std::string, YAML::Node> &skus)
 {
-    for (auto srcConfig : { m_fallbackYaml, m_userYaml })
+    DCGM_LOG_DEBUG << "Parsing SKUs";
+
+    auto srcSkus = config["skus"];
+    if (!srcSkus.IsSequence())
     {
-        DCGM_LOG_DEBUG << "Parsing SKUs";
+        auto mark = srcSkus.Mark();
+        DCGM_LOG_ERROR << "skus is not a sequence; ignoring. Position: " << mark.line << "," << mark.column;
+        return;
+    }
 
-        auto srcSkus = srcConfig["skus"];
-        if (!srcSkus.IsSequence())
+    DCGM_LOG_DEBUG << "Going through SKUs";
+    for (auto srcSku : srcSkus)
+    {
+        std::string id;
+        DCGM_LOG_VERBOSE << "Checking SKU is a map";
+        if (!srcSku.IsMap())
         {
-            auto mark = srcSkus.Mark();
-            DCGM_LOG_ERROR << "skus is not a sequence; ignoring. Position: " << mark.line << "," << mark.column;
+            auto mark = srcSku.Mark();
+            // TODO Convert this to an exception
+            DCGM_LOG_ERROR << "sku is not a map; ignoring. Position: " << mark.line << "," << mark.column;
             continue;
         }
 
-        DCGM_LOG_DEBUG << "Going through SKUs";
-        for (auto srcSku : srcSkus)
+        try
         {
-            std::string id;
-            DCGM_LOG_VERBOSE << "Checking SKU is a map";
-            if (!srcSku.IsMap())
-            {
-                auto mark = srcSku.Mark();
-                // TODO Convert this to an exception
-                DCGM_LOG_ERROR << "sku is not a map; ignoring. Position: " << mark.line << "," << mark.column;
-                continue;
-            }
+            id = srcSku["id"].as<std::string>();
+            DCGM_LOG_VERBOSE << "Found SKU with ID " << id;
+        }
+        catch (const YAML::Exception &e)
+        {
+            DCGM_LOG_ERROR << "SKU ID could not be read. Ignoring";
+            continue;
+        }
 
-            try
+        YAML::Node &dstSku = skus[id];
+
+        DCGM_LOG_VERBOSE << "Descending to SKU's children";
+        parseTests(dstSku, srcSku);
+    }
+}
+
+/*****************************************************************************/
+/* Layer a SKU that ParseYaml() read on top of sku. ParseYaml() already checked its shape */
+static void layerYamlSku(YAML::Node const &yamlSku, DiagSku &sku)
+{
+    for (auto pluginIt = yamlSku.begin(); pluginIt != yamlSku.end(); ++pluginIt)
+    {
+        std::string const pluginName = pluginIt->first.Scalar();
+        if (pluginName == "name" || pluginName == "id")
+        {
+            continue;
+        }
+
+        DiagSkuPlugin &plugin = sku[pluginName];
+        for (auto paramIt = pluginIt->second.begin(); paramIt != pluginIt->second.end(); ++paramIt)
+        {
+            std::string const paramName = paramIt->first.Scalar();
+            if (paramIt->second.IsMap())
             {
-                id = srcSku["id"].as<std::string>();
-                DCGM_LOG_VERBOSE << "Found SKU with ID " << id;
+                for (auto subtestIt = paramIt->second.begin(); subtestIt != paramIt->second.end(); ++subtestIt)
+                {
+                    plugin.subtests[paramName][subtestIt->first.Scalar()] = subtestIt->second.Scalar();
+                }
             }
-            catch (const YAML::Exception &e)
+            else
             {
-                DCGM_LOG_ERROR << "SKU ID could not be read. Ignoring";
-                continue;
+                plugin.params[paramName] = paramIt->second.Scalar();
             }
-
-            YAML::Node &dstSku = GetOrAddSku(id);
-
-            DCGM_LOG_VERBOSE << "Descending to SKU's children";
-            parseTests(dstSku, srcSku);
         }
     }
 }
 
 /*****************************************************************************/
-const std::unordered_map<std::string, YAML::Node> &ConfigFileParser_v2::GetSkus() const
+std::optional<DiagSku> ConfigFileParser_v2::GetSku(const std::string &id) const
 {
-    return m_skus;
+    std::optional<DiagSku> sku;
+
+    if (m_usePackageSkus)
+    {
+        if (auto packageSkuIt = m_packageSkus.find(id); packageSkuIt != m_packageSkus.end())
+        {
+            sku.emplace();
+            layerYamlSku(packageSkuIt->second, *sku);
+        }
+    }
+    else if (auto const *compiledSku = CompiledDiagSkus::FindSku(id); compiledSku != nullptr)
+    {
+        sku.emplace();
+        for (auto const &param : CompiledDiagSkus::GetParams(*compiledSku))
+        {
+            DiagSkuPlugin &plugin = (*sku)[std::string(CompiledDiagSkus::GetString(param.plugin))];
+            std::string name(CompiledDiagSkus::GetString(param.name));
+            std::string value(CompiledDiagSkus::GetString(param.value));
+
+            if (param.subtest == c_compiledDiagNoString)
+            {
+                plugin.params[name] = value;
+            }
+            else
+            {
+                plugin.subtests[std::string(CompiledDiagSkus::GetString(param.subtest))][name] = value;
+            }
+        }
+    }
+
+    auto userSkuIt = m_skus.find(id);
+    if (userSkuIt == m_skus.end())
+    {
+        return sku;
+    }
+
+    if (!sku.has_value())
+    {
+        sku.emplace();
+    }
+
+    layerYamlSku(userSkuIt->second, *sku);
+    return sku;
 }
 
 /*****************************************************************************/
@@ -473,14 +565,3 @@ void ConfigFileParser_v2::legacyGlobalStructHelper()
     }
     nvvsCommon.requirePersistenceMode = fwcfg.requirePersistence;
 }
-
-/*****************************************************************************/
-/* Returns reference to m_skus[id]. Adds the SKU if it does not exist */
-YAML::Node &ConfigFileParser_v2::GetOrAddSku(const std::string &id)
-{
-    if (m_skus.find(id) == m_skus.end())
-    {
-        m_skus[id] = YAML::Node();
-    }
-    return m_skus[id];
-}
@@ -527,6 +527,193 @@ void CustomStatHolder::AddDiagStats(const std::vector<dcgmDiagCustomStats_t> &cu
     }
 }
 
+void CustomStatHolder::AddDiagStats(const std::vector<CustomStatRecord> &customStats)
+{
+    for (auto const &record : customStats)
+    {
+        switch (record.type)
+        {
+            case DCGM_CUSTOM_STAT_TYPE_GPU:
+            {
+                DcgmLockGuard lock(&m_gpuDataMutex);
+                auto &values = m_gpuData[record.gpuId][record.statName];
+                values.insert(values.end(), record.values.begin(), record.values.end());
+                break;
+            }
+
+            case DCGM_CUSTOM_STAT_TYPE_GROUPED:
+            {
+                DcgmLockGuard lock(&m_groupedDataMutex);
+                auto &values = m_groupedData[record.category][record.statName];
+                values.insert(values.end(), record.values.begin(), record.values.end());
+                break;
+            }
+
+            case DCGM_CUSTOM_STAT_TYPE_SINGLE:
+                // Same keys as AddSingleStatValues() so the stats JSON keeps its layout
+                InsertSingleData(record.category, record.statName, record.strValue);
+                break;
+
+            default:
+                DCGM_LOG_ERROR << "Found unsupported type " << record.type << " when trying to add stats.";
+                break;
+        }
+    }
+}
+
+dcgmReturn_t CustomStatHolder::StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData)
+{
+    DcgmLockGuard gpuDataLock(&m_gpuDataMutex);
+    DcgmLockGuard groupedDataLock(&m_groupedDataMutex);
+    DcgmLockGuard singleDataLock(&m_groupSingleDataMutex);
+
+    std::vector<dcgmDiagCustomStatValue_t> values;
+
+    // Values of a stat are sent in runs of the same type, which is normally the whole stat
+    auto streamValues = [&](dcgmDiagCustomStatChunk_t &chunk, std::vector<dcgmTimeseriesInfo_t> const &series) {
+        for (size_t start = 0; start < series.size();)
+        {
+            bool const isInt = series[start].isInt;
+            size_t end       = start;
+
+            values.clear();
+            for (; end < series.size() && series[end].isInt == isInt; end++)
+            {
+                dcgmDiagCustomStatValue_t value {};
+                value.timestamp = series[end].timestamp;
+                if (isInt)
+                {
+                    value.value.i = static_cast<long long>(series[end].val.i64);
+                }
+                else
+                {
+                    value.value.dbl = series[end].val.fp64;
+                }
+                values.push_back(value);
+            }
+
+            chunk.valueType = isInt ? DcgmPluginParamInt : DcgmPluginParamFloat;
+            chunk.numValues = static_cast<unsigned int>(values.size());
+            chunk.values    = values.data();
+            if (dcgmReturn_t ret = sink(&chunk, sinkData); ret != DCGM_ST_OK)
+            {
+                return ret;
+            }
+            start = end;
+        }
+        return DCGM_ST_OK;
+    };
+
+    for (auto const &[gpuId, stats] : m_gpuData)
+    {
+        for (auto const &[name, series] : stats)
+        {
+            dcgmDiagCustomStatChunk_t chunk {};
+            chunk.type     = DCGM_CUSTOM_STAT_TYPE_GPU;
+            chunk.gpuId    = gpuId;
+            chunk.statName = name.c_str();
+            if (dcgmReturn_t ret = streamValues(chunk, series); ret != DCGM_ST_OK)
+            {
+                return ret;
+            }
+        }
+    }
+
+    for (auto const &[groupName, stats] : m_groupedData)
+    {
+        for (auto const &[name, series] : stats)
+        {
+            dcgmDiagCustomStatChunk_t chunk {};
+            chunk.type     = DCGM_CUSTOM_STAT_TYPE_GROUPED;
+            chunk.statName = name.c_str();
+            chunk.category = groupName.c_str();
+            if (dcgmReturn_t ret = streamValues(chunk, series); ret != DCGM_ST_OK)
+            {
+                return ret;
+            }
+        }
+    }
+
+    // Same naming as PopulateSingleData(), so the diagnostic stores these exactly as it does the legacy ones
+    for (auto const &[category, stats] : m_groupSingleData)
+    {
+        for (auto const &[name, value] : stats)
+        {
+            dcgmDiagCustomStatChunk_t chunk {};
+            chunk.type      = DCGM_CUSTOM_STAT_TYPE_SINGLE;
+            chunk.statName  = name.c_str();
+            chunk.category  = category.c_str();
+            chunk.valueType = DcgmPluginParamString;
+            chunk.strValue  = value.c_str();
+            if (dcgmReturn_t ret = sink(&chunk, sinkData); ret != DCGM_ST_OK)
+            {
+                return ret;
+            }
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t CustomStatHolder::AppendChunk(std::vector<CustomStatRecord> &records,
+                                           const dcgmDiagCustomStatChunk_t &chunk)
+{
+    if (chunk.statName == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    CustomStatRecord record;
+    record.type     = chunk.type;
+    record.statName = chunk.statName;
+    record.category = chunk.category == nullptr ? "" : chunk.category;
+
+    switch (chunk.type)
+    {
+        case DCGM_CUSTOM_STAT_TYPE_GPU:
+        case DCGM_CUSTOM_STAT_TYPE_GROUPED:
+        {
+            bool const isInt = chunk.valueType == DcgmPluginParamInt;
+            if ((!isInt && chunk.valueType != DcgmPluginParamFloat) || (chunk.numValues > 0 && chunk.values == nullptr))
+            {
+                return DCGM_ST_BADPARAM;
+            }
+
+            record.gpuId = chunk.type == DCGM_CUSTOM_STAT_TYPE_GPU ? chunk.gpuId : 0;
+            record.values.resize(chunk.numValues);
+            for (unsigned int i = 0; i < chunk.numValues; i++)
+            {
+                dcgmTimeseriesInfo_t &data = record.values[i];
+                data.timestamp             = chunk.values[i].timestamp;
+                data.isInt                 = isInt;
+                if (isInt)
+                {
+                    data.val.i64 = static_cast<uint64_t>(chunk.values[i].value.i);
+                }
+                else
+                {
+                    data.val.fp64 = chunk.values[i].value.dbl;
+                }
+            }
+            break;
+        }
+
+        case DCGM_CUSTOM_STAT_TYPE_SINGLE:
+            if (chunk.valueType != DcgmPluginParamString || chunk.strValue == nullptr)
+            {
+                return DCGM_ST_BADPARAM;
+            }
+            record.strValue = chunk.strValue;
+            break;
+
+        default:
+            return DCGM_ST_BADPARAM;
+    }
+
+    records.push_back(std::move(record));
+    return DCGM_ST_OK;
+}
+
 void CustomStatHolder::AddCustomData(Json::Value &jv)
 {
     AddGpuDataToJson(jv);
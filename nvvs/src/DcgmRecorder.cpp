@@ -1104,7 +1104,7 @@ dcgmReturn_t DcgmRecorder::GetDeviceAttributes(unsigned int gpuId, dcgmDeviceAtt
     return m_dcgmSystem.GetDeviceAttributes(gpuId, attributes);
 }
 
-void DcgmRecorder::AddDiagStats(const std::vector<dcgmDiagCustomStats_t> &customStats)
+void DcgmRecorder::AddDiagStats(const std::vector<CustomStatRecord> &customStats)
 {
     m_customStatHolder.AddDiagStats(customStats);
 }
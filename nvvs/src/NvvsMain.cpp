@@ -16,12 +16,15 @@
 #include "JsonOutput.h"
 #include "NvidiaValidationSuite.h"
 #include "NvvsCommon.h"
+#include "NvvsWorker.h"
 #include "Plugin.h"
 #include <DcgmBuildInfo.hpp>
 #include <NvvsException.hpp>
+#include <NvvsWorkerProtocol.hpp>
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace
 {
@@ -85,7 +88,7 @@ void OutputMainError(const std::string &error, nvvsReturn_t errorCode = NVVS_ST_
 }
 
 /*****************************************************************************/
-int main(int argc, char **argv)
+static int RunNvvs(int argc, char **argv)
 {
     std::unique_ptr<NvidiaValidationSuite> nvvs;
 
@@ -128,3 +131,14 @@ int main(int argc, char **argv)
 
     return nvvsCommon.mainReturnCode;
 }
+
+/*****************************************************************************/
+int main(int argc, char **argv)
+{
+    if (argc > 1 && std::string_view(argv[1]) == NVVS_WORKER_ARG)
+    {
+        return RunNvvsWorker(argc, argv, RunNvvs);
+    }
+
+    return RunNvvs(argc, argv);
+}
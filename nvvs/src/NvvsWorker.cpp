@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "NvvsWorker.h"
+
+#include "NvvsCommon.h"
+#include "TestFramework.h"
+#include <NvvsWorkerProtocol.hpp>
+
+#include <array>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace DcgmNs::Nvvs::Worker;
+
+namespace
+{
+/* Requests are read from stdin and responses written to stdout */
+int const REQUEST_FD  = STDIN_FILENO;
+int const RESPONSE_FD = STDOUT_FILENO;
+
+/*****************************************************************************/
+/*
+ * Returns the major version of the Cuda driver, or 0 if it can't be determined.
+ * cuDriverGetVersion() doesn't need cuInit(), which must not be called before forking
+ */
+unsigned int GetCudaDriverMajorVersion()
+{
+    void *libcuda = dlopen("libcuda.so.1", RTLD_LAZY);
+    if (libcuda == nullptr)
+    {
+        return 0;
+    }
+
+    using cuDriverGetVersion_t = int (*)(int *);
+    auto cuDriverGetVersion    = reinterpret_cast<cuDriverGetVersion_t>(dlsym(libcuda, "cuDriverGetVersion"));
+
+    int version = 0;
+    if (cuDriverGetVersion == nullptr || cuDriverGetVersion(&version) != 0)
+    {
+        version = 0;
+    }
+
+    dlclose(libcuda);
+    return version / 1000;
+}
+
+/*****************************************************************************/
+/* Runs in the child forked for one request. Never returns */
+[[noreturn]] void RunRequest(std::vector<std::string> &args,
+                             pid_t workerPid,
+                             int stdoutFd,
+                             int stderrFd,
+                             int (*nvvsMain)(int, char **))
+{
+    /* Don't outlive the worker, which the diag module may kill at any time */
+    if (prctl(PR_SET_PDEATHSIG, SIGKILL) != 0 || getppid() != workerPid)
+    {
+        _exit(EXIT_FAILURE);
+    }
+    signal(SIGPIPE, SIG_DFL);
+
+    int devNull = open("/dev/null", O_RDONLY);
+    if (devNull < 0 || dup2(devNull, STDIN_FILENO) < 0 || dup2(stdoutFd, STDOUT_FILENO) < 0
+        || dup2(stderrFd, STDERR_FILENO) < 0)
+    {
+        _exit(EXIT_FAILURE);
+    }
+    close(devNull);
+    close(stdoutFd);
+    close(stderrFd);
+
+    std::vector<char *> argv;
+    argv.reserve(args.size() + 1);
+    for (auto &arg : args)
+    {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    std::exit(nvvsMain(static_cast<int>(args.size()), argv.data()));
+}
+
+/*****************************************************************************/
+/*
+ * Forward the output of a running request until both pipes are closed
+ *
+ * Returns false if the diag module went away
+ */
+bool ForwardOutput(int stdoutFd, int stderrFd)
+{
+    std::array<char, 16 * 1024> buff {};
+    std::array<pollfd, 2> fds { pollfd { stdoutFd, POLLIN, 0 }, pollfd { stderrFd, POLLIN, 0 } };
+    std::array<MessageType, 2> const types { MessageType::Stdout, MessageType::Stderr };
+    int pipesLeft = 2;
+
+    while (pipesLeft > 0)
+    {
+        if (poll(fds.data(), fds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+
+        for (size_t i = 0; i < fds.size(); i++)
+        {
+            if (fds[i].fd < 0 || fds[i].revents == 0)
+            {
+                continue;
+            }
+
+            ssize_t bytesRead = read(fds[i].fd, buff.data(), buff.size());
+            if (bytesRead < 0 && (errno == EINTR || errno == EAGAIN))
+            {
+                continue;
+            }
+            if (bytesRead <= 0)
+            {
+                /* A negative fd is ignored by poll() */
+                close(fds[i].fd);
+                fds[i].fd = -1;
+                pipesLeft--;
+                continue;
+            }
+            if (!WriteMessage(RESPONSE_FD, types[i], buff.data(), static_cast<std::uint32_t>(bytesRead)))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+/*
+ * Run one request and report its results
+ *
+ * Returns false if the worker can't continue
+ */
+bool ServeRequest(std::vector<std::string> &args, int (*nvvsMain)(int, char **))
+{
+    std::array<int, 2> stdoutPipe {};
+    std::array<int, 2> stderrPipe {};
+
+    if (args.empty() || pipe2(stdoutPipe.data(), O_CLOEXEC) != 0)
+    {
+        return false;
+    }
+    if (pipe2(stderrPipe.data(), O_CLOEXEC) != 0)
+    {
+        close(stdoutPipe[0]);
+        close(stdoutPipe[1]);
+        return false;
+    }
+
+    pid_t const workerPid = getpid();
+    pid_t pid             = fork();
+    if (pid == 0)
+    {
+        close(stdoutPipe[0]);
+        close(stderrPipe[0]);
+        RunRequest(args, workerPid, stdoutPipe[1], stderrPipe[1], nvvsMain);
+    }
+
+    close(stdoutPipe[1]);
+    close(stderrPipe[1]);
+
+    if (pid < 0)
+    {
+        close(stdoutPipe[0]);
+        close(stderrPipe[0]);
+        return false;
+    }
+
+    bool connected = WriteMessage(RESPONSE_FD, MessageType::Started, &pid, sizeof(pid))
+                     && ForwardOutput(stdoutPipe[0], stderrPipe[0]);
+    if (!connected)
+    {
+        /* Nobody is left to read the results */
+        kill(pid, SIGKILL);
+    }
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+        {
+            return false;
+        }
+    }
+
+    return connected && WriteMessage(RESPONSE_FD, MessageType::Exited, &status, sizeof(status));
+}
+} // namespace
+
+/*****************************************************************************/
+int RunNvvsWorker(int argc, char *argv[], int (*nvvsMain)(int, char **))
+{
+    for (int i = 2; i + 1 < argc; i++)
+    {
+        if (!strcmp(argv[i], "-p") || !strcmp(argv[i], "--pluginpath"))
+        {
+            nvvsCommon.pluginPath = argv[i + 1];
+        }
+    }
+
+    /* Output of each run is forwarded over the protocol. Anything else written by the worker is noise */
+    if (int devNull = open("/dev/null", O_WRONLY); devNull >= 0)
+    {
+        dup2(devNull, STDERR_FILENO);
+        close(devNull);
+    }
+
+    /* A write to a diag module that went away must fail rather than kill the worker */
+    signal(SIGPIPE, SIG_IGN);
+
+    TestFramework framework;
+    try
+    {
+        /* Best effort: a run that finds nothing preloaded just loads its plugins from disk */
+        framework.PreloadPlugins(GetCudaDriverMajorVersion());
+    }
+    catch (std::exception const &)
+    {}
+
+    if (!WriteMessage(RESPONSE_FD, MessageType::Ready, nullptr, 0))
+    {
+        return EXIT_FAILURE;
+    }
+
+    MessageType type;
+    std::string payload;
+    while (ReadMessage(REQUEST_FD, type, payload))
+    {
+        if (type != MessageType::Run)
+        {
+            return EXIT_FAILURE;
+        }
+
+        auto args = UnpackArgs(payload);
+        if (!ServeRequest(args, nvvsMain))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* The diag module closed our stdin */
+    return EXIT_SUCCESS;
+}
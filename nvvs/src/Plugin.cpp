@@ -405,6 +405,11 @@ void Plugin::PopulateCustomStats(dcgmDiagCustomStats_t &customStats)
     m_customStatHolder.PopulateCustomStats(customStats);
 }
 
+dcgmReturn_t Plugin::StreamCustomStats(dcgmDiagCustomStatsSink_f sink, void *sinkData)
+{
+    return m_customStatHolder.StreamCustomStats(sink, sinkData);
+}
+
 std::string Plugin::GetDisplayName()
 {
     return GetTestDisplayName(m_infoStruct.testIndex);
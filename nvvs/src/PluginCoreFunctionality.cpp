@@ -140,7 +140,7 @@ nvvsPluginResult_t PluginCoreFunctionality::CheckCommonErrors(TestParameters &tp
 dcgmReturn_t PluginCoreFunctionality::PluginEnded(const std::string &statsfile,
                                                   TestParameters &tp,
                                                   nvvsPluginResult_t result,
-                                                  std::vector<dcgmDiagCustomStats_t> &customStats)
+                                                  std::vector<CustomStatRecord> &customStats)
 {
     if (!m_initialized)
     {
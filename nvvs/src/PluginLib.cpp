@@ -17,6 +17,7 @@
 #include <NvvsCommon.h>
 #include <PluginLib.h>
 
+#include <algorithm>
 #include <dlfcn.h>
 
 
@@ -29,10 +30,12 @@ PluginLib::PluginLib()
     , m_initializeCB(nullptr)
     , m_runTestCB(nullptr)
     , m_retrieveStatsCB(nullptr)
+    , m_streamStatsCB(nullptr)
     , m_retrieveResultsCB(nullptr)
     , m_shutdownPluginCB(nullptr)
     , m_userData(nullptr)
     , m_pluginName()
+    , m_pluginInterfaceVersion(0)
     , m_customStats()
     , m_errors()
     , m_info()
@@ -54,11 +57,13 @@ PluginLib::PluginLib(PluginLib &&other) noexcept
     , m_initializeCB(other.m_initializeCB)
     , m_runTestCB(other.m_runTestCB)
     , m_retrieveStatsCB(other.m_retrieveStatsCB)
+    , m_streamStatsCB(other.m_streamStatsCB)
     , m_retrieveResultsCB(other.m_retrieveResultsCB)
     , m_shutdownPluginCB(other.m_shutdownPluginCB)
     , m_userData(other.m_userData)
     , m_pluginName(other.m_pluginName)
-    , m_customStats(other.m_customStats)
+    , m_pluginInterfaceVersion(other.m_pluginInterfaceVersion)
+    , m_customStats(std::move(other.m_customStats))
     , m_errors(other.m_errors)
     , m_info(other.m_info)
     , m_results(other.m_results)
@@ -74,6 +79,7 @@ PluginLib::PluginLib(PluginLib &&other) noexcept
     other.m_getPluginInterfaceVersionCB = nullptr;
     other.m_runTestCB                   = nullptr;
     other.m_retrieveStatsCB             = nullptr;
+    other.m_streamStatsCB               = nullptr;
     other.m_retrieveResultsCB           = nullptr;
     other.m_shutdownPluginCB            = nullptr;
     other.m_userData                    = nullptr;
@@ -91,10 +97,12 @@ PluginLib &PluginLib::operator=(PluginLib &&other) noexcept
         m_initializeCB                = other.m_initializeCB;
         m_runTestCB                   = other.m_runTestCB;
         m_retrieveStatsCB             = other.m_retrieveStatsCB;
+        m_streamStatsCB               = other.m_streamStatsCB;
         m_retrieveResultsCB           = other.m_retrieveResultsCB;
         m_shutdownPluginCB            = other.m_shutdownPluginCB;
         m_userData                    = other.m_userData;
         m_pluginName                  = other.m_pluginName;
+        m_pluginInterfaceVersion      = other.m_pluginInterfaceVersion;
         m_customStats                 = std::move(other.m_customStats);
         m_errors                      = std::move(other.m_errors);
         m_info                        = std::move(other.m_info);
@@ -109,6 +117,7 @@ PluginLib &PluginLib::operator=(PluginLib &&other) noexcept
         other.m_getPluginInterfaceVersionCB = nullptr;
         other.m_runTestCB                   = nullptr;
         other.m_retrieveStatsCB             = nullptr;
+        other.m_streamStatsCB               = nullptr;
         other.m_retrieveResultsCB           = nullptr;
         other.m_userData                    = nullptr;
     }
@@ -154,11 +163,9 @@ dcgmReturn_t PluginLib::LoadPlugin(const std::string &path, const std::string &n
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    m_retrieveStatsCB = (dcgmDiagRetrieveCustomStats_f)LoadFunction("RetrieveCustomStats");
-    if (m_retrieveStatsCB == nullptr)
-    {
-        return DCGM_ST_GENERIC_ERROR;
-    }
+    // Plugins only need one of these. Look them up without LoadFunction() so a missing one isn't logged
+    m_retrieveStatsCB = (dcgmDiagRetrieveCustomStats_f)dlsym(m_pluginPtr, "RetrieveCustomStats");
+    m_streamStatsCB   = (dcgmDiagStreamCustomStats_f)dlsym(m_pluginPtr, "StreamCustomStats");
 
     m_retrieveResultsCB = (dcgmDiagRetrieveResults_f)LoadFunction("RetrieveResults");
     if (m_retrieveResultsCB == nullptr)
@@ -174,7 +181,7 @@ dcgmReturn_t PluginLib::LoadPlugin(const std::string &path, const std::string &n
 
 
     if (m_getPluginInfoCB == nullptr || m_initializeCB == nullptr || m_runTestCB == nullptr
-        || m_retrieveStatsCB == nullptr || m_retrieveResultsCB == nullptr)
+        || (m_retrieveStatsCB == nullptr && m_streamStatsCB == nullptr) || m_retrieveResultsCB == nullptr)
     {
         DCGM_LOG_ERROR << "All of the required functions must be defined in the plugin";
         return DCGM_ST_GENERIC_ERROR;
@@ -191,7 +198,17 @@ dcgmReturn_t PluginLib::LoadPlugin(const std::string &path, const std::string &n
         pluginVersion = m_getPluginInterfaceVersionCB();
     }
 
-    if (pluginVersion != DCGM_DIAG_PLUGIN_INTERFACE_VERSION)
+    if (pluginVersion == DCGM_DIAG_PLUGIN_INTERFACE_VERSION_4)
+    {
+        // The only difference is StreamCustomStats(), which such plugins don't have
+        m_streamStatsCB = nullptr;
+        if (m_retrieveStatsCB == nullptr)
+        {
+            DCGM_LOG_ERROR << "Plugin " << name << " of version " << pluginVersion << " has no RetrieveCustomStats";
+            return DCGM_ST_GENERIC_ERROR;
+        }
+    }
+    else if (pluginVersion != DCGM_DIAG_PLUGIN_INTERFACE_VERSION)
     {
         DCGM_LOG_ERROR << "Unable to load plugin " << name << " shared library " << path << " due to version mismatch. "
                        << "Our version: " << DCGM_DIAG_PLUGIN_INTERFACE_VERSION << ". Plugin version: " << pluginVersion
@@ -199,6 +216,7 @@ dcgmReturn_t PluginLib::LoadPlugin(const std::string &path, const std::string &n
         return DCGM_ST_GENERIC_ERROR; /* Return a generic error so this isn't confused with an API version mismatch */
     }
 
+    m_pluginInterfaceVersion = pluginVersion;
     return DCGM_ST_OK;
 }
 
@@ -268,7 +286,7 @@ dcgmReturn_t PluginLib::GetPluginInfo()
 
     try
     {
-        ret = m_getPluginInfoCB(DCGM_DIAG_PLUGIN_INTERFACE_VERSION, &pluginInfo);
+        ret = m_getPluginInfoCB(m_pluginInterfaceVersion, &pluginInfo);
 
         if (ret == DCGM_ST_OK)
         {
@@ -469,13 +487,7 @@ void PluginLib::RunTest(unsigned int timeout, TestParameters *tp)
 
     try
     {
-        std::unique_ptr<dcgmDiagCustomStats_t> pCustomStats = std::make_unique<dcgmDiagCustomStats_t>();
-        dcgmDiagCustomStats_t &customStats                  = *pCustomStats;
-        do
-        {
-            m_retrieveStatsCB(&customStats, m_userData);
-            m_customStats.push_back(customStats);
-        } while (customStats.moreStats != 0);
+        RetrieveCustomStats();
     }
     catch (std::runtime_error &e)
     {
@@ -647,11 +659,107 @@ std::string PluginLib::GetFullLogFileName() const
 }
 
 /*****************************************************************************/
-const std::vector<dcgmDiagCustomStats_t> &PluginLib::GetCustomStats() const
+const std::vector<CustomStatRecord> &PluginLib::GetCustomStats() const
 {
     return m_customStats;
 }
 
+/*****************************************************************************/
+dcgmReturn_t PluginLib::ReceiveCustomStatChunk(const dcgmDiagCustomStatChunk_t *chunk, void *sinkData)
+{
+    if (chunk == nullptr || sinkData == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    auto *self       = static_cast<PluginLib *>(sinkData);
+    dcgmReturn_t ret = CustomStatHolder::AppendChunk(self->m_customStats, *chunk);
+    if (ret != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "Ignoring invalid custom stat '" << (chunk->statName == nullptr ? "" : chunk->statName)
+                       << "' from plugin " << self->m_pluginName;
+    }
+    return ret;
+}
+
+/*****************************************************************************/
+void PluginLib::RetrieveCustomStats()
+{
+    if (m_streamStatsCB != nullptr)
+    {
+        m_streamStatsCB(ReceiveCustomStatChunk, this, m_userData);
+        return;
+    }
+
+    /*
+     * Plugins of version 4 fill a fixed dcgmDiagCustomStats_t until they're out of stats.
+     * Each stat is turned into chunks, so only one staging buffer is ever alive
+     */
+    auto pCustomStats                  = std::make_unique<dcgmDiagCustomStats_t>();
+    dcgmDiagCustomStats_t &customStats = *pCustomStats;
+    std::vector<dcgmDiagCustomStatValue_t> values;
+
+    do
+    {
+        customStats.moreStats = 0;
+        customStats.numStats  = 0;
+        m_retrieveStatsCB(&customStats, m_userData);
+
+        for (unsigned int i = 0; i < std::min<unsigned int>(customStats.numStats, DCGM_DIAG_MAX_CUSTOM_STATS); i++)
+        {
+            dcgmDiagCustomStat_t &stat = customStats.stats[i];
+            // The plugin filled these, so make sure they're terminated
+            stat.statName[sizeof(stat.statName) - 1] = '\0';
+            stat.category[sizeof(stat.category) - 1] = '\0';
+
+            dcgmDiagCustomStatChunk_t chunk {};
+            chunk.type     = stat.type;
+            chunk.gpuId    = stat.gpuId;
+            chunk.statName = stat.statName;
+            chunk.category = stat.category;
+
+            if (stat.type == DCGM_CUSTOM_STAT_TYPE_SINGLE)
+            {
+                stat.values[0].value.str[sizeof(stat.values[0].value.str) - 1] = '\0';
+                chunk.valueType                                                 = DcgmPluginParamString;
+                chunk.strValue                                                  = stat.values[0].value.str;
+                ReceiveCustomStatChunk(&chunk, this);
+                continue;
+            }
+
+            // Values of one stat may mix ints and floats, so they're passed on in runs of the same type
+            unsigned int const numValues = std::min<unsigned int>(stat.numValues, DCGM_DIAG_MAX_VALUES);
+            for (unsigned int start = 0; start < numValues;)
+            {
+                dcgmPluginValue_t const valueType = stat.values[start].type;
+                unsigned int end                  = start;
+
+                values.clear();
+                for (; end < numValues && stat.values[end].type == valueType; end++)
+                {
+                    dcgmDiagCustomStatValue_t value {};
+                    value.timestamp = stat.values[end].timestamp;
+                    if (valueType == DcgmPluginParamInt)
+                    {
+                        value.value.i = stat.values[end].value.i;
+                    }
+                    else
+                    {
+                        value.value.dbl = stat.values[end].value.dbl;
+                    }
+                    values.push_back(value);
+                }
+
+                chunk.valueType = valueType;
+                chunk.numValues = static_cast<unsigned int>(values.size());
+                chunk.values    = values.data();
+                ReceiveCustomStatChunk(&chunk, this);
+                start = end;
+            }
+        }
+    } while (customStats.moreStats != 0);
+}
+
 /*****************************************************************************/
 const std::vector<dcgmDiagErrorDetail_v2> &PluginLib::GetErrors() const
 {
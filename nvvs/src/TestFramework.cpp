@@ -59,6 +59,7 @@ TestFramework::TestFramework()
     , testGroup()
     , dlList()
     , skipRest(false)
+    , m_numSoftwareRuns(0)
     , m_nvvsBinaryMode(0)
     , m_nvvsOwnerUid(0)
     , m_nvvsOwnerGid(0)
@@ -77,6 +78,7 @@ TestFramework::TestFramework(bool jsonOutput, GpuSet *gpuSet)
     , dlList()
     , m_output(0)
     , skipRest(false)
+    , m_numSoftwareRuns(0)
     , m_nvvsBinaryMode(0)
     , m_nvvsOwnerUid(0)
     , m_nvvsOwnerGid(0)
@@ -216,6 +218,18 @@ std::string TestFramework::GetPluginDirExtension() const
 
     log_debug("The following Cuda version will be used for plugins: {}.{}", cudaMajorVersion, cudaMinorVersion);
 
+    std::string extension = GetPluginDirExtension(cudaMajorVersion);
+    if (extension.empty())
+    {
+        log_error("Detected unsupported Cuda version: {}.{}", cudaMajorVersion, cudaMinorVersion);
+        throw std::runtime_error("Detected unsupported Cuda version");
+    }
+
+    return extension;
+}
+
+std::string TestFramework::GetPluginDirExtension(unsigned int cudaMajorVersion)
+{
     static const std::string CUDA_12_EXTENSION("/cuda12/");
     static const std::string CUDA_11_EXTENSION("/cuda11/");
     static const std::string CUDA_10_EXTENSION("/cuda10/");
@@ -229,12 +243,8 @@ std::string TestFramework::GetPluginDirExtension() const
         case 12:
             return CUDA_12_EXTENSION;
         default:
-            log_error("Detected unsupported Cuda version: {}.{}", cudaMajorVersion, cudaMinorVersion);
-            throw std::runtime_error("Detected unsupported Cuda version");
+            return "";
     }
-
-    // NOT-REACHED
-    return "";
 }
 
 std::string TestFramework::GetPluginDir()
@@ -242,7 +252,7 @@ std::string TestFramework::GetPluginDir()
     return GetPluginBaseDir() + GetPluginDirExtension();
 }
 
-void TestFramework::LoadLibrary(const char *libraryPath, const char *libraryName)
+bool TestFramework::IsSkippedLibrary(const char *libraryName) const
 {
     for (const auto &skipLibrary : m_skipLibraryList)
     {
@@ -250,9 +260,18 @@ void TestFramework::LoadLibrary(const char *libraryPath, const char *libraryName
         {
             DCGM_LOG_DEBUG << "Skipping library " << libraryName << " because it matches " << skipLibrary
                            << " in the skip list.";
-            return;
+            return true;
         }
     }
+    return false;
+}
+
+void TestFramework::LoadLibrary(const char *libraryPath, const char *libraryName)
+{
+    if (IsSkippedLibrary(libraryName))
+    {
+        return;
+    }
 
     if (!strncmp("libpluginCommon.so", libraryName, 18))
     {
@@ -422,6 +441,75 @@ void TestFramework::loadPlugins()
     }
 }
 
+/*****************************************************************************/
+unsigned int TestFramework::PreloadPlugins(unsigned int cudaMajorVersion)
+{
+    std::string extension = GetPluginDirExtension(cudaMajorVersion);
+    if (extension.empty())
+    {
+        log_debug("Not preloading plugins for unsupported Cuda version {}", cudaMajorVersion);
+        return 0;
+    }
+
+    char oldPath[2048]     = { 0 };
+    std::string pluginDir  = GetPluginBaseDir() + extension;
+    unsigned int numLoaded = 0;
+
+    if (getcwd(oldPath, sizeof(oldPath)) == 0 || chdir(pluginDir.c_str()))
+    {
+        log_error("Cannot preload plugins from '{}': '{}'", pluginDir, strerror(errno));
+        return 0;
+    }
+
+    /* Open the libraries the same way loadPlugins() does, so its dlopen() calls find them already mapped.
+       Nothing from the plugins is called here: they are only initialized by the process that runs them */
+    auto preload = [&](const char *libraryPath, const char *libraryName) {
+        if (IsSkippedLibrary(libraryName))
+        {
+            return;
+        }
+        void *dlib = dlopen(libraryPath, RTLD_LAZY);
+        if (dlib == nullptr)
+        {
+            std::string const dlopen_error = dlerror();
+            log_debug("Unable to preload plugin {}: {}", libraryName, dlopen_error);
+            return;
+        }
+        dlList.push_back(dlib);
+        numLoaded++;
+    };
+
+    preload("./libpluginCommon.so", "libpluginCommon.so");
+
+    DIR *dir = opendir(".");
+    if (dir != nullptr)
+    {
+        struct dirent *dirent = nullptr;
+        while ((dirent = readdir(dir)) != nullptr)
+        {
+            char *dot = strrchr(dirent->d_name, '.');
+            if (dot == nullptr || strcmp(dot, ".so") != 0 || !strcmp(dirent->d_name, "libpluginCommon.so"))
+            {
+                continue;
+            }
+
+            char buf[2048];
+            snprintf(buf, sizeof(buf), "./%s", dirent->d_name);
+
+            if (PluginPermissionsMatch(pluginDir, buf))
+            {
+                preload(buf, dirent->d_name);
+            }
+        }
+        closedir(dir);
+    }
+
+    chdir(oldPath);
+
+    log_debug("Preloaded {} libraries from {}", numLoaded, pluginDir);
+    return numLoaded;
+}
+
 /*****************************************************************************/
 void TestFramework::insertIntoTestGroup(std::string groupName, Test *testObject)
 {
@@ -657,6 +745,11 @@ void TestFramework::goList(Test::testClasses_enum classNum,
 {
     GetAndOutputHeader(classNum);
 
+    if (classNum == Test::NVVS_CLASS_SOFTWARE)
+    {
+        m_numSoftwareRuns++;
+    }
+
     // iterate through all tests giving them the GPU objects needed
     for (std::vector<Test *>::iterator testItr = testsList.begin(); testItr != testsList.end(); testItr++)
     {
@@ -701,6 +794,11 @@ void TestFramework::goList(Test::testClasses_enum classNum,
                 {
                     if (!nvvsCommon.requirePersistenceMode)
                         tp->AddString(SW_STR_REQUIRE_PERSISTENCE, "False");
+                    /* Host checks run as one batch per run. Outcomes left over from a run that was cut short
+                       by skipRest must not be served to the next one */
+                    tp->AddString(SW_STR_HOST_CHECK_BATCH,
+                                  std::to_string(nvvsCommon.currentIteration) + "."
+                                      + std::to_string(m_numSoftwareRuns));
                     if (name == "Denylist")
                         tp->AddString(SW_STR_DO_TEST, "denylist");
                     else if (name == "NVML Library")
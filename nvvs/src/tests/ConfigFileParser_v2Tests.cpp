@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 #include "DcgmDiagUnitTestCommon.h"
+#include <CompiledDiagSkus.h>
 #include <ConfigFileParser_v2.h>
 #include <catch2/catch.hpp>
+#include <fstream>
+#include <map>
 #include <unistd.h>
 #include <yaml-cpp/yaml.h>
 
@@ -230,3 +233,167 @@ SCENARIO("Load Default Config")
         CHECK(error == e.what());
     }
 }
+
+SCENARIO("Compiled diag SKUs match diag-skus.yaml")
+{
+    FrameworkConfig fc;
+    ConfigFileParser_v2 cfp("", fc);
+    // The same file the table was compiled from, so it must not change anything
+    cfp.setPackageConfigFile(DIAG_SKUS_YAML_PATH);
+    REQUIRE(cfp.Init());
+
+    YAML::Node yaml = YAML::LoadFile(DIAG_SKUS_YAML_PATH);
+    CHECK(CompiledDiagSkus::GetVersion() == yaml["version"].as<std::string>());
+    CHECK(CompiledDiagSkus::GetSpec() == yaml["spec"].as<std::string>());
+
+    // Build what ParseYaml() would have from the YAML, merging SKUs that are listed more than once
+    std::map<std::string, DiagSku> expected;
+    for (auto const &yamlSku : yaml["skus"])
+    {
+        DiagSku &sku = expected[yamlSku["id"].as<std::string>()];
+        for (auto pluginIt = yamlSku.begin(); pluginIt != yamlSku.end(); ++pluginIt)
+        {
+            std::string const pluginName = pluginIt->first.Scalar();
+            if (pluginName == "name" || pluginName == "id")
+            {
+                continue;
+            }
+
+            for (auto paramIt = pluginIt->second.begin(); paramIt != pluginIt->second.end(); ++paramIt)
+            {
+                if (paramIt->second.IsMap())
+                {
+                    for (auto subtestIt = paramIt->second.begin(); subtestIt != paramIt->second.end(); ++subtestIt)
+                    {
+                        sku[pluginName].subtests[paramIt->first.Scalar()][subtestIt->first.Scalar()]
+                            = subtestIt->second.Scalar();
+                    }
+                }
+                else
+                {
+                    sku[pluginName].params[paramIt->first.Scalar()] = paramIt->second.Scalar();
+                }
+            }
+        }
+    }
+
+    REQUIRE(CompiledDiagSkus::GetSkus().size() == expected.size());
+    for (auto const &[id, expectedSku] : expected)
+    {
+        INFO("SKU " << id);
+        auto sku = cfp.GetSku(id);
+        REQUIRE(sku.has_value());
+        CHECK(sku->size() == expectedSku.size());
+        for (auto const &[pluginName, expectedPlugin] : expectedSku)
+        {
+            INFO("Plugin " << pluginName);
+            REQUIRE(sku->contains(pluginName));
+            CHECK(sku->at(pluginName).params == expectedPlugin.params);
+            CHECK(sku->at(pluginName).subtests == expectedPlugin.subtests);
+        }
+    }
+
+    CHECK(!cfp.GetSku("0000").has_value());
+}
+
+SCENARIO("A user config file is layered on top of the compiled SKUs")
+{
+    std::string configFile = createTmpFile("diag-skus");
+    {
+        std::ofstream out(configFile);
+        out << "version: \"1\"\n"
+               "spec: dcgm-diag-v1\n"
+               "skus:\n"
+               "  - id: 102d\n"
+               "    sm_stress:\n"
+               "      target_stress: 1000.0\n"
+               "    memtest:\n"
+               "      test0:\n"
+               "        is_allowed: false\n"
+               "  - name: Not a real GPU\n"
+               "    id: ffff\n"
+               "    pcie:\n"
+               "      is_allowed: true\n";
+    }
+
+    FrameworkConfig fc;
+    ConfigFileParser_v2 cfp(configFile, fc);
+    REQUIRE(cfp.Init());
+
+    auto sku = cfp.GetSku("102d");
+    REQUIRE(sku.has_value());
+    // Overridden
+    CHECK(sku->at("sm_stress").params.at("target_stress") == "1000.0");
+    CHECK(sku->at("memtest").subtests.at("test0").at("is_allowed") == "false");
+    // Kept from the compiled table
+    CHECK(sku->at("sm_stress").params.at("use_dgemm") == "false");
+    CHECK(sku->at("targeted_power").params.at("target_power") == "148.0");
+
+    auto newSku = cfp.GetSku("ffff");
+    REQUIRE(newSku.has_value());
+    CHECK(newSku->size() == 1);
+    CHECK(newSku->at("pcie").params.at("is_allowed") == "true");
+
+    unlink(configFile.c_str());
+}
+
+SCENARIO("A packaged config file that differs from the compiled SKUs overrides them")
+{
+    std::ifstream compiledFrom(DIAG_SKUS_YAML_PATH, std::ios::binary);
+    std::string const compiledYaml { std::istreambuf_iterator<char>(compiledFrom), std::istreambuf_iterator<char>() };
+    CHECK(CompiledDiagSkus::IsCompiledFrom(compiledYaml));
+    CHECK(!CompiledDiagSkus::IsCompiledFrom(compiledYaml + "\n"));
+    CHECK(!CompiledDiagSkus::IsCompiledFrom(""));
+
+    std::string packageFile = createTmpFile("diag-skus-package");
+    std::string configFile  = createTmpFile("diag-skus");
+    {
+        std::ofstream out(packageFile);
+        out << "version: \"2\"\n"
+               "spec: dcgm-diag-v1\n"
+               "skus:\n"
+               "  - id: 102d\n"
+               "    sm_stress:\n"
+               "      target_stress: 1.0\n";
+    }
+    {
+        std::ofstream out(configFile);
+        out << "skus:\n"
+               "  - id: 102d\n"
+               "    pcie:\n"
+               "      is_allowed: true\n";
+    }
+
+    FrameworkConfig fc;
+    ConfigFileParser_v2 cfp(configFile, fc);
+    cfp.setPackageConfigFile(packageFile);
+    REQUIRE(cfp.Init());
+
+    // Only what the packaged file has, plus the user's config on top
+    auto sku = cfp.GetSku("102d");
+    REQUIRE(sku.has_value());
+    CHECK(sku->size() == 2);
+    CHECK(sku->at("sm_stress").params.size() == 1);
+    CHECK(sku->at("sm_stress").params.at("target_stress") == "1.0");
+    CHECK(sku->at("pcie").params.at("is_allowed") == "true");
+
+    // SKUs that are only in the compiled table are gone
+    REQUIRE(CompiledDiagSkus::GetSkus().size() > 1);
+    std::string const compiledOnlyId(CompiledDiagSkus::GetString(CompiledDiagSkus::GetSkus()[0].id) == "102d"
+                                         ? CompiledDiagSkus::GetString(CompiledDiagSkus::GetSkus()[1].id)
+                                         : CompiledDiagSkus::GetString(CompiledDiagSkus::GetSkus()[0].id));
+    CHECK(!cfp.GetSku(compiledOnlyId).has_value());
+
+    // A packaged file that can't be parsed leaves the compiled table in place
+    {
+        std::ofstream out(packageFile);
+        out << "skus: [\n";
+    }
+    ConfigFileParser_v2 brokenPackage("", fc);
+    brokenPackage.setPackageConfigFile(packageFile);
+    REQUIRE(brokenPackage.Init());
+    CHECK(brokenPackage.GetSku(compiledOnlyId).has_value());
+
+    unlink(packageFile.c_str());
+    unlink(configFile.c_str());
+}
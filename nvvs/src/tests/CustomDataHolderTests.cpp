@@ -181,3 +181,95 @@ TEST_CASE("CustomStatHolder : Storing Values and Outputting in structs / JSON")
         CHECK(jv[bridgemen][lost][i]["value"].asInt64() == i);
     }
 }
+
+dcgmReturn_t collect_custom_stat_chunk(const dcgmDiagCustomStatChunk_t *chunk, void *sinkData)
+{
+    auto &records = *static_cast<std::vector<CustomStatRecord> *>(sinkData);
+    return CustomStatHolder::AppendChunk(records, *chunk);
+}
+
+TEST_CASE("CustomStatHolder : Streaming Values")
+{
+    CustomStatHolder cdh;
+    std::vector<unsigned int> gpus;
+    gpus.push_back(0);
+    gpus.push_back(1);
+    cdh.InitGpus(gpus);
+
+    // More values than a dcgmDiagCustomStat_t holds, and some that don't fit in an int
+    long long const big = 1LL << 40;
+    for (long long i = 0; i < 400; i++)
+    {
+        cdh.SetGpuStat(1, breaths, big + i);
+        cdh.SetGpuStat(0, investiture, 0.25 * i);
+        cdh.SetGroupedStat(bridgemen, lost, i);
+    }
+    cdh.SetSingleGroupStat("0", lost, "kaladin");
+
+    std::vector<CustomStatRecord> records;
+    REQUIRE(cdh.StreamCustomStats(collect_custom_stat_chunk, &records) == DCGM_ST_OK);
+    CHECK(records.size() == 4);
+
+    CustomStatHolder holder;
+    holder.InitGpus(gpus);
+    holder.AddDiagStats(records);
+
+    std::vector<dcgmTimeseriesInfo_t> values = holder.GetCustomGpuStat(1, breaths);
+    REQUIRE(values.size() == 400);
+    CHECK(values[399].isInt);
+    CHECK(values[399].val.i64 == big + 399);
+    CHECK(holder.GetGroupedStat(bridgemen, lost).size() == 400);
+
+    // Single-value stats come out of the framework's holder the same way as through the legacy structs
+    std::vector<dcgmDiagCustomStats_t> statsList;
+    get_vector_from_custom_stats(cdh, statsList);
+    CustomStatHolder legacyHolder;
+    legacyHolder.InitGpus(gpus);
+    legacyHolder.AddDiagStats(statsList);
+
+    Json::Value legacy;
+    Json::Value streamed;
+    legacyHolder.AddCustomData(legacy);
+    holder.AddCustomData(streamed);
+    CHECK(streamed["0"][lost].asString() == "kaladin");
+    CHECK(legacy["0"] == streamed["0"]);
+    CHECK(legacy[GPUS][0][investiture] == streamed[GPUS][0][investiture]);
+
+    // Streaming doesn't consume the stats
+    records.clear();
+    REQUIRE(cdh.StreamCustomStats(collect_custom_stat_chunk, &records) == DCGM_ST_OK);
+    CHECK(records.size() == 4);
+}
+
+TEST_CASE("CustomStatHolder : Invalid Chunks")
+{
+    std::vector<CustomStatRecord> records;
+    dcgmDiagCustomStatValue_t value {};
+    dcgmDiagCustomStatChunk_t chunk {};
+    chunk.type      = DCGM_CUSTOM_STAT_TYPE_GPU;
+    chunk.statName  = breaths.c_str();
+    chunk.valueType = DcgmPluginParamInt;
+    chunk.numValues = 1;
+    chunk.values    = &value;
+    CHECK(CustomStatHolder::AppendChunk(records, chunk) == DCGM_ST_OK);
+
+    chunk.statName = nullptr;
+    CHECK(CustomStatHolder::AppendChunk(records, chunk) == DCGM_ST_BADPARAM);
+
+    chunk.statName = breaths.c_str();
+    chunk.values   = nullptr;
+    CHECK(CustomStatHolder::AppendChunk(records, chunk) == DCGM_ST_BADPARAM);
+
+    chunk.values    = &value;
+    chunk.valueType = DcgmPluginParamString;
+    CHECK(CustomStatHolder::AppendChunk(records, chunk) == DCGM_ST_BADPARAM);
+
+    // Single stats need their string
+    chunk.type = DCGM_CUSTOM_STAT_TYPE_SINGLE;
+    CHECK(CustomStatHolder::AppendChunk(records, chunk) == DCGM_ST_BADPARAM);
+
+    chunk.type = 7;
+    CHECK(CustomStatHolder::AppendChunk(records, chunk) == DCGM_ST_BADPARAM);
+
+    CHECK(records.size() == 1);
+}
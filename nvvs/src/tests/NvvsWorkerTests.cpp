@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <NvvsWorkerProtocol.hpp>
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace DcgmNs::Nvvs::Worker;
+
+TEST_CASE("NvvsWorker: Pack and unpack arguments")
+{
+    std::vector<std::string> args { "/usr/bin/nvvs", "-j", "", "--specifiedtest", "software" };
+    CHECK(UnpackArgs(PackArgs(args)) == args);
+
+    CHECK(UnpackArgs("").empty());
+    CHECK(UnpackArgs("nvvs") == std::vector<std::string> { "nvvs" });
+}
+
+TEST_CASE("NvvsWorker: Messages over a pipe")
+{
+    std::array<int, 2> fds {};
+    REQUIRE(pipe(fds.data()) == 0);
+
+    std::string const output(1000, 'x');
+    pid_t const pid = 1234;
+
+    CHECK(WriteMessage(fds[1], MessageType::Ready, nullptr, 0));
+    CHECK(WriteMessage(fds[1], MessageType::Started, &pid, sizeof(pid)));
+    CHECK(WriteMessage(fds[1], MessageType::Stdout, output));
+    // Payloads over MAX_PAYLOAD are refused and nothing is written
+    CHECK(!WriteMessage(fds[1], MessageType::Stderr, std::string(MAX_PAYLOAD + 1, 'y')));
+
+    MessageType type {};
+    std::string payload;
+
+    REQUIRE(ReadMessage(fds[0], type, payload));
+    CHECK(type == MessageType::Ready);
+    CHECK(payload.empty());
+
+    REQUIRE(ReadMessage(fds[0], type, payload));
+    CHECK(type == MessageType::Started);
+    REQUIRE(payload.size() == sizeof(pid));
+    CHECK(*reinterpret_cast<pid_t const *>(payload.data()) == pid);
+
+    REQUIRE(ReadMessage(fds[0], type, payload));
+    CHECK(type == MessageType::Stdout);
+    CHECK(payload == output);
+
+    // A message cut short by the writer going away is not a message
+    MessageHeader const header { MessageType::Stderr, 10 };
+    CHECK(WriteAll(fds[1], &header, sizeof(header)));
+    CHECK(WriteAll(fds[1], "abc", 3));
+    close(fds[1]);
+
+    CHECK(!ReadMessage(fds[0], type, payload));
+    CHECK(!ReadMessage(fds[0], type, payload));
+    close(fds[0]);
+}
@@ -52,6 +52,18 @@ TEST_CASE("PluginLib: General")
     nvvsPluginResult_t result = pl.GetResult();
     CHECK(result == NVVS_RESULT_PASS);
 
+    /* The test plugin only has RetrieveCustomStats(), whose stat is split by value type */
+    auto const &customStats = pl.GetCustomStats();
+    REQUIRE(customStats.size() == 2);
+    CHECK(customStats[0].statName == "fake_stat");
+    CHECK(customStats[0].gpuId == 1);
+    REQUIRE(customStats[0].values.size() == 1);
+    CHECK(customStats[0].values[0].isInt);
+    CHECK(customStats[0].values[0].val.i64 == 10);
+    REQUIRE(customStats[1].values.size() == 1);
+    CHECK(!customStats[1].values[0].isInt);
+    CHECK(customStats[1].values[0].val.fp64 == 2.5);
+
     setenv("result", "fail", 1);
     pl.RunTest(10, &tp);
     result = pl.GetResult();
@@ -22,9 +22,10 @@ unsigned int g_numGpus;
 
 extern "C" {
 
+/* Still at version 4 so the loading of older plugins is covered */
 unsigned int GetPluginInterfaceVersion(void)
 {
-    return DCGM_DIAG_PLUGIN_INTERFACE_VERSION;
+    return DCGM_DIAG_PLUGIN_INTERFACE_VERSION_4;
 }
 
 dcgmReturn_t GetPluginInfo(unsigned int pluginInterfaceVersion, dcgmDiagPluginInfo_t *info)
@@ -60,7 +61,23 @@ void RunTest(unsigned int timeout,
 {}
 
 void RetrieveCustomStats(dcgmDiagCustomStats_t *customStats, void *userData)
-{}
+{
+    /* One stat with an int and a float value, which the diag receives as two chunks */
+    dcgmDiagCustomStat_t &stat = customStats->stats[0];
+    snprintf(stat.statName, sizeof(stat.statName), "fake_stat");
+    stat.category[0]         = '\0';
+    stat.type                = DCGM_CUSTOM_STAT_TYPE_GPU;
+    stat.gpuId               = 1;
+    stat.numValues           = 2;
+    stat.values[0].type      = DcgmPluginParamInt;
+    stat.values[0].timestamp = 1;
+    stat.values[0].value.i   = 10;
+    stat.values[1].type      = DcgmPluginParamFloat;
+    stat.values[1].timestamp = 2;
+    stat.values[1].value.dbl = 2.5;
+    customStats->numStats    = 1;
+    customStats->moreStats   = 0;
+}
 
 void RetrieveResults(dcgmDiagResults_t *results, void *userData)
 {
@@ -4,8 +4,7 @@
 #include <stdlib.h> //malloc/free
 #include <string.h> //memset
 
-#define KV_DEFAULT_BLOCK_SIZE 1       /* Start with capacity for N subblocks */
-#define KV_DEFAULT_SUBBLOCK_SIZE 1024 /* Size of a subblock in bytes */
+#define KV_DEFAULT_BLOCK_SIZE 1 /* Start with capacity for N subblocks */
 
 /*****************************************************************************/
 /* Stubs for local functions */
@@ -14,6 +13,24 @@ static int keyedvector_grow_blocks(keyedvector_p kv, int newSize);
 static int keyedvector_delete_block_range(keyedvector_p kv, int startBlockIdx, int endBlockIdx);
 static void keyedvector_call_freeCB_range(keyedvector_p kv, kv_cursor_p startCursor, kv_cursor_p endCursor);
 
+/*****************************************************************************/
+static void *keyedvector_alloc_subblock(keyedvector_p kv)
+{
+    if (kv->allocator)
+        return kv->allocator->allocCB((size_t)kv->subBlockSize, kv->allocator->user);
+
+    return kv_malloc(kv->subBlockSize);
+}
+
+/*****************************************************************************/
+static void keyedvector_free_subblock(keyedvector_p kv, void *block)
+{
+    if (kv->allocator)
+        kv->allocator->freeCB(block, (size_t)kv->subBlockSize, kv->allocator->user);
+    else
+        kv_free(block);
+}
+
 /*****************************************************************************/
 keyedvector_p keyedvector_alloc(int elemSize,
                                 int subBlockSize,
@@ -22,6 +39,19 @@ keyedvector_p keyedvector_alloc(int elemSize,
                                 kv_free_f freeCB,
                                 void *user,
                                 int *errorSt)
+{
+    return keyedvector_alloc_with_allocator(elemSize, subBlockSize, compareCB, mergeCB, freeCB, user, NULL, errorSt);
+}
+
+/*****************************************************************************/
+keyedvector_p keyedvector_alloc_with_allocator(int elemSize,
+                                               int subBlockSize,
+                                               kv_compare_f compareCB,
+                                               kv_merge_f mergeCB,
+                                               kv_free_f freeCB,
+                                               void *user,
+                                               const kv_allocator_t *allocator,
+                                               int *errorSt)
 {
     int st;
     keyedvector_p kv = NULL;
@@ -47,6 +77,7 @@ keyedvector_p keyedvector_alloc(int elemSize,
     kv->mergeCB      = mergeCB;
     kv->freeCB       = freeCB;
     kv->user         = user;
+    kv->allocator    = allocator;
 
     if (subBlockSize < 0)
     {
@@ -86,7 +117,7 @@ keyedvector_p keyedvector_alloc(int elemSize,
     /* Allocate the first block as empty. It is the only block that's allowed
      * to be empty
      */
-    kv->blocks[0] = kv_malloc(kv->subBlockSize);
+    kv->blocks[0] = keyedvector_alloc_subblock(kv);
     if (!kv->blocks[0])
     {
         keyedvector_destroy(kv);
@@ -127,7 +158,7 @@ void keyedvector_destroy(keyedvector_p kv)
         {
             if (kv->blocks[i])
             {
-                kv_free(kv->blocks[i]);
+                keyedvector_free_subblock(kv, kv->blocks[i]);
                 kv->blocks[i] = 0;
             }
         }
@@ -553,7 +584,7 @@ int keyedvector_insert(keyedvector_p kv, void *element, kv_cursor_p cursor)
 
     kv->Nblocks++;
     kv->blockNelem[blockIndex + 1] = 0;
-    kv->blocks[blockIndex + 1]     = kv_malloc(kv->subBlockSize);
+    kv->blocks[blockIndex + 1]     = keyedvector_alloc_subblock(kv);
     if (!kv->blocks[blockIndex + 1])
         return KV_ST_MEMORY;
 
@@ -741,7 +772,7 @@ void keyedvector_empty(keyedvector_p kv)
     {
         if (kv->blocks[i])
         {
-            kv_free(kv->blocks[i]);
+            keyedvector_free_subblock(kv, kv->blocks[i]);
             kv->blocks[i] = NULL;
         }
         kv->blockNelem[i] = 0;
@@ -858,7 +889,7 @@ static int keyedvector_delete_block_range(keyedvector_p kv, int startBlockIdx, i
         }
         else
         {
-            kv_free(kv->blocks[blockIndex]);
+            keyedvector_free_subblock(kv, kv->blocks[blockIndex]);
             kv->blocks[blockIndex] = NULL;
         }
     }
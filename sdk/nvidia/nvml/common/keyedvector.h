@@ -8,6 +8,8 @@ Efficient key'd vector container that minimizes allocations and frees
 NOTE: This class is NOT thread safe. It is up to the caller to be thread safe 
 */
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -21,6 +23,9 @@ extern "C"
 #define kv_realloc realloc
 #endif //kv_malloc
 
+/* Size of a subblock in bytes when 0 is passed to keyedvector_alloc() */
+#define KV_DEFAULT_SUBBLOCK_SIZE 1024
+
 /* Status codes */
 #define KV_ST_OK 0        /* Success */
 #define KV_ST_BADPARAM -1 /* A bad parameter was passed to a function */
@@ -83,6 +88,22 @@ Callback function for comparing two elements. This should return:
 */
     typedef void (*kv_free_f)(void *elem, void *user);
 
+    /*****************************************************************************/
+    /* Optional allocator for the sub blocks of a keyed vector, which hold all of its
+   elements. Use this to place elements somewhere other than kv_malloc() puts them,
+   like a memory pool. The keyed vector's own bookkeeping still uses kv_malloc().
+
+   allocCB should return a block of size bytes or NULL if out of memory. freeCB
+   is passed the same size that the block was allocated with. The allocator must
+   outlive every keyed vector that uses it.
+*/
+    typedef struct kv_allocator_t
+    {
+        void *(*allocCB)(size_t size, void *user);
+        void (*freeCB)(void *block, size_t size, void *user);
+        void *user; /* User-supplied context pointer passed to allocCB and freeCB */
+    } kv_allocator_t, *kv_allocator_p;
+
 /*****************************************************************************/
 /* Operations for searching */
 #define KV_LGE_EQUAL 0      /* return nearest == key (or none) */
@@ -115,6 +136,8 @@ Callback function for comparing two elements. This should return:
         kv_compare_f compareCB;
         kv_merge_f mergeCB;
         kv_free_f freeCB; /* Optional element free callback. Can be null */
+
+        const kv_allocator_t *allocator; /* Optional sub block allocator. NULL=use kv_malloc() */
     } keyedvector_t, *keyedvector_p;
 
     /*************************************************************************/
@@ -143,6 +166,21 @@ Returns: Pointer to allocated keyedvector object
                                     void *user,
                                     int *errorSt);
 
+    /*************************************************************************/
+    /*
+Same as keyedvector_alloc(), but allocates sub blocks from allocator.
+
+allocator    IN: Sub block allocator. NULL=use kv_malloc() like keyedvector_alloc()
+*/
+    keyedvector_p keyedvector_alloc_with_allocator(int elemSize,
+                                                   int subBlockSize,
+                                                   kv_compare_f compareCB,
+                                                   kv_merge_f mergeCB,
+                                                   kv_free_f freeCB,
+                                                   void *user,
+                                                   const kv_allocator_t *allocator,
+                                                   int *errorSt);
+
     /*************************************************************************/
     /*
 Locate an element by searching for an element by matching key fields
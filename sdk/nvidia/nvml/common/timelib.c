@@ -35,6 +35,32 @@ timelib64_t resyncUsecSince1970 = 0;
 /* The following is the magic number for the windows file time of 1/1/1970 */
 timelib64_t jan1st1970HunNano = 116444736000000000LL;
 
+/* Clock to use instead of the system clock. NULL = system clock.
+   Only accessed atomically since it may be swapped while other threads read the clock */
+static timelib_clock_f clockOverride = NULL;
+
+#ifdef NV_UNIX
+#define TIMELIB_GET_CLOCK_OVERRIDE() __atomic_load_n(&clockOverride, __ATOMIC_ACQUIRE)
+#define TIMELIB_SET_CLOCK_OVERRIDE(clockFn) __atomic_store_n(&clockOverride, (clockFn), __ATOMIC_RELEASE)
+#else
+#define TIMELIB_GET_CLOCK_OVERRIDE() \
+    ((timelib_clock_f)InterlockedCompareExchangePointer((PVOID volatile *)&clockOverride, NULL, NULL))
+#define TIMELIB_SET_CLOCK_OVERRIDE(clockFn) \
+    InterlockedExchangePointer((PVOID volatile *)&clockOverride, (PVOID)(clockFn))
+#endif
+
+/*****************************************************************************/
+void timelib_setClockOverride(timelib_clock_f clockFn)
+{
+    TIMELIB_SET_CLOCK_OVERRIDE(clockFn);
+}
+
+/*****************************************************************************/
+timelib_clock_f timelib_getClockOverride(void)
+{
+    return TIMELIB_GET_CLOCK_OVERRIDE();
+}
+
 /*****************************************************************************/
 #ifndef NV_UNIX //Windows
 /*****************************************************************************/
@@ -89,6 +115,10 @@ timelib64_t timelib_usecSince1970(void)
     timelib64_t retTime              = 0;
     timelib64_t nowCycles;
     timelib64_t usecSinceResync;
+    timelib_clock_f clockFn = TIMELIB_GET_CLOCK_OVERRIDE();
+
+    if (clockFn)
+        return clockFn();
 
     if (!haveSynced)
     {
@@ -120,6 +150,10 @@ timelib64_t timelib_usecSince1970(void)
 {
     struct timeval timeVal;
     timelib64_t retTime;
+    timelib_clock_f clockFn = TIMELIB_GET_CLOCK_OVERRIDE();
+
+    if (clockFn)
+        return clockFn();
 
     gettimeofday(&timeVal, NULL);
 
@@ -35,12 +35,31 @@ extern "C"
     typedef __int64 timelib64_t;
     typedef unsigned int timelib32_t;
 
+    typedef timelib64_t (*timelib_clock_f)(void);
+
     /*****************************************************************************/
     timelib64_t timelib_usecSince1970(void);
     /*
 	Returns microseconds since 1970 as an int64
 */
 
+    /*****************************************************************************/
+    void timelib_setClockOverride(timelib_clock_f clockFn);
+    /*
+	Make timelib_usecSince1970() and everything based on it return clockFn()
+	instead of the system clock. Pass NULL to go back to the system clock.
+	This is meant for virtual clocks in tests and simulations. It can be
+	swapped while other threads read the clock, so clockFn must be safe to
+	call from any thread
+*/
+
+    /*****************************************************************************/
+    timelib_clock_f timelib_getClockOverride(void);
+    /*
+	Returns the clock passed to timelib_setClockOverride() or NULL if
+	timelib_usecSince1970() uses the system clock
+*/
+
     /*****************************************************************************/
     timelib32_t timelib_secSince1970(void);
     /*
@@ -40,7 +40,10 @@ static void timeseries_freeCB(timeseries_entry_p elem, timeseries_p ts)
     if (ts->tsType == TS_TYPE_STRING || ts->tsType == TS_TYPE_BLOB)
     {
         if (elem->val.ptr)
+        {
             free(elem->val.ptr);
+            ts->ptrBytes -= elem->val2.ptrSize;
+        }
         elem->val.ptr      = 0;
         elem->val2.ptrSize = 0;
     }
@@ -63,6 +66,12 @@ void timeseries_destroy(timeseries_p ts)
 
 /*****************************************************************************/
 timeseries_p timeseries_alloc(int tsType, int *errorSt)
+{
+    return timeseries_alloc_with_allocator(tsType, NULL, errorSt);
+}
+
+/*****************************************************************************/
+timeseries_p timeseries_alloc_with_allocator(int tsType, const kv_allocator_t *allocator, int *errorSt)
 {
     timeseries_p ts = 0;
     int kvErrorSt;
@@ -89,13 +98,14 @@ timeseries_p timeseries_alloc(int tsType, int *errorSt)
     ts->tsType = tsType;
 
     /* allocate the keyedvector */
-    ts->keyedVector = keyedvector_alloc(sizeof(timeseries_entry_t),
-                                        0,
-                                        (kv_compare_f)timeseries_compareCB,
-                                        (kv_merge_f)timeseries_mergeCB,
-                                        (kv_free_f)timeseries_freeCB,
-                                        ts,
-                                        &kvErrorSt);
+    ts->keyedVector = keyedvector_alloc_with_allocator(sizeof(timeseries_entry_t),
+                                                       0,
+                                                       (kv_compare_f)timeseries_compareCB,
+                                                       (kv_merge_f)timeseries_mergeCB,
+                                                       (kv_free_f)timeseries_freeCB,
+                                                       ts,
+                                                       allocator,
+                                                       &kvErrorSt);
     if (!ts->keyedVector)
     {
         PRINT_ERROR("%d", "Error %d from keyedvector_alloc\n", kvErrorSt);
@@ -130,7 +140,11 @@ static int timeseries_insert(timeseries_p ts, timeseries_entry_p entry)
     {
         insertSt = keyedvector_insert(ts->keyedVector, entry, &cursor);
         if (!insertSt)
+        {
+            if (ts->tsType == TS_TYPE_STRING || ts->tsType == TS_TYPE_BLOB)
+                ts->ptrBytes += entry->val2.ptrSize;
             return TS_ST_OK; /* Success */
+        }
         else if (insertSt != KV_ST_DUPLICATE)
         {
             PRINT_ERROR("%d %ld",
@@ -818,3 +832,105 @@ timeseries_entry_p timeseries_find(timeseries_p ts, timelib64_t time, int findOp
         cursor = &tempCursor;
     return (timeseries_entry_p)keyedvector_find_by_key(ts->keyedVector, &time, findOp, cursor);
 }
+
+/*****************************************************************************/
+int timeseries_find_range(timeseries_p ts, timelib64_t startTime, timelib64_t endTime, timeseries_range_p range)
+{
+    keyedvector_p kv;
+    timeseries_entry_p first, last;
+    int blockIndex;
+
+    if (!ts || !ts->keyedVector || !range)
+        return TS_ST_BADPARAM;
+
+    kv = ts->keyedVector;
+    memset(range, 0, sizeof(*range));
+
+    if (startTime)
+        first = timeseries_find(ts, startTime, TS_LGE_GREATEQUAL, &range->first);
+    else
+        first = timeseries_first(ts, &range->first);
+
+    if (endTime)
+        last = timeseries_find(ts, endTime, TS_LGE_LESSEQUAL, &range->last);
+    else
+        last = timeseries_last(ts, &range->last);
+
+    if (!first || !last || first->usecSince1970 > last->usecSince1970)
+        return TS_ST_OK; /* Nothing in the range */
+
+    /* Count whole blocks rather than entries */
+    if (range->first.blockIndex == range->last.blockIndex)
+    {
+        range->Nentries = range->last.subIndex - range->first.subIndex + 1;
+        return TS_ST_OK;
+    }
+
+    range->Nentries = kv->blockNelem[range->first.blockIndex] - range->first.subIndex;
+    for (blockIndex = range->first.blockIndex + 1; blockIndex < range->last.blockIndex; blockIndex++)
+    {
+        range->Nentries += kv->blockNelem[blockIndex];
+    }
+    range->Nentries += range->last.subIndex + 1;
+    return TS_ST_OK;
+}
+
+/*****************************************************************************/
+int timeseries_visit_range(timeseries_p ts,
+                           timeseries_range_p range,
+                           int descending,
+                           int maxEntries,
+                           timeseries_run_f runCB,
+                           void *user)
+{
+    keyedvector_p kv;
+    int blockIndex, step, endBlockIndex;
+    int firstSubIndex, lastSubIndex, Nrun, st;
+    int Nvisited = 0;
+
+    if (!ts || !ts->keyedVector || !range || !runCB || maxEntries < 0)
+        return TS_ST_BADPARAM;
+
+    if (range->Nentries < 1)
+        return 0;
+
+    kv = ts->keyedVector;
+
+    if (descending)
+    {
+        blockIndex    = range->last.blockIndex;
+        endBlockIndex = range->first.blockIndex - 1;
+        step          = -1;
+    }
+    else
+    {
+        blockIndex    = range->first.blockIndex;
+        endBlockIndex = range->last.blockIndex + 1;
+        step          = 1;
+    }
+
+    for (; blockIndex != endBlockIndex && Nvisited < maxEntries; blockIndex += step)
+    {
+        firstSubIndex = blockIndex == range->first.blockIndex ? range->first.subIndex : 0;
+        lastSubIndex  = blockIndex == range->last.blockIndex ? range->last.subIndex : kv->blockNelem[blockIndex] - 1;
+        Nrun          = lastSubIndex - firstSubIndex + 1;
+
+        /* Trim the run from whichever end the visit reaches last */
+        if (Nrun > maxEntries - Nvisited)
+        {
+            Nrun = maxEntries - Nvisited;
+            if (descending)
+                firstSubIndex = lastSubIndex - Nrun + 1;
+        }
+
+        st = runCB((timeseries_entry_p)((char *)kv->blocks[blockIndex] + (size_t)kv->elemSize * firstSubIndex),
+                   Nrun,
+                   user);
+        if (st)
+            return st;
+
+        Nvisited += Nrun;
+    }
+
+    return Nvisited;
+}
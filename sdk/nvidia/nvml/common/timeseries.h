@@ -64,6 +64,8 @@ extern "C"
         int tsType;                /* TS_TYPE_? #define of the type of value stored
                                   in keyedVector */
         keyedvector_p keyedVector; /* Data structure to hold the time series */
+        long long ptrBytes;        /* Bytes allocated for the values of TS_TYPE_STRING and
+                                  TS_TYPE_BLOB entries */
     } timeseries_t, *timeseries_p;
 
     /* Cursor into a timeseries enumeration. Note that these cursors are only
@@ -101,6 +103,16 @@ extern "C"
  */
     timeseries_p timeseries_alloc(int tsType, int *errorSt);
 
+    /*****************************************************************************/
+    /*
+ * Same as timeseries_alloc(), but stores the entries in blocks from allocator.
+ * See kv_allocator_t
+ *
+ * allocator IN: Block allocator. NULL=use the default heap like timeseries_alloc()
+ *
+ */
+    timeseries_p timeseries_alloc_with_allocator(int tsType, const kv_allocator_t *allocator, int *errorSt);
+
     /*****************************************************************************/
     /*
  * Destroy an allocated timeseries collection
@@ -352,6 +364,63 @@ Returns NULL if not found.
 */
     timeseries_entry_p timeseries_find(timeseries_p ts, timelib64_t time, int findOp, timeseries_cursor_p cursor);
 
+    /*************************************************************************/
+    /* Inclusive range of entries of a timeseries. See timeseries_find_range() */
+    typedef struct timeseries_range_t
+    {
+        timeseries_cursor_t first; /* Oldest entry in the range */
+        timeseries_cursor_t last;  /* Newest entry in the range */
+        int Nentries;              /* Number of entries in the range. 0 = the range is empty */
+    } timeseries_range_t, *timeseries_range_p;
+
+    /*************************************************************************/
+    /*
+ * Callback for timeseries_visit_range(). entries is a run of Nentries entries
+ * that are contiguous in memory, in ascending time order.
+ *
+ * Return 0 to keep visiting. A negative value stops the visit and is returned
+ * by timeseries_visit_range()
+ */
+    typedef int (*timeseries_run_f)(timeseries_entry_p entries, int Nentries, void *user);
+
+    /*************************************************************************/
+    /*
+Locate the entries with startTime <= usecSince1970 <= endTime. Both ends are
+found by binary search over the blocks of the timeseries, which is O(log N) in
+the size of the timeseries. Counting the entries in between is linear in the
+range, one step per block it spans.
+
+startTime IN: Oldest timestamp to include. 0 = from the first entry
+endTime   IN: Newest timestamp to include. 0 = through the last entry
+range    OUT: Boundaries and size of the range. Only valid until the
+              timeseries is modified
+
+Returns TS_ST_OK on success (including an empty range)
+        <0 TS_ST_? #define on error
+*/
+    int timeseries_find_range(timeseries_p ts, timelib64_t startTime, timelib64_t endTime, timeseries_range_p range);
+
+    /*************************************************************************/
+    /*
+Call runCB once per contiguous run of entries of range, so callers can copy
+whole runs rather than stepping a cursor one entry at a time.
+
+descending IN: 0 = visit runs oldest first. 1 = visit runs newest first. Entries
+               within a run are always in ascending order, so descending callers
+               should walk each run from its end
+maxEntries IN: Visit at most this many entries, counted from the start of the
+               visit. With descending, these are the newest entries of the range
+
+Returns >= 0 Number of entries visited
+        <0 TS_ST_? #define on error or the value runCB stopped the visit with
+*/
+    int timeseries_visit_range(timeseries_p ts,
+                               timeseries_range_p range,
+                               int descending,
+                               int maxEntries,
+                               timeseries_run_f runCB,
+                               void *user);
+
 #ifdef __cplusplus
 }
 #endif
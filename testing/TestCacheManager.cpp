@@ -16,15 +16,21 @@
 
 #include "TestCacheManager.h"
 #include "DcgmCacheManager.h"
+#include "DcgmCoreCommunication.h"
+#include "DcgmCoreProxy.h"
+#include "DcgmGroupManager.h"
 #include "DcgmTopology.hpp"
 #include "dcgm_fields.h"
 #include "dcgm_structs.h"
+#include <atomic>
 #include <bitset>
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <vector>
 
 
 /* No. of iterations corresponding to different sample set of vgpuIds */
@@ -1863,6 +1869,152 @@ CLEANUP:
     return retSt;
 }
 
+/*****************************************************************************/
+int TestCacheManager::TestWatcherViews(dcgmcm_decimation_t decimation)
+{
+    /* The decimation of new views is read from the environment when the cache manager is created */
+    setenv("__DCGM_WATCH_DECIMATION", decimation == DcgmcmDecimateFirst ? "first" : "last", 1);
+    std::unique_ptr<DcgmCacheManager> cacheManager = createCacheManager(1);
+    unsetenv("__DCGM_WATCH_DECIMATION");
+    if (nullptr == cacheManager)
+    {
+        return -1;
+    }
+
+    unsigned int gpuId = cacheManager->AddFakeGpu();
+    if (gpuId == DCGM_GPU_ID_BAD)
+    {
+        if (m_gpus.size() >= DCGM_MAX_NUM_DEVICES)
+        {
+            printf("Skipping TestWatcherViews() due to having no space for a fake GPU.\n");
+            return 0;
+        }
+
+        fprintf(stderr, "Unable to add fake GPU\n");
+        return -1;
+    }
+
+    unsigned short const fieldId = DCGM_FI_DEV_GPU_TEMP;
+    DcgmWatcher fastWatcher(DcgmWatcherTypeClient, 1);
+    DcgmWatcher slowWatcher(DcgmWatcherTypeClient, 2);
+    bool wereFirstWatcher = false;
+
+    /* The slow watcher is 10x slower than the watch, so it should get its own view */
+    dcgmReturn_t st = cacheManager->AddFieldWatch(
+        DCGM_FE_GPU, gpuId, fieldId, 100000, 3600.0, 0, fastWatcher, false, false, wereFirstWatcher);
+    if (st == DCGM_ST_OK)
+    {
+        st = cacheManager->AddFieldWatch(
+            DCGM_FE_GPU, gpuId, fieldId, 1000000, 3600.0, 0, slowWatcher, false, false, wereFirstWatcher);
+    }
+    if (st != DCGM_ST_OK)
+    {
+        fprintf(stderr, "AddFieldWatch returned %d\n", st);
+        return 1;
+    }
+
+    /* 5 seconds of samples at the fast rate, starting on a second boundary */
+    int const numSamples  = 50;
+    timelib64_t startTime = (timelib_usecSince1970() / 1000000 - 60) * 1000000;
+    std::vector<dcgmcm_sample_t> injected(numSamples);
+    for (int i = 0; i < numSamples; i++)
+    {
+        injected[i]           = {};
+        injected[i].timestamp = startTime + i * 100000;
+        injected[i].val.i64   = i;
+    }
+
+    st = cacheManager->InjectSamples(DCGM_FE_GPU, gpuId, fieldId, injected.data(), numSamples);
+    if (st != DCGM_ST_OK)
+    {
+        fprintf(stderr, "InjectSamples returned %d\n", st);
+        return 1;
+    }
+
+    dcgmcm_sample_t samples[100];
+    int Nsamples = 100;
+
+    /* The fast watcher and readers without a watcher see every sample */
+    st = cacheManager->GetSamples(
+        DCGM_FE_GPU, gpuId, fieldId, samples, &Nsamples, 0, 0, DCGM_ORDER_ASCENDING, nullptr, &fastWatcher);
+    if (st != DCGM_ST_OK || Nsamples != numSamples)
+    {
+        fprintf(stderr, "Fast watcher got st %d, %d samples. Expected %d\n", st, Nsamples, numSamples);
+        return 1;
+    }
+
+    /* The slow watcher sees one sample of each second. First emits a second's first sample as soon as it
+       arrives. Last emits a second's last sample once the next second starts, so the open one is missing */
+    bool const isFirst    = decimation == DcgmcmDecimateFirst;
+    int const numBuckets  = isFirst ? numSamples / 10 : numSamples / 10 - 1;
+    int const bucketIndex = isFirst ? 0 : 9;
+
+    Nsamples = 100;
+    st       = cacheManager->GetSamples(
+        DCGM_FE_GPU, gpuId, fieldId, samples, &Nsamples, 0, 0, DCGM_ORDER_ASCENDING, nullptr, &slowWatcher);
+    if (st != DCGM_ST_OK || Nsamples != numBuckets)
+    {
+        fprintf(stderr, "Slow watcher got st %d, %d samples. Expected %d\n", st, Nsamples, numBuckets);
+        return 1;
+    }
+
+    for (int i = 0; i < Nsamples; i++)
+    {
+        if (samples[i].val.i64 != i * 10 + bucketIndex
+            || samples[i].timestamp != startTime + i * 1000000 + bucketIndex * 100000)
+        {
+            fprintf(stderr,
+                    "Slow watcher sample %d was %lld at %lld\n",
+                    i,
+                    samples[i].val.i64,
+                    (long long)samples[i].timestamp);
+            return 1;
+        }
+    }
+
+    /* Once the fast watcher is gone, the slow watcher reads the shared samples again */
+    st = cacheManager->RemoveFieldWatch(DCGM_FE_GPU, gpuId, fieldId, 0, fastWatcher);
+    if (st != DCGM_ST_OK)
+    {
+        fprintf(stderr, "RemoveFieldWatch returned %d\n", st);
+        return 1;
+    }
+
+    Nsamples = 100;
+    st       = cacheManager->GetSamples(
+        DCGM_FE_GPU, gpuId, fieldId, samples, &Nsamples, 0, 0, DCGM_ORDER_ASCENDING, nullptr, &slowWatcher);
+    if (st != DCGM_ST_OK || Nsamples != numSamples)
+    {
+        fprintf(stderr, "Slow watcher alone got st %d, %d samples. Expected %d\n", st, Nsamples, numSamples);
+        return 1;
+    }
+
+    /* Views are trimmed along with the shared samples to stay within the cache memory budget. The
+       fast watcher comes back so that the slow watcher gets a view seeded from the shared samples */
+    st = cacheManager->AddFieldWatch(
+        DCGM_FE_GPU, gpuId, fieldId, 100000, 3600.0, 0, fastWatcher, false, false, wereFirstWatcher);
+    if (st == DCGM_ST_OK)
+    {
+        st = cacheManager->SetCacheMemoryBudget(1);
+    }
+    if (st != DCGM_ST_OK)
+    {
+        fprintf(stderr, "AddFieldWatch or SetCacheMemoryBudget returned %d\n", st);
+        return 1;
+    }
+
+    Nsamples = 100;
+    st       = cacheManager->GetSamples(
+        DCGM_FE_GPU, gpuId, fieldId, samples, &Nsamples, 0, 0, DCGM_ORDER_ASCENDING, nullptr, &slowWatcher);
+    if (st != DCGM_ST_OK || Nsamples != 1 || samples[0].val.i64 != (numBuckets - 1) * 10 + bucketIndex)
+    {
+        fprintf(stderr, "Slow watcher got st %d, %d samples over budget. Expected 1\n", st, Nsamples);
+        return 1;
+    }
+
+    return 0;
+}
+
 /*****************************************************************************/
 int TestCacheManager::TestCountBasedQuota()
 {
@@ -2023,6 +2175,513 @@ public:
     }
 };
 
+/*****************************************************************************/
+int TestCacheManager::TestLatestSamplePerf()
+{
+    std::unique_ptr<DcgmCacheManager> cacheManager = createCacheManager(1);
+    if (nullptr == cacheManager)
+    {
+        return -1;
+    }
+
+    unsigned int gpuId = cacheManager->AddFakeGpu();
+    if (gpuId == DCGM_GPU_ID_BAD)
+    {
+        if (m_gpus.size() >= DCGM_MAX_NUM_DEVICES)
+        {
+            printf("Skipping TestLatestSamplePerf() due to having no space for a fake GPU.\n");
+            return 0;
+        }
+
+        fprintf(stderr, "Unable to add fake GPU\n");
+        return -1;
+    }
+
+    std::vector<unsigned short> const fieldIds = { DCGM_FI_DEV_GPU_TEMP, DCGM_FI_DEV_POWER_USAGE };
+    DcgmWatcher watcher(DcgmWatcherTypeClient, DCGM_CONNECTION_ID_NONE);
+    bool wereFirstWatcher = false;
+
+    for (auto fieldId : fieldIds)
+    {
+        dcgmReturn_t st = cacheManager->AddFieldWatch(
+            DCGM_FE_GPU, gpuId, fieldId, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher);
+        if (st == DCGM_ST_OK)
+        {
+            st = (dcgmReturn_t)InjectSampleHelper(
+                cacheManager.get(), DcgmFieldGetById(fieldId), DCGM_FE_GPU, gpuId, timelib_usecSince1970());
+        }
+        if (st != DCGM_ST_OK)
+        {
+            fprintf(stderr, "Unable to watch and inject fieldId %u: %d\n", fieldId, st);
+            return 1;
+        }
+    }
+
+    /* Keep appending while the readers run so that they race with the append path */
+    std::atomic<bool> done { false };
+    std::atomic<long long> numInjected { 0 };
+    std::thread writer([&] {
+        while (!done.load(std::memory_order_relaxed))
+        {
+            for (auto fieldId : fieldIds)
+            {
+                InjectSampleHelper(
+                    cacheManager.get(), DcgmFieldGetById(fieldId), DCGM_FE_GPU, gpuId, timelib_usecSince1970());
+                numInjected++;
+            }
+        }
+    });
+
+    int const numReaders        = 4;
+    int const numReadsPerReader = 1000000;
+    std::atomic<int> numErrors { 0 };
+    std::vector<std::thread> readers;
+
+    timelib64_t startTime = timelib_usecSince1970();
+
+    for (int i = 0; i < numReaders; i++)
+    {
+        readers.emplace_back([&] {
+            dcgmcm_sample_t sample;
+            for (int j = 0; j < numReadsPerReader; j++)
+            {
+                if (cacheManager->GetLatestSample(DCGM_FE_GPU, gpuId, fieldIds[j % fieldIds.size()], &sample, nullptr)
+                    != DCGM_ST_OK)
+                {
+                    numErrors++;
+                }
+            }
+        });
+    }
+
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    timelib64_t endTime = timelib_usecSince1970();
+
+    done = true;
+    writer.join();
+
+    long long const numReads = (long long)numReaders * numReadsPerReader;
+    printf("TestLatestSamplePerf %lld GetLatestSample() on %d threads in %lld usec, %.1f nsec per read, "
+           "%lld samples appended meanwhile\n",
+           numReads,
+           numReaders,
+           (long long)(endTime - startTime),
+           1000.0 * (double)(endTime - startTime) / (double)numReads,
+           numInjected.load());
+
+    if (numErrors > 0)
+    {
+        fprintf(stderr, "%d GetLatestSample() calls failed\n", numErrors.load());
+        return 1;
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
+int TestCacheManager::TestGetSamplesPerf()
+{
+    std::unique_ptr<DcgmCacheManager> cacheManager = createCacheManager(1);
+    if (nullptr == cacheManager)
+    {
+        return -1;
+    }
+
+    unsigned int gpuId = cacheManager->AddFakeGpu();
+    if (gpuId == DCGM_GPU_ID_BAD)
+    {
+        if (m_gpus.size() >= DCGM_MAX_NUM_DEVICES)
+        {
+            printf("Skipping TestGetSamplesPerf() due to having no space for a fake GPU.\n");
+            return 0;
+        }
+
+        fprintf(stderr, "Unable to add fake GPU\n");
+        return -1;
+    }
+
+    unsigned short const fieldId = DCGM_FI_DEV_POWER_USAGE;
+    DcgmWatcher watcher(DcgmWatcherTypeClient, DCGM_CONNECTION_ID_NONE);
+    bool wereFirstWatcher = false;
+
+    dcgmReturn_t st = cacheManager->AddFieldWatch(
+        DCGM_FE_GPU, gpuId, fieldId, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher);
+    if (st != DCGM_ST_OK)
+    {
+        fprintf(stderr, "AddFieldWatch returned %d\n", st);
+        return 1;
+    }
+
+    /* One sample per msec, all of them recent enough to be kept */
+    int const numSamples      = 1000000;
+    int const injectBatchSize = 10000;
+    timelib64_t const firstTs = timelib_usecSince1970() - (timelib64_t)numSamples * 1000 - 1000000;
+    std::vector<dcgmcm_sample_t> batch(injectBatchSize);
+
+    for (int i = 0; i < numSamples; i += injectBatchSize)
+    {
+        for (int j = 0; j < injectBatchSize; j++)
+        {
+            batch[j]           = {};
+            batch[j].timestamp = firstTs + (timelib64_t)(i + j) * 1000;
+            batch[j].val.d     = i + j;
+        }
+        st = cacheManager->InjectSamples(DCGM_FE_GPU, gpuId, fieldId, batch.data(), injectBatchSize);
+        if (st != DCGM_ST_OK)
+        {
+            fprintf(stderr, "InjectSamples returned %d\n", st);
+            return 1;
+        }
+    }
+
+    int retSt = 0;
+
+    for (int windowSize : { 10000, 100000, 1000000 })
+    {
+        /* Take the window from the middle of the series where there's room for it */
+        int const firstIndex        = (numSamples - windowSize) / 2;
+        timelib64_t const startTime = firstTs + (timelib64_t)firstIndex * 1000;
+        timelib64_t const endTime   = startTime + (timelib64_t)(windowSize - 1) * 1000;
+
+        for (dcgmOrder_t order : { DCGM_ORDER_ASCENDING, DCGM_ORDER_DESCENDING })
+        {
+            DcgmFvBuffer fvBuffer;
+            int Msamples = windowSize;
+
+            timelib64_t t1 = timelib_usecSince1970();
+            st             = cacheManager->GetSamples(
+                DCGM_FE_GPU, gpuId, fieldId, nullptr, &Msamples, startTime, endTime, order, &fvBuffer);
+            timelib64_t diff = timelib_usecSince1970() - t1;
+
+            if (st != DCGM_ST_OK || Msamples != windowSize)
+            {
+                fprintf(stderr, "GetSamples of %d returned %d with %d samples\n", windowSize, st, Msamples);
+                retSt = 1;
+                continue;
+            }
+
+            /* Spot check that the window came back in the requested order */
+            dcgmBufferedFvCursor_t cursor = 0;
+            dcgmBufferedFv_t *fv          = fvBuffer.GetNextFv(&cursor);
+            double const expectedFirst = order == DCGM_ORDER_ASCENDING ? firstIndex : firstIndex + windowSize - 1;
+            if (fv == nullptr || fv->value.dbl != expectedFirst)
+            {
+                fprintf(stderr, "GetSamples of %d order %d started at the wrong sample\n", windowSize, (int)order);
+                retSt = 1;
+            }
+
+            printf("TestGetSamplesPerf %d samples %s in %lld usec, %.1f nsec per sample\n",
+                   windowSize,
+                   order == DCGM_ORDER_ASCENDING ? "ascending" : "descending",
+                   (long long)diff,
+                   1000.0 * (double)diff / (double)windowSize);
+        }
+    }
+
+    return retSt;
+}
+
+/*****************************************************************************/
+int TestCacheManager::TestCoreProxySamplesBatch()
+{
+    std::unique_ptr<DcgmCacheManager> cacheManager = createCacheManager(1);
+    if (nullptr == cacheManager)
+    {
+        return -1;
+    }
+
+    unsigned int gpuId = cacheManager->AddFakeGpu();
+    if (gpuId == DCGM_GPU_ID_BAD)
+    {
+        if (m_gpus.size() >= DCGM_MAX_NUM_DEVICES)
+        {
+            printf("Skipping TestCoreProxySamplesBatch() due to having no space for a fake GPU.\n");
+            return 0;
+        }
+
+        fprintf(stderr, "Unable to add fake GPU\n");
+        return -1;
+    }
+
+    std::vector<unsigned short> const fieldIds = { DCGM_FI_DEV_GPU_TEMP, DCGM_FI_DEV_POWER_USAGE };
+    DcgmWatcher watcher(DcgmWatcherTypeClient, DCGM_CONNECTION_ID_NONE);
+    bool wereFirstWatcher = false;
+    int const numSamples  = 10;
+    timelib64_t const now = timelib_usecSince1970();
+
+    for (auto fieldId : fieldIds)
+    {
+        dcgmReturn_t st = cacheManager->AddFieldWatch(
+            DCGM_FE_GPU, gpuId, fieldId, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher);
+        for (int i = 0; st == DCGM_ST_OK && i < numSamples; i++)
+        {
+            st = (dcgmReturn_t)InjectSampleHelper(
+                cacheManager.get(), DcgmFieldGetById(fieldId), DCGM_FE_GPU, gpuId, now - (numSamples - i) * 1000);
+        }
+        if (st != DCGM_ST_OK)
+        {
+            fprintf(stderr, "Unable to watch and inject fieldId %u: %d\n", fieldId, st);
+            return 1;
+        }
+    }
+
+    DcgmGroupManager groupManager { cacheManager.get() };
+    DcgmCoreCommunication communicator;
+    communicator.Init(cacheManager.get(), &groupManager);
+
+    dcgmCoreCallbacks_t coreCallbacks {};
+    coreCallbacks.version  = dcgmCoreCallbacks_version;
+    coreCallbacks.postfunc = PostRequestToCore;
+    coreCallbacks.poster   = &communicator;
+    DcgmCoreProxy coreProxy(coreCallbacks);
+
+    /* Every sample of each field, the latest of each, and a field that isn't watched */
+    std::vector<dcgmCoreGetSamplesParams_t> requests;
+    for (auto fieldId : fieldIds)
+    {
+        requests.push_back({ DCGM_FE_GPU, gpuId, fieldId, 0, 0, numSamples * 2, DCGM_ORDER_ASCENDING });
+        requests.push_back({ DCGM_FE_GPU, gpuId, fieldId, 0, 0, 1, DCGM_ORDER_DESCENDING });
+    }
+    requests.push_back({ DCGM_FE_GPU, gpuId, DCGM_FI_DEV_SM_CLOCK, 0, 0, 1, DCGM_ORDER_ASCENDING });
+
+    auto checkResults = [&](std::vector<DcgmCoreSamples> const &results) {
+        if (results.size() != requests.size())
+        {
+            fprintf(stderr, "Got %zu results for %zu requests\n", results.size(), requests.size());
+            return 1;
+        }
+        for (size_t i = 0; i + 1 < requests.size(); i += 2)
+        {
+            if (results[i].ret != DCGM_ST_OK || results[i].samples.size() != (size_t)numSamples
+                || results[i + 1].ret != DCGM_ST_OK || results[i + 1].samples.size() != 1
+                || results[i + 1].samples[0].timestamp != results[i].samples.back().timestamp)
+            {
+                fprintf(stderr, "Unexpected samples for fieldId %u\n", requests[i].fieldId);
+                return 1;
+            }
+        }
+        if (results.back().ret != DCGM_ST_NOT_WATCHED)
+        {
+            fprintf(stderr, "Expected DCGM_ST_NOT_WATCHED for an unwatched field. Got %d\n", results.back().ret);
+            return 1;
+        }
+        return 0;
+    };
+
+    std::vector<DcgmCoreSamples> results;
+    dcgmReturn_t st = coreProxy.GetSamplesBatch(requests, results);
+    if (st != DCGM_ST_OK)
+    {
+        fprintf(stderr, "GetSamplesBatch returned %d\n", st);
+        return 1;
+    }
+    if (checkResults(results) != 0)
+    {
+        return 1;
+    }
+
+    /* The async flavor gives the same answer without blocking this thread. Issue more batches than there are
+       workers so some of them queue up behind the others */
+    std::vector<std::shared_future<DcgmCoreSamplesBatch>> batchFutures;
+    for (int i = 0; i < DCGM_CORE_PROXY_ASYNC_WORKERS * 2; i++)
+    {
+        batchFutures.push_back(coreProxy.GetSamplesBatchAsync(requests));
+    }
+
+    for (auto const &batchFuture : batchFutures)
+    {
+        DcgmCoreSamplesBatch const &batch = batchFuture.get();
+        if (batch.ret != DCGM_ST_OK)
+        {
+            fprintf(stderr, "GetSamplesBatchAsync returned %d\n", batch.ret);
+            return 1;
+        }
+        if (checkResults(batch.results) != 0)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
+int TestCacheManager::TestWatchSetupPerf()
+{
+    std::unique_ptr<DcgmCacheManager> perPairCm = createCacheManager(1);
+    std::unique_ptr<DcgmCacheManager> bulkCm    = createCacheManager(1);
+    if (nullptr == perPairCm || nullptr == bulkCm)
+    {
+        return -1;
+    }
+
+    /* Same fake GPUs in both cache managers */
+    std::vector<dcgmGroupEntityPair_t> entities;
+    for (int i = 0; i < 8; i++)
+    {
+        unsigned int gpuId = perPairCm->AddFakeGpu();
+        if (gpuId == DCGM_GPU_ID_BAD || bulkCm->AddFakeGpu() != gpuId)
+        {
+            break;
+        }
+        entities.push_back({ DCGM_FE_GPU, gpuId });
+    }
+    if (entities.empty())
+    {
+        printf("Skipping TestWatchSetupPerf() due to having no space for a fake GPU.\n");
+        return 0;
+    }
+
+    std::vector<unsigned short> validFieldIds;
+    std::vector<unsigned short> fieldIds;
+    bulkCm->GetValidFieldIds(validFieldIds, false);
+    for (unsigned short fieldId : validFieldIds)
+    {
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+        if (fieldMeta != nullptr && fieldMeta->scope == DCGM_FS_DEVICE)
+        {
+            fieldIds.push_back(fieldId);
+        }
+    }
+
+    DcgmWatcher watcher(DcgmWatcherTypeClient, DCGM_CONNECTION_ID_NONE);
+    bool wereFirstWatcher = false;
+    dcgmReturn_t st;
+
+    timelib64_t t1 = timelib_usecSince1970();
+    for (auto const &entity : entities)
+    {
+        for (unsigned short fieldId : fieldIds)
+        {
+            st = perPairCm->AddFieldWatch(entity.entityGroupId,
+                                          entity.entityId,
+                                          fieldId,
+                                          1000000,
+                                          3600.0,
+                                          0,
+                                          watcher,
+                                          false,
+                                          false,
+                                          wereFirstWatcher);
+            if (st != DCGM_ST_OK)
+            {
+                fprintf(stderr, "AddFieldWatch of fieldId %u returned %d\n", fieldId, st);
+                return 1;
+            }
+        }
+    }
+    timelib64_t perPairUsec = timelib_usecSince1970() - t1;
+
+    t1 = timelib_usecSince1970();
+    st = bulkCm->AddFieldWatches(entities, fieldIds, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher);
+    timelib64_t bulkUsec = timelib_usecSince1970() - t1;
+    if (st != DCGM_ST_OK || !wereFirstWatcher)
+    {
+        fprintf(stderr, "AddFieldWatches returned %d, wereFirstWatcher %d\n", st, wereFirstWatcher);
+        return 1;
+    }
+
+    printf("Watch setup of %zu GPUs x %zu fields: per pair %lld usec, bulk %lld usec\n",
+           entities.size(),
+           fieldIds.size(),
+           (long long)perPairUsec,
+           (long long)bulkUsec);
+
+    dcgmcm_watch_info_t watchInfo;
+    for (auto const &entity : entities)
+    {
+        for (unsigned short fieldId : fieldIds)
+        {
+            st = bulkCm->GetEntityWatchInfoSnapshot(entity.entityGroupId, entity.entityId, fieldId, &watchInfo);
+            if (st != DCGM_ST_OK || !watchInfo.isWatched || watchInfo.watchers.size() != 1)
+            {
+                fprintf(stderr, "gpuId %u, fieldId %u was not watched by the bulk add\n", entity.entityId, fieldId);
+                return 1;
+            }
+        }
+    }
+
+    /* A bad field anywhere in the batch means nothing is watched */
+    std::unique_ptr<DcgmCacheManager> txnCm = createCacheManager(1);
+    unsigned int gpuId                      = txnCm->AddFakeGpu();
+    if (gpuId == DCGM_GPU_ID_BAD)
+    {
+        fprintf(stderr, "Unable to add fake GPU\n");
+        return 1;
+    }
+
+    std::vector<dcgmGroupEntityPair_t> txnEntities = { { DCGM_FE_GPU, gpuId } };
+    std::vector<unsigned short> txnFieldIds        = { DCGM_FI_DEV_GPU_TEMP, DCGM_FI_DEV_POWER_USAGE };
+    for (unsigned short fieldId = 1; fieldId < DCGM_FI_MAX_FIELDS; fieldId++)
+    {
+        if (DcgmFieldGetById(fieldId) == nullptr)
+        {
+            txnFieldIds.push_back(fieldId);
+            break;
+        }
+    }
+
+    st = txnCm->AddFieldWatches(txnEntities, txnFieldIds, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher);
+    if (st != DCGM_ST_UNKNOWN_FIELD)
+    {
+        fprintf(stderr, "AddFieldWatches with an unknown field returned %d\n", st);
+        return 1;
+    }
+
+    for (size_t i = 0; i + 1 < txnFieldIds.size(); i++)
+    {
+        st = txnCm->GetEntityWatchInfoSnapshot(DCGM_FE_GPU, gpuId, txnFieldIds[i], &watchInfo);
+        if (st == DCGM_ST_OK && watchInfo.isWatched)
+        {
+            fprintf(stderr, "fieldId %u was watched by a failed AddFieldWatches\n", txnFieldIds[i]);
+            return 1;
+        }
+    }
+
+    /* A pre-watch failing mid-batch undoes the pre-watches before it and leaves no watch infos behind. GPU
+       ids past the last GPU fail their pre-watch */
+    txnFieldIds.pop_back();
+    txnEntities.push_back({ DCGM_FE_GPU, gpuId + 1 });
+    st = txnCm->AddFieldWatches(txnEntities, txnFieldIds, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher);
+    if (st == DCGM_ST_OK)
+    {
+        fprintf(stderr, "AddFieldWatches with a missing GPU succeeded\n");
+        return 1;
+    }
+
+    for (auto const &entity : txnEntities)
+    {
+        for (unsigned short fieldId : txnFieldIds)
+        {
+            st = txnCm->GetEntityWatchInfoSnapshot(entity.entityGroupId, entity.entityId, fieldId, &watchInfo);
+            if (st != DCGM_ST_NOT_WATCHED)
+            {
+                fprintf(stderr,
+                        "gpuId %u, fieldId %u has a watch info after a failed AddFieldWatches\n",
+                        entity.entityId,
+                        fieldId);
+                return 1;
+            }
+        }
+    }
+
+    /* Nothing was left half-watched, so the good GPU alone can still be watched from scratch */
+    txnEntities.pop_back();
+    st = txnCm->AddFieldWatches(txnEntities, txnFieldIds, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher);
+    if (st != DCGM_ST_OK || !wereFirstWatcher)
+    {
+        fprintf(
+            stderr, "AddFieldWatches after a failed batch returned %d, wereFirstWatcher %d\n", st, wereFirstWatcher);
+        return 1;
+    }
+
+    return 0;
+}
+
 /*****************************************************************************/
 int TestCacheManager::TestTimedModeAwakeTime()
 {
@@ -2651,6 +3310,10 @@ int TestCacheManager::Run()
     try
     {
         CompleteTest("TestUpdatePerf", TestUpdatePerf(), Nfailed);
+        CompleteTest("TestLatestSamplePerf", TestLatestSamplePerf(), Nfailed);
+        CompleteTest("TestGetSamplesPerf", TestGetSamplesPerf(), Nfailed);
+        CompleteTest("TestCoreProxySamplesBatch", TestCoreProxySamplesBatch(), Nfailed);
+        CompleteTest("TestWatchSetupPerf", TestWatchSetupPerf(), Nfailed);
         CompleteTest("TestLockstepModeAwakeTime", TestLockstepModeAwakeTime(), Nfailed);
         CompleteTest("TestTimedModeAwakeTime", TestTimedModeAwakeTime(), Nfailed);
         CompleteTest("TestWatchesVisited", TestWatchesVisited(), Nfailed);
@@ -2662,6 +3325,8 @@ int TestCacheManager::Run()
         CompleteTest("TestRecordTiming", TestRecordTiming(), Nfailed);
         CompleteTest("TestTimeBasedQuota", TestTimeBasedQuota(), Nfailed);
         CompleteTest("TestCountBasedQuota", TestCountBasedQuota(), Nfailed);
+        CompleteTest("TestWatcherViewsLast", TestWatcherViews(DcgmcmDecimateLast), Nfailed);
+        CompleteTest("TestWatcherViewsFirst", TestWatcherViews(DcgmcmDecimateFirst), Nfailed);
         CompleteTest("TestRecordingGlobal", TestRecordingGlobal(), Nfailed);
         CompleteTest("TestFieldValueConversion", TestFieldValueConversion(), Nfailed);
         CompleteTest("TestConvertVectorToBitmask", TestConvertVectorToBitmask(), Nfailed);
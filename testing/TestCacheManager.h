@@ -56,6 +56,7 @@ private:
     int TestRecordTiming();
     int TestTimeBasedQuota();
     int TestCountBasedQuota();
+    int TestWatcherViews(dcgmcm_decimation_t decimation);
     int TestSummary();
     int TestWatchedFieldsIteration();
     int TestWatchedFieldsIterationGpu();
@@ -63,6 +64,10 @@ private:
     int TestTimedModeAwakeTime();
     int TestLockstepModeAwakeTime();
     int TestUpdatePerf();
+    int TestLatestSamplePerf();
+    int TestGetSamplesPerf();
+    int TestCoreProxySamplesBatch();
+    int TestWatchSetupPerf();
     int TestWatchesVisited();
     int TestFieldValueConversion();
     int TestConvertVectorToBitmask();
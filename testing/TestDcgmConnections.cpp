@@ -23,10 +23,13 @@
 #include <cassert>
 #include <iostream>
 #include <memory>
+#include <netinet/in.h>
 #include <stdexcept>
 #include <string>
 #include <sys/socket.h>
 #include <unistd.h>
+#include <unordered_set>
+#include <vector>
 
 /*****************************************************************************/
 TestDcgmConnections::TestDcgmConnections()
@@ -228,6 +231,213 @@ int TestDcgmConnections::TestIpcSocketPair(void)
     return 0;
 }
 
+/*****************************************************************************/
+/* State shared by the callbacks of TestIpcReactorScaling. One DcgmIpc instance
+   both listens and connects to itself, so every message is framed twice (once
+   on each end) by whichever reactors own the two connections */
+struct TestIpcReactorBench_t
+{
+    DcgmIpc *dcgmIpc = nullptr;                         /* Instance to send replies through */
+    std::unordered_set<dcgm_connection_id_t> clientIds; /* Connections we initiated. Read-only once
+                                                           messages are flowing */
+    std::atomic_bool stop              = false;
+    std::atomic_uint64_t numRoundTrips = 0;
+};
+
+static void TirbProcessMessage(dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message, void *userData)
+{
+    TestIpcReactorBench_t *bench = (TestIpcReactorBench_t *)userData;
+
+    if (bench->clientIds.count(connectionId) == 0)
+    {
+        /* Server side. Echo the message back */
+        bench->dcgmIpc->SendMessage(connectionId, std::move(message), false);
+        return;
+    }
+
+    bench->numRoundTrips++;
+
+    if (!bench->stop)
+    {
+        bench->dcgmIpc->SendMessage(connectionId, std::move(message), false);
+    }
+}
+
+static void TirbProcessDisconnect(dcgm_connection_id_t /* connectionId */, void * /* userData */)
+{}
+
+/*****************************************************************************/
+/* Get a loopback TCP port that nothing listens on right now, or -1 on error */
+static int GetFreeTcpPort()
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    struct sockaddr_in addr = {};
+    socklen_t addrLen       = sizeof(addr);
+    addr.sin_family         = AF_INET;
+    addr.sin_addr.s_addr    = htonl(INADDR_LOOPBACK);
+    addr.sin_port           = 0; /* Let the kernel pick one */
+
+    int port = -1;
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0
+        && getsockname(fd, (struct sockaddr *)&addr, &addrLen) == 0)
+    {
+        port = ntohs(addr.sin_port);
+    }
+
+    close(fd);
+    return port;
+}
+
+/*****************************************************************************/
+static int RunIpcReactorBench(bool useTcp, unsigned int numReactors, double &roundTripsPerSec)
+{
+    const unsigned int numConnections = 64;   /* Client connections to open */
+    const unsigned int numInFlight    = 4;    /* Messages in flight per connection */
+    const unsigned int payloadSize    = 1024; /* Bytes per message body */
+    const unsigned int durationMs     = 250;  /* Short so this stays a smoke test. Raise it to benchmark */
+    const int tcpPort                 = useTcp ? GetFreeTcpPort() : 0;
+    const std::string domainPath      = "/tmp/dcgm_test_ipc_reactors.sock";
+
+    if (tcpPort < 0)
+    {
+        std::cerr << "Unable to find a free TCP port\n";
+        return 50;
+    }
+
+    TestIpcReactorBench_t bench;
+    DcgmIpc dcgmIpc(8, numReactors);
+
+    bench.dcgmIpc = &dcgmIpc;
+
+    std::optional<DcgmIpcTcpServerParams_t> tcpParams;
+    std::optional<DcgmIpcDomainServerParams_t> domainParams;
+
+    if (useTcp)
+    {
+        tcpParams = DcgmIpcTcpServerParams_t { "127.0.0.1", tcpPort };
+    }
+    else
+    {
+        domainParams = DcgmIpcDomainServerParams_t { domainPath };
+    }
+
+    dcgmReturn_t dcgmReturn
+        = dcgmIpc.Init(tcpParams, domainParams, TirbProcessMessage, &bench, TirbProcessDisconnect, &bench);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        std::cerr << "Got " << dcgmReturn << " from dcgmIpc.Init()\n";
+        return 100;
+    }
+
+    std::vector<dcgm_connection_id_t> clientIds;
+
+    for (unsigned int i = 0; i < numConnections; i++)
+    {
+        dcgm_connection_id_t connectionId;
+
+        if (useTcp)
+        {
+            dcgmReturn = dcgmIpc.ConnectTcp("127.0.0.1", tcpPort, connectionId, 5000);
+        }
+        else
+        {
+            dcgmReturn = dcgmIpc.ConnectDomain(domainPath, connectionId, 5000);
+        }
+
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            std::cerr << "Unable to open connection " << i << ". Got " << dcgmReturn << "\n";
+            return 200;
+        }
+
+        clientIds.push_back(connectionId);
+    }
+
+    bench.clientIds.insert(clientIds.begin(), clientIds.end());
+
+    for (auto connectionId : clientIds)
+    {
+        for (unsigned int i = 0; i < numInFlight; i++)
+        {
+            auto message = std::make_unique<DcgmMessage>();
+            message->UpdateMsgHdr(0, 0, 0, payloadSize);
+            message->GetMsgBytesPtr()->resize(payloadSize, 'D');
+
+            dcgmReturn = dcgmIpc.SendMessage(connectionId, std::move(message), false);
+            if (dcgmReturn != DCGM_ST_OK)
+            {
+                std::cerr << "Unexpected dcgmReturn " << dcgmReturn << " from SendMessage\n";
+                return 300;
+            }
+        }
+    }
+
+    /* Let the connections warm up before we start measuring */
+    usleep(50000);
+
+    timelib64_t startTime    = timelib_usecSince1970();
+    uint64_t startRoundTrips = bench.numRoundTrips;
+
+    usleep(durationMs * 1000);
+
+    uint64_t numRoundTrips = bench.numRoundTrips - startRoundTrips;
+    timelib64_t elapsed    = timelib_usecSince1970() - startTime;
+
+    bench.stop = true;
+
+    /* Let in-flight messages drain before we tear down the instance */
+    usleep(100000);
+
+    if (numRoundTrips == 0)
+    {
+        std::cerr << "No round trips completed with " << numReactors << " reactors\n";
+        return 400;
+    }
+
+    roundTripsPerSec = (double)numRoundTrips * 1000000.0 / (double)elapsed;
+    return 0;
+}
+
+/*****************************************************************************/
+int TestDcgmConnections::TestIpcReactorScaling(void)
+{
+    const unsigned int reactorCounts[] = { 1, 2, 4 };
+
+    for (bool useTcp : { false, true })
+    {
+        double baseline = 0.0;
+
+        for (unsigned int numReactors : reactorCounts)
+        {
+            double roundTripsPerSec = 0.0;
+
+            int st = RunIpcReactorBench(useTcp, numReactors, roundTripsPerSec);
+            if (st != 0)
+            {
+                return st;
+            }
+
+            if (baseline == 0.0)
+            {
+                baseline = roundTripsPerSec;
+            }
+
+            printf("TestIpcReactorScaling %s reactors %u: %.0f round trips/sec (%.2fx)\n",
+                   useTcp ? "tcp" : "unix",
+                   numReactors,
+                   roundTripsPerSec,
+                   roundTripsPerSec / baseline);
+        }
+    }
+
+    return 0;
+}
+
 /*****************************************************************************/
 int TestDcgmConnections::TestDeadlockSingle(void)
 {
@@ -544,6 +754,7 @@ int TestDcgmConnections::Run()
     try
     {
         CompleteTest("TestIpcSocketPair", TestIpcSocketPair(), Nfailed);
+        CompleteTest("TestIpcReactorScaling", TestIpcReactorScaling(), Nfailed);
         CompleteTest("TestThrash", TestThrash(), Nfailed);
         CompleteTest("TestDeadlockSingle", TestDeadlockSingle(), Nfailed);
         CompleteTest("TestDeadlockMultiThread", TestDeadlockMulti(), Nfailed);
@@ -49,6 +49,7 @@ private:
     int TestDeadlockMulti(void);
     int TestThrash(void);
     int TestIpcSocketPair(void);
+    int TestIpcReactorScaling(void);
 
     /*************************************************************************/
     /*
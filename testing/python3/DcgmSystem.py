@@ -105,6 +105,9 @@ class DcgmSystemIntrospect:
         self._handle = dcgmHandle
         self.memory = DcgmSystemIntrospectMemory(dcgmHandle)
         self.cpuUtil = DcgmSystemIntrospectCpuUtil(dcgmHandle)
+        self.queueWait = DcgmSystemIntrospectQueueWait(dcgmHandle)
+        self.forcedUpdates = DcgmSystemIntrospectForcedUpdates(dcgmHandle)
+        self.cacheMemory = DcgmSystemIntrospectCacheMemory(dcgmHandle)
         
     def UpdateAll(self, waitForUpdate=True):
         dcgm_agent.dcgmIntrospectUpdateAll(self._handle.handle, waitForUpdate)
@@ -149,6 +152,64 @@ class DcgmSystemIntrospectCpuUtil:
         '''
         return dcgm_agent.dcgmIntrospectGetHostengineCpuUtilization(self._dcgmHandle.handle, waitIfNoData)
 
+class DcgmSystemIntrospectQueueWait:
+    '''
+    Class to access information about how long requests to DCGM waited to be processed
+    '''
+    
+    def __init__(self, dcgmHandle):
+        self._dcgmHandle = dcgmHandle
+        
+    def GetForHostengine(self):
+        '''
+        Get how many requests of each priority class the hostengine has processed and how long
+        they waited in its queue before being picked up.
+                      
+        Returns a dcgm_structs.c_dcgmIntrospectQueueWait_v1 object. Index its classes by
+        dcgm_structs.DCGM_INTROSPECT_QUEUE_CLASS_*
+        '''
+        return dcgm_agent.dcgmIntrospectGetHostengineQueueWait(self._dcgmHandle.handle)
+
+class DcgmSystemIntrospectForcedUpdates:
+    '''
+    Class to access information about the forced update cycles requested by dcgmUpdateAllFields
+    '''
+
+    def __init__(self, dcgmHandle):
+        self._dcgmHandle = dcgmHandle
+
+    def GetForHostengine(self):
+        '''
+        Get how many forced updates were requested and how many of those ran their own update cycle
+        versus being coalesced into a cycle that another caller requested.
+
+        Returns a dcgm_structs.c_dcgmIntrospectForcedUpdates_v1 object
+        '''
+        return dcgm_agent.dcgmIntrospectGetForcedUpdates(self._dcgmHandle.handle)
+
+class DcgmSystemIntrospectCacheMemory:
+    '''
+    Class to access information about the memory used by the hostengine's cache of field samples
+    '''
+
+    def __init__(self, dcgmHandle):
+        self._dcgmHandle = dcgmHandle
+
+    def GetForHostengine(self):
+        '''
+        Get how much memory cached samples use, the budget they are held to and how many samples
+        were evicted to stay within it.
+
+        Returns a dcgm_structs.c_dcgmIntrospectCacheMemory_v1 object
+        '''
+        return dcgm_agent.dcgmIntrospectGetCacheMemory(self._dcgmHandle.handle)
+
+    def SetBudget(self, budgetBytes):
+        '''
+        Set the memory budget in bytes for cached samples. 0 = unlimited
+        '''
+        dcgm_agent.dcgmIntrospectSetCacheMemoryBudget(self._dcgmHandle.handle, budgetBytes)
+
 '''
 Class to encapsulate DCGM field-metadata requests
 '''
@@ -269,6 +269,28 @@ def dcgmGroupGetInfo(dcgm_handle, group_id, version=dcgm_structs.c_dcgmGroupInfo
     dcgm_structs._dcgmCheckReturn(ret)
     return device_values
 
+@ensure_byte_strings()
+def dcgmGroupGetEntities(dcgm_handle, group_id):
+    """
+    Returns a list of every c_dcgmGroupEntityPair_t in the group, in the order they were added
+    """
+    fn = dcgmFP("dcgmGroupGetEntities")
+    entityPairs = []
+
+    page = dcgm_structs.c_dcgmGroupEntities_v1()
+    while True:
+        page.version = dcgm_structs.c_dcgmGroupEntities_version1
+        page.startIndex = len(entityPairs)
+        ret = fn(dcgm_handle, group_id, byref(page))
+        dcgm_structs._dcgmCheckReturn(ret)
+        for i in range(page.count):
+            entityPair = dcgm_structs.c_dcgmGroupEntityPair_t()
+            entityPair.entityGroupId = page.entityList[i].entityGroupId
+            entityPair.entityId = page.entityList[i].entityId
+            entityPairs.append(entityPair)
+        if page.count == 0 or len(entityPairs) >= page.totalCount:
+            return entityPairs
+
 @ensure_byte_strings()
 def dcgmGroupGetAllIds(dcgmHandle):
     fn = dcgmFP("dcgmGroupGetAllIds")
@@ -436,6 +458,14 @@ def dcgmGetValuesSince_v2(dcgm_handle, groupId, fieldGroupId, sinceTimestamp, en
     dcgm_structs._dcgmCheckReturn(ret)
     return c_nextSinceTimestamp.value
 
+@ensure_byte_strings()
+def dcgmGetValuesSinceColumnar(dcgm_handle, groupId, fieldGroupId, sinceTimestamp, untilTimestamp, values):
+    fn = dcgmFP("dcgmGetValuesSinceColumnar")
+    c_nextSinceTimestamp = c_int64()
+    ret = fn(dcgm_handle, groupId, fieldGroupId, c_int64(sinceTimestamp), c_int64(untilTimestamp), byref(c_nextSinceTimestamp), byref(values))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return c_nextSinceTimestamp.value
+
 @ensure_byte_strings()
 def dcgmGetLatestValues(dcgm_handle, groupId, fieldGroupId, enumCB, userData):
     fn = dcgmFP("dcgmGetLatestValues")
@@ -450,6 +480,18 @@ def dcgmGetLatestValues_v2(dcgm_handle, groupId, fieldGroupId, enumCB, userData)
     dcgm_structs._dcgmCheckReturn(ret)
     return ret
 
+@ensure_byte_strings()
+def dcgmGetLatestValueChanges(dcgm_handle, groupId, fieldGroupId, resyncInterval, enumCB, userData):
+    '''
+    Calls enumCB for the latest values of fieldGroupId for groupId that changed since the last call.
+    Returns True if every value was passed to enumCB as a resync, False if only the ones that changed were
+    '''
+    fn = dcgmFP("dcgmGetLatestValueChanges")
+    c_isResync = c_int32()
+    ret = fn(dcgm_handle, groupId, fieldGroupId, c_uint32(resyncInterval), byref(c_isResync), enumCB, py_object(userData))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return c_isResync.value != 0
+
 @ensure_byte_strings()
 def dcgmWatchFields(dcgm_handle, groupId, fieldGroupId, updateFreq, maxKeepAge, maxKeepSamples):
     fn = dcgmFP("dcgmWatchFields")
@@ -679,6 +721,84 @@ def dcgmIntrospectGetHostengineCpuUtilization(dcgm_handle, waitIfNoData=True):
     dcgm_structs._dcgmCheckReturn(ret)
     return cpuUtil
     
+@ensure_byte_strings()
+def dcgmIntrospectGetHostengineQueueWait(dcgm_handle):
+    fn = dcgmFP("dcgmIntrospectGetHostengineQueueWait")
+    
+    queueWait = dcgm_structs.c_dcgmIntrospectQueueWait_v1()
+    queueWait.version = dcgm_structs.dcgmIntrospectQueueWait_version1
+    
+    ret = fn(dcgm_handle, byref(queueWait))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return queueWait
+
+def dcgmIntrospectGetForcedUpdates(dcgm_handle):
+    fn = dcgmFP("dcgmIntrospectGetForcedUpdates")
+
+    forcedUpdates = dcgm_structs.c_dcgmIntrospectForcedUpdates_v1()
+    forcedUpdates.version = dcgm_structs.dcgmIntrospectForcedUpdates_version1
+
+    ret = fn(dcgm_handle, byref(forcedUpdates))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return forcedUpdates
+
+def dcgmIntrospectGetCacheMemory(dcgm_handle):
+    fn = dcgmFP("dcgmIntrospectGetCacheMemory")
+
+    cacheMemory = dcgm_structs.c_dcgmIntrospectCacheMemory_v1()
+    cacheMemory.version = dcgm_structs.dcgmIntrospectCacheMemory_version1
+
+    ret = fn(dcgm_handle, byref(cacheMemory))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return cacheMemory
+
+def dcgmIntrospectSetCacheMemoryBudget(dcgm_handle, budgetBytes):
+    fn = dcgmFP("dcgmIntrospectSetCacheMemoryBudget")
+    ret = fn(dcgm_handle, c_int64(budgetBytes))
+    dcgm_structs._dcgmCheckReturn(ret)
+
+def dcgmFederationGetNodes(dcgm_handle):
+    fn = dcgmFP("dcgmFederationGetNodes")
+
+    nodes = dcgm_structs.c_dcgmFederationNodes_v1()
+    nodes.version = dcgm_structs.dcgmFederationNodes_version1
+
+    ret = fn(dcgm_handle, byref(nodes))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return nodes
+
+def dcgmFederationGetLatestValues(dcgm_handle, nodeId=dcgm_structs.DCGM_FEDERATION_ALL_NODES):
+    '''
+    Returns a list of every dcgm_structs.c_dcgmFederationFieldValue_v1 mirrored from nodeId
+    '''
+    fn = dcgmFP("dcgmFederationGetLatestValues")
+
+    values = []
+    generation = None
+    while True:
+        page = dcgm_structs.c_dcgmFederationValues_v1()
+        page.version = dcgm_structs.dcgmFederationValues_version1
+        page.nodeId = nodeId
+        page.startIndex = len(values)
+
+        ret = fn(dcgm_handle, byref(page))
+        dcgm_structs._dcgmCheckReturn(ret)
+
+        if generation is not None and page.generation != generation:
+            # Values were added since the last page, so our indexes are stale
+            values = []
+            generation = None
+            continue
+        generation = page.generation
+
+        for i in range(page.numValues):
+            value = dcgm_structs.c_dcgmFederationFieldValue_v1()
+            memmove(addressof(value), addressof(page.values[i]), sizeof(value))
+            values.append(value)
+
+        if page.numValues == 0 or len(values) >= page.totalValues:
+            return values
+    
 @ensure_byte_strings()
 def dcgmEntityGetLatestValues(dcgmHandle, entityGroup, entityId, fieldIds):
     fn = dcgmFP("dcgmEntityGetLatestValues")
@@ -699,6 +819,23 @@ def dcgmEntitiesGetLatestValues(dcgmHandle, entities, fieldIds, flags):
     dcgm_structs._dcgmCheckReturn(ret)
     return field_values
 
+@ensure_byte_strings()
+def dcgmEntitiesGetCycleValues(dcgmHandle, entities, fieldIds, cycleId=0, timeoutMs=0):
+    '''
+    Returns (cycleId, field_values) where field_values are the values of fieldIds for entities as of
+    update cycle cycleId. Pass the cycleId returned by the previous call to wait for the next cycle
+    '''
+    fn = dcgmFP("dcgmEntitiesGetCycleValues")
+    numFvs =  len(fieldIds) * len(entities)
+    field_values = (dcgm_structs.c_dcgmFieldValue_v2 * numFvs)()
+    entities_values = (dcgm_structs.c_dcgmGroupEntityPair_t * len(entities))(*entities)
+    field_id_values = (c_uint16 * len(fieldIds))(*fieldIds)
+    c_cycleId = c_int64(cycleId)
+    ret = fn(dcgmHandle, entities_values, c_uint(len(entities)), field_id_values, c_uint(len(fieldIds)),
+             byref(c_cycleId), c_uint(timeoutMs), field_values)
+    dcgm_structs._dcgmCheckReturn(ret)
+    return c_cycleId.value, field_values
+
 @ensure_byte_strings()
 def dcgmSelectGpusByTopology(dcgmHandle, inputGpuIds, numGpus, hintFlags):
     fn = dcgmFP("dcgmSelectGpusByTopology")
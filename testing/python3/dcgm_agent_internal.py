@@ -129,7 +129,7 @@ def dcgmSetEntityNvLinkLinkState(dcgmHandle, entityGroupId, entityId, linkId, li
 @dcgm_agent.ensure_byte_strings()
 def dcgmGetCacheManagerFieldInfo(dcgmHandle, entityId, entityGroupId, fieldId):
     fn = dcgm_structs._dcgmGetFunctionPointer("dcgmGetCacheManagerFieldInfo")
-    cmfi = dcgm_structs_internal.dcgmCacheManagerFieldInfo_v4()
+    cmfi = dcgm_structs_internal.dcgmCacheManagerFieldInfo_v5()
 
     cmfi.entityId = entityId
     cmfi.entityGroupId = entityGroupId
@@ -710,6 +710,21 @@ class c_dcgmGroupInfo_v2(_PrintableStructure):
     ]
 c_dcgmGroupInfo_version2 = make_dcgm_version(c_dcgmGroupInfo_v2, 2)
 
+DCGM_GROUP_ENTITIES_PAGE_SIZE = 1024 #Maximum number of entities returned by one dcgmGroupGetEntities call
+
+# /**
+#  * Structure to page through the entities of a DCGM group of any size
+#  */
+class c_dcgmGroupEntities_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint),
+        ('startIndex', c_uint),
+        ('count', c_uint),
+        ('totalCount', c_uint),
+        ('entityList', c_dcgmGroupEntityPair_t * DCGM_GROUP_ENTITIES_PAGE_SIZE)
+    ]
+c_dcgmGroupEntities_version1 = make_dcgm_version(c_dcgmGroupEntities_v1, 1)
+
 
 DcgmiMigProfileNone                     = 0  # No profile (for GPUs)
 DcgmMigProfileGpuInstanceSlice1         = 1  # GPU instance slice 1
@@ -1512,10 +1527,68 @@ class c_dcgmFieldValue_v2(_PrintableStructure):
 
 dcgmFieldValue_version2 = make_dcgm_version(c_dcgmFieldValue_v2, 2)
 
+DCGM_COLUMNAR_NO_POOL_ENTRY = 0xFFFFFFFF
+
+# Struct-of-arrays output of dcgm_agent.dcgmGetValuesSinceColumnar()
+class c_dcgmColumnarValues_v1(_PrintableStructure):
+    _fields_ = [
+        # version must always be first
+        ('version', c_uint),
+        ('capacity', c_uint),
+        ('count', c_uint),
+        ('totalCount', c_uint),
+        ('timestamps', POINTER(c_int64)),
+        ('entityGroupIds', POINTER(c_uint)),
+        ('entityIds', POINTER(c_uint)),
+        ('fieldIds', POINTER(c_ushort)),
+        ('fieldTypes', POINTER(c_ushort)),
+        ('statuses', POINTER(c_int)),
+        ('int64Values', POINTER(c_int64)),
+        ('doubleValues', POINTER(c_double)),
+        ('poolOffsets', POINTER(c_uint)),
+        ('poolLengths', POINTER(c_uint)),
+        ('stringPool', POINTER(c_char)),
+        ('stringPoolCapacity', c_uint),
+        ('stringPoolUsed', c_uint),
+        ('stringPoolNeeded', c_uint),
+    ]
+
+dcgmColumnarValues_version1 = make_dcgm_version(c_dcgmColumnarValues_v1, 1)
+
+def make_dcgm_columnar_values(capacity, stringPoolCapacity):
+    """
+    Allocate a c_dcgmColumnarValues_v1 with every column set. ctypes keeps the
+    arrays alive for as long as the returned struct is referenced. A
+    stringPoolCapacity of None leaves the string pool NULL
+    """
+    values = c_dcgmColumnarValues_v1()
+    values.version = dcgmColumnarValues_version1
+    values.capacity = capacity
+    values.timestamps = (c_int64 * capacity)()
+    values.entityGroupIds = (c_uint * capacity)()
+    values.entityIds = (c_uint * capacity)()
+    values.fieldIds = (c_ushort * capacity)()
+    values.fieldTypes = (c_ushort * capacity)()
+    values.statuses = (c_int * capacity)()
+    values.int64Values = (c_int64 * capacity)()
+    values.doubleValues = (c_double * capacity)()
+    values.poolOffsets = (c_uint * capacity)()
+    values.poolLengths = (c_uint * capacity)()
+    if stringPoolCapacity is not None:
+        values.stringPool = (c_char * stringPoolCapacity)()
+        values.stringPoolCapacity = stringPoolCapacity
+    return values
+
 
 #Field value flags used by dcgm_agent.dcgmEntitiesGetLatestValues()
 DCGM_FV_FLAG_LIVE_DATA = 0x00000001
 
+#Maximum timeoutMs that can be passed to dcgm_agent.dcgmEntitiesGetCycleValues()
+DCGM_MAX_CYCLE_WAIT_MS = 60000
+
+#resyncInterval dcgm_agent.dcgmGetLatestValueChanges() uses when 0 is passed
+DCGM_FV_CHANGES_DEFAULT_RESYNC_INTERVAL = 60
+
 DCGM_HEALTH_WATCH_PCIE      = 0x1
 DCGM_HEALTH_WATCH_NVLINK    = 0x2
 DCGM_HEALTH_WATCH_PMU       = 0x4
@@ -1853,6 +1926,109 @@ class c_dcgmIntrospectCpuUtil_v1(_PrintableStructure):
 
 dcgmIntrospectCpuUtil_version1 = make_dcgm_version(c_dcgmIntrospectCpuUtil_v1, 1)
 
+DCGM_INTROSPECT_QUEUE_CLASS_HIGH = 0   # Liveness probes, health checks and policy registration
+DCGM_INTROSPECT_QUEUE_CLASS_NORMAL = 1 # Requests that aren't classified as high or bulk
+DCGM_INTROSPECT_QUEUE_CLASS_BULK = 2   # Large sample reads and diagnostic runs
+DCGM_INTROSPECT_QUEUE_CLASS_COUNT = 3
+
+class c_dcgmIntrospectQueueClassWait_t(_PrintableStructure):
+    _fields_ = [
+        ('numRequests', c_uint64),   #!< Number of requests of this class that have been processed
+        ('totalWaitUsec', c_uint64), #!< Total time those requests spent queued, in usec
+        ('maxWaitUsec', c_uint64),   #!< Longest time any of those requests spent queued, in usec
+        ('numQueued', c_uint32),     #!< Number of requests of this class that are queued right now
+    ]
+
+class c_dcgmIntrospectQueueWait_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32), #!< version number
+        ('classes', c_dcgmIntrospectQueueClassWait_t * DCGM_INTROSPECT_QUEUE_CLASS_COUNT),
+    ]
+
+dcgmIntrospectQueueWait_version1 = make_dcgm_version(c_dcgmIntrospectQueueWait_v1, 1)
+
+class c_dcgmIntrospectForcedUpdates_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32), #!< version number
+        ('numRequests', c_int64), #!< Number of forced update requests
+        ('numExecuted', c_int64), #!< Number of forced update cycles that were executed
+        ('numCoalesced', c_int64), #!< Number of forced update requests that attached to another cycle
+        ('numSkipped', c_int64), #!< Number of queued forced update cycles that were skipped since a timed cycle satisfied their requests first
+        ('minSpacingUsec', c_int64), #!< Minimum spacing between forced update cycles, in usec
+    ]
+
+dcgmIntrospectForcedUpdates_version1 = make_dcgm_version(c_dcgmIntrospectForcedUpdates_v1, 1)
+
+class c_dcgmIntrospectCacheMemory_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32), #!< version number
+        ('budgetBytes', c_int64), #!< Cache memory budget in bytes. 0 = unlimited
+        ('usedBytes', c_int64), #!< Bytes used by cached samples right now
+        ('numEvictions', c_int64), #!< Number of times samples were evicted because the budget was exceeded
+        ('evictedSamples', c_int64), #!< Number of samples that were evicted
+        ('evictedBytes', c_int64), #!< Bytes that were freed by evicting samples
+    ]
+
+dcgmIntrospectCacheMemory_version1 = make_dcgm_version(c_dcgmIntrospectCacheMemory_v1, 1)
+
+DCGM_FEDERATION_MAX_NODES = 64
+DCGM_FEDERATION_MAX_VALUES = 128
+DCGM_FEDERATION_ALL_NODES = 0xFFFFFFFF
+
+class c_dcgmFederationNode_v1(_PrintableStructure):
+    _fields_ = [
+        ('nodeId', c_uint32), #!< ID that qualifies the entities of this node in federated field values
+        ('connected', c_uint32), #!< 1 if the aggregator is connected to the node right now. 0 if not
+        ('address', c_char * DCGM_MAX_STR_LENGTH), #!< Address the node was configured with
+        ('lagUsec', c_int64), #!< How old the newest mirrored sample was when the last sync finished
+        ('syncLatencyUsec', c_int64), #!< How long the last successful sync with the node took
+        ('lastSyncTs', c_int64), #!< When the last successful sync finished in usec since 1970. 0 = never
+        ('numSyncs', c_int64), #!< Number of successful syncs with the node
+        ('numErrors', c_int64), #!< Number of failed connection attempts and syncs
+        ('numValues', c_int64), #!< Number of field values mirrored from the node right now
+    ]
+
+class c_dcgmFederationNodes_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32),
+        ('numNodes', c_uint32),
+        ('nodes', c_dcgmFederationNode_v1 * DCGM_FEDERATION_MAX_NODES),
+    ]
+
+dcgmFederationNodes_version1 = make_dcgm_version(c_dcgmFederationNodes_v1, 1)
+
+class c_dcgmFederationFieldValue_v1_value(DcgmUnion):
+    _fields_ = [
+        ('i64', c_int64),
+        ('dbl', c_double),
+        ('str', c_char * DCGM_MAX_STR_LENGTH),
+    ]
+
+class c_dcgmFederationFieldValue_v1(_PrintableStructure):
+    _fields_ = [
+        ('nodeId', c_uint32), #!< Node this value was mirrored from
+        ('entityGroupId', c_uint32), #!< Entity group of the entity on the node
+        ('entityId', c_uint32), #!< Entity ID on the node
+        ('fieldId', c_uint16),
+        ('fieldType', c_uint16),
+        ('status', c_int32),
+        ('ts', c_int64),
+        ('value', c_dcgmFederationFieldValue_v1_value),
+    ]
+
+class c_dcgmFederationValues_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32),
+        ('nodeId', c_uint32), #!< IN: Node to get the values of or DCGM_FEDERATION_ALL_NODES
+        ('startIndex', c_uint32), #!< IN: Index of the first value to return
+        ('numValues', c_uint32), #!< OUT: Number of entries in values[] that are populated
+        ('totalValues', c_uint32), #!< OUT: Number of values there are for nodeId in total
+        ('generation', c_uint32), #!< OUT: Changes whenever values are added. Start over if it changes between pages
+        ('values', c_dcgmFederationFieldValue_v1 * DCGM_FEDERATION_MAX_VALUES),
+    ]
+
+dcgmFederationValues_version1 = make_dcgm_version(c_dcgmFederationValues_v1, 1)
+
 DCGM_MAX_CONFIG_FILE_LEN = 10000
 DCGM_MAX_TEST_NAMES = 20
 DCGM_MAX_TEST_NAMES_LEN = 50
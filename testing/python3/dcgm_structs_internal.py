@@ -121,7 +121,7 @@ class c_dcgm_cm_field_info_watcher_t(dcgm_structs._PrintableStructure):
     ]
 
 
-class dcgmCacheManagerFieldInfo_v4(dcgm_structs._PrintableStructure):
+class dcgmCacheManagerFieldInfo_v5(dcgm_structs._PrintableStructure):
     _fields_ = [
         ('version', c_uint32),
         ('flags', c_uint32),
@@ -137,10 +137,17 @@ class dcgmCacheManagerFieldInfo_v4(dcgm_structs._PrintableStructure):
         ('fetchCount', c_int64),
         ('numSamples', c_int32),
         ('numWatchers', c_int32),
-        ('watchers', c_dcgm_cm_field_info_watcher_t * DCGM_CM_FIELD_INFO_NUM_WATCHERS)
+        ('watchers', c_dcgm_cm_field_info_watcher_t * DCGM_CM_FIELD_INFO_NUM_WATCHERS),
+        ('numaNode', c_int32),
+        ('hugePages', c_int32),
+        ('sampleBytes', c_int64),
+        ('poolBytesReserved', c_int64),
+        ('poolBytesInUse', c_int64),
+        ('poolHeapFallbacks', c_int64),
+        ('budgetEvictedSamples', c_int64)
     ]
 
-dcgmCacheManagerFieldInfo_version4 = dcgm_structs.make_dcgm_version(dcgmCacheManagerFieldInfo_v4, 4)
+dcgmCacheManagerFieldInfo_version5 = dcgm_structs.make_dcgm_version(dcgmCacheManagerFieldInfo_v5, 5)
 
 class c_dcgmCreateFakeEntities_v2(dcgm_structs._PrintableStructure):
     _fields_ = [
@@ -33,6 +33,7 @@ import utils
 import json
 import tempfile
 import shutil
+import subprocess
 
 from ctypes import *
 from apps.app_runner import AppRunner
@@ -1032,3 +1033,32 @@ def test_dcgm_diag_paused_embedded(handle, gpuIds):
 @test_utils.run_with_injection_gpus(1)
 def test_dcgm_diag_paused_standalone(handle, gpuIds):
     helper_test_dcgm_diag_paused(handle, gpuIds)
+
+def helper_get_nvvs_worker_pids():
+    try:
+        return subprocess.check_output(["pgrep", "-f", "apps/nvvs/nvvs --worker"]).split()
+    except subprocess.CalledProcessError:
+        return []
+
+@test_utils.run_with_standalone_host_engine(120, heEnv={'NVVS_WORKER_MODE': '1'})
+@test_utils.run_with_initialized_client()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_diag_warm_nvvs_worker(handle, gpuIds):
+    """
+    Verifies that the software diagnostic runs through the warm nvvs worker and that the worker
+    is kept and reused between runs
+    """
+    dd = DcgmDiag.DcgmDiag(gpuIds=gpuIds, testNamesStr='1')
+
+    response = test_utils.diag_execute_wrapper(dd, handle)
+    assert response.levelOneTestCount > 0, "The software diagnostic did not report any results"
+
+    workerPids = helper_get_nvvs_worker_pids()
+    assert len(workerPids) == 1, "Expected one nvvs worker after the first run, found %s" % workerPids
+
+    for _ in range(3):
+        response = test_utils.diag_execute_wrapper(dd, handle)
+        assert response.levelOneTestCount > 0, "The software diagnostic did not report any results"
+
+    assert helper_get_nvvs_worker_pids() == workerPids, \
+        "The nvvs worker %s was not reused between runs: %s" % (workerPids, helper_get_nvvs_worker_pids())
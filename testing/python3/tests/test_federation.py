@@ -0,0 +1,172 @@
+# Copyright (c) 2023, NVIDIA CORPORATION.  All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# test an nv-hostengine that aggregates other hostengines with --federate
+import tempfile
+import time
+from ctypes import byref
+
+import apps
+import dcgm_agent
+import dcgm_agent_internal
+import dcgm_fields
+import dcgm_structs
+import dcgm_structs_internal
+import logger
+import test_utils
+import dcgm_field_injection_helpers
+
+# Ports of the downstream hostengines. The aggregator listens on the default port
+g_downstreamPorts = [5600, 5601]
+
+def _start_downstream_hostengine(port):
+    '''
+    Start a hostengine on port that loads injection NVML so it doesn't need any GPUs
+    '''
+    app = apps.NvHostEngineApp(args=["-p", str(port)],
+                               pid_dir=tempfile.mkdtemp(),
+                               heEnv={test_utils.INJECTION_MODE_VAR: 'True'})
+    app.start(timeout=10)
+    return app
+
+def _create_fake_gpu(handle):
+    cfe = dcgm_structs_internal.c_dcgmCreateFakeEntities_v2()
+    cfe.numToCreate = 1
+    cfe.entityList[0].entity.entityGroupId = dcgm_fields.DCGM_FE_GPU
+    updated = dcgm_agent_internal.dcgmCreateFakeEntities(handle, cfe)
+    return updated.entityList[0].entity.entityId
+
+def _wait_for_nodes(handle, condition, timeoutSec=15):
+    deadline = time.time() + timeoutSec
+    while True:
+        nodes = dcgm_agent.dcgmFederationGetNodes(handle)
+        if condition(nodes):
+            return nodes
+        assert time.time() < deadline, "Federation didn't converge. Nodes: %s" % \
+            str([nodes.nodes[i] for i in range(nodes.numNodes)])
+        time.sleep(0.1)
+
+def _get_values_page(handle, nodeId, startIndex):
+    page = dcgm_structs.c_dcgmFederationValues_v1()
+    page.version = dcgm_structs.dcgmFederationValues_version1
+    page.nodeId = nodeId
+    page.startIndex = startIndex
+    ret = dcgm_structs._dcgmGetFunctionPointer("dcgmFederationGetLatestValues")(handle, byref(page))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return page
+
+@test_utils.run_with_embedded_host_engine()
+def test_dcgm_federation_not_configured(handle):
+    '''
+    Hostengines that weren't started with --federate have nothing to serve
+    '''
+    with test_utils.assert_raises(dcgm_structs.dcgmExceptionClass(dcgm_structs.DCGM_ST_NOT_CONFIGURED)):
+        dcgm_agent.dcgmFederationGetNodes(handle)
+    with test_utils.assert_raises(dcgm_structs.dcgmExceptionClass(dcgm_structs.DCGM_ST_NOT_CONFIGURED)):
+        dcgm_agent.dcgmFederationGetLatestValues(handle)
+
+def test_dcgm_federation_mirrors_downstream_hostengines():
+    '''
+    Run several hostengines on loopback, aggregate them with a third one and check that it serves
+    the values injected into each of them qualified by node
+    '''
+    downstreamApps = []
+    try:
+        for port in g_downstreamPorts:
+            downstreamApps.append(_start_downstream_hostengine(port))
+
+        dcgm_agent.dcgmInit()
+        connectParams = dcgm_structs.c_dcgmConnectV2Params_v1()
+        connectParams.persistAfterDisconnect = 0
+
+        # Give every node a GPU with its own values. Node IDs are the index in --federate
+        expected = {}
+        downstreamHandles = []
+        for nodeId, port in enumerate(g_downstreamPorts):
+            downstreamHandle = dcgm_agent.dcgmConnect_v2("127.0.0.1:%d" % port, connectParams)
+            downstreamHandles.append(downstreamHandle)
+            gpuId = _create_fake_gpu(downstreamHandle)
+
+            temperature = 40 + nodeId
+            power = 100.5 + nodeId
+            dcgm_field_injection_helpers.inject_value(downstreamHandle, gpuId, dcgm_fields.DCGM_FI_DEV_GPU_TEMP,
+                                                      temperature, 0)
+            dcgm_field_injection_helpers.inject_value(downstreamHandle, gpuId, dcgm_fields.DCGM_FI_DEV_POWER_USAGE,
+                                                      power, 0)
+            expected[(nodeId, gpuId, dcgm_fields.DCGM_FI_DEV_GPU_TEMP)] = temperature
+            expected[(nodeId, gpuId, dcgm_fields.DCGM_FI_DEV_POWER_USAGE)] = power
+
+        federateArgs = ['--federate', ','.join(["127.0.0.1:%d" % port for port in g_downstreamPorts]),
+                        '--federate-fields', '%d,%d' % (dcgm_fields.DCGM_FI_DEV_GPU_TEMP,
+                                                        dcgm_fields.DCGM_FI_DEV_POWER_USAGE)]
+        heEnv = {test_utils.INJECTION_MODE_VAR: 'True', '__DCGM_FEDERATION_INTERVAL_MS': '100'}
+
+        with test_utils.RunStandaloneHostEngine(20, heArgs=federateArgs, heEnv=heEnv):
+            handle = dcgm_agent.dcgmConnect_v2("127.0.0.1", connectParams)
+
+            nodes = _wait_for_nodes(handle, lambda nodes: nodes.numNodes == len(g_downstreamPorts) and
+                                    all(nodes.nodes[i].connected and nodes.nodes[i].numValues >= 2
+                                        for i in range(nodes.numNodes)))
+            for i in range(nodes.numNodes):
+                node = nodes.nodes[i]
+                logger.info("Node %d at %s: lag %d usec, sync latency %d usec, %d syncs" %
+                            (node.nodeId, node.address, node.lagUsec, node.syncLatencyUsec, node.numSyncs))
+                assert node.nodeId == i, "Got node %d at index %d" % (node.nodeId, i)
+                assert node.address == ("127.0.0.1:%d" % g_downstreamPorts[i]).encode(), node.address
+                assert node.numSyncs > 0 and node.lastSyncTs > 0
+
+            actual = {}
+            for value in dcgm_agent.dcgmFederationGetLatestValues(handle):
+                assert value.entityGroupId == dcgm_fields.DCGM_FE_GPU
+                if value.fieldType == dcgm_fields.DCGM_FT_DOUBLE:
+                    actual[(value.nodeId, value.entityId, value.fieldId)] = value.value.dbl
+                else:
+                    actual[(value.nodeId, value.entityId, value.fieldId)] = value.value.i64
+            for key, expectedValue in expected.items():
+                assert key in actual, "Missing %s in %s" % (str(key), str(actual))
+                assert actual[key] == expectedValue, "%s: %s != %s" % (str(key), str(actual[key]), str(expectedValue))
+
+            # Filtering by node only returns that node's values
+            nodeValues = dcgm_agent.dcgmFederationGetLatestValues(handle, 1)
+            assert len(nodeValues) > 0 and all(value.nodeId == 1 for value in nodeValues)
+
+            with test_utils.assert_raises(dcgm_structs.dcgmExceptionClass(dcgm_structs.DCGM_ST_BADPARAM)):
+                dcgm_agent.dcgmFederationGetLatestValues(handle, len(g_downstreamPorts))
+
+            # Pages are stable while no values are added. The generation of all nodes adds up theirs
+            allPage = _get_values_page(handle, dcgm_structs.DCGM_FEDERATION_ALL_NODES, 0)
+            nodePages = [_get_values_page(handle, nodeId, 0) for nodeId in range(len(g_downstreamPorts))]
+            assert allPage.generation > 0
+            assert allPage.generation == sum(page.generation for page in nodePages)
+            assert allPage.totalValues == sum(page.totalValues for page in nodePages)
+            lastPage = _get_values_page(handle, dcgm_structs.DCGM_FEDERATION_ALL_NODES, nodePages[0].totalValues)
+            assert lastPage.generation == allPage.generation
+            assert lastPage.numValues == nodePages[1].numValues
+            assert all(lastPage.values[i].nodeId == 1 for i in range(lastPage.numValues))
+
+            # Losing a node is reported on that node alone. Its last values stay available
+            numErrors = nodes.nodes[0].numErrors
+            dcgm_agent.dcgmDisconnect(downstreamHandles[0])
+            downstreamApps[0].terminate()
+            downstreamApps = downstreamApps[1:]
+
+            nodes = _wait_for_nodes(handle, lambda nodes: not nodes.nodes[0].connected and
+                                    nodes.nodes[0].numErrors > numErrors)
+            assert nodes.nodes[1].connected
+            assert nodes.nodes[0].numValues >= 2
+
+            dcgm_agent.dcgmDisconnect(handle)
+    finally:
+        for app in downstreamApps:
+            app.terminate()
+        dcgm_agent.dcgmShutdown()
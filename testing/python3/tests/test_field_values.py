@@ -127,6 +127,243 @@ def test_dcgm_field_values_since_agent(handle, gpuIds):
         else:
             assert newValueCount == numValuesPerLoop, "newValueCount %d != numValuesPerLoop %d" % (newValueCount, numValuesPerLoop)
 
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_field_values_since_columnar(handle, gpuIds):
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    systemObj = handleObj.GetSystem()
+    groupObj = systemObj.GetEmptyGroup("test1")
+    gpuId = gpuIds[0]
+    groupObj.AddGpu(gpuId)
+
+    fieldId = dcgm_fields.DCGM_FI_DEV_POWER_USAGE
+    fieldGroupObj = pydcgm.DcgmFieldGroup(handleObj, "my_field_group", [fieldId, ])
+
+    fv = dcgm_structs_internal.c_dcgmInjectFieldValue_v1()
+    fv.version = dcgm_structs_internal.dcgmInjectFieldValue_version1
+    fv.fieldId = fieldId
+    fv.status = 0
+    fv.fieldType = ord(dcgm_fields.DCGM_FT_DOUBLE)
+
+    numValues = 5
+    startTs = get_usec_since_1970() - 1000000
+    for i in range(numValues):
+        fv.ts = startTs + i
+        fv.value.dbl = 100.0 + i
+        dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+    #Too small. We should get a complete prefix and be told how much room we need
+    values = dcgm_structs.make_dcgm_columnar_values(2, 0)
+    with test_utils.assert_raises(dcgmExceptionClass(dcgm_structs.DCGM_ST_INSUFFICIENT_SIZE)):
+        dcgm_agent.dcgmGetValuesSinceColumnar(handle, groupObj.GetId(), fieldGroupObj.fieldGroupId, startTs, 0, values)
+    assert values.count == 2, "count %d != 2" % values.count
+    assert values.totalCount == numValues, "totalCount %d != %d" % (values.totalCount, numValues)
+    assert values.doubleValues[1] == 101.0, "doubleValues[1] %f" % values.doubleValues[1]
+
+    values = dcgm_structs.make_dcgm_columnar_values(values.totalCount, values.stringPoolNeeded)
+    nextSinceTimestamp = dcgm_agent.dcgmGetValuesSinceColumnar(handle, groupObj.GetId(), fieldGroupObj.fieldGroupId,
+                                                              startTs, 0, values)
+    assert nextSinceTimestamp > startTs, "nextSinceTimestamp %d <= %d" % (nextSinceTimestamp, startTs)
+    assert values.count == numValues, "count %d != %d" % (values.count, numValues)
+    for i in range(numValues):
+        assert values.timestamps[i] == startTs + i, "idx %d ts %d" % (i, values.timestamps[i])
+        assert values.entityGroupIds[i] == dcgm_fields.DCGM_FE_GPU, "idx %d eg %d" % (i, values.entityGroupIds[i])
+        assert values.entityIds[i] == gpuId, "idx %d eid %d" % (i, values.entityIds[i])
+        assert values.fieldIds[i] == fieldId, "idx %d fieldId %d" % (i, values.fieldIds[i])
+        assert values.doubleValues[i] == 100.0 + i, "idx %d value %f" % (i, values.doubleValues[i])
+        assert values.int64Values[i] == dcgmvalue.DCGM_INT64_BLANK, "idx %d int64 %d" % (i, values.int64Values[i])
+        assert values.poolOffsets[i] == dcgm_structs.DCGM_COLUMNAR_NO_POOL_ENTRY
+
+    #Limiting the window to the first two values
+    values = dcgm_structs.make_dcgm_columnar_values(numValues, 0)
+    nextSinceTimestamp = dcgm_agent.dcgmGetValuesSinceColumnar(handle, groupObj.GetId(), fieldGroupObj.fieldGroupId,
+                                                              startTs, startTs + 1, values)
+    assert values.count == 2, "count %d != 2" % values.count
+    assert nextSinceTimestamp == startTs + 2, "nextSinceTimestamp %d != %d" % (nextSinceTimestamp, startTs + 2)
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_field_values_since_columnar_null_pool(handle, gpuIds):
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    systemObj = handleObj.GetSystem()
+    groupObj = systemObj.GetEmptyGroup("test1")
+    gpuId = gpuIds[0]
+    groupObj.AddGpu(gpuId)
+
+    fieldId = dcgm_fields.DCGM_FI_DEV_SERIAL
+    fieldGroupObj = pydcgm.DcgmFieldGroup(handleObj, "my_field_group", [fieldId, ])
+
+    fv = dcgm_structs_internal.c_dcgmInjectFieldValue_v1()
+    fv.version = dcgm_structs_internal.dcgmInjectFieldValue_version1
+    fv.fieldId = fieldId
+    fv.status = 0
+    fv.fieldType = ord(dcgm_fields.DCGM_FT_STRING)
+
+    serials = [b"serial-a", b"serial-bc"]
+    startTs = get_usec_since_1970() - 1000000
+    for i, serial in enumerate(serials):
+        fv.ts = startTs + i
+        fv.value.str = serial
+        dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+    #A NULL string pool gets every value with the offsets and lengths a big enough pool would have
+    values = dcgm_structs.make_dcgm_columnar_values(len(serials), None)
+    dcgm_agent.dcgmGetValuesSinceColumnar(handle, groupObj.GetId(), fieldGroupObj.fieldGroupId, startTs, 0, values)
+    assert values.count == len(serials), "count %d != %d" % (values.count, len(serials))
+    assert values.stringPoolUsed == 0, "stringPoolUsed %d" % values.stringPoolUsed
+    expectedOffset = 0
+    for i, serial in enumerate(serials):
+        assert values.poolOffsets[i] == expectedOffset, "idx %d offset %d" % (i, values.poolOffsets[i])
+        assert values.poolLengths[i] == len(serial) + 1, "idx %d length %d" % (i, values.poolLengths[i])
+        expectedOffset += len(serial) + 1
+    assert values.stringPoolNeeded == expectedOffset, "stringPoolNeeded %d != %d" % (values.stringPoolNeeded, expectedOffset)
+
+    #The same offsets point at the strings once there's a pool
+    nullPoolOffsets = [values.poolOffsets[i] for i in range(len(serials))]
+    values = dcgm_structs.make_dcgm_columnar_values(len(serials), values.stringPoolNeeded)
+    dcgm_agent.dcgmGetValuesSinceColumnar(handle, groupObj.GetId(), fieldGroupObj.fieldGroupId, startTs, 0, values)
+    for i, serial in enumerate(serials):
+        assert values.poolOffsets[i] == nullPoolOffsets[i], "idx %d offset %d" % (i, values.poolOffsets[i])
+        start = values.poolOffsets[i]
+        value = values.stringPool[start:start + values.poolLengths[i] - 1]
+        assert value == serial, "idx %d value %s != %s" % (i, value, serial)
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_entities_get_cycle_values(handle, gpuIds):
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    systemObj = handleObj.GetSystem()
+    groupObj = systemObj.GetEmptyGroup("test1")
+    gpuId = gpuIds[0]
+    groupObj.AddGpu(gpuId)
+
+    #Watch something fast so the update thread keeps completing cycles. The field we inject into isn't
+    #watched so that the update thread doesn't write blank values for it to the fake GPU
+    fieldId = dcgm_fields.DCGM_FI_DEV_POWER_USAGE
+    fieldGroupObj = pydcgm.DcgmFieldGroup(handleObj, "my_field_group", [dcgm_fields.DCGM_FI_DEV_GPU_TEMP, ])
+    groupObj.samples.WatchFields(fieldGroupObj, 100000, 3600.0, 0)
+
+    fv = dcgm_structs_internal.c_dcgmInjectFieldValue_v1()
+    fv.version = dcgm_structs_internal.dcgmInjectFieldValue_version1
+    fv.fieldId = fieldId
+    fv.status = 0
+    fv.fieldType = ord(dcgm_fields.DCGM_FT_DOUBLE)
+
+    #A value from the past and one that no completed cycle can have seen yet
+    now = get_usec_since_1970()
+    fv.ts = now - 1000000
+    fv.value.dbl = 1.0
+    dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+    fv.ts = now + 3600 * 1000000
+    fv.value.dbl = 2.0
+    dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+    entities = [dcgm_structs.c_dcgmGroupEntityPair_t(dcgm_fields.DCGM_FE_GPU, gpuId), ]
+
+    cycleId, values = dcgm_agent.dcgmEntitiesGetCycleValues(handle, entities, [fieldId, ], 0, 5000)
+    assert cycleId > 0, "cycleId %d" % cycleId
+    assert len(values) == 1
+    assert values[0].status == dcgm_structs.DCGM_ST_OK, "status %d" % values[0].status
+    assert values[0].value.dbl == 1.0, "value %f" % values[0].value.dbl
+
+    latestValues = dcgm_agent.dcgmEntitiesGetLatestValues(handle, entities, [fieldId, ], 0)
+    assert latestValues[0].value.dbl == 2.0, "latest value %f" % latestValues[0].value.dbl
+
+    #Waiting for the next cycle should return a later one
+    nextCycleId, values = dcgm_agent.dcgmEntitiesGetCycleValues(handle, entities, [fieldId, ], cycleId, 5000)
+    assert nextCycleId > cycleId, "nextCycleId %d <= cycleId %d" % (nextCycleId, cycleId)
+    assert values[0].value.dbl == 1.0, "value %f" % values[0].value.dbl
+
+    #A cycle that won't complete any time soon
+    with test_utils.assert_raises(dcgmExceptionClass(dcgm_structs.DCGM_ST_TIMEOUT)):
+        dcgm_agent.dcgmEntitiesGetCycleValues(handle, entities, [fieldId, ], nextCycleId + 1000000, 100)
+
+    with test_utils.assert_raises(dcgmExceptionClass(dcgm_structs.DCGM_ST_BADPARAM)):
+        dcgm_agent.dcgmEntitiesGetCycleValues(handle, entities, [fieldId, ], 0, dcgm_structs.DCGM_MAX_CYCLE_WAIT_MS + 1)
+
+def py_latest_value_changes_callback(entityGroupId, entityId, values, numValues, userData):
+    changes = ctypes.cast(userData, ctypes.py_object).value
+    for i in range(numValues):
+        changes.append((entityGroupId, entityId, values[i].fieldId, values[i].value.dbl))
+    return 0
+
+latest_value_changes_callback = dcgm_agent.dcgmFieldValueEntityEnumeration_f(py_latest_value_changes_callback)
+
+def helper_dcgm_get_latest_value_changes(handle, gpuIds):
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    systemObj = handleObj.GetSystem()
+    groupObj = systemObj.GetEmptyGroup("test1")
+    gpuId = gpuIds[0]
+    groupObj.AddGpu(gpuId)
+
+    #Not watched so that the update thread doesn't write blank values over the injected ones
+    fieldId = dcgm_fields.DCGM_FI_DEV_POWER_USAGE
+    fieldGroupObj = pydcgm.DcgmFieldGroup(handleObj, "my_field_group", [fieldId, ])
+
+    fv = dcgm_structs_internal.c_dcgmInjectFieldValue_v1()
+    fv.version = dcgm_structs_internal.dcgmInjectFieldValue_version1
+    fv.fieldId = fieldId
+    fv.status = 0
+    fv.fieldType = ord(dcgm_fields.DCGM_FT_DOUBLE)
+
+    def inject(value, ts):
+        fv.ts = ts
+        fv.value.dbl = value
+        dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+    def get_changes(resyncInterval):
+        changes = []
+        isResync = dcgm_agent.dcgmGetLatestValueChanges(handle, groupObj.GetId(), fieldGroupObj.fieldGroupId,
+                                                        resyncInterval, latest_value_changes_callback, changes)
+        return isResync, changes
+
+    now = get_usec_since_1970()
+    inject(1.0, now - 3000000)
+
+    #The first call sends everything
+    isResync, changes = get_changes(100)
+    assert isResync
+    assert changes == [(dcgm_fields.DCGM_FE_GPU, gpuId, fieldId, 1.0), ], "changes %s" % str(changes)
+
+    #Nothing changed
+    isResync, changes = get_changes(100)
+    assert not isResync
+    assert changes == [], "changes %s" % str(changes)
+
+    #A newer sample of the same value isn't a change
+    inject(1.0, now - 2000000)
+    isResync, changes = get_changes(100)
+    assert changes == [], "changes %s" % str(changes)
+
+    inject(2.0, now - 1000000)
+    isResync, changes = get_changes(100)
+    assert not isResync
+    assert changes == [(dcgm_fields.DCGM_FE_GPU, gpuId, fieldId, 2.0), ], "changes %s" % str(changes)
+
+    #A resync sends unchanged values again
+    isResync, changes = get_changes(1)
+    assert isResync
+    assert changes == [(dcgm_fields.DCGM_FE_GPU, gpuId, fieldId, 2.0), ], "changes %s" % str(changes)
+
+    #Another field group is another reader
+    otherFieldGroupObj = pydcgm.DcgmFieldGroup(handleObj, "my_other_field_group", [fieldId, ])
+    changes = []
+    isResync = dcgm_agent.dcgmGetLatestValueChanges(handle, groupObj.GetId(), otherFieldGroupObj.fieldGroupId,
+                                                    0, latest_value_changes_callback, changes)
+    assert isResync
+    assert len(changes) == 1, "changes %s" % str(changes)
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_get_latest_value_changes_embedded(handle, gpuIds):
+    helper_dcgm_get_latest_value_changes(handle, gpuIds)
+
+@test_utils.run_with_standalone_host_engine(20)
+@test_utils.run_with_initialized_client()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_get_latest_value_changes_standalone(handle, gpuIds):
+    helper_dcgm_get_latest_value_changes(handle, gpuIds)
+
 def helper_dcgm_values_since(handle, gpuIds):
     handleObj = pydcgm.DcgmHandle(handle=handle)
     systemObj = handleObj.GetSystem()
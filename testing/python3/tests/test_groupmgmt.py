@@ -235,3 +235,47 @@ def test_dcgm_group_delete_grp_embedded(handle):
 def test_dcgm_group_delete_grp_standalone(handle):
     helper_dcgm_group_delete_grp(handle)
 
+
+def helper_dcgm_group_more_than_max_entities(handle, coreIds):
+    '''
+    Groups aren't limited to DCGM_GROUP_MAX_ENTITIES. dcgmGroupGetEntities lists all of them
+    '''
+    assert len(coreIds) > dcgm_structs.DCGM_GROUP_MAX_ENTITIES
+    groupId = dcgm_agent.dcgmGroupCreate(handle, dcgm_structs.DCGM_GROUP_EMPTY, "bigGroup")
+
+    for coreId in coreIds:
+        dcgm_agent.dcgmGroupAddEntity(handle, groupId, dcgm_fields.DCGM_FE_CPU_CORE, coreId)
+
+    with test_utils.assert_raises(dcgmExceptionClass(dcgm_structs.DCGM_ST_BADPARAM)):
+        dcgm_agent.dcgmGroupAddEntity(handle, groupId, dcgm_fields.DCGM_FE_CPU_CORE, coreIds[-1])
+
+    entityPairs = dcgm_agent.dcgmGroupGetEntities(handle, groupId)
+    assert [(e.entityGroupId, e.entityId) for e in entityPairs] == \
+        [(dcgm_fields.DCGM_FE_CPU_CORE, coreId) for coreId in coreIds], str(entityPairs)
+
+    # dcgmGroupGetInfo can't hold them all
+    with test_utils.assert_raises(dcgmExceptionClass(dcgm_structs.DCGM_ST_MAX_LIMIT)):
+        dcgm_agent.dcgmGroupGetInfo(handle, groupId)
+
+    removed = coreIds[dcgm_structs.DCGM_GROUP_MAX_ENTITIES]
+    dcgm_agent.dcgmGroupRemoveEntity(handle, groupId, dcgm_fields.DCGM_FE_CPU_CORE, removed)
+    entityIds = [e.entityId for e in dcgm_agent.dcgmGroupGetEntities(handle, groupId)]
+    assert entityIds == [coreId for coreId in coreIds if coreId != removed], str(entityIds)
+
+    with test_utils.assert_raises(dcgmExceptionClass(dcgm_structs.DCGM_ST_BADPARAM)):
+        dcgm_agent.dcgmGroupRemoveEntity(handle, groupId, dcgm_fields.DCGM_FE_CPU_CORE, removed)
+
+    dcgm_agent.dcgmGroupDestroy(handle, groupId)
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_cpus(1)
+@test_utils.run_with_injection_cpu_cores(100)
+def test_dcgm_group_more_than_max_entities_embedded(handle, cpuIds, coreIds):
+    helper_dcgm_group_more_than_max_entities(handle, coreIds)
+
+@test_utils.run_with_standalone_host_engine(20)
+@test_utils.run_with_initialized_client()
+@test_utils.run_with_injection_cpus(1)
+@test_utils.run_with_injection_cpu_cores(100)
+def test_dcgm_group_more_than_max_entities_standalone(handle, cpuIds, coreIds):
+    helper_dcgm_group_more_than_max_entities(handle, coreIds)
@@ -40,6 +40,97 @@ def test_dcgm_standalone_metadata_memory_get_hostengine_sane(handle):
     
     assert(1*1024*1024 < bytesUsed < 100*1024*1024), bytesUsed        # 1MB to 100MB
 
+@test_utils.run_with_standalone_host_engine()
+@test_utils.run_with_initialized_client()
+def test_dcgm_standalone_metadata_queue_wait_get_hostengine_sane(handle):
+    """
+    Sanity test for API that gets how long requests waited in the hostengine's queue
+    """
+    handle = pydcgm.DcgmHandle(handle)
+    system = pydcgm.DcgmSystem(handle)
+
+    # Liveness probes are high priority. Make sure at least one went through the queue
+    dcgm_agent.dcgmHostengineIsHealthy(handle.handle)
+
+    queueWait = system.introspect.queueWait.GetForHostengine()
+    highClass = queueWait.classes[dcgm_structs.DCGM_INTROSPECT_QUEUE_CLASS_HIGH]
+    normalClass = queueWait.classes[dcgm_structs.DCGM_INTROSPECT_QUEUE_CLASS_NORMAL]
+
+    logger.debug("high priority requests: %d, total wait %d usec" % (highClass.numRequests, highClass.totalWaitUsec))
+
+    assert highClass.numRequests > 0, "Expected the health check to be counted as high priority"
+    # This request itself is queued as normal priority, so it's counted once it has been dispatched
+    assert normalClass.numRequests > 0
+    for queueClass in queueWait.classes:
+        assert queueClass.maxWaitUsec <= queueClass.totalWaitUsec, "%d > %d" % (queueClass.maxWaitUsec, queueClass.totalWaitUsec)
+
+@test_utils.run_with_standalone_host_engine()
+@test_utils.run_with_initialized_client()
+def test_dcgm_standalone_metadata_forced_updates_sane(handle):
+    """
+    Sanity test for API that gets how many forced updates were executed versus coalesced
+    """
+    handle = pydcgm.DcgmHandle(handle)
+    system = pydcgm.DcgmSystem(handle)
+
+    before = system.introspect.forcedUpdates.GetForHostengine()
+
+    numUpdates = 5
+    for i in range(numUpdates):
+        dcgm_agent.dcgmUpdateAllFields(handle.handle, 1)
+
+    after = system.introspect.forcedUpdates.GetForHostengine()
+
+    logger.debug("forced updates: %d requested, %d executed, %d coalesced, %d skipped" %
+                 (after.numRequests, after.numExecuted, after.numCoalesced, after.numSkipped))
+
+    assert after.numRequests - before.numRequests >= numUpdates, "%d - %d" % (after.numRequests, before.numRequests)
+    # Every request either queued a cycle, which then ran or was skipped, or attached to another one
+    assert after.numExecuted + after.numSkipped + after.numCoalesced <= after.numRequests
+    assert after.numExecuted > before.numExecuted, "Expected at least one forced cycle to run"
+    assert after.minSpacingUsec >= 0
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_only_with_live_gpus()
+def test_dcgm_embedded_metadata_cache_memory_budget(handle, gpuIds):
+    """
+    Test that the cache is evicted down to its memory budget
+    """
+    handle = pydcgm.DcgmHandle(handle)
+    system = pydcgm.DcgmSystem(handle)
+    group = pydcgm.DcgmGroup(handle, groupName="cache-memory-group", groupType=dcgm_structs.DCGM_GROUP_DEFAULT)
+    fieldIds = [dcgm_fields.DCGM_FI_DEV_SM_CLOCK, dcgm_fields.DCGM_FI_DEV_MEM_CLOCK, dcgm_fields.DCGM_FI_DEV_GPU_TEMP]
+    fieldGroup = pydcgm.DcgmFieldGroup(handle, name="cache-memory-fields", fieldIds=fieldIds)
+
+    group.samples.WatchFields(fieldGroup, 1000, 3600.0, 0)
+    for i in range(200):
+        group.samples.UpdateAllFields(True)
+
+    cacheMemory = system.introspect.cacheMemory.GetForHostengine()
+    assert cacheMemory.budgetBytes == 0
+    assert cacheMemory.usedBytes > 0
+
+    try:
+        usedBytesBefore = cacheMemory.usedBytes
+        budgetBytes = usedBytesBefore // 2
+        system.introspect.cacheMemory.SetBudget(budgetBytes)
+
+        cacheMemory = system.introspect.cacheMemory.GetForHostengine()
+        logger.debug("cache memory: %d used of %d. %d samples evicted" %
+                     (cacheMemory.usedBytes, cacheMemory.budgetBytes, cacheMemory.evictedSamples))
+        assert cacheMemory.budgetBytes == budgetBytes
+        # Other watches may already be down to their newest sample, so the budget isn't always reachable
+        assert cacheMemory.usedBytes < usedBytesBefore, "%d >= %d" % (cacheMemory.usedBytes, usedBytesBefore)
+        assert cacheMemory.numEvictions > 0
+        assert cacheMemory.evictedSamples > 0
+
+        # The newest sample of every field is kept
+        values = dcgm_agent.dcgmEntityGetLatestValues(handle.handle, dcgm_fields.DCGM_FE_GPU, gpuIds[0], fieldIds)
+        for value in values:
+            assert value.status == dcgm_structs.DCGM_ST_OK, "%d" % value.status
+    finally:
+        system.introspect.cacheMemory.SetBudget(0)
+
 def _cpu_load(start_time, duration_sec, x):
     while time.time() - start_time < duration_sec:
         x*x
@@ -270,7 +270,7 @@ def test_nvvs_plugins_required_symbols():
         'GetPluginInfo',
         'InitializePlugin',
         'RunTest',
-        'RetrieveCustomStats',
+        'StreamCustomStats',
         'RetrieveResults'
     ]
 
@@ -33,6 +33,7 @@ import test_utils
 import utils
 import stats
 import option_parser
+import DcgmDiag
 
 REQ_MATPLOTLIB_VER = '1.5.1'
 def isReqMatplotlibVersion():
@@ -495,3 +496,36 @@ def _test_cpuutil_bounded_flatlines_hostengine(cpuUtilTS):
         'CPU utilization did not stay consistent.  It varied for %.2f%% of the time out of %d points '
         % (100*relativeOutliers, len(tail))
         + 'but it is only allowed to vary %.2f%% of the time' % (100*relativeOutliersAllowed))
+
+# number of back to back quick diags to time in test_dcgm_diag_quick_startup_time
+QUICK_DIAG_STARTUP_RUNS = 10
+
+@test_utils.run_with_standalone_host_engine(120)
+@test_utils.run_with_initialized_client()
+@test_utils.run_only_with_live_gpus()
+@test_utils.run_only_if_mig_is_disabled()
+@test_utils.for_all_same_sku_gpus()
+def test_dcgm_diag_quick_startup_time(handle, gpuIds):
+    '''
+    Benchmark back to back quick (-r 1) diagnostics. Each run starts a new nvvs process, so the run time is mostly
+    nvvs startup: loading the SKU table and the allowlist, and loading the plugins.
+
+    The min, mean and max run times are logged so they can be compared between builds.
+    '''
+    if not option_parser.options.developer_mode:
+        test_utils.skip_test("Skipping developer test.")
+
+    test_utils.set_nvvs_bin_path()
+    dd = DcgmDiag.DcgmDiag(gpuIds=gpuIds, testNamesStr='1')
+
+    # The first run pays for cold caches. Don't count it
+    test_utils.diag_execute_wrapper(dd, handle)
+
+    durations = []
+    for _ in range(QUICK_DIAG_STARTUP_RUNS):
+        start = time.time()
+        test_utils.diag_execute_wrapper(dd, handle)
+        durations.append(time.time() - start)
+
+    logger.info("Quick diag on GPUs %s over %d runs: min %.3f s, mean %.3f s, max %.3f s"
+                % (gpuIds, len(durations), min(durations), stats.mean(durations), max(durations)))